@@ -6,5 +6,5 @@
 #include "../opendps/bootcom.c"
 #include "../opendps/flashlock.c"
 #include "../opendps/past.c"
-#include "../opendps/ringbuf.c"
+#include "../opendps/lz.c"
 #include "../opendps/tick.c"
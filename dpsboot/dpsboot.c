@@ -34,9 +34,9 @@
 #include <usart.h>
 #include <timer.h>
 #include <flash.h>
+#include <iwdg.h>
 #include "tick.h"
 #include "hw.h"
-#include "ringbuf.h"
 #include "past.h"
 #include "pastunits.h"
 #include "uframe.h"
@@ -44,13 +44,23 @@
 #include "bootcom.h"
 #include "crc16.h"
 #include "flashlock.h"
+#include "lz.h"
 
 #ifndef MIN
 #define MIN(x, y) ((x) < (y) ? (x) : (y))
 #endif
 
-#define RX_BUF_SIZE  (16)
-#define MAX_CHUNK_SIZE (2*1024)
+#define MAX_CHUNK_SIZE (UPGRADE_MAX_CHUNK_SIZE)
+#define FLASH_PAGE_SIZE (1024)
+/** Largest number of pages in an upgrade manifest */
+#define MAX_MANIFEST_PAGES (64)
+
+/** The app written by the latest upgrade, stored in past_app_image */
+typedef struct {
+    uint32_t length;
+    uint16_t crc;
+    uint16_t version; /** Counts the upgrades */
+} image_desc_t;
 
 /** Our parameter storage */
 static past_t past;
@@ -63,10 +73,6 @@ extern uint32_t *_past_end;
 extern uint32_t *_bootcom_start;
 extern uint32_t *_bootcom_end;
 
-/** UART RX FIFO */
-static ringbuf_t rx_buf;
-static uint8_t buffer[2*RX_BUF_SIZE];
-
 /** UART frame buffer */
 static uint8_t frame_buffer[FRAME_OVERHEAD(MAX_CHUNK_SIZE)];
 static uint32_t rx_idx = 0;
@@ -76,11 +82,42 @@ static bool receiving_frame = false;
 static uint16_t chunk_size;
 static uint32_t cur_flash_address;
 static uint16_t fw_crc16;
+/** Outcome of programming the previous chunk, which was acked before it was
+  * programmed */
+static upgrade_status_t flash_status;
+/** Number of upgrade data packets the host may have in flight, 0 for the
+  * original stop and wait upgrade without offsets */
+static uint8_t window;
+/** True if a chunk is acked before it is programmed, when the RX ring holds
+  * what the host sends meanwhile, see protocol_upgrade_grant() */
+static bool ack_early;
+/** Number of image bytes accepted, acked cumulatively */
+static uint32_t upgrade_offset;
+/** UPGRADE_FLAG_* granted in cmd_upgrade_start */
+static uint8_t upgrade_flags;
+
+/** Bit n is set if page n of the app in flash has the crc the manifest gave
+  * for page n of the new image. Chunks of such pages are not sent. */
+static uint8_t page_same[MAX_MANIFEST_PAGES / 8];
+
+/** An LZ compressed image, or one sent in chunks that are not whole pages,
+  * is collected in this page before it is programmed */
+static uint8_t page_buffer[FLASH_PAGE_SIZE];
+static uint32_t page_fill;
+/** Number of image bytes decoded */
+static uint32_t image_length;
 
 static upgrade_reason_t reason = reason_unknown;
 
+/** The rate set with cmd_set_baud, dropped as described in protocol.h */
+static uint32_t uart_baud = UART_DEFAULT_BAUD;
+static bool baud_confirmed;
+static uint32_t baud_last_frame;
+
 static void handle_frame(uint8_t *frame, uint32_t length);
 static void send_frame(uint8_t *frame, uint32_t length);
+static inline bool flash_write32(uint32_t address, uint32_t data);
+static void skip_same_chunks(void);
 
 /**
   * @brief Send ack to upgrade start and do some book keeping
@@ -93,13 +130,52 @@ static void send_start_response(void)
     PACK8(upgrade_continue);
     PACK16(chunk_size);
     PACK8(reason);
+    PACK8(window); /** Also tells the host we support windowed upgrades */
+    PACK8(upgrade_flags);
+    if (upgrade_flags & UPGRADE_FLAG_MANIFEST) {
+        for (uint32_t i = 0; i < sizeof(page_same); i++) {
+            PACK8(page_same[i]);
+        }
+    }
     FINISH_FRAME();
     uint32_t setting = 1;
     (void) past_write_unit(&past, past_upgrade_started, (void*) &setting, sizeof(setting));
-    cur_flash_address = (uint32_t) &_app_start;
+    upgrade_offset = 0;
+    skip_same_chunks();
+    cur_flash_address = (uint32_t) &_app_start + upgrade_offset;
+    /** The skipped chunks are part of the image, even if no chunk follows */
+    image_length = upgrade_offset;
+    page_fill = 0;
+    lz_reset();
+    flash_status = upgrade_continue;
     send_frame(_buffer, _length);
 }
 
+/**
+  * @brief Switch the UART to a new baud rate
+  * @param baud the new rate
+  * @retval None
+  */
+static void set_baud(uint32_t baud)
+{
+    hw_uart_set_baudrate(baud);
+    uart_baud = baud;
+    baud_confirmed = false;
+    baud_last_frame = get_ticks32();
+}
+
+/**
+  * @brief Go back to UART_DEFAULT_BAUD if the host did not confirm the new
+  *        rate in time or has gone quiet
+  * @retval None
+  */
+static void check_baud(void)
+{
+    if (uart_baud != UART_DEFAULT_BAUD && get_ticks32() - baud_last_frame >= (baud_confirmed ? BAUD_IDLE_MS : BAUD_CONFIRM_MS)) {
+        set_baud(UART_DEFAULT_BAUD);
+    }
+}
+
 /**
   * @brief Handle firmware upgrade
   * @retval none
@@ -112,8 +188,13 @@ static void handle_upgrade(void)
     }
 
     while(1) {
-        uint16_t b;
-        if (ringbuf_get(&rx_buf, &b)) {
+        uint8_t buf[16];
+        /** The IWDG keeps running through the reset if the app started it */
+        iwdg_reset();
+        check_baud();
+        uint32_t count = hw_uart_rx_get(buf, sizeof(buf));
+        for (uint32_t i = 0; i < count; i++) {
+            uint8_t b = buf[i];
             if (b == _SOF) {
                 receiving_frame = true;
                 rx_idx = 0;
@@ -121,14 +202,222 @@ static void handle_upgrade(void)
             if (receiving_frame && rx_idx < sizeof(frame_buffer)) {
                 frame_buffer[rx_idx++] = b;
                 if (b == _EOF) {
-                    handle_frame(frame_buffer, rx_idx);
                     receiving_frame = false;
+                    handle_frame(frame_buffer, rx_idx);
                 }
             }
         }
     }
 }
 
+/**
+  * @brief Erase and program a chunk of upgrade data at cur_flash_address
+  * @param data the chunk
+  * @param length length of the chunk
+  * @retval upgrade_continue if the chunk was written
+  */
+static upgrade_status_t program_chunk(uint8_t *data, uint32_t length)
+{
+    for (uint32_t page = 0; page < length; page += FLASH_PAGE_SIZE) {
+        uint32_t page_length = MIN(FLASH_PAGE_SIZE, length - page);
+        if (memcmp((void*) (cur_flash_address + page), &data[page], page_length) == 0) {
+            continue; /** Unchanged, spare the flash */
+        }
+        flash_erase_page(cur_flash_address + page);
+        if (!(FLASH_SR_EOP & flash_get_status_flags())) {
+            return upgrade_erase_error;
+        }
+        for (uint32_t i = page; i < page + page_length; i+=4) {
+            uint32_t word = data[i+3] << 24 | data[i+2] << 16 | data[i+1] << 8 | data[i];
+            /** @todo: Handle binaries not size aliged to 4 bytes */
+            if (!flash_write32(cur_flash_address+i, word)) {
+                return upgrade_flash_error;
+            }
+        }
+    }
+    cur_flash_address += length;
+    return upgrade_continue;
+}
+
+/**
+  * @brief Check the manifest of the new image against the app in flash
+  * @param manifest crc16 of each whole page of the new image
+  * @param num_pages number of pages in the manifest
+  * @retval None
+  */
+static void check_manifest(uint8_t *manifest, uint32_t num_pages)
+{
+    memset(page_same, 0, sizeof(page_same));
+    for (uint32_t page = 0; page < num_pages && page < MAX_MANIFEST_PAGES; page++) {
+        uint8_t *flash = (uint8_t*) &_app_start + page * FLASH_PAGE_SIZE;
+        uint16_t crc = manifest[2*page] << 8 | manifest[2*page + 1];
+        if (flash + FLASH_PAGE_SIZE <= (uint8_t*) &_app_end && crc16_update(0, flash, FLASH_PAGE_SIZE) == crc) {
+            page_same[page / 8] |= 1 << (page % 8);
+        }
+    }
+}
+
+/**
+  * @brief Move upgrade_offset past the chunks whose pages are all unchanged
+  *        according to the manifest. The host skips the same chunks.
+  * @retval None
+  */
+static void skip_same_chunks(void)
+{
+    if (!(upgrade_flags & UPGRADE_FLAG_MANIFEST)) {
+        return;
+    }
+    while (1) {
+        for (uint32_t page = upgrade_offset / FLASH_PAGE_SIZE; page < (upgrade_offset + chunk_size) / FLASH_PAGE_SIZE; page++) {
+            if (page >= MAX_MANIFEST_PAGES || !(page_same[page / 8] & (1 << (page % 8)))) {
+                return;
+            }
+        }
+        upgrade_offset += chunk_size;
+    }
+}
+
+/**
+  * @brief Program the page buffer, padded to a whole word
+  * @retval upgrade_continue if the page was written
+  */
+static upgrade_status_t flush_page(void)
+{
+    if (cur_flash_address + FLASH_PAGE_SIZE > (uint32_t) &_app_end) {
+        return upgrade_overflow_error;
+    }
+    while (page_fill % 4) {
+        page_buffer[page_fill++] = 0xff;
+    }
+    upgrade_status_t status = program_chunk(page_buffer, page_fill);
+    page_fill = 0;
+    return status;
+}
+
+/**
+  * @brief Append a byte to the image in the page buffer
+  * @param b the byte
+  * @retval upgrade_continue if all is well
+  */
+static upgrade_status_t page_output(uint8_t b)
+{
+    page_buffer[page_fill++] = b;
+    image_length++;
+    return page_fill == FLASH_PAGE_SIZE ? flush_page() : upgrade_continue;
+}
+
+/**
+  * @brief Append a decoded byte to the image, for lz_decode()
+  * @param b the byte
+  * @retval upgrade_continue if all is well
+  */
+upgrade_status_t lz_output(uint8_t b)
+{
+    return page_output(b);
+}
+
+/**
+  * @brief Read back a byte of the image decoded so far, from the page buffer
+  *        or from flash, for lz_decode()
+  * @param pos position of the byte in the image
+  * @retval the byte
+  */
+uint8_t lz_image_byte(uint32_t pos)
+{
+    uint32_t page_start = image_length - page_fill;
+    return pos >= page_start ? page_buffer[pos - page_start] : ((uint8_t*) &_app_start)[pos];
+}
+
+/**
+  * @brief Write a chunk of upgrade data, raw or compressed
+  * @param data the chunk
+  * @param length length of the chunk
+  * @retval upgrade_continue if the chunk was written
+  */
+static upgrade_status_t write_chunk(uint8_t *data, uint32_t length)
+{
+    upgrade_status_t status = upgrade_continue;
+    if (upgrade_flags & UPGRADE_FLAG_LZ) {
+        return lz_decode(data, length);
+    }
+    if (chunk_size % FLASH_PAGE_SIZE) {
+        /** Chunks not made of whole pages are programmed a page at a time */
+        for (uint32_t i = 0; i < length && status == upgrade_continue; i++) {
+            status = page_output(data[i]);
+        }
+        return status;
+    }
+    status = program_chunk(data, length);
+    /** upgrade_offset includes the unchanged chunks that follow */
+    cur_flash_address = (uint32_t) &_app_start + upgrade_offset;
+    image_length = upgrade_offset;
+    return status;
+}
+
+/**
+  * @brief Send the response to an upgrade data packet
+  * @param status the status to report
+  * @retval None
+  */
+static void send_data_response(upgrade_status_t status)
+{
+    DECLARE_FRAME(MAX_FRAME_LENGTH);
+    PACK8(cmd_response | cmd_upgrade_data);
+    PACK8(status);
+    PACK32(upgrade_offset);
+    FINISH_FRAME();
+    send_frame(_buffer, _length);
+}
+
+/**
+  * @brief Describe the app just written in past_app_image, with a version
+  *        past_app_verified does not hold so the next boot checks it
+  * @retval None
+  */
+static void store_image_desc(void)
+{
+    image_desc_t desc = { .length = image_length, .crc = fw_crc16, .version = 1 };
+    const void *data;
+    uint32_t length;
+    if (past_read_unit(&past, past_app_image, &data, &length) && length == sizeof(desc)) {
+        image_desc_t old;
+        memcpy(&old, data, sizeof(old));
+        desc.version = old.version + 1;
+    }
+    (void) past_write_unit(&past, past_app_image, (void*) &desc, sizeof(desc));
+}
+
+/**
+  * @brief Check the app against the descriptor of the latest upgrade. The
+  *        crc is computed on the first boot after the upgrade only, the
+  *        version found intact is kept in past_app_verified and later boots
+  *        just compare it.
+  * @retval false if the app does not have the crc of the descriptor
+  */
+static bool check_image(void)
+{
+    image_desc_t desc;
+    uint16_t verified;
+    const void *data;
+    uint32_t length;
+    if (!past_read_unit(&past, past_app_image, &data, &length) || length != sizeof(desc)) {
+        return true; /** Not written by an upgrade of this boot, nothing to check */
+    }
+    memcpy(&desc, data, sizeof(desc));
+    if (past_read_unit(&past, past_app_verified, &data, &length) && length == sizeof(verified)) {
+        memcpy(&verified, data, sizeof(verified));
+        if (verified == desc.version) {
+            return true;
+        }
+    }
+    if (desc.length > (uint32_t) &_app_end - (uint32_t) &_app_start ||
+        crc16_update(0, (uint8_t*) &_app_start, desc.length) != desc.crc) {
+        return false;
+    }
+    (void) past_write_unit(&past, past_app_verified, (void*) &desc.version, sizeof(desc.version));
+    return true;
+}
+
 /**
   * @brief Branch to main application
   * @retval false if app start failed
@@ -189,71 +478,128 @@ static void handle_frame(uint8_t *frame, uint32_t length)
     int32_t payload_len = uframe_extract_payload(frame, length);
     payload = frame; // Why? Well, frame now points to the payload
     if (payload_len > 0) {
+        baud_confirmed = true;
+        baud_last_frame = get_ticks32();
         cmd = frame[0];
         switch(cmd) {
+            case cmd_set_baud:
+            {
+                uint32_t baud;
+                bool success;
+                {
+                    DECLARE_UNPACK(payload, payload_len);
+                    UNPACK8(cmd);
+                    UNPACK32(baud);
+                    success = payload_len == 5 && protocol_baud_supported(baud);
+                }
+                DECLARE_FRAME(MAX_FRAME_LENGTH);
+                PACK8(cmd_response | cmd_set_baud);
+                PACK8(success);
+                FINISH_FRAME();
+                send_frame(_buffer, _length);
+                if (success) {
+                    set_baud(baud);
+                }
+                break;
+            }
             case cmd_upgrade_start:
             {
                 {
-                    DECLARE_UNPACK(payload, length);
+                    upgrade_grant_t grant = { 0 };
+                    DECLARE_UNPACK(payload, payload_len);
                     UNPACK8(cmd);
-                    UNPACK16(chunk_size);
-                    chunk_size = MIN(MAX_CHUNK_SIZE, chunk_size);
+                    UNPACK16(grant.chunk_size);
                     UNPACK16(fw_crc16);
+                    if (_remain >= 1) {
+                        UNPACK8(grant.window);
+                    }
+                    if (_remain >= 1) {
+                        UNPACK8(grant.flags);
+                    }
+                    /** The ring is empty when its head meets its tail, so it
+                      * holds one byte less than its size */
+                    protocol_upgrade_grant(&grant, uart_baud, RX_DMA_BUF_SIZE - 1);
+                    chunk_size = grant.chunk_size;
+                    window = grant.window;
+                    upgrade_flags = grant.flags;
+                    ack_early = grant.ack_early;
+                    if (upgrade_flags & UPGRADE_FLAG_MANIFEST) {
+                        check_manifest(&_buffer[_pos], _remain / 2);
+                    }
                 }
                 send_start_response();
                 break;
             }
             case cmd_upgrade_data:
+            {
+                uint8_t *data = &payload[1]; /** frame type of the payload occupies 1 byte, the rest is upgrade data */
+                uint32_t chunk_length = payload_len - 1;
+                if (window) {
+                    /** The payload starts with the image offset of the data */
+                    if (chunk_length < 4) {
+                        break;
+                    }
+                    uint32_t offset = data[0] << 24 | data[1] << 16 | data[2] << 8 | data[3];
+                    data += 4;
+                    chunk_length -= 4;
+                    if (offset > upgrade_offset) {
+                        break; /** A packet was lost, the host goes back to the acked offset */
+                    } else if (offset < upgrade_offset) {
+                        send_data_response(flash_status); /** The ack was lost, ack again */
+                        break;
+                    }
+                }
                 if (!cur_flash_address || !fw_crc16) {
                     status = upgrade_protocol_error;
-                } else if (payload_len < 0) {
-                    status = upgrade_crc_error;
-                } else if (cur_flash_address >= (uint32_t) &_app_end) {
+                } else if (upgrade_offset + chunk_length > (uint32_t) &_app_end - (uint32_t) &_app_start) {
                     status = upgrade_overflow_error;
                 } else {
-                    status = upgrade_continue; /** think positive thoughts */
-                    uint32_t chunk_length = payload_len - 1; /** frame type of the payload occupies 1 byte, the rest is upgrade data */
-                    if (chunk_length > 0) {
-                        flash_erase_page(cur_flash_address);
-                        if (!(FLASH_SR_EOP & flash_get_status_flags())) {
-                            status = upgrade_erase_error;
-                        } else {
-                            uint32_t word;
-                            status = upgrade_continue; // Think positive
-                            /** Note, payload contains 1 frame type byte and N bytes data */
-                            for (uint32_t i = 0; i < (uint32_t) chunk_length; i+=4) {
-                                word = payload[i+4] << 24 | payload[i+3] << 16 | payload[i+2] << 8 | payload[i+1];
-                                /** @todo: Handle binaries not size aliged to 4 bytes */
-                                if (!flash_write32(cur_flash_address+i, word)) {
-                                    status = upgrade_flash_error;
-                                    break;
-                                }
-                            }
-                            cur_flash_address += chunk_length;
+                    status = flash_status;
+                    if (chunk_length >= chunk_size) {
+                        /** Ack before programming if the RX ring holds what
+                          * the host sends meanwhile, an error is then
+                          * reported in the response to the next chunk */
+                        if (status == upgrade_continue) {
+                            upgrade_offset += chunk_length;
+                            skip_same_chunks();
+                        }
+                        if (ack_early) {
+                            send_data_response(status);
+                        }
+                        if (status == upgrade_continue) {
+                            flash_status = write_chunk(data, chunk_length);
+                        }
+                        if (!ack_early) {
+                            send_data_response(flash_status);
                         }
+                        break;
                     }
-                    if (chunk_length < chunk_size) { /** @todo verify code for even kb binaries */
-                        uint16_t calc_crc = crc16((uint8_t*) &_app_start, cur_flash_address - (uint32_t) &_app_start);
+                    /** The last chunk, the response is the outcome of the upgrade */
+                    if (status == upgrade_continue && chunk_length > 0) {
+                        upgrade_offset += chunk_length;
+                        status = write_chunk(data, chunk_length);
+                    }
+                    if (status == upgrade_continue && page_fill) {
+                        status = flush_page();
+                    }
+                    if (status == upgrade_continue) { /** @todo verify code for even kb binaries */
+                        uint16_t calc_crc = crc16_update(0, (uint8_t*) &_app_start, image_length);
                         status = fw_crc16 == calc_crc ? upgrade_success : upgrade_crc_error;
                     }
                 }
-                {
-                    DECLARE_FRAME(MAX_FRAME_LENGTH);
-                    PACK8(cmd_response | cmd_upgrade_data);
-                    PACK8(status);
-                    FINISH_FRAME();
-                    send_frame(_buffer, _length);
-                    if (status == upgrade_success) {
-                        usart_wait_send_ready(USART1); /** make sure FIFO is empty */
-                        (void) past_erase_unit(&past, past_upgrade_started);
-                        cur_flash_address = 0;
-                        lock_flash();
-                        if (!start_app()) {
-                            handle_upgrade(); /** Try again... */
-                        }
+                send_data_response(status);
+                if (status == upgrade_success) {
+                    usart_wait_send_ready(USART1); /** make sure FIFO is empty */
+                    store_image_desc();
+                    (void) past_erase_unit(&past, past_upgrade_started);
+                    cur_flash_address = 0;
+                    lock_flash();
+                    if (!start_app()) {
+                        handle_upgrade(); /** Try again... */
                     }
                 }
                 break;
+            }
             default:
                 break;
         }
@@ -272,8 +618,13 @@ int main(void)
     void *data;
     uint32_t length;
 
-    ringbuf_init(&rx_buf, (uint8_t*) buffer, sizeof(buffer));
-    hw_init(&rx_buf);
+    /** A warm boot asked for by the app skips the checks below and the
+      * hardware init the app does anyway */
+    if (bootcom_peek(&magic, &temp) && magic == BOOTCOM_WARM_BOOT) {
+        (void) start_app();
+    }
+
+    hw_init();
 
     do {
         if (hw_check_forced_upgrade()) {
@@ -284,9 +635,11 @@ int main(void)
             break;
         }
 
-        past.blocks[0] = past_start;
-        past.blocks[1] = past_start + 1024;
-        if (!past_init(&past)) {
+        for (uint32_t i = 0; i < PAST_NUM_BLOCKS; i++) {
+            past.blocks[i] = past_start + i * PAST_BLOCK_SIZE;
+        }
+        /** Built with another PAST_BLOCKS than the linker script */
+        if (past_start + PAST_NUM_BLOCKS * PAST_BLOCK_SIZE != (uint32_t) &_past_end || !past_init(&past)) {
             /** Not much we can do */
             enter_upgrade = true;
             reason = reason_past_failure;
@@ -305,7 +658,7 @@ int main(void)
         }
 #endif // GIT_VERSION
 
-        if (bootcom_get(&magic, &temp) && magic == 0xfedebeda) {
+        if (bootcom_get(&magic, &temp) && magic == BOOTCOM_UPGRADE) {
             /** We got invoced by the app */
             chunk_size = temp >> 16;
             fw_crc16 = temp & 0xffff;
@@ -320,6 +673,13 @@ int main(void)
             reason = reason_unfinished_upgrade;
             break;
         }
+
+        if (!check_image()) {
+            /** The app is not the image the latest upgrade wrote */
+            enter_upgrade = true;
+            reason = reason_image_corrupt;
+            break;
+        }
     } while(0);
 
     if (enter_upgrade) {
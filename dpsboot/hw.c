@@ -30,24 +30,27 @@
 #include <gpio.h>
 #include <nvic.h>
 #include <usart.h>
+#include <dma.h>
 #include <stdio.h>
 #include "tick.h"
 #include "hw.h"
-#include "ringbuf.h"
 
 static void clock_init(void);
 static void usart_init(void);
 static void gpio_init(void);
 
-static ringbuf_t *rx_buf;
+/** USART1 RX is received by DMA1 channel 5, which keeps running while the
+  * CPU is stalled by flash erase and program operations that would make an
+  * RX interrupt miss bytes */
+static uint8_t rx_dma_buf[RX_DMA_BUF_SIZE];
+static uint32_t rx_dma_tail;
 
 /**
   * @brief Initialize the hardware
   * @retval None
   */
-void hw_init(ringbuf_t *usart_rx_buf)
+void hw_init(void)
 {
-    rx_buf = usart_rx_buf;
     clock_init();
     systick_init();
     gpio_init();
@@ -71,21 +74,41 @@ bool hw_check_forced_upgrade(void)
     return gpio_get(BUTTON_SEL_PORT, BUTTON_SEL_PIN) != BUTTON_SEL_PIN;
 }
 
-void usart1_isr(void)
+/**
+  * @brief Get bytes received on USART1
+  * @param buf buffer to copy received bytes to
+  * @param size size of buffer
+  * @retval number of bytes copied, 0 if there is nothing more to read
+  * @note Bytes are lost if more than RX_DMA_BUF_SIZE arrive between two calls,
+  *       the frame crc will catch that
+  */
+uint32_t hw_uart_rx_get(uint8_t *buf, uint32_t size)
 {
-    if ((USART_CR1(USART1) & USART_CR1_RXNEIE) != 0 &&
-        (USART_SR(USART1) & USART_SR_RXNE) != 0) {
-        uint16_t ch = usart_recv(USART1);
-        if ((USART_SR(USART1) & USART_SR_ORE) == 0 &&
-            (USART_SR(USART1) & USART_SR_FE) == 0 &&
-            (USART_SR(USART1) & USART_SR_PE) == 0) {
-            if (!ringbuf_put(rx_buf, ch)) {
-                //printf("ASSERT:usart1_isr:%d\n", __LINE__);
-            }
-        } else {
-            //printf("ASSERT:usart1_isr:%d\n", __LINE__);
+    uint32_t head = sizeof(rx_dma_buf) - dma_get_number_of_data(DMA1, DMA_CHANNEL5);
+    uint32_t count = 0;
+    if (head == sizeof(rx_dma_buf)) {
+        head = 0;
+    }
+    while (rx_dma_tail != head && count < size) {
+        buf[count++] = rx_dma_buf[rx_dma_tail++];
+        if (rx_dma_tail == sizeof(rx_dma_buf)) {
+            rx_dma_tail = 0;
         }
     }
+    return count;
+}
+
+/**
+  * @brief Change the baud rate of USART1 once the byte being sent has left
+  * @param baud the new rate
+  * @retval None
+  */
+void hw_uart_set_baudrate(uint32_t baud)
+{
+    while (!(USART_SR(USART1) & USART_SR_TC)) ;
+    usart_disable(USART1);
+    usart_set_baudrate(USART1, baud);
+    usart_enable(USART1);
 }
 
 /**
@@ -109,10 +132,22 @@ static void clock_init(void)
 static void usart_init(void)
 {
     rcc_periph_clock_enable(RCC_USART1);
+    rcc_periph_clock_enable(RCC_DMA1);
     gpio_set_mode(GPIOA, GPIO_MODE_OUTPUT_50_MHZ, GPIO_CNF_OUTPUT_ALTFN_PUSHPULL, GPIO_USART1_TX);
     gpio_set_mode(GPIOA, GPIO_MODE_INPUT, GPIO_CNF_INPUT_FLOAT, GPIO_USART1_RX);
 
-    nvic_enable_irq(NVIC_USART1_IRQ);
+    dma_channel_reset(DMA1, DMA_CHANNEL5);
+    dma_set_peripheral_address(DMA1, DMA_CHANNEL5, (uint32_t) &USART1_DR);
+    dma_set_memory_address(DMA1, DMA_CHANNEL5, (uint32_t) rx_dma_buf);
+    dma_set_number_of_data(DMA1, DMA_CHANNEL5, sizeof(rx_dma_buf));
+    dma_set_read_from_peripheral(DMA1, DMA_CHANNEL5);
+    dma_enable_memory_increment_mode(DMA1, DMA_CHANNEL5);
+    dma_set_peripheral_size(DMA1, DMA_CHANNEL5, DMA_CCR_PSIZE_8BIT);
+    dma_set_memory_size(DMA1, DMA_CHANNEL5, DMA_CCR_MSIZE_8BIT);
+    dma_set_priority(DMA1, DMA_CHANNEL5, DMA_CCR_PL_HIGH);
+    dma_enable_circular_mode(DMA1, DMA_CHANNEL5);
+    dma_enable_channel(DMA1, DMA_CHANNEL5);
+
     usart_set_baudrate(USART1, 115200);
     usart_set_databits(USART1, 8);
     usart_set_stopbits(USART1, USART_STOPBITS_1);
@@ -120,8 +155,7 @@ static void usart_init(void)
     usart_set_parity(USART1, USART_PARITY_NONE);
     usart_set_flow_control(USART1, USART_FLOWCONTROL_NONE);
 
-    // Enable USART1 Receive interrupt.
-    USART_CR1(USART1) |= USART_CR1_RXNEIE;
+    usart_enable_rx_dma(USART1);
 
     usart_enable(USART1);
 }
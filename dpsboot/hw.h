@@ -25,18 +25,36 @@
 #ifndef __HW_H__
 #define __HW_H__
 
-#include "ringbuf.h"
-
 #define BUTTON_SEL_PORT GPIOA
 #define BUTTON_SEL_PIN  GPIO2
 
 
+/** Size of the USART1 RX DMA ring, it must hold what the host sends while
+  * a chunk is erased and programmed. protocol_upgrade_grant() picks the
+  * chunk size and window to fit, or acks after programming. */
+#define RX_DMA_BUF_SIZE  (1024)
+
+
 /**
   * @brief Initialize the hardware
-  * @param usart_rx_buf pointer to the USART RX ringbuffer
   * @retval None
   */
-void hw_init(ringbuf_t *usart_rx_buf);
+void hw_init(void);
+
+/**
+  * @brief Get bytes received on USART1
+  * @param buf buffer to copy received bytes to
+  * @param size size of buffer
+  * @retval number of bytes copied, 0 if there is nothing more to read
+  */
+uint32_t hw_uart_rx_get(uint8_t *buf, uint32_t size);
+
+/**
+  * @brief Change the baud rate of USART1, after the byte being sent
+  * @param baud the new rate
+  * @retval None
+  */
+void hw_uart_set_baudrate(uint32_t baud);
 
 /**
   * @brief Check if we are to enter forced upgrade
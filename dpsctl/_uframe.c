@@ -0,0 +1,96 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/** Compiled uframe codec for the host tools, sharing uframe.c and crc16.c
+  * with the firmware. uframe.py uses it when it has been built with
+  * 'python setup.py build_ext --inplace' in this directory. */
+
+#include <Python.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "uframe.h"
+#include "crc16.h"
+
+/** Unescape, crc check and return (status, payload) of an escaped frame,
+  * status being 0 or -E_* */
+static PyObject *py_decode(PyObject *self, PyObject *args)
+{
+    Py_buffer frame;
+    PyObject *payload, *ret;
+    int32_t status;
+    (void) self;
+    if (!PyArg_ParseTuple(args, "s*", &frame)) {
+        return NULL;
+    }
+    /** The payload is unescaped in place, into a copy of the frame */
+    payload = PyByteArray_FromStringAndSize((const char*) frame.buf, frame.len);
+    PyBuffer_Release(&frame);
+    if (!payload) {
+        return NULL;
+    }
+    status = uframe_extract_payload((uint8_t*) PyByteArray_AS_STRING(payload), (uint32_t) PyByteArray_GET_SIZE(payload));
+    if (PyByteArray_Resize(payload, status > 0 ? status : 0) < 0) {
+        Py_DECREF(payload);
+        return NULL;
+    }
+    ret = Py_BuildValue("(iO)", status > 0 ? 0 : status, payload);
+    Py_DECREF(payload);
+    return ret;
+}
+
+/** Return the crc16 of a buffer */
+static PyObject *py_crc16(PyObject *self, PyObject *args)
+{
+    Py_buffer data;
+    uint16_t crc;
+    (void) self;
+    if (!PyArg_ParseTuple(args, "s*", &data)) {
+        return NULL;
+    }
+    crc = crc16_update(0, (const uint8_t*) data.buf, (uint32_t) data.len);
+    PyBuffer_Release(&data);
+    return Py_BuildValue("i", crc);
+}
+
+static PyMethodDef uframe_methods[] = {
+    {"decode", py_decode, METH_VARARGS, "Unescape and crc check a frame, returns (status, payload)"},
+    {"crc16", py_crc16, METH_VARARGS, "Return the crc16 of a buffer"},
+    {NULL, NULL, 0, NULL}
+};
+
+#if PY_MAJOR_VERSION >= 3
+static struct PyModuleDef uframe_module = {
+    PyModuleDef_HEAD_INIT, "_uframe", NULL, -1, uframe_methods
+};
+
+PyMODINIT_FUNC PyInit__uframe(void)
+{
+    return PyModule_Create(&uframe_module);
+}
+#else // PY_MAJOR_VERSION
+PyMODINIT_FUNC init_uframe(void)
+{
+    (void) Py_InitModule("_uframe", uframe_methods);
+}
+#endif // PY_MAJOR_VERSION
@@ -0,0 +1,266 @@
+"""
+The MIT License (MIT)
+
+Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+"""
+
+"""
+Drive many OpenDPS devices from one process, for production test benches.
+Every unit gets its own Comm, so its requests are pipelined on its own link,
+and a pool of worker threads runs the same pipeline of steps on the units
+concurrently. Serial, UDP and TCP links may be mixed, units are named like
+dpsctl's -d option.
+
+    def check_output(unit):
+        unit.comm.set_parameters(voltage = 5000, current = 500)
+        unit.comm.enable(True)
+        time.sleep(0.2)
+        return unit.comm.query()
+
+    bench = Bench({"dps1": "/dev/ttyUSB0", "dps2": "192.168.1.20", "dps3": "tcp:192.168.1.21"})
+    results = bench.run([("output", check_output),
+                         ("ripple", stream_step(2.0, 10, 10)),
+                         ("off", lambda unit: unit.comm.enable(False))],
+                        consumer = lambda unit, samples: log(unit, samples))
+    print(results.to_json())
+
+A step is called with the Unit and its return value is recorded. A step
+that raises, or returns None or False, fails and the remaining steps of
+that unit are skipped. Streamed samples are handed to the consumer on a
+thread of its own. A consumer that cannot keep up does not stall the links:
+its queue is bounded and the oldest batches are dropped when it fills, and
+the dropped samples are counted per unit.
+"""
+
+import json
+import threading
+import time
+try:
+    import Queue as queue
+except ImportError:
+    import queue
+from protocol import *
+from client import Comm
+from dpsctl import interface_for
+
+"""
+The outcome of the steps of all units, collected from the worker threads
+"""
+class Results(object):
+
+    def __init__(self):
+        self._lock = threading.Lock()
+        self._records = []
+
+    def add(self, unit, step, value, elapsed, error = None):
+        record = {'unit': unit, 'step': step, 'ok': error == None,
+                  'value': value, 'elapsed': elapsed}
+        if error != None:
+            record['error'] = error
+        with self._lock:
+            self._records.append(record)
+
+    def records(self):
+        with self._lock:
+            return list(self._records)
+
+    """
+    The records of each unit keyed on its name, in the order they ran
+    """
+    def by_unit(self):
+        units = {}
+        for r in self.records():
+            units.setdefault(r['unit'], []).append(r)
+        return units
+
+    """
+    The names of the units with a failed step
+    """
+    def failed(self):
+        return sorted(set(r['unit'] for r in self.records() if not r['ok']))
+
+    def summary(self):
+        summary = {}
+        for (unit, records) in self.by_unit().items():
+            summary[unit] = {'passed': len([r for r in records if r['ok']]),
+                             'failed': len([r for r in records if not r['ok']]),
+                             'elapsed': sum(r['elapsed'] for r in records)}
+        return summary
+
+    def to_json(self):
+        return json.dumps({'records': self.records(), 'summary': self.summary()},
+                          default = str, sort_keys = True)
+
+"""
+Hands streamed samples to a consumer on a thread of its own. feed() is
+called from the reader threads of the Comms and never blocks, when the
+queue is full the oldest batch gives way.
+"""
+class Stream(object):
+
+    def __init__(self, consumer, depth = 64):
+        self._consumer = consumer
+        self._queue = queue.Queue(depth)
+        self._lock = threading.Lock()
+        self._thread = threading.Thread(target = self._run)
+        self._thread.daemon = True
+        self._thread.start()
+
+    def feed(self, unit, samples):
+        with self._lock:
+            unit.samples += len(samples)
+            while True:
+                try:
+                    self._queue.put_nowait((unit, samples))
+                    return
+                except queue.Full:
+                    pass
+                try:
+                    (old_unit, old) = self._queue.get_nowait()
+                    old_unit.dropped += len(old)
+                except queue.Empty:
+                    pass
+
+    """
+    Number of batches waiting for the consumer
+    """
+    def lag(self):
+        return self._queue.qsize()
+
+    def close(self):
+        self._queue.put((None, None))
+        self._thread.join()
+
+    def _run(self):
+        while True:
+            (unit, samples) = self._queue.get()
+            if unit == None:
+                break
+            try:
+                self._consumer(unit, samples)
+            except Exception:
+                pass
+
+"""
+A device on the bench. comm is open while its pipeline runs, samples and
+dropped count the streamed samples received and dropped by the consumer.
+"""
+class Unit(object):
+
+    def __init__(self, name, if_name):
+        self.name = name
+        self.if_name = if_name
+        self.comm = None
+        self.samples = 0
+        self.dropped = 0
+
+"""
+Run pipelines of steps on many units, `workers` units at a time. The Comm
+options depth, timeout and tagged apply to every unit.
+"""
+class Bench(object):
+
+    def __init__(self, units, workers = None, stream_depth = 64, **comm_args):
+        if not isinstance(units, dict):
+            units = dict((if_name, if_name) for if_name in units)
+        self.units = [Unit(name, units[name]) for name in sorted(units)]
+        self._workers = workers if workers else len(self.units)
+        self._stream_depth = stream_depth
+        self._comm_args = comm_args
+        self._stream = None
+
+    """
+    Run the pipeline, a list of (name, step) tuples, on every unit and
+    return the Results. Streamed samples go to consumer(unit, samples).
+    """
+    def run(self, pipeline, consumer = None):
+        results = Results()
+        todo = queue.Queue()
+        for unit in self.units:
+            todo.put(unit)
+        if consumer:
+            self._stream = Stream(consumer, self._stream_depth)
+        threads = []
+        for i in range(min(self._workers, len(self.units))):
+            t = threading.Thread(target = self._worker, args = (todo, pipeline, results))
+            t.daemon = True
+            t.start()
+            threads.append(t)
+        for t in threads:
+            t.join()
+        if self._stream:
+            self._stream.close()
+            self._stream = None
+        return results
+
+    def _worker(self, todo, pipeline, results):
+        while True:
+            try:
+                unit = todo.get_nowait()
+            except queue.Empty:
+                return
+            self._run_unit(unit, pipeline, results)
+
+    def _run_unit(self, unit, pipeline, results):
+        start = time.time()
+        try:
+            unit.comm = Comm(interface_for(unit.if_name),
+                             on_event = lambda f: self._event(unit, f), **self._comm_args)
+        except (Exception, SystemExit) as e:
+            results.add(unit.name, "open", None, time.time() - start, str(e))
+            return
+        try:
+            for (name, step) in pipeline:
+                start = time.time()
+                error = None
+                value = None
+                try:
+                    value = step(unit)
+                    if value == None or value is False:
+                        error = "no response"
+                except (Exception, SystemExit) as e:
+                    # The interfaces call fail() on I/O errors
+                    error = str(e) if str(e) else e.__class__.__name__
+                results.add(unit.name, name, value, time.time() - start, error)
+                if error != None:
+                    break
+        finally:
+            unit.comm.close()
+            unit.comm = None
+
+    def _event(self, unit, f):
+        if self._stream and f.get_frame()[0] == cmd_stream_data:
+            self._stream.feed(unit, unpack_stream_data(f))
+
+"""
+A step streaming samples for `seconds`, see create_stream_start(). Returns
+the number of samples received and dropped.
+"""
+def stream_step(seconds, interval_ms, count, frame_size = None):
+    def step(unit):
+        (samples, dropped) = (unit.samples, unit.dropped)
+        f = unit.comm.call(create_stream_start(interval_ms, count, frame_size))
+        if f == None or f.get_frame()[1] == 0:
+            return None
+        time.sleep(seconds)
+        unit.comm.call(create_cmd(cmd_stream_stop))
+        return {'samples': unit.samples - samples, 'dropped': unit.dropped - dropped}
+    return step
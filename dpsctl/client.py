@@ -0,0 +1,246 @@
+"""
+The MIT License (MIT)
+
+Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+"""
+
+"""
+A long lived client for OpenDPS devices. The interface is opened once and a
+reader thread collects the responses, so requests are pipelined: up to
+`depth` requests can be in flight and the latency of the link is paid once
+per batch instead of once per request.
+
+    comm = Comm(tty_interface("/dev/ttyUSB0"))
+    pending = [comm.request(create_cmd(cmd_query)) for i in range(10)]
+    for r in pending:
+        print(unpack_query_response(r.wait()))
+    comm.close()
+
+The device handles its frames in order, so a response answers the oldest
+request in flight for the same command. Requests that were passed over, or
+did not get a response within the timeout, complete with None. With
+`tagged = True` every request carries a tag that its response echoes, and
+responses are matched on the tag instead, so a lost response does not
+affect the other requests in flight. Frames the device sends on its own
+(streamed samples, OCP, OVP/OPP, temperature, alarm and change events) go
+to the `on_event` callback, called from the reader thread.
+"""
+
+import threading
+import time
+from protocol import *
+
+"""
+A request in flight
+"""
+class Request(object):
+
+    def __init__(self, command, tag = None):
+        self.command = command
+        self.tag = tag
+        self.sent = time.time()
+        self._done = threading.Event()
+        self._response = None
+
+    def complete(self, response):
+        self._response = response
+        self._done.set()
+
+    """
+    Wait for the response, returns the uFrame or None on timeout
+    """
+    def wait(self, timeout = None):
+        self._done.wait(timeout)
+        return self._response
+
+    def done(self):
+        return self._done.is_set()
+
+class Comm(object):
+
+    def __init__(self, interface, depth = 4, timeout = 1.0, on_event = None, tagged = False):
+        self._interface = interface
+        self._tagged = tagged
+        self._next_tag = 0
+        self._depth = depth
+        self._timeout = timeout
+        self._on_event = on_event
+        self._pending = []
+        self._parameter_ids = None
+        self._lock = threading.Condition()
+        self._running = True
+        if not interface.open():
+            raise IOError("could not open %s" % (interface.name()))
+        self._thread = threading.Thread(target = self._reader)
+        self._thread.daemon = True
+        self._thread.start()
+
+    """
+    Send a request without waiting for its response. Blocks while `depth`
+    requests are in flight. Returns a Request to wait on.
+    """
+    def request(self, frame):
+        req = Request(frame.get_frame()[1])
+        with self._lock:
+            while len(self._pending) >= self._depth:
+                self._lock.wait(self._timeout)
+                self._expire()
+            if self._tagged:
+                req.tag = self._next_tag
+                self._next_tag = (self._next_tag + 1) & 0xff
+                frame = create_tagged(frame, req.tag)
+            req.sent = time.time()
+            self._pending.append(req)
+            self._interface.write(frame.get_frame())
+        return req
+
+    """
+    Send a request and wait for its response
+    """
+    def call(self, frame):
+        return self.request(frame).wait(self._timeout * (self._depth + 1))
+
+    """
+    Convenience wrappers, returning the unpacked responses
+    """
+    def ping(self):
+        return self.call(create_cmd(cmd_ping)) != None
+
+    def query(self):
+        f = self.call(create_cmd(cmd_query))
+        return unpack_query_response(f) if f else None
+
+    def enable(self, on):
+        f = self.call(create_enable_output("on" if on else "off"))
+        return f != None and f.get_frame()[1] == 1
+
+    def set_parameters(self, **params):
+        f = self.call(create_set_parameter(["%s=%s" % (k, v) for k, v in params.items()]))
+        return f != None
+
+    """
+    The ids of the parameters of the current function keyed on their names,
+    listed once. Refresh after changing the function.
+    """
+    def parameter_ids(self, refresh = False):
+        if refresh or self._parameter_ids == None:
+            f = self.call(create_cmd(cmd_list_parameters))
+            if f == None:
+                return None
+            (func, names) = unpack_list_parameters(f)
+            self._parameter_ids = dict((name, id) for (id, name) in enumerate(names))
+        return self._parameter_ids
+
+    """
+    Set parameters with the binary cmd_set_parameter_values, sparing the
+    device the string parsing. Returns the set_param_status_t of each
+    parameter keyed on its name, or None on timeout.
+    """
+    def set_parameter_values(self, **params):
+        ids = self.parameter_ids()
+        if ids == None:
+            return None
+        for name in params:
+            if name not in ids:
+                raise KeyError("no parameter '%s'" % (name))
+        names = list(params.keys())
+        f = self.call(create_set_parameter_values([(ids[name], params[name]) for name in names]))
+        if f == None:
+            return None
+        f.unpack8()
+        f.unpack8()
+        return dict((name, f.unpack8()) for name in names)
+
+    """
+    Get the values of the parameters of the current function keyed on their
+    names, or None on timeout
+    """
+    def get_parameter_values(self):
+        ids = self.parameter_ids()
+        f = self.call(create_cmd(cmd_get_parameter_values)) if ids != None else None
+        if f == None:
+            return None
+        names = dict((id, name) for (name, id) in ids.items())
+        values = unpack_parameter_values(f)
+        return dict((names.get(id, "param_%d" % (id)), value) for (id, value) in values.items())
+
+    def close(self):
+        self._running = False
+        self._thread.join(self._timeout * 2)
+        with self._lock:
+            for req in self._pending:
+                req.complete(None)
+            self._pending = []
+        self._interface.close()
+
+    """
+    Drop the requests that timed out, called with the lock taken
+    """
+    def _expire(self):
+        now = time.time()
+        expired = [req for req in self._pending if now - req.sent > self._timeout]
+        for req in expired:
+            self._pending.remove(req)
+            req.complete(None)
+        if expired:
+            self._lock.notify_all()
+
+    """
+    Find the request of a response, called with the lock taken
+    """
+    def _match(self, command, tag):
+        for i in range(len(self._pending)):
+            req = self._pending[i]
+            if req.command != command or req.tag != tag:
+                continue
+            if tag == None:
+                # Untagged responses come in order, the older untagged
+                # requests were lost
+                passed = [r for r in self._pending[:i] if r.tag == None]
+                for r in passed:
+                    self._pending.remove(r)
+                    r.complete(None)
+            self._pending.remove(req)
+            return req
+        return None
+
+    def _reader(self):
+        while self._running:
+            resp = self._interface.read()
+            with self._lock:
+                self._expire()
+            if len(resp) == 0:
+                continue
+            f = uFrame()
+            if f.set_frame(resp) < 0:
+                continue
+            command = f.get_frame()[0]
+            if not command & cmd_response:
+                if self._on_event:
+                    self._on_event(f)
+                continue
+            tag = untag_response(f)
+            command = f.get_frame()[0] ^ cmd_response
+            with self._lock:
+                req = self._match(command, tag)
+                if req:
+                    req.complete(f)
+                    self._lock.notify_all()
@@ -47,10 +47,14 @@ except:
     raise SystemExit()
 import threading
 import time
+import copy
+import shlex
+import struct
 from uhej import uhej
 from protocol import *
 import uframe
 import binascii
+import lz
 try:
     from PyCRC.CRCCCITT import CRCCCITT
 except:
@@ -61,6 +65,9 @@ import json
 
 parameters = []
 
+# Set to stop the streams of all devices when running on several at once
+stop_event = threading.Event()
+
 """
 An abstract class that describes a communication interface
 """
@@ -83,6 +90,9 @@ class comm_interface(object):
     def read(self):
         return bytearray()
 
+    def set_baudrate(self, baud):
+        return False
+
     def name(self):
         return self._if_name
 
@@ -92,25 +102,35 @@ A class that describes a serial interface
 class tty_interface(comm_interface):
 
     _port_handle = None
+    _baud = uart_default_baud
 
     def __init__(self, if_name):
         self._if_name = if_name
 
     def open(self):
-        self._port_handle = serial.Serial(baudrate = 115200, timeout = 1.0)
+        if self._port_handle:
+            return True # Already open, opening the port is slow
+        self._port_handle = serial.Serial(baudrate = self._baud, timeout = 1.0)
         self._port_handle.port = self._if_name
         self._port_handle.open()
         return True
 
     def close(self):
-        self._port_handle.port.close()
-        self._port_handle = None
+        if self._port_handle:
+            self._port_handle.close()
+            self._port_handle = None
         return True
 
     def write(self, bytes):
         self._port_handle.write(bytes)
         return True
 
+    def set_baudrate(self, baud):
+        self._baud = baud
+        if self._port_handle:
+            self._port_handle.baudrate = baud
+        return True
+
     def read(self):
         bytes = bytearray()
         sof = False
@@ -129,16 +149,21 @@ class tty_interface(comm_interface):
         return bytes
 
 """
-A class that describes a UDP interface
+A class that describes a UDP interface. The wifi proxy may coalesce frames
+sent back to back into one datagram, they are returned one by one.
 """
 class udp_interface(comm_interface):
 
     _socket = None
+    _frames = None
 
     def __init__(self, if_name):
         self._if_name = if_name
+        self._frames = []
 
     def open(self):
+        if self._socket:
+            return True
         try:
             self._socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
             self._socket.settimeout(1.0)
@@ -147,8 +172,9 @@ class udp_interface(comm_interface):
         return True
 
     def close(self):
-        self._socket.close()
-        self._socket = None
+        if self._socket:
+            self._socket.close()
+            self._socket = None
         return True
 
     def write(self, bytes):
@@ -159,17 +185,87 @@ class udp_interface(comm_interface):
         return True
 
     def read(self):
+        if self._frames:
+            return self._frames.pop(0)
         reply = bytearray()
         try:
-            d = self._socket.recvfrom(1000)
+            d = self._socket.recvfrom(2048)
             reply = bytearray(d[0])
             addr = d[1]
         except socket.timeout:
             pass
         except socket.error:
             pass
+        eof = reply.find(bytearray([uframe._EOF]))
+        if eof >= 0 and eof + 1 < len(reply):
+            # What follows the last EOF is not a frame
+            for frame in reply[eof + 1:].split(bytearray([uframe._EOF]))[:-1]:
+                sof = frame.find(bytearray([uframe._SOF]))
+                if sof >= 0:
+                    self._frames.append(frame[sof:] + bytearray([uframe._EOF]))
+            reply = reply[:eof + 1]
         return reply
 
+"""
+A class that describes a TCP interface to the wifi proxy. The connection is
+kept open, so streamed samples are not lost like datagrams may be.
+"""
+class tcp_interface(comm_interface):
+
+    _socket = None
+    _rx = None
+
+    def __init__(self, if_name):
+        self._if_name = if_name
+        self._rx = bytearray()
+
+    def open(self):
+        if self._socket:
+            return True
+        try:
+            self._socket = socket.create_connection((self._if_name, 5005), 5.0)
+            self._socket.settimeout(1.0)
+            self._socket.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        except socket.error:
+            self._socket = None
+            return False
+        return True
+
+    def close(self):
+        if self._socket:
+            self._socket.close()
+            self._socket = None
+        return True
+
+    def write(self, bytes):
+        try:
+            self._socket.sendall(bytes)
+        except socket.error as msg:
+            fail("%s" % (str(msg)))
+        return True
+
+    def read(self):
+        while True:
+            sof = self._rx.find(bytearray([uframe._SOF]))
+            if sof >= 0:
+                eof = self._rx.find(bytearray([uframe._EOF]), sof)
+                if eof >= 0:
+                    frame = self._rx[sof:eof + 1]
+                    self._rx = self._rx[eof + 1:]
+                    return frame
+                self._rx = self._rx[sof:]
+            else:
+                self._rx = bytearray()
+            try:
+                d = self._socket.recv(4096)
+            except socket.timeout:
+                return bytearray()
+            except socket.error:
+                return bytearray()
+            if not d:
+                fail("connection to %s closed" % (self._if_name))
+            self._rx += bytearray(d)
+
 """
 Print error message and exit with error
 """
@@ -187,6 +283,9 @@ def unit_name(unit):
     if unit == 2: return "W"
     if unit == 3: return "s"
     if unit == 4: return "Hz"
+    if unit == 6: return "ohm"
+    if unit == 7: return "C"
+    if unit == 8: return "Ah"
     return "unknown"
 
 """
@@ -216,7 +315,7 @@ def handle_response(command, frame, args):
         success = frame.get_frame()[1]
         if resp_command != command:
             print("Warning: sent command %02x, response was %02x." % (command, resp_command))
-        if resp_command !=  cmd_upgrade_start and resp_command != cmd_upgrade_data and not success:
+        if resp_command !=  cmd_upgrade_start and resp_command != cmd_upgrade_data and resp_command != cmd_set_baud and resp_command != cmd_stage_data and not success:
             fail("command failed according to device")
 
     if args.json:
@@ -253,10 +352,30 @@ def handle_response(command, frame, args):
         chunk_size = frame.unpack16()
         ret_dict["status"] = status
         ret_dict["chunk_size"] = chunk_size
+        frame.unpack8() # reason
+        if frame._unpack_pos < len(frame.get_frame()):
+            ret_dict["window"] = frame.unpack8()
+        if frame._unpack_pos < len(frame.get_frame()):
+            ret_dict["flags"] = frame.unpack8()
+            if ret_dict["flags"] & upgrade_flag_manifest:
+                ret_dict["page_same"] = [frame.unpack8() for i in range(upgrade_manifest_bitmap_size)]
     elif resp_command == cmd_upgrade_data:
         cmd = frame.unpack8()
         status = frame.unpack8()
         ret_dict["status"] = status
+        if frame._unpack_pos < len(frame.get_frame()):
+            ret_dict["offset"] = frame.unpack32()
+    elif resp_command == cmd_set_baud:
+        cmd = frame.unpack8()
+        ret_dict["status"] = frame.unpack8()
+    elif resp_command == cmd_stage_start or resp_command == cmd_stage_upgrade:
+        pass
+    elif resp_command == cmd_stage_data:
+        cmd = frame.unpack8()
+        ret_dict["status"] = frame.unpack8()
+        ret_dict["offset"] = frame.unpack32()
+    elif resp_command == cmd_stage_status:
+        ret_dict = unpack_stage_status(frame)
     elif resp_command == cmd_set_function:
         cmd = frame.unpack8()
         status = frame.unpack8()
@@ -293,7 +412,7 @@ def handle_response(command, frame, args):
             status = frame.unpack8()
             parts = p.split("=")
             # TODO: handle json output
-            print("%s: %s" % (parts[0], "ok" if status == 0 else "unknown parameter" if status == 1 else "out of range" if status == 2 else "unsupported parameter" if status == 3 else "unknown error %d" % (status)))
+            print("%s: %s" % (parts[0], "ok" if status == 0 else "unknown parameter" if status == 1 else "out of range" if status == 2 else "unsupported parameter" if status == 3 else "not applied" if status == 4 else "unknown error %d" % (status)))
     elif resp_command == cmd_list_parameters:
         cmd = frame.unpack8()
         status = frame.unpack8()
@@ -330,6 +449,88 @@ def handle_response(command, frame, args):
         pass
     elif resp_command == cmd_lock:
         pass
+    elif resp_command == cmd_stream_start:
+        pass
+    elif resp_command == cmd_stream_stop:
+        pass
+    elif resp_command == cmd_subscribe:
+        pass
+    elif resp_command == cmd_set_calibration:
+        pass
+    elif resp_command == cmd_set_sequence:
+        pass
+    elif resp_command == cmd_set_alarms:
+        pass
+    elif resp_command == cmd_wave:
+        pass
+    elif resp_command == cmd_mirror:
+        pass
+    elif resp_command == cmd_warm_reboot:
+        pass
+    elif resp_command == cmd_past_export:
+        ret_dict = unpack_past_export(frame)
+    elif resp_command == cmd_past_import:
+        pass
+    elif resp_command == cmd_arm:
+        cmd = frame.unpack8()
+        status = frame.unpack8()
+        if status == 0:
+            print("Error, failed to arm the setpoint.")
+    elif resp_command == cmd_fire:
+        cmd = frame.unpack8()
+        status = frame.unpack8()
+        if status == 0:
+            print("Error, the setpoint was not armed or was refused.")
+    elif resp_command == cmd_capture_arm:
+        cmd = frame.unpack8()
+        status = frame.unpack8()
+        ret_dict["capacity"] = frame.unpack16()
+    elif resp_command == cmd_capture_read:
+        ret_dict = unpack_capture_read(frame)
+    elif resp_command == cmd_histogram:
+        ret_dict = unpack_histogram(frame)
+    elif resp_command == cmd_histogram_limits:
+        ret_dict = unpack_histogram_limits(frame)
+    elif resp_command == cmd_energy_query:
+        data = unpack_energy_response(frame)
+        if args.json:
+            _json = data
+        else:
+            print("%-10s : %d.%03d Ah" % ('Charge', data['charge_uah']/1000000, (data['charge_uah']%1000000)/1000))
+            print("%-10s : %d.%03d Wh" % ('Energy', data['energy_mwh']/1000, data['energy_mwh']%1000))
+            print("%-10s : %d:%02d:%02d" % ('On time', data['on_time_s']/3600, (data['on_time_s']/60)%60, data['on_time_s']%60))
+    elif resp_command == cmd_stats:
+        data = unpack_stats(frame)
+        if args.json:
+            _json = data
+        elif data['status'] == 0:
+            print("Error, the window is out of range or the firmware was not built with STATS=1")
+        else:
+            print("%d scans, window of %d blocks of %d scans" % (data['scans'], data['blocks'], data['block_scans']))
+            print("%-8s %8s %8s %8s %8s %8s %10s" % ('', 'Min', 'Max', 'Mean', 'RMS', 'P-P', 'Ripple'))
+            for (channel, name, unit) in [('v_out', 'V_out', 'mV'), ('i_out', 'I_out', 'mA'), ('v_in', 'V_in', 'mV')]:
+                c = data[channel]
+                print("%-8s %8d %8d %8d %8d %8d %6d.%03d  %s" % (name, c['min'], c['max'], c['mean'], c['rms'], c['p2p'], c['ripple']/1000, c['ripple']%1000, unit))
+    elif resp_command == cmd_profile_dump:
+        data = unpack_profile_dump(frame)
+        if args.json:
+            _json = data
+        elif data['status'] == 0:
+            print("Device firmware was not built with PROFILING=1")
+        else:
+            print("%-15s %10s %10s %10s %10s %10s" % ('Point', 'Count', 'Min', 'Avg', 'Max', 'Max us'))
+            for name in profile_points:
+                if name in data['counters']:
+                    c = data['counters'][name]
+                    print("%-15s %10d %10d %10d %10d %10.1f" % (name, c['count'], c['min'], c['avg'], c['max'], c['max'] * 1000000.0 / cpu_clock_hz))
+    elif resp_command == cmd_stack_usage:
+        data = unpack_stack_usage(frame)
+        if args.json:
+            _json = data
+        elif data['status'] == 0:
+            print("Device firmware was not built with STACK_WATERMARK=1")
+        else:
+            print("Stack used %d of %d bytes (%d%%), %d bytes never touched" % (data['used'], data['size'], 100 * data['used'] / data['size'] if data['size'] else 0, data['size'] - data['used']))
     else:
         print("Unknown response %d from device." % (resp_command))
 
@@ -358,6 +559,8 @@ def communicate(comms, frame, args):
         fail("timeout talking to device %s" % (comms._if_name))
     elif args.verbose:
         print("RX %2d bytes [%s]\n" % (len(resp), " ".join("%02x" % b for b in resp)))
+    if not isinstance(comms, tty_interface):
+        registry_add(comms._if_name)
     if not comms.close:
         print("Warning: could not close %s" % (comms.name()))
 
@@ -368,15 +571,39 @@ def communicate(comms, frame, args):
     else:
         return handle_response(frame.get_frame()[1], f, args)
 
+"""
+Ask the device (or the bootloader) to change UART rate and follow it. The
+device reverts to uart_default_baud unless a frame arrives at the new rate
+within a second, so this must be followed by another command.
+Returns True if the rate was changed.
+"""
+def negotiate_baud(comms, baud, args):
+    if comms._baud == baud:
+        return True
+    ret_dict = communicate(comms, create_set_baud(baud), args)
+    if not ret_dict.get("status", 0):
+        print("Warning: device did not accept %d baud, staying at %d" % (baud, comms._baud))
+        return False
+    comms.set_baudrate(baud)
+    return True
+
 """
 Communicate with the DPS device according to the user's whishes
 """
-def handle_commands(args):
+def handle_commands(args, comms = None):
     if args.scan:
         uhej_scan()
         return
 
-    comms = create_comms(args)
+    if not comms:
+        comms = create_comms(args)
+
+    fast = False
+    if args.baud:
+        if isinstance(comms, tty_interface):
+            fast = negotiate_baud(comms, args.baud, args)
+        else:
+            print("Warning: --baud only applies to tty devices, the wifi proxy sets its own rate")
 
     if args.ping:
         communicate(comms, create_cmd(cmd_ping), args)
@@ -404,19 +631,1107 @@ def handle_commands(args):
         else:
             fail("enable is 'on' or 'off'")
 
-    if args.parameter:
+    if args.parameter and not args.arm and args.measure == None:
         payload = create_set_parameter(args.parameter)
         if payload:
             communicate(comms, payload, args)
         else:
             fail("malformatted parameters")
 
+    if args.enable_at:
+        run_enable_at(comms, args)
+
+    if args.arm:
+        run_arm(comms, args)
+
+    if args.sweep:
+        run_sweep(comms, args)
+    elif args.measure != None:
+        run_measure(comms, args)
+
+    if args.fire != None and isinstance(comms, tty_interface):
+        communicate(comms, create_fire(args.fire), args)
+
     if args.query:
         communicate(comms, create_cmd(cmd_query), args)
 
+    if args.energy:
+        if args.energy == 'show' or args.energy == 'reset':
+            communicate(comms, create_energy_query(args.energy == 'reset'), args)
+        else:
+            fail("energy is 'show' or 'reset'")
+
+    if args.stats:
+        if args.stats == 'show':
+            communicate(comms, create_stats(), args)
+        else:
+            parts = args.stats.split(",")
+            try:
+                block_scans, blocks = int(parts[0]), int(parts[1])
+                if len(parts) != 2:
+                    raise ValueError
+            except (ValueError, IndexError):
+                fail("stats is 'show' or <block scans>,<blocks>")
+            communicate(comms, create_stats(block_scans, blocks), args)
+
+    if args.profile:
+        if args.profile == 'show' or args.profile == 'reset':
+            communicate(comms, create_profile_dump(args.profile == 'reset'), args)
+        else:
+            fail("profile is 'show' or 'reset'")
+
+    if args.stack:
+        communicate(comms, create_stack_usage(), args)
+
+    if args.calibrate:
+        run_calibrate(comms, args)
+
+    if args.sequence:
+        run_sequence(comms, args)
+
+    if args.alarms:
+        run_alarms(comms, args)
+
+    if args.wave:
+        run_wave(comms, args)
+
+    if args.capture:
+        run_capture(comms, args)
+
+    if args.histogram:
+        run_histogram(comms, args)
+
+    if args.log:
+        run_log(comms, args)
+
+    if args.bench != None:
+        run_bench(comms, args)
+
+    if args.wait_alarm != None:
+        run_wait_alarm(comms, args)
+    elif args.subscribe:
+        run_subscribe(comms, args)
+    elif args.stream and args.bench == None:
+        run_stream(comms, args)
+
+    if args.mirror:
+        run_mirror(comms, args)
+
     if hasattr(args, 'temperature') and args.temperature:
         communicate(comms, create_temperature(float(args.temperature)), args)
 
+    if fast:
+        # Also confirms the new rate if no command was given
+        negotiate_baud(comms, uart_default_baud, args)
+
+    if args.backup:
+        run_backup(comms, args)
+
+    if args.restore:
+        run_restore(comms, args)
+
+    if args.reboot:
+        # The device is back at the default rate after the reboot
+        communicate(comms, create_cmd(cmd_warm_reboot), args)
+
+"""
+Read the settings of the device into the JSON file args.backup. The export
+is read again if the settings changed while reading it.
+"""
+def run_backup(comms, args):
+    for attempt in range(3):
+        export = bytearray()
+        first = communicate(comms, create_past_export(0), args)
+        resp = first
+        while True:
+            if resp['total'] != first['total'] or resp['crc'] != first['crc']:
+                break
+            export += resp['data']
+            if len(export) >= resp['total'] or not resp['data']:
+                break
+            resp = communicate(comms, create_past_export(len(export)), args)
+        crc = 0
+        for b in export:
+            crc = uframe.crc16_ccitt(crc, b)
+        if len(export) == first['total'] and crc == first['crc']:
+            break
+    else:
+        fail("the settings kept changing during the backup")
+    units = [{'id': id, 'name': past_device_units.get(id, ''), 'data': binascii.hexlify(data).decode()} for (id, data) in unpack_past_units(export)]
+    try:
+        with open(args.backup, "w") as f:
+            json.dump({'units': units}, f, indent=4, sort_keys=True)
+    except IOError as e:
+        fail("could not write %s (%s)" % (args.backup, str(e)))
+    print("Saved %d settings to %s" % (len(units), args.backup))
+
+"""
+Write the settings of the JSON backup given as <file>[,all] to the device
+in one transaction, after which it restarts. The calibration, the energy
+counters and the I_out offset belong to the device backed up and are only
+restored with 'all'.
+"""
+def run_restore(comms, args):
+    parts = args.restore.split(",")
+    restore_all = len(parts) > 1 and parts[1] == "all"
+    try:
+        with open(parts[0]) as f:
+            backup = json.load(f)
+        units = [(u['id'], bytearray(binascii.unhexlify(u['data']))) for u in backup['units']]
+    except (IOError, ValueError, KeyError, TypeError) as e:
+        fail("could not read the backup %s (%s)" % (parts[0], str(e)))
+    units = [(id, data) for (id, data) in units if restore_all or id not in past_device_units]
+    if not units:
+        fail("nothing to restore")
+    export = pack_past_units(units)
+    for offset in range(0, len(export), past_transfer_chunk):
+        communicate(comms, create_past_import(len(export), offset, export[offset:offset + past_transfer_chunk]), args)
+    print("Restored %d settings, the device restarts" % (len(units)))
+
+"""
+Upload a calibration table, given as <table>=<file> where the file holds one
+'<x> <y>' point per line, or <table>=clear to revert to the linear conversion
+"""
+def run_calibrate(comms, args):
+    parts = args.calibrate.split("=")
+    if len(parts) != 2 or parts[0] not in cal_tables:
+        fail("calibrate is <%s>=<file|clear>" % ("|".join(sorted(cal_tables.keys()))))
+    table = cal_tables[parts[0]]
+    points = []
+    if parts[1] != "clear":
+        try:
+            with open(parts[1]) as f:
+                for line in f:
+                    line = line.split("#")[0].strip()
+                    if line:
+                        (x, y) = line.split()
+                        points.append((int(x), int(y)))
+        except (IOError, ValueError):
+            fail("could not read calibration points from %s" % (parts[1]))
+        if len(points) < 2:
+            fail("a calibration table needs at least two points")
+    first = 0
+    while True:
+        chunk = points[first:first + cal_points_per_frame]
+        communicate(comms, create_set_calibration(table, len(points), first, chunk), args)
+        first += len(chunk)
+        if first >= len(points):
+            break
+    print("Calibration table %s %s" % (parts[0], "updated" if points else "cleared"))
+
+"""
+Upload a sequence for the seq function, given as <file>[,<repeat>] where the
+file holds one '<V_out mV> <I_out mA> <duration ms>' step per line and repeat
+is the number of runs (default 1, 0 for forever), or clear to erase it
+"""
+def run_sequence(comms, args):
+    parts = args.sequence.split(",")
+    steps = []
+    repeat = 1
+    try:
+        if len(parts) == 2:
+            repeat = int(parts[1])
+    except ValueError:
+        fail("sequence is <file>[,<repeat>] or clear")
+    if len(parts) > 2 or repeat < 0 or repeat > 255:
+        fail("sequence is <file>[,<repeat>] or clear, repeat being 0..255")
+    if parts[0] != "clear":
+        try:
+            with open(parts[0]) as f:
+                for line in f:
+                    line = line.split("#")[0].strip()
+                    if line:
+                        (v_out, i_out, duration) = line.split()
+                        steps.append((int(v_out), int(i_out), int(duration)))
+        except (IOError, ValueError):
+            fail("could not read sequence steps from %s" % (parts[0]))
+        if not steps:
+            fail("a sequence needs at least one step")
+    first = 0
+    while True:
+        chunk = steps[first:first + seq_steps_per_frame]
+        communicate(comms, create_set_sequence(len(steps), first, repeat, chunk), args)
+        first += len(chunk)
+        if first >= len(steps):
+            break
+    print("Sequence %s" % ("of %d steps uploaded" % (len(steps)) if steps else "cleared"))
+
+"""
+Return the function names of the device in index order
+"""
+def function_names(comms, args):
+    if not comms.open() or not comms.write(create_cmd(cmd_list_functions).get_frame()):
+        fail("could not talk to %s" % (comms.name()))
+    resp = comms.read()
+    f = uFrame()
+    if len(resp) == 0 or f.set_frame(resp) < 0 or f.get_frame()[0] != cmd_response | cmd_list_functions:
+        fail("could not list the functions of %s" % (comms.name()))
+    return unpack_list_functions(f)
+
+"""
+Upload alarm rules given as <file> holding one rule per line, or clear to
+remove them:
+  <channel> <below|above>[,on] <threshold> <hold ms> <action>
+channel being v_out (mV), i_out (mA), v_in (mV) or power (mW) and action
+notify, off, function,<name> or function-on,<name>. Rules with ',on' are
+only evaluated while power out is enabled. Every rule notifies the host
+when it fires, see --wait-alarm. Eg. 'i_out below,on 10 5000 off' disables
+power out once the device under test has drawn less than 10mA for 5s.
+"""
+def run_alarms(comms, args):
+    rules = []
+    names = None
+    if args.alarms != "clear":
+        try:
+            with open(args.alarms) as f:
+                for line in f:
+                    line = line.split("#")[0].strip()
+                    if not line:
+                        continue
+                    (channel, compare, threshold, hold_ms, action) = line.split()
+                    compare = compare.split(",")
+                    comp = {'below': alarm_below, 'above': alarm_above}[compare[0]]
+                    if len(compare) > 1:
+                        if compare[1] != "on" or len(compare) > 2:
+                            raise ValueError
+                        comp |= alarm_while_enabled
+                    action = action.split(",")
+                    function = 0
+                    if action[0] == "notify" or action[0] == "off":
+                        act = alarm_notify if action[0] == "notify" else alarm_disable_output
+                    elif action[0] == "function" or action[0] == "function-on":
+                        act = alarm_set_function if action[0] == "function" else alarm_set_function_on
+                        if names == None:
+                            names = function_names(comms, args)
+                        function = names.index(action[1])
+                    else:
+                        raise ValueError
+                    rules.append((alarm_channels[channel], comp, act, function, int(threshold), int(hold_ms)))
+        except IOError:
+            fail("could not read alarm rules from %s" % (args.alarms))
+        except (ValueError, KeyError, IndexError):
+            fail("alarm rules are '<channel> <below|above>[,on] <threshold> <hold ms> <action>', see --help")
+        if not rules:
+            fail("no alarm rules in %s" % (args.alarms))
+    first = 0
+    while True:
+        chunk = rules[first:first + alarm_rules_per_frame]
+        communicate(comms, create_set_alarms(len(rules), first, chunk), args)
+        first += len(chunk)
+        if first >= len(rules):
+            break
+    print("%s" % ("%d alarm rules uploaded" % (len(rules)) if rules else "Alarm rules cleared"))
+
+"""
+Wait for an alarm rule to fire, for at most the given number of seconds
+(0 for ever). Exits with status 1 on timeout.
+"""
+def run_wait_alarm(comms, args):
+    if not comms.open():
+        fail("could not open %s" % (comms.name()))
+    deadline = time.time() + args.wait_alarm if args.wait_alarm > 0 else None
+    try:
+        while not stop_event.is_set():
+            if deadline and time.time() > deadline:
+                fail("no alarm within %d seconds" % (args.wait_alarm))
+            resp = comms.read()
+            if len(resp) == 0:
+                continue
+            f = uFrame()
+            if f.set_frame(resp) < 0 or f.get_frame()[0] != cmd_alarm_event:
+                continue
+            f.unpack8()
+            (rule, value) = unpack_alarm_event(f)
+            if args.json:
+                print(json.dumps({'rule': rule, 'value': value}, sort_keys=True))
+            else:
+                print("Alarm rule %d fired at %d" % (rule, value))
+            return
+    except KeyboardInterrupt:
+        print("")
+
+"""
+Print the changes of the fields given as <field>[,<field>...], any of
+output, function, lock, setpoint, v_out, i_out and v_in, as the device
+reports them until interrupted. The measured fields are reported once they
+moved more than the --deadband. The first report holds all fields.
+"""
+def run_subscribe(comms, args):
+    fields = args.subscribe.split(",")
+    for field in fields:
+        if not field in notify_fields:
+            fail("subscribe to any of %s" % (",".join(notify_fields)))
+    try:
+        (deadband_mv, deadband_ma) = [int(x) for x in args.deadband.split(",")]
+    except ValueError:
+        fail("deadband is <mV>,<mA>")
+    names = function_names(comms, args) if 'function' in fields else []
+    # communicate() leaves the interface open, keep reading from it
+    communicate(comms, create_subscribe(fields, deadband_mv, deadband_ma), args)
+    try:
+        while not stop_event.is_set():
+            resp = comms.read()
+            if len(resp) == 0:
+                continue
+            f = uFrame()
+            if f.set_frame(resp) < 0 or f.get_frame()[0] != cmd_change_event:
+                continue
+            f.unpack8()
+            change = unpack_change_event(f)
+            if 'function' in change and change['function'] < len(names):
+                change['function'] = names[change['function']]
+            if args.json:
+                print(json.dumps(change, sort_keys=True))
+                continue
+            out = []
+            for key in sorted(change.keys()):
+                if key == 'output':
+                    out.append("output %s" % ("on" if change[key] else "off"))
+                elif key == 'lock':
+                    flags = [name for (bit, name) in [(notify_lock_ui, "ui"), (notify_lock_temperature, "temperature")] if change[key] & bit]
+                    out.append("lock %s" % (",".join(flags) if flags else "none"))
+                elif key == 'function':
+                    out.append("function %s" % (change[key]))
+                else:
+                    out.append("%s %d %s" % (key, change[key], "mA" if key.startswith("i_") else "mV"))
+            print("%.3f  %s" % (time.time(), "  ".join(out)))
+    except KeyboardInterrupt:
+        print("")
+    communicate(comms, create_subscribe([]), args)
+
+"""
+Play a waveform on V_out given as <shape>,<frequency Hz>,<offset mV>,<amplitude mV>
+or stop it with 'off'
+"""
+def run_wave(comms, args):
+    shapes = {'off': wave_off, 'sine': wave_sine, 'triangle': wave_triangle, 'square': wave_square}
+    parts = args.wave.split(",")
+    try:
+        shape = shapes[parts[0]]
+        if shape == wave_off:
+            frequency, offset, amplitude = 0, 0, 0
+        else:
+            frequency = int(round(float(parts[1]) * 1000))
+            offset = int(parts[2])
+            amplitude = int(parts[3])
+    except (KeyError, ValueError, IndexError):
+        fail("wave is off or <shape>,<frequency Hz>,<offset mV>,<amplitude mV>, shape being one of %s" % (", ".join(sorted(shapes.keys()))))
+    communicate(comms, create_wave(shape, frequency, offset, amplitude), args)
+
+"""
+Arm a waveform capture given as <trigger>[,<level>[,<decimation>[,<pre>]]],
+wait for it to trigger and print the samples. The sample times are estimates
+based on the nominal ADC scan rate.
+"""
+def run_capture(comms, args):
+    triggers = {'off': capture_trig_none, 'now': capture_trig_immediate, 'i_above': capture_trig_i_above, 'v_above': capture_trig_v_above, 'v_below': capture_trig_v_below, 'ocp': capture_trig_ocp, 'enable': capture_trig_enable, 'disable': capture_trig_disable}
+    parts = args.capture.split(",")
+    try:
+        trigger = triggers[parts[0]]
+        level = int(parts[1]) if len(parts) > 1 else 0
+        decimation = int(parts[2]) if len(parts) > 2 else 1
+        pre = int(parts[3]) if len(parts) > 3 else 64
+    except (KeyError, ValueError):
+        fail("capture is <trigger>[,<level>[,<decimation>[,<pre>]]], trigger being one of %s" % (", ".join(sorted(triggers.keys()))))
+    communicate(comms, create_capture_arm(trigger, level, decimation, pre), args)
+    if trigger == capture_trig_none:
+        return
+    try:
+        while True:
+            data = communicate(comms, create_capture_read(0), args)
+            if data['state'] == capture_done:
+                break
+            time.sleep(0.1)
+    except KeyboardInterrupt:
+        communicate(comms, create_capture_arm(capture_trig_none, 0, 0, 0), args)
+        print("")
+        return
+    samples = data['samples']
+    while len(samples) < data['count']:
+        samples += communicate(comms, create_capture_read(len(samples)), args)['samples']
+    period_us = 1000000.0 * data['decimation'] / adc_scan_rate_hz
+    for (index, s) in enumerate(samples):
+        s['time_us'] = int((index - data['trigger_index']) * period_us)
+        if args.json:
+            print(json.dumps(s, sort_keys=True))
+        else:
+            print("%10d  V_out %6d mV  I_out %5d mA  V_in %6d mV" % (s['time_us'], s['v_out'], s['i_out'], s['v_in']))
+
+"""
+Print the load profile of firmware built with HISTOGRAM=1, the bins holding
+samples and the time spent above the I_out limits. 'reset' clears the
+counters after printing them and <mA>[,<mA>...] sets the limits.
+"""
+def run_histogram(comms, args):
+    reset = args.histogram == 'reset'
+    limits = None
+    if args.histogram != 'show' and not reset:
+        try:
+            limits = [int(l) for l in args.histogram.split(",")]
+        except ValueError:
+            fail("histogram is 'show', 'reset' or <limit mA>[,<limit mA>...]")
+        if len(limits) > histogram_limits or min(limits) < 0 or max(limits) > 0xffff:
+            fail("at most %d limits of 0 to 65535 mA" % (histogram_limits))
+        limits += [0] * (histogram_limits - len(limits))
+    # The responses are printed as one JSON object at the end
+    quiet = copy.copy(args)
+    quiet.json = False
+    profile = {}
+    for (channel, name) in enumerate(histogram_channels):
+        profile[name] = []
+        for first in range(0, histogram_bins, histogram_bins_per_frame):
+            profile[name] += communicate(comms, create_histogram(channel, first), quiet)['samples']
+    data = communicate(comms, create_histogram_limits(reset, limits), quiet)
+    interval = data['interval_ms']
+    total = sum(profile['i_out'])
+    above = [l for l in data['limits'] if l['limit']]
+    if args.json:
+        bins = [{'from': histogram_bin_edge(b), 'v_out': profile['v_out'][b], 'i_out': profile['i_out'][b]} for b in range(histogram_bins)]
+        print(json.dumps({'interval_ms': interval, 'samples': total, 'bins': bins, 'limits': above}, sort_keys=True))
+        return
+    print("%d samples every %d ms, %s recorded" % (total, interval, duration(total * interval / 1000)))
+    for (name, unit) in [('v_out', 'mV'), ('i_out', 'mA')]:
+        print("%-8s %15s %10s %7s" % ('V_out' if name == 'v_out' else 'I_out', 'Range ' + unit, 'Time', '%'))
+        for b in range(histogram_bins):
+            count = profile[name][b]
+            if count == 0:
+                continue
+            top = "%d" % (histogram_bin_edge(b + 1) - 1) if b + 1 < histogram_bins else ""
+            print("%8s %7d-%-7s %10s %7.2f" % ('', histogram_bin_edge(b), top, duration(count * interval / 1000), 100.0 * count / total))
+    for l in above:
+        print("I_out above %d mA for %s (%.2f%%)" % (l['limit'], duration(l['above'] * interval / 1000), 100.0 * l['above'] / total if total else 0))
+
+"""
+Format seconds as [<days>d ]<hours>:<minutes>:<seconds>
+"""
+def duration(seconds):
+    text = "%d:%02d:%02d" % ((seconds / 3600) % 24, (seconds / 60) % 60, seconds % 60)
+    return "%dd %s" % (seconds / 86400, text) if seconds >= 86400 else text
+
+"""
+Stream telemetry from the device until interrupted
+"""
+def run_stream(comms, args):
+    parts = args.stream.split(",")
+    try:
+        interval = int(parts[0])
+        count = int(parts[1]) if len(parts) > 1 else 8
+    except ValueError:
+        fail("stream is <interval ms>[,<samples per frame>]")
+    # communicate() leaves the interface open, keep reading from it
+    communicate(comms, create_stream_start(interval, count), args)
+    try:
+        while not stop_event.is_set():
+            resp = comms.read()
+            if len(resp) == 0:
+                continue
+            f = uFrame()
+            if f.set_frame(resp) < 0 or f.get_frame()[0] != cmd_stream_data:
+                continue
+            for s in unpack_stream_data(f):
+                if args.json:
+                    print(json.dumps(s, sort_keys=True))
+                else:
+                    print("%10d  V_out %6d mV  I_out %5d mA  V_in %6d mV" % (s['timestamp'], s['v_out'], s['i_out'], s['v_in']))
+    except KeyboardInterrupt:
+        print("")
+    communicate(comms, create_cmd(cmd_stream_stop), args)
+
+"""
+Send a request and wait for its response, skipping the frames the device
+sends on its own. Returns the round trip time in seconds, or None if the
+response did not arrive within the read timeout of the interface or within
+two seconds of unsolicited frames.
+"""
+def bench_request(comms, frame):
+    command = frame.get_frame()[1]
+    start = time.time()
+    if not comms.write(frame.get_frame()):
+        fail("write failed on %s" % (comms.name()))
+    while time.time() - start < 2.0:
+        resp = comms.read()
+        if len(resp) == 0:
+            return None
+        f = uFrame()
+        if f.set_frame(resp) >= 0 and f.get_frame()[0] == cmd_response | command:
+            return time.time() - start
+    return None
+
+"""
+Summarize the round trip times of a benchmark phase, None standing for a
+timeout. The latencies are in milliseconds.
+"""
+def bench_summary(name, times, elapsed):
+    done = sorted([t * 1000 for t in times if t != None])
+    result = {'name': name, 'count': len(times), 'timeouts': len(times) - len(done)}
+    if done:
+        pick = lambda q: done[min(len(done) - 1, int(round(q * (len(done) - 1))))]
+        result['p50_ms'] = round(pick(0.50), 3)
+        result['p99_ms'] = round(pick(0.99), 3)
+        result['max_ms'] = round(done[-1], 3)
+        result['per_s'] = round(len(done) / elapsed, 1) if elapsed > 0 else 0
+    return result
+
+"""
+Measure the round trip latency of ping, query and set_parameters over
+args.bench iterations each, and the sustained rate of streamed frames, as
+set by --stream (5 ms, 8 samples per frame by default). The -p parameters
+are set in the set_parameters phase, by default the first parameter of the
+current function is set to its value. With --json the results are printed
+as one JSON object, to compare runs of the emulator before and after a
+change.
+"""
+def run_bench(comms, args):
+    iterations = args.bench
+    if iterations < 1:
+        fail("bench takes at least one iteration")
+    if not comms.open():
+        fail("could not open %s" % (comms.name()))
+    parameters = args.parameter
+    if not parameters:
+        comms.write(create_cmd(cmd_query).get_frame())
+        resp = comms.read()
+        f = uFrame()
+        if len(resp) == 0 or f.set_frame(resp) < 0 or f.get_frame()[0] != cmd_response | cmd_query:
+            fail("could not query %s" % (comms.name()))
+        params = unpack_query_response(f)['params']
+        parameters = ["%s=%s" % (k, params[k]) for k in sorted(params.keys())[:1]]
+    phases = [("ping", create_cmd(cmd_ping)), ("query", create_cmd(cmd_query))]
+    if parameters:
+        phases.append(("set_parameters", create_set_parameter(parameters)))
+    results = []
+    for (name, frame) in phases:
+        start = time.time()
+        times = [bench_request(comms, frame) for i in range(iterations)]
+        results.append(bench_summary(name, times, time.time() - start))
+
+    parts = (args.stream or "5,8").split(",")
+    try:
+        interval = int(parts[0])
+        count = int(parts[1]) if len(parts) > 1 else 8
+    except ValueError:
+        fail("stream is <interval ms>[,<samples per frame>]")
+    if bench_request(comms, create_stream_start(interval, count)) == None:
+        fail("could not start streaming on %s" % (comms.name()))
+    frames = samples = lost = first_samples = 0
+    first = last = None
+    next_timestamp = None
+    deadline = time.time() + iterations * interval * count / 1000.0 + 2.0
+    while frames < iterations and time.time() < deadline:
+        resp = comms.read()
+        f = uFrame()
+        if len(resp) == 0 or f.set_frame(resp) < 0 or f.get_frame()[0] != cmd_stream_data:
+            continue
+        batch = unpack_stream_data(f)
+        if not batch:
+            continue
+        last = time.time()
+        if first == None:
+            first = last
+            first_samples = len(batch)
+        elif batch[0]['timestamp'] != next_timestamp:
+            lost += 1
+        next_timestamp = batch[-1]['timestamp'] + interval
+        frames += 1
+        samples += len(batch)
+    bench_request(comms, create_cmd(cmd_stream_stop))
+    stream = {'name': "stream", 'interval_ms': interval, 'frames': frames, 'gaps': lost}
+    if frames > 1:
+        # The first frame starts the clock
+        stream['frames_per_s'] = round((frames - 1) / (last - first), 1)
+        stream['samples_per_s'] = round((samples - first_samples) / (last - first), 1)
+    results.append(stream)
+
+    if args.json:
+        print(json.dumps({'device': comms.name(), 'iterations': iterations, 'results': results}, sort_keys=True))
+        return
+    print("%-16s %6s %8s %9s %9s %9s %8s" % ("", "count", "timeouts", "p50 ms", "p99 ms", "max ms", "per s"))
+    for r in results[:-1]:
+        if 'p50_ms' in r:
+            print("%-16s %6d %8d %9.3f %9.3f %9.3f %8.1f" % (r['name'], r['count'], r['timeouts'], r['p50_ms'], r['p99_ms'], r['max_ms'], r['per_s']))
+        else:
+            print("%-16s %6d %8d %9s %9s %9s %8s" % (r['name'], r['count'], r['timeouts'], "-", "-", "-", "-"))
+    if 'frames_per_s' in stream:
+        print("stream           %d frames every %d ms: %.1f frames/s, %.1f samples/s, %d gaps" % (frames, interval * count, stream['frames_per_s'], stream['samples_per_s'], lost))
+    else:
+        print("stream           %d frames, too few to measure" % (frames))
+
+"""
+Text rendering of the mirrored display, the glyphs are kept by their position
+and each row of glyphs is printed as a line, highlighted glyphs in reverse
+video. Fills erase what they cover and blitted images are shown as '#'.
+"""
+class mirror_panel(object):
+
+    def __init__(self):
+        self.glyphs = {}
+        self.inverted = False
+
+    def _erase(self, x, y, w, h):
+        for pos in list(self.glyphs.keys()):
+            if x <= pos[0] < x + w and y <= pos[1] < y + h:
+                del self.glyphs[pos]
+
+    def apply(self, ops):
+        for op in ops:
+            if op[0] == mirror_op_clear:
+                self.glyphs = {}
+            elif op[0] == mirror_op_fill:
+                self._erase(*op[1:5])
+            elif op[0] == mirror_op_glyph:
+                (size, ch, x, y, w, h, highlight) = op[1:]
+                self._erase(x, y, w, h)
+                self.glyphs[(x, y)] = (ch, highlight)
+            elif op[0] == mirror_op_blit:
+                (x, y, w, h) = op[1:]
+                self._erase(x, y, w, h)
+                self.glyphs[(x, y)] = ('#', False)
+            elif op[0] == mirror_op_invert:
+                self.inverted = op[1] != 0
+
+    def render(self):
+        rows = {}
+        for (x, y), glyph in self.glyphs.items():
+            rows.setdefault(y, []).append((x, glyph))
+        lines = []
+        for y in sorted(rows.keys()):
+            line = ""
+            for x, (ch, highlight) in sorted(rows[y]):
+                line += "\033[7m%s\033[0m" % ch if highlight else ch
+            lines.append(line)
+        if self.inverted:
+            lines.append("(display inverted)")
+        return "\n".join(lines)
+
+"""
+Show a live text copy of the device's display until interrupted
+"""
+def run_mirror(comms, args):
+    communicate(comms, create_mirror(True), args)
+    panel = mirror_panel()
+    expected = None
+    try:
+        while not stop_event.is_set():
+            resp = comms.read()
+            if len(resp) == 0:
+                continue
+            f = uFrame()
+            if f.set_frame(resp) < 0 or f.get_frame()[0] != cmd_mirror_data:
+                continue
+            seq, ops = unpack_mirror_data(f)
+            if expected is not None and seq != expected:
+                # A frame was lost, have the device redraw everything
+                panel = mirror_panel()
+                expected = None
+                comms.write(create_mirror(True).get_frame())
+                continue
+            expected = (seq + 1) & 0xff
+            panel.apply(ops)
+            sys.stdout.write("\033[2J\033[H" + panel.render() + "\n")
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        print("")
+    # Frames already on their way may come before the response
+    comms.write(create_mirror(False).get_frame())
+    for i in range(10):
+        f = uFrame()
+        resp = comms.read()
+        if len(resp) == 0 or (f.set_frame(resp) >= 0 and f.get_frame()[0] == cmd_response | cmd_mirror):
+            break
+
+"""
+Writes logged samples to a CSV file, or a binary file if the name ends in
+.bin. The binary file starts with the magic DPSLOG1 and a newline, followed
+by little endian records of [timestamp ms:32] [V_out mV:16] [I_out mA:16]
+[V_in mV:16].
+"""
+class sample_log(object):
+
+    _magic = b"DPSLOG1\n"
+    _record = struct.Struct("<IHHH")
+
+    def __init__(self, file_name):
+        self._binary = file_name.endswith(".bin")
+        self._file = open(file_name, "wb" if self._binary else "w", 1 << 16)
+        if self._binary:
+            self._file.write(self._magic)
+        else:
+            self._file.write("timestamp_ms,v_out_mv,i_out_ma,v_in_mv\n")
+
+    def write(self, s):
+        if self._binary:
+            self._file.write(self._record.pack(s['timestamp'] & 0xffffffff, s['v_out'], s['i_out'], s['v_in']))
+        else:
+            self._file.write("%d,%d,%d,%d\n" % (s['timestamp'], s['v_out'], s['i_out'], s['v_in']))
+
+    def close(self):
+        self._file.close()
+
+"""
+Min, max and mean of the logged samples, and the energy delivered
+"""
+class sample_stats(object):
+
+    def __init__(self):
+        self.count = 0
+        self.missed = 0
+        self.energy_mws = 0.0
+        self._sum = {'v_out': 0, 'i_out': 0, 'v_in': 0}
+        self._min = {}
+        self._max = {}
+        self._prev = None
+
+    def add(self, s, interval):
+        if self._prev:
+            dt = s['timestamp'] - self._prev['timestamp']
+            if dt > interval:
+                self.missed += dt / interval - 1
+            self.energy_mws += s['v_out'] * s['i_out'] * dt / 1000000.0
+        for key in self._sum:
+            self._sum[key] += s[key]
+            self._min[key] = min(self._min.get(key, s[key]), s[key])
+            self._max[key] = max(self._max.get(key, s[key]), s[key])
+        self.count += 1
+        self._prev = s
+
+    def report(self):
+        print("%d samples logged, %d missed" % (self.count, self.missed))
+        if self.count == 0:
+            return
+        for key, unit in [('v_out', 'mV'), ('i_out', 'mA'), ('v_in', 'mV')]:
+            print("%-6s min %6d  max %6d  mean %8.1f %s" % (key, self._min[key], self._max[key], float(self._sum[key]) / self.count, unit))
+        print("Energy %.4f Wh" % (self.energy_mws / 3600000.0))
+
+"""
+Log the telemetry stream to a file until interrupted. Samples are read as
+fast as they arrive and written through a large buffer. With --decimate N,
+every N samples are averaged into one logged sample.
+"""
+def run_log(comms, args):
+    interval = stream_min_interval_ms
+    count = stream_max_samples
+    if args.stream:
+        parts = args.stream.split(",")
+        try:
+            interval = int(parts[0])
+            count = int(parts[1]) if len(parts) > 1 else count
+        except ValueError:
+            fail("stream is <interval ms>[,<samples per frame>]")
+    decimate = max(1, args.decimate)
+    log = sample_log(args.log)
+    stats = sample_stats()
+    acc = []
+    communicate(comms, create_stream_start(interval, count, max_bulk_frame_length), args)
+    try:
+        while not stop_event.is_set():
+            resp = comms.read()
+            if len(resp) == 0:
+                continue
+            f = uFrame()
+            if f.set_frame(resp) < 0 or f.get_frame()[0] != cmd_stream_data:
+                continue
+            for s in unpack_stream_data(f):
+                stats.add(s, interval)
+                if decimate == 1:
+                    log.write(s)
+                    continue
+                acc.append(s)
+                if len(acc) == decimate:
+                    avg = {'timestamp': acc[0]['timestamp']}
+                    for key in ['v_out', 'i_out', 'v_in']:
+                        avg[key] = sum(a[key] for a in acc) / decimate
+                    log.write(avg)
+                    acc = []
+    except KeyboardInterrupt:
+        print("")
+    communicate(comms, create_cmd(cmd_stream_stop), args)
+    log.close()
+    stats.report()
+
+"""
+Enable the output at the time args.enable_at. The frame is prepared and the
+interface opened before waiting, so every device of a fan-out is switched
+on within a few milliseconds of the others.
+"""
+def run_enable_at(comms, args):
+    frame = create_enable_output('on')
+    if not comms.open():
+        fail("could not open %s" % (comms.name()))
+    delay = args.enable_at - time.time()
+    if delay < 0:
+        fail("enable time passed %.3f s ago" % (-delay))
+    if delay > 0.05:
+        time.sleep(delay - 0.05)
+    while time.time() < args.enable_at:
+        pass
+    late = time.time() - args.enable_at
+    comms.write(frame.get_frame())
+    resp = comms.read()
+    if len(resp) == 0:
+        fail("timeout talking to device %s" % (comms._if_name))
+    f = uFrame()
+    if f.set_frame(resp) < 0:
+        fail("protocol error")
+    handle_response(frame.get_frame()[1], f, args)
+    if args.verbose:
+        print("Enabled %.1f ms after the set time" % (late * 1000))
+
+"""
+Arm the setpoint given by args.arm as <id>[,on|off], made of the parameters
+of args.parameter and the output state. The ids of the parameters are looked
+up first, as the armed values carry ids rather than names.
+"""
+def run_arm(comms, args):
+    parts = args.arm.split(",")
+    output = parts[1] if len(parts) > 1 else None
+    try:
+        arm_id = int(parts[0])
+    except ValueError:
+        arm_id = 0
+    if arm_id < 1 or arm_id > 255 or output not in [None, "on", "off"]:
+        fail("arm is <id>[,on|off], the id in 1..255")
+    communicate(comms, create_arm(arm_id, output, parameter_values(comms, args)), args)
+
+"""
+Return the parameter names of the current function in id order
+"""
+def parameter_names(comms, args):
+    if not comms.open():
+        fail("could not open %s" % (comms.name()))
+    comms.write(create_cmd(cmd_list_parameters).get_frame())
+    resp = comms.read()
+    f = uFrame()
+    if len(resp) == 0 or f.set_frame(resp) < 0:
+        fail("could not list the parameters of %s" % (comms.name()))
+    (func, names) = unpack_list_parameters(f)
+    return names
+
+"""
+Return the -p parameters as (id, value) tuples, for the commands taking
+parameter ids rather than names
+"""
+def parameter_values(comms, args):
+    values = []
+    if args.parameter:
+        names = parameter_names(comms, args)
+        for p in args.parameter:
+            parts = p.split("=")
+            if len(parts) != 2 or parts[0].strip() not in names:
+                fail("unknown parameter '%s'" % (p))
+            try:
+                values.append((names.index(parts[0].strip()), int(parts[1])))
+            except ValueError:
+                fail("parameters set by id take integer values")
+    return values
+
+"""
+Parse --measure, [<tolerance mV>[,<timeout ms>[,<samples>]]]
+"""
+def measure_settings(args):
+    settings = [10, 1000, 16]
+    try:
+        if args.measure:
+            parts = [int(x) for x in args.measure.split(",")]
+            if len(parts) > 3:
+                raise ValueError
+            settings[:len(parts)] = parts
+    except ValueError:
+        fail("measure is [<tolerance mV>[,<timeout ms>[,<samples>]]]")
+    if settings[1] < 0 or settings[1] > 0xffff or settings[2] < 1 or settings[2] > measure_max_samples:
+        fail("the measure timeout is at most 65535 ms and 1..%d samples are averaged" % (measure_max_samples))
+    return settings
+
+"""
+Apply the (id, value) tuples, wait for V_out to settle and return the
+averaged readings of one cmd_set_and_measure. The response takes as long
+as the settling, longer than the read timeout of the interfaces.
+"""
+def set_and_measure(comms, args, values, settings):
+    (tolerance, timeout, samples) = settings
+    frame = create_set_and_measure(tolerance, timeout, samples, None, values)
+    if not comms.open() or not comms.write(frame.get_frame()):
+        fail("could not talk to %s" % (comms.name()))
+    deadline = time.time() + (timeout + samples) / 1000.0 + 1.0
+    while time.time() < deadline:
+        resp = comms.read()
+        f = uFrame()
+        if len(resp) == 0 or f.set_frame(resp) < 0 or f.get_frame()[0] != cmd_response | cmd_set_and_measure:
+            continue
+        data = unpack_set_and_measure(f)
+        if data == None:
+            fail("the setpoint was refused or a measurement is running")
+        return data
+    fail("timeout talking to device %s" % (comms._if_name))
+
+"""
+Print the readings of a set and measure
+"""
+def print_measurement(data, args, prefix = ""):
+    if args.json:
+        print(json.dumps(data, sort_keys=True))
+    else:
+        settle = "settled in %d ms" % (data['settle_ms']) if data['settled'] else "not settled after %d ms" % (data['settle_ms'])
+        print("%sV_out %6d mV  I_out %5d mA  V_in %6d mV  %s" % (prefix, data['v_out'], data['i_out'], data['v_in'], settle))
+
+"""
+Apply the -p parameters, wait for V_out to settle and measure, in one round
+trip
+"""
+def run_measure(comms, args):
+    print_measurement(set_and_measure(comms, args, parameter_values(comms, args), measure_settings(args)), args)
+
+"""
+Step a parameter given as <name>,<from>,<to>,<step> and measure at every
+step once V_out has settled, as set by --measure
+"""
+def run_sweep(comms, args):
+    try:
+        (name, start, stop, step) = args.sweep.split(",")
+        (start, stop, step) = (int(start), int(stop), int(step))
+        if step == 0 or (stop - start) * step < 0:
+            raise ValueError
+    except ValueError:
+        fail("sweep is <parameter>,<from>,<to>,<step>")
+    names = parameter_names(comms, args)
+    if not name in names:
+        fail("unknown parameter '%s'" % (name))
+    settings = measure_settings(args)
+    try:
+        for value in range(start, stop + (1 if step > 0 else -1), step):
+            data = set_and_measure(comms, args, [(names.index(name), value)], settings)
+            if args.json:
+                data[name] = value
+            print_measurement(data, args, "%s %6d  " % (name, value))
+    except KeyboardInterrupt:
+        print("")
+
+"""
+Multicast a cmd_fire to the wifi proxies, which all forward it to their
+device at the same moment. Multicast is not acknowledged, so the datagram is
+repeated, a device firing only once per arming.
+"""
+def send_fire(arm_id, verbose):
+    frame = create_fire(arm_id).get_frame()
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_TTL, 32)
+    for i in range(3):
+        sock.sendto(frame, (fire_mcast_group, fire_mcast_port))
+        time.sleep(0.002)
+    sock.close()
+    if verbose:
+        print("Fired %d to %s:%d" % (arm_id, fire_mcast_group, fire_mcast_port))
+
+"""
+Parse the time of --enable-at, a UNIX time or +<seconds> from now
+"""
+def parse_enable_time(value):
+    try:
+        if value.startswith("+"):
+            return time.time() + float(value[1:])
+        return float(value)
+    except ValueError:
+        fail("enable time is a UNIX time or +<seconds>")
+
+"""
+Writes the output of each device thread on lines prefixed with the device
+name, so the output of parallel commands does not get mixed up
+"""
+class prefixed_output(object):
+
+    def __init__(self, out):
+        self._out = out
+        self._lock = threading.Lock()
+        self._local = threading.local()
+
+    def set_prefix(self, prefix):
+        self._local.prefix = prefix
+        self._local.line = ""
+
+    def write(self, text):
+        prefix = getattr(self._local, 'prefix', None)
+        if prefix is None:
+            self._out.write(text)
+            return
+        self._local.line += text
+        while "\n" in self._local.line:
+            line, self._local.line = self._local.line.split("\n", 1)
+            with self._lock:
+                self._out.write("%-15s %s\n" % (prefix, line))
+
+    def flush(self):
+        self._out.flush()
+
+"""
+Run the commands of args on each of the devices in parallel
+"""
+def handle_fan_out(devices, args):
+    output = prefixed_output(sys.stdout)
+    failed = []
+
+    def worker(device):
+        output.set_prefix(device)
+        dev_args = copy.copy(args)
+        dev_args.device = device
+        try:
+            handle_commands(dev_args)
+        except SystemExit as e:
+            if e.code:
+                failed.append(device)
+        except Exception as e:
+            print("Error: %s" % (str(e)))
+            failed.append(device)
+
+    threads = []
+    sys.stdout = output
+    try:
+        for device in devices:
+            t = threading.Thread(target = worker, args = (device,))
+            t.daemon = True
+            t.start()
+            threads.append(t)
+        for t in threads:
+            while t.is_alive():
+                t.join(0.1)
+    except KeyboardInterrupt:
+        # Let the streams stop themselves
+        stop_event.set()
+        for t in threads:
+            t.join(2.0)
+    finally:
+        sys.stdout = output._out
+    if failed:
+        fail("%d of %d devices failed (%s)" % (len(failed), len(devices), ", ".join(sorted(failed))))
+
+"""
+Read dpsctl command lines from stdin and run them on one connection, which
+stays open between the commands. Type quit or end the input to stop.
+"""
+def run_repl(parser, args):
+    comms = create_comms(args)
+    if not comms.open():
+        fail("could not open %s" % (comms.name()))
+    interactive = sys.stdin.isatty()
+    while True:
+        if interactive:
+            sys.stdout.write("dps> ")
+            sys.stdout.flush()
+        line = sys.stdin.readline()
+        if not line or line.strip() == "quit":
+            break
+        if not line.strip():
+            continue
+        try:
+            line_args, unknown = parser.parse_known_args(shlex.split(line))
+            line_args.json = line_args.json or args.json
+            line_args.verbose = line_args.verbose or args.verbose
+            if line_args.enable_at:
+                line_args.enable_at = parse_enable_time(line_args.enable_at)
+            handle_commands(line_args, comms)
+        except SystemExit:
+            pass # The error is printed, carry on with the next command
+        sys.stdout.flush()
+    comms.close()
+
 """
 Return True if the parameter if_name is an IP address.
 """
@@ -437,6 +1752,175 @@ def chunk_from_file(filename, chunk_size):
             else:
                 break
 
+"""
+Fail unless the upgrade status tells us to continue or that we are done
+"""
+def check_upgrade_status(status):
+    if status == upgrade_continue or status == upgrade_success:
+        return
+    print("")
+    if status == upgrade_crc_error:
+        fail("device reported CRC error")
+    elif status == upgrade_erase_error:
+        fail("device reported erasing error")
+    elif status == upgrade_flash_error:
+        fail("device reported flashing error")
+    elif status == upgrade_overflow_error:
+        fail("device reported firmware overflow error")
+    elif status == upgrade_protocol_error:
+        fail("device reported protocol error")
+    else:
+        fail("device reported an unknown error (%d)" % status)
+
+"""
+Return the crc of every whole page of the firmware for the upgrade manifest
+"""
+def upgrade_manifest(content):
+    num_pages = min(len(content) / upgrade_page_size, 8 * upgrade_manifest_bitmap_size)
+    return [CRCCCITT().calculate(content[i * upgrade_page_size:(i + 1) * upgrade_page_size]) for i in range(num_pages)]
+
+"""
+Return the set of chunks the device reported unchanged, that is chunks with
+only unchanged pages in the page_same bitmap
+"""
+def unchanged_chunks(page_same, chunk_size, num_chunks):
+    pages_per_chunk = chunk_size / upgrade_page_size
+    skipped = set()
+    for i in range(num_chunks):
+        pages = range(i * pages_per_chunk, (i + 1) * pages_per_chunk)
+        if all(p / 8 < len(page_same) and page_same[p / 8] & (1 << (p % 8)) for p in pages):
+            skipped.add(i)
+    return skipped
+
+"""
+Send the firmware with up to window chunks in flight. The device acks the
+number of bytes it has accepted, if an ack does not arrive in time we go back
+and resend from there. The chunks in skipped are not sent.
+"""
+def run_windowed_upgrade(comms, content, chunk_size, window, args, skipped = set()):
+    # The image ends with a chunk shorter than chunk_size, empty if need be
+    num_chunks = len(content) / chunk_size + 1
+    chunks = [i for i in range(num_chunks) if not i in skipped]
+    # Indices into chunks of the first chunk not acked and the next to send
+    acked = 0
+    sent = 0
+    timeouts = 0
+    if not comms.open():
+        fail("could not open %s" % (comms.name()))
+    while True:
+        while sent < len(chunks) and sent - acked < window:
+            offset = chunks[sent] * chunk_size
+            frame = create_upgrade_data(bytearray(content[offset:offset + chunk_size]), offset)
+            if not comms.write(frame.get_frame()):
+                fail("write failed on %s" % (comms.name()))
+            sent += 1
+        resp = comms.read()
+        if len(resp) == 0:
+            timeouts += 1
+            if timeouts > 5:
+                print("")
+                fail("timeout talking to device %s" % (comms._if_name))
+            sent = acked
+            continue
+        f = uFrame()
+        if f.set_frame(resp) < 0:
+            continue # The timeout takes care of it
+        ret_dict = handle_response(cmd_upgrade_data, f, args)
+        status = ret_dict["status"]
+        check_upgrade_status(status)
+        if status == upgrade_success:
+            print("")
+            break
+        timeouts = 0
+        while acked < len(chunks) and chunks[acked] * chunk_size < ret_dict["offset"]:
+            acked += 1
+        sent = max(sent, acked)
+        sys.stdout.write("\rDownload progress: %d%% " % (acked*100.0/len(chunks)))
+        sys.stdout.flush()
+    comms.close()
+
+"""
+Return the staging status of the wifi proxy of comms, or None if the proxy
+does not stage firmware. An older proxy hands cmd_stage_status to the DPS,
+which answers with status 0.
+"""
+def stage_status(comms, args):
+    if not comms.open():
+        fail("could not open %s" % (comms.name()))
+    if not comms.write(create_cmd(cmd_stage_status).get_frame()):
+        fail("write failed on %s" % (comms.name()))
+    resp = comms.read()
+    comms.close()
+    f = uFrame()
+    if len(resp) == 0 or f.set_frame(resp) < 0 or f.get_frame()[0] != cmd_response | cmd_stage_status or f.get_frame()[1] != 1:
+        return None
+    return unpack_stage_status(f)
+
+"""
+Send the firmware to the wifi proxy, which stores it and runs the upgrade
+on its UART. The chunks are sent with up to upgrade_max_window in flight
+and the proxy acks the number of bytes it has stored. We then follow the
+upgrade run by the proxy.
+Returns False if the proxy does not stage firmware.
+"""
+def run_staged_upgrade(comms, content, crc, args):
+    if stage_status(comms, args) == None:
+        return False
+    communicate(comms, create_stage_start(len(content), crc), args)
+    num_chunks = (len(content) + stage_max_chunk_size - 1) / stage_max_chunk_size
+    acked = 0
+    sent = 0
+    timeouts = 0
+    if not comms.open():
+        fail("could not open %s" % (comms.name()))
+    while acked < num_chunks:
+        while sent < num_chunks and sent - acked < upgrade_max_window:
+            offset = sent * stage_max_chunk_size
+            frame = create_stage_data(bytearray(content[offset:offset + stage_max_chunk_size]), offset)
+            if not comms.write(frame.get_frame()):
+                fail("write failed on %s" % (comms.name()))
+            sent += 1
+        resp = comms.read()
+        if len(resp) == 0:
+            timeouts += 1
+            if timeouts > 5:
+                print("")
+                fail("timeout talking to proxy %s" % (comms._if_name))
+            sent = acked
+            continue
+        f = uFrame()
+        if f.set_frame(resp) < 0:
+            continue # The timeout takes care of it
+        ret_dict = handle_response(cmd_stage_data, f, args)
+        if not ret_dict["status"]:
+            break # The status below tells why
+        timeouts = 0
+        acked = ret_dict["offset"] / stage_max_chunk_size if ret_dict["offset"] < len(content) else num_chunks
+        sent = max(sent, acked)
+        sys.stdout.write("\rStaging progress: %d%% " % (acked*100.0/num_chunks))
+        sys.stdout.flush()
+    comms.close()
+    print("")
+    status = stage_status(comms, args)
+    if status == None or status["state"] != stage_staged:
+        check_upgrade_status(status["upgrade_status"] if status else upgrade_protocol_error)
+        fail("the proxy did not stage the firmware")
+    communicate(comms, create_cmd(cmd_stage_upgrade), args)
+    while True:
+        time.sleep(0.25)
+        status = stage_status(comms, args)
+        if status == None:
+            continue # The proxy is busy, ask again
+        sys.stdout.write("\rDownload progress: %d%% " % (status["offset"]*100.0/status["length"]))
+        sys.stdout.flush()
+        if status["state"] == stage_done:
+            print("")
+            return True
+        if status["state"] != stage_upgrading:
+            check_upgrade_status(status["upgrade_status"])
+            print("")
+            fail("the proxy failed to upgrade the device")
+
 """
 Run OpenDPS firmware upgrade
 """
@@ -447,9 +1931,43 @@ def run_upgrade(comms, fw_file_name, args):
         if content.encode('hex')[6:8] != "20" and not args.force:
             fail("The firmware file does not seem valid, use --force to force upgrade")
         crc = CRCCCITT().calculate(content)
+    if not isinstance(comms, tty_interface) and not args.no_stage and run_staged_upgrade(comms, content, crc, args):
+        sys.exit(os.EX_OK)
     chunk_size = 1024
+    fast = isinstance(comms, tty_interface) and args.baud
+    if fast:
+        # The bootloader starts at the default rate after the app reboots
+        negotiate_baud(comms, uart_default_baud, args)
     ret_dict = communicate(comms, create_upgrade_start(chunk_size, crc), args)
-    if ret_dict["status"] == upgrade_continue:
+    if fast and ret_dict["status"] == upgrade_continue:
+        fast = negotiate_baud(comms, args.baud, args)
+    skipped = set()
+    if ret_dict["status"] == upgrade_continue and "window" in ret_dict:
+        # The bootloader takes larger chunks with several in flight, and
+        # tells which pages of the image it already has
+        chunk_size = upgrade_max_chunk_size
+        ret_dict = communicate(comms, create_upgrade_start(chunk_size, crc, upgrade_max_window, upgrade_flag_manifest, upgrade_manifest(content)), args)
+        chunk_size = ret_dict["chunk_size"]
+        if "page_same" in ret_dict:
+            skipped = unchanged_chunks(ret_dict["page_same"], chunk_size, len(content) / chunk_size + 1)
+            if len(skipped) > 0:
+                print("%d of %d bytes are unchanged" % (len(skipped) * chunk_size, len(content)))
+        if not args.no_compress and ret_dict["status"] == upgrade_continue:
+            compressed = lz.compress(content)
+            # Unchanged chunks cannot be skipped in a compressed image
+            if len(compressed) < len(content) - len(skipped) * chunk_size:
+                ret_dict = communicate(comms, create_upgrade_start(chunk_size, crc, upgrade_max_window, upgrade_flag_lz), args)
+                skipped = set()
+    if ret_dict["status"] != upgrade_continue:
+        fail("Device rejected firmware upgrade")
+    if ret_dict.get("window", 0) > 0:
+        if ret_dict.get("flags", 0) & upgrade_flag_lz:
+            stream = str(compressed)
+            print("Compressed %d bytes to %d" % (len(content), len(stream)))
+        else:
+            stream = content
+        run_windowed_upgrade(comms, stream, ret_dict["chunk_size"], ret_dict["window"], args, skipped)
+    else:
         if chunk_size != ret_dict["chunk_size"]:
             print("Device selected chunk size %d" % (ret_dict["chunk_size"]))
         counter = 0
@@ -461,29 +1979,22 @@ def run_upgrade(comms, fw_file_name, args):
 
             ret_dict = communicate(comms, create_upgrade_data(chunk), args)
             status = ret_dict["status"]
-            if status == upgrade_continue:
-                pass
-            elif status == upgrade_crc_error:
-                print("")
-                fail("device reported CRC error")
-            elif status == upgrade_erase_error:
-                print("")
-                fail("device reported erasing error")
-            elif status == upgrade_flash_error:
-                print("")
-                fail("device reported flashing error")
-            elif status == upgrade_overflow_error:
+            check_upgrade_status(status)
+            if status == upgrade_success:
                 print("")
-                fail("device reported firmware overflow error")
-            elif status == upgrade_success:
-                print("")
-            else:
-                print("")
-                fail("device reported an unknown error (%d)" % status)
-    else:
-        fail("Device rejected firmware upgrade")
     sys.exit(os.EX_OK)
 
+"""
+Return the interface for a device name: "tcp:" and an IP number for TCP, an
+IP number for UDP and anything else is taken as a serial port
+"""
+def interface_for(if_name):
+    if if_name.startswith("tcp:") and is_ip_address(if_name[4:]):
+        return tcp_interface(if_name[4:])
+    elif is_ip_address(if_name):
+        return udp_interface(if_name)
+    return tty_interface(if_name)
+
 """
 Create and return a comminications interface object or None if no comms if
 was specified.
@@ -497,20 +2008,79 @@ def create_comms(args):
         if_name = os.environ['DPSIF']
 
     if if_name != None:
-        if is_ip_address(if_name):
-            comms = udp_interface(if_name)
-        else:
-            comms = tty_interface(if_name)
+        comms = interface_for(if_name)
     else:
         fail("no comms interface specified")
     return comms
 
 """
-The worker thread used by uHej for service discovery
+The OpenDPS devices found on the network are kept between runs in
+registry_file, so -A and device names resolve without a scan. A device not
+heard from in registry_ttl_s is dropped. Names given with --name outlive
+the devices they point at.
+"""
+registry_file = os.environ.get("DPSCTL_REGISTRY", os.path.join(os.path.expanduser("~"), ".dpsctl-devices.json"))
+registry_ttl_s = 15 * 60
+registry_lock = threading.Lock()
+# IP numbers of the devices heard from during this run and when
+registry_seen = {}
+
+"""
+Return the registry as {"devices": {<IP number>: <last seen>}, "names":
+{<name>: <IP number>}}, without the expired devices
 """
-def uhej_worker_thread():
-    global discovery_list
-    global sock
+def registry_load():
+    try:
+        with open(registry_file) as f:
+            reg = json.load(f)
+    except (IOError, ValueError):
+        reg = {}
+    now = time.time()
+    reg["devices"] = dict((ip, t) for (ip, t) in reg.get("devices", {}).items() if now - t < registry_ttl_s)
+    reg["names"] = reg.get("names", {})
+    return reg
+
+"""
+Note that the device at the IP number answered or announced itself
+"""
+def registry_add(ip):
+    with registry_lock:
+        registry_seen[ip] = time.time()
+
+"""
+Merge the devices seen during this run, and the new names, into the registry
+file. Other dpsctl runs may have saved meanwhile, so the file is read again.
+"""
+def registry_save(names = {}):
+    with registry_lock:
+        seen = dict(registry_seen)
+    if not seen and not names:
+        return
+    reg = registry_load()
+    for ip in seen:
+        reg["devices"][ip] = max(seen[ip], reg["devices"].get(ip, 0))
+    reg["names"].update(names)
+    temp = registry_file + ".tmp"
+    try:
+        with open(temp, "w") as f:
+            json.dump(reg, f, indent=4, sort_keys=True)
+        os.rename(temp, registry_file)
+    except (IOError, OSError) as e:
+        print("Warning: could not save %s (%s)" % (registry_file, str(e)))
+
+"""
+Return the IP number a device name given with --name stands for, or the
+device as given. tcp: prefixed names resolve too.
+"""
+def registry_resolve(device, reg):
+    prefix = "tcp:" if device.startswith("tcp:") else ""
+    return prefix + reg["names"].get(device[len(prefix):], device[len(prefix):])
+
+"""
+The worker thread used by uHej for service discovery, recording the devices
+whose announcements arrive on sock until stopped
+"""
+def uhej_worker_thread(sock, found, verbose):
     while 1:
         try:
             data, addr = sock.recvfrom(1024)
@@ -524,25 +2094,25 @@ def uhej_worker_thread():
                 types = ["UDP", "TCP", "mcast"]
                 if uhej.ANNOUNCE == f["frame_type"]:
                     for s in f["services"]:
-                        key = "%s:%s:%s" % (f["source"], s["port"], s["type"])
-                        if not key in discovery_list:
-                            if s["service_name"] == "opendps":
-                                discovery_list[key] = True # Keep track of which hosts we have seen
-                                print("%s" % (f["source"]))
+                        if s["service_name"] == "opendps":
+                            registry_add(f["source"])
+                            if not f["source"] in found:
+                                found.add(f["source"]) # Keep track of which hosts we have seen
+                                if verbose[0]:
+                                    print("%s" % (f["source"]))
 #                            print("%16s:%-5d  %-8s %s" % (f["source"], s["port"], types[s["type"]], s["service_name"]))
             except uhej.IllegalFrameException as e:
                 pass
         except socket.error as e:
-            print('Exception'), e
+            return
 
 """
-Scan for OpenDPS devices on the local network
+Join the uHej multicast group and collect announcements in the background.
+Returns the socket, to send queries on, and the set of IP numbers found,
+which fills as the worker thread hears from devices. verbose is a list
+holding one flag so the caller can silence the printing.
 """
-def uhej_scan():
-    global discovery_list
-    global sock
-    discovery_list = {}
-
+def uhej_listen(verbose):
     ANY = "0.0.0.0"
     sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
     try:
@@ -552,12 +2122,34 @@ def uhej_scan():
     sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_TTL, 32)
     sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_LOOP, 1)
     sock.bind((ANY, uhej.MCAST_PORT))
+    sock.setsockopt(socket.SOL_IP, socket.IP_ADD_MEMBERSHIP, socket.inet_aton(uhej.MCAST_GRP) + socket.inet_aton(ANY))
 
-    thread = threading.Thread(target = uhej_worker_thread)
+    found = set()
+    thread = threading.Thread(target = uhej_worker_thread, args = (sock, found, verbose))
     thread.daemon = True
     thread.start()
+    return sock, found
 
-    sock.setsockopt(socket.SOL_IP, socket.IP_ADD_MEMBERSHIP, socket.inet_aton(uhej.MCAST_GRP) + socket.inet_aton(ANY))
+"""
+Scan for OpenDPS devices on the local network
+"""
+def uhej_scan():
+    num_found = len(uhej_discover(True))
+    registry_save()
+    if num_found == 0:
+        print("No OpenDPS devices found")
+    elif num_found == 1:
+        print("1 OpenDPS device found")
+    else:
+        print("%d OpenDPS devices found" % (num_found))
+
+"""
+Return the sorted IP numbers of the OpenDPS devices on the local network,
+printing them as they are found if verbose is set
+"""
+def uhej_discover(verbose):
+    verbose = [verbose]
+    sock, found = uhej_listen(verbose)
 
     run_time_s = 6 # Run query for this many seconds
     query_interval_s = 2 # Send query this often
@@ -571,13 +2163,38 @@ def uhej_scan():
             last_query = time.time()
         time.sleep(1)
 
-    num_found = len(discovery_list)
-    if num_found == 0:
-        print("No OpenDPS devices found")
-    elif num_found == 1:
-        print("1 OpenDPS device found")
-    else:
-        print("%d OpenDPS devices found" % (num_found))
+    verbose[0] = False
+    return sorted(found)
+
+"""
+Print the devices announcing themselves, as they answer the queries of
+other hosts or come up, without querying. The registry is saved as they are
+found, until interrupted.
+"""
+def uhej_passive():
+    sock, found = uhej_listen([True])
+    count = 0
+    while True:
+        time.sleep(1)
+        if len(found) != count:
+            count = len(found)
+            registry_save()
+
+"""
+Return the devices of the registry. If the registry is empty the network is
+scanned, otherwise the registry is refreshed in the background by one query
+while the commands run, for the next run to use.
+"""
+def registry_devices():
+    devices = sorted(registry_load()["devices"].keys())
+    if not devices:
+        return uhej_discover(False)
+    try:
+        sock, found = uhej_listen([False])
+        sock.sendto(uhej.query(uhej.UDP, "*"), (uhej.MCAST_GRP, uhej.MCAST_PORT))
+    except socket.error:
+        pass # Another scan holds the port, run without refreshing
+    return devices
 
 
 """
@@ -588,30 +2205,98 @@ def main():
     testing = '--testing' in sys.argv
     parser = argparse.ArgumentParser(description='Instrument an OpenDPS device')
 
-    parser.add_argument('-d', '--device', help="OpenDPS device to connect to. Can be a /dev/tty device or an IP number. If omitted, dpsctl.py will try the environment variable DPSIF", default='')
+    parser.add_argument('-d', '--device', help="OpenDPS device to connect to. Can be a /dev/tty device, an IP number or tcp:<IP number> for a persistent connection. Separate several devices with commas to run the command on all of them in parallel. If omitted, dpsctl.py will try the environment variable DPSIF", default='')
     parser.add_argument('-S', '--scan', action="store_true", help="Scan for OpenDPS wifi devices")
+    parser.add_argument('-A', '--all', action="store_true", help="Run the command on all OpenDPS wifi devices of the registry, scanning if it is empty")
+    parser.add_argument(      '--listen', action="store_true", help="Print OpenDPS wifi devices as they announce themselves, without scanning, and add them to the registry")
+    parser.add_argument(      '--name', type=str, help="Name the device given with -d, -d <name> then resolves from the registry")
+    parser.add_argument(      '--bench', type=int, nargs='?', const=200, help="Measure the latency of ping, query and set_parameters over N iterations (200) and the stream rate")
+    parser.add_argument(      '--repl', action="store_true", help="Read commands (dpsctl options) from stdin, one per line, and run them on a connection kept open")
     parser.add_argument('-f', '--function', nargs='?', help="Set active function")
     parser.add_argument('-F', '--list-functions', action='store_true', help="List available functions")
     parser.add_argument('-p', '--parameter', nargs='+', help="Set function parameter <name>=<value>")
     parser.add_argument('-P', '--list-parameters', action='store_true', help="List function parameters of active function")
     parser.add_argument('-o', '--enable', help="Enable output ('on' or 'off')")
+    parser.add_argument(      '--enable-at', type=str, help="Enable output at a UNIX time or in +<seconds>, after setting function and parameters. Synchronises several devices")
+    parser.add_argument(      '--measure', type=str, nargs='?', const="", help="Apply the -p parameters, wait for V_out to settle and measure in one round trip, optionally [<tolerance mV>[,<timeout ms>[,<samples>]]]")
+    parser.add_argument(      '--sweep', type=str, help="Step a parameter as <name>,<from>,<to>,<step> and measure at every step, see --measure")
+    parser.add_argument(      '--arm', type=str, help="Arm the -p parameters and output state as <id>[,on|off], applied by --fire. Arm each device first")
+    parser.add_argument(      '--fire', type=int, help="Apply the setpoint armed with this id, multicast to all wifi devices at once")
     parser.add_argument(      '--ping', action='store_true', help="Ping device (causes screen to flash)")
     parser.add_argument('-L', '--lock', action='store_true', help="Lock device keys")
     parser.add_argument('-l', '--unlock', action='store_true', help="Unlock device keys")
     parser.add_argument('-q', '--query', action='store_true', help="Query device settings and measurements")
+    parser.add_argument('-s', '--stream', type=str, help="Stream measurements, <interval ms>[,<samples per frame>]")
+    parser.add_argument(      '--log', type=str, help="Log the measurement stream to a CSV file, or a binary file if the name ends in .bin. The stream is set with --stream")
+    parser.add_argument(      '--decimate', type=int, default=1, help="Average every N streamed samples into one logged sample")
+    parser.add_argument(      '--alarms', type=str, help="Upload the alarm rules of a file for firmware built with ALARMS=1, or clear")
+    parser.add_argument(      '--wait-alarm', type=int, nargs='?', const=0, help="Wait for an alarm rule to fire, for at most the given seconds")
+    parser.add_argument(      '--subscribe', type=str, help="Print the changes of <field>[,<field>...] as the device reports them, fields being output, function, lock, setpoint, v_out, i_out and v_in")
+    parser.add_argument(      '--deadband', type=str, default="50,10", help="Smallest change of the measured voltages and currents --subscribe reports, <mV>,<mA>")
+    parser.add_argument(      '--sequence', type=str, help="Upload sequence for the seq function, <file>[,<repeat>] or clear")
+    parser.add_argument(      '--wave', type=str, help="Play a waveform on V_out, <sine|triangle|square>,<frequency Hz>,<offset mV>,<amplitude mV> or off")
+    parser.add_argument(      '--capture', type=str, help="Capture waveform, <trigger>[,<level mA/mV>[,<decimation>[,<pre samples>]]]")
+    parser.add_argument(      '--energy', nargs='?', const='show', help="Show charge and energy counters, 'reset' clears them after showing")
+    parser.add_argument(      '--histogram', nargs='?', const='show', help="Show the load profile of firmware built with HISTOGRAM=1, 'reset' clears it after showing, <mA>[,<mA>...] sets the I_out limits the time above is counted for")
+    parser.add_argument(      '--stats', nargs='?', const='show', help="Show the rolling statistics of firmware built with STATS=1, <block scans>,<blocks> sets the window and starts over")
+    parser.add_argument(      '--backup', type=str, help="Save the settings of firmware built with PAST_TRANSFER=1 to a file")
+    parser.add_argument(      '--restore', type=str, help="Restore the settings saved with --backup, <file>[,all]. 'all' includes the calibration, energy counters and I_out offset")
+    parser.add_argument(      '--reboot', action='store_true', help="Reboot the device, skipping the start up delays")
+    parser.add_argument(      '--mirror', action='store_true', help="Show a live copy of the display of firmware built with MIRROR=1")
+    parser.add_argument(      '--stack', action='store_true', help="Show the deepest stack use since reset of firmware built with STACK_WATERMARK=1")
+    parser.add_argument(      '--profile', nargs='?', const='show', help="Show cycle counters of firmware built with PROFILING=1, 'reset' clears them after showing")
+    parser.add_argument(      '--calibrate', type=str, help="Upload calibration table, <table>=<file> or <table>=clear")
     parser.add_argument('-j', '--json', action='store_true', help="Output parameters as JSON")
     parser.add_argument('-v', '--verbose', action='store_true', help="Verbose communications")
     parser.add_argument('-U', '--upgrade', type=str, dest="firmware", help="Perform upgrade of OpenDPS firmware")
     parser.add_argument(      '--force', action='store_true', help="Force upgrade even if dpsctl complains about the firmware")
+    parser.add_argument(      '--no-compress', action='store_true', help="Send the firmware uncompressed during upgrade")
+    parser.add_argument(      '--no-stage', action='store_true', help="Send the firmware chunk by chunk to the device, not staging it on the wifi proxy")
+    parser.add_argument(      '--baud', type=int, help="Switch a tty connection to this UART rate (230400, 460800 or 921600) for the duration of the command")
     if testing:
         parser.add_argument('-t', '--temperature', type=str, dest="temperature", help="Send temperature report (for testing)")
 
     args, unknown = parser.parse_known_args()
+    if args.enable_at:
+        args.enable_at = parse_enable_time(args.enable_at)
+
+    if args.listen:
+        try:
+            uhej_passive()
+        except KeyboardInterrupt:
+            print("")
+        return
+
+    registry = registry_load()
+    devices = [registry_resolve(d, registry) for d in args.device.split(",") if d]
+    if args.name:
+        if len(devices) != 1 or not is_ip_address(devices[0].split(":")[-1]):
+            fail("--name names one wifi device, given with -d")
+        registry_add(devices[0].split(":")[-1])
+        registry_save({args.name: devices[0].split(":")[-1]})
+    if args.all:
+        devices = registry_devices()
+        if not devices:
+            fail("no OpenDPS devices found")
 
     try:
-        handle_commands(args)
+        if args.repl:
+            if devices:
+                args.device = devices[0]
+            run_repl(parser, args)
+        elif len(devices) > 1:
+            handle_fan_out(devices, args)
+        elif devices or args.fire == None or 'DPSIF' in os.environ:
+            if devices:
+                args.device = devices[0]
+            handle_commands(args)
+        # The devices are all armed by now, fire them in one go
+        if args.fire != None and not any(not d.startswith("tcp:") and not is_ip_address(d) for d in devices):
+            send_fire(args.fire, args.verbose)
     except KeyboardInterrupt:
         print("")
+    finally:
+        registry_save()
 
 if __name__ == "__main__":
     main()
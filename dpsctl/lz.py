@@ -0,0 +1,111 @@
+"""
+The MIT License (MIT)
+
+Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+"""
+
+"""
+LZ compression of firmware images for upgrades, decoded by lz_decode() in
+opendps/lz.c. See the upgrade session section of opendps/protocol.h for the
+format, and opendps/tests/lz_test.c for the round trip test.
+"""
+
+MIN_MATCH = 3
+MAX_MATCH = 0x7f + MIN_MATCH
+MAX_LITERALS = 0x80
+MAX_DISTANCE = 0xffff
+
+# Number of earlier positions tried for every match
+MAX_CANDIDATES = 64
+
+"""
+Compress data, return the compressed bytearray
+"""
+def compress(data):
+    data = bytearray(data)
+    out = bytearray()
+    literals = bytearray()
+    chains = {}
+    pos = 0
+
+    def flush_literals():
+        while len(literals) > 0:
+            run = literals[:MAX_LITERALS]
+            out.append(len(run) - 1)
+            out.extend(run)
+            del literals[:MAX_LITERALS]
+
+    def insert(p):
+        if p + MIN_MATCH <= len(data):
+            key = bytes(data[p:p + MIN_MATCH])
+            chains.setdefault(key, []).append(p)
+
+    while pos < len(data):
+        best_len = 0
+        best_dist = 0
+        if pos + MIN_MATCH <= len(data):
+            candidates = chains.get(bytes(data[pos:pos + MIN_MATCH]), [])
+            for cand in reversed(candidates[-MAX_CANDIDATES:]):
+                if pos - cand > MAX_DISTANCE:
+                    break
+                length = 0
+                limit = min(MAX_MATCH, len(data) - pos)
+                while length < limit and data[cand + length] == data[pos + length]:
+                    length += 1
+                if length > best_len:
+                    best_len = length
+                    best_dist = pos - cand
+                    if length == limit:
+                        break
+        if best_len >= MIN_MATCH:
+            flush_literals()
+            out.append(0x80 | (best_len - MIN_MATCH))
+            out.append(best_dist >> 8)
+            out.append(best_dist & 0xff)
+            for p in range(pos, pos + best_len):
+                insert(p)
+            pos += best_len
+        else:
+            literals.append(data[pos])
+            insert(pos)
+            pos += 1
+    flush_literals()
+    return out
+
+"""
+Decompress data compressed by compress(), return the decompressed bytearray
+"""
+def decompress(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        c = data[i]
+        i += 1
+        if c & 0x80:
+            length = (c & 0x7f) + MIN_MATCH
+            distance = data[i] << 8 | data[i + 1]
+            i += 2
+            for n in range(length):
+                out.append(out[-distance])
+        else:
+            out.extend(data[i:i + c + 1])
+            i += c + 1
+    return out
@@ -23,6 +23,7 @@ THE SOFTWARE.
 """
 
 from uframe import *
+import struct
 
 # command_t
 cmd_ping = 1
@@ -41,8 +42,151 @@ cmd_list_functions = 13
 cmd_set_parameters = 14
 cmd_list_parameters = 15
 cmd_temperature_report = 16
+cmd_stream_start = 17
+cmd_stream_stop = 18
+cmd_stream_data = 19
+cmd_set_calibration = 20
+cmd_protection_event = 21
+cmd_set_sequence = 22
+cmd_energy_query = 23
+cmd_capture_arm = 24
+cmd_capture_read = 25
+cmd_profile_dump = 26
+cmd_set_parameter_values = 27
+cmd_get_parameter_values = 28
+cmd_temperature_event = 29
+cmd_set_baud = 30
+cmd_wave = 31
+cmd_stack_usage = 32
+cmd_mirror = 33
+cmd_mirror_data = 34
+cmd_warm_reboot = 35
+cmd_arm = 36
+cmd_fire = 37
+cmd_past_export = 38
+cmd_past_import = 39
+cmd_stats = 40
+cmd_set_alarms = 41
+cmd_alarm_event = 42
+cmd_stage_start = 43
+cmd_stage_data = 44
+cmd_stage_upgrade = 45
+cmd_stage_status = 46
+cmd_subscribe = 47
+cmd_change_event = 48
+cmd_set_and_measure = 49
+cmd_histogram = 50
+cmd_histogram_limits = 51
+cmd_tagged = 0x40
 cmd_response = 0x80
 
+# The UART rate the device and the bootloader start at, see protocol.h
+uart_default_baud = 115200
+
+# cmd_fire datagrams go to this multicast group, see "Armed setpoints" in protocol.h
+fire_mcast_group = "239.255.77.1"
+fire_mcast_port = 5007
+arm_output_unchanged = 0xff
+
+# Most readings a cmd_set_and_measure averages, see protocol.h
+measure_max_samples = 64
+
+# Sample batch delta escape, see protocol.h
+sample_delta_escape = 0x80
+
+# pwrctl_cal_table_t
+cal_tables = {'vout_adc': 0, 'vout_dac': 1, 'iout_adc': 2, 'iout_dac': 3}
+
+# Calibration points per cmd_set_calibration frame, see protocol.h
+cal_points_per_frame = 6
+
+# protection_event_t
+protection_ovp = 0
+protection_opp = 1
+
+# Sequence steps per cmd_set_sequence frame, see protocol.h
+seq_steps_per_frame = 3
+
+# Alarm rules per cmd_set_alarms frame, see protocol.h
+alarm_rules_per_frame = 2
+
+# alarm_channel_t, alarm_compare_t and alarm_action_t (alarm.h)
+alarm_channels = {'v_out': 0, 'i_out': 1, 'v_in': 2, 'power': 3}
+alarm_below = 0
+alarm_above = 1
+alarm_while_enabled = 0x80
+alarm_notify = 0
+alarm_disable_output = 1
+alarm_set_function = 2
+alarm_set_function_on = 3
+
+# notify_field_t (protocol.h), the bits of the cmd_subscribe field mask
+notify_fields = ['output', 'function', 'lock', 'setpoint', 'v_out', 'i_out', 'v_in']
+notify_lock_ui = 1 << 0
+notify_lock_temperature = 1 << 1
+
+# Settings bytes per cmd_past_export/cmd_past_import frame, see protocol.h
+past_transfer_chunk = 96
+
+# The past units of the settings, and the ones belonging to the particular
+# device (pastunits.h)
+past_boot_git_hash = 3
+past_app_git_hash = 4
+past_device_units = {5: 'calibration', 6: 'cal_v_out_adc', 7: 'cal_v_out_dac', 8: 'cal_i_out_adc', 9: 'cal_i_out_dac', 10: 'energy', 11: 'i_out_offset', 15: 'histogram'}
+
+# capture_trigger_t
+capture_trig_none = 0
+capture_trig_immediate = 1
+capture_trig_i_above = 2
+capture_trig_v_above = 3
+capture_trig_v_below = 4
+capture_trig_ocp = 5
+capture_trig_enable = 6
+capture_trig_disable = 7
+
+# mirror_op_t
+mirror_op_clear = 1
+mirror_op_fill = 2
+mirror_op_glyph = 3
+mirror_op_blit = 4
+mirror_op_invert = 5
+
+# wave_shape_t
+wave_off = 0
+wave_sine = 1
+wave_triangle = 2
+wave_square = 3
+
+# capture_state_t
+capture_idle = 0
+capture_armed = 1
+capture_triggered = 2
+capture_done = 3
+
+# Telemetry streaming limits, see protocol.h
+max_bulk_frame_length = 128
+stream_min_interval_ms = 5
+stream_max_samples = 32
+
+# Samples per cmd_capture_read response, see protocol.h
+capture_samples_per_frame = 16
+
+# The load profile, see protocol.h. histogram_channel_t, bins of each
+# channel, bins per cmd_histogram response and I_out limits
+histogram_channels = ['v_out', 'i_out']
+histogram_bins = 32
+histogram_bins_per_frame = 16
+histogram_limits = 4
+
+# Nominal rate of the ADC scans the capture samples are averaged from
+adc_scan_rate_hz = 21000
+
+# profile_point_t, in the order of the cmd_profile_dump counters
+profile_points = ['adc_isr', 'usart_isr', 'button_isr', 'spi_transceive', 'uui_refresh', 'handle_frame', 'past_write']
+
+# Core clock the profiling cycles are counted at
+cpu_clock_hz = 24000000
+
 # wifi_status_t
 wifi_off = 0
 wifi_connecting = 1
@@ -57,8 +201,31 @@ upgrade_crc_error = 2
 upgrade_erase_error = 3
 upgrade_flash_error = 4
 upgrade_overflow_error = 5
+upgrade_protocol_error = 6
 upgrade_success = 16
 
+# Largest upgrade chunk and number of chunks in flight dpsboot accepts
+upgrade_max_chunk_size = 2048
+upgrade_max_window = 4
+
+# Flags of cmd_upgrade_start
+upgrade_flag_lz = 1 << 0 # The image is sent LZ compressed
+upgrade_flag_manifest = 1 << 1 # Page crcs follow, unchanged chunks are not sent
+upgrade_page_size = 1024
+# Size of the bitmap of unchanged pages in the cmd_upgrade_start response
+upgrade_manifest_bitmap_size = 8
+
+# Largest chunk of a cmd_stage_data frame, see "Staged upgrades" in protocol.h
+stage_max_chunk_size = 1024
+
+# stage_state_t
+stage_idle = 0
+stage_receiving = 1
+stage_staged = 2
+stage_upgrading = 3
+stage_done = 4
+stage_failed = 5
+
 
 """
  Helpers for creating frames.
@@ -72,6 +239,22 @@ def create_response(command, success):
     f.end()
     return f
 
+"""
+Return a copy of a request frame carrying the tag, its response will carry
+the same tag (see "Tagged requests" in protocol.h)
+"""
+def create_tagged(frame, tag):
+    request = uFrame()
+    request.set_frame(bytearray(frame.get_frame()))
+    payload = request.get_frame()
+    f = uFrame()
+    f.pack8(payload[0] | cmd_tagged)
+    f.pack8(tag)
+    for b in payload[1:]:
+        f.pack8(b)
+    f.end()
+    return f
+
 def create_cmd(cmd):
     f = uFrame()
     f.pack8(cmd)
@@ -105,6 +288,69 @@ def create_set_parameter(parameter_list):
     f.end()
     return f
 
+# values is a list of (id, value) tuples, the id of a parameter being its
+# position in the cmd_list_parameters response
+def create_set_parameter_values(values):
+    f = uFrame()
+    f.pack8(cmd_set_parameter_values)
+    for (id, value) in values:
+        f.pack8(id)
+        f.pack32(int(value) & 0xffffffff)
+    f.end()
+    return f
+
+# values is a list of (id, value) tuples as for create_set_parameter_values,
+# output is 'on', 'off' or None to leave it
+def create_arm(arm_id, output, values):
+    f = uFrame()
+    f.pack8(cmd_arm)
+    f.pack8(arm_id)
+    f.pack8(arm_output_unchanged if output == None else (1 if output == "on" else 0))
+    for (id, value) in values:
+        f.pack8(id)
+        f.pack32(int(value) & 0xffffffff)
+    f.end()
+    return f
+
+# values and output as for create_arm, tolerance 0 waits timeout ms instead
+# of for V_out to settle
+def create_set_and_measure(tolerance_mv, timeout_ms, samples, output, values):
+    f = uFrame()
+    f.pack8(cmd_set_and_measure)
+    f.pack16(tolerance_mv)
+    f.pack16(timeout_ms)
+    f.pack8(samples)
+    f.pack8(arm_output_unchanged if output == None else (1 if output == "on" else 0))
+    for (id, value) in values:
+        f.pack8(id)
+        f.pack32(int(value) & 0xffffffff)
+    f.end()
+    return f
+
+def create_fire(arm_id):
+    f = uFrame()
+    f.pack8(cmd_fire)
+    f.pack8(arm_id)
+    f.end()
+    return f
+
+def create_past_export(offset):
+    f = uFrame()
+    f.pack8(cmd_past_export)
+    f.pack16(offset)
+    f.end()
+    return f
+
+def create_past_import(total, offset, data):
+    f = uFrame()
+    f.pack8(cmd_past_import)
+    f.pack16(total)
+    f.pack16(offset)
+    for b in data:
+        f.pack8(b)
+    f.end()
+    return f
+
 def create_query_response(v_in, v_out_setting, v_out, i_out, i_limit, power_enabled):
     f = uFrame()
     f.pack8(cmd_response | cmd_query)
@@ -124,6 +370,23 @@ def create_wifi_status(wifi_status):
     f.end()
     return f
 
+def create_set_baud(baud):
+    f = uFrame()
+    f.pack8(cmd_set_baud)
+    f.pack32(baud)
+    f.end()
+    return f
+
+def create_wave(shape, frequency_mhz, offset_mv, amplitude_mv):
+    f = uFrame()
+    f.pack8(cmd_wave)
+    f.pack8(shape)
+    f.pack32(frequency_mhz)
+    f.pack16(offset_mv)
+    f.pack16(amplitude_mv)
+    f.end()
+    return f
+
 def create_lock(locked):
     f = uFrame()
     f.pack8(cmd_lock)
@@ -138,22 +401,200 @@ def create_ocp(i_cut):
     f.end()
     return f
 
-def create_upgrade_start(window_size, crc):
+def create_protection_event(protection, value):
+    f = uFrame()
+    f.pack8(cmd_protection_event)
+    f.pack8(protection)
+    f.pack32(value)
+    f.end()
+    return f
+
+def create_upgrade_start(chunk_size, crc, window = None, flags = None, manifest = None):
     f = uFrame()
     f.pack8(cmd_upgrade_start)
-    f.pack16(window_size)
+    f.pack16(chunk_size)
     f.pack16(crc)
+    if window != None:
+        f.pack8(window)
+        if flags != None:
+            f.pack8(flags)
+            if manifest:
+                for page_crc in manifest:
+                    f.pack16(page_crc)
     f.end()
     return f
 
-def create_upgrade_data(data):
+def create_upgrade_data(data, offset = None):
     f = uFrame()
     f.pack8(cmd_upgrade_data)
+    if offset != None:
+        f.pack32(offset)
     for d in data:
         f.pack8(d)
     f.end()
     return f
 
+def create_stage_start(length, crc):
+    f = uFrame()
+    f.pack8(cmd_stage_start)
+    f.pack32(length)
+    f.pack16(crc)
+    f.end()
+    return f
+
+def create_stage_data(data, offset):
+    f = uFrame()
+    f.pack8(cmd_stage_data)
+    f.pack32(offset)
+    for d in data:
+        f.pack8(d)
+    f.end()
+    return f
+
+def create_stream_start(interval_ms, count, frame_size = None):
+    f = uFrame()
+    f.pack8(cmd_stream_start)
+    f.pack16(interval_ms)
+    f.pack8(count)
+    if frame_size:
+        f.pack16(frame_size)
+    f.end()
+    return f
+
+# points is a list of (x, y) tuples, first is the index of points[0] in the table
+def create_set_calibration(table, total, first, points):
+    f = uFrame()
+    f.pack8(cmd_set_calibration)
+    f.pack8(table)
+    f.pack8(total)
+    f.pack8(first)
+    for (x, y) in points:
+        f.pack16(x)
+        f.pack16(y)
+    f.end()
+    return f
+
+def create_set_sequence(total, first, repeat, steps):
+    f = uFrame()
+    f.pack8(cmd_set_sequence)
+    f.pack8(total)
+    f.pack8(first)
+    f.pack8(repeat)
+    for (v_out, i_out, duration) in steps:
+        f.pack16(v_out)
+        f.pack16(i_out)
+        f.pack32(duration)
+    f.end()
+    return f
+
+# The rules are (channel, compare, action, function, threshold, hold ms)
+def create_set_alarms(total, first, rules):
+    f = uFrame()
+    f.pack8(cmd_set_alarms)
+    f.pack8(total)
+    f.pack8(first)
+    for (channel, compare, action, function, threshold, hold_ms) in rules:
+        f.pack8(channel)
+        f.pack8(compare)
+        f.pack8(action)
+        f.pack8(function)
+        f.pack32(threshold)
+        f.pack32(hold_ms)
+    f.end()
+    return f
+
+# fields is a list of names of notify_fields, an empty list unsubscribes
+def create_subscribe(fields, deadband_mv = 0, deadband_ma = 0):
+    f = uFrame()
+    f.pack8(cmd_subscribe)
+    mask = 0
+    for field in fields:
+        mask |= 1 << notify_fields.index(field)
+    f.pack8(mask)
+    f.pack16(deadband_mv)
+    f.pack16(deadband_ma)
+    f.end()
+    return f
+
+# Without arguments the window is left as it is
+def create_stats(block_scans = None, blocks = None):
+    f = uFrame()
+    f.pack8(cmd_stats)
+    if block_scans != None:
+        f.pack16(block_scans)
+        f.pack8(blocks)
+    f.end()
+    return f
+
+def create_energy_query(reset):
+    f = uFrame()
+    f.pack8(cmd_energy_query)
+    f.pack8(1 if reset else 0)
+    f.end()
+    return f
+
+def create_capture_arm(trigger, level, decimation, pre):
+    f = uFrame()
+    f.pack8(cmd_capture_arm)
+    f.pack8(trigger)
+    f.pack16(level)
+    f.pack16(decimation)
+    f.pack16(pre)
+    f.end()
+    return f
+
+def create_capture_read(offset):
+    f = uFrame()
+    f.pack8(cmd_capture_read)
+    f.pack16(offset)
+    f.end()
+    return f
+
+def create_histogram(channel, first):
+    f = uFrame()
+    f.pack8(cmd_histogram)
+    f.pack8(channel)
+    f.pack8(first)
+    f.end()
+    return f
+
+# Without limits they are left as they are
+def create_histogram_limits(reset, limits = None):
+    f = uFrame()
+    f.pack8(cmd_histogram_limits)
+    f.pack8(1 if reset else 0)
+    if limits != None:
+        for limit in limits:
+            f.pack16(limit)
+    f.end()
+    return f
+
+# Lower edge of a bin of the load profile, in mV or mA
+def histogram_bin_edge(bin):
+    if bin < 4:
+        return bin
+    return (2 + (bin & 1)) << ((bin >> 1) - 1)
+
+def create_mirror(enable):
+    f = uFrame()
+    f.pack8(cmd_mirror)
+    f.pack8(1 if enable else 0)
+    f.end()
+    return f
+
+def create_stack_usage():
+    f = uFrame()
+    f.pack8(cmd_stack_usage)
+    f.end()
+    return f
+
+def create_profile_dump(reset):
+    f = uFrame()
+    f.pack8(cmd_profile_dump)
+    f.pack8(1 if reset else 0)
+    f.end()
+    return f
+
 def create_temperature(temperature):
     print("Sending temperature %.1f and %.1f" % (temperature, -temperature))
     temperature = int(10 * temperature)
@@ -228,6 +669,277 @@ def unpack_lock(uframe):
 def unpack_ocp(uframe):
     return uframe.unpack16()
 
+# Returns (protection, value)
+def unpack_protection_event(uframe):
+    protection = uframe.unpack8()
+    value = uframe.unpack32()
+    return (protection, value)
+
+# Returns (alarm, temp1, temp2), the temperatures x10
+def unpack_temperature_event(uframe):
+    alarm = uframe.unpack8()
+    temp1 = uframe.unpack16()
+    temp2 = uframe.unpack16()
+    return (alarm, temp1 - 0x10000 if temp1 & 0x8000 else temp1, temp2 - 0x10000 if temp2 & 0x8000 else temp2)
+
+# Returns (rule, value), the value being the reading that fired the rule
+def unpack_alarm_event(uframe):
+    rule = uframe.unpack8()
+    value = uframe.unpack32()
+    return (rule, value)
+
+# Returns a dict of the fields that changed, keyed by their names in
+# notify_fields, the setpoint being split in v_out_setting and i_out_setting
+def unpack_change_event(uframe):
+    changed = uframe.unpack8()
+    data = {}
+    for (bit, field) in enumerate(notify_fields):
+        if not changed & (1 << bit):
+            continue
+        if field == 'setpoint':
+            data['v_out_setting'] = uframe.unpack16()
+            data['i_out_setting'] = uframe.unpack16()
+        elif bit < notify_fields.index('setpoint'):
+            data[field] = uframe.unpack8()
+        else:
+            data[field] = uframe.unpack16()
+    return data
+
+# Returns the function names in index order
+def unpack_list_functions(uframe):
+    uframe.unpack8()
+    names = []
+    if uframe.unpack8() == 0:
+        return names
+    while not uframe.eof():
+        name = uframe.unpack_cstr()
+        if name == "":
+            break
+        names.append(name)
+    return names
+
+# Strips the tag of a tagged response so it unpacks like an untagged one,
+# returns the tag or None if the response was not tagged
+def untag_response(uframe):
+    payload = uframe.get_frame()
+    if len(payload) < 2 or not payload[0] & cmd_tagged:
+        return None
+    tag = payload[1]
+    uframe._frame = bytearray([payload[0] & ~cmd_tagged]) + bytearray(payload[2:])
+    return tag
+
+# Returns a dictionary of the frame contents, the samples being a list of
+# dictionaries
+def unpack_capture_read(uframe):
+    data = {}
+    data['command'] = uframe.unpack8()
+    data['status'] = uframe.unpack8()
+    data['state'] = uframe.unpack8()
+    data['count'] = uframe.unpack16()
+    data['trigger_index'] = uframe.unpack16()
+    data['decimation'] = uframe.unpack16()
+    data['offset'] = uframe.unpack16()
+    data['samples'] = []
+    while not uframe.eof():
+        sample = {}
+        sample['v_out'] = uframe.unpack16()
+        sample['i_out'] = uframe.unpack16()
+        sample['v_in'] = uframe.unpack16()
+        data['samples'].append(sample)
+    return data
+
+# Returns a dictionary of the frame contents
+def unpack_histogram(uframe):
+    data = {}
+    data['command'] = uframe.unpack8()
+    data['status'] = uframe.unpack8()
+    data['interval_ms'] = uframe.unpack16()
+    data['channel'] = uframe.unpack8()
+    data['first'] = uframe.unpack8()
+    data['samples'] = []
+    while not uframe.eof():
+        data['samples'].append(uframe.unpack32())
+    return data
+
+# Returns a dictionary of the frame contents, the limits being a list of
+# dictionaries
+def unpack_histogram_limits(uframe):
+    data = {}
+    data['command'] = uframe.unpack8()
+    data['status'] = uframe.unpack8()
+    data['interval_ms'] = uframe.unpack16()
+    data['limits'] = []
+    while not uframe.eof():
+        limit = {}
+        limit['limit'] = uframe.unpack16()
+        limit['above'] = uframe.unpack32()
+        data['limits'].append(limit)
+    return data
+
+# Returns a dictionary of the frame contents
+def unpack_energy_response(uframe):
+    data = {}
+    data['command'] = uframe.unpack8()
+    data['status'] = uframe.unpack8()
+    data['charge_uah'] = uframe.unpack32()
+    data['energy_mwh'] = uframe.unpack32()
+    data['on_time_s'] = uframe.unpack32()
+    return data
+
+# Returns a dictionary of the frame contents
+def unpack_stage_status(uframe):
+    data = {}
+    data['command'] = uframe.unpack8()
+    data['status'] = uframe.unpack8()
+    data['state'] = uframe.unpack8()
+    data['upgrade_status'] = uframe.unpack8()
+    data['offset'] = uframe.unpack32()
+    data['length'] = uframe.unpack32()
+    return data
+
+# Returns a dictionary of the frame contents, the statistics of each channel
+# keyed on its name
+def unpack_stats(uframe):
+    data = {}
+    data['command'] = uframe.unpack8()
+    data['status'] = uframe.unpack8()
+    data['block_scans'] = uframe.unpack16()
+    data['blocks'] = uframe.unpack8()
+    data['scans'] = uframe.unpack32()
+    for channel in ['v_out', 'i_out', 'v_in']:
+        c = {}
+        c['min'] = uframe.unpack16()
+        c['max'] = uframe.unpack16()
+        c['mean'] = uframe.unpack16()
+        c['rms'] = uframe.unpack16()
+        c['ripple'] = uframe.unpack32()
+        c['p2p'] = c['max'] - c['min']
+        data[channel] = c
+    return data
+
+# Returns the current function and the names of its parameters, in id order
+def unpack_list_parameters(uframe):
+    uframe.unpack8()
+    if uframe.unpack8() == 0:
+        return (None, [])
+    cur_func = uframe.unpack_cstr()
+    names = []
+    while not uframe.eof():
+        names.append(uframe.unpack_cstr())
+        uframe.unpack8()
+        uframe.unpack8()
+    return (cur_func, names)
+
+# Returns a dict of the averaged readings, or None if the setpoint was refused
+def unpack_set_and_measure(uframe):
+    uframe.unpack8()
+    if uframe.unpack8() == 0:
+        return None
+    data = {}
+    data['settled'] = uframe.unpack8() != 0
+    data['settle_ms'] = uframe.unpack16()
+    data['v_out'] = uframe.unpack16()
+    data['i_out'] = uframe.unpack16()
+    data['v_in'] = uframe.unpack16()
+    return data
+
+# Returns a dictionary of the parameter values keyed on their ids
+def unpack_parameter_values(uframe):
+    values = {}
+    uframe.unpack8()
+    if uframe.unpack8() == 0:
+        return values
+    while not uframe.eof():
+        id = uframe.unpack8()
+        value = uframe.unpack32()
+        values[id] = value - (1 << 32) if value & 0x80000000 else value
+    return values
+
+# Returns a dictionary of the frame contents, the counters being keyed on
+# the profile_points names
+def unpack_profile_dump(uframe):
+    data = {}
+    data['command'] = uframe.unpack8()
+    data['status'] = uframe.unpack8()
+    data['counters'] = {}
+    if data['status'] == 0:
+        return data
+    num = uframe.unpack8()
+    for i in range(num):
+        counter = {}
+        counter['count'] = uframe.unpack32()
+        counter['min'] = uframe.unpack32()
+        counter['avg'] = uframe.unpack32()
+        counter['max'] = uframe.unpack32()
+        name = profile_points[i] if i < len(profile_points) else "point_%d" % (i)
+        data['counters'][name] = counter
+    return data
+
+# Returns the sequence number and a list of the drawing commands of a
+# cmd_mirror_data frame, each a tuple of the mirror_op_t and its arguments
+def unpack_mirror_data(uframe):
+    uframe.unpack8() # command
+    seq = uframe.unpack8()
+    sizes = {mirror_op_clear: 0, mirror_op_fill: 5, mirror_op_glyph: 7, mirror_op_blit: 4, mirror_op_invert: 1}
+    ops = []
+    while not uframe.eof():
+        op = uframe.unpack8()
+        if op not in sizes:
+            break
+        args = [uframe.unpack8() for i in range(sizes[op])]
+        if op == mirror_op_fill:
+            args = args[:4] + [(args[4] << 8) | uframe.unpack8()]
+        elif op == mirror_op_glyph:
+            args[1] = chr(args[1])
+        ops.append(tuple([op] + args))
+    return seq, ops
+
+# Returns a dictionary of the frame contents
+def unpack_stack_usage(uframe):
+    data = {}
+    data['command'] = uframe.unpack8()
+    data['status'] = uframe.unpack8()
+    if data['status'] == 0:
+        return data
+    data['size'] = uframe.unpack16()
+    data['used'] = uframe.unpack16()
+    return data
+
+# Returns a dictionary of the frame contents
+def unpack_past_export(uframe):
+    data = {}
+    data['command'] = uframe.unpack8()
+    data['status'] = uframe.unpack8()
+    if data['status'] == 0:
+        return data
+    data['total'] = uframe.unpack16()
+    data['crc'] = uframe.unpack16()
+    data['offset'] = uframe.unpack16()
+    data['data'] = bytearray()
+    while not uframe.eof():
+        data['data'].append(uframe.unpack8())
+    return data
+
+# Returns a list of (id, data) of the units of a settings export, see
+# "Settings backup and restore" in protocol.h
+def unpack_past_units(export):
+    units = []
+    pos = 0
+    while pos + 8 <= len(export):
+        (id, length) = struct.unpack(">II", bytes(export[pos:pos + 8]))
+        units.append((id, export[pos + 8:pos + 8 + length]))
+        pos += 8 + ((length + 3) & ~3)
+    return units
+
+# Returns a settings stream of a list of (id, data)
+def pack_past_units(units):
+    export = bytearray()
+    for (id, data) in units:
+        export += bytearray(struct.pack(">II", id, len(data)))
+        export += data
+        export += bytearray((4 - len(data) % 4) % 4)
+    return export
+
 # Returns a dictionary of the frame contents
 def unpack_temperature_report(uframe):
     data = {}
@@ -245,3 +957,27 @@ def unpack_temperature_report(uframe):
         data['params'][key] = value
     return data
 
+# Returns a list of dictionaries, one per sample
+def unpack_stream_data(uframe):
+    samples = []
+    command = uframe.unpack8()
+    timestamp = uframe.unpack32()
+    interval = uframe.unpack16()
+    count = uframe.unpack8()
+    keys = ['v_out', 'i_out', 'v_in']
+    prev = {}
+    for i in range(count):
+        sample = {}
+        sample['timestamp'] = timestamp + i * interval
+        for key in keys:
+            if i == 0:
+                sample[key] = uframe.unpack16()
+            else:
+                d = uframe.unpack8()
+                if d == sample_delta_escape:
+                    sample[key] = uframe.unpack16()
+                else:
+                    sample[key] = (prev[key] + (d - 256 if d & 0x80 else d)) & 0xffff
+        prev = sample
+        samples.append(sample)
+    return samples
@@ -22,6 +22,12 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 """
 
+# The compiled codec (see setup.py) decodes frames when it has been built
+try:
+    import _uframe
+except ImportError:
+    _uframe = None
+
 _SOF = 0x7e
 _DLE = 0x7d
 _XOR = 0x20
@@ -111,10 +117,7 @@ class uFrame(object):
     """
     def set_frame(self, escaped_frame):
         self._frame = escaped_frame
-        res = self._unescape()
-        if res == 0:
-            res = self._calc_crc()
-        return res
+        return self._decode()
 
     """
     Return a string describing the data in the frame
@@ -123,9 +126,14 @@ class uFrame(object):
         return ' '.join(format(x, '02x') for x in self._frame)
 
     """
-    Unsecape frame data (internal function)
+    Unescape frame data and check the crc in a single pass, chopping the crc
+    off the payload if valid (internal function)
     """
-    def _unescape(self):
+    def _decode(self):
+        if _uframe:
+            status, self._frame = _uframe.decode(self._frame)
+            self._valid = status == 0
+            return status
         length = len(self._frame)
         if length < 4:
             return -E_LEN
@@ -133,32 +141,27 @@ class uFrame(object):
             return -E_FRM
         f = bytearray()
         seen_dle = False
-        for b in self._frame:
+        self._crc = 0
+        for b in self._frame[1:-1]:
             if b == _DLE:
                 seen_dle = True
-            elif seen_dle:
-                f.append(b ^ _XOR)
+                continue
+            if seen_dle:
+                b ^= _XOR
                 seen_dle = False
-            else:
-                f.append(b)
-        self._frame = f[1:-1]
-        return 0
-
-    """
-    Check crc of frame data and chop crc off payload if valid (internal function)
-    """
-    def _calc_crc(self):
-        self._crc = 0
-        for b in self._frame[:-2]:
-            self._crc = crc16_ccitt(self._crc, b)
+            # The crc lags two bytes behind as the last two bytes are the crc
+            if len(f) >= 2:
+                self._crc = crc16_ccitt(self._crc, f[-2])
+            f.append(b)
+        if len(f) < 2:
+            return -E_LEN
         self._crc &= 0xffff
-        crc = (self._frame[-2] << 8) | self._frame[-1]
-        self._valid = crc == self._crc
+        self._valid = ((f[-2] << 8) | f[-1]) == self._crc
         if not self._valid:
+            self._frame = f
             return -E_CRC
-        else:
-            self._frame = self._frame[:-2] # Chop of crc
-            return 0
+        self._frame = f[:-2] # Chop of crc
+        return 0
 
     def unpack8(self):
         b = self._frame[self._unpack_pos]
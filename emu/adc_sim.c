@@ -0,0 +1,348 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include "pwrctl.h"
+#include "hw.h"
+#include "adc_scan.h"
+#include "tick.h"
+#include "adc_sim.h"
+#include "dac.h"
+
+/** A simulated ADC connected to a simulated load. The scans are made in
+  * simulated time from the main loop and go through the same adc_scan() as
+  * the scans of the ADC ISR, so the protections, the sums and the readings
+  * behave as on the DPS. A protection trips after the same number of scans,
+  * its latency is only as accurate as the main loop is prompt. */
+
+/** Resistance of a shorted output */
+#define SHORT_MOHM  (10)
+
+/** Raw I_out error at 0mA of the simulated unit, compensated by adc_scan()
+  * like the error of a real unit */
+#define I_OUT_ZERO_ERROR  (3)
+
+/** If the main loop was stalled (a debugger, a slow terminal) the scans
+  * are caught up with at most this many. The headless emulator jumps from
+  * timer to timer, a second covers the longest period of the UI. */
+#define MAX_BURST  (ADC_SIM_SCAN_RATE)
+
+static pthread_mutex_t load_mutex = PTHREAD_MUTEX_INITIALIZER;
+static adc_sim_load_t load = { .type = load_open };
+static uint32_t v_in_mv = 20000;
+/** Set when the load changes so the inrush restarts */
+static bool load_changed;
+/** Voltage of the capacitor of a capacitive load */
+static double v_cap_mv;
+
+/** The V_out DAC table fed by the simulated DMA, see hw_dac_wave_start() */
+static const uint16_t *wave_table;
+static uint32_t wave_len;
+static uint64_t wave_rate_mhz;
+static uint64_t wave_start_scan;
+
+static uint64_t start_us;
+static uint64_t scans_done;
+/** Scans since power out was enabled or the load changed */
+static uint32_t scans_on;
+static uint32_t noise_state = 1;
+
+/**
+  * @brief Add +-1 LSB of noise to a raw sample
+  * @param raw the sample
+  * @retval the noisy sample, clamped to 12 bits
+  */
+static uint32_t noisy(int32_t raw)
+{
+    noise_state = noise_state * 1103515245 + 12345;
+    raw += (int32_t) ((noise_state >> 16) % 3) - 1;
+    return raw < 0 ? 0 : raw > 4095 ? 4095 : raw;
+}
+
+/**
+  * @brief Convert a V_out DAC code to the voltage it gives
+  * @param dac the code
+  * @retval the voltage in milli volt
+  */
+static double dac_mv(uint32_t dac)
+{
+    const pwrctl_coeff_t *coeff = &pwrctl_get_calibration()->v_out_dac;
+    double mv = coeff->k ? (((double) dac * 65536) - coeff->c) / coeff->k : 0;
+    return mv < 0 ? 0 : mv;
+}
+
+/**
+  * @brief Calculate the output of the DPS into the load for one scan
+  * @param l the load
+  * @param v_out_mv the output voltage is stored here
+  * @param i_out_ma the output current is stored here
+  * @retval None
+  */
+static void operating_point(const adc_sim_load_t *l, double *v_out_mv, double *i_out_ma)
+{
+    double v_set = pwrctl_get_vout();
+    double i_set = pwrctl_get_iout();
+    double v_max = v_in_mv > V_IO_DELTA ? v_in_mv - V_IO_DELTA : 0;
+    double r = 0, i = 0;
+    /** The output follows the DAC, which differs from the setting while soft
+      * start ramps it or a waveform plays */
+    if (DAC_DHR12R1 != pwrctl_calc_vout_dac(v_set)) {
+        v_set = dac_mv(DAC_DHR12R1);
+    }
+    if (v_set > v_max) {
+        v_set = v_max;
+    }
+    *v_out_mv = 0;
+    *i_out_ma = 0;
+    if (!pwrctl_vout_enabled()) {
+        /** Discharged at once */
+        v_cap_mv = 0;
+        return;
+    }
+    switch (l->type) {
+        case load_open:
+            *v_out_mv = v_set;
+            return;
+        case load_cc:
+            if (l->i_ma <= i_set) {
+                *v_out_mv = v_set;
+                *i_out_ma = l->i_ma;
+            } else {
+                /** Both regulate current, the load wins the voltage */
+                *i_out_ma = i_set;
+            }
+            return;
+        case load_capacitive:
+            {
+                /** mA per mV of change in one scan */
+                double c = l->c_uf * ADC_SIM_SCAN_RATE / 1e6;
+                double i_r = l->r_mohm ? v_cap_mv * 1000 / l->r_mohm : 0;
+                i = i_r + c * (v_set - v_cap_mv);
+                if (i > i_set) {
+                    /** Constant current charging */
+                    i = i_set;
+                    v_cap_mv += (i_set - i_r) / c;
+                } else {
+                    v_cap_mv = v_set;
+                }
+                *v_out_mv = v_cap_mv;
+                *i_out_ma = i < 0 ? 0 : i;
+            }
+            return;
+        case load_short:
+            r = SHORT_MOHM;
+            break;
+        case load_resistive:
+        case load_inrush:
+            r = l->r_mohm ? l->r_mohm : SHORT_MOHM;
+            break;
+    }
+    i = v_set * 1000 / r;
+    if (l->type == load_inrush && l->tau_ms) {
+        double t_ms = (double) scans_on * 1000 / ADC_SIM_SCAN_RATE;
+        i += l->i_ma * exp(-t_ms / l->tau_ms);
+    }
+    if (i <= i_set) {
+        *v_out_mv = v_set;
+        *i_out_ma = i;
+    } else {
+        /** Constant current, the voltage drops */
+        *i_out_ma = i_set;
+        *v_out_mv = i_set * r / 1000;
+        if (*v_out_mv > v_set) {
+            *v_out_mv = v_set;
+        }
+    }
+}
+
+/**
+  * @brief Convert a V_in in milli volt to a raw sample
+  * @param mv the voltage
+  * @retval the raw sample
+  */
+static int32_t vin_raw(uint32_t mv)
+{
+    const pwrctl_coeff_t *coeff = &pwrctl_get_calibration()->v_in_adc;
+    if (!coeff->k) {
+        return 0;
+    }
+    return (((int64_t) mv << 16) - coeff->c) / coeff->k;
+}
+
+/**
+  * @brief Set the load connected to the output
+  * @param l the new load, copied
+  * @retval None
+  */
+void adc_sim_set_load(const adc_sim_load_t *l)
+{
+    pthread_mutex_lock(&load_mutex);
+    load = *l;
+    load_changed = true;
+    pthread_mutex_unlock(&load_mutex);
+}
+
+/**
+  * @brief Feed the V_out DAC from a table in simulated time
+  * @param table the DAC codes, NULL to stop
+  * @param len number of codes
+  * @param rate_mhz samples per 1000s
+  * @retval None
+  */
+void adc_sim_set_wave(const uint16_t *table, uint32_t len, uint64_t rate_mhz)
+{
+    wave_start_scan = scans_done;
+    wave_len = len;
+    wave_rate_mhz = rate_mhz;
+    wave_table = table;
+}
+
+/**
+  * @brief Set the simulated input voltage
+  * @param mv the input voltage
+  * @retval None
+  */
+void adc_sim_set_vin(uint32_t mv)
+{
+    pthread_mutex_lock(&load_mutex);
+    v_in_mv = mv;
+    pthread_mutex_unlock(&load_mutex);
+}
+
+/**
+  * @brief Parse a load command of the event port
+  * @param cmd the command
+  * @retval true if the command was understood
+  */
+bool adc_sim_command(const char *cmd)
+{
+    adc_sim_load_t l;
+    unsigned int a, b, c;
+    memset(&l, 0, sizeof(l));
+    if (sscanf(cmd, "vin %u", &a) == 1) {
+        adc_sim_set_vin(a);
+        return true;
+    } else if (strcmp(cmd, "load open") == 0) {
+        l.type = load_open;
+    } else if (strcmp(cmd, "load short") == 0) {
+        l.type = load_short;
+    } else if (sscanf(cmd, "load r %u", &a) == 1) {
+        l.type = load_resistive;
+        l.r_mohm = a;
+    } else if (sscanf(cmd, "load cc %u", &a) == 1) {
+        l.type = load_cc;
+        l.i_ma = a;
+    } else if (sscanf(cmd, "load c %u %u", &a, &b) == 2) {
+        l.type = load_capacitive;
+        l.r_mohm = a;
+        l.c_uf = b;
+    } else if (sscanf(cmd, "load inrush %u %u %u", &a, &b, &c) == 3) {
+        l.type = load_inrush;
+        l.r_mohm = a;
+        l.i_ma = b;
+        l.tau_ms = c;
+    } else {
+        return false;
+    }
+    adc_sim_set_load(&l);
+    return true;
+}
+
+/**
+  * @brief Feed the scans that are due through adc_scan()
+  * @retval None
+  */
+void adc_sim_run(void)
+{
+    static bool was_enabled;
+    adc_sim_load_t l;
+    uint64_t now = get_ticks_us();
+    if (!start_us) {
+        start_us = now;
+    }
+    uint64_t due = (now - start_us) * ADC_SIM_SCAN_RATE / 1000000;
+    if (due - scans_done > MAX_BURST) {
+        scans_done = due - MAX_BURST;
+    }
+
+    pthread_mutex_lock(&load_mutex);
+    l = load;
+    if (load_changed) {
+        load_changed = false;
+        scans_on = 0;
+    }
+    int32_t v_in = vin_raw(v_in_mv);
+    pthread_mutex_unlock(&load_mutex);
+
+#ifdef CONFIG_ADC_DMA
+    static uint16_t block[ADC_DMA_BLOCK_LEN * adc_cha_max];
+    static uint32_t block_scans;
+#endif // CONFIG_ADC_DMA
+    for (; scans_done < due; scans_done++) {
+        double v_out_mv, i_out_ma;
+        if (wave_table) {
+            /** The TIM6 triggered DMA, one code per sample period */
+            uint64_t sample_index = (scans_done - wave_start_scan) * wave_rate_mhz / (ADC_SIM_SCAN_RATE * 1000ULL);
+            DAC_DHR12R1 = wave_table[sample_index % wave_len];
+        }
+        bool enabled = pwrctl_vout_enabled();
+        if (enabled && !was_enabled) {
+            scans_on = 0;
+        }
+        was_enabled = enabled;
+        /** May disable power out, which the next scan sees */
+        operating_point(&l, &v_out_mv, &i_out_ma);
+        scans_on++;
+        uint32_t i = noisy(pwrctl_calc_ilimit_adc(i_out_ma > 0xffff ? 0xffff : (uint16_t) i_out_ma) + I_OUT_ZERO_ERROR);
+#ifdef CONFIG_ADC_PLAN
+        /** Hold the channels the sampling plan leaves out of this scan */
+        static uint32_t v_out, vin;
+        if (scans_done % CONFIG_ADC_VOUT_DECIMATION == 0) {
+            v_out = noisy(pwrctl_calc_vout_adc((uint32_t) v_out_mv));
+        }
+        if (scans_done % CONFIG_ADC_VIN_DECIMATION == 0) {
+            vin = noisy(v_in);
+        }
+#else // CONFIG_ADC_PLAN
+        uint32_t v_out = noisy(pwrctl_calc_vout_adc((uint32_t) v_out_mv));
+        uint32_t vin = noisy(v_in);
+#endif // CONFIG_ADC_PLAN
+#ifdef CONFIG_ADC_DMA
+        block[block_scans * adc_cha_max + adc_cha_i_out] = i;
+        block[block_scans * adc_cha_max + adc_cha_v_in] = vin;
+        block[block_scans * adc_cha_max + adc_cha_v_out] = v_out;
+        if (++block_scans == ADC_DMA_BLOCK_LEN) {
+            block_scans = 0;
+            adc_scan_block(block);
+        }
+#else // CONFIG_ADC_DMA
+        adc_scan(i, vin, v_out);
+#endif // CONFIG_ADC_DMA
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ADC_SIM_H__
+#define __ADC_SIM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Scan rate of the ADC of the DPS, the simulated scans are produced at the
+  * same rate in simulated time */
+#define ADC_SIM_SCAN_RATE  (21000)
+
+/** The loads the simulated ADC can be connected to */
+typedef enum {
+    load_open = 0,  /** Nothing connected */
+    load_resistive, /** r_mohm */
+    load_cc,        /** An electronic load sinking i_ma */
+    load_inrush,    /** r_mohm with a capacitive inrush of i_ma decaying with tau_ms */
+    load_short,     /** Output shorted */
+    load_capacitive, /** c_uf in parallel with r_mohm, or nothing if 0 */
+} adc_sim_load_type_t;
+
+typedef struct {
+    adc_sim_load_type_t type;
+    uint32_t r_mohm;
+    uint32_t i_ma;
+    uint32_t tau_ms;
+    uint32_t c_uf;
+} adc_sim_load_t;
+
+/**
+  * @brief Set the load connected to the output, may be called from any thread
+  * @param load the new load, copied
+  * @retval None
+  */
+void adc_sim_set_load(const adc_sim_load_t *load);
+
+/**
+  * @brief Set the simulated input voltage, may be called from any thread
+  * @param v_in_mv the input voltage
+  * @retval None
+  */
+void adc_sim_set_vin(uint32_t v_in_mv);
+
+/**
+  * @brief Feed the V_out DAC from a table in simulated time, like the DMA of
+  *        hw_dac_wave_start(). Called from the main loop.
+  * @param table the DAC codes, NULL to stop
+  * @param len number of codes
+  * @param rate_mhz samples per 1000s
+  * @retval None
+  */
+void adc_sim_set_wave(const uint16_t *table, uint32_t len, uint64_t rate_mhz);
+
+/**
+  * @brief Parse a load command of the event port:
+  *        "load open", "load r <mohm>", "load cc <ma>",
+  *        "load inrush <mohm> <ma> <ms>", "load c <mohm> <uf>",
+  *        "load short" or "vin <mv>"
+  * @param cmd the command
+  * @retval true if the command was understood
+  */
+bool adc_sim_command(const char *cmd);
+
+/**
+  * @brief Feed the scans that are due since the previous call through
+  *        adc_scan() with the samples the load gives, called from the main
+  *        loop just like the ADC ISR would interrupt it
+  * @retval None
+  */
+void adc_sim_run(void);
+
+#endif // __ADC_SIM_H__
@@ -1,3 +1,3 @@
 #include <stdint.h>
-uint32_t DAC_DHR12R1;
-uint32_t DAC_DHR12R2;
+#include "dac.h"
+dac_regs_t dac_regs;
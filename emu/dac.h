@@ -1,2 +1,17 @@
-extern uint32_t DAC_DHR12R1;
-extern uint32_t DAC_DHR12R2;
+#include <stdint.h>
+
+/** The dual channel register writes the holding registers of both channels
+  * at once, as on the STM32. The layout takes a little endian host. */
+typedef union {
+    uint32_t dhr12rd;
+    struct {
+        uint16_t dhr12r1;
+        uint16_t dhr12r2;
+    };
+} dac_regs_t;
+
+extern dac_regs_t dac_regs;
+
+#define DAC_DHR12R1  (dac_regs.dhr12r1)
+#define DAC_DHR12R2  (dac_regs.dhr12r2)
+#define DAC_DHR12RD  (dac_regs.dhr12rd)
@@ -27,6 +27,8 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include <time.h>
 #include <pthread.h>
 #include <unistd.h>
 #include <semaphore.h>
@@ -37,6 +39,9 @@
 #include "event.h"
 #include "tft.h"
 #include "dbg_printf.h"
+#include "adc_sim.h"
+#include "tick.h"
+#include "softtimer.h"
 
 #define UDP_RX_BUF_LEN       (512)
 #define DPS_PORT            (5005)
@@ -51,6 +56,22 @@ int comm_sock;
 /** Current connected client, one at a time please */
 struct sockaddr_in comm_client_sock;
 
+/** The script run headless on the virtual clock, NULL when running real time
+  * with the UDP ports */
+static FILE *script;
+/** The next command of the script and when it is due */
+static char script_line[UDP_RX_BUF_LEN];
+static uint32_t script_line_no;
+static uint64_t script_us;
+/** Wall clock at start, for the speed up printed on quit */
+static struct timespec wall_start;
+/** Log every datagram and event, off so the emulator can take protocol
+  * traffic at full speed */
+static bool verbose;
+/** The arguments of the fuzzer, from -F on, see fuzz.c */
+static int fuzz_argc;
+static char **fuzz_argv;
+
 /**
  * @brief      Send a frame on the emulator 'USART' which is the UDP port.
  *             Called from protocol_handler.c
@@ -60,6 +81,17 @@ struct sockaddr_in comm_client_sock;
  */
 void dps_emul_send_frame(uint8_t *frame, uint32_t length)
 {
+    if (fuzz_argv) {
+        return;
+    }
+    if (script) {
+        printf("[%llu] TX", (unsigned long long) get_ticks());
+        for (uint32_t i = 0; i < length; i++) {
+            printf(" %02x", frame[i]);
+        }
+        printf("\n");
+        return;
+    }
     int slen = sizeof(comm_client_sock);
     if (sendto(comm_sock, frame, length, 0, (struct sockaddr*) &comm_client_sock, slen) == -1) {
         printf("Error: sendto()\n");
@@ -97,11 +129,11 @@ void* comm_thread(void *arg)
         if ((recv_len = recvfrom(comm_sock, buf, UDP_RX_BUF_LEN, 0, (struct sockaddr *) &comm_client_sock, &slen)) == -1) {
             printf("Error: recvfrom()\n");
         }
-        printf("[Com] Received %lu bytes\n", recv_len);
-        for (int i = 0; i < recv_len; i++) {
-            if (!event_put(event_uart_rx, buf[i])) {
-                dbg_printf("Error: event queue overflowed\n");
-            }
+        if (verbose) {
+            printf("[Com] Received %lu bytes\n", recv_len);
+        }
+        if (emul_uart_rx((uint8_t*) buf, recv_len) != recv_len) {
+            dbg_printf("Error: UART RX ring overflowed\n");
         }
     }
     
@@ -139,10 +171,12 @@ void* event_thread(void *arg)
     }
     
     while(1) {
-        if ((recv_len = recvfrom(sock, buf, UDP_RX_BUF_LEN, 0, (struct sockaddr *) &client_sock, &slen)) == -1) {
+        if ((recv_len = recvfrom(sock, buf, UDP_RX_BUF_LEN - 1, 0, (struct sockaddr *) &client_sock, &slen)) == -1) {
             printf("Error: recvfrom()\n");
+            continue;
         }
-        if (buf[recv_len-1] == '\n') {
+        buf[recv_len] = 0;
+        if (recv_len && buf[recv_len-1] == '\n') {
             buf[recv_len-1] = 0;
             recv_len--;
         }
@@ -151,6 +185,10 @@ void* event_thread(void *arg)
             printf("Drawing UI\n");
             emul_tft_draw();
             printf("---\n");
+        } else if (strcmp("tft stats", buf) == 0) {
+            emul_tft_stats();
+        } else if (adc_sim_command(buf)) {
+            printf("Load changed\n");
         }
     }
     
@@ -158,6 +196,126 @@ void* event_thread(void *arg)
     return NULL;
 }
 
+/**
+ * @brief      Read the next command of the script. wait and at only move the
+ *             script time, the end of the script is a quit.
+ */
+static void script_next(void)
+{
+    unsigned long long ms;
+    while (fgets(script_line, sizeof(script_line), script)) {
+        script_line_no++;
+        char *line = script_line;
+        size_t len = strlen(line);
+        while (len && isspace((unsigned char) line[len-1])) {
+            line[--len] = 0;
+        }
+        while (isspace((unsigned char) *line)) {
+            line++;
+        }
+        memmove(script_line, line, strlen(line) + 1);
+        if (!script_line[0] || script_line[0] == '#') {
+            continue;
+        } else if (sscanf(script_line, "wait %llu", &ms) == 1) {
+            script_us += ms * 1000;
+        } else if (sscanf(script_line, "at %llu", &ms) == 1) {
+            script_us = ms * 1000;
+        } else {
+            return;
+        }
+    }
+    strcpy(script_line, "quit");
+}
+
+/**
+ * @brief      Print how the run went and exit
+ */
+static void script_quit(void)
+{
+    struct timespec wall_end;
+    clock_gettime(CLOCK_MONOTONIC, &wall_end);
+    double wall_s = (wall_end.tv_sec - wall_start.tv_sec) + (wall_end.tv_nsec - wall_start.tv_nsec) / 1e9;
+    double virtual_s = get_ticks_us() / 1e6;
+    printf("Ran %.3f s in %.3f s (%.0fx)\n", virtual_s, wall_s, wall_s > 0 ? virtual_s / wall_s : 0);
+    flash_emul_print_wear();
+    exit(EXIT_SUCCESS);
+}
+
+/**
+ * @brief      Run one command of the script
+ *
+ * @param      cmd   The command
+ */
+static void script_command(char *cmd)
+{
+    unsigned int event, data = 0;
+    emu_printf("[%llu] %s\n", (unsigned long long) get_ticks(), cmd);
+    if (strcmp(cmd, "quit") == 0) {
+        script_quit();
+    } else if (strncmp(cmd, "rx ", 3) == 0) {
+        /** Bytes received on the 'USART', hex with optional spaces */
+        uint8_t buf[UDP_RX_BUF_LEN / 2];
+        uint32_t length = 0;
+        unsigned int byte;
+        int n;
+        for (char *p = cmd + 3; length < sizeof(buf); p += n) {
+            while (isspace((unsigned char) *p)) {
+                p++;
+            }
+            if (sscanf(p, "%2x%n", &byte, &n) != 1) {
+                break;
+            }
+            buf[length++] = byte;
+        }
+        if (emul_uart_rx(buf, length) != length) {
+            dbg_printf("Error: UART RX ring overflowed\n");
+        }
+    } else if (sscanf(cmd, "event %u %u", &event, &data) >= 1) {
+        (void) event_put((event_t) event, data);
+    } else if (strcmp(cmd, "tft on") == 0 || strcmp(cmd, "tft off") == 0) {
+        emul_tft_enable(cmd[5] == 'n');
+    } else if (strcmp(cmd, "tft stats") == 0) {
+        emul_tft_stats();
+    } else if (strcmp(cmd, "draw") == 0) {
+        emul_tft_draw();
+        printf("---\n");
+    } else if (!adc_sim_command(cmd)) {
+        fprintf(stderr, "Error: script line %u: unknown command '%s'\n", script_line_no, cmd);
+        exit(EXIT_FAILURE);
+    }
+}
+
+bool dps_emul_headless(void)
+{
+    return script != NULL || fuzz_argv != NULL;
+}
+
+bool dps_emul_verbose(void)
+{
+    return verbose;
+}
+
+void dps_emul_script_run(uint64_t deadline)
+{
+    if (fuzz_argv) {
+        /** The firmware is up */
+        emul_fuzz_run(fuzz_argc, fuzz_argv);
+    }
+    while (script_us <= get_ticks_us()) {
+        script_command(script_line);
+        script_next();
+    }
+    if (event_pending()) {
+        return;
+    }
+    /** Nothing happens until the next timer or command */
+    uint64_t next = deadline == SOFTTIMER_NEVER ? script_us : deadline * 1000;
+    if (script_us < next) {
+        next = script_us;
+    }
+    emul_clock_advance(next);
+}
+
 /**
  * @brief      Emulator init
  *
@@ -168,11 +326,9 @@ void dps_emul_init(past_t *past, int argc, char const *argv[])
 {
 	printf("OpenDPS Emulator\n");
 
-    pthread_create(&udp_th, NULL, comm_thread, "UDP comms thread");
-    pthread_create(&event_th, NULL, event_thread, "UDP event thread");
-
     size_t optind;
     char *file_name = 0;
+    char *script_name = 0;
     bool write_past = false;
     for (optind = 1; optind < argc; optind++) {
         switch (argv[optind][1]) {
@@ -183,11 +339,44 @@ void dps_emul_init(past_t *past, int argc, char const *argv[])
 	        case 'w':
 			    write_past = true;
 	        	break;
+	        case 's':
+	        	script_name = (char*) argv[optind+1];
+	        	optind++;
+	        	break;
+	        case 'v':
+	        	verbose = true;
+	        	break;
+	        case 'F':
+	        	/** The rest goes to the fuzzer */
+	        	fuzz_argc = argc - optind;
+	        	fuzz_argv = (char**) &argv[optind];
+	        	optind = argc;
+	        	break;
 	        default:
-	            fprintf(stderr, "Usage: %s [-p past.bin] [-w]\n", argv[0]);
+	            fprintf(stderr, "Usage: %s [-p past.bin] [-w] [-s script|-] [-v] [-F fuzzer arguments...]\n", argv[0]);
 	            exit(EXIT_FAILURE);
         }   
     }   
 
+    if (fuzz_argv) {
+        /** Headless without a script, fuzz.c feeds the inputs */
+        emul_clock_virtual();
+        emul_tft_enable(false);
+    } else if (script_name) {
+        /** Headless: no sockets, no TFT and time flies */
+        script = strcmp(script_name, "-") == 0 ? stdin : fopen(script_name, "r");
+        if (!script) {
+            fprintf(stderr, "Error: could not open %s\n", script_name);
+            exit(EXIT_FAILURE);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &wall_start);
+        emul_clock_virtual();
+        emul_tft_enable(false);
+        script_next();
+    } else {
+        pthread_create(&udp_th, NULL, comm_thread, "UDP comms thread");
+        pthread_create(&event_th, NULL, event_thread, "UDP event thread");
+    }
+
 	flash_emul_init(past, file_name, write_past);
 }
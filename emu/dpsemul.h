@@ -28,4 +28,41 @@
 
 void dps_emul_init(past_t *past, int argc, char const *argv[]);
 
+/** True when running a script headless on the virtual clock */
+bool dps_emul_headless(void);
+
+/**
+ * @brief      Run the script commands that are due and advance the virtual
+ *             clock to the next command or timer, called from hw_idle()
+ *
+ * @param[in]  deadline  the tick when the next timer expires
+ */
+void dps_emul_script_run(uint64_t deadline);
+
+/** True when started with -v, logging every datagram and event */
+bool dps_emul_verbose(void);
+
+/**
+ * @brief      Bytes received on the emulator 'USART', queued for
+ *             hw_uart_rx_get() in hw.c with one event_uart_rx_ready
+ *
+ * @param[in]  buf     The bytes
+ * @param[in]  length  The length
+ *
+ * @return     number of bytes queued, the rest were dropped
+ */
+uint32_t emul_uart_rx(const uint8_t *buf, uint32_t length);
+
+/**
+ * @brief      Run the fuzz target of fuzz.c, never returns
+ *
+ * @param[in]  argc  The fuzzer arguments, the first is skipped
+ * @param      argv  The arguments
+ */
+void emul_fuzz_run(int argc, char **argv);
+
+/** The virtual clock of misc.c */
+void emul_clock_virtual(void);
+void emul_clock_advance(uint64_t us);
+
 #endif // __DPSEMUL_H__
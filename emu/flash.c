@@ -6,9 +6,17 @@
 #include "flash.h"
 #include "past.h"
 
-#define FLASH_SIZE  (2048)
+#define FLASH_SIZE  (PAST_NUM_BLOCKS * PAST_BLOCK_SIZE)
 
 static uint8_t flash[FLASH_SIZE];
+/** Wear counters, for soak tests of the past */
+static uint32_t page_erases[FLASH_SIZE / 1024];
+static uint32_t word_programs;
+/** Busy time of the timing model, see flash.h */
+static uint64_t busy_us;
+static uint64_t busy_max_us;
+static uint64_t stall_us;
+static uint64_t longest_stall_us;
 static char *past_name;
 bool persistent;
 
@@ -16,8 +24,12 @@ void flash_emul_init(past_t *past, char *_past_name, bool _persistent)
 {
     past_name = _past_name;
     persistent = _persistent;
-    past->blocks[0] = 0;
-    past->blocks[1] = 1024;
+    memset(page_erases, 0, sizeof(page_erases));
+    word_programs = 0;
+    busy_us = busy_max_us = stall_us = longest_stall_us = 0;
+    for (uint32_t i = 0; i < PAST_NUM_BLOCKS; i++) {
+        past->blocks[i] = i * PAST_BLOCK_SIZE;
+    }
     memset(flash, 0xff, FLASH_SIZE);
     if (past_name) {
         FILE *f = fopen(past_name, "rb");
@@ -55,6 +67,10 @@ void flash_erase_page(uint32_t address)
         exit(EXIT_FAILURE);
     }
     memset(&flash[address], 0xff, 1024);
+    page_erases[address / 1024]++;
+    busy_us += FLASH_EMUL_PAGE_ERASE_US;
+    busy_max_us += FLASH_EMUL_PAGE_ERASE_MAX_US;
+    stall_us += FLASH_EMUL_PAGE_ERASE_US;
     save_past();
 }
 
@@ -66,9 +82,56 @@ void flash_program_word(uint32_t address, uint32_t data)
     }
     uint32_t *temp = (uint32_t*) &flash[address];
     *temp = data;
+    word_programs++;
+    busy_us += FLASH_EMUL_WORD_PROGRAM_US;
+    busy_max_us += FLASH_EMUL_WORD_PROGRAM_MAX_US;
+    stall_us += FLASH_EMUL_WORD_PROGRAM_US;
     save_past();
 }
 
+void flash_emul_print_wear(void)
+{
+    printf("Flash wear: %u words programmed, page erases:", word_programs);
+    for (uint32_t i = 0; i < FLASH_SIZE / 1024; i++) {
+        printf(" %u", page_erases[i]);
+    }
+    printf("\n");
+    (void) flash_emul_take_stall_us();
+    printf("Flash busy: %llu ms (%llu ms max), longest stall %llu ms\n",
+           (unsigned long long) busy_us / 1000, (unsigned long long) busy_max_us / 1000,
+           (unsigned long long) longest_stall_us / 1000);
+}
+
+uint32_t flash_emul_word_programs(void)
+{
+    return word_programs;
+}
+
+void flash_emul_get_stats(flash_emul_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->word_programs = word_programs;
+    for (uint32_t i = 0; i < FLASH_SIZE / 1024; i++) {
+        stats->page_erases += page_erases[i];
+        if (page_erases[i] > stats->max_page_erases) {
+            stats->max_page_erases = page_erases[i];
+        }
+    }
+    stats->busy_us = busy_us;
+    stats->busy_max_us = busy_max_us;
+    stats->longest_stall_us = longest_stall_us > stall_us ? longest_stall_us : stall_us;
+}
+
+uint64_t flash_emul_take_stall_us(void)
+{
+    uint64_t us = stall_us;
+    if (us > longest_stall_us) {
+        longest_stall_us = us;
+    }
+    stall_us = 0;
+    return us;
+}
+
 uint32_t flash_read_word(uint32_t address)
 {
     if (address > FLASH_SIZE) {
@@ -79,6 +142,15 @@ uint32_t flash_read_word(uint32_t address)
     return *temp;
 }
 
+const void *flash_read_ptr(uint32_t address)
+{
+    if (address > FLASH_SIZE) {
+        printf("Flash out of bound read access at 0x%08x\n", address);
+        exit(EXIT_FAILURE);
+    }
+    return (const void*) &flash[address];
+}
+
 uint32_t flash_get_status_flags(void)
 {
     return FLASH_SR_EOP;
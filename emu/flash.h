@@ -13,8 +13,32 @@ uint32_t flash_get_status_flags(void);
 void hexdump(char *desc, void *addr, int len);
 
 #ifdef DPS_EMULATOR
+/** Flash timing of the STM32F100 datasheet, typical and max. A word is
+  * programmed as two half words. The CPU stalls while the flash is busy. */
+#define FLASH_EMUL_WORD_PROGRAM_US      (105)
+#define FLASH_EMUL_WORD_PROGRAM_MAX_US  (140)
+#define FLASH_EMUL_PAGE_ERASE_US        (20000)
+#define FLASH_EMUL_PAGE_ERASE_MAX_US    (40000)
+
+typedef struct {
+    uint32_t word_programs;
+    uint32_t page_erases;
+    uint32_t max_page_erases;   /** Of the most worn page */
+    uint64_t busy_us;           /** Typical time the flash was busy */
+    uint64_t busy_max_us;       /** Worst case time */
+    uint64_t longest_stall_us;  /** Longest busy time taken by flash_emul_take_stall_us() */
+} flash_emul_stats_t;
+
 void flash_emul_init(past_t *past, char *file_name, bool save_past);
 uint32_t flash_read_word(uint32_t address);
+const void *flash_read_ptr(uint32_t address);
+/** Print the erases of every page and the number of words programmed */
+void flash_emul_print_wear(void);
+uint32_t flash_emul_word_programs(void);
+void flash_emul_get_stats(flash_emul_stats_t *stats);
+/** Get and clear the typical busy time since the previous call, the time the
+  * CPU stalled on the flash */
+uint64_t flash_emul_take_stall_us(void);
 #endif // DPS_EMULATOR
 
 #endif // __FLASH_H__
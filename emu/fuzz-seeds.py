@@ -0,0 +1,96 @@
+#!/usr/bin/python
+#
+# The MIT License (MIT)
+#
+# Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+
+"""
+Write a seed corpus for the protocol fuzz target of the emulator (fuzz.c),
+one valid frame per file for each command the firmware handles, built with
+the frame functions of dpsctl so the seeds follow the protocol.
+
+  % emu/fuzz-seeds.py emu/fuzz-corpus
+  % emu/dpsemu -F emu/fuzz-corpus
+"""
+
+import sys
+import os
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "dpsctl"))
+from protocol import *
+
+def seeds():
+    """
+    Return a list of (name, frame) tuples
+    """
+    s = []
+    for (name, cmd) in [("ping", cmd_ping), ("query", cmd_query),
+                        ("list_functions", cmd_list_functions),
+                        ("list_parameters", cmd_list_parameters),
+                        ("stream_stop", cmd_stream_stop),
+                        ("get_parameter_values", cmd_get_parameter_values),
+                        ("warm_reboot", cmd_warm_reboot)]:
+        s.append((name, create_cmd(cmd)))
+    s.append(("set_function", create_set_function("cv")))
+    s.append(("enable_output", create_enable_output("on")))
+    s.append(("set_parameters", create_set_parameter(["voltage=3300", "current=500"])))
+    s.append(("set_parameter_values", create_set_parameter_values([(0, 5000), (1, 1000)])))
+    s.append(("arm", create_arm(1, "on", [(0, 5000)])))
+    s.append(("set_and_measure", create_set_and_measure(10, 100, 4, "on", [(0, 5000)])))
+    s.append(("fire", create_fire(1)))
+    s.append(("histogram", create_histogram(1, histogram_bins_per_frame)))
+    s.append(("histogram_limits", create_histogram_limits(False, [500, 1000, 0, 0])))
+    s.append(("past_export", create_past_export(0)))
+    s.append(("past_import", create_past_import(8, 0, [1, 2, 3, 4, 5, 6, 7, 8])))
+    s.append(("wifi_status", create_wifi_status(1)))
+    s.append(("set_baud", create_set_baud(921600)))
+    s.append(("wave", create_wave(0, 50000, 5000, 1000)))
+    s.append(("lock", create_lock(1)))
+    s.append(("upgrade_start", create_upgrade_start(1024, 0x1234, 4, 0, [0xbeef])))
+    s.append(("upgrade_data", create_upgrade_data(range(16), 0)))
+    s.append(("stream_start", create_stream_start(10, 16)))
+    s.append(("subscribe", create_subscribe(["output", "setpoint", "v_out"], 10, 10)))
+    s.append(("set_calibration", create_set_calibration(0, 2, 0, [(100, 1000), (2000, 20000)])))
+    s.append(("set_sequence", create_set_sequence(2, 0, 1, [(5000, 1000, 100), (3300, 500, 100)])))
+    s.append(("set_alarms", create_set_alarms(1, 0, [(1, 0x80, 1, 0, 10, 5000)])))
+    s.append(("energy_query", create_energy_query(False)))
+    s.append(("capture_arm", create_capture_arm(1, 100, 1, 16)))
+    s.append(("capture_read", create_capture_read(0)))
+    s.append(("mirror", create_mirror(True)))
+    s.append(("stack_usage", create_stack_usage()))
+    s.append(("profile_dump", create_profile_dump(False)))
+    s.append(("tagged_query", create_tagged(create_cmd(cmd_query), 7)))
+    return s
+
+def main():
+    if len(sys.argv) != 2:
+        print("Usage: %s <corpus directory>" % sys.argv[0])
+        sys.exit(1)
+    if not os.path.isdir(sys.argv[1]):
+        os.makedirs(sys.argv[1])
+    for (name, frame) in seeds():
+        with open(os.path.join(sys.argv[1], name), "wb") as f:
+            f.write(frame.get_frame())
+    print("%d seeds written to %s" % (len(seeds()), sys.argv[1]))
+
+if __name__ == "__main__":
+    main()
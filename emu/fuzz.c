@@ -0,0 +1,174 @@
+/* 
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2018 Johan Kanflo (github.com/kanflo)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/** A fuzz target around the serial protocol, running the complete firmware
+  * of the emulator. Every input is fed to uframe_extract_payload() and to
+  * the frame decoder of the protocol handler, as if received on the UART.
+  *
+  * Built with 'make FUZZ=1' the target runs under libFuzzer. Otherwise the
+  * inputs given are run, each file of a directory once (or cycled with
+  * -runs=N) and the throughput is printed, for replaying crashes, measuring
+  * the exec/s baseline and running under AFL. */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <unistd.h>
+#include "event.h"
+#include "uframe.h"
+#include "serialhandler.h"
+#include "dpsemul.h"
+
+/** Inputs above this size are cut, frames are a few hundred bytes at most */
+#define FUZZ_MAX_INPUT  (4096)
+
+static uint64_t execs;
+
+#ifdef CONFIG_LIBFUZZER
+int LLVMFuzzerRunDriver(int *argc, char ***argv, int (*callback)(const uint8_t *data, size_t size));
+#endif // CONFIG_LIBFUZZER
+
+/**
+ * @brief      Run one input
+ *
+ * @param[in]  data  The input
+ * @param[in]  size  The size
+ *
+ * @return     0, as libFuzzer wants it
+ */
+static int fuzz_one(const uint8_t *data, size_t size)
+{
+    static uint8_t frame[FUZZ_MAX_INPUT];
+    if (size > FUZZ_MAX_INPUT) {
+        size = FUZZ_MAX_INPUT;
+    }
+    /** Unescaped in place, on a copy */
+    memcpy(frame, data, size);
+    (void) uframe_extract_payload(frame, size);
+    serial_handle_rx_buffer(data, size);
+    /** The main loop is not run meanwhile, drop what the handlers queued */
+    event_t event;
+    uint8_t event_data;
+    while (event_get(&event, &event_data)) ;
+    execs++;
+    return 0;
+}
+
+#ifndef CONFIG_LIBFUZZER
+/**
+ * @brief      Run a file, or all files of a directory
+ *
+ * @param[in]  path  The path
+ *
+ * @return     false if the path could not be read
+ */
+static bool fuzz_path(const char *path)
+{
+    static uint8_t buf[FUZZ_MAX_INPUT];
+    DIR *dir = opendir(path);
+    if (dir) {
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL) {
+            char name[1024];
+            if (entry->d_name[0] == '.') {
+                continue;
+            }
+            snprintf(name, sizeof(name), "%s/%s", path, entry->d_name);
+            (void) fuzz_path(name);
+        }
+        closedir(dir);
+        return true;
+    }
+    FILE *f = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "Error: could not open %s\n", path);
+        return false;
+    }
+    size_t size = fread(buf, 1, sizeof(buf), f);
+    if (f != stdin) {
+        fclose(f);
+    }
+    (void) fuzz_one(buf, size);
+    return true;
+}
+#endif // CONFIG_LIBFUZZER
+
+/**
+ * @brief      Run the fuzz target, called once the firmware has started.
+ *             Never returns.
+ *
+ * @param[in]  argc  The fuzzer arguments, the first is skipped
+ * @param      argv  The arguments
+ */
+void emul_fuzz_run(int argc, char **argv)
+{
+    /** The firmware prints plenty, keep stdout for nothing */
+    if (!freopen("/dev/null", "w", stdout)) {
+        fprintf(stderr, "Error: could not silence stdout\n");
+    }
+#ifdef CONFIG_LIBFUZZER
+    exit(LLVMFuzzerRunDriver(&argc, &argv, fuzz_one));
+#else // CONFIG_LIBFUZZER
+#ifdef __AFL_LOOP
+    /** AFL persistent mode, the inputs come on stdin */
+    static uint8_t buf[FUZZ_MAX_INPUT];
+    while (__AFL_LOOP(10000)) {
+        ssize_t size = read(0, buf, sizeof(buf));
+        if (size >= 0) {
+            (void) fuzz_one(buf, size);
+        }
+    }
+    exit(EXIT_SUCCESS);
+#endif // __AFL_LOOP
+    uint64_t runs = 0;
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-runs=", 6) == 0) {
+            runs = strtoull(&argv[i][6], NULL, 10);
+        }
+    }
+    do {
+        uint64_t before = execs;
+        for (int i = 1; i < argc && (!runs || execs < runs); i++) {
+            if (argv[i][0] != '-' || argv[i][1] == 0) {
+                if (!fuzz_path(argv[i])) {
+                    exit(EXIT_FAILURE);
+                }
+            }
+        }
+        if (execs == before) {
+            break; /** No inputs */
+        }
+    } while (execs < runs);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double s = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    fprintf(stderr, "Executed %llu inputs in %.3f s (%.0f exec/s)\n", (unsigned long long) execs, s, s > 0 ? execs / s : 0);
+    exit(EXIT_SUCCESS);
+#endif // CONFIG_LIBFUZZER
+}
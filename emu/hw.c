@@ -25,6 +25,15 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
+#include <unistd.h>
+#include "hw.h"
+#include "event.h"
+#include "ringbuf.h"
+#include "tick.h"
+#include "adc_sim.h"
+#include "dpsemul.h"
+#include "tft.h"
+#include "flash.h"
 
 /**
   * @brief Initialize the hardware
@@ -35,41 +44,180 @@ void hw_init(void)
 }
 
 /**
-  * @brief Read latest ADC mesurements
-  * @param i_out_raw latest I_out raw value
-  * @param v_in_raw latest V_in raw value
-  * @param v_out_raw latest V_out raw value
-  * @retval none
+  * @brief Calibrate the ADC and start sampling
+  * @retval None
   */
-void hw_get_adc_values(uint16_t *i_out_raw, uint16_t *v_in_raw, uint16_t *v_out_raw)
+void hw_adc_start(void)
 {
-    *i_out_raw = 0;
-    *v_in_raw = 0;
-    *v_out_raw = 0;
 }
 
 /**
-  * @brief Initialize TIM4 that drives the backlight of the TFT
+  * @brief Sleep until the next interrupt, unless there are events to handle
+  *        or a timer is due
+  * @param deadline the tick when the next timer expires
   * @retval None
   */
-void hw_enable_backlight(void)
+void hw_idle(uint64_t deadline)
+{
+    /** The CPU stalled while the flash was busy, on the virtual clock the
+      * time passes and the ADC DMA makes its scans meanwhile */
+    uint64_t stall_us = flash_emul_take_stall_us();
+    if (dps_emul_headless()) {
+        emul_clock_advance(get_ticks_us() + stall_us);
+    }
+    /** The scans the ADC would have made meanwhile */
+    adc_sim_run();
+    if (dps_emul_headless()) {
+        dps_emul_script_run(deadline);
+        return;
+    }
+    emul_tft_poll();
+    /** Events from the emulator threads are picked up within a ms */
+    if (!event_pending() && get_ticks() < deadline) {
+        usleep(1000);
+    }
+}
+
+/** Bytes received on the 'USART', put by the comms thread (or the script)
+  * and drained by the main loop, like the DMA ring of the DPS. The ring is
+  * lock free and a whole datagram posts a single event_uart_rx_ready. */
+#define UART_RX_RING_LEN  (4096)
+static uint16_t uart_rx_buffer[UART_RX_RING_LEN];
+static ringbuf_t uart_rx_ring = { uart_rx_buffer, UART_RX_RING_LEN, 0, 0 };
+static bool uart_rx_event_pending;
+static uint32_t uart_rx_overflows;
+
+uint32_t emul_uart_rx(const uint8_t *buf, uint32_t length)
 {
+    uint16_t words[16];
+    uint32_t total = 0;
+    while (total < length) {
+        uint32_t n = length - total < 16 ? length - total : 16;
+        for (uint32_t i = 0; i < n; i++) {
+            words[i] = buf[total + i];
+        }
+        uint32_t put = ringbuf_put_bulk(&uart_rx_ring, words, n);
+        total += put;
+        if (put < n) {
+            uart_rx_overflows += length - total;
+            break;
+        }
+    }
+    /** Sequentially consistent against the clear in hw_uart_rx_get(), or
+      * both threads could miss the bytes just put */
+    if (!__atomic_exchange_n(&uart_rx_event_pending, true, __ATOMIC_SEQ_CST)) {
+        if (!event_put(event_uart_rx_ready, 0)) {
+            __atomic_store_n(&uart_rx_event_pending, false, __ATOMIC_SEQ_CST);
+        }
+    }
+    return total;
 }
 
 /**
-  * @brief Get the ADC valut that triggered the OCP
-  * @retval Trivver value in mA
+  * @brief Get bytes received on USART1
+  * @param buf buffer to copy received bytes to
+  * @param size size of buffer
+  * @retval number of bytes copied, 0 if there is nothing more to read
   */
-uint16_t hw_get_itrig_ma(void)
+uint32_t hw_uart_rx_get(uint8_t *buf, uint32_t size)
 {
-    return 0;
+    uint16_t words[16];
+    uint32_t total = 0;
+    /** Clear before draining so bytes arriving during the drain post a new event */
+    __atomic_store_n(&uart_rx_event_pending, false, __ATOMIC_SEQ_CST);
+    while (total < size) {
+        uint32_t n = ringbuf_get_bulk(&uart_rx_ring, words, size - total < 16 ? size - total : 16);
+        if (n == 0) {
+            break;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            buf[total++] = (uint8_t) words[i];
+        }
+    }
+    return total;
 }
 
 /**
-  * @brief Check if it current press is a long press, inject event if so
+  * @brief Get the number of bytes dropped due to a full USART1 RX ring
+  * @retval number of dropped bytes since boot
+  */
+uint32_t hw_uart_rx_overflows(void)
+{
+    return __atomic_load_n(&uart_rx_overflows, __ATOMIC_RELAXED);
+}
+
+/**
+  * @brief Queue bytes for transmission on USART1
   * @retval None
   */
-void hw_longpress_check(void)
+void hw_uart_tx(const uint8_t *buf, uint32_t length)
+{
+    (void) buf;
+    (void) length;
+}
+
+/**
+  * @brief Wait until all queued bytes have been sent on USART1
+  * @retval None
+  */
+void hw_uart_tx_flush(void)
+{
+}
+
+/**
+  * @brief Change the baud rate of USART1, the emulator link has none
+  * @retval None
+  */
+void hw_uart_set_baudrate(uint32_t baud)
+{
+    (void) baud;
+}
+
+#ifdef CONFIG_THERMAL
+void hw_set_fan(bool on)
+{
+    (void) on;
+}
+
+/** There is no internal sensor, the reported temperatures drive the loop */
+bool hw_get_chip_temperature(int16_t *temp)
+{
+    (void) temp;
+    return false;
+}
+#endif // CONFIG_THERMAL
+
+#ifdef CONFIG_WAVE
+/** The DMA is simulated by adc_sim_run(), sample by sample */
+static bool wave_active;
+
+bool hw_dac_wave_start(const uint16_t *table, uint32_t len, uint64_t rate_mhz)
+{
+    if (!rate_mhz || rate_mhz > 256000000ULL) {
+        return false;
+    }
+    adc_sim_set_wave(table, len, rate_mhz);
+    wave_active = true;
+    return true;
+}
+
+void hw_dac_wave_stop(void)
+{
+    adc_sim_set_wave(NULL, 0, 0);
+    wave_active = false;
+}
+
+bool hw_dac_wave_active(void)
+{
+    return wave_active;
+}
+#endif // CONFIG_WAVE
+
+/**
+  * @brief Initialize TIM4 that drives the backlight of the TFT
+  * @retval None
+  */
+void hw_enable_backlight(void)
 {
 }
 
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <time.h>
 
 char  _bootcom_start[16];
 
@@ -10,9 +11,49 @@ void scb_reset_system(void)
 	printf("scb_reset_system!\n");
 }
 
-uint32_t get_ticks(void)
+/** The headless emulator runs on a virtual clock advanced by hw_idle() */
+static bool virtual_clock;
+static uint64_t virtual_us;
+
+/** Switch to the virtual clock, which starts at 0 */
+void emul_clock_virtual(void)
+{
+	virtual_clock = true;
+	virtual_us = 0;
+}
+
+/** Advance the virtual clock, it never goes backwards */
+void emul_clock_advance(uint64_t us)
+{
+	if (us > virtual_us) {
+		virtual_us = us;
+	}
+}
+
+/** Microseconds since the first call, like systick since power up */
+uint64_t get_ticks_us(void)
+{
+	static uint64_t start;
+	if (virtual_clock) {
+		return virtual_us;
+	}
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	uint64_t now = (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+	if (!start) {
+		start = now;
+	}
+	return now - start;
+}
+
+uint64_t get_ticks(void)
+{
+	return get_ticks_us() / 1000;
+}
+
+uint32_t get_ticks32(void)
 {
-	return 0;
+	return (uint32_t) get_ticks();
 }
 
 void delay_ms(uint32_t t)
@@ -25,12 +25,180 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "tft.h"
+#include "ili9163c.h"
+#include "font.h"
+#ifdef CONFIG_MIRROR
+#include "mirror.h"
+#endif // CONFIG_MIRROR
+#ifdef CONFIG_SDL
+#include <SDL.h>
+#include "tick.h"
+#endif // CONFIG_SDL
 
 #define TFT_WIDTH   128
 #define TFT_HEIGHT  128
+/** The characters drawn, for emul_tft_draw() */
 uint8_t tft[TFT_WIDTH][TFT_HEIGHT];
+/** The pixels as the display would show them, in the bgr565 of the firmware */
+static uint16_t pixels[TFT_HEIGHT][TFT_WIDTH];
+/** Off when running headless, nobody is looking */
+static bool tft_enabled = true;
+static bool is_inverted;
+static uint32_t frame_depth;
+
+/** Pixels the firmware sent to the display, what the SPI would carry. They
+  * are counted as the operations come in, before the compositor of the
+  * firmware drops any covered by others of the same frame. */
+static uint32_t frame_pixels;
+static uint32_t stat_frames;
+static uint32_t stat_last_pixels;
+static uint32_t stat_max_pixels;
+static uint64_t stat_total_pixels;
+
+#ifdef CONFIG_SDL
+/** Frames shown per second at most, the changes in between are merged */
+#ifndef CONFIG_SDL_FPS
+ #define CONFIG_SDL_FPS  (30)
+#endif
+/** Window pixels per display pixel */
+#ifndef CONFIG_SDL_SCALE
+ #define CONFIG_SDL_SCALE  (4)
+#endif
+static SDL_Window *window;
+static SDL_Renderer *renderer;
+static SDL_Texture *texture;
+static uint64_t present_tick;
+/** Area changed since it was last shown, empty when x2 <= x1 */
+static int32_t dirty_x1, dirty_y1, dirty_x2, dirty_y2;
+#endif // CONFIG_SDL
+
+#ifdef CONFIG_SDL
+/**
+ * @brief Open the window, on the first frame so none is opened headless
+ * @retval false if SDL failed
+ */
+static bool sdl_open(void)
+{
+    if (texture) {
+        return true;
+    }
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        printf("Error: SDL_Init: %s\n", SDL_GetError());
+        return false;
+    }
+    window = SDL_CreateWindow("OpenDPS", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                              CONFIG_SDL_SCALE * TFT_WIDTH, CONFIG_SDL_SCALE * TFT_HEIGHT, SDL_WINDOW_RESIZABLE);
+    renderer = window ? SDL_CreateRenderer(window, -1, 0) : NULL;
+    texture = renderer ? SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGB565, SDL_TEXTUREACCESS_STREAMING, TFT_WIDTH, TFT_HEIGHT) : NULL;
+    if (!texture) {
+        printf("Error: SDL: %s\n", SDL_GetError());
+        return false;
+    }
+    SDL_RenderSetLogicalSize(renderer, TFT_WIDTH, TFT_HEIGHT);
+    dirty_x1 = dirty_y1 = 0;
+    dirty_x2 = TFT_WIDTH;
+    dirty_y2 = TFT_HEIGHT;
+    return true;
+}
+
+/**
+ * @brief Show the changed area in the window, unless a frame was shown less
+ *        than 1/CONFIG_SDL_FPS s ago
+ * @retval none
+ */
+static void sdl_present(void)
+{
+    static uint16_t row[TFT_WIDTH];
+    if (dirty_x2 <= dirty_x1 || get_ticks() - present_tick < 1000 / CONFIG_SDL_FPS || !sdl_open()) {
+        return;
+    }
+    uint16_t mask = is_inverted ? 0xffff : 0;
+    for (int32_t y = dirty_y1; y < dirty_y2; y++) {
+        for (int32_t x = dirty_x1; x < dirty_x2; x++) {
+            row[x - dirty_x1] = pixels[y][x] ^ mask;
+        }
+        SDL_Rect r = { dirty_x1, y, dirty_x2 - dirty_x1, 1 };
+        SDL_UpdateTexture(texture, &r, row, sizeof(row));
+    }
+    SDL_RenderCopy(renderer, texture, NULL, NULL);
+    SDL_RenderPresent(renderer);
+    present_tick = get_ticks();
+    dirty_x1 = dirty_y1 = dirty_x2 = dirty_y2 = 0;
+}
+#endif // CONFIG_SDL
+
+/**
+ * @brief Count the pixels of a drawing operation and clip it to the screen
+ * @param x y w h the area, x and y may be negative, clipped on return
+ * @retval false if nothing of it is on the screen or nobody is looking
+ */
+static bool draw_area(int32_t *x, int32_t *y, int32_t *w, int32_t *h)
+{
+    frame_pixels += *w * *h;
+    if (!tft_enabled) {
+        return false;
+    }
+    int32_t x2 = *x + *w > TFT_WIDTH ? TFT_WIDTH : *x + *w;
+    int32_t y2 = *y + *h > TFT_HEIGHT ? TFT_HEIGHT : *y + *h;
+    *x = *x < 0 ? 0 : *x;
+    *y = *y < 0 ? 0 : *y;
+    if (*x >= x2 || *y >= y2) {
+        return false;
+    }
+    *w = x2 - *x;
+    *h = y2 - *y;
+#ifdef CONFIG_SDL
+    if (dirty_x2 <= dirty_x1) {
+        dirty_x1 = *x;
+        dirty_y1 = *y;
+        dirty_x2 = x2;
+        dirty_y2 = y2;
+    } else {
+        dirty_x1 = *x < dirty_x1 ? *x : dirty_x1;
+        dirty_y1 = *y < dirty_y1 ? *y : dirty_y1;
+        dirty_x2 = x2 > dirty_x2 ? x2 : dirty_x2;
+        dirty_y2 = y2 > dirty_y2 ? y2 : dirty_y2;
+    }
+#endif // CONFIG_SDL
+    return true;
+}
+
+/**
+ * @brief End of an operation, which is a frame of its own outside of
+ *        tft_frame_begin() and tft_frame_end()
+ * @retval none
+ */
+static void draw_done(void)
+{
+    if (frame_depth || !frame_pixels) {
+        return;
+    }
+    stat_frames++;
+    stat_last_pixels = frame_pixels;
+    stat_total_pixels += frame_pixels;
+    if (frame_pixels > stat_max_pixels) {
+        stat_max_pixels = frame_pixels;
+    }
+    frame_pixels = 0;
+#ifdef CONFIG_SDL
+    if (tft_enabled) {
+        sdl_present();
+    }
+#endif // CONFIG_SDL
+}
+
+/**
+ * @brief Turn rendering to the character buffer on or off
+ * @param enable true to render
+ * @retval none
+ */
+void emul_tft_enable(bool enable)
+{
+    tft_enabled = enable;
+}
 
 /**
  * @brief Draw the tft on stdout
@@ -60,6 +228,42 @@ void emul_tft_draw(void)
     }
 }
 
+/**
+ * @brief Print the number of pixels sent per frame, the SPI load of the UI
+ * @retval none
+ */
+void emul_tft_stats(void)
+{
+    printf("TFT: %u frames, %u pixels in the last, %u max, %llu average\n",
+           stat_frames, stat_last_pixels, stat_max_pixels,
+           (unsigned long long) (stat_frames ? stat_total_pixels / stat_frames : 0));
+}
+
+/**
+ * @brief Handle the window events and show changes held back by the frame
+ *        rate cap, called when the firmware is idle
+ * @retval none
+ */
+void emul_tft_poll(void)
+{
+#ifdef CONFIG_SDL
+    if (!texture) {
+        return;
+    }
+    SDL_Event e;
+    while (SDL_PollEvent(&e)) {
+        if (e.type == SDL_QUIT) {
+            exit(EXIT_SUCCESS);
+        } else if (e.type == SDL_WINDOWEVENT) {
+            dirty_x1 = dirty_y1 = 0;
+            dirty_x2 = TFT_WIDTH;
+            dirty_y2 = TFT_HEIGHT;
+        }
+    }
+    sdl_present();
+#endif // CONFIG_SDL
+}
+
 /**
   * @brief Initialize the TFT module
   * @retval none
@@ -76,6 +280,30 @@ void tft_init(void)
 void tft_clear(void)
 {
     memset(tft, 0, sizeof(tft));
+#ifdef CONFIG_MIRROR
+    mirror_clear();
+#endif // CONFIG_MIRROR
+    tft_fill(0, 0, TFT_WIDTH, TFT_HEIGHT, BLACK);
+}
+
+/**
+  * @brief Start collecting drawing operations, frames may be nested
+  * @retval none
+  */
+void tft_frame_begin(void)
+{
+    frame_depth++;
+}
+
+/**
+  * @brief End a frame, the outermost frame flushes the collected operations
+  * @retval none
+  */
+void tft_frame_end(void)
+{
+    if (frame_depth && --frame_depth == 0) {
+        draw_done();
+    }
 }
 
 /**
@@ -89,15 +317,76 @@ void tft_clear(void)
   */
 void tft_blit(uint16_t *bits, uint32_t width, uint32_t height, uint32_t x, uint32_t y)
 {
-    (void) bits;
-    (void) width;
-    (void) height;
-    (void) x;
-    (void) y;
+#ifdef CONFIG_MIRROR
+    mirror_blit(x, y, width, height);
+#endif // CONFIG_MIRROR
+    int32_t cx = x, cy = y, cw = width, ch = height;
+    if (draw_area(&cx, &cy, &cw, &ch)) {
+        for (int32_t j = 0; j < ch; j++) {
+            memcpy(&pixels[cy + j][cx], &bits[(cy - (int32_t) y + j) * width + cx - (int32_t) x], cw * sizeof(uint16_t));
+        }
+    }
+    draw_done();
+}
+
+/**
+  * @brief Blit palette packed graphics on TFT, see pack565.py
+  * @param data run length encoded palette indices
+  * @param palette 16 colors in bgr565 format
+  * @param width width of data
+  * @param height of data
+  * @param x x position
+  * @param y y position
+  * @param invert if true, the colors will be inverted
+  * @retval none
+  */
+void tft_blit_packed(const uint8_t *data, const uint8_t *palette, uint32_t width, uint32_t height, uint32_t x, uint32_t y, bool invert)
+{
+#ifdef CONFIG_MIRROR
+    mirror_blit(x, y, width, height);
+#endif // CONFIG_MIRROR
+    int32_t cx = x, cy = y, cw = width, ch = height;
+    if (draw_area(&cx, &cy, &cw, &ch)) {
+        uint16_t mask = invert ? 0xffff : 0;
+        uint16_t color = 0;
+        uint32_t run = 0;
+        for (uint32_t j = 0; j < height; j++) {
+            for (uint32_t i = 0; i < width; i++) {
+                if (!run) {
+                    const uint8_t *c = &palette[2 * (*data & 0x0f)];
+                    run = (*data++ >> 4) + 1;
+                    color = ((c[0] << 8) | c[1]) ^ mask;
+                }
+                run--;
+                int32_t px = (int32_t) (x + i), py = (int32_t) (y + j);
+                if (px >= cx && px < cx + cw && py >= cy && py < cy + ch) {
+                    pixels[py][px] = color;
+                }
+            }
+        }
+    }
+    draw_done();
 }
 
 /**
-  * @brief Blit character on TFT
+  * @brief Draw a highlight frame around a glyph
+  * @param xpos x position
+  * @param ypos y position
+  * @param glyph_height height of frame
+  * @param glyph_width width of frame
+  * @param color color in bgr565 format
+  * @retval none
+  */
+static void frame_glyph(uint32_t xpos, uint32_t ypos, uint32_t glyph_height, uint32_t glyph_width, uint16_t color)
+{
+    tft_fill(xpos, ypos-1, glyph_width, 1, color);
+    tft_fill(xpos, ypos + glyph_height, glyph_width, 1, color);
+    tft_fill(xpos-1, ypos, 1, glyph_height, color);
+    tft_fill(xpos + glyph_width, ypos, 1, glyph_height, color);
+}
+
+/**
+  * @brief Blit character on TFT, with the same operations as the firmware
   * @param size size of character (0:small 1:large)
   * @param ch the character (must be a supported character)
   * @param x x position
@@ -109,14 +398,96 @@ void tft_blit(uint16_t *bits, uint32_t width, uint32_t height, uint32_t x, uint3
   */
 void tft_putch(uint8_t size, char ch, uint32_t x, uint32_t y, uint32_t w, uint32_t h, bool highlight)
 {
+    uint32_t glyph_width, glyph_height;
+    uint32_t xpos, ypos;
+    const uint8_t *glyph, *palette;
+#ifdef CONFIG_MIRROR
+    mirror_glyph(size, ch, x, y, w, h, highlight);
+#endif // CONFIG_MIRROR
     if (x >= TFT_WIDTH || y >= TFT_HEIGHT) {
         printf("Error: character '%c' put outside of screen (%d, %d)\n", ch, x, y);
+        return;
+    }
+    if (tft_enabled) {
+        tft[x][y] = ch;
+    }
+    const font_t *font = font_get(size);
+    int32_t glyph_index = font ? font_glyph(font, ch) : -1;
+    if (glyph_index < 0) {
+        return;
+    }
+    glyph_width = font->widths[glyph_index];
+    glyph = font->pix[glyph_index];
+    palette = font->palette;
+    glyph_height = font->height;
+
+    if (w < glyph_width) {
+        w = glyph_width + 2;
     }
-    tft[x][y] = ch;
-    (void) size;
-    (void) w;
-    (void) h;
-    (void) highlight;
+    if (h < glyph_height) {
+        h = glyph_height + 2;
+    }
+    xpos = x+(w-glyph_width)/2;
+    ypos = y+(h-glyph_height)/2;
+
+#ifdef CONFIG_MIRROR
+    mirror_mute(true);
+#endif // CONFIG_MIRROR
+    tft_frame_begin();
+    tft_blit_packed(glyph, palette, glyph_width, glyph_height, xpos, ypos, highlight);
+    if (x < xpos) {
+        tft_fill(x, y, xpos-x, h, BLACK);
+    }
+    if (xpos+glyph_width < x+w) {
+        tft_fill(xpos+glyph_width, y, x+w-(xpos+glyph_width)+1, h, BLACK);
+    }
+    frame_glyph(xpos, ypos, glyph_height, glyph_width, highlight ? WHITE : BLACK);
+    tft_frame_end();
+#ifdef CONFIG_MIRROR
+    mirror_mute(false);
+#endif // CONFIG_MIRROR
+}
+
+/**
+  * @brief Draw a string on TFT, with the pixels the firmware would send
+  * @param size size of the font, see font_get()
+  * @param str the string
+  * @param x x position
+  * @param y y position
+  * @param highlight if true, the string will be inverted
+  * @retval width of the string in pixels, see font_text_width()
+  */
+uint32_t tft_puts(uint8_t size, const char *str, uint32_t x, uint32_t y, bool highlight)
+{
+    const font_t *font = font_get(size);
+    uint32_t width = 0;
+    if (!font) {
+        return 0;
+    }
+    tft_frame_begin();
+    for (; *str; str++) {
+        int32_t glyph = font_glyph(font, *str);
+        if (glyph < 0) {
+            continue;
+        }
+        uint32_t glyph_width = font->widths[glyph];
+        uint32_t advance = font->advances[glyph];
+#ifdef CONFIG_MIRROR
+        mirror_glyph(size, *str, x + width, y, advance, font->height, highlight);
+        mirror_mute(true);
+#endif // CONFIG_MIRROR
+        if (tft_enabled && x + width < TFT_WIDTH && y < TFT_HEIGHT) {
+            tft[x + width][y] = *str;
+        }
+        tft_blit_packed(font->pix[glyph], font->palette, glyph_width, font->height, x + width, y, highlight);
+        tft_fill(x + width + glyph_width, y, advance - glyph_width, font->height, highlight ? WHITE : BLACK);
+#ifdef CONFIG_MIRROR
+        mirror_mute(false);
+#endif // CONFIG_MIRROR
+        width += advance;
+    }
+    tft_frame_end();
+    return width;
 }
 
 /**
@@ -129,12 +500,20 @@ void tft_putch(uint8_t size, char ch, uint32_t x, uint32_t y, uint32_t w, uint32
   */
 void tft_fill_pattern(uint32_t x1, uint32_t y1, uint32_t x2, uint32_t y2, uint8_t *fill, uint32_t fill_size)
 {
-    (void) x1;
-    (void) y1;
-    (void) x2;
-    (void) y2;
-    (void) fill;
-    (void) fill_size;
+#ifdef CONFIG_MIRROR
+    mirror_fill(x1, y1, x2-x1+1, y2-y1+1, fill_size >= 2 ? (fill[0] << 8) | fill[1] : 0);
+#endif // CONFIG_MIRROR
+    int32_t cx = x1, cy = y1, cw = x2-x1+1, ch = y2-y1+1;
+    uint32_t width = cw;
+    if (fill_size >= 2 && draw_area(&cx, &cy, &cw, &ch)) {
+        for (int32_t j = 0; j < ch; j++) {
+            for (int32_t i = 0; i < cw; i++) {
+                uint32_t k = 2 * ((cy - (int32_t) y1 + j) * width + cx - (int32_t) x1 + i);
+                pixels[cy + j][cx + i] = (fill[k % fill_size] << 8) | fill[(k + 1) % fill_size];
+            }
+        }
+    }
+    draw_done();
 }
 
 /**
@@ -147,11 +526,18 @@ void tft_fill_pattern(uint32_t x1, uint32_t y1, uint32_t x2, uint32_t y2, uint8_
   */
 void tft_fill(uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint16_t color)
 {
-    (void) x;
-    (void) y;
-    (void) w;
-    (void) h;
-    (void) color;
+#ifdef CONFIG_MIRROR
+    mirror_fill(x, y, w, h, color);
+#endif // CONFIG_MIRROR
+    int32_t cx = x, cy = y, cw = w, ch = h;
+    if (draw_area(&cx, &cy, &cw, &ch)) {
+        for (int32_t j = 0; j < ch; j++) {
+            for (int32_t i = 0; i < cw; i++) {
+                pixels[cy + j][cx + i] = color;
+            }
+        }
+    }
+    draw_done();
 }
 
 /**
@@ -161,7 +547,15 @@ void tft_fill(uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint16_t color)
   */
 void tft_invert(bool invert)
 {
-    (void) invert;
+#ifdef CONFIG_MIRROR
+    mirror_invert(invert);
+#endif // CONFIG_MIRROR
+    is_inverted = invert;
+#ifdef CONFIG_SDL
+    dirty_x1 = dirty_y1 = 0;
+    dirty_x2 = TFT_WIDTH;
+    dirty_y2 = TFT_HEIGHT;
+#endif // CONFIG_SDL
 }
 
 /**
@@ -170,5 +564,5 @@ void tft_invert(bool invert)
   */
 bool tft_is_inverted(void)
 {
-    return false;
+    return is_inverted;
 }
@@ -48,6 +48,7 @@
 #include <lwip/igmp.h>
 #include <ssid_config.h>
 #include <espressif/esp_wifi.h>
+#include <espressif/spi_flash.h>
 #include <stdin_uart_interrupt.h>
 #include "lwipopts.h"
 #include "uhej.h"
@@ -65,10 +66,40 @@ static SemaphoreHandle_t wifi_alive_sem;
 /** A queue to synchronize UART comms */
 static QueueHandle_t tx_queue;
 
-#define TX_QUEUE_DEPTH  (5)
+/** Room for a full window of upgrade data packets and then some */
+#define TX_QUEUE_DEPTH  (UPGRADE_MAX_WINDOW + 2)
 
 #define UART_RX_TIMEOUT_MS  (250)
 
+/** Number of requests that may await a response from the DPS. The DPS
+    handles its frames in order, so a response answers the oldest pending
+    request for the same command. A cmd_set_and_measure is answered when the
+    measurement is done, after the responses to later requests. */
+#define PIPELINE_DEPTH  (4)
+
+/** The rate the proxy moves the DPS link to with cmd_set_baud, set it to
+    UART_DEFAULT_BAUD to stay at that */
+#ifndef CONFIG_DPS_BAUD
+ #define CONFIG_DPS_BAUD  (921600)
+#endif
+/** Time between attempts to move the link, longer than BAUD_IDLE_MS so the
+    DPS has dropped any rate it was left at */
+#define BAUD_RETRY_MS  (BAUD_IDLE_MS + 1000)
+/** The DPS is pinged when nothing was sent to it for this long, keeping the
+    negotiated rate alive */
+#define BAUD_KEEPALIVE_MS  (BAUD_IDLE_MS / 4)
+
+/** The rate of the DPS link, only touched by uart_comm_task */
+static uint32_t dps_baud = UART_DEFAULT_BAUD;
+static uint32_t baud_retry_ms;
+/** Time of the latest frame sent to the DPS */
+static uint32_t uart_tx_ms;
+/** Set when a request timed out, the DPS may have dropped the rate */
+static volatile bool baud_lost;
+/** Given when the DPS answers the proxy's own cmd_set_baud or cmd_ping */
+static SemaphoreHandle_t baud_sem;
+static uint8_t baud_status;
+
 /** A structure used in the tx_queue */
 typedef struct {
     /** if client_port != 0, send the respnse frame to client_addr:client_port
@@ -76,10 +107,195 @@ typedef struct {
     struct udp_pcb *upcb;
     ip_addr_t client_addr;
     uint16_t client_port;
-    uint8_t frame[MAX_FRAME_LENGTH];
-    uint32_t frame_length;
+    /** Id of the TCP connection of the client, 0 for UDP clients */
+    uint32_t tcp_conn;
+    /** The frame as received, possibly chained. Freed by uart_comm_task */
+    struct pbuf *p;
 } tx_item_t;
 
+/** A request sent to the DPS awaiting its response */
+typedef struct {
+    struct udp_pcb *upcb;
+    ip_addr_t client_addr;
+    uint16_t client_port;
+    uint32_t tcp_conn;
+    uint8_t cmd; /** With the cmd_tagged bit of tagged requests */
+    uint8_t tag;
+    uint32_t sent_ms;
+    uint32_t timeout_ms; /** Longer for a cmd_set_and_measure */
+} pending_t;
+
+/** FIFO of requests in flight, guarded by pending_mutex */
+static pending_t pending[PIPELINE_DEPTH];
+static uint32_t pending_head;
+static uint32_t pending_count;
+static SemaphoreHandle_t pending_mutex;
+/** Counts the free slots of pending */
+static SemaphoreHandle_t pending_slots;
+
+/** Frames from the DPS are received straight into pbufs of this size */
+#define RX_FRAME_SIZE  FRAME_OVERHEAD(MAX_BULK_FRAME_LENGTH)
+
+/** Frames the DPS sends on its own, like streamed samples, go to the client
+    that sent the latest request */
+static pending_t last_client;
+
+/** Frames for a UDP client are coalesced into datagrams of up to this size,
+    the Ethernet MTU less the IP and UDP headers */
+#define UDP_BATCH_SIZE  (1500 - 20 - 8)
+
+/** Frames from the DPS not yet sent to udp_batch_client, chained into one
+    datagram. Only touched by uart_rx_task. */
+static struct pbuf *udp_batch;
+static pending_t udp_batch_client;
+
+/** Queries are answered from the latest cmd_query response if it is no older
+    than this. While clients are querying, the proxy refreshes the response
+    itself twice as often, so the UART sees one query per refresh no matter
+    how many clients poll. */
+#ifndef CONFIG_QUERY_MAX_AGE_MS
+ #define CONFIG_QUERY_MAX_AGE_MS  (200)
+#endif
+#define QUERY_REFRESH_MS  (CONFIG_QUERY_MAX_AGE_MS / 2)
+
+/** The proxy stops refreshing when no client has queried for this long */
+#define QUERY_IDLE_MS  (2000)
+
+/** The TCP port for persistent connections, streaming without losses */
+#define TCP_PORT  (5005)
+
+/** Largest frame a TCP client may send, an upgrade data packet */
+#define TCP_RX_FRAME_SIZE  FRAME_OVERHEAD(UPGRADE_MAX_CHUNK_SIZE + 5)
+
+/** The TCP client, there is room for one. Only touched in the tcpip thread,
+    or with the tcpip core locked. */
+static struct tcp_pcb *tcp_client;
+/** Incremented for every connection, so stale requests can be told apart */
+static uint32_t tcp_conn_id;
+/** The frame being received from the TCP client */
+static struct pbuf *tcp_rx;
+static uint32_t tcp_rx_size;
+/** A received frame waiting for room in tx_queue. The pbuf it came in is
+    refused, lwIP hands it in again later, and tcp_refused_pos bytes of it
+    were consumed. */
+static struct pbuf *tcp_ready;
+static struct pbuf *tcp_refused;
+static uint32_t tcp_refused_pos;
+/** Set when the client has been sent streamed samples */
+static bool tcp_streaming;
+/** Number of frames dropped because the client did not keep up */
+static uint32_t tcp_dropped;
+
+/** The latest cmd_query response, guarded by pending_mutex */
+static uint8_t query_cache[FRAME_OVERHEAD(64)];
+static uint32_t query_cache_length;
+static uint32_t query_cache_ms;
+/** Time of the latest cmd_query from a client */
+static uint32_t query_client_ms;
+
+/** Firmware staged for the DPS is stored at this sector aligned address. It
+    must be clear of the rboot slots and of the SDK parameters at the end of
+    the flash, the default suits the two 1MB slots of a 4MB module. */
+#ifndef CONFIG_STAGE_FLASH_ADDR
+ #define CONFIG_STAGE_FLASH_ADDR  (0x300000)
+#endif
+/** Largest image that may be staged, the flash of the DPS */
+#define STAGE_MAX_SIZE  (64 * 1024)
+/** The bootloader answers cmd_upgrade_start once the app has restarted
+    into it */
+#define STAGE_START_TIMEOUT_MS  (2000)
+/** Number of timeouts in a row before a staged upgrade is given up */
+#define STAGE_RETRIES  (5)
+
+/** The staged image. Written by uart_comm_task, stage_state,
+    stage_upgrade_status and stage_offset are also read by the tcpip thread
+    for cmd_stage_status. */
+static volatile uint8_t stage_state = stage_idle;
+static volatile uint8_t stage_upgrade_status;
+/** Bytes received while receiving, bytes accepted by the DPS while
+    upgrading */
+static volatile uint32_t stage_offset;
+static uint32_t stage_length;
+static uint16_t stage_crc;
+/** Set when the whole image is in flash with the right crc */
+static bool stage_valid;
+/** Frames of cmd_stage_data are copied here to be unpacked */
+static uint8_t stage_frame[FRAME_OVERHEAD(STAGE_MAX_CHUNK_SIZE + 5)];
+/** A chunk of the image on its way to or from the flash, word aligned for
+    the flash API */
+static uint32_t stage_buf[STAGE_MAX_CHUNK_SIZE / 4];
+/** Given when the DPS answers the proxy's own cmd_upgrade_start or
+    cmd_upgrade_data, the payload of the response is in stage_resp (guarded
+    by pending_mutex) */
+static SemaphoreHandle_t stage_sem;
+static uint8_t stage_resp[FRAME_OVERHEAD(16)];
+static int32_t stage_resp_length;
+
+static void tcp_send_frame(struct pbuf *p, bool stream);
+static uint8_t frame_command(struct pbuf *p);
+
+/**
+  * @brief Get a copy of the cached cmd_query response if it is fresh
+  * @retval the response, or NULL if the query has to go to the DPS
+  */
+static struct pbuf *query_cached(void)
+{
+    struct pbuf *p = NULL;
+    xSemaphoreTake(pending_mutex, portMAX_DELAY);
+    query_client_ms = systime_ms();
+    if (query_cache_length && systime_ms() - query_cache_ms <= CONFIG_QUERY_MAX_AGE_MS) {
+        p = pbuf_alloc(PBUF_TRANSPORT, query_cache_length, PBUF_RAM);
+        if (p) {
+            memcpy(p->payload, query_cache, query_cache_length);
+        }
+    }
+    xSemaphoreGive(pending_mutex);
+    return p;
+}
+
+/**
+  * @brief Create the response to cmd_stage_status
+  * @retval the response, or NULL if it could not be allocated
+  */
+static struct pbuf *stage_status_frame(void)
+{
+    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, FRAME_OVERHEAD(12), PBUF_RAM);
+    if (!p) {
+        return NULL;
+    }
+    uint32_t offset = stage_offset;
+    DECLARE_FRAME_AT((uint8_t*) p->payload, p->len);
+    PACK8(cmd_response | cmd_stage_status);
+    PACK8(1);
+    PACK8(stage_state);
+    PACK8(stage_upgrade_status);
+    PACK32(offset);
+    PACK32(stage_length);
+    FINISH_FRAME();
+    pbuf_realloc(p, _length);
+    return p;
+}
+
+/**
+  * @brief Answer a cmd_query from the cache if the cached response is fresh
+  * @param upcb the udp_pcb which received the query
+  * @param addr the client address
+  * @param port the client port
+  * @retval true if the query was answered
+  */
+static bool query_answer(struct udp_pcb *upcb, const ip_addr_t *addr, u16_t port)
+{
+    struct pbuf *p = query_cached();
+    if (!p) {
+        return false;
+    }
+    err_t err = udp_sendto(upcb, p, addr, port);
+    if (err < 0) {
+        printf("Error sending message: %s (%d)\n", lwip_strerr(err), err);
+    }
+    pbuf_free(p);
+    return true;
+}
 
 /**
   * @brief This function is called when an UDP datagrm has been received on the port UDP_PORT.
@@ -95,70 +311,535 @@ static void udp_receive_callback(void *arg, struct udp_pcb *upcb, struct pbuf *p
 {
     if (p) {
         tx_item_t item;
+        if (frame_command(p) == cmd_query && query_answer(upcb, addr, port)) {
+            pbuf_free(p);
+            return;
+        }
+        if (frame_command(p) == cmd_stage_status) {
+            pbuf_free(p);
+            if ((p = stage_status_frame()) != NULL) {
+                err_t err = udp_sendto(upcb, p, addr, port);
+                if (err < 0) {
+                    printf("Error sending message: %s (%d)\n", lwip_strerr(err), err);
+                }
+                pbuf_free(p);
+            }
+            return;
+        }
         memcpy((void*) &item.client_addr, (void*) addr, sizeof(ip_addr_t));
         item.upcb = upcb;
         item.client_port = port;
-        memcpy((void*) item.frame, (void*) p->payload, p->len);
-        item.frame_length = p->len;
+        item.tcp_conn = 0;
+        item.p = p; /** Our reference, freed once sent on the UART */
         if (pdPASS != xQueueSend(tx_queue, (void*) &item, 1000/portTICK_PERIOD_MS)) {
             printf("Failed to enqueue\n");
+            pbuf_free(p);
             /** @todo Handle queue error */
         }
-        pbuf_free(p);
     }
 }
 
 /**
-  * @brief Send buffer on UART 0
-  * @param buffer buffer to send
-  * @param length length of buffer
+  * @brief Called when a datagram arrives on FIRE_MCAST_GROUP. A cmd_fire is
+  *        put first in the queue, so every proxy hands it to its DPS right
+  *        away, and its response is dropped. Anything else is ignored.
+  * @param arg user supplied argument (udp_pcb.recv_arg)
+  * @param upcb the udp_pcb which received data
+  * @param p the packet buffer that was received
+  * @param addr the remote IP address from which the packet was received
+  * @param port the remote port from which the packet was received
+  * @retval None
+  */
+static void fire_receive_callback(void *arg, struct udp_pcb *upcb, struct pbuf *p, const ip_addr_t *addr, u16_t port)
+{
+    (void) arg;
+    (void) addr;
+    (void) port;
+    if (p) {
+        tx_item_t item;
+        if (frame_command(p) != cmd_fire) {
+            pbuf_free(p);
+            return;
+        }
+        item.upcb = upcb;
+        item.client_port = 0;
+        item.tcp_conn = 0;
+        item.p = p;
+        if (pdPASS != xQueueSendToFront(tx_queue, (void*) &item, 0)) {
+            printf("Failed to enqueue fire\n");
+            pbuf_free(p);
+        }
+    }
+}
+
+/**
+  * @brief Create a request of the proxy itself, not answering any client
+  * @param item the request
+  * @param payload the payload of the frame
+  * @param length length of payload
+  * @retval true if the pbuf could be allocated
+  */
+static bool create_dps_request(tx_item_t *item, const uint8_t *payload, uint32_t length)
+{
+    item->client_port = 0;
+    item->tcp_conn = 0;
+    item->p = pbuf_alloc(PBUF_RAW, MAX_FRAME_LENGTH, PBUF_RAM);
+    if (!item->p) {
+        return false;
+    }
+    DECLARE_FRAME(MAX_FRAME_LENGTH);
+    for (uint32_t i = 0; i < length; i++) {
+        PACK8(payload[i]);
+    }
+    FINISH_FRAME();
+    memcpy(item->p->payload, _buffer, _length);
+    pbuf_realloc(item->p, _length);
+    return true;
+}
+
+/**
+  * @brief Send a command without arguments to the DPS, not answering any client
+  * @param cmd the command
   * @retval None
   */
-static void uart_tx(uint8_t *buffer, uint32_t length)
+static void send_dps_command(command_t cmd)
 {
-    do {
-        uart_putc(0, *buffer);
-        buffer++;
-    } while(length--);
+    tx_item_t item;
+    uint8_t payload = cmd;
+    if (!create_dps_request(&item, &payload, 1)) {
+        return;
+    }
+    if (pdPASS != xQueueSend(tx_queue, (void*) &item, 1000/portTICK_PERIOD_MS)) {
+        printf("Failed to enqueue\n");
+        pbuf_free(item.p);
+    }
+}
+
+/**
+  * @brief Forget the TCP client, stopping the stream it left running
+  * @retval None
+  */
+static void tcp_client_gone(void)
+{
+    tcp_client = NULL;
+    if (tcp_rx) {
+        pbuf_free(tcp_rx);
+        tcp_rx = NULL;
+    }
+    if (tcp_ready) {
+        pbuf_free(tcp_ready);
+        tcp_ready = NULL;
+    }
+    tcp_refused = NULL; /** Freed by lwIP with the pcb */
+    if (tcp_streaming) {
+        tcp_streaming = false;
+        send_dps_command(cmd_stream_stop);
+    }
 }
 
 /**
-  * @brief Receive a frame (SOF..EOF) on UART 0
-  * @param buffer buffer to store frame
-  * @param length length of buffer
-  * @retval length of frame received
+  * @brief Called by lwIP when the TCP client connection failed, the pcb is
+  *        already freed
+  * @retval None
   */
-static uint32_t uart_rx_frame(uint8_t *buffer, uint32_t buffer_size)
+static void tcp_error_callback(void *arg, err_t err)
 {
-    uint32_t size = 0;
-    uint8_t ch;
-    bool sof = false;
-    bool timeout = false;
-    uint32_t start_time = systime_ms();
-    while(size < buffer_size && !timeout) {
-        if (uart0_num_char() > 0) {
-            if (read(0, (void*) &ch, 1)) { // 0 is stdin
-                if (ch == _SOF) {
-                    size = 0;
-                    sof = true;
+    (void) arg;
+    printf("TCP client error %d\n", err);
+    tcp_client_gone();
+}
+
+/**
+  * @brief Queue tcp_ready for the DPS without waiting, in the tcpip thread
+  * @retval true if it was queued
+  */
+static bool tcp_queue_ready(void)
+{
+    tx_item_t item;
+    item.upcb = NULL;
+    item.client_port = 0;
+    item.tcp_conn = tcp_conn_id;
+    item.p = tcp_ready;
+    if (pdPASS != xQueueSend(tx_queue, (void*) &item, 0)) {
+        return false;
+    }
+    tcp_ready = NULL;
+    return true;
+}
+
+/**
+  * @brief Called by lwIP when data has been received from the TCP client.
+  *        The byte stream is split into frames that are queued for the DPS.
+  *        When tx_queue is full the rest of the data is refused and only
+  *        the bytes consumed are acked, so the client is held back by the
+  *        TCP window.
+  * @retval ERR_OK, ERR_MEM if the data was refused or ERR_ABRT if the pcb
+  *         was aborted
+  */
+static err_t tcp_receive_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
+{
+    (void) arg;
+    uint32_t pos = 0, n = 0;
+    if (p && p == tcp_refused) {
+        pos = tcp_refused_pos;
+        tcp_refused = NULL;
+        if (tcp_ready && !tcp_queue_ready()) {
+            tcp_refused = p;
+            return ERR_MEM;
+        }
+    }
+    if (!p) {
+        /** The client closed the connection */
+        tcp_client_gone();
+        if (tcp_close(tpcb) != ERR_OK) {
+            tcp_abort(tpcb);
+            return ERR_ABRT;
+        }
+        return ERR_OK;
+    }
+    for (struct pbuf *q = p; q; q = q->next) {
+        uint8_t *buffer = (uint8_t*) q->payload;
+        for (uint32_t i = 0; i < q->len; i++) {
+            uint8_t ch = buffer[i];
+            if (n++ < pos) {
+                continue; /** Consumed before the pbuf was refused */
+            }
+            if (ch == _SOF) {
+                if (!tcp_rx) {
+                    tcp_rx = pbuf_alloc(PBUF_RAW, TCP_RX_FRAME_SIZE, PBUF_RAM);
                 }
-                if (sof) {
-                    buffer[size++] = ch;
+                tcp_rx_size = 0;
+            }
+            if (!tcp_rx) {
+                continue; /** Out of memory or not in a frame, wait for the next SOF */
+            }
+            if (tcp_rx_size < TCP_RX_FRAME_SIZE) {
+                ((uint8_t*) tcp_rx->payload)[tcp_rx_size++] = ch;
+            }
+            if (ch == _EOF) {
+                struct pbuf *cached;
+                pbuf_realloc(tcp_rx, tcp_rx_size);
+                if (frame_command(tcp_rx) == cmd_query && (cached = query_cached()) != NULL) {
+                    tcp_send_frame(cached, false);
+                    pbuf_free(cached);
+                    pbuf_free(tcp_rx);
+                    tcp_rx = NULL;
+                    continue;
                 }
-                if (ch == _EOF) {
-                    sof = false;
-                    break;
+                if (frame_command(tcp_rx) == cmd_stage_status) {
+                    pbuf_free(tcp_rx);
+                    tcp_rx = NULL;
+                    if ((cached = stage_status_frame()) != NULL) {
+                        tcp_send_frame(cached, false);
+                        pbuf_free(cached);
+                    }
+                    continue;
+                }
+                tcp_ready = tcp_rx;
+                tcp_rx = NULL;
+                if (!tcp_queue_ready()) {
+                    tcp_recved(tpcb, n - pos);
+                    tcp_refused = p;
+                    tcp_refused_pos = n;
+                    return ERR_MEM;
                 }
             }
+        }
+    }
+    tcp_recved(tpcb, p->tot_len - pos);
+    pbuf_free(p);
+    return ERR_OK;
+}
+
+/**
+  * @brief Called by lwIP when a TCP client connects
+  * @retval ERR_OK if the connection was accepted
+  */
+static err_t tcp_accept_callback(void *arg, struct tcp_pcb *newpcb, err_t err)
+{
+    (void) arg;
+    if (err != ERR_OK || !newpcb) {
+        return ERR_VAL;
+    }
+    if (tcp_client) {
+        /** One client at a time, the others may still use UDP */
+        tcp_abort(newpcb);
+        return ERR_ABRT;
+    }
+    tcp_client = newpcb;
+    tcp_conn_id++;
+    if (tcp_conn_id == 0) {
+        tcp_conn_id = 1;
+    }
+    tcp_streaming = false;
+    tcp_nagle_disable(newpcb);
+    tcp_recv(newpcb, tcp_receive_callback);
+    tcp_err(newpcb, tcp_error_callback);
+    return ERR_OK;
+}
+
+/**
+  * @brief Send a frame to the TCP client, in the tcpip thread or with the
+  *        tcpip core locked. A frame that does not fit the send buffer is
+  *        dropped whole, so the byte stream always holds complete frames.
+  * @param p the frame, trimmed to size
+  * @param stream true if the frame holds streamed samples
+  * @retval None
+  */
+static void tcp_send_frame(struct pbuf *p, bool stream)
+{
+    if (tcp_sndbuf(tcp_client) < p->tot_len || tcp_sndqueuelen(tcp_client) >= TCP_SND_QUEUELEN - 1) {
+        tcp_dropped++;
+        printf("TCP client is behind, %u frames dropped\n", tcp_dropped);
+        return;
+    }
+    for (struct pbuf *q = p; q; q = q->next) {
+        (void) tcp_write(tcp_client, q->payload, q->len, TCP_WRITE_FLAG_COPY | (q->next ? TCP_WRITE_FLAG_MORE : 0));
+    }
+    (void) tcp_output(tcp_client);
+    tcp_streaming |= stream;
+}
+
+/**
+  * @brief Send a frame from the DPS to the TCP client
+  * @param conn the connection id of the client
+  * @param p the frame, trimmed to size
+  * @param stream true if the frame holds streamed samples
+  * @retval None
+  */
+static void tcp_forward(uint32_t conn, struct pbuf *p, bool stream)
+{
+    sys_lock_tcpip_core();
+    if (tcp_client && conn == tcp_conn_id) {
+        tcp_send_frame(p, stream);
+    }
+    sys_unlock_tcpip_core();
+}
+
+/**
+  * @brief Send a pbuf chain on UART 0
+  * @param p the pbuf chain to send
+  * @retval None
+  */
+static void uart_tx(struct pbuf *p)
+{
+    uart_tx_ms = systime_ms();
+    for (struct pbuf *q = p; q; q = q->next) {
+        uint8_t *buffer = (uint8_t*) q->payload;
+        for (uint32_t i = 0; i < q->len; i++) {
+            uart_putc(0, buffer[i]);
+        }
+    }
+}
+
+/**
+  * @brief Send a frame from the DPS to a client
+  * @param client the client
+  * @param p the frame, trimmed to size
+  * @retval None
+  */
+static void udp_forward(pending_t *client, struct pbuf *p)
+{
+    err_t err = udp_sendto(client->upcb, p, &client->client_addr, client->client_port);
+    if (err < 0) {
+        printf("Error sending message: %s (%d)\n", lwip_strerr(err), err);
+    }
+}
+
+/**
+  * @brief Send the frames coalesced for a UDP client, if any
+  * @retval None
+  */
+static void udp_flush(void)
+{
+    if (udp_batch) {
+        udp_forward(&udp_batch_client, udp_batch);
+        pbuf_free(udp_batch);
+        udp_batch = NULL;
+    }
+}
+
+/**
+  * @brief Coalesce a frame from the DPS with the frames before it to the
+  *        same UDP client. The frames of another client, or ones a frame
+  *        does not fit with, are sent first so every client receives its
+  *        frames in order.
+  * @param client the client
+  * @param p the frame, trimmed to size, the batch takes it over
+  * @retval None
+  */
+static void udp_queue(pending_t *client, struct pbuf *p)
+{
+    if (udp_batch && (udp_batch->tot_len + p->tot_len > UDP_BATCH_SIZE ||
+                      udp_batch_client.upcb != client->upcb ||
+                      udp_batch_client.client_port != client->client_port ||
+                      !ip_addr_cmp(&udp_batch_client.client_addr, &client->client_addr))) {
+        udp_flush();
+    }
+    if (udp_batch) {
+        pbuf_cat(udp_batch, p);
+    } else {
+        udp_batch = p;
+        udp_batch_client = *client;
+    }
+}
+
+/**
+  * @brief Get a byte of the payload of a frame
+  * @param p the frame, starting with SOF
+  * @param index index of the byte in the unescaped payload
+  * @retval the byte, 0 if the frame is too short
+  */
+static uint8_t frame_byte(struct pbuf *p, uint32_t index)
+{
+    uint32_t pos = 1;
+    while (pos + 2 < p->tot_len) {
+        uint8_t b = pbuf_get_at(p, pos++);
+        if (b == _DLE) {
+            b = pbuf_get_at(p, pos++) ^ _XOR;
+        }
+        if (index-- == 0) {
+            return b;
+        }
+    }
+    return 0;
+}
+
+/**
+  * @brief Get the command of a frame
+  * @param p the frame, starting with SOF
+  * @retval the command (with the cmd_response bit of responses)
+  */
+static uint8_t frame_command(struct pbuf *p)
+{
+    return frame_byte(p, 0);
+}
+
+/**
+  * @brief Check if the DPS answers a request after the requests that follow
+  * @param req the request
+  * @retval true for a cmd_set_and_measure
+  */
+static bool pending_deferred(const pending_t *req)
+{
+    return (req->cmd & ~cmd_tagged) == cmd_set_and_measure;
+}
+
+/**
+  * @brief Remove a request from pending, must be called with pending_mutex
+  *        taken
+  * @param i position of the request, 0 for the oldest
+  * @retval None
+  */
+static void pending_remove(uint32_t i)
+{
+    for (; i + 1 < pending_count; i++) {
+        pending[(pending_head + i) % PIPELINE_DEPTH] = pending[(pending_head + i + 1) % PIPELINE_DEPTH];
+    }
+    pending_count--;
+    xSemaphoreGive(pending_slots);
+}
+
+/**
+  * @brief Drop the requests the DPS did not answer in time, must be called
+  *        with pending_mutex taken
+  * @retval None
+  */
+static void pending_expire(void)
+{
+    for (uint32_t i = 0; i < pending_count; ) {
+        const pending_t *req = &pending[(pending_head + i) % PIPELINE_DEPTH];
+        if (systime_ms() - req->sent_ms >= req->timeout_ms) {
+            printf("Timeout from DPS\n");
+            baud_lost = true;
+            pending_remove(i);
         } else {
-            delay_ms(5);
+            i++;
+        }
+    }
+}
+
+/**
+  * @brief Find the client of a response, the oldest pending request for the
+  *        same command, and tag if the response is tagged. Older requests
+  *        were lost, the DPS answers in order but for the deferred ones.
+  * @param cmd the command of the response
+  * @param tag the tag of a tagged response
+  * @param client the client is copied here
+  * @retval true if there was a request for the response
+  */
+static bool pending_match(uint8_t cmd, uint8_t tag, pending_t *client)
+{
+    bool found = false;
+    xSemaphoreTake(pending_mutex, portMAX_DELAY);
+    /** A late response must not answer a request that timed out */
+    pending_expire();
+    for (uint32_t i = 0; i < pending_count; i++) {
+        pending_t *req = &pending[(pending_head + i) % PIPELINE_DEPTH];
+        if (req->cmd == cmd && (!(cmd & cmd_tagged) || req->tag == tag)) {
+            found = true;
+            *client = *req;
+            for (uint32_t n = i + 1; n-- > 0; ) {
+                if (n == i || !pending_deferred(&pending[(pending_head + n) % PIPELINE_DEPTH])) {
+                    pending_remove(n);
+                }
+            }
+            break;
         }
-        timeout = systime_ms() - start_time >= UART_RX_TIMEOUT_MS;
     }
-    if (timeout) {
-        size = 0;
+    xSemaphoreGive(pending_mutex);
+    return found;
+}
+
+/**
+  * @brief Handle a frame received from the DPS
+  * @param p the pbuf holding the frame (SOF..EOF) at its start
+  * @param size size of the frame
+  * @retval true if the pbuf was taken, false if it may be reused
+  */
+static bool handle_dps_frame(struct pbuf *p, uint32_t size)
+{
+    pending_t client;
+    bool found;
+    uint8_t cmd = frame_command(p);
+    if (cmd == (cmd_response | cmd_query) && size <= sizeof(query_cache)) {
+        xSemaphoreTake(pending_mutex, portMAX_DELAY);
+        query_cache_length = pbuf_copy_partial(p, query_cache, size, 0);
+        query_cache_ms = systime_ms();
+        xSemaphoreGive(pending_mutex);
     }
-    return size;
+    if (cmd & cmd_response) {
+        found = pending_match(cmd & ~cmd_response, frame_byte(p, 1), &client);
+    } else {
+        xSemaphoreTake(pending_mutex, portMAX_DELAY);
+        client = last_client;
+        xSemaphoreGive(pending_mutex);
+        found = true;
+    }
+    if (found && client.client_port == 0 && client.tcp_conn == 0 &&
+        (cmd == (cmd_response | cmd_set_baud) || cmd == (cmd_response | cmd_ping))) {
+        baud_status = frame_byte(p, 1);
+        xSemaphoreGive(baud_sem);
+    }
+    if (found && client.client_port == 0 && client.tcp_conn == 0 &&
+        (cmd == (cmd_response | cmd_upgrade_start) || cmd == (cmd_response | cmd_upgrade_data)) &&
+        size <= sizeof(stage_resp)) {
+        xSemaphoreTake(pending_mutex, portMAX_DELAY);
+        stage_resp_length = uframe_extract_payload(stage_resp, pbuf_copy_partial(p, stage_resp, size, 0));
+        xSemaphoreGive(pending_mutex);
+        xSemaphoreGive(stage_sem);
+    }
+    if (!found || (client.client_port == 0 && client.tcp_conn == 0)) {
+        return false; /** Nobody to send it to */
+    }
+    pbuf_realloc(p, size);
+    if (client.tcp_conn) {
+        tcp_forward(client.tcp_conn, p, cmd == cmd_stream_data);
+        pbuf_free(p);
+    } else {
+        udp_queue(&client, p);
+    }
+    return true;
 }
 
 /**
@@ -170,9 +851,16 @@ void set_dps_wifi_status(wifi_status_t status)
 {
     tx_item_t item;
     item.client_port = 0; // Don't transmit to any client
-    item.frame_length = protocol_create_wifi_status((uint8_t*) item.frame, sizeof(item.frame), status);
+    item.tcp_conn = 0;
+    item.p = pbuf_alloc(PBUF_RAW, MAX_FRAME_LENGTH, PBUF_RAM);
+    if (!item.p) {
+        printf("failed to allocate frame %d\n", status);
+        return;
+    }
+    pbuf_realloc(item.p, protocol_create_wifi_status((uint8_t*) item.p->payload, MAX_FRAME_LENGTH, status));
     if (pdPASS != xQueueSend(tx_queue, (void*) &item, 1000/portTICK_PERIOD_MS)) {
         printf("failed to enqueue %d\n", status);
+        pbuf_free(item.p);
         /** @todo: handle error */
     }
 }
@@ -208,6 +896,40 @@ static void uhej_task(void *arg)
             break;
         }
         udp_recv(upcb, udp_receive_callback, upcb);
+
+        ip4_addr_t group;
+        struct udp_pcb *fpcb = udp_new();
+        if (!fpcb || !ip4addr_aton(FIRE_MCAST_GROUP, &group)) {
+            printf("Failed to create fire UDP context\n");
+            break;
+        }
+        err = igmp_joingroup(IP4_ADDR_ANY4, &group);
+        if (ERR_OK == err) {
+            err = udp_bind(fpcb, IP_ADDR_ANY, FIRE_MCAST_PORT);
+        }
+        if (ERR_OK != err) {
+            printf("Failed to join fire multicast group: %d\n", err);
+            break;
+        }
+        udp_recv(fpcb, fire_receive_callback, fpcb);
+
+        struct tcp_pcb *tpcb = tcp_new();
+        if (!tpcb) {
+            printf("Failed to create TCP context\n");
+            break;
+        }
+        err = tcp_bind(tpcb, IP_ADDR_ANY, TCP_PORT);
+        if (ERR_OK != err) {
+            printf("Failed to bind TCP port: %d\n", err);
+            tcp_close(tpcb);
+            break;
+        }
+        tpcb = tcp_listen(tpcb);
+        if (!tpcb) {
+            printf("Failed to listen on TCP port\n");
+            break;
+        }
+        tcp_accept(tpcb, tcp_accept_callback);
         success = true;
     } while(0);
     sys_unlock_tcpip_core();
@@ -222,7 +944,499 @@ static void uhej_task(void *arg)
 }
 
 /**
-  * @brief This is the task that communicates with the DPS
+  * @brief Move the link back to UART_DEFAULT_BAUD when the DPS restarts
+  * @param retry_ms time of the next attempt to move the link again
+  * @retval None
+  */
+static void baud_reset(uint32_t retry_ms)
+{
+    if (dps_baud != UART_DEFAULT_BAUD) {
+        uart_flush_txfifo(0);
+        uart_set_baud(0, UART_DEFAULT_BAUD);
+        dps_baud = UART_DEFAULT_BAUD;
+        baud_retry_ms = retry_ms;
+    }
+}
+
+/**
+  * @brief Send a request to the DPS once there is room for it in the pipeline
+  * @param item the request, its pbuf is freed
+  * @retval None
+  */
+static void uart_request(tx_item_t *item)
+{
+    /** Wait for a free slot, dropping requests that were never answered */
+    while (pdPASS != xSemaphoreTake(pending_slots, UART_RX_TIMEOUT_MS/portTICK_PERIOD_MS)) {
+        xSemaphoreTake(pending_mutex, portMAX_DELAY);
+        pending_expire();
+        xSemaphoreGive(pending_mutex);
+    }
+    xSemaphoreTake(pending_mutex, portMAX_DELAY);
+    pending_t *req = &pending[(pending_head + pending_count) % PIPELINE_DEPTH];
+    req->upcb = item->upcb;
+    req->client_addr = item->client_addr;
+    req->client_port = item->client_port;
+    req->tcp_conn = item->tcp_conn;
+    req->cmd = frame_command(item->p);
+    req->tag = frame_byte(item->p, 1);
+    req->sent_ms = systime_ms();
+    req->timeout_ms = UART_RX_TIMEOUT_MS;
+    if (pending_deferred(req)) {
+        /** Answered once V_out settled or <timeout> passed, and <samples>
+            readings one millisecond apart were averaged */
+        uint32_t at = req->cmd & cmd_tagged ? 2 : 1;
+        req->timeout_ms += (frame_byte(item->p, at + 2) << 8 | frame_byte(item->p, at + 3)) + frame_byte(item->p, at + 4);
+    }
+    pending_count++;
+    if (item->client_port > 0 || item->tcp_conn > 0) {
+        last_client = *req;
+    }
+    xSemaphoreGive(pending_mutex);
+    uart_tx(item->p);
+    if (req->cmd == cmd_upgrade_start) {
+        /** The DPS restarts into the bootloader, which starts at the default
+            rate. Move the link again as soon as it is idle. */
+        baud_reset(systime_ms());
+    }
+    pbuf_free(item->p);
+}
+
+/**
+  * @brief Send a request of the proxy and wait for the response
+  * @param item the request, its pbuf is freed
+  * @retval the status of the response, -1 on timeout
+  */
+static int32_t baud_request(tx_item_t *item)
+{
+    (void) xSemaphoreTake(baud_sem, 0);
+    uart_request(item);
+    if (pdPASS != xSemaphoreTake(baud_sem, UART_RX_TIMEOUT_MS/portTICK_PERIOD_MS)) {
+        return -1;
+    }
+    return baud_status;
+}
+
+/**
+  * @brief Move the DPS link to CONFIG_DPS_BAUD, confirming the rate with a
+  *        ping. If the DPS does not support the command or the ping is not
+  *        answered, both ends stay at or go back to UART_DEFAULT_BAUD.
+  * @retval None
+  */
+static void baud_negotiate(void)
+{
+    tx_item_t item;
+    uint8_t set_baud[] = {cmd_set_baud, (CONFIG_DPS_BAUD >> 24) & 0xff, (CONFIG_DPS_BAUD >> 16) & 0xff, (CONFIG_DPS_BAUD >> 8) & 0xff, CONFIG_DPS_BAUD & 0xff};
+    uint8_t ping = cmd_ping;
+    baud_retry_ms = systime_ms() + BAUD_RETRY_MS;
+    if (!create_dps_request(&item, set_baud, sizeof(set_baud)) || baud_request(&item) != 1) {
+        return;
+    }
+    uart_set_baud(0, CONFIG_DPS_BAUD);
+    if (create_dps_request(&item, &ping, 1) && baud_request(&item) == 1) {
+        printf("DPS link at %u baud\n", CONFIG_DPS_BAUD);
+        dps_baud = CONFIG_DPS_BAUD;
+        baud_lost = false;
+    } else {
+        /** The DPS goes back after BAUD_CONFIRM_MS */
+        uart_set_baud(0, UART_DEFAULT_BAUD);
+    }
+}
+
+/**
+  * @brief Keep the DPS link at CONFIG_DPS_BAUD: negotiate the rate when the
+  *        pipeline is idle, ping the DPS so it keeps the rate and fall back
+  *        to UART_DEFAULT_BAUD when the DPS stops answering
+  * @retval None
+  */
+static void baud_maintain(void)
+{
+    if (CONFIG_DPS_BAUD == UART_DEFAULT_BAUD) {
+        return;
+    }
+    /** Notice a lost response when no other traffic would */
+    xSemaphoreTake(pending_mutex, portMAX_DELAY);
+    pending_expire();
+    xSemaphoreGive(pending_mutex);
+    if (baud_lost && dps_baud != UART_DEFAULT_BAUD) {
+        printf("DPS link lost, back to %u baud\n", UART_DEFAULT_BAUD);
+        uart_set_baud(0, UART_DEFAULT_BAUD);
+        dps_baud = UART_DEFAULT_BAUD;
+        baud_retry_ms = systime_ms() + BAUD_RETRY_MS;
+    }
+    baud_lost = false;
+    if (dps_baud == UART_DEFAULT_BAUD) {
+        xSemaphoreTake(pending_mutex, portMAX_DELAY);
+        bool idle = pending_count == 0;
+        xSemaphoreGive(pending_mutex);
+        if (idle && uxQueueMessagesWaiting(tx_queue) == 0 && (int32_t) (systime_ms() - baud_retry_ms) >= 0) {
+            baud_negotiate();
+        }
+    } else if (systime_ms() - uart_tx_ms >= BAUD_KEEPALIVE_MS) {
+        send_dps_command(cmd_ping);
+    }
+}
+
+/**
+  * @brief Refresh the cached cmd_query response if clients are querying and
+  *        no query is on its way to the DPS
+  * @retval None
+  */
+static void query_refresh(void)
+{
+    bool refresh;
+    xSemaphoreTake(pending_mutex, portMAX_DELAY);
+    refresh = systime_ms() - query_client_ms < QUERY_IDLE_MS && systime_ms() - query_cache_ms >= QUERY_REFRESH_MS;
+    for (uint32_t i = 0; refresh && i < pending_count; i++) {
+        refresh = pending[(pending_head + i) % PIPELINE_DEPTH].cmd != cmd_query;
+    }
+    xSemaphoreGive(pending_mutex);
+    if (refresh) {
+        tx_item_t item;
+        item.client_port = 0; // The response only goes to the cache
+        item.tcp_conn = 0;
+        item.p = pbuf_alloc(PBUF_RAW, MAX_FRAME_LENGTH, PBUF_RAM);
+        if (item.p) {
+            pbuf_realloc(item.p, protocol_create_status((uint8_t*) item.p->payload, MAX_FRAME_LENGTH));
+            uart_request(&item);
+        }
+    }
+}
+
+/**
+  * @brief Send a staging response to the client of a request
+  * @param item the request, its pbuf is freed
+  * @param payload the payload of the response
+  * @param length length of payload
+  * @retval None
+  */
+static void stage_reply(tx_item_t *item, const uint8_t *payload, uint32_t length)
+{
+    pbuf_free(item->p);
+    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, FRAME_OVERHEAD(length), PBUF_RAM);
+    if (!p) {
+        return;
+    }
+    DECLARE_FRAME_AT((uint8_t*) p->payload, p->len);
+    for (uint32_t i = 0; i < length; i++) {
+        PACK8(payload[i]);
+    }
+    FINISH_FRAME();
+    pbuf_realloc(p, _length);
+    if (item->tcp_conn) {
+        tcp_forward(item->tcp_conn, p, false);
+    } else if (item->client_port) {
+        pending_t client;
+        client.upcb = item->upcb;
+        client.client_addr = item->client_addr;
+        client.client_port = item->client_port;
+        udp_forward(&client, p);
+    }
+    pbuf_free(p);
+}
+
+/**
+  * @brief Check the crc of the staged image
+  * @retval true if the image has the crc the host sent
+  */
+static bool stage_verify(void)
+{
+    uint16_t crc = 0;
+    for (uint32_t offset = 0; offset < stage_length; offset += sizeof(stage_buf)) {
+        uint32_t size = stage_length - offset < sizeof(stage_buf) ? stage_length - offset : sizeof(stage_buf);
+        if (sdk_spi_flash_read(CONFIG_STAGE_FLASH_ADDR + offset, stage_buf, (size + 3) & ~3) != SPI_FLASH_RESULT_OK) {
+            return false;
+        }
+        crc = crc16_update(crc, (uint8_t*) stage_buf, size);
+    }
+    return crc == stage_crc;
+}
+
+/**
+  * @brief Store a chunk of the image being staged, erasing the sectors it
+  *        starts as they are reached
+  * @param data the chunk
+  * @param size size of the chunk
+  * @retval true if the chunk was written
+  */
+static bool stage_write(const uint8_t *data, uint32_t size)
+{
+    uint32_t offset = stage_offset;
+    uint32_t sector = (offset + SPI_FLASH_SEC_SIZE - 1) / SPI_FLASH_SEC_SIZE;
+    for (; sector * SPI_FLASH_SEC_SIZE < offset + size; sector++) {
+        if (sdk_spi_flash_erase_sector(CONFIG_STAGE_FLASH_ADDR / SPI_FLASH_SEC_SIZE + sector) != SPI_FLASH_RESULT_OK) {
+            return false;
+        }
+    }
+    memset(stage_buf, 0xff, sizeof(stage_buf));
+    memcpy(stage_buf, data, size);
+    return sdk_spi_flash_write(CONFIG_STAGE_FLASH_ADDR + offset, stage_buf, (size + 3) & ~3) == SPI_FLASH_RESULT_OK;
+}
+
+/**
+  * @brief Handle cmd_stage_start, cmd_stage_data and cmd_stage_upgrade
+  *        requests, see "Staged upgrades" in protocol.h
+  * @param item the request, its pbuf is freed
+  * @retval true if the staged image is to be sent to the DPS
+  */
+static bool stage_handle(tx_item_t *item)
+{
+    uint8_t reply[6];
+    uint32_t reply_length = 2;
+    bool upgrade = false;
+    int32_t length = uframe_extract_payload(stage_frame, pbuf_copy_partial(item->p, stage_frame, sizeof(stage_frame), 0));
+    if (length <= 0) {
+        pbuf_free(item->p);
+        return false;
+    }
+    uint8_t cmd = stage_frame[0];
+    reply[0] = cmd_response | cmd;
+    reply[1] = 0;
+    if (cmd == cmd_stage_start && stage_state != stage_upgrading) {
+        uint32_t image_length;
+        uint16_t crc;
+        DECLARE_UNPACK(&stage_frame[1], length - 1);
+        UNPACK32(image_length);
+        UNPACK16(crc);
+        if (_remain == 0 && image_length > 0 && image_length <= STAGE_MAX_SIZE) {
+            stage_length = image_length;
+            stage_crc = crc;
+            stage_offset = 0;
+            stage_valid = false;
+            stage_upgrade_status = upgrade_continue;
+            stage_state = stage_receiving;
+            reply[1] = 1;
+        }
+    } else if (cmd == cmd_stage_data && length >= 5) {
+        uint32_t offset;
+        uint32_t size = length - 5;
+        DECLARE_UNPACK(&stage_frame[1], 4);
+        UNPACK32(offset);
+        if (stage_state == stage_receiving && offset > stage_offset) {
+            /** Beyond what we have, the chunks before it were lost */
+            pbuf_free(item->p);
+            return false;
+        }
+        if (stage_state == stage_receiving && offset == stage_offset && size > 0 &&
+            size <= STAGE_MAX_CHUNK_SIZE && offset + size <= stage_length &&
+            (size % 4 == 0 || offset + size == stage_length)) {
+            if (!stage_write(&stage_frame[5], size)) {
+                stage_upgrade_status = upgrade_flash_error;
+                stage_state = stage_failed;
+            } else if ((stage_offset += size) == stage_length) {
+                stage_valid = stage_verify();
+                stage_upgrade_status = stage_valid ? upgrade_continue : upgrade_crc_error;
+                stage_state = stage_valid ? stage_staged : stage_failed;
+            }
+        }
+        /** Chunks before the offset are acked again */
+        reply[1] = stage_state == stage_receiving || stage_state == stage_staged;
+        reply[2] = stage_offset >> 24;
+        reply[3] = (stage_offset >> 16) & 0xff;
+        reply[4] = (stage_offset >> 8) & 0xff;
+        reply[5] = stage_offset & 0xff;
+        reply_length = 6;
+    } else if (cmd == cmd_stage_upgrade) {
+        upgrade = stage_valid && stage_state != stage_receiving && stage_state != stage_upgrading;
+        reply[1] = upgrade;
+    }
+    stage_reply(item, reply, reply_length);
+    return upgrade;
+}
+
+/**
+  * @brief Send a request of a staged upgrade to the DPS and wait for the
+  *        response
+  * @param item the request, its pbuf is freed
+  * @param timeout_ms how long to wait for the response
+  * @param resp the payload of the response is copied here
+  * @retval length of the response, 0 on timeout
+  */
+static uint32_t stage_request(tx_item_t *item, uint32_t timeout_ms, uint8_t *resp)
+{
+    uint32_t length = 0;
+    uart_request(item);
+    if (pdPASS == xSemaphoreTake(stage_sem, timeout_ms/portTICK_PERIOD_MS)) {
+        xSemaphoreTake(pending_mutex, portMAX_DELAY);
+        if (stage_resp_length > 0) {
+            length = stage_resp_length < 6 ? stage_resp_length : 6;
+            memcpy(resp, stage_resp, length);
+        }
+        xSemaphoreGive(pending_mutex);
+    }
+    return length;
+}
+
+/**
+  * @brief Send cmd_upgrade_start for the staged image
+  * @param chunk_size the chunk size to ask for
+  * @param window the window to ask for, 0 for the first request that
+  *        restarts the DPS into the bootloader
+  * @param timeout_ms how long to wait for the response
+  * @param resp the payload of the response is copied here
+  * @retval length of the response, 0 on timeout or if it was not accepted
+  */
+static uint32_t stage_upgrade_start(uint32_t chunk_size, uint8_t window, uint32_t timeout_ms, uint8_t *resp)
+{
+    tx_item_t item;
+    uint8_t start[] = {cmd_upgrade_start, chunk_size >> 8, chunk_size & 0xff, stage_crc >> 8, stage_crc & 0xff, window, 0};
+    (void) xSemaphoreTake(stage_sem, 0);
+    if (!create_dps_request(&item, start, window ? sizeof(start) : 5)) {
+        return 0;
+    }
+    uint32_t length = stage_request(&item, timeout_ms, resp);
+    if (length < 4 || resp[1] != upgrade_continue) {
+        stage_upgrade_status = length < 2 ? upgrade_protocol_error : resp[1];
+        return 0;
+    }
+    return length;
+}
+
+/**
+  * @brief Send a chunk of the staged image to the bootloader
+  * @param offset offset of the chunk
+  * @param chunk_size the agreed chunk size, the last chunk is shorter
+  * @param windowed true if the offset is sent
+  * @retval true if the chunk was queued
+  */
+static bool stage_send_chunk(uint32_t offset, uint32_t chunk_size, bool windowed)
+{
+    tx_item_t item;
+    uint32_t size = stage_length - offset < chunk_size ? stage_length - offset : chunk_size;
+    if (size && sdk_spi_flash_read(CONFIG_STAGE_FLASH_ADDR + offset, stage_buf, (size + 3) & ~3) != SPI_FLASH_RESULT_OK) {
+        return false;
+    }
+    item.client_port = 0;
+    item.tcp_conn = 0;
+    item.p = pbuf_alloc(PBUF_RAW, FRAME_OVERHEAD(STAGE_MAX_CHUNK_SIZE + 5), PBUF_RAM);
+    if (!item.p) {
+        return false;
+    }
+    uint8_t *data = (uint8_t*) stage_buf;
+    DECLARE_FRAME_AT((uint8_t*) item.p->payload, item.p->len);
+    PACK8(cmd_upgrade_data);
+    if (windowed) {
+        PACK32(offset);
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        PACK8(data[i]);
+    }
+    FINISH_FRAME();
+    pbuf_realloc(item.p, _length);
+    uart_request(&item);
+    return true;
+}
+
+/**
+  * @brief Upgrade the DPS with the staged image, following the host side of
+  *        "DPS upgrade sessions" in protocol.h. Other requests wait in
+  *        tx_queue meanwhile.
+  * @retval None
+  */
+static void stage_upgrade(void)
+{
+    uint8_t resp[6];
+    uint32_t length;
+    uint32_t chunk_size = STAGE_MAX_CHUNK_SIZE;
+    uint8_t window = 0;
+    stage_state = stage_upgrading;
+    stage_upgrade_status = upgrade_continue;
+    stage_offset = 0;
+    do {
+        length = stage_upgrade_start(chunk_size, 0, STAGE_START_TIMEOUT_MS, resp);
+        if (!length) {
+            break;
+        }
+        if (CONFIG_DPS_BAUD != UART_DEFAULT_BAUD) {
+            baud_negotiate();
+        }
+        if (length >= 6) {
+            /** A bootloader sending the window field takes several chunks
+                in flight once asked for it */
+            length = stage_upgrade_start(chunk_size, UPGRADE_MAX_WINDOW, UART_RX_TIMEOUT_MS, resp);
+            if (!length) {
+                break;
+            }
+            window = length >= 6 ? resp[5] : 0;
+        }
+        chunk_size = (resp[2] << 8) | resp[3];
+        if (chunk_size == 0 || chunk_size > STAGE_MAX_CHUNK_SIZE || chunk_size % 4) {
+            stage_upgrade_status = upgrade_protocol_error;
+            break;
+        }
+        bool windowed = window > 0;
+        if (!windowed) {
+            window = 1;
+        }
+        /** The image ends with a chunk shorter than chunk_size, empty if
+            need be */
+        uint32_t num_chunks = stage_length / chunk_size + 1;
+        uint32_t acked = 0;
+        uint32_t sent = 0;
+        uint32_t timeouts = 0;
+        (void) xSemaphoreTake(stage_sem, 0);
+        while (stage_upgrade_status == upgrade_continue) {
+            while (sent < num_chunks && sent - acked < window) {
+                if (!stage_send_chunk(sent * chunk_size, chunk_size, windowed)) {
+                    stage_upgrade_status = upgrade_protocol_error;
+                    break;
+                }
+                sent++;
+            }
+            if (stage_upgrade_status != upgrade_continue) {
+                break;
+            }
+            length = 0;
+            if (pdPASS == xSemaphoreTake(stage_sem, UART_RX_TIMEOUT_MS/portTICK_PERIOD_MS)) {
+                xSemaphoreTake(pending_mutex, portMAX_DELAY);
+                if (stage_resp_length > 0) {
+                    length = stage_resp_length < 6 ? stage_resp_length : 6;
+                    memcpy(resp, stage_resp, length);
+                }
+                xSemaphoreGive(pending_mutex);
+            }
+            if (length < 2) {
+                /** A bootloader without windows cannot take a chunk again */
+                if (!windowed || ++timeouts > STAGE_RETRIES) {
+                    stage_upgrade_status = upgrade_protocol_error;
+                    break;
+                }
+                sent = acked;
+                continue;
+            }
+            stage_upgrade_status = resp[1];
+            if (stage_upgrade_status != upgrade_continue) {
+                break;
+            }
+            timeouts = 0;
+            uint32_t offset = (acked + 1) * chunk_size;
+            if (windowed && length >= 6) {
+                offset = ((uint32_t) resp[2] << 24) | (resp[3] << 16) | (resp[4] << 8) | resp[5];
+            }
+            while (acked < num_chunks && acked * chunk_size < offset) {
+                acked++;
+            }
+            if (sent < acked) {
+                sent = acked;
+            }
+            stage_offset = offset < stage_length ? offset : stage_length;
+        }
+    } while (0);
+    if (stage_upgrade_status == upgrade_success) {
+        printf("Staged upgrade done\n");
+        stage_offset = stage_length;
+        stage_state = stage_done;
+    } else {
+        printf("Staged upgrade failed (%d)\n", stage_upgrade_status);
+        stage_state = stage_failed;
+    }
+    /** The DPS starts the app, or stays in the bootloader, at the default
+        rate */
+    baud_reset(systime_ms() + BAUD_RETRY_MS);
+}
+
+/**
+  * @brief This is the task that sends requests to the DPS, without waiting
+  *        for the responses of the requests before
   * @param arg user supplied argument from xTaskCreate
   * @retval None
   */
@@ -230,32 +1444,65 @@ static void uart_comm_task(void *arg)
 {
     tx_item_t item;
     while(1) {
-        if (pdPASS != xQueueReceive(tx_queue, (void*) &item, portMAX_DELAY)) {
-            printf("xQueueReceive failed\n");
-            delay_ms(1000);
-        } else {
-            uint8_t buffer[MAX_FRAME_LENGTH];
-            uint32_t size;
-            uart_tx((uint8_t*) &item.frame, item.frame_length);
-
-            size = uart_rx_frame((uint8_t*) &buffer, sizeof(buffer));
-            if (size > 0) {
-                if (item.client_port > 0) {
-                    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, size, PBUF_RAM);
-                    if (!p) {
-                        printf("Failed to allocate transport buffer\n");
-                    } else {
-                        memcpy(p->payload, buffer, size);
-                        err_t err = udp_sendto(item.upcb, p, &item.client_addr, item.client_port);
-                        if (err < 0) {
-                            printf("Error sending message: %s (%d)\n", lwip_strerr(err), err);
-                        }
-                        pbuf_free(p);
-                    }
+        if (pdPASS == xQueueReceive(tx_queue, (void*) &item, QUERY_REFRESH_MS/portTICK_PERIOD_MS)) {
+            uint8_t cmd = frame_command(item.p);
+            if (cmd == cmd_stage_start || cmd == cmd_stage_data || cmd == cmd_stage_upgrade) {
+                if (stage_handle(&item)) {
+                    stage_upgrade();
                 }
             } else {
-                printf("Timeout from DPS\n");
-                /** @todo: handle timeout */
+                uart_request(&item);
+            }
+        }
+        query_refresh();
+        baud_maintain();
+    }
+}
+
+/**
+  * @brief This is the task that receives frames from the DPS. Reading stdin
+  *        blocks until the UART RX interrupt has received something. Frames
+  *        that are already waiting when one is done, like a burst of stream
+  *        batches or events received while wifi kept the task busy, go to a
+  *        UDP client in one datagram. A lone frame is sent before blocking,
+  *        so coalescing adds no latency.
+  * @param arg user supplied argument from xTaskCreate
+  * @retval None
+  */
+static void uart_rx_task(void *arg)
+{
+    /** The frame is received into the payload of the pbuf that is sent */
+    struct pbuf *p = NULL;
+    uint32_t size = 0;
+    bool sof = false;
+    uint8_t ch;
+    while(1) {
+        if (!p) {
+            p = pbuf_alloc(PBUF_TRANSPORT, RX_FRAME_SIZE, PBUF_RAM);
+            if (!p) {
+                printf("Failed to allocate transport buffer\n");
+                delay_ms(10);
+                continue;
+            }
+        }
+        if (udp_batch && uart0_num_char() == 0) {
+            udp_flush();
+        }
+        if (read(0, (void*) &ch, 1) != 1) { // 0 is stdin
+            continue;
+        }
+        uint8_t *frame = (uint8_t*) p->payload;
+        if (ch == _SOF) {
+            size = 0;
+            sof = true;
+        }
+        if (sof && size < RX_FRAME_SIZE) {
+            frame[size++] = ch;
+        }
+        if (sof && ch == _EOF) {
+            sof = false;
+            if (handle_dps_frame(p, size)) {
+                p = NULL;
             }
         }
     }
@@ -276,10 +1523,8 @@ static void wifi_task(void *pvParameters)
         .password = WIFI_PASS,
     };
 
-    // As the uart_rx_frame currently has no timeout and libnet80211.a spams at
-    // boot there is a risk of the DPS missing the wifi status update causing
-    // the uart_comm_task task to lock up and the DPS is now uncontrollable
-    // via wifi which kind of was the idea...
+    // libnet80211.a spams the UART at boot so there is a risk of the DPS
+    // missing an early wifi status update
 
     //set_dps_wifi_status(wifi_connecting); // Do this early as there will be lots of spam when wifi connection begins
     xSemaphoreTake(wifi_alive_sem, portMAX_DELAY);
@@ -327,12 +1572,17 @@ static void wifi_task(void *pvParameters)
 
 void user_init(void)
 {
-    uart_set_baud(0, 115200);
+    uart_set_baud(0, UART_DEFAULT_BAUD);
     uart_clear_txfifo(0);
     vSemaphoreCreateBinary(wifi_alive_sem);
     tx_queue = xQueueCreate(TX_QUEUE_DEPTH, sizeof(tx_item_t));
+    pending_mutex = xSemaphoreCreateMutex();
+    pending_slots = xSemaphoreCreateCounting(PIPELINE_DEPTH, PIPELINE_DEPTH);
+    vSemaphoreCreateBinary(baud_sem);
+    vSemaphoreCreateBinary(stage_sem);
     ota_tftp_init_server(TFTP_PORT);
     xTaskCreate(&uart_comm_task, "uart_comm_task", 2048, NULL, 4, NULL);
+    xTaskCreate(&uart_rx_task, "uart_rx_task", 1024, NULL, 4, NULL);
     xTaskCreate(&wifi_task, "wifi_task",  256, NULL, 2, NULL);
     xTaskCreate(&uhej_task, "uhej_task",  256, NULL, 3, NULL);
 }
@@ -10,6 +10,10 @@
 
 import socket
 import sys
+import os
+import struct
+import subprocess
+import time
 
 prompt = "> " # OpenOCD prompt
 
@@ -18,47 +22,93 @@ ocd_sock = False
 def ocd_exchange(str = ""):
     output = ""
     line = ""
-    got_prompt = False
     if len(str) > 0:
         ocd_sock.send(bytearray(str, "ascii"))
     while 1:
+        # Read whatever has arrived, a multi word dump is one recv instead
+        # of one per character
         try:
-            ch = ocd_sock.recv(1)
-            if len(ch) > 0:
-                if ch == b'\d':
-                    pass
-                if ch == b'\n':
-                    if "%s\n" % line != str:
-                        output += "%s\n" % line
-                    line = ""
-                elif ord(ch) >= 32 and ord(ch) <= 126:
-                    line += ch.decode("ascii")
-                if line.endswith(prompt):
-                    got_prompt = True
-                    break
-            else:
-                break
+            chunk = ocd_sock.recv(4096)
         except socket.timeout as e:
             break
+        if len(chunk) == 0:
+            break
+        for ch in bytearray(chunk):
+            if ch == 10:
+                if "%s\n" % line != str:
+                    output += "%s\n" % line
+                line = ""
+            elif ch >= 32 and ch <= 126:
+                line += chr(ch)
+        if line.endswith(prompt):
+            break
     return output.strip()
 
 def ocd_sync():
     return ocd_exchange()
 
-def ocd_read(address):
-    response = ocd_exchange("mdw 0x%08x 1\n" % (address))
-    parts = response.split(":")
-    if len(parts) != 2:
-        print ("Parsing error: %s" % response)
+# Words read from the target, keyed by address. A peripheral is read in one
+# block and its registers are then printed from the cache, so a dump is a
+# snapshot of one moment and costs one telnet round trip. ocd_write() drops
+# the word it changes.
+mem_cache = {}
+
+# Reads of more words than this go through dump_image, which transfers
+# binary instead of a hex listing. OpenOCD runs on localhost so the image
+# file can be read back directly.
+DUMP_IMAGE_WORDS = 256
+dump_image_file = "/tmp/ocd-client-%d.bin" % os.getpid()
+
+def ocd_dump_image(address, count):
+    response = ocd_exchange("dump_image %s 0x%08x %d\n" % (dump_image_file, address, 4*count))
+    if "dumped" not in response:
+        print ("Dump error: %s" % response)
+        return False
+    try:
+        with open(dump_image_file, "rb") as f:
+            data = f.read()
+        os.remove(dump_image_file)
+    except IOError as e:
+        print ("Dump error: %s" % e)
         return False
-    temp_address = int(parts[0].strip(), 16)
-    value = int(parts[1].strip(), 16)
-    if temp_address != address:
-        print ("Address error: %s" % response)
+    if len(data) != 4*count:
+        print ("Dump error: got %d of %d bytes" % (len(data), 4*count))
         return False
-    return value
+    return list(struct.unpack("<%dI" % count, data))
+
+def ocd_read_block(address, count):
+    if count > DUMP_IMAGE_WORDS:
+        values = ocd_dump_image(address, count)
+        if values == False:
+            return False
+    else:
+        response = ocd_exchange("mdw 0x%08x %d\n" % (address, count))
+        words = parse_mem_dump(response)
+        if words == False:
+            return False
+        values = [words.get(address + 4*i) for i in range(count)]
+        if None in values:
+            print ("Address error: %s" % response)
+            return False
+    for (i, value) in enumerate(values):
+        mem_cache[address + 4*i] = value
+    return values
+
+def ocd_snapshot(address, end):
+    """Read the registers in [address, end) into the cache in one go"""
+    if not all(a in mem_cache for a in range(address, end, 4)):
+        ocd_read_block(address, (end - address) // 4)
+
+def ocd_read(address):
+    if address in mem_cache:
+        return mem_cache[address]
+    values = ocd_read_block(address, 1)
+    if values == False:
+        return False
+    return values[0]
 
 def ocd_write(address, value):
+    mem_cache.pop(address, None)
     response = ocd_exchange("mww 0x%08x 0x%08x\n" % (address, value))
 
 known_pins = {
@@ -344,6 +394,7 @@ def print_gpio_pin(port_nbr, pin, cnf, mode, level):
 
 def dump_port_settings(port_nbr):
 #    print("Checking GPIO%c" % (ord('A') + port_nbr))
+    ocd_snapshot(port_addresses[port_nbr], port_addresses[port_nbr] + GPIOx_LCKR + 4)
     crl = ocd_read(port_addresses[port_nbr] + GPIOx_CRL)
     crh = ocd_read(port_addresses[port_nbr] + GPIOx_CRH)
     idr = ocd_read(port_addresses[port_nbr] + GPIOx_IDR)
@@ -409,6 +460,7 @@ U           ARR         CCR2
 
 def dump_tim_settings(name, base_addr):
     print("%s settings" % (name))
+    ocd_snapshot(base_addr, base_addr + TIMx_DMAR + 4)
     dump_reg("CR1",   base_addr + TIMx_CR1)
     dump_reg("CR2",   base_addr + TIMx_CR2)
     dump_reg("SMC",   base_addr + TIMx_SMC)
@@ -459,6 +511,7 @@ def dump_tim4_settings():
 
 def dump_dac_settings():
     print("DAC settings")
+    ocd_snapshot(DAC_BASE, DAC_BASE + DAC_SR + 4)
     dump_reg("CR",      DAC_BASE + DAC_CR)
     dump_reg("SWTRIGR", DAC_BASE + DAC_SWTRIGR)
     dump_reg("DHR12R1", DAC_BASE + DAC_DHR12R1)
@@ -494,6 +547,7 @@ def dump_dac_settings():
 
 def dump_adc1_settings():
     print("ADC1 settings")
+    ocd_snapshot(ADC1_BASE, ADC1_BASE + ADC_DR + 4)
     dump_reg("SR",      ADC1_BASE + ADC_SR)
     dump_reg("CR1",     ADC1_BASE + ADC_CR1)
     dump_reg("CR2",     ADC1_BASE + ADC_CR2)
@@ -551,6 +605,7 @@ def dump_adc1_settings():
 
 def dump_afio_settings():
     print("AFIO settings")
+    ocd_snapshot(AFIO_BASE, AFIO_BASE + AFIO_MAPR2 + 4)
     dump_reg("EVCR",     AFIO_BASE + AFIO_EVCR)
     dump_reg("MAPR",     AFIO_BASE + AFIO_MAPR)
     dump_reg("EXTICR1",  AFIO_BASE + AFIO_EXTICR1)
@@ -572,6 +627,7 @@ def dump_afio_settings():
 
 def dump_exti_settings():
     print("EXTI settings")
+    ocd_snapshot(EXTI_BASE, EXTI_BASE + EXTI_PR + 4)
     dump_reg("IMR",    EXTI_BASE + EXTI_IMR)
     dump_reg("EMR",    EXTI_BASE + EXTI_EMR)
     dump_reg("RTSR",   EXTI_BASE + EXTI_RTSR)
@@ -591,6 +647,7 @@ def dump_exti_settings():
 
 def dump_rcc_settings():
     print("RCC settings")
+    ocd_snapshot(RCC_BASE, RCC_BASE + RCC_CFGR2 + 4)
     dump_reg("CR",       RCC_BASE + RCC_CR)
     dump_reg("CFGR",     RCC_BASE + RCC_CFGR)
     dump_reg("CIR",      RCC_BASE + RCC_CIR)
@@ -605,6 +662,7 @@ def dump_rcc_settings():
 
 def dump_spi_settings(name, base_addr):
     print("%s settings" % (name))
+    ocd_snapshot(base_addr, base_addr + SPI_TXCRCR + 4)
     dump_reg("CR2",      base_addr + SPI_CR1)
     dump_reg("CR1",      base_addr + SPI_CR2)
     dump_reg("SR",       base_addr + SPI_SR)
@@ -621,6 +679,7 @@ def dump_spi2_settings():
 
 def dump_gpio_settings(name, base_addr):
     print("%s settings" % (name))
+    ocd_snapshot(base_addr, base_addr + GPIOx_LCKR + 4)
     dump_reg("CRL",      base_addr + GPIOx_CRL)
     dump_reg("CRH",      base_addr + GPIOx_CRH)
     dump_reg("IDR",      base_addr + GPIOx_IDR)
@@ -695,6 +754,7 @@ mww 0x40007424 0x1d601fff
 
 def dump_dma_settings():
     print("DMA settings")
+    ocd_snapshot(DMA1_BASE, DMA1_BASE + DMA_CPAR7 + 4)
     dump_reg("ISR",    DMA1_BASE + DMA_ISR)
     dump_reg("IFCR",   DMA1_BASE + DMA_IFCR)
     dump_reg("CCR1",   DMA1_BASE + DMA_CCR1)
@@ -732,8 +792,10 @@ def dump_register_map():
         end = reg[1]
         name = reg[2]
         print("\n# %s (0x%08x..0x%08x)" % (name, address, end))
-        while address < end:
-            value = ocd_read(address)
+        values = ocd_read_block(address, (end + 1 - address) // 4)
+        if values == False:
+            continue
+        for value in values:
             print("[0x%08x] = 0x%08x" % (address, value))
             address += 4
 
@@ -753,11 +815,110 @@ def read_mem():
         address = int(sys.argv[2], 16)
         if len(sys.argv) == 4:
             length = int(sys.argv[3], 16)
-        while length > 0:
-            value = ocd_read(address)
-            print("[0x%08x] = 0x%08x" % (address, value))
-            address += 4
-            length -= 1
+        values = ocd_read_block(address, length)
+        if values != False:
+            for value in values:
+                print("[0x%08x] = 0x%08x" % (address, value))
+                address += 4
+
+# Symbols traced when none are given, the OCP state
+trace_default_symbols = ["i_out_adc", "v_out_adc", "adc_counter", "pwrctl_i_limit_raw"]
+
+# Symbols closer than this are read in the same block
+TRACE_MERGE_GAP = 64
+
+def resolve_symbols(elf, names):
+    """
+    Look up the address and size of each symbol with nm, static symbols
+    included. Return a list of (name, address, size) or False.
+    """
+    nm = os.environ.get("NM", "arm-none-eabi-nm")
+    try:
+        out = subprocess.check_output([nm, "-S", elf]).decode("utf-8")
+    except (OSError, subprocess.CalledProcessError) as e:
+        print("Failed to run %s: %s" % (nm, e))
+        return False
+    found = {}
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) != 4 or fields[3] not in names:
+            continue
+        if fields[3] in found:
+            sys.stderr.write("Warning: %s is defined more than once, using the first\n" % fields[3])
+            continue
+        found[fields[3]] = (fields[3], int(fields[0], 16), int(fields[1], 16))
+    symbols = []
+    for name in names:
+        if name not in found:
+            print("Symbol %s not found in %s" % (name, elf))
+            return False
+        if found[name][2] not in [1, 2, 4, 8]:
+            print("Symbol %s is %d bytes, only 1, 2, 4 and 8 are supported" % (name, found[name][2]))
+            return False
+        symbols.append(found[name])
+    return symbols
+
+def trace_blocks(symbols):
+    """Group the symbols into word aligned blocks, one read each"""
+    blocks = []
+    for (name, address, size) in sorted(symbols, key = lambda s: s[1]):
+        start = address & ~3
+        end = (address + size + 3) & ~3
+        if blocks and start - blocks[-1][1] < TRACE_MERGE_GAP:
+            blocks[-1][1] = max(blocks[-1][1], end)
+        else:
+            blocks.append([start, end])
+    return blocks
+
+def trace():
+    """
+    Sample symbols at a fixed rate and print them as CSV until interrupted.
+    The debug port reads the RAM without halting the core, so the firmware
+    runs undisturbed.
+    """
+    if len(sys.argv) < 4:
+        print("%s trace <elf> <rate Hz> [<symbol> ...]" % (sys.argv[0]))
+        return
+    symbols = resolve_symbols(sys.argv[2], sys.argv[4:] or trace_default_symbols)
+    if not symbols:
+        return
+    period = 1.0 / float(sys.argv[3])
+    blocks = trace_blocks(symbols)
+    formats = {1: "<B", 2: "<H", 4: "<I", 8: "<Q"}
+    print("time," + ",".join(s[0] for s in symbols))
+    start = time.time()
+    deadline = start
+    overruns = 0
+    try:
+        while 1:
+            now = time.time()
+            mem = {}
+            for (address, end) in blocks:
+                values = ocd_read_block(address, (end - address) // 4)
+                if values == False:
+                    return
+                data = struct.pack("<%dI" % len(values), *values)
+                mem[address] = data
+            row = ["%.4f" % (now - start)]
+            for (name, address, size) in symbols:
+                for (block, data) in mem.items():
+                    if block <= address < block + len(data):
+                        offset = address - block
+                        row.append("%d" % struct.unpack(formats[size], data[offset:offset + size])[0])
+                        break
+            print(",".join(row))
+            sys.stdout.flush()
+            deadline += period
+            delay = deadline - time.time()
+            if delay > 0:
+                time.sleep(delay)
+            else:
+                overruns += 1
+                deadline = time.time()
+    except KeyboardInterrupt:
+        pass
+    if overruns:
+        sys.stderr.write("%d samples were late, try a lower rate\n" % overruns)
 
 def print_help():
     global commands
@@ -767,7 +928,7 @@ def print_help():
 
 def dump_all():
     global commands
-    blocklist = ["reg", "all", "r", "w", "help"]
+    blocklist = ["reg", "all", "r", "w", "trace", "help"]
     for cmd in commands:
         if cmd not in blocklist:
             print(">>>> %s" % cmd)
@@ -775,17 +936,21 @@ def dump_all():
             print("")
 
 def parse_mem_dump(data):
-    lines = data.split('\n')
-    for l in lines:
+    """Parse the output of mdw into a dictionary of words keyed by address"""
+    words = {}
+    for l in data.split('\n'):
         parts = l.split(":")
         if len(parts) != 2:
             print ("Parsing error: %s" % l)
-            return
-        address = int(parts[0].strip(), 16)
-        parts[1] = parts[1].strip()
-        data = parts[1].split(" ")
-        for (i, item) in enumerate(data):
-            decode_mem(address+4*i, int(item, 16))
+            return False
+        try:
+            address = int(parts[0].strip(), 16)
+            for (i, item) in enumerate(parts[1].split()):
+                words[address + 4*i] = int(item, 16)
+        except ValueError:
+            print ("Parsing error: %s" % l)
+            return False
+    return words
 
 try:
     ocd_sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
@@ -817,6 +982,7 @@ commands = {
     "tim4"  : dump_tim4_settings,
     "w"     : write_mem,
     "r"     : read_mem,
+    "trace" : trace,
     "help"  : print_help,
     "all"   : dump_all,
 }
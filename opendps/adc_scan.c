@@ -0,0 +1,588 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "pwrctl.h"
+#include "hw.h"
+#include "adc_scan.h"
+#include "event.h"
+#include "dps-model.h"
+#ifdef CONFIG_CAPTURE
+#include "capture.h"
+#endif // CONFIG_CAPTURE
+#ifdef CONFIG_BROWNOUT
+#include "brownout.h"
+#endif // CONFIG_BROWNOUT
+#ifdef CONFIG_STATS
+#include "stats.h"
+#endif // CONFIG_STATS
+
+/** The processing of the ADC scans, fed by the ADC ISRs of hw.c and by the
+  * simulated ADC of the emulator */
+
+#ifdef DPS_EMULATOR
+ /** The simulated ADC runs in the main loop, there is nothing to mask */
+ #define ADC_SCAN_LOCK()
+ #define ADC_SCAN_UNLOCK()
+#else // DPS_EMULATOR
+ #include <cortex.h>
+ #define ADC_SCAN_LOCK()    uint32_t _primask = cm_mask_interrupts(1)
+ #define ADC_SCAN_UNLOCK()  cm_mask_interrupts(_primask)
+#endif // DPS_EMULATOR
+
+static volatile uint16_t i_out_adc;
+static volatile uint16_t i_out_trig_adc;
+static volatile uint16_t prot_trig_i_out_adc;
+static volatile uint16_t prot_trig_v_out_adc;
+static volatile uint16_t v_in_adc;
+static volatile uint16_t v_out_adc;
+
+/** We skip the first 40 samples. For a connected ESP8266 the first sample
+  * will read a current draw of ~3A which will trigger the OCP.
+  * @todo Investigate if the ESP8266 _really_ draws 3A or if it is a DPS issue
+  */
+#define STARTUP_SKIP_COUNT   (40)
+
+/** Once we are checking for OCP, we need 20 over currents in a row to trigger
+  * OCP. This is due to spikes in the ADC readings.
+  * @todo Investigate if the spikes are real or is a DPS issue
+  */
+#ifndef CONFIG_OCP_FILTER_COUNT
+ #define CONFIG_OCP_FILTER_COUNT (20)
+#endif
+#define OCP_FILTER_COUNT (CONFIG_OCP_FILTER_COUNT)
+
+/** Number of ADC conversions performed */
+static uint32_t adc_counter;
+
+/** ADC_CHA_IOUT_GOLDEN_VALUE of dps-model.h is the ADC reading on channel
+  * ADC_CHA_IOUT when power out was disabled on the unit the model was
+  * developed on. When testing on another unit I noticed the current
+  * measurement was quite off, the reason being the ADC reading at 0mA had an
+  * offset. For that reason, we calculate the individual offset for the unit
+  * we're running on. Might work out... */
+/** How many measurements do we take before calculating adc_i_offset */
+#define ADC_I_OFFSET_COUNT  (1000)
+/** Offset from golden value when measuring 0.00mA output current on this unit */
+static int32_t adc_i_offset;
+/** Are we measuring the offset not not? */
+static bool measure_i_out = true;
+/** Has adc_i_offset been measured or taken from an earlier measurement */
+static bool i_offset_valid;
+/** Used to calculate mean value of ADC_CHA_IOUT when power out is disabled */
+static uint32_t i_offset_calc;
+
+#ifdef CONFIG_ADC_OVERSAMPLING
+_Static_assert (12 + HW_ADC_FRAC_BITS <= 16, "Readings must fit 16 bits");
+_Static_assert (CONFIG_ADC_CIC_ORDER * CONFIG_ADC_DECIMATION_LOG2 + 12 <= 32, "CIC registers overflow");
+/** CIC decimator state per channel. The integrators wrap around which is
+  * fine as long as the output fits the register width. */
+typedef struct {
+    uint32_t integrator[CONFIG_ADC_CIC_ORDER];
+    uint32_t comb[CONFIG_ADC_CIC_ORDER];
+} cic_t;
+static cic_t cic[adc_cha_max];
+static uint32_t cic_phase;
+#endif // CONFIG_ADC_OVERSAMPLING
+
+#ifdef CONFIG_ADC_DMA
+/** Two block summaries, the ISR writes the one not pointed to by adc_block_idx */
+static adc_block_t adc_blocks[2];
+static volatile uint32_t adc_block_idx;
+static volatile uint32_t adc_block_seq;
+/** Optional consumer of raw blocks, called from the DMA ISR */
+static hw_adc_block_callback_t adc_block_callback;
+#endif // CONFIG_ADC_DMA
+
+/** State of the protections checked by handle_protections(), all filtered
+  * like the OCP */
+typedef struct {
+    event_t event;  /** Sent when the protection kicks in */
+    uint32_t count; /** Number of scans in a row over the limit */
+} prot_state_t;
+
+/** Drained by hw_get_adc_sums() */
+static hw_adc_sums_t adc_sums;
+
+static prot_state_t protections[prot_max] = {
+    [prot_ovp] = { .event = event_ovp },
+    [prot_opp] = { .event = event_opp },
+};
+
+#if defined(CONFIG_ADC_DMA) && defined(CONFIG_OCP_AWD)
+/** The analog watchdog tells scans apart by their position in the DMA buffer */
+_Static_assert (((2 * ADC_DMA_BLOCK_LEN) & (2 * ADC_DMA_BLOCK_LEN - 1)) == 0, "DMA buffer scans must be a power of 2");
+#define OCP_SCAN_MASK  (2 * ADC_DMA_BLOCK_LEN - 1)
+#else
+#define OCP_SCAN_MASK  (0xffffffff)
+#endif
+
+/**
+  * @brief Read latest ADC mesurements
+  * @param i_out_raw latest I_out raw value
+  * @param v_in_raw latest V_in raw value
+  * @param v_out_raw latest V_out raw value
+  * @note The values have HW_ADC_FRAC_BITS fractional bits
+  * @retval none
+  */
+void hw_get_adc_values(uint16_t *i_out_raw, uint16_t *v_in_raw, uint16_t *v_out_raw)
+{
+    *i_out_raw = i_out_adc;
+    *v_in_raw = v_in_adc;
+    *v_out_raw = v_out_adc;
+}
+
+#ifdef CONFIG_ADC_DMA
+/**
+  * @brief Get the summary of the latest completed ADC block
+  * @param block the summary is copied here
+  * @retval true if a block has been completed since boot
+  */
+bool hw_get_adc_block(adc_block_t *block)
+{
+    uint32_t seq;
+    do {
+        seq = adc_block_seq;
+        memcpy((void*) block, (void*) &adc_blocks[adc_block_idx], sizeof(adc_block_t));
+    } while (seq != adc_block_seq); /** The ISR completed a block while we were copying */
+    return seq != 0;
+}
+
+/**
+  * @brief Register a consumer of raw ADC blocks
+  * @param callback function called from the DMA ISR for every completed block,
+  *        or NULL to unregister
+  * @retval None
+  */
+void hw_set_adc_block_callback(hw_adc_block_callback_t callback)
+{
+    adc_block_callback = callback;
+}
+#endif // CONFIG_ADC_DMA
+
+/**
+  * @brief Get the ADC valut that triggered the OCP
+  * @retval Trivver value in mA
+  */
+uint16_t hw_get_itrig_ma(void)
+{
+    return i_out_trig_adc;
+}
+
+/**
+  * @brief Get the ADC values of the scan that triggered the latest OVP or OPP
+  * @param i_out_raw I_out sample, offset compensated
+  * @param v_out_raw V_out sample
+  * @retval None
+  */
+void hw_get_prot_trig(uint16_t *i_out_raw, uint16_t *v_out_raw)
+{
+    *i_out_raw = prot_trig_i_out_adc;
+    *v_out_raw = prot_trig_v_out_adc;
+}
+
+/**
+  * @brief Add some filtering to OCPs
+  * @param raw the offset compensated I_out sample
+  * @param scan index of the scan the sample belongs to
+  * @retval None
+  */
+static void handle_ocp(uint16_t raw, uint32_t scan)
+{
+    static uint32_t ocp_count = 0;
+    static uint32_t last_tick_counter = 0;
+    if (((last_tick_counter+1) & OCP_SCAN_MASK) == scan) {
+        ocp_count++;
+        last_tick_counter = scan;
+        if (ocp_count == OCP_FILTER_COUNT) {
+            i_out_trig_adc = raw;
+            pwrctl_enable_vout(false);
+            event_put(event_ocp, 0);
+#ifdef CONFIG_CAPTURE
+            capture_trigger(capture_trig_ocp);
+#endif // CONFIG_CAPTURE
+        }
+    } else {
+        ocp_count = 0;
+        last_tick_counter = scan;
+    }
+}
+
+/**
+  * @brief Check one scan against the protection limits. Every protection
+  *        has a measure computed here and is then handled by the same
+  *        table driven filter, the cost per scan is the same whether the
+  *        protections are enabled or not.
+  * @param i_out the offset compensated I_out sample
+  * @param v_out the V_out sample
+  * @retval None
+  */
+static inline void handle_protections(uint32_t i_out, uint32_t v_out)
+{
+    int32_t v = (int32_t) v_out - pwrctl_v_out_zero_raw;
+    int32_t i = (int32_t) i_out - pwrctl_i_out_zero_raw;
+    uint32_t measure[prot_max];
+    measure[prot_ovp] = v_out;
+    measure[prot_opp] = v > 0 && i > 0 ? (uint32_t) (v * i) : 0;
+    bool enabled = pwrctl_vout_enabled();
+    for (uint32_t p = 0; p < prot_max; p++) {
+        prot_state_t *prot = &protections[p];
+        uint32_t limit = pwrctl_prot_limit_raw[p];
+        if (enabled && limit && measure[p] > limit) {
+            if (++prot->count == OCP_FILTER_COUNT) {
+                prot_trig_i_out_adc = i_out;
+                prot_trig_v_out_adc = v_out;
+                pwrctl_enable_vout(false);
+                event_put(prot->event, 0);
+#ifdef CONFIG_CAPTURE
+                capture_trigger(capture_trig_ocp);
+#endif // CONFIG_CAPTURE
+                enabled = false;
+            }
+        } else {
+            prot->count = 0;
+        }
+    }
+}
+
+/**
+  * @brief Add one scan to the sums of charge and energy
+  * @param i_out the offset compensated I_out sample
+  * @param v_out the V_out sample
+  * @retval None
+  */
+static inline void handle_sums(uint32_t i_out, uint32_t v_out)
+{
+    int32_t v = (int32_t) v_out - pwrctl_v_out_zero_raw;
+    int32_t i = (int32_t) i_out - pwrctl_i_out_zero_raw;
+    if (pwrctl_vout_enabled()) {
+        adc_sums.count++;
+        if (i > 0) {
+            adc_sums.i_out += i;
+            if (v > 0) {
+                adc_sums.power += (uint32_t) (v * i);
+            }
+        }
+    }
+}
+
+/**
+  * @brief Get and clear the sums of the samples made while power out was
+  *        enabled
+  * @param sums the sums since the previous call are copied here
+  * @retval None
+  */
+void hw_get_adc_sums(hw_adc_sums_t *sums)
+{
+    ADC_SCAN_LOCK();
+    *sums = adc_sums;
+    sums->scans = adc_counter;
+    adc_sums.count = 0;
+    adc_sums.i_out = 0;
+    adc_sums.power = 0;
+    ADC_SCAN_UNLOCK();
+}
+
+/**
+  * @brief Get the I_out offset measured at start up
+  * @param offset the offset is stored here
+  * @retval true if the offset has been measured
+  */
+bool adc_scan_i_offset(int32_t *offset)
+{
+    *offset = adc_i_offset;
+    return i_offset_valid;
+}
+
+/**
+  * @brief Check if the I_out offset is still being measured
+  * @retval true until ADC_I_OFFSET_COUNT scans have been averaged
+  */
+bool adc_scan_i_offset_measuring(void)
+{
+    return measure_i_out;
+}
+
+/**
+  * @brief Use an I_out offset measured before a warm reboot rather than
+  *        measuring it again, must be called before the ADC is started
+  * @param offset the offset
+  * @retval None
+  */
+void adc_scan_set_i_offset(int32_t offset)
+{
+    adc_i_offset = offset;
+    i_offset_valid = true;
+    measure_i_out = false;
+}
+
+/**
+  * @brief Use an I_out offset stored from an earlier boot until the one being
+  *        measured is ready, so readings and OCP are right from the start.
+  *        Must be called early, long before the measurement ends.
+  * @param offset the offset
+  * @retval None
+  */
+void adc_scan_seed_i_offset(int32_t offset)
+{
+    if (measure_i_out) {
+        adc_i_offset = offset;
+        i_offset_valid = true;
+#ifdef CONFIG_OCP_AWD
+        hw_update_ocp_limit();
+#endif // CONFIG_OCP_AWD
+    }
+}
+
+#ifdef CONFIG_OCP_AWD
+/**
+  * @brief Handle an analog watchdog interrupt, a raw I_out sample exceeded
+  *        the limit
+  * @param raw the raw I_out sample
+  * @param scan index of the scan the sample belongs to
+  * @retval None
+  */
+void adc_scan_awd(uint32_t raw, uint32_t scan)
+{
+    if (pwrctl_vout_enabled()) {
+        handle_ocp(raw + adc_i_offset, scan);
+    }
+}
+#endif // CONFIG_OCP_AWD
+
+/**
+  * @brief Calibrate an I_out sample and check it for OCP
+  * @param i the raw I_out sample, compensated with the measured offset on return
+  * @retval true if the sample is to be used, false during start up
+  */
+static inline bool handle_i_out_sample(uint32_t *i)
+{
+    /** @todo Make sure power out is not enabled during this measurement */
+    if (measure_i_out) {
+        if (adc_counter < ADC_I_OFFSET_COUNT) {
+            i_offset_calc += *i;
+        } else {
+            adc_i_offset = ADC_CHA_IOUT_GOLDEN_VALUE - (i_offset_calc / ADC_I_OFFSET_COUNT);
+            i_offset_valid = true;
+            measure_i_out = false;
+#ifdef CONFIG_OCP_AWD
+            hw_update_ocp_limit();
+#endif // CONFIG_OCP_AWD
+        }
+    }
+    // If pwrctl_i_limit_raw == 0, the setting hasn't been read from past yet
+    if (pwrctl_i_limit_raw) {
+        if (adc_counter >= STARTUP_SKIP_COUNT) {
+            *i += adc_i_offset;
+#ifndef CONFIG_OCP_AWD
+            if (*i > pwrctl_i_limit_raw && pwrctl_vout_enabled()) { /** OCP! */
+                handle_ocp(*i, adc_counter);
+            }
+#endif // CONFIG_OCP_AWD
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef CONFIG_ADC_OVERSAMPLING
+/**
+  * @brief Run one sample through the integrators of a CIC decimator
+  * @param f the decimator
+  * @param sample the sample
+  * @retval None
+  */
+static inline void cic_integrate(cic_t *f, uint32_t sample)
+{
+    f->integrator[0] += sample;
+    for (uint32_t n = 1; n < CONFIG_ADC_CIC_ORDER; n++) {
+        f->integrator[n] += f->integrator[n-1];
+    }
+}
+
+/**
+  * @brief Run the combs of a CIC decimator, called once per decimation period
+  * @param f the decimator
+  * @retval the reading with HW_ADC_FRAC_BITS fractional bits
+  */
+static inline uint16_t cic_decimate(cic_t *f)
+{
+    uint32_t y = f->integrator[CONFIG_ADC_CIC_ORDER-1];
+    for (uint32_t n = 0; n < CONFIG_ADC_CIC_ORDER; n++) {
+        uint32_t prev = f->comb[n];
+        f->comb[n] = y;
+        y -= prev;
+    }
+    /** The gain of the filter is R^N */
+    return y >> (CONFIG_ADC_CIC_ORDER * CONFIG_ADC_DECIMATION_LOG2 - HW_ADC_FRAC_BITS);
+}
+
+/**
+  * @brief Feed one scan to the decimators and publish new readings at the
+  *        end of each decimation period
+  * @param i_out offset compensated I_out sample, 0 while skipped
+  * @param v_in V_in sample
+  * @param v_out V_out sample
+  * @retval None
+  */
+static inline void handle_scan(uint32_t i_out, uint32_t v_in, uint32_t v_out)
+{
+    cic_integrate(&cic[adc_cha_i_out], i_out);
+    cic_integrate(&cic[adc_cha_v_in], v_in);
+    cic_integrate(&cic[adc_cha_v_out], v_out);
+    if (++cic_phase == (1 << CONFIG_ADC_DECIMATION_LOG2)) {
+        cic_phase = 0;
+        i_out_adc = cic_decimate(&cic[adc_cha_i_out]);
+        v_in_adc = cic_decimate(&cic[adc_cha_v_in]);
+        v_out_adc = cic_decimate(&cic[adc_cha_v_out]);
+    }
+}
+#endif // CONFIG_ADC_OVERSAMPLING
+
+/**
+  * @brief Get the number of scans processed since boot
+  * @retval the number of scans
+  */
+uint32_t adc_scan_count(void)
+{
+    return adc_counter;
+}
+
+#ifndef CONFIG_ADC_DMA
+/**
+  * @brief Process one scan of the ADC, at ~21kHz
+  * @param i the raw I_out sample
+  * @param v_in the raw V_in sample
+  * @param v_out the raw V_out sample
+  * @retval None
+  */
+void adc_scan(uint32_t i, uint32_t v_in, uint32_t v_out)
+{
+    adc_counter++;
+#ifdef CONFIG_BROWNOUT
+    brownout_check(v_in);
+#endif // CONFIG_BROWNOUT
+    bool i_valid = handle_i_out_sample(&i);
+    if (i_valid) {
+        handle_protections(i, v_out);
+        handle_sums(i, v_out);
+#ifdef CONFIG_CAPTURE
+        capture_scan(i, v_in, v_out);
+#endif // CONFIG_CAPTURE
+#ifdef CONFIG_STATS
+        stats_scan(i, v_in, v_out);
+#endif // CONFIG_STATS
+    }
+#ifdef CONFIG_ADC_OVERSAMPLING
+    handle_scan(i_valid ? i : 0, v_in, v_out);
+#else // CONFIG_ADC_OVERSAMPLING
+    if (i_valid) {
+        i_out_adc = i;
+    }
+    v_in_adc  = v_in;
+    v_out_adc = v_out;
+#endif // CONFIG_ADC_OVERSAMPLING
+}
+#else // CONFIG_ADC_DMA
+/**
+  * @brief Process one half of the ADC DMA buffer
+  * @param block_start ADC_DMA_BLOCK_LEN scans of adc_cha_max interleaved samples
+  * @retval None
+  */
+void adc_scan_block(uint16_t *block_start)
+{
+    uint16_t *scans = block_start;
+    adc_block_t *block = &adc_blocks[adc_block_idx ^ 1];
+    uint32_t i_sum = 0, v_in_sum = 0, v_out_sum = 0;
+    uint32_t i_count = 0;
+    block->i_out_min = block->v_out_min = 0xffff;
+    block->i_out_max = block->v_out_max = 0;
+
+    for (uint32_t n = 0; n < ADC_DMA_BLOCK_LEN; n++, scans += adc_cha_max) {
+        adc_counter++;
+#ifdef CONFIG_BROWNOUT
+        brownout_check(scans[adc_cha_v_in]);
+#endif // CONFIG_BROWNOUT
+        uint32_t i = scans[adc_cha_i_out];
+        uint16_t v_out = scans[adc_cha_v_out];
+        bool i_valid = handle_i_out_sample(&i);
+        if (i_valid) {
+            handle_protections(i, v_out);
+            handle_sums(i, v_out);
+#ifdef CONFIG_CAPTURE
+            capture_scan(i, scans[adc_cha_v_in], v_out);
+#endif // CONFIG_CAPTURE
+#ifdef CONFIG_STATS
+            stats_scan(i, scans[adc_cha_v_in], v_out);
+#endif // CONFIG_STATS
+            /** Write back so raw block consumers see compensated values */
+            scans[adc_cha_i_out] = i;
+            i_sum += i;
+            i_count++;
+            if (i < block->i_out_min) {
+                block->i_out_min = i;
+            }
+            if (i > block->i_out_max) {
+                block->i_out_max = i;
+            }
+        }
+#ifdef CONFIG_ADC_OVERSAMPLING
+        handle_scan(i_valid ? i : 0, scans[adc_cha_v_in], v_out);
+#endif // CONFIG_ADC_OVERSAMPLING
+        v_in_sum += scans[adc_cha_v_in];
+        v_out_sum += v_out;
+        if (v_out < block->v_out_min) {
+            block->v_out_min = v_out;
+        }
+        if (v_out > block->v_out_max) {
+            block->v_out_max = v_out;
+        }
+    }
+
+    if (i_count) {
+        block->i_out_avg = i_sum / i_count;
+#ifndef CONFIG_ADC_OVERSAMPLING
+        i_out_adc = block->i_out_avg;
+#endif // CONFIG_ADC_OVERSAMPLING
+    } else {
+        block->i_out_avg = block->i_out_min = block->i_out_max = 0;
+    }
+    block->v_in_avg = v_in_sum / ADC_DMA_BLOCK_LEN;
+    block->v_out_avg = v_out_sum / ADC_DMA_BLOCK_LEN;
+#ifndef CONFIG_ADC_OVERSAMPLING
+    v_in_adc = block->v_in_avg;
+    v_out_adc = block->v_out_avg;
+#endif // CONFIG_ADC_OVERSAMPLING
+    block->count = ADC_DMA_BLOCK_LEN;
+    block->seq = adc_block_seq + 1;
+    adc_block_idx ^= 1;
+    adc_block_seq = block->seq;
+
+    if (adc_block_callback) {
+        adc_block_callback((const uint16_t*) block_start, ADC_DMA_BLOCK_LEN);
+    }
+}
+#endif // CONFIG_ADC_DMA
@@ -0,0 +1,106 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ADC_SCAN_H__
+#define __ADC_SCAN_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    adc_cha_i_out = 0,
+    adc_cha_v_in,
+    adc_cha_v_out,
+    adc_cha_max,
+} adc_channel_t;
+
+#ifndef CONFIG_ADC_DMA
+/**
+  * @brief Process one scan: calibrate I_out, check the protections, add to
+  *        the sums and the capture, and update the readings
+  * @param i the raw I_out sample
+  * @param v_in the raw V_in sample
+  * @param v_out the raw V_out sample
+  * @retval None
+  */
+void adc_scan(uint32_t i, uint32_t v_in, uint32_t v_out);
+#else // CONFIG_ADC_DMA
+/**
+  * @brief Process a block of ADC_DMA_BLOCK_LEN scans like adc_scan() does,
+  *        and publish the block summary
+  * @param block_start adc_cha_max interleaved raw samples per scan, I_out is
+  *        offset compensated on return
+  * @retval None
+  */
+void adc_scan_block(uint16_t *block_start);
+#endif // CONFIG_ADC_DMA
+
+/**
+  * @brief Get the number of scans processed since boot
+  * @retval the number of scans
+  */
+uint32_t adc_scan_count(void);
+
+/**
+  * @brief Get the I_out offset measured at start up
+  * @param offset the offset is stored here
+  * @retval true if the offset has been measured
+  */
+bool adc_scan_i_offset(int32_t *offset);
+
+/**
+  * @brief Check if the I_out offset is still being measured
+  * @retval true until ADC_I_OFFSET_COUNT scans have been averaged
+  */
+bool adc_scan_i_offset_measuring(void);
+
+/**
+  * @brief Use an I_out offset measured before a warm reboot rather than
+  *        measuring it again, must be called before the ADC is started
+  * @param offset the offset
+  * @retval None
+  */
+void adc_scan_set_i_offset(int32_t offset);
+
+/**
+  * @brief Use an I_out offset stored from an earlier boot until the one being
+  *        measured is ready, so readings and OCP are right from the start.
+  *        Must be called early, long before the measurement ends.
+  * @param offset the offset
+  * @retval None
+  */
+void adc_scan_seed_i_offset(int32_t offset);
+
+#ifdef CONFIG_OCP_AWD
+/**
+  * @brief Handle an analog watchdog interrupt, a raw I_out sample exceeded
+  *        the limit
+  * @param raw the raw I_out sample
+  * @param scan index of the scan the sample belongs to
+  * @retval None
+  */
+void adc_scan_awd(uint32_t raw, uint32_t scan);
+#endif // CONFIG_OCP_AWD
+
+#endif // __ADC_SCAN_H__
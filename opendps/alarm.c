@@ -0,0 +1,213 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "alarm.h"
+#include "hw.h"
+#include "pwrctl.h"
+#include "tick.h"
+#include "softtimer.h"
+#include "past.h"
+#include "pastunits.h"
+#include "uui.h"
+#include "opendps.h"
+#include "serialhandler.h"
+#include "dbg_printf.h"
+
+static alarm_rule_t rules[CONFIG_ALARM_RULES];
+static uint32_t rule_count;
+static uint32_t upload_count;
+static past_t *alarm_past;
+static softtimer_t alarm_timer;
+
+/** When the condition of each rule started to hold, 0 while it does not */
+static uint64_t since[CONFIG_ALARM_RULES];
+/** Set when a rule has fired, until its condition clears */
+static bool fired[CONFIG_ALARM_RULES];
+
+static void alarm_tick(softtimer_t *timer);
+
+/**
+  * @brief Check a rule
+  * @param rule the rule
+  * @retval true if the rule can be evaluated and acted on
+  */
+static bool rule_valid(const alarm_rule_t *rule)
+{
+    char *names[8];
+    if (rule->channel >= alarm_max_channel || (rule->compare & ~ALARM_WHILE_ENABLED) > alarm_above || rule->action >= alarm_max_action) {
+        return false;
+    }
+    if (rule->action == alarm_set_function || rule->action == alarm_set_function_on) {
+        return rule->function < opendps_get_function_names(names, 8);
+    }
+    return true;
+}
+
+/**
+  * @brief Initialize the alarms, restoring the rules from past and starting
+  *        the evaluation
+  * @param past the past the rules are stored in
+  * @retval None
+  */
+void alarm_init(past_t *past)
+{
+    const void *stored;
+    uint32_t length;
+    alarm_past = past;
+    if (past_read_unit(past, past_alarms, &stored, &length) && length <= sizeof(rules) && length % sizeof(alarm_rule_t) == 0) {
+        memcpy(rules, stored, length);
+        rule_count = length / sizeof(alarm_rule_t);
+        for (uint32_t i = 0; i < rule_count; i++) {
+            if (!rule_valid(&rules[i])) {
+                rule_count = 0; /** Not ours, maybe from another build */
+                break;
+            }
+        }
+    }
+    softtimer_start(&alarm_timer, CONFIG_ALARM_INTERVAL_MS, CONFIG_ALARM_INTERVAL_MS, &alarm_tick);
+}
+
+/**
+  * @brief Upload (part of) the rules, the rules are stored in past when the
+  *        last one has been received
+  * @param total number of rules, 0 removes them all
+  * @param first index of the first rule in rules, uploads are made in order
+  * @param _rules the rules
+  * @param count number of rules
+  * @retval false if the upload is out of order or a rule is invalid
+  */
+bool alarm_upload(uint32_t total, uint32_t first, const alarm_rule_t *_rules, uint32_t count)
+{
+    if (total > CONFIG_ALARM_RULES || first + count > total) {
+        return false;
+    }
+    if (first == 0) {
+        upload_count = 0;
+    } else if (first != upload_count) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (!rule_valid(&_rules[i])) {
+            return false;
+        }
+    }
+    /** No rule is evaluated until the upload is complete */
+    rule_count = 0;
+    memcpy(&rules[first], _rules, count * sizeof(alarm_rule_t));
+    upload_count += count;
+    if (upload_count < total) {
+        return true;
+    }
+    upload_count = 0;
+    memset(since, 0, sizeof(since));
+    memset(fired, 0, sizeof(fired));
+    rule_count = total;
+    if (!total) {
+        (void) past_erase_unit(alarm_past, past_alarms);
+        return true;
+    }
+    if (!past_write_unit(alarm_past, past_alarms, (void*) rules, total * sizeof(alarm_rule_t))) {
+        dbg_printf("Error: past write alarms failed!\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+  * @brief Act on a rule that fired
+  * @param index the index of the rule
+  * @param value the reading that fired it
+  * @retval None
+  */
+static void fire(uint32_t index, uint32_t value)
+{
+    const alarm_rule_t *rule = &rules[index];
+    switch (rule->action) {
+        case alarm_disable_output:
+            (void) opendps_enable_output(false);
+            break;
+        case alarm_set_function:
+        case alarm_set_function_on:
+            if (opendps_enable_function_idx(rule->function) && rule->action == alarm_set_function_on) {
+                (void) opendps_enable_output(true);
+            }
+            break;
+        default:
+            break;
+    }
+#ifdef CONFIG_SERIAL_PROTOCOL
+    serial_send_alarm_event(index, value);
+#else
+    (void) value;
+#endif // CONFIG_SERIAL_PROTOCOL
+}
+
+/**
+  * @brief Evaluate the rules, run every CONFIG_ALARM_INTERVAL_MS
+  * @param timer the alarm timer
+  * @retval None
+  */
+static void alarm_tick(softtimer_t *timer)
+{
+    (void) timer;
+    if (!rule_count) {
+        return;
+    }
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    uint32_t value[alarm_max_channel];
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+    value[alarm_v_out] = pwrctl_calc_vout(v_out_raw);
+    value[alarm_i_out] = pwrctl_calc_iout(i_out_raw);
+    value[alarm_v_in] = pwrctl_calc_vin(v_in_raw);
+    value[alarm_power] = value[alarm_v_out] * value[alarm_i_out] / 1000;
+    bool enabled = pwrctl_vout_enabled();
+    uint64_t now = get_ticks();
+    for (uint32_t i = 0; i < rule_count; i++) {
+        const alarm_rule_t *rule = &rules[i];
+        uint32_t v = value[rule->channel];
+        bool holds;
+        if ((rule->compare & ALARM_WHILE_ENABLED) && !enabled) {
+            holds = false;
+        } else if ((rule->compare & ~ALARM_WHILE_ENABLED) == alarm_below) {
+            holds = v < rule->threshold;
+        } else {
+            holds = v > rule->threshold;
+        }
+        if (!holds) {
+            since[i] = 0;
+            fired[i] = false;
+        } else if (!fired[i]) {
+            if (!since[i]) {
+                since[i] = now ? now : 1;
+            }
+            if (now - since[i] >= rule->hold_ms) {
+                fired[i] = true;
+                fire(i, v);
+            }
+        }
+    }
+}
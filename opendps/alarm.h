@@ -0,0 +1,100 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ALARM_H__
+#define __ALARM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "past.h"
+
+/** Alarm rules watch the decimated readings and act when a condition has
+  * held for a while, eg. "I_out below 10mA for 5s" when the device under
+  * test is done. Every rule notifies the host when it fires, and fires again
+  * only after its condition has cleared. */
+
+/** Number of rules */
+#ifndef CONFIG_ALARM_RULES
+ #define CONFIG_ALARM_RULES  (8)
+#endif
+
+/** How often the rules are evaluated, on a soft timer */
+#ifndef CONFIG_ALARM_INTERVAL_MS
+ #define CONFIG_ALARM_INTERVAL_MS  (10)
+#endif
+
+typedef enum {
+    alarm_v_out = 0, /** mV */
+    alarm_i_out,     /** mA */
+    alarm_v_in,      /** mV */
+    alarm_power,     /** mW */
+    alarm_max_channel
+} alarm_channel_t;
+
+typedef enum {
+    alarm_below = 0,
+    alarm_above
+} alarm_compare_t;
+
+/** Or:ed to the compare of rules only evaluated while power out is enabled */
+#define ALARM_WHILE_ENABLED  (0x80)
+
+typedef enum {
+    alarm_notify = 0,       /** Only notify the host */
+    alarm_disable_output,
+    alarm_set_function,     /** Switch to <function>, with power out disabled */
+    alarm_set_function_on,  /** Switch to <function> and enable power out */
+    alarm_max_action
+} alarm_action_t;
+
+/** A rule, stored in past as is */
+typedef struct {
+    uint8_t channel;    /** alarm_channel_t */
+    uint8_t compare;    /** alarm_compare_t, optionally | ALARM_WHILE_ENABLED */
+    uint8_t action;     /** alarm_action_t */
+    uint8_t function;   /** Function index of the alarm_set_function actions */
+    uint32_t threshold; /** In the unit of the channel */
+    uint32_t hold_ms;   /** How long the condition must hold, 0 fires at once */
+} alarm_rule_t;
+
+/**
+  * @brief Initialize the alarms, restoring the rules from past and starting
+  *        the evaluation
+  * @param past the past the rules are stored in
+  * @retval None
+  */
+void alarm_init(past_t *past);
+
+/**
+  * @brief Upload (part of) the rules, the rules are stored in past when the
+  *        last one has been received
+  * @param total number of rules, 0 removes them all
+  * @param first index of the first rule in rules, uploads are made in order
+  * @param rules the rules
+  * @param count number of rules
+  * @retval false if the upload is out of order or a rule is invalid
+  */
+bool alarm_upload(uint32_t total, uint32_t first, const alarm_rule_t *rules, uint32_t count);
+
+#endif // __ALARM_H__
@@ -47,11 +47,12 @@ void bootcom_put(uint32_t w1, uint32_t w2)
 }
 
 /**
-  * @brief Get data from bootcom buffer
+  * @brief Read the bootcom buffer
   * @param w1, w2 pointers to place bootcom data info
+  * @param clear clear the buffer once read
   * @retval true if bootcom data was found, false otherwise
   */
-bool bootcom_get(uint32_t *w1, uint32_t *w2)
+static bool bootcom_read(uint32_t *w1, uint32_t *w2, bool clear)
 {
     bool success = false;
     uint32_t *bootcom = (uint32_t*) &_bootcom_start;
@@ -59,10 +60,31 @@ bool bootcom_get(uint32_t *w1, uint32_t *w2)
         if (bootcom[3] == crc16((uint8_t*) bootcom, 12)) {
             *w1 = bootcom[1];
             *w2 = bootcom[2];
-            bootcom[0] = bootcom[1] = bootcom[2] = bootcom[3] = 0;
+            if (clear) {
+                bootcom[0] = bootcom[1] = bootcom[2] = bootcom[3] = 0;
+            }
             success = true;
         }
     }
 	return success;
 }
 
+/**
+  * @brief Get data from bootcom buffer
+  * @param w1, w2 pointers to place bootcom data info
+  * @retval true if bootcom data was found, false otherwise
+  */
+bool bootcom_get(uint32_t *w1, uint32_t *w2)
+{
+    return bootcom_read(w1, w2, true);
+}
+
+/**
+  * @brief Get data from bootcom buffer, leaving it for the next reader
+  * @param w1, w2 pointers to place bootcom data info
+  * @retval true if bootcom data was found, false otherwise
+  */
+bool bootcom_peek(uint32_t *w1, uint32_t *w2)
+{
+    return bootcom_read(w1, w2, false);
+}
@@ -28,6 +28,14 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/** Magics passed as the first bootcom word */
+/** The app asks the bootloader for an upgrade, the second word holds the
+  * chunk size and the firmware crc */
+#define BOOTCOM_UPGRADE   (0xfedebeda)
+/** The app asks the bootloader to start it again at once, the second word
+  * holds the measured I_out offset for the app to keep */
+#define BOOTCOM_WARM_BOOT (0xb0075afe)
+
 /**
   * @brief Put data into bootcom buffer and set the bootcom magic
   * @param w1, w2 data to place into buffer
@@ -42,4 +50,11 @@ void bootcom_put(uint32_t w1, uint32_t w2);
   */
 bool bootcom_get(uint32_t *w1, uint32_t *w2);
 
+/**
+  * @brief Get data from bootcom buffer, leaving it for the next reader
+  * @param w1, w2 pointers to place bootcom data info
+  * @retval true if bootcom data was found, false otherwise
+  */
+bool bootcom_peek(uint32_t *w1, uint32_t *w2);
+
 #endif // __BOOTCOM_H__
@@ -0,0 +1,122 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#ifndef DPS_EMULATOR
+#include <rcc.h>
+#include <pwr.h>
+#include <exti.h>
+#include <nvic.h>
+#endif // DPS_EMULATOR
+#include "brownout.h"
+#include "pwrctl.h"
+#include "event.h"
+#include "tick.h"
+#include "dbg_printf.h"
+
+static past_t *brownout_past;
+static volatile uint16_t trip_raw;
+static volatile uint16_t arm_raw;
+static volatile bool armed;
+static volatile bool tripped;
+static uint32_t below_count;
+/** When the trip was detected, for timing the save */
+static volatile uint64_t trip_us;
+
+/**
+  * @brief Disable power out and have the main loop save, once per trip
+  * @retval None
+  */
+static void trip(void)
+{
+    if (tripped) {
+        return;
+    }
+    tripped = true;
+    trip_us = get_ticks_us();
+    bool enabled = pwrctl_vout_enabled();
+    pwrctl_enable_vout(false);
+    event_put(event_brownout, enabled);
+}
+
+void brownout_init(past_t *past)
+{
+    brownout_past = past;
+    trip_raw = pwrctl_calc_vin_adc(CONFIG_BROWNOUT_V_IN_MV);
+    arm_raw = pwrctl_calc_vin_adc(CONFIG_BROWNOUT_V_IN_MV + CONFIG_BROWNOUT_HYSTERESIS_MV);
+#ifndef DPS_EMULATOR
+    /** PVDO rises as VDD falls below 2.9V */
+    rcc_periph_clock_enable(RCC_PWR);
+    pwr_enable_power_voltage_detect(PWR_CR_PLS_2V9);
+    exti_set_trigger(EXTI16, EXTI_TRIGGER_RISING);
+    exti_enable_request(EXTI16);
+    nvic_enable_irq(NVIC_PVD_IRQ);
+#endif // DPS_EMULATOR
+}
+
+void brownout_check(uint32_t v_in_raw)
+{
+    if (!armed) {
+        /** Not until the supply has come up, and then back up after a trip */
+        if (v_in_raw >= arm_raw) {
+            armed = true;
+            tripped = false;
+            below_count = 0;
+        }
+    } else if (v_in_raw >= trip_raw) {
+        below_count = 0;
+    } else if (++below_count == CONFIG_BROWNOUT_FILTER_COUNT) {
+        armed = false;
+        trip();
+    }
+}
+
+bool brownout_save(void)
+{
+    uint64_t start_us = get_ticks_us();
+    uint32_t length = PAST_UNIT_SIZE(sizeof(energy_counters_t)) + past_cache_size(brownout_past);
+    if (!past_begin_reserved(brownout_past, length)) {
+        dbg_printf("Error: brownout save has no room!\n");
+        return false;
+    }
+    energy_save();
+    (void) past_flush(brownout_past);
+    bool success = past_commit(brownout_past);
+    uint64_t end_us = get_ticks_us();
+    dbg_printf("Brownout: %u bytes saved in %u us, %u us after the trip\n", PAST_UNIT_SIZE(4) + length, (uint32_t) (end_us - start_us), (uint32_t) (end_us - trip_us));
+    return success;
+}
+
+#ifndef DPS_EMULATOR
+/**
+  * @brief PVD ISR, VDD fell below the threshold
+  * @retval None
+  */
+void pvd_isr(void)
+{
+    exti_reset_request(EXTI16);
+    trip();
+}
+#endif // DPS_EMULATOR
@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __BROWNOUT_H__
+#define __BROWNOUT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "past.h"
+#include "energy.h"
+
+/** When the supply goes away, the energy counters and the settings pending
+  * in the past write-back cache would be lost. V_in is checked on every ADC
+  * scan, and the PVD interrupts when VDD sags, as a backstop. Either one
+  * disables power out, which stretches the hold-up time of the input
+  * capacitors, and puts an event_brownout, its data telling if power out
+  * was enabled. The main loop then writes it all
+  * in one past transaction into PAST_RESERVE_SIZE bytes kept free in the
+  * current block, so no flash page has to be erased. */
+
+/** V_in below which the supply is taken as lost. It must leave the 3.3V
+  * regulator enough headroom to finish the save. */
+#ifndef CONFIG_BROWNOUT_V_IN_MV
+ #define CONFIG_BROWNOUT_V_IN_MV  (7000)
+#endif
+
+/** The check is armed once V_in has been this much above the trip level */
+#ifndef CONFIG_BROWNOUT_HYSTERESIS_MV
+ #define CONFIG_BROWNOUT_HYSTERESIS_MV  (1000)
+#endif
+
+/** Consecutive scans below the trip level it takes, ~20 per ms */
+#ifndef CONFIG_BROWNOUT_FILTER_COUNT
+ #define CONFIG_BROWNOUT_FILTER_COUNT  (10)
+#endif
+
+/** The flash the emergency save can take: the transaction marker, the
+  * energy counters and a full write-back cache */
+#ifdef CONFIG_PAST_WRITE_BACK
+ #define BROWNOUT_SAVE_SIZE  (PAST_UNIT_SIZE(4) + PAST_UNIT_SIZE(sizeof(energy_counters_t)) + PAST_CACHE_SLOTS * PAST_UNIT_SIZE(PAST_CACHE_UNIT_SIZE))
+#else // CONFIG_PAST_WRITE_BACK
+ #define BROWNOUT_SAVE_SIZE  (PAST_UNIT_SIZE(4) + PAST_UNIT_SIZE(sizeof(energy_counters_t)))
+#endif // CONFIG_PAST_WRITE_BACK
+
+_Static_assert (PAST_RESERVE_SIZE >= BROWNOUT_SAVE_SIZE, "PAST_RESERVE_SIZE cannot hold the brownout save");
+
+/**
+  * @brief Start watching V_in and VDD, after the calibration has been read
+  * @param past the past to save to
+  * @retval None
+  */
+void brownout_init(past_t *past);
+
+/**
+  * @brief Check a V_in sample, called from the ADC ISR on every scan
+  * @param v_in_raw the raw 12 bit V_in sample
+  * @retval None
+  */
+void brownout_check(uint32_t v_in_raw);
+
+/**
+  * @brief Save the energy counters and the pending settings, on
+  *        event_brownout. The check is re-armed should V_in come back.
+  * @retval true if the save was committed
+  */
+bool brownout_save(void);
+
+#endif // __BROWNOUT_H__
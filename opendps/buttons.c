@@ -0,0 +1,208 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <gpio.h>
+#include "buttons.h"
+#include "event.h"
+#include "hw.h"
+#include "tick.h"
+#include "profile.h"
+
+#define BUTTON_LONG    (1 << 0) /** Held presses become press_long */
+#define BUTTON_REPEAT  (1 << 1) /** Held presses become press_repeat */
+
+typedef struct {
+    uint32_t port;
+    uint16_t pin;
+    event_t event;
+    uint8_t flags;
+} button_t;
+
+typedef struct {
+    uint8_t integrator;
+    bool pressed;
+    bool held;           /** A long press or a repeat was sent for this press */
+    uint32_t press_tick; /** When the press was accepted */
+    uint32_t next_repeat;
+    bool ignore;         /** Held since buttons_init(), ignored until released */
+} button_state_t;
+
+static const button_t buttons[] = {
+    { BUTTON_SEL_PORT, BUTTON_SEL_PIN, event_button_sel, BUTTON_LONG },
+    { BUTTON_M1_PORT, BUTTON_M1_PIN, event_button_m1, BUTTON_REPEAT },
+    { BUTTON_M2_PORT, BUTTON_M2_PIN, event_button_m2, BUTTON_REPEAT },
+    { BUTTON_ENABLE_PORT, BUTTON_ENABLE_PIN, event_button_enable, 0 },
+    { BUTTON_ROT_PRESS_PORT, BUTTON_ROT_PRESS_PIN, event_rot_press, BUTTON_LONG },
+};
+
+#define NUM_BUTTONS  (sizeof(buttons) / sizeof(buttons[0]))
+#define SEL_BUTTON   (0) /** Index of SEL in buttons[] */
+
+static button_state_t state[NUM_BUTTONS];
+
+/** Debounced rotary encoder pins */
+static uint8_t rot_a_integrator;
+static uint8_t rot_b_integrator;
+static bool rot_a;
+static bool rot_b;
+
+#ifdef CONFIG_ROT_ACCEL
+/** Detents less than ROT_ACCEL_MS apart in the same direction count as up to
+  * ROT_ACCEL_MAX steps, the faster the dial is turned the more */
+#define ROT_ACCEL_MS   (80)
+#define ROT_ACCEL_MAX  (8)
+static uint32_t rot_last_tick;
+static bool rot_last_left;
+#endif // CONFIG_ROT_ACCEL
+
+/**
+  * @brief Run an integrator one sample
+  * @param integrator the integrator
+  * @param level the sampled level
+  * @param max the number of samples it takes to change state
+  * @param debounced the debounced level, updated when the integrator hits
+  *        either end
+  * @retval true if the debounced level changed
+  */
+static bool integrate(uint8_t *integrator, bool level, uint8_t max, bool *debounced)
+{
+    if (level) {
+        if (*integrator < max) {
+            (*integrator)++;
+        }
+    } else if (*integrator > 0) {
+        (*integrator)--;
+    }
+    if (*integrator == max && !*debounced) {
+        *debounced = true;
+        return true;
+    } else if (*integrator == 0 && *debounced) {
+        *debounced = false;
+        return true;
+    }
+    return false;
+}
+
+/**
+  * @brief Get the number of steps a detent of the rotary encoder counts as
+  * @param left true for a step to the left
+  * @param now the current tick
+  * @retval the number of steps, 1 unless the dial is turned fast
+  */
+static uint8_t rot_steps(bool left, uint32_t now)
+{
+#ifdef CONFIG_ROT_ACCEL
+    uint32_t interval = now - rot_last_tick;
+    bool same = left == rot_last_left;
+    rot_last_tick = now;
+    rot_last_left = left;
+    if (same && interval < ROT_ACCEL_MS) {
+        return 1 + (ROT_ACCEL_MS - interval) * (ROT_ACCEL_MAX - 1) / ROT_ACCEL_MS;
+    }
+#else // CONFIG_ROT_ACCEL
+    (void) left;
+    (void) now;
+#endif // CONFIG_ROT_ACCEL
+    return 1;
+}
+
+/**
+  * @brief Classify one button from its debounced state
+  * @param i index in buttons[]
+  * @param down the sampled level, true if the button reads pressed
+  * @param now the current tick
+  * @retval None
+  */
+static void scan_button(uint32_t i, bool down, uint32_t now)
+{
+    const button_t *b = &buttons[i];
+    button_state_t *s = &state[i];
+    if (integrate(&s->integrator, down, CONFIG_BUTTON_DEBOUNCE_MS, &s->pressed)) {
+        if (s->pressed) {
+            s->press_tick = now;
+            s->next_repeat = now + CONFIG_BUTTON_REPEAT_DELAY_MS;
+            s->held = false;
+        } else if (!s->held) {
+            event_put(b->event, press_short);
+        }
+        s->ignore = false;
+    } else if (s->pressed && !s->ignore) {
+        if (!s->held && (b->flags & BUTTON_LONG) && now - s->press_tick >= CONFIG_BUTTON_LONGPRESS_MS) {
+            s->held = true;
+            event_put(b->event, press_long);
+        } else if ((b->flags & BUTTON_REPEAT) && (int32_t) (now - s->next_repeat) >= 0) {
+            s->held = true;
+            s->next_repeat += CONFIG_BUTTON_REPEAT_MS;
+            event_put(b->event, press_repeat);
+        }
+    }
+}
+
+void buttons_init(void)
+{
+    for (uint32_t i = 0; i < NUM_BUTTONS; i++) {
+        /** A button held at power on (SEL in the bootloader) must be let go
+          * and pressed again to count */
+        bool down = !((uint16_t) GPIO_IDR(buttons[i].port) & buttons[i].pin);
+        state[i].integrator = down ? CONFIG_BUTTON_DEBOUNCE_MS : 0;
+        state[i].pressed = down;
+        state[i].held = true;
+        state[i].ignore = down;
+    }
+    rot_a = ((uint16_t) GPIO_IDR(BUTTON_ROT_A_PORT) & BUTTON_ROT_A_PIN) ? 1 : 0;
+    rot_b = ((uint16_t) GPIO_IDR(BUTTON_ROT_B_PORT) & BUTTON_ROT_B_PIN) ? 1 : 0;
+    rot_a_integrator = rot_a ? CONFIG_ROT_DEBOUNCE_MS : 0;
+    rot_b_integrator = rot_b ? CONFIG_ROT_DEBOUNCE_MS : 0;
+    (void) tick_add_callback(&buttons_scan);
+}
+
+void buttons_scan(void)
+{
+    PROFILE_START();
+    uint32_t now = get_ticks32();
+    for (uint32_t i = 0; i < NUM_BUTTONS; i++) {
+        /** The buttons are active low */
+        bool down = !((uint16_t) GPIO_IDR(buttons[i].port) & buttons[i].pin);
+        scan_button(i, down, now);
+    }
+
+    bool a = ((uint16_t) GPIO_IDR(BUTTON_ROT_A_PORT) & BUTTON_ROT_A_PIN) ? 1 : 0;
+    bool b = ((uint16_t) GPIO_IDR(BUTTON_ROT_B_PORT) & BUTTON_ROT_B_PIN) ? 1 : 0;
+    (void) integrate(&rot_b_integrator, b, CONFIG_ROT_DEBOUNCE_MS, &rot_b);
+    if (integrate(&rot_a_integrator, a, CONFIG_ROT_DEBOUNCE_MS, &rot_a)) {
+        /** One step on each edge of A. B leads A turning left. */
+        bool left = rot_a == rot_b;
+        if (state[SEL_BUTTON].pressed) {
+            /** SEL + rotary, the SEL press itself and any long press are
+              * dropped */
+            state[SEL_BUTTON].held = true;
+            event_put(left ? event_rot_left_set : event_rot_right_set, 1);
+        } else {
+            event_put(left ? event_rot_left : event_rot_right, rot_steps(left, now));
+        }
+    }
+    PROFILE_END(prof_button_isr);
+}
@@ -0,0 +1,78 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __BUTTONS_H__
+#define __BUTTONS_H__
+
+#include <stdint.h>
+
+/** The buttons and the rotary encoder are sampled every millisecond from the
+  * systick ISR rather than interrupting on every edge. Each input has an
+  * integrator that counts up while the pin reads pressed and down while it
+  * does not, and the input only changes state when the integrator hits either
+  * end. Contact bounce therefore never reaches the event queue. A press is
+  * timestamped when it is accepted and classified from that:
+  *  - press_short on release, unless the press turned long or repeating
+  *  - press_long once held for CONFIG_BUTTON_LONGPRESS_MS (SEL and rotary press)
+  *  - press_repeat every CONFIG_BUTTON_REPEAT_MS after being held for
+  *    CONFIG_BUTTON_REPEAT_DELAY_MS (M1 and M2)
+  */
+
+/** Samples a button must read the same before it changes state */
+#ifndef CONFIG_BUTTON_DEBOUNCE_MS
+ #define CONFIG_BUTTON_DEBOUNCE_MS  (5)
+#endif
+
+/** Samples for the rotary encoder A and B pins, which change far quicker */
+#ifndef CONFIG_ROT_DEBOUNCE_MS
+ #define CONFIG_ROT_DEBOUNCE_MS  (2)
+#endif
+
+#ifndef CONFIG_BUTTON_LONGPRESS_MS
+ #define CONFIG_BUTTON_LONGPRESS_MS  (1000)
+#endif
+
+#ifndef CONFIG_BUTTON_REPEAT_DELAY_MS
+ #define CONFIG_BUTTON_REPEAT_DELAY_MS  (500)
+#endif
+
+#ifndef CONFIG_BUTTON_REPEAT_MS
+ #define CONFIG_BUTTON_REPEAT_MS  (150)
+#endif
+
+/**
+  * @brief Start the button scanner on the systick ISR, buttons held down
+  *        now are ignored until released
+  * @retval None
+  */
+void buttons_init(void);
+
+/**
+  * @brief Sample the buttons and the rotary encoder and put the resulting
+  *        events, called from the systick ISR every millisecond
+  * @retval None
+  */
+void buttons_scan(void);
+
+#endif // __BUTTONS_H__
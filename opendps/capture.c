@@ -0,0 +1,221 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "capture.h"
+#include "hw.h"
+#include "pwrctl.h"
+
+/** The ring, raw samples */
+static uint16_t ring[CONFIG_CAPTURE_SAMPLES][3];
+static volatile capture_state_t state;
+static capture_trigger_t trigger;
+static uint32_t trigger_level;
+static uint32_t decimation;
+static uint32_t post_samples;
+
+/** Owned by the ISR while armed or triggered */
+static uint32_t head;        /** Next sample goes here */
+static uint32_t filled;      /** Number of samples in the ring */
+static uint32_t trigger_pos; /** Ring index of the first post-trigger sample */
+static uint32_t remaining;   /** Post-trigger samples left to record */
+static uint32_t scan_count;
+static uint32_t sums[3];
+static bool was_enabled;
+
+enum {
+    s_i_out = 0,
+    s_v_in,
+    s_v_out,
+};
+
+/**
+  * @brief Arm a capture, discarding any previous capture
+  * @param trigger the trigger, capture_trig_none disarms
+  * @param level the level of the threshold triggers in mA or mV
+  * @param decimation number of scans (at ~21kHz) averaged into each sample
+  * @param pre_samples number of samples to keep from before the trigger
+  * @retval false if the arguments are out of range
+  */
+bool capture_arm(capture_trigger_t _trigger, uint32_t level, uint32_t _decimation, uint32_t pre_samples)
+{
+    state = capture_idle; /** The ISR keeps out until we are done */
+    if (_trigger == capture_trig_none) {
+        return true;
+    }
+    if (_trigger >= capture_trig_max || _decimation == 0 || _decimation > 0xffff || pre_samples >= CONFIG_CAPTURE_SAMPLES) {
+        return false;
+    }
+    switch (_trigger) {
+        case capture_trig_i_above:
+            trigger_level = pwrctl_calc_ilimit_adc(level);
+            break;
+        case capture_trig_v_above:
+        case capture_trig_v_below:
+            trigger_level = pwrctl_calc_vout_adc(level);
+            break;
+        default:
+            trigger_level = 0;
+            break;
+    }
+    trigger = _trigger;
+    decimation = _decimation;
+    post_samples = CONFIG_CAPTURE_SAMPLES - pre_samples;
+    head = filled = 0;
+    scan_count = 0;
+    sums[s_i_out] = sums[s_v_in] = sums[s_v_out] = 0;
+    was_enabled = pwrctl_vout_enabled();
+    state = capture_armed;
+    if (trigger == capture_trig_immediate) {
+        capture_trigger(capture_trig_immediate);
+    }
+    return true;
+}
+
+/**
+  * @brief Get the state of the capture
+  * @param count number of samples captured, valid when done
+  * @param trigger_index index of the first sample recorded after the trigger,
+  *        valid when done
+  * @param decimation number of scans per sample
+  * @retval the state
+  */
+capture_state_t capture_get_state(uint32_t *count, uint32_t *trigger_index, uint32_t *_decimation)
+{
+    capture_state_t s = state;
+    *_decimation = decimation;
+    if (s == capture_done) {
+        /** The oldest sample is at head once the ring has wrapped */
+        uint32_t start = filled < CONFIG_CAPTURE_SAMPLES ? 0 : head;
+        *count = filled;
+        *trigger_index = (trigger_pos + CONFIG_CAPTURE_SAMPLES - start) % CONFIG_CAPTURE_SAMPLES;
+    } else {
+        *count = *trigger_index = 0;
+    }
+    return s;
+}
+
+/**
+  * @brief Read samples of a finished capture, oldest first
+  * @param offset index of the first sample to read
+  * @param samples the samples are copied here
+  * @param count max number of samples to copy
+  * @retval number of samples copied, 0 if the capture is not done
+  */
+uint32_t capture_read(uint32_t offset, capture_sample_t *samples, uint32_t count)
+{
+    if (state != capture_done || offset >= filled) {
+        return 0;
+    }
+    if (count > filled - offset) {
+        count = filled - offset;
+    }
+    uint32_t start = filled < CONFIG_CAPTURE_SAMPLES ? 0 : head;
+    for (uint32_t n = 0; n < count; n++) {
+        uint16_t *raw = ring[(start + offset + n) % CONFIG_CAPTURE_SAMPLES];
+        samples[n].v_out = pwrctl_calc_vout(raw[s_v_out] << HW_ADC_FRAC_BITS);
+        samples[n].i_out = pwrctl_calc_iout(raw[s_i_out] << HW_ADC_FRAC_BITS);
+        samples[n].v_in = pwrctl_calc_vin(raw[s_v_in] << HW_ADC_FRAC_BITS);
+    }
+    return count;
+}
+
+/**
+  * @brief Signal a trigger event, called from the ISRs detecting it
+  * @param source the event
+  * @retval None
+  */
+void capture_trigger(capture_trigger_t source)
+{
+    if (state == capture_armed && source == trigger) {
+        trigger_pos = head;
+        remaining = post_samples;
+        state = capture_triggered;
+    }
+}
+
+/**
+  * @brief Record one scan, called from the ADC ISRs
+  * @param i_out the offset compensated I_out sample
+  * @param v_in the V_in sample
+  * @param v_out the V_out sample
+  * @note The samples have no fractional bits
+  * @retval None
+  */
+void capture_scan(uint32_t i_out, uint32_t v_in, uint32_t v_out)
+{
+    if (state != capture_armed && state != capture_triggered) {
+        return;
+    }
+    /** The thresholds are checked on every scan so that spikes shorter than
+      * a decimated sample still trigger */
+    if (state == capture_armed) {
+        bool enabled = pwrctl_vout_enabled();
+        if (enabled != was_enabled) {
+            capture_trigger(enabled ? capture_trig_enable : capture_trig_disable);
+            was_enabled = enabled;
+        }
+        switch (trigger) {
+            case capture_trig_i_above:
+                if (i_out > trigger_level) {
+                    capture_trigger(trigger);
+                }
+                break;
+            case capture_trig_v_above:
+                if (v_out > trigger_level) {
+                    capture_trigger(trigger);
+                }
+                break;
+            case capture_trig_v_below:
+                if (v_out < trigger_level) {
+                    capture_trigger(trigger);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    sums[s_i_out] += i_out;
+    sums[s_v_in] += v_in;
+    sums[s_v_out] += v_out;
+    if (++scan_count < decimation) {
+        return;
+    }
+    uint16_t *sample = ring[head];
+    sample[s_i_out] = sums[s_i_out] / decimation;
+    sample[s_v_in] = sums[s_v_in] / decimation;
+    sample[s_v_out] = sums[s_v_out] / decimation;
+    sums[s_i_out] = sums[s_v_in] = sums[s_v_out] = 0;
+    scan_count = 0;
+    if (++head == CONFIG_CAPTURE_SAMPLES) {
+        head = 0;
+    }
+    if (filled < CONFIG_CAPTURE_SAMPLES) {
+        filled++;
+    }
+    if (state == capture_triggered && --remaining == 0) {
+        state = capture_done;
+    }
+}
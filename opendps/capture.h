@@ -0,0 +1,109 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __CAPTURE_H__
+#define __CAPTURE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Number of samples in the capture ring, 6 bytes each */
+#ifndef CONFIG_CAPTURE_SAMPLES
+ #define CONFIG_CAPTURE_SAMPLES  (256)
+#endif
+
+/** What starts the post-trigger part of a capture */
+typedef enum {
+    capture_trig_none = 0, /** Disarm */
+    capture_trig_immediate,
+    capture_trig_i_above,  /** A single I_out sample above the level (mA) */
+    capture_trig_v_above,  /** A single V_out sample above the level (mV) */
+    capture_trig_v_below,  /** A single V_out sample below the level (mV) */
+    capture_trig_ocp,      /** OCP, OVP or OPP cut power out */
+    capture_trig_enable,   /** Power out was enabled */
+    capture_trig_disable,  /** Power out was disabled, for any reason */
+    capture_trig_max
+} capture_trigger_t;
+
+typedef enum {
+    capture_idle = 0,
+    capture_armed,     /** Recording the pre-trigger history */
+    capture_triggered, /** Recording the post-trigger samples */
+    capture_done,      /** Frozen, ready for download */
+} capture_state_t;
+
+/** A captured sample in mV and mA */
+typedef struct {
+    uint16_t v_out;
+    uint16_t i_out;
+    uint16_t v_in;
+} capture_sample_t;
+
+/**
+  * @brief Arm a capture, discarding any previous capture
+  * @param trigger the trigger, capture_trig_none disarms
+  * @param level the level of the threshold triggers in mA or mV
+  * @param decimation number of scans (at ~21kHz) averaged into each sample
+  * @param pre_samples number of samples to keep from before the trigger
+  * @retval false if the arguments are out of range
+  */
+bool capture_arm(capture_trigger_t trigger, uint32_t level, uint32_t decimation, uint32_t pre_samples);
+
+/**
+  * @brief Get the state of the capture
+  * @param count number of samples captured, valid when done
+  * @param trigger_index index of the first sample recorded after the trigger,
+  *        valid when done
+  * @param decimation number of scans per sample
+  * @retval the state
+  */
+capture_state_t capture_get_state(uint32_t *count, uint32_t *trigger_index, uint32_t *decimation);
+
+/**
+  * @brief Read samples of a finished capture, oldest first
+  * @param offset index of the first sample to read
+  * @param samples the samples are copied here
+  * @param count max number of samples to copy
+  * @retval number of samples copied, 0 if the capture is not done
+  */
+uint32_t capture_read(uint32_t offset, capture_sample_t *samples, uint32_t count);
+
+/**
+  * @brief Record one scan, called from the ADC ISRs
+  * @param i_out the offset compensated I_out sample
+  * @param v_in the V_in sample
+  * @param v_out the V_out sample
+  * @note The samples have no fractional bits
+  * @retval None
+  */
+void capture_scan(uint32_t i_out, uint32_t v_in, uint32_t v_out);
+
+/**
+  * @brief Signal a trigger event, called from the ISRs detecting it
+  * @param source the event
+  * @retval None
+  */
+void capture_trigger(capture_trigger_t source);
+
+#endif // __CAPTURE_H__
@@ -54,67 +54,144 @@
  #define ARG_DELIMITER_STR " "
 #endif
 
+/** Separates the commands of a batch */
+#define BATCH_DELIMITER ';'
+
 /**
-  * @brief Handle command input from the user
+  * @brief Split "<command> <argument 1> ... <argument N>" into argc, argv
+  *        style in one pass, delimiters are replaced by terminators
+  * @param line the command line, modified
+  * @param argv receives pointers to the command and its arguments
+  * @retval argc, 0 for an empty line
+  */
+static uint32_t tokenize(char *line, char *argv[])
+{
+    const char delim = ARG_DELIMITER_STR[0];
+    uint32_t argc = 0;
+    char *p = line;
+    while (*p && argc < MAX_ARGC) {
+        while (*p == delim) {
+            *p++ = 0;
+        }
+        if (!*p) {
+            break;
+        }
+        argv[argc++] = p;
+        while (*p && *p != delim) {
+            p++;
+        }
+    }
+    return argc;
+}
+
+/**
+  * @brief Find a command by binary search
+  * @param cmds array of supported commands, sorted by name (strcmp order)
+  * @param num number of commands in the cmds array
+  * @param name the command name
+  * @retval the command or NULL if not found
+  */
+static const cli_command_t *find_command(const cli_command_t cmds[], uint32_t num, const char *name)
+{
+    uint32_t lo = 0, hi = num;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        int cmp = strcmp(name, cmds[mid].cmd);
+        if (cmp == 0) {
+            return &cmds[mid];
+        } else if (cmp < 0) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+  * @brief Print the help text of all commands
   * @param cmds array of supported commands
   * @param num number of commands in the cmds array
-  * @param line user input to parsr
   * @retval None
   */
-void cli_run(const cli_command_t cmds[], const uint32_t num, char *line)
+static void print_help(const cli_command_t cmds[], const uint32_t num)
+{
+    for (uint32_t i=0; i<num; i++) {
+        if (cmds[i].help) {
+            if (cmds[i].usage) {
+                dbg_printf("%s %s;   %s\n", cmds[i].cmd, cmds[i].usage, cmds[i].help);
+            } else {
+                dbg_printf("%s;   %s\n", cmds[i].cmd, cmds[i].help);
+            }
+        }
+    }
+    dbg_printf("(end commands with semicolon, not enter).\n");
+}
+
+/**
+  * @brief Handle command input from the user
+  * @param cmds array of supported commands, sorted by name (strcmp order)
+  * @param num number of commands in the cmds array
+  * @param line user input to parse, modified
+  * @retval true if the command was found and run
+  */
+bool cli_run(const cli_command_t cmds[], const uint32_t num, char *line)
 {
-    bool found_cmd = false;
-    // Split string "<command> <argument 1> <argument 2>  ...  <argument N>"
-    // into argc, argv style
     char *argv[MAX_ARGC];
-    uint32_t argc = 1;
-    char *temp, *rover;
     memset((void*) argv, 0, sizeof(argv));
-    argv[0] = line;
-    rover = line;
-    rover = strstr(line, ARG_DELIMITER_STR);
-    while(argc < MAX_ARGC && (temp = strstr(rover, ARG_DELIMITER_STR))) {
-        temp++;
-        argv[argc++] = temp;
-        *rover = 0;
-        rover = temp+1;
+    uint32_t argc = tokenize(line, argv);
+    if (argc == 0) {
+        return true;
     }
 
-    for (uint32_t i=0; i<num; i++) {
-        if (cmds[i].cmd && strcmp(argv[0], cmds[i].cmd) == 0) {
-            if (cmds[i].min_arg > argc-1 || cmds[i].max_arg < argc-1) {
-                dbg_printf("Wrong number of arguments:\n");
-                if (cmds[i].usage) {
-                    dbg_printf("Usage: %s%s%s;\n", cmds[i].cmd, ARG_DELIMITER_STR, cmds[i].usage);
-                }
-            } else {
-                cmds[i].handler(argc, argv);
+    const cli_command_t *cmd = find_command(cmds, num, argv[0]);
+    if (cmd) {
+        if (cmd->min_arg > argc-1 || cmd->max_arg < argc-1) {
+            dbg_printf("Wrong number of arguments:\n");
+            if (cmd->usage) {
+                dbg_printf("Usage: %s%s%s;\n", cmd->cmd, ARG_DELIMITER_STR, cmd->usage);
             }
-            found_cmd = true;
+            return false;
         }
+        cmd->handler(argc, argv);
+        return true;
+    } else if (strcmp(argv[0], "help") == 0) {
+        print_help(cmds, num);
+        return true;
     }
+    dbg_printf("Unknown command, try 'help'\n");
+    return false;
+}
 
-    if (!found_cmd) {
-        if (strcmp(argv[0], "help") == 0) {
-            uint32_t max_len = 0;
-            // Make sure command list is nicely padded
-            for (uint32_t i=0; i<num; i++) {
-                if (cmds[i].help && max_len < strlen(cmds[i].cmd)) {
-                    max_len = strlen(cmds[i].cmd);
-                }
-            }
-            for (uint32_t i=0; i<num; i++) {
-                if (cmds[i].help) {
-                    if (cmds[i].usage) {
-                        dbg_printf("%s %s;   %s\n", cmds[i].cmd, cmds[i].usage, cmds[i].help);
-                    } else {
-                        dbg_printf("%s;   %s\n", cmds[i].cmd, cmds[i].help);
-                    }
-                }
+/**
+  * @brief Run several semicolon separated commands, ending the combined
+  *        reply with one status line, "ok" or "error <failed> of <commands>"
+  * @param cmds array of supported commands, sorted by name (strcmp order)
+  * @param num number of commands in the cmds array
+  * @param line the commands, modified
+  * @retval number of commands that failed
+  */
+uint32_t cli_run_batch(const cli_command_t cmds[], const uint32_t num, char *line)
+{
+    uint32_t total = 0, failed = 0;
+    char *p = line;
+    while (p) {
+        char *next = strchr(p, BATCH_DELIMITER);
+        if (next) {
+            *next++ = 0;
+        }
+        if (*p) {
+            total++;
+            if (!cli_run(cmds, num, p)) {
+                failed++;
             }
-            dbg_printf("(end commands with semicolon, not enter).\n");
-        } else {
-            dbg_printf("Unknown command, try 'help'\n");
         }
+        p = next;
+    }
+    if (failed) {
+        dbg_printf("error %u of %u\n", failed, total);
+    } else {
+        dbg_printf("ok\n");
     }
+    return failed;
 }
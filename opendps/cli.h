@@ -38,11 +38,21 @@ typedef struct {
 
 /**
   * @brief Handle command input from the user
-  * @param cmds array of supported commands
+  * @param cmds array of supported commands, sorted by name (strcmp order)
   * @param num number of commands in the cmds array
-  * @param line user input to parsr
-  * @retval None
+  * @param line user input to parse, modified
+  * @retval true if the command was found and run
   */
-void cli_run(const cli_command_t cmds[], const uint32_t num, char *line);
+bool cli_run(const cli_command_t cmds[], const uint32_t num, char *line);
+
+/**
+  * @brief Run several semicolon separated commands, ending the combined
+  *        reply with one status line, "ok" or "error <failed> of <commands>"
+  * @param cmds array of supported commands, sorted by name (strcmp order)
+  * @param num number of commands in the cmds array
+  * @param line the commands, modified
+  * @retval number of commands that failed
+  */
+uint32_t cli_run_batch(const cli_command_t cmds[], const uint32_t num, char *line);
 
 #endif // __CLI_H__
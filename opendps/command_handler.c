@@ -39,15 +39,21 @@ static void stat_cmd(uint32_t argc, char *argv[]);
 static void on_cmd(uint32_t argc, char *argv[]);
 static void off_cmd(uint32_t argc, char *argv[]);
 static void v_cmd(uint32_t argc, char *argv[]);
+static void batch_cmd(uint32_t argc, char *argv[]);
 
 
+/** In batch mode input is not echoed and a whole line of semicolon separated
+  * commands is run at the newline, with one combined reply */
+static bool batch_mode;
+
+/** Sorted by name, cli_run() uses binary search */
 static const cli_command_t commands[] = {
     {
-        .cmd = "on",
-        .handler = &on_cmd,
-        .min_arg = 0, .max_arg = 0,
-        .help = "Power output on",
-        .usage = "",
+        .cmd = "batch",
+        .handler = &batch_cmd,
+        .min_arg = 1, .max_arg = 1,
+        .help = "Run lines of semicolon separated commands at newline",
+        .usage = "<on|off>",
     },
     {
         .cmd = "off",
@@ -56,6 +62,13 @@ static const cli_command_t commands[] = {
         .help = "Power output off",
         .usage = "",
     },
+    {
+        .cmd = "on",
+        .handler = &on_cmd,
+        .min_arg = 0, .max_arg = 0,
+        .help = "Power output on",
+        .usage = "",
+    },
     {
         .cmd = "stat",
         .handler = &stat_cmd,
@@ -75,21 +88,36 @@ static const cli_command_t commands[] = {
 
 void serial_handle_rx_char(char c)
 {
-    static char buffer[80];
+    static char buffer[128];
     static uint32_t i = 0;
     if (i == 0) {
         memset(buffer, 0, sizeof(buffer));
     }
 
-    if (c == '\b' || c == 0x7f) {
+    if (batch_mode) {
+        static bool overflow;
+        if (c == '\r' || c == '\n') {
+            if (overflow) {
+                dbg_printf("error line too long\n");
+            } else if (i) {
+                cli_run_batch(commands, sizeof(commands) / sizeof(cli_command_t), (char*) buffer);
+            }
+            overflow = false;
+            i = 0;
+        } else if (i >= sizeof(buffer) - 1) {
+            overflow = true;
+        } else if (c >= 0x20) {
+            buffer[i++] = c;
+        }
+    } else if (c == '\b' || c == 0x7f) {
         if (i) {
             dbg_printf("\b \b");
             i--;
         }
     } else if (i >= sizeof(buffer) - 1) {
-        usart_send_blocking(USART1, '\a');
+        hw_uart_tx((uint8_t*) "\a", 1);
     } else if (c == ';') {
-        usart_send_blocking(USART1, '\n');
+        hw_uart_tx((uint8_t*) "\n", 1);
         if (strlen(buffer) > 0) {
             cli_run(commands, sizeof(commands) / sizeof(cli_command_t), (char*) buffer);
         }
@@ -100,7 +128,14 @@ void serial_handle_rx_char(char c)
         // Ignore other control characters
     } else {
         buffer[i++] = c;
-        usart_send_blocking(USART1, c);
+        hw_uart_tx((uint8_t*) &c, 1);
+    }
+}
+
+void serial_handle_rx_buffer(const uint8_t *buf, uint32_t length)
+{
+    for (uint32_t i = 0; i < length; i++) {
+        serial_handle_rx_char((char) buf[i]);
     }
 }
 
@@ -143,3 +178,9 @@ static void v_cmd(uint32_t argc, char *argv[])
     dbg_printf("Setting V_out to %umv\n", v_out);
     pwrctl_set_vout(v_out);
 }
+
+static void batch_cmd(uint32_t argc, char *argv[])
+{
+    (void) argc;
+    batch_mode = strcmp(argv[1], "on") == 0;
+}
@@ -12,6 +12,17 @@
   */
 uint16_t crc16_add(uint16_t crc, uint8_t byte);
 
+/**
+  * @brief Add a block of bytes to crc
+  * @param crc crc calculated so far
+  * @param data pointer to data
+  * @param length length of data
+  * @retval crc after adding the data
+  * @note Initialize with crc=0, crc16_update(0, data, length) equals
+  *       crc16(data, length)
+  */
+uint16_t crc16_update(uint16_t crc, const uint8_t *data, uint32_t length);
+
 /**
   * @brief Calculate 16 bit crc
   * @param data pointer to data
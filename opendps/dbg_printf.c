@@ -22,9 +22,14 @@
  * THE SOFTWARE.
  */
 
-#include <usart.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include "dbg_printf.h"
 #include "mini-printf.h"
+#include "hw.h"
+#ifdef CONFIG_DBG_DEFERRED
+#include <libopencm3/cm3/cortex.h>
+#endif // CONFIG_DBG_DEFERRED
 
 #ifndef CONFIG_DBG_PRINTF_BUFFER_SIZE
  #define CONFIG_DBG_PRINTF_BUFFER_SIZE (80)
@@ -32,6 +37,155 @@
 
 static char buffer[CONFIG_DBG_PRINTF_BUFFER_SIZE];
 
+#ifdef CONFIG_DBG_DEFERRED
+
+#ifndef CONFIG_DBG_DEFERRED_WORDS
+ #define CONFIG_DBG_DEFERRED_WORDS (64)
+#endif // CONFIG_DBG_DEFERRED_WORDS
+
+/** Arguments kept per call, mini-printf takes all of them as 32 bit words */
+#define DBG_MAX_ARGS (6)
+/** Characters of a %s argument kept, including the terminator */
+#define DBG_MAX_STRING (16)
+#define DBG_STRING_WORDS (DBG_MAX_STRING / 4)
+/** Format string pointer, record size and the arguments */
+#define DBG_MAX_RECORD (2 + DBG_MAX_ARGS + DBG_MAX_ARGS * DBG_STRING_WORDS)
+
+/** The calls not yet formatted, each as [fmt] [words] [args] [strings] */
+static uint32_t ring[CONFIG_DBG_DEFERRED_WORDS];
+static uint32_t head; /** Written by dbg_printf() */
+static uint32_t tail; /** Read by dbg_flush() */
+static uint32_t dropped;
+
+/**
+  * @brief Find the conversions of a format string
+  * @param fmt the format string
+  * @param conv receives the conversion character of each argument
+  * @retval number of arguments, at most DBG_MAX_ARGS
+  */
+static uint32_t scan_format(const char *fmt, char *conv)
+{
+    uint32_t count = 0;
+    while (*fmt && count < DBG_MAX_ARGS) {
+        if (*fmt++ != '%') {
+            continue;
+        }
+        while ((*fmt >= '0' && *fmt <= '9') || *fmt == '-' || *fmt == 'l') {
+            fmt++;
+        }
+        if (*fmt == '\0') {
+            break;
+        }
+        if (*fmt != '%') {
+            conv[count++] = *fmt;
+        }
+        fmt++;
+    }
+    return count;
+}
+
+/**
+  * @brief Queue a debug print, formatted later by dbg_flush(). Safe to call
+  *        from interrupt handlers. %s arguments are copied, truncated to
+  *        DBG_MAX_STRING - 1 characters.
+  * @param fmt format string, must stay valid (a literal)
+  * @retval 0, or -1 if the ring was full and the print was dropped
+  */
+int dbg_printf(const char *fmt, ...)
+{
+    uint32_t record[DBG_MAX_RECORD];
+    char conv[DBG_MAX_ARGS];
+    uint32_t count = scan_format(fmt, conv);
+    uint32_t words = 2 + count;
+    va_list va;
+    va_start(va, fmt);
+    record[0] = (uint32_t) fmt;
+    for (uint32_t i = 0; i < count; i++) {
+        record[2 + i] = va_arg(va, uint32_t);
+        if (conv[i] == 's') {
+            const char *str = (const char*) record[2 + i];
+            char *dst = (char*) &record[words];
+            uint32_t j;
+            for (j = 0; j < DBG_MAX_STRING - 1 && str[j]; j++) {
+                dst[j] = str[j];
+            }
+            dst[j] = '\0';
+            words += (j + 4) / 4;
+        }
+    }
+    va_end(va);
+    record[1] = words;
+
+    int ret = 0;
+    uint32_t primask = cm_mask_interrupts(1);
+    if (head - tail + words > CONFIG_DBG_DEFERRED_WORDS) {
+        dropped++;
+        ret = -1;
+    } else {
+        for (uint32_t i = 0; i < words; i++) {
+            ring[head++ % CONFIG_DBG_DEFERRED_WORDS] = record[i];
+        }
+    }
+    cm_mask_interrupts(primask);
+    return ret;
+}
+
+/**
+  * @brief Format and send the oldest queued debug print, called when the
+  *        main loop is idle
+  * @retval true if more prints are queued
+  */
+bool dbg_flush(void)
+{
+    uint32_t record[DBG_MAX_RECORD];
+    uint32_t lost;
+    uint32_t primask = cm_mask_interrupts(1);
+    lost = dropped;
+    dropped = 0;
+    bool empty = head == tail;
+    if (!empty) {
+        uint32_t words = ring[(tail + 1) % CONFIG_DBG_DEFERRED_WORDS];
+        for (uint32_t i = 0; i < words; i++) {
+            record[i] = ring[tail++ % CONFIG_DBG_DEFERRED_WORDS];
+        }
+    }
+    cm_mask_interrupts(primask);
+
+    int size;
+    if (lost) {
+        size = mini_snprintf(buffer, CONFIG_DBG_PRINTF_BUFFER_SIZE, "[%u debug prints dropped]\n", lost);
+        hw_uart_tx((uint8_t*) buffer, size);
+    }
+    if (empty) {
+        return false;
+    }
+
+    char conv[DBG_MAX_ARGS];
+    const char *fmt = (const char*) record[0];
+    uint32_t count = scan_format(fmt, conv);
+    uint32_t strings = 2 + count;
+    uint32_t a[DBG_MAX_ARGS] = {0};
+    for (uint32_t i = 0; i < count; i++) {
+        a[i] = record[2 + i];
+        if (conv[i] == 's') {
+            char *str = (char*) &record[strings];
+            a[i] = (uint32_t) str;
+            uint32_t j = 0;
+            while (str[j]) {
+                j++;
+            }
+            strings += (j + 4) / 4;
+        }
+    }
+    size = mini_snprintf(buffer, CONFIG_DBG_PRINTF_BUFFER_SIZE, fmt, a[0], a[1], a[2], a[3], a[4], a[5]);
+    if (size > 0) {
+        hw_uart_tx((uint8_t*) buffer, size);
+    }
+    return head != tail;
+}
+
+#else // CONFIG_DBG_DEFERRED
+
 int dbg_printf(const char *fmt, ...)
 {
     int size;
@@ -39,8 +193,10 @@ int dbg_printf(const char *fmt, ...)
     va_start(va, fmt);
     size = mini_vsnprintf(buffer, CONFIG_DBG_PRINTF_BUFFER_SIZE, fmt, va);
     va_end(va);
-    for (int i = 0; i < size; i++) {
-        usart_send_blocking(USART1, buffer[i]);
+    if (size > 0) {
+        hw_uart_tx((uint8_t*) buffer, size);
     }
     return size;
 }
+
+#endif // CONFIG_DBG_DEFERRED
@@ -35,6 +35,13 @@
 #else // DPS_EMULATOR
  int dbg_printf(const char *fmt, ...);
  #define emu_printf(...)
+ #ifdef CONFIG_DBG_DEFERRED
+  #include <stdbool.h>
+  /** With CONFIG_DBG_DEFERRED dbg_printf() only queues the format string and
+    * its arguments, this formats and sends one queued print. Returns true if
+    * more are queued. */
+  bool dbg_flush(void);
+ #endif // CONFIG_DBG_DEFERRED
 #endif // DPS_EMULATOR
 
 #endif // __DBG_PRINTF_H__
@@ -41,27 +41,53 @@
  *
  * */
 
+/** Convert a compile time constant to Q16.16 */
+#define Q16(x)  ((int32_t) ((x) * 65536.0 + ((x) < 0 ? -0.5 : 0.5)))
+
+/*
+ * One descriptor per model:
+ *
+ * ADC_CHA_IOUT_GOLDEN_VALUE  ADC reading of I_out at 0mA
+ * MODEL_{A,V}_{ADC,DAC}_{K,C}  calibration coefficients in Q16.16, the
+ *                            floating point arithmetic is folded by the
+ *                            compiler
+ * MODEL_PWR_PORT/PIN         power out control, active low
+ * MODEL_FAN_PORT/PIN         fan control, active high, models without a fan
+ *                            leave these undefined
+ */
+
 /** Contribution by @cleverfox */
 #if defined(DPS5015)
  #define ADC_CHA_IOUT_GOLDEN_VALUE  (59)
- #define A_ADC_K (double)6.8403
- #define A_ADC_C (double)-394.06
- #define A_DAC_K (double)0.166666
- #define A_DAC_C (double)261.6666
- #define V_ADC_K (double)13.012
- #define V_ADC_C (double)-125.732
- #define V_DAC_K (double)0.072266
- #define V_DAC_C (double)4.444777
+ #define MODEL_A_ADC_K  Q16(6.8403)
+ #define MODEL_A_ADC_C  Q16(-394.06)
+ #define MODEL_A_DAC_K  Q16(0.166666)
+ #define MODEL_A_DAC_C  Q16(261.6666)
+ #define MODEL_V_ADC_K  Q16(13.012)
+ #define MODEL_V_ADC_C  Q16(-125.732)
+ #define MODEL_V_DAC_K  Q16(0.072266)
+ #define MODEL_V_DAC_C  Q16(4.444777)
+ /** The I_limit ADC coefficients are the inverse of the I_out ADC ones */
+ #define MODEL_I_LIMIT_K  Q16(1 / 6.8403)
+ #define MODEL_I_LIMIT_C  Q16(1 - -394.06 / 6.8403)
+ #define MODEL_PWR_PORT  GPIOC
+ #define MODEL_PWR_PIN   GPIO13
+ #define MODEL_FAN_PORT  GPIOB
+ #define MODEL_FAN_PIN   GPIO11
 #elif defined(DPS5005)
  #define ADC_CHA_IOUT_GOLDEN_VALUE  (0x45)
- #define A_ADC_K (double)1.713
- #define A_ADC_C (double)-118.51
- #define A_DAC_K (double)0.652
- #define A_DAC_C (double)288.611
- #define V_DAC_K (double)0.072
- #define V_DAC_C (double)1.85
- #define V_ADC_K (double)13.164
- #define V_ADC_C (double)-100.751
+ #define MODEL_A_ADC_K  Q16(1.713)
+ #define MODEL_A_ADC_C  Q16(-118.51)
+ #define MODEL_A_DAC_K  Q16(0.652)
+ #define MODEL_A_DAC_C  Q16(288.611)
+ #define MODEL_V_DAC_K  Q16(0.072)
+ #define MODEL_V_DAC_C  Q16(1.85)
+ #define MODEL_V_ADC_K  Q16(13.164)
+ #define MODEL_V_ADC_C  Q16(-100.751)
+ #define MODEL_I_LIMIT_K  Q16(1 / 1.713)
+ #define MODEL_I_LIMIT_C  Q16(1 - -118.51 / 1.713)
+ #define MODEL_PWR_PORT  GPIOB
+ #define MODEL_PWR_PIN   GPIO11
 #else
  #error "Please set MODEL to the device you want to build for"
 #endif // MODEL
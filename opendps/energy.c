@@ -0,0 +1,182 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "energy.h"
+#include "hw.h"
+#include "pwrctl.h"
+#include "tick.h"
+#include "softtimer.h"
+#include "past.h"
+#include "pastunits.h"
+#include "dbg_printf.h"
+
+#define MS_PER_HOUR (3600ULL * 1000)
+
+static energy_counters_t counters;
+static uint64_t charge_frac;  /** Q16.16 mA * ms, below one mA * ms */
+static uint64_t energy_frac;  /** Q16.16 uW * ms, below one mW * ms */
+static uint64_t on_time_frac; /** Q16.16 ms, below one ms */
+static softtimer_t energy_timer;
+static past_t *energy_past;
+static uint64_t last_tick;
+static uint32_t last_scans;
+static bool was_enabled;
+
+static void energy_tick(softtimer_t *timer);
+static void integrate(void);
+
+/**
+  * @brief Write the counters to past
+  * @retval None
+  */
+static void store_counters(void)
+{
+    if (energy_past && !past_write_unit(energy_past, past_energy, (void*) &counters, sizeof(counters))) {
+        dbg_printf("Error: past write energy failed!\n");
+    }
+}
+
+/**
+  * @brief Initialize the energy module, restoring the counters from past and
+  *        starting the integration. The counters are written to past when
+  *        power out is disabled.
+  * @param past the past the counters are stored in
+  * @retval None
+  */
+void energy_init(past_t *past)
+{
+    const energy_counters_t *stored;
+    uint32_t length;
+    hw_adc_sums_t sums;
+    energy_past = past;
+    if (past_read_unit(past, past_energy, (const void**) &stored, &length) && length == sizeof(counters)) {
+        memcpy(&counters, stored, sizeof(counters));
+    }
+    hw_get_adc_sums(&sums); /** Drop whatever was summed before we got here */
+    last_scans = sums.scans;
+    last_tick = get_ticks();
+    was_enabled = pwrctl_vout_enabled();
+    softtimer_start(&energy_timer, CONFIG_ENERGY_INTERVAL_MS, CONFIG_ENERGY_INTERVAL_MS, &energy_tick);
+}
+
+/**
+  * @brief Integrate the ADC sums made since the previous call, run every
+  *        CONFIG_ENERGY_INTERVAL_MS. The counters are written to past when
+  *        power out is disabled.
+  * @param timer the energy timer
+  * @retval None
+  */
+static void energy_tick(softtimer_t *timer)
+{
+    (void) timer;
+    integrate();
+    bool enabled = pwrctl_vout_enabled();
+    if (was_enabled && !enabled) {
+        store_counters();
+    }
+    was_enabled = enabled;
+}
+
+/**
+  * @brief Integrate the ADC sums made since the previous call
+  * @retval None
+  */
+static void integrate(void)
+{
+    uint64_t now = get_ticks();
+    uint64_t dt = now - last_tick;
+    hw_adc_sums_t sums;
+    if (dt == 0) {
+        return;
+    }
+    hw_get_adc_sums(&sums);
+    uint32_t scans = sums.scans - last_scans;
+    if (scans == 0) {
+        return; /** Nothing sampled, keep integrating from last_tick */
+    }
+    last_tick = now;
+    last_scans = sums.scans;
+
+    /** The sums are of zero point compensated samples so the slopes of the
+      * linear calibration are all that is needed. Averaging over the scans
+      * before scaling keeps the products well within 64 bits. The
+      * products are Q16.16, whole units move to the counters and the
+      * remainders are carried to the next call. */
+    const pwrctl_calibration_t *cal = pwrctl_get_calibration();
+    uint64_t k_i = cal->i_out_adc.k > 0 ? cal->i_out_adc.k : 0;
+    uint64_t k_v = cal->v_out_adc.k > 0 ? cal->v_out_adc.k : 0;
+    uint64_t acc;
+    acc = charge_frac + (sums.i_out * dt / scans) * k_i;
+    counters.charge += acc >> 16;
+    charge_frac = acc & 0xffff;
+    acc = energy_frac + (sums.power * dt / scans) * ((k_v * k_i) >> 16);
+    counters.energy += (acc >> 16) / 1000;
+    energy_frac = (((acc >> 16) % 1000) << 16) | (acc & 0xffff);
+    acc = on_time_frac + (((uint64_t) sums.count * dt) << 16) / scans;
+    counters.on_time += acc >> 16;
+    on_time_frac = acc & 0xffff;
+}
+
+/**
+  * @brief Integrate up to now and write the counters to past, as part of a
+  *        transaction if one is open
+  * @retval None
+  */
+void energy_save(void)
+{
+    integrate();
+    store_counters();
+    was_enabled = pwrctl_vout_enabled();
+}
+
+/**
+  * @brief Get the accumulated counters
+  * @param charge_uah charge delivered in micro ampere hours
+  * @param energy_mwh energy delivered in milli watt hours
+  * @param on_time_s time power out has been enabled in seconds
+  * @retval None
+  */
+void energy_get(uint32_t *charge_uah, uint32_t *energy_mwh, uint32_t *on_time_s)
+{
+    /** mA * ms / 3600 = uAh, mW * ms / 3600000 = mWh */
+    *charge_uah = (uint32_t) (counters.charge / 3600);
+    *energy_mwh = (uint32_t) (counters.energy / MS_PER_HOUR);
+    *on_time_s = (uint32_t) (counters.on_time / 1000);
+}
+
+/**
+  * @brief Clear the counters, in ram and in past
+  * @retval None
+  */
+void energy_reset(void)
+{
+    memset(&counters, 0, sizeof(counters));
+    charge_frac = energy_frac = on_time_frac = 0;
+    if (energy_past) {
+        (void) past_erase_unit(energy_past, past_energy);
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ENERGY_H__
+#define __ENERGY_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "past.h"
+
+/** How often the ADC sums are collected, on a soft timer */
+#ifndef CONFIG_ENERGY_INTERVAL_MS
+ #define CONFIG_ENERGY_INTERVAL_MS  (100)
+#endif
+
+/** The accumulated counters, in whole units. The fractions are kept in ram
+  * and a 64 bit total of mW * ms lasts for millennia at full power. */
+typedef struct {
+    uint64_t charge;  /** mA * ms */
+    uint64_t energy;  /** mW * ms */
+    uint64_t on_time; /** ms with power out enabled */
+} energy_counters_t;
+
+/**
+  * @brief Initialize the energy module, restoring the counters from past and
+  *        starting the integration. The counters are written to past when
+  *        power out is disabled.
+  * @param past the past the counters are stored in
+  * @retval None
+  */
+void energy_init(past_t *past);
+
+/**
+  * @brief Get the accumulated counters
+  * @param charge_uah charge delivered in micro ampere hours
+  * @param energy_mwh energy delivered in milli watt hours
+  * @param on_time_s time power out has been enabled in seconds
+  * @retval None
+  */
+void energy_get(uint32_t *charge_uah, uint32_t *energy_mwh, uint32_t *on_time_s);
+
+/**
+  * @brief Integrate up to now and write the counters to past, as part of a
+  *        transaction if one is open
+  * @retval None
+  */
+void energy_save(void);
+
+/**
+  * @brief Clear the counters, in ram and in past
+  * @retval None
+  */
+void energy_reset(void);
+
+#endif // __ENERGY_H__
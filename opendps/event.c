@@ -29,10 +29,101 @@
 #include "ringbuf.h"
 #include "event.h"
 
-#define MAX_EVENTS	(64)
+#ifdef DPS_EMULATOR
+ #include <pthread.h>
+#else // DPS_EMULATOR
+ #include <cortex.h>
+#endif // DPS_EMULATOR
 
-static ringbuf_t events;
-static uint8_t buffer[2*MAX_EVENTS];
+/** Events are queued in lanes of different priority, event_get() always
+  * returns the oldest event of the highest priority lane holding any. A burst
+  * of UI or serial events can then not delay the handling of an OCP. */
+typedef enum {
+	lane_safety = 0, /** Protections cutting power out */
+	lane_control,    /** Power out enable and host commands */
+	lane_ui,         /** Buttons and the rotary encoder */
+	lane_bulk,       /** Bytes received one event each */
+	lane_max
+} lane_t;
+
+/** Number of events each lane can hold, one slot of each ring is kept empty */
+#define SAFETY_EVENTS	(4)
+#define CONTROL_EVENTS	(8)
+#define UI_EVENTS	(16)
+#define BULK_EVENTS	(64)
+
+static ringbuf_t lanes[lane_max];
+static uint16_t safety_buffer[SAFETY_EVENTS + 1];
+static uint16_t control_buffer[CONTROL_EVENTS + 1];
+static uint16_t ui_buffer[UI_EVENTS + 1];
+static uint16_t bulk_buffer[BULK_EVENTS + 1];
+
+/** Rotary encoder steps are coalesced here until another UI event is put
+  * or the main loop gets them. The event data is the number of steps. */
+static event_t rot_event;
+static uint8_t rot_steps;
+
+/** The event lanes are single consumer (the main loop) but events are put
+  * from several ISRs and the main loop. Producers are serialized here, as is
+  * the consumer's access to the coalesced rotary steps. */
+#ifdef DPS_EMULATOR
+static pthread_mutex_t producer_mutex = PTHREAD_MUTEX_INITIALIZER;
+ #define PRODUCER_LOCK()    pthread_mutex_lock(&producer_mutex)
+ #define PRODUCER_UNLOCK()  pthread_mutex_unlock(&producer_mutex)
+#else // DPS_EMULATOR
+ #define PRODUCER_LOCK()    uint32_t _primask = cm_mask_interrupts(1)
+ #define PRODUCER_UNLOCK()  cm_mask_interrupts(_primask)
+#endif // DPS_EMULATOR
+
+/**
+  * @brief Get the lane of an event
+  * @param event the event
+  * @retval the lane
+  */
+static lane_t event_lane(event_t event)
+{
+	switch (event) {
+		case event_ocp:
+		case event_ovp:
+		case event_opp:
+		case event_brownout:
+			return lane_safety;
+		case event_button_enable:
+		case event_uart_rx_ready:
+			return lane_control;
+		case event_uart_rx:
+			return lane_bulk;
+		default:
+			return lane_ui;
+	}
+}
+
+/**
+  * @brief Check if an event is a rotary encoder step
+  * @param event the event
+  * @retval true if steps of the event are coalesced
+  */
+static bool is_rotary_step(event_t event)
+{
+	return event == event_rot_left || event == event_rot_right ||
+	       event == event_rot_left_set || event == event_rot_right_set;
+}
+
+/**
+  * @brief Move the coalesced rotary steps to the UI lane, must be called
+  *        with the producer lock held
+  * @retval false if the UI lane is full
+  */
+static bool flush_rotary(void)
+{
+	if (rot_steps) {
+		if (!ringbuf_put(&lanes[lane_ui], (uint16_t) (rot_event << 8 | rot_steps))) {
+			return false;
+		}
+		rot_steps = 0;
+	}
+	return true;
+}
 
 
 /**
@@ -41,39 +132,119 @@ static uint8_t buffer[2*MAX_EVENTS];
   */
 void event_init(void)
 {
-	ringbuf_init(&events, (uint8_t*) buffer, sizeof(buffer));
-	memset(buffer, 0, sizeof(buffer));
+	ringbuf_init(&lanes[lane_safety], (uint8_t*) safety_buffer, sizeof(safety_buffer));
+	ringbuf_init(&lanes[lane_control], (uint8_t*) control_buffer, sizeof(control_buffer));
+	ringbuf_init(&lanes[lane_ui], (uint8_t*) ui_buffer, sizeof(ui_buffer));
+	ringbuf_init(&lanes[lane_bulk], (uint8_t*) bulk_buffer, sizeof(bulk_buffer));
+	rot_steps = 0;
 }
 
 /**
-  * @brief Fetch next event in queue
+  * @brief Fetch next event in queue, protection events first, then power
+  *        enable and host commands, UI events and last received bytes
   * @param event the type of event received or 'event_none' if no events in queue
   * @param data additional event data
   * @retval true if an event was found
   */
 bool event_get(event_t *event, uint8_t *data)
 {
-	bool got_event = true;
-	uint16_t e;
-	if (!ringbuf_get(&events, &e)) {
+	bool got_event = false;
+	uint16_t e = 0;
+	for (uint32_t lane = 0; lane < lane_max && !got_event; lane++) {
+		if (lane == lane_ui) {
+			/** The coalesced steps are newer than anything in the UI lane */
+			PRODUCER_LOCK();
+			got_event = ringbuf_get(&lanes[lane_ui], &e);
+			if (!got_event && rot_steps) {
+				e = (uint16_t) (rot_event << 8 | rot_steps);
+				rot_steps = 0;
+				got_event = true;
+			}
+			PRODUCER_UNLOCK();
+		} else {
+			got_event = ringbuf_get(&lanes[lane], &e);
+		}
+	}
+	if (!got_event) {
 		*event = event_none;
 		*data = 0;
-		got_event = false;
 	} else {
 		*event = e >> 8;
 		*data = e & 0xff;
-
 	}
 	return got_event;
 }
 
 /**
-  * @brief Place event in event fifo
+  * @brief Check if there are events in the queue, without getting any
+  * @retval true if event_get() would find an event
+  */
+bool event_pending(void)
+{
+	for (uint32_t lane = 0; lane < lane_max; lane++) {
+		if (!ringbuf_is_empty(&lanes[lane])) {
+			return true;
+		}
+	}
+	return rot_steps > 0;
+}
+
+/**
+  * @brief Place event in event fifo. Rotary steps in the same direction are
+  *        coalesced into one event until the main loop gets it.
   * @param event event type
-  * @param data additional event data
-  * @retval None
+  * @param data additional event data, the number of steps for rotary steps
+  * @retval false if the event's lane is full
   */
 bool event_put(event_t event, uint8_t data)
 {
-	return ringbuf_put(&events, (uint16_t) (event << 8 | data));
+	bool success = true;
+	lane_t lane = event_lane(event);
+	PRODUCER_LOCK();
+	if (is_rotary_step(event) && rot_steps && rot_event == event && rot_steps + data <= 0xff) {
+		rot_steps += data;
+	} else if (lane == lane_ui) {
+		/** Keep the UI events in order */
+		success = flush_rotary();
+		if (success && is_rotary_step(event)) {
+			rot_event = event;
+			rot_steps = data;
+		} else if (success) {
+			success = ringbuf_put(&lanes[lane], (uint16_t) (event << 8 | data));
+		}
+	} else {
+		success = ringbuf_put(&lanes[lane], (uint16_t) (event << 8 | data));
+	}
+	PRODUCER_UNLOCK();
+	return success;
+}
+
+/**
+  * @brief Place several events of the same type in the event fifo
+  * @param event event type
+  * @param data additional event data, one event per byte
+  * @param count number of events
+  * @retval number of events placed in the fifo
+  */
+uint32_t event_put_bulk(event_t event, const uint8_t *data, uint32_t count)
+{
+	uint16_t e[16];
+	uint32_t total = 0;
+	lane_t lane = event_lane(event);
+	PRODUCER_LOCK();
+	if (lane != lane_ui || flush_rotary()) {
+		while (total < count) {
+			uint32_t n = count - total < 16 ? count - total : 16;
+			for (uint32_t i = 0; i < n; i++) {
+				e[i] = (uint16_t) (event << 8 | data[total + i]);
+			}
+			uint32_t put = ringbuf_put_bulk(&lanes[lane], e, n);
+			total += put;
+			if (put < n) {
+				break; /** Full */
+			}
+		}
+	}
+	PRODUCER_UNLOCK();
+	return total;
 }
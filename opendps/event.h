@@ -31,18 +31,23 @@ typedef enum {
 	event_button_m2,
 	event_button_sel,
 	event_button_enable,
-  event_rot_left,
+  event_rot_left,      /** The data of the rotary steps is the number of steps */
   event_rot_right,
   event_rot_left_set,
   event_rot_right_set,
 	event_rot_press,
 	event_uart_rx,
-	event_ocp
+	event_ocp,
+	event_uart_rx_ready, /** Bytes are waiting in the hw USART RX ring */
+	event_ovp,
+	event_opp,
+	event_brownout       /** V_in or VDD is failing, save state now */
 } event_t;
 
 typedef enum {
 	press_short = 0,
 	press_long,
+	press_repeat, /** Sent repeatedly while the button is held */
 } button_press_t;
 
 
@@ -53,7 +58,8 @@ typedef enum {
 void event_init(void);
 
 /**
-  * @brief Fetch next event in queue
+  * @brief Fetch next event in queue, protection events first, then power
+  *        enable and host commands, UI events and last received bytes
   * @param event the type of event received or 'event_none' if no events in queue
   * @param data additional event data
   * @retval true if an event was found
@@ -61,11 +67,27 @@ void event_init(void);
 bool event_get(event_t *event, uint8_t *data);
 
 /**
-  * @brief Place event in event fifo
+  * @brief Check if there are events in the queue, without getting any
+  * @retval true if event_get() would find an event
+  */
+bool event_pending(void);
+
+/**
+  * @brief Place event in event fifo. Rotary steps in the same direction are
+  *        coalesced into one event until the main loop gets it.
   * @param event event type
-  * @param data additional event data
-  * @retval None
+  * @param data additional event data, the number of steps for rotary steps
+  * @retval false if the event's lane is full
   */
 bool event_put(event_t event, uint8_t data);
 
+/**
+  * @brief Place several events of the same type in the event fifo
+  * @param event event type
+  * @param data additional event data, one event per byte
+  * @param count number of events
+  * @retval number of events placed in the fifo
+  */
+uint32_t event_put_bulk(event_t event, const uint8_t *data, uint32_t count);
+
 #endif // __EVENT_H__
@@ -1,226 +1,108 @@
 #include <stdint.h>
+#include "font.h"
 const uint32_t font_18_height = 15;
 const uint32_t font_18_num_glyphs = 13;
 
+const uint8_t font_18_palette[] = {
+  0x00, 0x00, 0x10, 0x82, 0x21, 0x04, 0x31, 0x86, 0x42, 0x08, 0x52, 0xaa, 0x63, 0x2c, 0x73, 0xae,
+  0x84, 0x30, 0x94, 0xb2, 0xa5, 0x54, 0xb5, 0xd6, 0xc6, 0x58, 0xd6, 0xda, 0xe7, 0x5c, 0xff, 0xff,
+};
+
 const uint8_t font_18_0[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x45, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x08, 0x41, 0xc6, 0x58, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x91, 0x00, 0x00, 0x00, 0x00, 0x73, 0x8e,
-  0xff, 0xff, 0x4a, 0x69, 0x84, 0x30, 0xff, 0xff, 0x31, 0x86, 0x00, 0x00, 0xad, 0x95, 0xd6, 0x9a,
-  0x00, 0x00, 0x18, 0xc3, 0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00, 0xdf, 0x1b, 0xad, 0x75, 0x00, 0x00,
-  0x00, 0x00, 0xef, 0x9d, 0x9d, 0x13, 0x00, 0x00, 0xef, 0x9d, 0x9c, 0xd3, 0x00, 0x00, 0x00, 0x00,
-  0xde, 0xfb, 0xad, 0x95, 0x00, 0x00, 0xff, 0xff, 0x94, 0xb2, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba,
-  0xbd, 0xf7, 0x08, 0x41, 0xff, 0xff, 0x8c, 0x71, 0x00, 0x00, 0x00, 0x00, 0xce, 0x79, 0xc6, 0x38,
-  0x00, 0x00, 0xff, 0xff, 0x94, 0x92, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xbd, 0xf7, 0x00, 0x00,
-  0xf7, 0xbe, 0x94, 0xd2, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xda, 0xad, 0x95, 0x00, 0x00, 0xe7, 0x3c,
-  0xad, 0x55, 0x00, 0x00, 0x00, 0x00, 0xef, 0x7d, 0xa5, 0x34, 0x00, 0x00, 0xb5, 0xb6, 0xce, 0x79,
-  0x00, 0x00, 0x10, 0xa2, 0xff, 0xff, 0x73, 0x8e, 0x00, 0x00, 0x73, 0x8e, 0xff, 0xff, 0x4a, 0x69,
-  0x84, 0x50, 0xff, 0xff, 0x31, 0x86, 0x00, 0x00, 0x08, 0x41, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff,
-  0x8c, 0x71, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x45, 0x18, 0xc3, 0x00, 0x00,
-  0x00, 0x00
+  0x20, 0x12, 0x30, 0x0c, 0x1f, 0x09, 0x10, 0x07, 0x0f, 0x05, 0x08, 0x0f, 0x03, 0x00, 0x0a, 0x0c,
+  0x00, 0x01, 0x0f, 0x06, 0x00, 0x0d, 0x0a, 0x10, 0x0e, 0x0a, 0x00, 0x0e, 0x09, 0x10, 0x0d, 0x0a,
+  0x00, 0x0f, 0x09, 0x10, 0x0d, 0x0b, 0x00, 0x0f, 0x08, 0x10, 0x1c, 0x00, 0x0f, 0x09, 0x10, 0x0d,
+  0x0b, 0x00, 0x0f, 0x09, 0x10, 0x0d, 0x0a, 0x00, 0x0e, 0x0a, 0x10, 0x0e, 0x0a, 0x00, 0x0b, 0x0c,
+  0x00, 0x01, 0x0f, 0x07, 0x00, 0x07, 0x0f, 0x05, 0x08, 0x0f, 0x03, 0x10, 0x0c, 0x1f, 0x08, 0x30,
+  0x02, 0x01, 0x10,
 };
-const uint32_t font_18_0_len = 210;
 
 const uint8_t font_18_1[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0xe7, 0x5c, 0x7b, 0xef,
-  0x10, 0xa2, 0xd6, 0xba, 0xff, 0xff, 0x7b, 0xef, 0xde, 0xfb, 0xe7, 0x5c, 0xff, 0xff, 0x7b, 0xef,
-  0x8c, 0x91, 0x29, 0x45, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x08, 0x41, 0xff, 0xff, 0x7b, 0xef,
-  0x00, 0x00, 0x08, 0x41, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x08, 0x41, 0xff, 0xff, 0x7b, 0xef,
-  0x00, 0x00, 0x08, 0x41, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x08, 0x41, 0xff, 0xff, 0x7b, 0xef,
-  0x00, 0x00, 0x08, 0x41, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x08, 0x41, 0xff, 0xff, 0x7b, 0xef,
-  0x00, 0x00, 0x08, 0x41, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x08, 0x41, 0xff, 0xff, 0x7b, 0xef,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0x40, 0x02, 0x0e, 0x07, 0x01, 0x0d, 0x0f, 0x07, 0x0d, 0x0e, 0x0f, 0x07, 0x09, 0x02, 0x0f, 0x07,
+  0x10, 0x0f, 0x07, 0x10, 0x0f, 0x07, 0x10, 0x0f, 0x07, 0x10, 0x0f, 0x07, 0x10, 0x0f, 0x07, 0x10,
+  0x0f, 0x07, 0x10, 0x0f, 0x07, 0x10, 0x0f, 0x07, 0x10, 0x0f, 0x07, 0x30,
 };
-const uint32_t font_18_1_len = 120;
 
 const uint8_t font_18_2[] = {
-  0x00, 0x00, 0x10, 0xa2, 0x29, 0x65, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x95, 0xff, 0xff,
-  0xff, 0xff, 0xde, 0xfb, 0x73, 0xae, 0x00, 0x00, 0x94, 0xb2, 0x42, 0x48, 0x31, 0xa6, 0xbe, 0x17,
-  0xf7, 0xde, 0x21, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb, 0xff, 0xff, 0x4a, 0x89,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x69, 0xff, 0xff, 0x4a, 0x89, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x7c, 0x0f, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x08, 0x41, 0xe7, 0x3c,
-  0xb5, 0x96, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x71, 0xf7, 0xde, 0x29, 0x65, 0x00, 0x00,
-  0x00, 0x00, 0x39, 0xc7, 0xf7, 0xde, 0x84, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce, 0x79,
-  0xd6, 0xda, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0x5a, 0xcb, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x9c, 0xf3, 0xef, 0x9d, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xc6, 0x38, 0xde, 0xfb, 0x63, 0x2c, 0x63, 0x2c, 0x63, 0x2c, 0x42, 0x08, 0xe7, 0x3c, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9d, 0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00
+  0x00, 0x01, 0x03, 0x20, 0x0a, 0x1f, 0x0d, 0x07, 0x00, 0x09, 0x04, 0x03, 0x0b, 0x0f, 0x02, 0x20,
+  0x05, 0x0f, 0x05, 0x20, 0x05, 0x0f, 0x05, 0x20, 0x08, 0x0f, 0x02, 0x20, 0x0e, 0x0a, 0x20, 0x08,
+  0x0f, 0x03, 0x10, 0x03, 0x0f, 0x08, 0x20, 0x0c, 0x0d, 0x20, 0x04, 0x0f, 0x05, 0x20, 0x09, 0x0e,
+  0x30, 0x0c, 0x0d, 0x26, 0x04, 0x0e, 0x3f, 0x0a, 0x50,
 };
-const uint32_t font_18_2_len = 180;
 
 const uint8_t font_18_3[] = {
-  0x00, 0x00, 0x00, 0x00, 0x21, 0x04, 0x31, 0x86, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xbe, 0x17, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x3a, 0x07, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x6d,
-  0x31, 0xa6, 0x42, 0x08, 0xde, 0xfb, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x8c, 0x71, 0xef, 0x9d, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x73, 0xae, 0xff, 0xff, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38,
-  0xd6, 0xda, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xef, 0xde, 0xfb, 0xef, 0x9d, 0x3a, 0x07,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xe7, 0x3c, 0x31, 0xa6, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0xbd, 0xf7, 0xef, 0x9d, 0x10, 0x82, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x8a, 0xff, 0xff, 0x4a, 0x49, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0xff, 0xff, 0x73, 0xae, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x52, 0xaa, 0xff, 0xff, 0x5a, 0xeb, 0x00, 0x00, 0x7b, 0xef, 0x29, 0x85, 0x4a, 0x49,
-  0xce, 0x59, 0xf7, 0xbe, 0x18, 0xc3, 0x18, 0xc3, 0xde, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xef, 0x9d,
-  0x5a, 0xeb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x45, 0x31, 0x86, 0x08, 0x41, 0x00, 0x00,
-  0x00, 0x00
+  0x10, 0x02, 0x03, 0x30, 0x0b, 0x1f, 0x0e, 0x04, 0x10, 0x06, 0x03, 0x04, 0x0d, 0x0a, 0x40, 0x08,
+  0x0e, 0x40, 0x07, 0x0f, 0x01, 0x30, 0x0c, 0x0d, 0x20, 0x07, 0x0d, 0x0e, 0x04, 0x20, 0x0c, 0x0f,
+  0x0e, 0x03, 0x30, 0x03, 0x0b, 0x0e, 0x01, 0x30, 0x05, 0x0f, 0x04, 0x30, 0x02, 0x0f, 0x07, 0x30,
+  0x05, 0x0f, 0x05, 0x00, 0x07, 0x03, 0x04, 0x0c, 0x0f, 0x11, 0x0d, 0x1f, 0x0e, 0x05, 0x20, 0x02,
+  0x03, 0x20,
 };
-const uint32_t font_18_3_len = 210;
 
 const uint8_t font_18_4[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x4a, 0x69, 0xff, 0xff, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x49,
-  0xef, 0x7d, 0xe7, 0x3c, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xd7, 0x84, 0x50,
-  0xde, 0xfb, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0x29, 0x45, 0xf7, 0xde, 0x18, 0xe3, 0xde, 0xfb,
-  0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0x94, 0xb2, 0xa5, 0x54, 0x00, 0x00, 0xde, 0xfb, 0x8c, 0x51,
-  0x00, 0x00, 0x08, 0x41, 0xef, 0x9d, 0x42, 0x28, 0x00, 0x00, 0xde, 0xfb, 0x8c, 0x51, 0x00, 0x00,
-  0x52, 0xaa, 0xe7, 0x3c, 0x00, 0x00, 0x00, 0x00, 0xde, 0xfb, 0x8c, 0x51, 0x00, 0x00, 0xa5, 0x34,
-  0xce, 0x79, 0x6b, 0x6d, 0x6b, 0x6d, 0xe7, 0x5c, 0xbd, 0xd7, 0x52, 0xaa, 0xa5, 0x54, 0xdf, 0x1b,
-  0xdf, 0x1b, 0xdf, 0x1b, 0xf7, 0xde, 0xef, 0x9d, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xde, 0xfb, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xde, 0xfb, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xde, 0xfb,
-  0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00
+  0x90, 0x05, 0x0f, 0x08, 0x30, 0x0c, 0x0f, 0x08, 0x20, 0x04, 0x1e, 0x08, 0x20, 0x0b, 0x08, 0x0d,
+  0x08, 0x10, 0x02, 0x0f, 0x02, 0x0d, 0x08, 0x10, 0x09, 0x0a, 0x00, 0x0d, 0x08, 0x10, 0x0e, 0x04,
+  0x00, 0x0d, 0x08, 0x00, 0x05, 0x0e, 0x10, 0x0d, 0x08, 0x00, 0x0a, 0x0c, 0x16, 0x0e, 0x0b, 0x05,
+  0x0a, 0x2d, 0x0f, 0x0e, 0x0a, 0x30, 0x0d, 0x08, 0x40, 0x0d, 0x08, 0x40, 0x0d, 0x08, 0x70,
 };
-const uint32_t font_18_4_len = 210;
 
 const uint8_t font_18_5[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x6d,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x38, 0x00, 0x00, 0x73, 0xae, 0xef, 0x7d, 0x52, 0xaa,
-  0x52, 0xaa, 0x42, 0x28, 0x00, 0x00, 0x7c, 0x0f, 0xde, 0xfb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x8c, 0x71, 0xce, 0x99, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9c, 0xf3,
-  0xc6, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xef, 0x7d, 0x94, 0xd2,
-  0x29, 0x65, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0x94, 0xb2, 0xef, 0x7d, 0xef, 0x9d, 0x29, 0x85,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0xef, 0x7d, 0x84, 0x30, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xa5, 0x14, 0xce, 0x79, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x9c, 0xf3, 0xef, 0x9d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x3c, 0xce, 0x79,
-  0x21, 0x24, 0x63, 0x0c, 0x39, 0xc7, 0x9c, 0xf3, 0xff, 0xff, 0x6b, 0x6d, 0x63, 0x4c, 0xff, 0xff,
-  0xff, 0xff, 0xf7, 0xde, 0x94, 0x92, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0x39, 0xc7, 0x10, 0x82,
-  0x00, 0x00, 0x00, 0x00
+  0x60, 0x06, 0x2f, 0x0c, 0x00, 0x07, 0x0e, 0x15, 0x04, 0x00, 0x08, 0x0d, 0x30, 0x08, 0x0c, 0x30,
+  0x09, 0x0b, 0x30, 0x0a, 0x0e, 0x09, 0x03, 0x10, 0x05, 0x09, 0x1e, 0x03, 0x20, 0x02, 0x0e, 0x08,
+  0x30, 0x0a, 0x0c, 0x30, 0x09, 0x0e, 0x30, 0x0e, 0x0c, 0x02, 0x06, 0x03, 0x09, 0x0f, 0x16, 0x2f,
+  0x09, 0x10, 0x02, 0x03, 0x01, 0x10,
 };
-const uint32_t font_18_5_len = 180;
 
 const uint8_t font_18_6[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x21, 0x24, 0x8c, 0x91, 0xde, 0xfb, 0x29, 0x45, 0x00, 0x00, 0x18, 0xc3, 0xde, 0xfb, 0xd6, 0xda,
-  0x63, 0x4c, 0x08, 0x61, 0x00, 0x00, 0xbd, 0xf7, 0xd6, 0xba, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00,
-  0x21, 0x24, 0xff, 0xff, 0x4a, 0x89, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xcf, 0xf7, 0xde,
-  0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x54, 0xef, 0x7d, 0xc6, 0x38, 0xce, 0x79,
-  0x6b, 0x6d, 0x00, 0x00, 0xbe, 0x17, 0xe7, 0x3c, 0x7b, 0xef, 0xc6, 0x58, 0xff, 0xff, 0x42, 0x28,
-  0xd6, 0xba, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0xef, 0x7d, 0x84, 0x30, 0xc6, 0x58, 0xad, 0x95,
-  0x00, 0x00, 0x00, 0x00, 0xbe, 0x17, 0xbe, 0x17, 0xb5, 0xb6, 0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00,
-  0xad, 0x95, 0xd6, 0xda, 0x94, 0xb2, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00, 0xd6, 0x9a, 0xbe, 0x17,
-  0x42, 0x48, 0xff, 0xff, 0x5b, 0x0b, 0x52, 0xca, 0xf7, 0xde, 0x7b, 0xcf, 0x00, 0x00, 0xa5, 0x34,
-  0xff, 0xff, 0xff, 0xff, 0xce, 0x59, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00, 0x21, 0x04, 0x29, 0x65,
-  0x00, 0x00, 0x00, 0x00
+  0x70, 0x02, 0x09, 0x0d, 0x02, 0x00, 0x01, 0x1d, 0x06, 0x01, 0x00, 0x0b, 0x0d, 0x01, 0x10, 0x02,
+  0x0f, 0x05, 0x20, 0x07, 0x0f, 0x30, 0x0a, 0x0e, 0x1c, 0x06, 0x00, 0x0b, 0x0e, 0x07, 0x0c, 0x0f,
+  0x04, 0x0d, 0x0a, 0x10, 0x0e, 0x08, 0x0c, 0x0a, 0x10, 0x3b, 0x10, 0x0a, 0x0d, 0x09, 0x0d, 0x10,
+  0x0c, 0x0b, 0x04, 0x0f, 0x06, 0x05, 0x0f, 0x07, 0x00, 0x0a, 0x1f, 0x0c, 0x01, 0x10, 0x02, 0x03,
+  0x10,
 };
-const uint32_t font_18_6_len = 180;
 
 const uint8_t font_18_7[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x65,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x58, 0x10, 0x82, 0x5a, 0xeb,
-  0x5a, 0xeb, 0x5a, 0xeb, 0x63, 0x4c, 0xf7, 0xde, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0x39, 0xc7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xbe, 0x17, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0xf7, 0xde,
-  0x6b, 0x8d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x6d, 0xf7, 0xde, 0x18, 0xc3,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb5, 0xb6, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xf7, 0xbe, 0x8c, 0x71, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x39, 0xc7, 0xff, 0xff, 0x4a, 0x89, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x6b, 0x6d, 0xff, 0xff, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9c, 0xf3,
-  0xef, 0x9d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xce, 0x99,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xde, 0xfb, 0xb5, 0x96, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00
+  0x60, 0x03, 0x4f, 0x0c, 0x01, 0x25, 0x06, 0x0f, 0x0a, 0x30, 0x06, 0x0f, 0x03, 0x30, 0x0b, 0x0c,
+  0x30, 0x02, 0x0f, 0x07, 0x30, 0x06, 0x0f, 0x01, 0x30, 0x0b, 0x0c, 0x40, 0x0f, 0x08, 0x30, 0x03,
+  0x0f, 0x05, 0x30, 0x06, 0x0f, 0x01, 0x30, 0x09, 0x0e, 0x40, 0x1c, 0x40, 0x0d, 0x0a, 0x90,
 };
-const uint32_t font_18_7_len = 210;
 
 const uint8_t font_18_8[] = {
-  0x00, 0x00, 0x00, 0x00, 0x10, 0xa2, 0x31, 0xa6, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x6b, 0x8d, 0xf7, 0xbe, 0xf7, 0xbe, 0xef, 0x9d, 0x52, 0xaa, 0x00, 0x00, 0x18, 0xe3, 0xf7, 0xde,
-  0x73, 0xae, 0x08, 0x41, 0xb5, 0xd6, 0xef, 0x7d, 0x00, 0x00, 0x4a, 0x69, 0xff, 0xff, 0x29, 0x45,
-  0x00, 0x00, 0x73, 0x8e, 0xff, 0xff, 0x21, 0x24, 0x42, 0x28, 0xff, 0xff, 0x29, 0x85, 0x00, 0x00,
-  0x6b, 0x4d, 0xf7, 0xde, 0x10, 0x82, 0x08, 0x61, 0xf7, 0xde, 0x73, 0x8e, 0x00, 0x00, 0xa5, 0x34,
-  0xce, 0x79, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xef, 0xef, 0x9d, 0x73, 0xae, 0xf7, 0xde, 0x42, 0x28,
-  0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0xf7, 0xbe, 0xff, 0xff, 0xb5, 0xb6, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x20, 0xc6, 0x38, 0xb5, 0x96, 0x5a, 0xeb, 0xf7, 0xde, 0x73, 0xae, 0x00, 0x00, 0x4a, 0x49,
-  0xff, 0xff, 0x21, 0x24, 0x00, 0x00, 0x8c, 0x71, 0xef, 0x9d, 0x08, 0x41, 0x84, 0x30, 0xef, 0x7d,
-  0x00, 0x00, 0x00, 0x00, 0x31, 0xa6, 0xff, 0xff, 0x42, 0x28, 0x8c, 0x91, 0xf7, 0xde, 0x08, 0x61,
-  0x00, 0x00, 0x4a, 0x49, 0xff, 0xff, 0x3a, 0x07, 0x4a, 0x69, 0xff, 0xff, 0x7b, 0xef, 0x10, 0x82,
-  0xad, 0x75, 0xe7, 0x5c, 0x08, 0x61, 0x00, 0x00, 0x8c, 0x91, 0xff, 0xff, 0xf7, 0xde, 0xe7, 0x5c,
-  0x4a, 0x49, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0x31, 0xa6, 0x08, 0x41, 0x00, 0x00,
-  0x00, 0x00
+  0x10, 0x01, 0x03, 0x01, 0x20, 0x07, 0x1f, 0x0e, 0x05, 0x00, 0x02, 0x0f, 0x07, 0x00, 0x0b, 0x0e,
+  0x00, 0x05, 0x0f, 0x02, 0x00, 0x07, 0x0f, 0x02, 0x04, 0x0f, 0x03, 0x00, 0x06, 0x0f, 0x11, 0x0f,
+  0x07, 0x00, 0x0a, 0x0c, 0x10, 0x07, 0x0e, 0x07, 0x0f, 0x04, 0x10, 0x01, 0x1f, 0x0b, 0x20, 0x0c,
+  0x0a, 0x05, 0x0f, 0x07, 0x00, 0x04, 0x0f, 0x02, 0x00, 0x08, 0x0e, 0x00, 0x08, 0x0e, 0x10, 0x03,
+  0x0f, 0x04, 0x09, 0x0f, 0x01, 0x00, 0x04, 0x0f, 0x04, 0x05, 0x0f, 0x07, 0x01, 0x0a, 0x0e, 0x01,
+  0x00, 0x09, 0x1f, 0x0e, 0x04, 0x20, 0x01, 0x03, 0x20,
 };
-const uint32_t font_18_8_len = 210;
 
 const uint8_t font_18_9[] = {
-  0x00, 0x00, 0x00, 0x00, 0x10, 0xa2, 0x31, 0x86, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x6b, 0x8d, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c, 0x29, 0x65, 0x00, 0x00, 0x10, 0x82, 0xf7, 0xbe,
-  0x94, 0xd2, 0x18, 0xe3, 0xd6, 0xba, 0xb5, 0xb6, 0x00, 0x00, 0x52, 0x8a, 0xff, 0xff, 0x42, 0x28,
-  0x00, 0x00, 0x73, 0xce, 0xf7, 0xbe, 0x08, 0x41, 0x6b, 0x4d, 0xff, 0xff, 0x21, 0x24, 0x00, 0x00,
-  0x52, 0xaa, 0xff, 0xff, 0x21, 0x24, 0x5a, 0xcb, 0xff, 0xff, 0x29, 0x65, 0x00, 0x00, 0x42, 0x28,
-  0xff, 0xff, 0x39, 0xc7, 0x18, 0xe3, 0xff, 0xff, 0x5a, 0xeb, 0x00, 0x00, 0x42, 0x08, 0xff, 0xff,
-  0x42, 0x28, 0x00, 0x00, 0xd6, 0xda, 0xdf, 0x1b, 0x6b, 0x4d, 0x9d, 0x13, 0xff, 0xff, 0x31, 0xa6,
-  0x00, 0x00, 0x39, 0xc7, 0xd6, 0xba, 0xef, 0x9d, 0xdf, 0x1b, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x94, 0xb2, 0xef, 0x7d, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xd6, 0xda, 0x9c, 0xf3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x73, 0xce, 0xf7, 0xde, 0x39, 0xe7, 0x00, 0x00, 0x00, 0x00, 0x52, 0xca, 0xad, 0x75, 0xff, 0xff,
-  0x6b, 0x6d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xad, 0x55, 0x52, 0xaa, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00
+  0x10, 0x01, 0x03, 0x30, 0x07, 0x1f, 0x0e, 0x03, 0x00, 0x01, 0x0f, 0x09, 0x02, 0x0d, 0x0b, 0x00,
+  0x05, 0x0f, 0x04, 0x00, 0x07, 0x0f, 0x00, 0x06, 0x0f, 0x02, 0x00, 0x05, 0x0f, 0x02, 0x05, 0x0f,
+  0x03, 0x00, 0x04, 0x0f, 0x03, 0x02, 0x0f, 0x05, 0x00, 0x04, 0x0f, 0x04, 0x00, 0x1d, 0x06, 0x0a,
+  0x0f, 0x03, 0x00, 0x03, 0x0d, 0x0e, 0x0d, 0x0f, 0x02, 0x30, 0x09, 0x0e, 0x40, 0x0d, 0x09, 0x30,
+  0x07, 0x0f, 0x04, 0x10, 0x05, 0x0a, 0x0f, 0x06, 0x20, 0x0c, 0x0a, 0x05, 0x90,
 };
-const uint32_t font_18_9_len = 210;
 
 const uint8_t font_18_dot[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x8c, 0x91, 0xb5, 0xb6, 0xce, 0x99, 0xef, 0x9d, 0x08, 0x41, 0x10, 0xa2
+  0xf0, 0x70, 0x09, 0x0b, 0x0c, 0x0e, 0x00, 0x01,
 };
-const uint32_t font_18_dot_len = 60;
 
 const uint8_t font_18_v[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x84, 0x30, 0xff, 0xff, 0x21, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x21, 0x04, 0xff, 0xff, 0x7b, 0xcf, 0x00, 0x00, 0x52, 0xaa, 0xff, 0xff, 0x4a, 0x69, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x4a, 0x69, 0xff, 0xff, 0x42, 0x28, 0x00, 0x00, 0x21, 0x04, 0xff, 0xff,
-  0x7b, 0xcf, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xcf, 0xff, 0xff, 0x10, 0x82, 0x00, 0x00,
-  0x00, 0x00, 0xe7, 0x5c, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xde, 0xfb,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x95, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xdf, 0x1b, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xae, 0xff, 0xff, 0x18, 0xc3,
-  0x00, 0x00, 0x18, 0xc3, 0xff, 0xff, 0x63, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0xa6,
-  0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x52, 0xaa, 0xff, 0xff, 0x29, 0x45, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x20, 0xef, 0x9d, 0x94, 0xb2, 0x00, 0x00, 0x94, 0xb2, 0xe7, 0x3c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xce, 0x99, 0x00, 0x00, 0xce, 0x99,
-  0x9d, 0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x4d, 0xff, 0xff,
-  0x29, 0x65, 0xff, 0xff, 0x5a, 0xeb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x21, 0x24, 0xff, 0xff, 0xb5, 0x96, 0xf7, 0xde, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xff, 0xff, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x51, 0xff, 0xff, 0x7b, 0xef,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0x90, 0x08, 0x0f, 0x02, 0x20, 0x02, 0x0f, 0x07, 0x00, 0x05, 0x0f, 0x05, 0x20, 0x05, 0x0f, 0x04,
+  0x00, 0x02, 0x0f, 0x07, 0x20, 0x07, 0x0f, 0x01, 0x10, 0x0e, 0x0a, 0x20, 0x0a, 0x0d, 0x20, 0x0a,
+  0x0d, 0x20, 0x0d, 0x0a, 0x20, 0x07, 0x0f, 0x01, 0x00, 0x01, 0x0f, 0x06, 0x20, 0x03, 0x0f, 0x05,
+  0x00, 0x05, 0x0f, 0x02, 0x30, 0x0e, 0x09, 0x00, 0x09, 0x0e, 0x40, 0x0a, 0x0c, 0x00, 0x0c, 0x0a,
+  0x40, 0x06, 0x0f, 0x03, 0x0f, 0x05, 0x40, 0x02, 0x0f, 0x0a, 0x0f, 0x01, 0x50, 0x0d, 0x0f, 0x0c,
+  0x30, 0x01, 0x10, 0x08, 0x0f, 0x07, 0xd0,
 };
-const uint32_t font_18_v_len = 300;
 
 const uint8_t font_18_a[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xae, 0xff, 0xff, 0x84, 0x30, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbe, 0x17, 0xff, 0xff, 0xce, 0x79,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x82, 0xf7, 0xde, 0xad, 0x55,
-  0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xde,
-  0x21, 0x24, 0xf7, 0xde, 0x63, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9c, 0xd3,
-  0xc6, 0x58, 0x00, 0x00, 0xce, 0x59, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xdf, 0x1b, 0x84, 0x50, 0x00, 0x00, 0x8c, 0x51, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x21, 0x24, 0xff, 0xff, 0x4a, 0x49, 0x00, 0x00, 0x4a, 0x69, 0xff, 0xff, 0x31, 0x86, 0x00, 0x00,
-  0x00, 0x00, 0x63, 0x0c, 0xf7, 0xde, 0x08, 0x61, 0x00, 0x00, 0x10, 0x82, 0xf7, 0xde, 0x6b, 0x8d,
-  0x00, 0x00, 0x00, 0x00, 0x9d, 0x13, 0xef, 0x9d, 0xa5, 0x34, 0xa5, 0x34, 0xa5, 0x34, 0xf7, 0xbe,
-  0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0xde, 0xfb, 0xde, 0xfb, 0xbd, 0xd7, 0xbd, 0xd7, 0xbd, 0xd7,
-  0xde, 0xfb, 0xe7, 0x5c, 0x00, 0x00, 0x18, 0xc3, 0xff, 0xff, 0x63, 0x0c, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0x21, 0x24, 0x4a, 0x69, 0xff, 0xff, 0x31, 0x86, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x31, 0x86, 0xff, 0xff, 0x5a, 0xcb, 0x84, 0x30, 0xf7, 0xde, 0x00, 0x20,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xf7, 0xde, 0x94, 0x92, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0xb0, 0x07, 0x0f, 0x08, 0x50, 0x0b, 0x0f, 0x0c, 0x40, 0x01, 0x0f, 0x0a, 0x0f, 0x02, 0x30, 0x05,
+  0x0f, 0x02, 0x0f, 0x06, 0x30, 0x09, 0x0c, 0x00, 0x0c, 0x0a, 0x30, 0x0d, 0x08, 0x00, 0x08, 0x0e,
+  0x20, 0x02, 0x0f, 0x04, 0x00, 0x05, 0x0f, 0x03, 0x10, 0x06, 0x0f, 0x01, 0x00, 0x01, 0x0f, 0x07,
+  0x10, 0x0a, 0x0e, 0x2a, 0x0f, 0x0a, 0x10, 0x1d, 0x2b, 0x0d, 0x0e, 0x00, 0x01, 0x0f, 0x06, 0x20,
+  0x06, 0x0f, 0x02, 0x05, 0x0f, 0x03, 0x20, 0x03, 0x0f, 0x05, 0x08, 0x0f, 0x40, 0x0f, 0x09, 0x80,
 };
-const uint32_t font_18_a_len = 270;
 
 const uint8_t font_18_widths[13] = {
   7, 
@@ -239,34 +121,69 @@ const uint8_t font_18_widths[13] = {
  };
 
 const uint16_t font_18_sizes[13] = {
-  210, 
-  120, 
-  180, 
-  210, 
-  210, 
-  180, 
-  180, 
-  210, 
-  210, 
-  210, 
-  60, 
-  300, 
-  270, 
+  83, 
+  44, 
+  57, 
+  66, 
+  63, 
+  54, 
+  65, 
+  47, 
+  89, 
+  77, 
+  8, 
+  87, 
+  80, 
  };
 
-const uint16_t *font_18_pix[13] = {
-  (uint16_t*) &font_18_0, 
-  (uint16_t*) &font_18_1, 
-  (uint16_t*) &font_18_2, 
-  (uint16_t*) &font_18_3, 
-  (uint16_t*) &font_18_4, 
-  (uint16_t*) &font_18_5, 
-  (uint16_t*) &font_18_6, 
-  (uint16_t*) &font_18_7, 
-  (uint16_t*) &font_18_8, 
-  (uint16_t*) &font_18_9, 
-  (uint16_t*) &font_18_dot, 
-  (uint16_t*) &font_18_v, 
-  (uint16_t*) &font_18_a, 
+const uint8_t *font_18_pix[13] = {
+  font_18_0, 
+  font_18_1, 
+  font_18_2, 
+  font_18_3, 
+  font_18_4, 
+  font_18_5, 
+  font_18_6, 
+  font_18_7, 
+  font_18_8, 
+  font_18_9, 
+  font_18_dot, 
+  font_18_v, 
+  font_18_a, 
  };
 
+const uint8_t font_18_index[] = {
+  0x0a, 0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0x0c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0b,
+};
+
+const uint8_t font_18_advances[13] = {
+  8, 
+  5, 
+  7, 
+  8, 
+  8, 
+  7, 
+  7, 
+  8, 
+  8, 
+  8, 
+  3, 
+  11, 
+  10, 
+ };
+
+const font_t font_18 = {
+  .size = 18,
+  .height = 15,
+  .max_width = 10,
+  .digit_width = 7,
+  .first_code = 46,
+  .num_codes = 41,
+  .index = font_18_index,
+  .widths = font_18_widths,
+  .advances = font_18_advances,
+  .pix = font_18_pix,
+  .palette = font_18_palette,
+};
@@ -1,31 +1,23 @@
+#include "font.h"
 extern const uint32_t font_18_height;
 extern const uint32_t font_18_num_glyphs;
+extern const uint8_t font_18_palette[];
 extern const uint8_t font_18_0[];
-extern const uint32_t font_18_0_len;
 extern const uint8_t font_18_1[];
-extern const uint32_t font_18_1_len;
 extern const uint8_t font_18_2[];
-extern const uint32_t font_18_2_len;
 extern const uint8_t font_18_3[];
-extern const uint32_t font_18_3_len;
 extern const uint8_t font_18_4[];
-extern const uint32_t font_18_4_len;
 extern const uint8_t font_18_5[];
-extern const uint32_t font_18_5_len;
 extern const uint8_t font_18_6[];
-extern const uint32_t font_18_6_len;
 extern const uint8_t font_18_7[];
-extern const uint32_t font_18_7_len;
 extern const uint8_t font_18_8[];
-extern const uint32_t font_18_8_len;
 extern const uint8_t font_18_9[];
-extern const uint32_t font_18_9_len;
 extern const uint8_t font_18_dot[];
-extern const uint32_t font_18_dot_len;
 extern const uint8_t font_18_v[];
-extern const uint32_t font_18_v_len;
 extern const uint8_t font_18_a[];
-extern const uint32_t font_18_a_len;
 extern const uint8_t font_18_widths[13];
 extern const uint16_t font_18_sizes[13];
-extern const uint16_t *font_18_pix[13];
+extern const uint8_t *font_18_pix[13];
+extern const uint8_t font_18_index[];
+extern const uint8_t font_18_advances[13];
+extern const font_t font_18;
@@ -1,303 +1,128 @@
 #include <stdint.h>
+#include "font.h"
 const uint32_t font_24_height = 17;
 const uint32_t font_24_num_glyphs = 13;
 
+const uint8_t font_24_palette[] = {
+  0x00, 0x00, 0x10, 0x82, 0x21, 0x04, 0x31, 0x86, 0x42, 0x08, 0x52, 0xaa, 0x63, 0x2c, 0x73, 0xae,
+  0x84, 0x30, 0x94, 0xb2, 0xa5, 0x54, 0xb5, 0xd6, 0xc6, 0x58, 0xd6, 0xda, 0xe7, 0x5c, 0xff, 0xff,
+};
+
 const uint8_t font_24_0[] = {
-  0x00, 0x00, 0x00, 0x20, 0x8c, 0x91, 0xe7, 0x5c, 0xef, 0x9d, 0xb5, 0xd6, 0x21, 0x24, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x94, 0xd2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xde, 0xfb,
-  0x08, 0x41, 0x00, 0x00, 0x10, 0xa2, 0xf7, 0xde, 0xf7, 0xde, 0x42, 0x28, 0x18, 0xc3, 0xd6, 0xda,
-  0xff, 0xff, 0x63, 0x0c, 0x00, 0x00, 0x52, 0xaa, 0xff, 0xff, 0xc6, 0x38, 0x00, 0x00, 0x00, 0x00,
-  0x73, 0xae, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x84, 0x10, 0xff, 0xff, 0x94, 0xb2, 0x00, 0x00,
-  0x00, 0x00, 0x42, 0x48, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00, 0x9c, 0xf3, 0xff, 0xff, 0x7b, 0xef,
-  0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0xff, 0xff, 0xef, 0x9d, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff,
-  0x6b, 0x6d, 0x00, 0x00, 0x00, 0x00, 0x21, 0x04, 0xff, 0xff, 0xff, 0xff, 0x00, 0x20, 0xb5, 0xb6,
-  0xff, 0xff, 0x6b, 0x4d, 0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0xff, 0xff, 0xff, 0xff, 0x08, 0x61,
-  0xbd, 0xd7, 0xff, 0xff, 0x63, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0xff, 0xff, 0xff, 0xff,
-  0x10, 0x82, 0xb5, 0xb6, 0xff, 0xff, 0x6b, 0x4d, 0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0xff, 0xff,
-  0xff, 0xff, 0x08, 0x61, 0xad, 0x75, 0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00, 0x00, 0x00, 0x21, 0x04,
-  0xff, 0xff, 0xff, 0xff, 0x00, 0x20, 0x9c, 0xf3, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00,
-  0x29, 0x65, 0xff, 0xff, 0xef, 0x9d, 0x00, 0x00, 0x84, 0x30, 0xff, 0xff, 0x94, 0xb2, 0x00, 0x00,
-  0x00, 0x00, 0x42, 0x48, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00, 0x52, 0xaa, 0xff, 0xff, 0xc6, 0x38,
-  0x00, 0x00, 0x00, 0x00, 0x73, 0xae, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x10, 0xa2, 0xf7, 0xde,
-  0xf7, 0xde, 0x42, 0x28, 0x18, 0xc3, 0xd6, 0xda, 0xff, 0xff, 0x63, 0x0c, 0x00, 0x00, 0x00, 0x00,
-  0x94, 0xd2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xde, 0xfb, 0x08, 0x41, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x20, 0x8c, 0x91, 0xe7, 0x5c, 0xef, 0x9d, 0xb5, 0xd6, 0x21, 0x24, 0x00, 0x00,
-  0x00, 0x00
+  0x10, 0x09, 0x1e, 0x0b, 0x02, 0x20, 0x09, 0x3f, 0x0d, 0x10, 0x01, 0x1f, 0x04, 0x01, 0x0d, 0x0f,
+  0x06, 0x00, 0x05, 0x0f, 0x0c, 0x10, 0x07, 0x0f, 0x0a, 0x00, 0x08, 0x0f, 0x09, 0x10, 0x04, 0x0f,
+  0x0d, 0x00, 0x09, 0x0f, 0x07, 0x10, 0x03, 0x0f, 0x0e, 0x00, 0x0a, 0x0f, 0x06, 0x10, 0x02, 0x1f,
+  0x00, 0x0b, 0x0f, 0x06, 0x10, 0x01, 0x1f, 0x01, 0x0b, 0x0f, 0x06, 0x10, 0x01, 0x1f, 0x01, 0x0b,
+  0x0f, 0x06, 0x10, 0x01, 0x1f, 0x01, 0x0a, 0x0f, 0x06, 0x10, 0x02, 0x1f, 0x00, 0x09, 0x0f, 0x07,
+  0x10, 0x03, 0x0f, 0x0e, 0x00, 0x08, 0x0f, 0x09, 0x10, 0x04, 0x0f, 0x0d, 0x00, 0x05, 0x0f, 0x0c,
+  0x10, 0x07, 0x0f, 0x0a, 0x00, 0x01, 0x1f, 0x04, 0x01, 0x0d, 0x0f, 0x06, 0x10, 0x09, 0x3f, 0x0d,
+  0x30, 0x09, 0x1e, 0x0b, 0x02, 0x10,
 };
-const uint32_t font_24_0_len = 306;
 
 const uint8_t font_24_1[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0xe7, 0xf7, 0xde, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00,
-  0x18, 0xe3, 0xe7, 0x3c, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x21, 0x24, 0xde, 0xfb, 0xff, 0xff,
-  0xff, 0xff, 0xa5, 0x54, 0x18, 0xe3, 0xef, 0x9d, 0xf7, 0xde, 0xb5, 0xb6, 0xff, 0xff, 0xa5, 0x54,
-  0x00, 0x00, 0xa5, 0x54, 0x42, 0x48, 0x63, 0x0c, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x0c,
-  0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0xa5, 0x54,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x0c,
-  0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0xa5, 0x54,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x0c,
-  0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0xa5, 0x54,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0xa5, 0x54
+  0x20, 0x04, 0x0f, 0x0a, 0x10, 0x02, 0x0e, 0x0f, 0x0a, 0x00, 0x02, 0x0d, 0x1f, 0x0a, 0x02, 0x0e,
+  0x0f, 0x0b, 0x0f, 0x0a, 0x00, 0x0a, 0x04, 0x06, 0x0f, 0x0a, 0x20, 0x06, 0x0f, 0x0a, 0x20, 0x06,
+  0x0f, 0x0a, 0x20, 0x06, 0x0f, 0x0a, 0x20, 0x06, 0x0f, 0x0a, 0x20, 0x06, 0x0f, 0x0a, 0x20, 0x06,
+  0x0f, 0x0a, 0x20, 0x06, 0x0f, 0x0a, 0x20, 0x06, 0x0f, 0x0a, 0x20, 0x06, 0x0f, 0x0a, 0x20, 0x06,
+  0x0f, 0x0a, 0x20, 0x06, 0x0f, 0x0a, 0x20, 0x06, 0x0f, 0x0a,
 };
-const uint32_t font_24_1_len = 204;
 
 const uint8_t font_24_2[] = {
-  0x10, 0x82, 0x8c, 0x71, 0xde, 0xfb, 0xf7, 0xbe, 0xdf, 0x1b, 0x94, 0xd2, 0x10, 0x82, 0x00, 0x00,
-  0xb5, 0xb6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xce, 0x79, 0x00, 0x00,
-  0x3a, 0x07, 0xad, 0x55, 0x21, 0x24, 0x08, 0x41, 0x52, 0xaa, 0xf7, 0xde, 0xff, 0xff, 0x42, 0x48,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xf7, 0xff, 0xff, 0x73, 0xae,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x54, 0xff, 0xff, 0x73, 0xce,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0x52, 0x8a,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x24, 0xf7, 0xde, 0xe7, 0x5c, 0x08, 0x41,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x55, 0xff, 0xff, 0x7b, 0xcf, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x69, 0xff, 0xff, 0xd6, 0xba, 0x08, 0x41, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x10, 0xa2, 0xe7, 0x5c, 0xf7, 0xde, 0x39, 0xc7, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0x84, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x42, 0x08, 0xff, 0xff, 0xde, 0xfb, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xb5, 0x96, 0xff, 0xff, 0x63, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x18, 0xe3, 0xf7, 0xde, 0xe7, 0x5c, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x5a, 0xeb, 0xff, 0xff, 0xb5, 0x96, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x7c, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xda,
-  0x8c, 0x71, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xda
+  0x01, 0x08, 0x0d, 0x0f, 0x0d, 0x09, 0x01, 0x00, 0x0b, 0x4f, 0x0c, 0x00, 0x04, 0x0a, 0x02, 0x00,
+  0x05, 0x1f, 0x04, 0x40, 0x0b, 0x0f, 0x07, 0x40, 0x0a, 0x0f, 0x07, 0x40, 0x0c, 0x0f, 0x05, 0x30,
+  0x02, 0x0f, 0x0e, 0x40, 0x0a, 0x0f, 0x07, 0x30, 0x05, 0x0f, 0x0d, 0x30, 0x01, 0x0e, 0x0f, 0x03,
+  0x30, 0x0a, 0x0f, 0x08, 0x30, 0x04, 0x0f, 0x0d, 0x40, 0x0a, 0x0f, 0x06, 0x30, 0x02, 0x0f, 0x0e,
+  0x40, 0x05, 0x0f, 0x0a, 0x40, 0x08, 0x5f, 0x0d, 0x08, 0x5f, 0x0d,
 };
-const uint32_t font_24_2_len = 272;
 
 const uint8_t font_24_3[] = {
-  0x21, 0x04, 0x9c, 0xf3, 0xe7, 0x3c, 0xf7, 0xbe, 0xd6, 0xba, 0x63, 0x4c, 0x00, 0x00, 0x00, 0x00,
-  0x9d, 0x13, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x8d, 0x00, 0x00,
-  0x29, 0x65, 0x7c, 0x0f, 0x21, 0x04, 0x08, 0x61, 0x8c, 0x71, 0xff, 0xff, 0xef, 0x7d, 0x00, 0x20,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xef, 0x7d, 0xff, 0xff, 0x29, 0x65,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xda, 0xff, 0xff, 0x31, 0x86,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0xa2, 0xf7, 0xde, 0xf7, 0xbe, 0x08, 0x61,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x31, 0x86, 0xbe, 0x17, 0xff, 0xff, 0x94, 0xd2, 0x00, 0x00,
-  0x00, 0x00, 0x29, 0x65, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x54, 0x08, 0x41, 0x00, 0x00,
-  0x00, 0x00, 0x29, 0x65, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x1b, 0x42, 0x08, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x21, 0x24, 0x94, 0xb2, 0xff, 0xff, 0xef, 0x9d, 0x18, 0xc3,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xf7, 0xff, 0xff, 0x73, 0x8e,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xcf, 0xff, 0xff, 0x9c, 0xf3,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xae, 0xff, 0xff, 0xa5, 0x34,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x54, 0xff, 0xff, 0x84, 0x50,
-  0x63, 0x2c, 0x52, 0xca, 0x10, 0xa2, 0x10, 0x82, 0x6b, 0x6d, 0xf7, 0xde, 0xff, 0xff, 0x3a, 0x07,
-  0xce, 0x99, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xad, 0x55, 0x00, 0x00,
-  0x42, 0x28, 0xb5, 0xb6, 0xef, 0x7d, 0xf7, 0xbe, 0xd6, 0xba, 0x7b, 0xef, 0x00, 0x20, 0x00, 0x00
+  0x02, 0x09, 0x0e, 0x0f, 0x0d, 0x06, 0x10, 0x0a, 0x4f, 0x07, 0x00, 0x03, 0x08, 0x02, 0x01, 0x08,
+  0x0f, 0x0e, 0x50, 0x0e, 0x0f, 0x03, 0x40, 0x0d, 0x0f, 0x03, 0x30, 0x01, 0x1f, 0x01, 0x20, 0x03,
+  0x0b, 0x0f, 0x09, 0x10, 0x03, 0x2f, 0x0a, 0x20, 0x03, 0x2f, 0x0d, 0x04, 0x30, 0x02, 0x09, 0x0f,
+  0x0e, 0x01, 0x40, 0x0b, 0x0f, 0x07, 0x40, 0x07, 0x0f, 0x09, 0x40, 0x07, 0x0f, 0x0a, 0x40, 0x0a,
+  0x0f, 0x08, 0x06, 0x05, 0x11, 0x06, 0x1f, 0x04, 0x0c, 0x4f, 0x0a, 0x00, 0x04, 0x0b, 0x0e, 0x0f,
+  0x0d, 0x07, 0x10,
 };
-const uint32_t font_24_3_len = 272;
 
 const uint8_t font_24_4[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x8a, 0xff, 0xff, 0xff, 0xff, 0x08, 0x61,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xff, 0xff, 0xff, 0xff,
-  0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb, 0xff, 0xff, 0xf7, 0xde,
-  0xff, 0xff, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xda, 0xce, 0x79,
-  0xce, 0x99, 0xff, 0xff, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0xff, 0xff,
-  0x52, 0xaa, 0xce, 0x99, 0xff, 0xff, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38,
-  0xde, 0xfb, 0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x31, 0xa6,
-  0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00,
-  0xa5, 0x34, 0xef, 0x9d, 0x08, 0x61, 0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0x08, 0x61, 0x00, 0x00,
-  0x08, 0x61, 0xf7, 0xbe, 0x9c, 0xf3, 0x00, 0x00, 0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0x08, 0x61,
-  0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0x42, 0x08, 0x00, 0x00, 0x00, 0x00, 0xce, 0x99, 0xff, 0xff,
-  0x08, 0x61, 0x00, 0x00, 0xb5, 0xd6, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce, 0x99,
-  0xff, 0xff, 0x08, 0x61, 0x00, 0x00, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xad, 0x95, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xad, 0x95, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0x08, 0x61, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0x08, 0x61,
-  0x00, 0x00
+  0x30, 0x05, 0x1f, 0x01, 0x40, 0x0d, 0x1f, 0x01, 0x30, 0x05, 0x2f, 0x01, 0x30, 0x0d, 0x1c, 0x0f,
+  0x01, 0x20, 0x05, 0x0f, 0x05, 0x0c, 0x0f, 0x01, 0x20, 0x0c, 0x0d, 0x00, 0x0c, 0x0f, 0x01, 0x10,
+  0x03, 0x0f, 0x06, 0x00, 0x0c, 0x0f, 0x01, 0x10, 0x0a, 0x0e, 0x01, 0x00, 0x0c, 0x0f, 0x01, 0x00,
+  0x01, 0x0f, 0x09, 0x10, 0x0c, 0x0f, 0x01, 0x00, 0x06, 0x0f, 0x04, 0x10, 0x0c, 0x0f, 0x01, 0x00,
+  0x0b, 0x0e, 0x20, 0x0c, 0x0f, 0x01, 0x00, 0x7f, 0x0a, 0x7f, 0x0a, 0x40, 0x0c, 0x0f, 0x01, 0x50,
+  0x0c, 0x0f, 0x01, 0x50, 0x0c, 0x0f, 0x01, 0x50, 0x0c, 0x0f, 0x01, 0x00,
 };
-const uint32_t font_24_4_len = 306;
 
 const uint8_t font_24_5[] = {
-  0x00, 0x00, 0x39, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xeb,
-  0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xeb,
-  0x00, 0x00, 0x4a, 0x89, 0xff, 0xff, 0x84, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x5a, 0xeb, 0xff, 0xff, 0x73, 0xae, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x6b, 0x6d, 0xff, 0xff, 0x63, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x7b, 0xef, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x8c, 0x91, 0xff, 0xff, 0xef, 0x7d, 0xad, 0x95, 0x39, 0xe7, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x63, 0x2c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x20, 0x21, 0x04, 0x63, 0x0c, 0xd6, 0xda, 0xff, 0xff, 0xf7, 0xbe, 0x18, 0xc3,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x82, 0xdf, 0x1b, 0xff, 0xff, 0x6b, 0x6d,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x84, 0x10, 0xff, 0xff, 0x9c, 0xf3,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x2c, 0xff, 0xff, 0xa5, 0x54,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xef, 0xff, 0xff, 0x94, 0xd2,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0x63, 0x2c,
-  0x29, 0x45, 0x42, 0x28, 0x08, 0x61, 0x18, 0xe3, 0x94, 0xd2, 0xff, 0xff, 0xef, 0x7d, 0x10, 0x82,
-  0x8c, 0x71, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x52, 0xaa, 0x00, 0x00,
-  0x4a, 0x89, 0xbe, 0x17, 0xef, 0x7d, 0xef, 0x9d, 0xb5, 0xd6, 0x39, 0xe7, 0x00, 0x00, 0x00, 0x00
+  0x00, 0x04, 0x4f, 0x05, 0x00, 0x04, 0x4f, 0x05, 0x00, 0x05, 0x0f, 0x08, 0x40, 0x05, 0x0f, 0x07,
+  0x40, 0x06, 0x0f, 0x06, 0x40, 0x07, 0x0f, 0x05, 0x40, 0x09, 0x0f, 0x0e, 0x0a, 0x04, 0x20, 0x0a,
+  0x3f, 0x06, 0x20, 0x02, 0x06, 0x0d, 0x1f, 0x01, 0x30, 0x01, 0x0d, 0x0f, 0x06, 0x40, 0x08, 0x0f,
+  0x09, 0x40, 0x06, 0x0f, 0x0a, 0x40, 0x07, 0x0f, 0x09, 0x40, 0x0c, 0x0f, 0x06, 0x02, 0x04, 0x01,
+  0x02, 0x09, 0x0f, 0x0e, 0x01, 0x08, 0x4f, 0x05, 0x00, 0x05, 0x0b, 0x1e, 0x0b, 0x04, 0x10,
 };
-const uint32_t font_24_5_len = 272;
 
 const uint8_t font_24_6[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x49, 0xb5, 0x96, 0xdf, 0x1b, 0x29, 0x65,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x9d, 0x13, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x4a, 0x69, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x94, 0xb2, 0xff, 0xff, 0xdf, 0x1b, 0x6b, 0x4d,
-  0x29, 0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0xa6, 0xff, 0xff, 0xd6, 0xda, 0x10, 0x82,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0x4a, 0x49,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xef, 0x7d, 0xef, 0x7d,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0x86, 0xff, 0xff,
-  0xe7, 0x5c, 0xce, 0x99, 0xf7, 0xbe, 0xd6, 0xba, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x42, 0x28, 0x00, 0x00,
-  0x6b, 0x6d, 0xff, 0xff, 0xbd, 0xd7, 0x18, 0xe3, 0x18, 0xc3, 0xad, 0x95, 0xff, 0xff, 0xc6, 0x18,
-  0x00, 0x00, 0x73, 0xae, 0xff, 0xff, 0x8c, 0x91, 0x00, 0x00, 0x00, 0x00, 0x21, 0x24, 0xff, 0xff,
-  0xf7, 0xde, 0x08, 0x61, 0x73, 0x8e, 0xff, 0xff, 0x94, 0xd2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xef, 0x9d, 0xff, 0xff, 0x29, 0x45, 0x63, 0x2c, 0xff, 0xff, 0x9d, 0x13, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xdf, 0x1b, 0xff, 0xff, 0x31, 0x86, 0x4a, 0x69, 0xff, 0xff, 0xbd, 0xf7, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xef, 0x7d, 0xff, 0xff, 0x21, 0x24, 0x21, 0x04, 0xff, 0xff, 0xe7, 0x5c,
-  0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0xff, 0xff, 0xf7, 0xde, 0x00, 0x20, 0x00, 0x00, 0xd6, 0xba,
-  0xff, 0xff, 0x73, 0xce, 0x08, 0x61, 0x94, 0xd2, 0xff, 0xff, 0xb5, 0xd6, 0x00, 0x00, 0x00, 0x00,
-  0x5a, 0xeb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x42, 0x28, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x6b, 0x6d, 0xd6, 0xda, 0xf7, 0xbe, 0xd6, 0xba, 0x5a, 0xcb, 0x00, 0x00,
-  0x00, 0x00
+  0x30, 0x04, 0x0a, 0x0d, 0x03, 0x30, 0x0a, 0x2f, 0x05, 0x20, 0x09, 0x0f, 0x0d, 0x06, 0x02, 0x20,
+  0x03, 0x0f, 0x0d, 0x01, 0x40, 0x0a, 0x0f, 0x04, 0x50, 0x1e, 0x50, 0x03, 0x0f, 0x0e, 0x0c, 0x0f,
+  0x0d, 0x05, 0x10, 0x05, 0x5f, 0x04, 0x00, 0x06, 0x0f, 0x0b, 0x02, 0x01, 0x0a, 0x0f, 0x0b, 0x00,
+  0x07, 0x0f, 0x09, 0x10, 0x02, 0x1f, 0x01, 0x07, 0x0f, 0x09, 0x20, 0x0e, 0x0f, 0x02, 0x06, 0x0f,
+  0x0a, 0x20, 0x0d, 0x0f, 0x03, 0x05, 0x0f, 0x0b, 0x20, 0x0e, 0x0f, 0x12, 0x0f, 0x0e, 0x10, 0x02,
+  0x1f, 0x10, 0x0d, 0x0f, 0x07, 0x01, 0x09, 0x0f, 0x0b, 0x10, 0x05, 0x4f, 0x04, 0x20, 0x06, 0x0d,
+  0x0f, 0x0d, 0x05, 0x10,
 };
-const uint32_t font_24_6_len = 306;
 
 const uint8_t font_24_7[] = {
-  0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x10, 0x82, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xef,
-  0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20,
-  0xe7, 0x3c, 0xff, 0xff, 0x31, 0x86, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x52, 0xaa, 0xff, 0xff, 0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x08, 0x61, 0xf7, 0xbe, 0xef, 0x9d, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9d, 0x13, 0xff, 0xff, 0x5b, 0x0b, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x3c, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x44, 0xff, 0xff, 0xd6, 0xda, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x2c, 0xff, 0xff, 0x9c, 0xf3,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9c, 0xd3, 0xff, 0xff,
-  0x6b, 0x4d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x58,
-  0xff, 0xff, 0x39, 0xe7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xf7, 0xbe, 0xff, 0xff, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x10, 0xa2, 0xff, 0xff, 0xf7, 0xde, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x29, 0x65, 0xff, 0xff, 0xe7, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00
+  0x0e, 0x6f, 0x01, 0x0e, 0x6f, 0x01, 0x40, 0x07, 0x0f, 0x0a, 0x50, 0x0e, 0x0f, 0x03, 0x40, 0x05,
+  0x0f, 0x0b, 0x50, 0x0a, 0x0f, 0x05, 0x40, 0x01, 0x0f, 0x0e, 0x50, 0x05, 0x0f, 0x0a, 0x50, 0x0a,
+  0x0f, 0x06, 0x50, 0x0e, 0x0f, 0x02, 0x40, 0x02, 0x0f, 0x0d, 0x50, 0x06, 0x0f, 0x09, 0x50, 0x09,
+  0x0f, 0x06, 0x50, 0x0c, 0x0f, 0x04, 0x50, 0x1f, 0x01, 0x40, 0x01, 0x1f, 0x50, 0x03, 0x0f, 0x0e,
+  0x40,
 };
-const uint32_t font_24_7_len = 306;
 
 const uint8_t font_24_8[] = {
-  0x00, 0x00, 0x08, 0x61, 0x8c, 0x91, 0xd6, 0xda, 0xef, 0x7d, 0xbe, 0x17, 0x42, 0x28, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xbd, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde,
-  0x3a, 0x07, 0x00, 0x00, 0x42, 0x08, 0xff, 0xff, 0xe7, 0x5c, 0x31, 0xa6, 0x10, 0x82, 0xad, 0x75,
-  0xff, 0xff, 0xb5, 0xb6, 0x00, 0x00, 0x73, 0xae, 0xff, 0xff, 0x94, 0xb2, 0x00, 0x00, 0x00, 0x00,
-  0x31, 0xa6, 0xff, 0xff, 0xe7, 0x3c, 0x00, 0x00, 0x73, 0xae, 0xff, 0xff, 0x84, 0x50, 0x00, 0x00,
-  0x00, 0x00, 0x21, 0x04, 0xff, 0xff, 0xde, 0xfb, 0x00, 0x00, 0x4a, 0x49, 0xff, 0xff, 0xad, 0x75,
-  0x00, 0x00, 0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x20, 0xde, 0xfb,
-  0xf7, 0xde, 0x31, 0xa6, 0x00, 0x00, 0xb5, 0xd6, 0xf7, 0xde, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00,
-  0x31, 0xc6, 0xef, 0x9d, 0xef, 0x7d, 0xad, 0x75, 0xff, 0xff, 0x7b, 0xcf, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x08, 0x41, 0xbe, 0x17, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x1b, 0x08, 0x61, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0x5b, 0x0b, 0x8c, 0x71, 0xff, 0xff, 0xce, 0x79,
-  0x08, 0x61, 0x00, 0x00, 0x52, 0x8a, 0xff, 0xff, 0x9c, 0xd3, 0x00, 0x00, 0x00, 0x00, 0x94, 0xd2,
-  0xff, 0xff, 0x94, 0xb2, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00,
-  0x08, 0x61, 0xf7, 0xde, 0xf7, 0xbe, 0x00, 0x20, 0xce, 0x99, 0xff, 0xff, 0x31, 0x86, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xde, 0xfb, 0xff, 0xff, 0x21, 0x04, 0xce, 0x79, 0xff, 0xff, 0x5a, 0xcb,
-  0x00, 0x00, 0x00, 0x00, 0x08, 0x61, 0xf7, 0xbe, 0xff, 0xff, 0x10, 0x82, 0x8c, 0x51, 0xff, 0xff,
-  0xd6, 0xda, 0x29, 0x65, 0x10, 0x82, 0x9d, 0x13, 0xff, 0xff, 0xc6, 0x38, 0x00, 0x00, 0x08, 0x61,
-  0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0x39, 0xc7, 0x00, 0x00,
-  0x00, 0x00, 0x10, 0xa2, 0x9d, 0x13, 0xef, 0x7d, 0xef, 0x9d, 0xb5, 0xd6, 0x31, 0xa6, 0x00, 0x00,
-  0x00, 0x00
+  0x00, 0x01, 0x09, 0x0d, 0x0e, 0x0b, 0x04, 0x20, 0x0b, 0x4f, 0x04, 0x00, 0x04, 0x0f, 0x0e, 0x03,
+  0x01, 0x0a, 0x0f, 0x0b, 0x00, 0x07, 0x0f, 0x09, 0x10, 0x03, 0x0f, 0x0e, 0x00, 0x07, 0x0f, 0x08,
+  0x10, 0x02, 0x0f, 0x0d, 0x00, 0x04, 0x0f, 0x0a, 0x10, 0x04, 0x0f, 0x0a, 0x10, 0x0d, 0x0f, 0x03,
+  0x00, 0x0b, 0x0f, 0x03, 0x10, 0x03, 0x1e, 0x0a, 0x0f, 0x07, 0x30, 0x0b, 0x1f, 0x0d, 0x01, 0x20,
+  0x0a, 0x0f, 0x06, 0x08, 0x0f, 0x0c, 0x01, 0x00, 0x05, 0x0f, 0x09, 0x10, 0x09, 0x0f, 0x09, 0x00,
+  0x0a, 0x0f, 0x04, 0x10, 0x01, 0x1f, 0x00, 0x0c, 0x0f, 0x03, 0x20, 0x0d, 0x0f, 0x02, 0x0c, 0x0f,
+  0x05, 0x10, 0x01, 0x1f, 0x01, 0x08, 0x0f, 0x0d, 0x03, 0x01, 0x0a, 0x0f, 0x0c, 0x00, 0x01, 0x0d,
+  0x4f, 0x03, 0x10, 0x01, 0x0a, 0x1e, 0x0b, 0x03, 0x10,
 };
-const uint32_t font_24_8_len = 306;
 
 const uint8_t font_24_9[] = {
-  0x00, 0x00, 0x08, 0x61, 0x94, 0xd2, 0xe7, 0x5c, 0xef, 0x9d, 0xb5, 0xd6, 0x21, 0x44, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xad, 0x55, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x1b,
-  0x08, 0x61, 0x00, 0x00, 0x21, 0x24, 0xff, 0xff, 0xf7, 0xbe, 0x42, 0x08, 0x18, 0xc3, 0xce, 0x79,
-  0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00, 0x6b, 0x4d, 0xff, 0xff, 0xad, 0x95, 0x00, 0x00, 0x00, 0x00,
-  0x5a, 0xeb, 0xff, 0xff, 0xb5, 0xb6, 0x00, 0x00, 0x8c, 0x71, 0xff, 0xff, 0x84, 0x10, 0x00, 0x00,
-  0x00, 0x00, 0x29, 0x65, 0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x9c, 0xd3, 0xff, 0xff, 0x73, 0xae,
-  0x00, 0x00, 0x00, 0x00, 0x10, 0x82, 0xff, 0xff, 0xf7, 0xde, 0x00, 0x00, 0x94, 0x92, 0xff, 0xff,
-  0x84, 0x30, 0x00, 0x00, 0x00, 0x00, 0x08, 0x41, 0xff, 0xff, 0xff, 0xff, 0x08, 0x41, 0x73, 0x8e,
-  0xff, 0xff, 0xb5, 0xb6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xff, 0xff, 0xff, 0xff, 0x08, 0x61,
-  0x29, 0x65, 0xff, 0xff, 0xf7, 0xde, 0x5a, 0xeb, 0x08, 0x41, 0x39, 0xe7, 0xff, 0xff, 0xff, 0xff,
-  0x00, 0x20, 0x00, 0x00, 0xad, 0x55, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xef, 0x7d, 0x00, 0x00, 0x00, 0x00, 0x08, 0x61, 0x94, 0xd2, 0xef, 0x7d, 0xef, 0x7d, 0xce, 0x59,
-  0xff, 0xff, 0xc6, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x63, 0x2c, 0xff, 0xff, 0x8c, 0x71, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xbe, 0x17, 0xff, 0xff, 0x39, 0xe7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x63, 0x4c, 0xff, 0xff, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x82,
-  0x42, 0x08, 0xad, 0x75, 0xff, 0xff, 0xf7, 0xbe, 0x29, 0x85, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xd6, 0xda, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x4a, 0x49, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xb5, 0x96, 0xce, 0x99, 0x84, 0x50, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00
+  0x00, 0x01, 0x09, 0x1e, 0x0b, 0x02, 0x20, 0x0a, 0x3f, 0x0d, 0x01, 0x00, 0x02, 0x1f, 0x04, 0x01,
+  0x0c, 0x0f, 0x06, 0x00, 0x06, 0x0f, 0x0a, 0x10, 0x05, 0x0f, 0x0b, 0x00, 0x08, 0x0f, 0x08, 0x10,
+  0x03, 0x0f, 0x0d, 0x00, 0x09, 0x0f, 0x07, 0x10, 0x01, 0x1f, 0x00, 0x09, 0x0f, 0x08, 0x20, 0x1f,
+  0x00, 0x07, 0x0f, 0x0b, 0x20, 0x1f, 0x01, 0x03, 0x1f, 0x05, 0x00, 0x04, 0x1f, 0x10, 0x0a, 0x4f,
+  0x0e, 0x10, 0x01, 0x09, 0x1e, 0x0c, 0x0f, 0x0c, 0x50, 0x06, 0x0f, 0x08, 0x50, 0x0b, 0x0f, 0x04,
+  0x40, 0x06, 0x0f, 0x0c, 0x20, 0x01, 0x04, 0x0a, 0x1f, 0x03, 0x20, 0x0d, 0x1f, 0x0e, 0x04, 0x30,
+  0x0a, 0x0c, 0x08, 0x02, 0x30,
 };
-const uint32_t font_24_9_len = 306;
 
 const uint8_t font_24_dot[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x39, 0xe7, 0xe7, 0x5c, 0xb5, 0xd6, 0x00, 0x00, 0x94, 0x92, 0xff, 0xff, 0xff, 0xff, 0x29, 0x45,
-  0x39, 0xe7, 0xe7, 0x5c, 0xb5, 0xd6, 0x00, 0x20
+  0xf0, 0xf0, 0xf0, 0x70, 0x04, 0x0e, 0x0b, 0x00, 0x09, 0x1f, 0x02, 0x04, 0x0e, 0x0b, 0x00,
 };
-const uint32_t font_24_dot_len = 136;
 
 const uint8_t font_24_v[] = {
-  0x6b, 0x4d, 0xff, 0xff, 0xce, 0x79, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0x52, 0xaa, 0x31, 0xa6, 0xff, 0xff, 0xf7, 0xbe, 0x00, 0x20,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xf7, 0xde, 0xff, 0xff, 0x21, 0x24,
-  0x00, 0x20, 0xf7, 0xbe, 0xff, 0xff, 0x29, 0x65, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x31, 0x86, 0xff, 0xff, 0xef, 0x7d, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x58, 0xff, 0xff, 0x5a, 0xcb,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb, 0xff, 0xff, 0xb5, 0xb6, 0x00, 0x00,
-  0x00, 0x00, 0x8c, 0x91, 0xff, 0xff, 0x8c, 0x71, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x94, 0xb2, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0xff, 0xff, 0xc6, 0x38,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce, 0x59, 0xff, 0xff, 0x42, 0x08, 0x00, 0x00,
-  0x00, 0x00, 0x18, 0xc3, 0xff, 0xff, 0xf7, 0xbe, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x08, 0x41,
-  0xf7, 0xde, 0xf7, 0xbe, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xda, 0xff, 0xff,
-  0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x39, 0xe7, 0xff, 0xff, 0xbe, 0x17, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x9c, 0xd3, 0xff, 0xff, 0x73, 0xae, 0x00, 0x00, 0x00, 0x00, 0x73, 0xce,
-  0xff, 0xff, 0x84, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb, 0xff, 0xff,
-  0xad, 0x95, 0x00, 0x00, 0x00, 0x00, 0xb5, 0xb6, 0xff, 0xff, 0x42, 0x08, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x10, 0xa2, 0xf7, 0xde, 0xef, 0x7d, 0x00, 0x00, 0x00, 0x00, 0xef, 0x9d,
-  0xef, 0x9d, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce, 0x79,
-  0xff, 0xff, 0x31, 0x86, 0x31, 0xa6, 0xff, 0xff, 0xb5, 0x96, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x84, 0x30, 0xff, 0xff, 0x73, 0xae, 0x7b, 0xcf, 0xff, 0xff,
-  0x6b, 0x6d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0xe7,
-  0xff, 0xff, 0xbd, 0xd7, 0xbd, 0xf7, 0xff, 0xff, 0x21, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x5c, 0xf7, 0xbe, 0xf7, 0xbe, 0xd6, 0xda,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x71, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0xca, 0xff, 0xff, 0xff, 0xff, 0x42, 0x28,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0x06, 0x0f, 0x0c, 0x50, 0x0c, 0x0f, 0x05, 0x03, 0x1f, 0x50, 0x1f, 0x02, 0x00, 0x1f, 0x03, 0x30,
+  0x03, 0x0f, 0x0e, 0x10, 0x0c, 0x0f, 0x05, 0x30, 0x05, 0x0f, 0x0b, 0x10, 0x09, 0x0f, 0x08, 0x30,
+  0x09, 0x0f, 0x07, 0x10, 0x05, 0x0f, 0x0c, 0x30, 0x0c, 0x0f, 0x04, 0x10, 0x01, 0x1f, 0x30, 0x1f,
+  0x30, 0x0d, 0x0f, 0x03, 0x10, 0x04, 0x0f, 0x0b, 0x30, 0x09, 0x0f, 0x07, 0x10, 0x07, 0x0f, 0x08,
+  0x30, 0x05, 0x0f, 0x0a, 0x10, 0x0b, 0x0f, 0x04, 0x30, 0x01, 0x0f, 0x0e, 0x10, 0x1e, 0x50, 0x0c,
+  0x0f, 0x13, 0x0f, 0x0a, 0x50, 0x08, 0x0f, 0x17, 0x0f, 0x06, 0x50, 0x04, 0x0f, 0x1b, 0x0f, 0x02,
+  0x60, 0x0e, 0x1f, 0x0d, 0x70, 0x0a, 0x1f, 0x08, 0x70, 0x05, 0x1f, 0x04, 0x30,
 };
-const uint32_t font_24_v_len = 408;
 
 const uint8_t font_24_a[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0xe7, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x69,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x84, 0x30, 0xff, 0xff, 0xff, 0xff, 0x94, 0x92, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce, 0x59, 0xef, 0x9d, 0xef, 0x9d, 0xd6, 0xda,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xc3,
-  0xf7, 0xde, 0xb5, 0xb6, 0xb5, 0xd6, 0xff, 0xff, 0x21, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0x73, 0xae, 0x73, 0xae, 0xff, 0xff,
-  0x6b, 0x8d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x55,
-  0xff, 0xff, 0x31, 0x86, 0x31, 0xa6, 0xff, 0xff, 0xb5, 0xd6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xef, 0x7d, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0xef, 0x7d,
-  0xf7, 0xbe, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3a, 0x07, 0xff, 0xff,
-  0xad, 0x55, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0x4a, 0x69, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x84, 0x30, 0xff, 0xff, 0x6b, 0x4d, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x6d,
-  0xff, 0xff, 0x8c, 0x91, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x18, 0xff, 0xff,
-  0x29, 0x45, 0x00, 0x00, 0x00, 0x00, 0x29, 0x85, 0xff, 0xff, 0xce, 0x99, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x08, 0x41, 0xf7, 0xbe, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xe7, 0x5c, 0xf7, 0xde, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00,
-  0x00, 0x00, 0x84, 0x10, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x8c, 0x91, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xf7, 0xff, 0xff, 0x42, 0x28,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x48, 0xff, 0xff, 0xce, 0x79, 0x00, 0x00,
-  0x00, 0x20, 0xef, 0x9d, 0xf7, 0xde, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x10, 0x82, 0xff, 0xff, 0xf7, 0xde, 0x08, 0x61, 0x31, 0x86, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xda, 0xff, 0xff, 0x42, 0x08,
-  0x63, 0x2c, 0xff, 0xff, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xa5, 0x54, 0xff, 0xff, 0x73, 0xce
+  0x30, 0x04, 0x1f, 0x05, 0x70, 0x08, 0x1f, 0x09, 0x70, 0x0c, 0x1e, 0x0d, 0x60, 0x01, 0x0f, 0x1b,
+  0x0f, 0x02, 0x50, 0x06, 0x0f, 0x17, 0x0f, 0x07, 0x50, 0x0a, 0x0f, 0x13, 0x0f, 0x0b, 0x50, 0x1e,
+  0x10, 0x0e, 0x0f, 0x40, 0x04, 0x0f, 0x0a, 0x10, 0x0a, 0x0f, 0x05, 0x30, 0x08, 0x0f, 0x06, 0x10,
+  0x06, 0x0f, 0x09, 0x30, 0x0b, 0x0f, 0x02, 0x10, 0x03, 0x0f, 0x0c, 0x30, 0x0f, 0x0e, 0x30, 0x0e,
+  0x0f, 0x01, 0x10, 0x04, 0x7f, 0x05, 0x10, 0x08, 0x7f, 0x09, 0x10, 0x0b, 0x0f, 0x04, 0x30, 0x04,
+  0x0f, 0x0c, 0x10, 0x0e, 0x0f, 0x01, 0x30, 0x01, 0x1f, 0x01, 0x03, 0x0f, 0x0d, 0x50, 0x0d, 0x0f,
+  0x04, 0x06, 0x0f, 0x0a, 0x50, 0x0a, 0x0f, 0x07,
 };
-const uint32_t font_24_a_len = 408;
 
 const uint8_t font_24_widths[13] = {
   9, 
@@ -316,34 +141,69 @@ const uint8_t font_24_widths[13] = {
  };
 
 const uint16_t font_24_sizes[13] = {
-  306, 
-  204, 
-  272, 
-  272, 
-  306, 
-  272, 
-  306, 
-  306, 
-  306, 
-  306, 
-  136, 
-  408, 
-  408, 
+  118, 
+  74, 
+  75, 
+  83, 
+  92, 
+  79, 
+  100, 
+  65, 
+  121, 
+  101, 
+  15, 
+  109, 
+  104, 
  };
 
-const uint16_t *font_24_pix[13] = {
-  (uint16_t*) &font_24_0, 
-  (uint16_t*) &font_24_1, 
-  (uint16_t*) &font_24_2, 
-  (uint16_t*) &font_24_3, 
-  (uint16_t*) &font_24_4, 
-  (uint16_t*) &font_24_5, 
-  (uint16_t*) &font_24_6, 
-  (uint16_t*) &font_24_7, 
-  (uint16_t*) &font_24_8, 
-  (uint16_t*) &font_24_9, 
-  (uint16_t*) &font_24_dot, 
-  (uint16_t*) &font_24_v, 
-  (uint16_t*) &font_24_a, 
+const uint8_t *font_24_pix[13] = {
+  font_24_0, 
+  font_24_1, 
+  font_24_2, 
+  font_24_3, 
+  font_24_4, 
+  font_24_5, 
+  font_24_6, 
+  font_24_7, 
+  font_24_8, 
+  font_24_9, 
+  font_24_dot, 
+  font_24_v, 
+  font_24_a, 
  };
 
+const uint8_t font_24_index[] = {
+  0x0a, 0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0x0c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0b,
+};
+
+const uint8_t font_24_advances[13] = {
+  11, 
+  8, 
+  10, 
+  10, 
+  11, 
+  10, 
+  11, 
+  11, 
+  11, 
+  11, 
+  6, 
+  14, 
+  14, 
+ };
+
+const font_t font_24 = {
+  .size = 24,
+  .height = 17,
+  .max_width = 12,
+  .digit_width = 9,
+  .first_code = 46,
+  .num_codes = 41,
+  .index = font_24_index,
+  .widths = font_24_widths,
+  .advances = font_24_advances,
+  .pix = font_24_pix,
+  .palette = font_24_palette,
+};
@@ -1,31 +1,23 @@
+#include "font.h"
 extern const uint32_t font_24_height;
 extern const uint32_t font_24_num_glyphs;
+extern const uint8_t font_24_palette[];
 extern const uint8_t font_24_0[];
-extern const uint32_t font_24_0_len;
 extern const uint8_t font_24_1[];
-extern const uint32_t font_24_1_len;
 extern const uint8_t font_24_2[];
-extern const uint32_t font_24_2_len;
 extern const uint8_t font_24_3[];
-extern const uint32_t font_24_3_len;
 extern const uint8_t font_24_4[];
-extern const uint32_t font_24_4_len;
 extern const uint8_t font_24_5[];
-extern const uint32_t font_24_5_len;
 extern const uint8_t font_24_6[];
-extern const uint32_t font_24_6_len;
 extern const uint8_t font_24_7[];
-extern const uint32_t font_24_7_len;
 extern const uint8_t font_24_8[];
-extern const uint32_t font_24_8_len;
 extern const uint8_t font_24_9[];
-extern const uint32_t font_24_9_len;
 extern const uint8_t font_24_dot[];
-extern const uint32_t font_24_dot_len;
 extern const uint8_t font_24_v[];
-extern const uint32_t font_24_v_len;
 extern const uint8_t font_24_a[];
-extern const uint32_t font_24_a_len;
 extern const uint8_t font_24_widths[13];
 extern const uint16_t font_24_sizes[13];
-extern const uint16_t *font_24_pix[13];
+extern const uint8_t *font_24_pix[13];
+extern const uint8_t font_24_index[];
+extern const uint8_t font_24_advances[13];
+extern const font_t font_24;
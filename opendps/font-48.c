@@ -1,976 +1,208 @@
 #include <stdint.h>
+#include "font.h"
 const uint32_t font_48_height = 35;
 const uint32_t font_48_num_glyphs = 13;
 
+const uint8_t font_48_palette[] = {
+  0x00, 0x00, 0x10, 0x82, 0x21, 0x04, 0x31, 0x86, 0x42, 0x08, 0x52, 0xaa, 0x63, 0x2c, 0x73, 0xae,
+  0x84, 0x30, 0x94, 0xb2, 0xa5, 0x54, 0xb5, 0xd6, 0xc6, 0x58, 0xd6, 0xda, 0xe7, 0x5c, 0xff, 0xff,
+};
+
 const uint8_t font_48_0[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x61, 0x73, 0x8e, 0xc6, 0x58, 0xef, 0x7d,
-  0xf7, 0xde, 0xdf, 0x1b, 0xad, 0x75, 0x42, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x04, 0xd6, 0xba, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0xb2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xd6, 0xda, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x84, 0x30, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x7c, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c,
-  0xb5, 0xd6, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0x29, 0x45, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x20, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0xb2, 0x00, 0x20,
-  0x00, 0x00, 0x18, 0xe3, 0xd6, 0xda, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x91, 0x00, 0x00,
-  0x00, 0x00, 0x4a, 0x49, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x08, 0x41, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x3c, 0x00, 0x00,
-  0x00, 0x00, 0x8c, 0x91, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9d, 0x13, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x08, 0x41, 0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6,
-  0x00, 0x00, 0xbe, 0x17, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x4d, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x63, 0x2c,
-  0x00, 0x00, 0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x39, 0xe7, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x94, 0xd2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0xb2,
-  0x18, 0xc3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x21, 0x04, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbd, 0xd7,
-  0x29, 0x85, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xce, 0x99,
-  0x42, 0x28, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c,
-  0x5a, 0xcb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde,
-  0x63, 0x2c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xde, 0xfb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0xc7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x6b, 0x6d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0xa6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x73, 0x8e, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0x86, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xce, 0x99, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x7b, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xce, 0x79, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x73, 0xae, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xce, 0x99, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x85, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x6b, 0x8d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0x86, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x6b, 0x4d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xda, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0xa6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x63, 0x2c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x52, 0xaa, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x49, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe,
-  0x39, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x1b,
-  0x29, 0x45, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x4d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xce, 0x59,
-  0x10, 0x82, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x45, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x84, 0x30, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0x96,
-  0x00, 0x00, 0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x49, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x84, 0x30,
-  0x00, 0x00, 0xb5, 0x96, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7b, 0xcf, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa,
-  0x00, 0x00, 0x7c, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xd6, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x21, 0x24,
-  0x00, 0x00, 0x29, 0x65, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x21, 0x04, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xce, 0x79, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x58, 0x42, 0x08,
-  0x08, 0x61, 0x63, 0x4c, 0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x73, 0xae, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x4a, 0x89, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x1b, 0x08, 0x61, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x54, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x4a, 0x69, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x94, 0xd2, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x4a, 0x69, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x24, 0x7b, 0xef, 0x9c, 0xf3,
-  0xad, 0x75, 0x94, 0x92, 0x5b, 0x0b, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0x30, 0x01, 0x07, 0x0c, 0x0e, 0x0f, 0x0d, 0x0a, 0x04, 0x60, 0x02, 0x0d, 0x6f, 0x09, 0x50, 0x0d,
+  0x8f, 0x08, 0x30, 0x08, 0x3f, 0x0e, 0x0b, 0x4f, 0x02, 0x20, 0x0e, 0x2f, 0x09, 0x10, 0x02, 0x0d,
+  0x2f, 0x09, 0x10, 0x04, 0x2f, 0x0e, 0x30, 0x05, 0x2f, 0x0e, 0x10, 0x09, 0x2f, 0x0a, 0x40, 0x0e,
+  0x2f, 0x03, 0x00, 0x0b, 0x2f, 0x06, 0x40, 0x0c, 0x2f, 0x06, 0x00, 0x0e, 0x2f, 0x04, 0x40, 0x09,
+  0x2f, 0x09, 0x01, 0x3f, 0x02, 0x40, 0x07, 0x2f, 0x0b, 0x03, 0x3f, 0x50, 0x06, 0x2f, 0x0c, 0x04,
+  0x3f, 0x50, 0x05, 0x2f, 0x0e, 0x05, 0x2f, 0x0e, 0x50, 0x04, 0x3f, 0x06, 0x2f, 0x0d, 0x50, 0x03,
+  0x3f, 0x06, 0x2f, 0x0d, 0x50, 0x03, 0x3f, 0x07, 0x2f, 0x0d, 0x50, 0x03, 0x3f, 0x07, 0x2f, 0x0c,
+  0x50, 0x03, 0x3f, 0x07, 0x2f, 0x0c, 0x50, 0x03, 0x3f, 0x07, 0x2f, 0x0c, 0x50, 0x03, 0x3f, 0x07,
+  0x2f, 0x0d, 0x50, 0x03, 0x3f, 0x06, 0x2f, 0x0d, 0x50, 0x03, 0x3f, 0x06, 0x2f, 0x0d, 0x50, 0x04,
+  0x3f, 0x05, 0x2f, 0x0e, 0x50, 0x04, 0x3f, 0x04, 0x3f, 0x50, 0x05, 0x2f, 0x0d, 0x02, 0x3f, 0x01,
+  0x40, 0x06, 0x2f, 0x0c, 0x01, 0x3f, 0x02, 0x40, 0x08, 0x2f, 0x0a, 0x00, 0x0d, 0x2f, 0x04, 0x40,
+  0x0a, 0x2f, 0x08, 0x00, 0x0a, 0x2f, 0x07, 0x40, 0x0d, 0x2f, 0x05, 0x00, 0x08, 0x2f, 0x0b, 0x30,
+  0x01, 0x3f, 0x02, 0x00, 0x03, 0x3f, 0x02, 0x20, 0x07, 0x2f, 0x0c, 0x20, 0x0c, 0x2f, 0x0c, 0x04,
+  0x01, 0x06, 0x0e, 0x2f, 0x07, 0x20, 0x05, 0x9f, 0x0d, 0x01, 0x30, 0x0a, 0x8f, 0x05, 0x50, 0x09,
+  0x5f, 0x0e, 0x05, 0x70, 0x02, 0x07, 0x09, 0x0a, 0x09, 0x06, 0x40,
 };
-const uint32_t font_48_0_len = 1120;
 
 const uint8_t font_48_1[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0xe7,
-  0x42, 0x08, 0x42, 0x08, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x5a, 0xeb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x24, 0xef, 0x7d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0xde, 0xfb, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3,
-  0xd6, 0xba, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00,
-  0x00, 0x00, 0x31, 0x86, 0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x6b, 0x4d, 0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x6b, 0x4d, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xce, 0x79, 0xd6, 0xda, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa,
-  0x10, 0x82, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xb6, 0x08, 0x61, 0xc6, 0x38, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x6b, 0x6d, 0xef, 0x7d, 0x63, 0x2c, 0x00, 0x00,
-  0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x20,
-  0x18, 0xc3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x08, 0x61,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x52, 0xaa, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x18, 0xc3, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa,
-  0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x21, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x18, 0xe3, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x52, 0xaa, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x08, 0x41,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00
+  0x60, 0x24, 0x01, 0x50, 0x05, 0x2f, 0x05, 0x40, 0x02, 0x0e, 0x2f, 0x05, 0x30, 0x02, 0x0d, 0x3f,
+  0x05, 0x20, 0x02, 0x0d, 0x4f, 0x05, 0x10, 0x03, 0x0d, 0x5f, 0x05, 0x00, 0x06, 0x0e, 0x6f, 0x05,
+  0x06, 0x3f, 0x0c, 0x0d, 0x2f, 0x05, 0x01, 0x0e, 0x1f, 0x0b, 0x01, 0x0c, 0x2f, 0x05, 0x00, 0x06,
+  0x0e, 0x06, 0x10, 0x0c, 0x2f, 0x05, 0x10, 0x01, 0x20, 0x0c, 0x2f, 0x05, 0x50, 0x0c, 0x2f, 0x05,
+  0x50, 0x0c, 0x2f, 0x05, 0x01, 0x40, 0x0c, 0x2f, 0x05, 0x01, 0x40, 0x0c, 0x2f, 0x05, 0x01, 0x40,
+  0x0c, 0x2f, 0x05, 0x02, 0x40, 0x0c, 0x2f, 0x05, 0x02, 0x40, 0x0c, 0x2f, 0x05, 0x02, 0x40, 0x0c,
+  0x2f, 0x05, 0x01, 0x40, 0x0c, 0x2f, 0x05, 0x01, 0x40, 0x0c, 0x2f, 0x05, 0x50, 0x0c, 0x2f, 0x05,
+  0x50, 0x0c, 0x2f, 0x05, 0x50, 0x0c, 0x2f, 0x05, 0x50, 0x0c, 0x2f, 0x05, 0x50, 0x0c, 0x2f, 0x05,
+  0x50, 0x0c, 0x2f, 0x05, 0x50, 0x0c, 0x2f, 0x05, 0x50, 0x0c, 0x2f, 0x05, 0x50, 0x0c, 0x2f, 0x05,
+  0x50, 0x0c, 0x2f, 0x05, 0x50, 0x0c, 0x2f, 0x05, 0x50, 0x0c, 0x2f, 0x05, 0x50, 0x0c, 0x2f, 0x05,
+  0xa0,
 };
-const uint32_t font_48_1_len = 770;
 
 const uint8_t font_48_2[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0xca, 0x8c, 0x71, 0xbd, 0xd7, 0xe7, 0x5c, 0xef, 0x9d,
-  0xce, 0x79, 0xa5, 0x54, 0x6b, 0x8d, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x29, 0x45, 0xc6, 0x58, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xda, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x6b, 0x4d, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x08, 0x00, 0x00, 0x00, 0x00,
-  0x63, 0x0c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c, 0xb5, 0xb6, 0xc6, 0x58,
-  0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x20, 0x00, 0x00,
-  0x00, 0x00, 0xad, 0x55, 0xff, 0xff, 0xad, 0x55, 0x21, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x10, 0x82, 0xa5, 0x54, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x4d, 0x00, 0x00,
-  0x00, 0x00, 0x10, 0x82, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x20, 0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x14, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x84, 0x10, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x38, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x4a, 0x89, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xa5, 0x54, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xd6, 0xda, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7b, 0xcf, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x21, 0x04, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x29, 0x85, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xb5, 0xb6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x0b,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x31, 0x86, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x04, 0xef, 0x9d,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x84, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x18, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xae, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xf7, 0xde, 0x39, 0xc7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x04, 0xef, 0x9d, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb5, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xd6, 0xba, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x39, 0xc7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xad, 0x55,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x42, 0x08, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x21, 0x44,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xa5, 0x54, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9c, 0xf3, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x10, 0xa2, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x65, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x6b, 0x4d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x8c, 0x91, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xad, 0x95, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xce, 0x79, 0xbd, 0xd7, 0xbd, 0xd7,
-  0xbd, 0xd7, 0xbd, 0xd7, 0xbd, 0xd7, 0xbd, 0xd7, 0xbd, 0xd7, 0xbd, 0xd7, 0xbd, 0xd7, 0x84, 0x30,
-  0x00, 0x00, 0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0x96,
-  0x10, 0xa2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0x96,
-  0x29, 0x45, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0x96,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0x20, 0x05, 0x08, 0x0b, 0x1e, 0x0c, 0x0a, 0x07, 0x50, 0x02, 0x0c, 0x7f, 0x0d, 0x04, 0x20, 0x06,
+  0xbf, 0x04, 0x10, 0x06, 0x3f, 0x0e, 0x0b, 0x0c, 0x0e, 0x3f, 0x0d, 0x20, 0x0a, 0x0f, 0x0a, 0x02,
+  0x20, 0x01, 0x0a, 0x3f, 0x06, 0x10, 0x01, 0x05, 0x60, 0x0d, 0x2f, 0x0a, 0xa0, 0x08, 0x2f, 0x0c,
+  0xa0, 0x06, 0x2f, 0x0e, 0xa0, 0x05, 0x3f, 0xa0, 0x07, 0x2f, 0x0d, 0xa0, 0x0a, 0x2f, 0x0a, 0xa0,
+  0x0d, 0x2f, 0x07, 0x90, 0x02, 0x3f, 0x03, 0x90, 0x0a, 0x2f, 0x0b, 0x90, 0x03, 0x3f, 0x04, 0x90,
+  0x0b, 0x2f, 0x0c, 0x90, 0x06, 0x3f, 0x03, 0x80, 0x02, 0x0e, 0x2f, 0x08, 0x90, 0x0b, 0x2f, 0x0d,
+  0x90, 0x07, 0x3f, 0x03, 0x80, 0x02, 0x0e, 0x2f, 0x08, 0x90, 0x0b, 0x2f, 0x0d, 0x90, 0x05, 0x3f,
+  0x03, 0x90, 0x0d, 0x2f, 0x0a, 0x90, 0x04, 0x3f, 0x02, 0x90, 0x0a, 0x2f, 0x09, 0x90, 0x01, 0x3f,
+  0x03, 0x90, 0x06, 0x2f, 0x0e, 0xa0, 0x09, 0x2f, 0x0a, 0xa0, 0x0a, 0x2f, 0x06, 0xa0, 0x0c, 0x2f,
+  0x0c, 0x8b, 0x08, 0x00, 0x0e, 0xcf, 0x0a, 0x01, 0xdf, 0x0a, 0x02, 0xdf, 0x0a, 0xf0,
 };
-const uint32_t font_48_2_len = 1120;
 
 const uint8_t font_48_3[] = {
-  0x00, 0x00, 0x00, 0x00, 0x08, 0x61, 0x73, 0xae, 0xa5, 0x34, 0xce, 0x99, 0xf7, 0xbe, 0xdf, 0x1b,
-  0xb5, 0x96, 0x84, 0x30, 0x21, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x63, 0x2c, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x6b, 0x6d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x08, 0x61, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xef, 0x9d, 0xc6, 0x38, 0xa5, 0x54, 0xd6, 0xba,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x6b, 0x8d, 0xe7, 0x3c, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x52, 0xaa, 0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x20, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x6b, 0x8d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x00, 0x20, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x08, 0x41, 0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x45, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xce, 0x79, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x69, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xad, 0x95, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xbe, 0x17, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xcb, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xe7, 0x3c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3a, 0x07, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x31, 0x86, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0x08, 0x61, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xbd, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xc3,
-  0xad, 0x75, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x9d, 0x29, 0x45, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x45, 0x6b, 0x8d, 0x8c, 0x71, 0xb5, 0xb6, 0xef, 0x7d,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x0b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xdf, 0x1b, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x0b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xce, 0x79, 0x39, 0xe7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x0b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0xd2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x08, 0x61, 0x21, 0x24, 0x4a, 0x69, 0x73, 0xae,
-  0xe7, 0x3c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x10, 0x82, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x85, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x20, 0xde, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0xb2, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x00, 0x20,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x10, 0xa2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x21, 0x04,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x39, 0xe7,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0x9a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x28,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x21, 0x04,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x21, 0x44, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x00, 0x20,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x9c, 0xd3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xde, 0xfb, 0x00, 0x00,
-  0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x39, 0xe7, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00,
-  0x39, 0xc7, 0xff, 0xff, 0xd6, 0xda, 0x6b, 0x4d, 0x31, 0xa6, 0x08, 0x41, 0x00, 0x20, 0x29, 0x65,
-  0x84, 0x30, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c, 0x08, 0x61, 0x00, 0x00,
-  0x8c, 0x71, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0xf7, 0xde, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00, 0x00, 0x00,
-  0xd6, 0x9a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x7c, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x10, 0x82, 0x7b, 0xef, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xde, 0xfb, 0x39, 0xe7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x08, 0x41, 0x42, 0x28, 0x6b, 0x4d, 0x8c, 0x91, 0xad, 0x55, 0x84, 0x30,
-  0x5a, 0xcb, 0x31, 0x86, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0x10, 0x01, 0x07, 0x0a, 0x0c, 0x0f, 0x0d, 0x0a, 0x08, 0x02, 0x50, 0x06, 0x0e, 0x6f, 0x0e, 0x05,
+  0x30, 0x06, 0xaf, 0x07, 0x20, 0x01, 0x0e, 0x1f, 0x0e, 0x0c, 0x0a, 0x0d, 0x4f, 0x02, 0x20, 0x07,
+  0x0e, 0x05, 0x30, 0x05, 0x0e, 0x2f, 0x0a, 0x30, 0x01, 0x50, 0x07, 0x3f, 0xb0, 0x0e, 0x2f, 0x02,
+  0xa0, 0x0c, 0x2f, 0x05, 0xa0, 0x0a, 0x2f, 0x06, 0xa0, 0x0b, 0x2f, 0x05, 0xa0, 0x0e, 0x2f, 0x04,
+  0x90, 0x03, 0x3f, 0x01, 0x90, 0x0b, 0x2f, 0x0a, 0x80, 0x01, 0x0a, 0x2f, 0x0e, 0x02, 0x40, 0x02,
+  0x07, 0x08, 0x0b, 0x0e, 0x3f, 0x05, 0x50, 0x06, 0x5f, 0x0d, 0x04, 0x60, 0x06, 0x5f, 0x0c, 0x04,
+  0x60, 0x06, 0x7f, 0x09, 0x60, 0x01, 0x02, 0x05, 0x07, 0x0e, 0x3f, 0x07, 0x90, 0x01, 0x0a, 0x3f,
+  0x03, 0xa0, 0x0d, 0x2f, 0x09, 0xa0, 0x05, 0x2f, 0x0e, 0xa0, 0x01, 0x3f, 0x02, 0xa0, 0x0e, 0x2f,
+  0x04, 0xa0, 0x0c, 0x2f, 0x05, 0xa0, 0x0d, 0x2f, 0x04, 0xa0, 0x3f, 0x02, 0x90, 0x02, 0x3f, 0xa0,
+  0x09, 0x2f, 0x0d, 0x10, 0x05, 0x60, 0x04, 0x3f, 0x07, 0x00, 0x03, 0x0f, 0x0d, 0x06, 0x03, 0x10,
+  0x03, 0x08, 0x3f, 0x0e, 0x01, 0x00, 0x08, 0xbf, 0x06, 0x10, 0x0c, 0xaf, 0x08, 0x20, 0x01, 0x07,
+  0x0e, 0x6f, 0x0d, 0x04, 0x60, 0x04, 0x06, 0x09, 0x0a, 0x08, 0x05, 0x03, 0x50,
 };
-const uint32_t font_48_3_len = 1120;
 
 const uint8_t font_48_4[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x08, 0x41, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x00, 0x20, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x84, 0x30, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9c, 0xf3, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x45,
-  0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xa5, 0x54, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x29, 0x45, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xda, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xd6,
-  0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x44, 0xf7, 0xde, 0xff, 0xff,
-  0xff, 0xff, 0x39, 0xe7, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34,
-  0xff, 0xff, 0xff, 0xff, 0xbd, 0xf7, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x21, 0x04, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x49, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x8c, 0x71, 0xff, 0xff, 0xff, 0xff, 0xce, 0x99, 0x00, 0x00, 0x00, 0x00,
-  0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x61, 0xef, 0x7d, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xeb,
-  0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x6d, 0xff, 0xff, 0xff, 0xff,
-  0xdf, 0x1b, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xda,
-  0xff, 0xff, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x4a, 0x69, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x18, 0xc3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xb5, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xad, 0x55, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0x42, 0x08,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x8d, 0xff, 0xff, 0xff, 0xff,
-  0xde, 0xfb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x58,
-  0xff, 0xff, 0xff, 0xff, 0x84, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x21, 0x24, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x31, 0x86, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x7b, 0xef, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xff, 0xff, 0xff, 0xff, 0xce, 0x79,
-  0x84, 0x10, 0x84, 0x10, 0x84, 0x10, 0x84, 0x10, 0x84, 0x10, 0x84, 0x10, 0xd6, 0x9a, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x8c, 0x91, 0x84, 0x10, 0x84, 0x10, 0x31, 0x86, 0xf7, 0xde, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x63, 0x0c,
-  0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x63, 0x0c, 0xde, 0xfb, 0xdf, 0x1b, 0xdf, 0x1b, 0xdf, 0x1b, 0xdf, 0x1b, 0xdf, 0x1b,
-  0xdf, 0x1b, 0xdf, 0x1b, 0xdf, 0x1b, 0xdf, 0x1b, 0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xdf, 0x1b, 0xdf, 0x1b, 0xdf, 0x1b, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0x90, 0x34, 0xc0, 0x08, 0x3f, 0x02, 0xa0, 0x02, 0x4f, 0x02, 0xa0, 0x09, 0x4f, 0x02, 0x90, 0x02,
+  0x5f, 0x02, 0x90, 0x0a, 0x5f, 0x02, 0x80, 0x02, 0x2f, 0x0d, 0x2f, 0x02, 0x80, 0x0a, 0x1f, 0x0b,
+  0x0a, 0x2f, 0x02, 0x70, 0x02, 0x2f, 0x04, 0x0a, 0x2f, 0x02, 0x70, 0x0a, 0x1f, 0x0b, 0x00, 0x0a,
+  0x2f, 0x02, 0x60, 0x02, 0x2f, 0x04, 0x00, 0x0a, 0x2f, 0x02, 0x60, 0x08, 0x1f, 0x0c, 0x10, 0x0a,
+  0x2f, 0x02, 0x50, 0x01, 0x0e, 0x1f, 0x05, 0x10, 0x0a, 0x2f, 0x02, 0x50, 0x06, 0x1f, 0x0d, 0x20,
+  0x0a, 0x2f, 0x02, 0x50, 0x0d, 0x1f, 0x07, 0x20, 0x0a, 0x2f, 0x02, 0x40, 0x05, 0x2f, 0x01, 0x20,
+  0x0a, 0x2f, 0x02, 0x40, 0x0b, 0x1f, 0x0a, 0x30, 0x0a, 0x2f, 0x02, 0x30, 0x01, 0x2f, 0x04, 0x30,
+  0x0a, 0x2f, 0x02, 0x30, 0x07, 0x1f, 0x0d, 0x40, 0x0a, 0x2f, 0x02, 0x30, 0x0c, 0x1f, 0x08, 0x40,
+  0x0a, 0x2f, 0x02, 0x20, 0x02, 0x2f, 0x03, 0x40, 0x0a, 0x2f, 0x02, 0x20, 0x07, 0x1f, 0x0d, 0x50,
+  0x0a, 0x2f, 0x02, 0x20, 0x0d, 0x1f, 0x0c, 0x58, 0x0c, 0x2f, 0x09, 0x18, 0x03, 0xff, 0x0f, 0x06,
+  0xff, 0x0f, 0x06, 0x9d, 0x0e, 0x2f, 0x2d, 0x05, 0x90, 0x0a, 0x2f, 0x02, 0xc0, 0x0a, 0x2f, 0x02,
+  0xc0, 0x0a, 0x2f, 0x02, 0xc0, 0x0a, 0x2f, 0x02, 0xc0, 0x0a, 0x2f, 0x02, 0xc0, 0x0a, 0x2f, 0x02,
+  0xc0, 0x0a, 0x2f, 0x02, 0xc0, 0x0a, 0x2f, 0x02, 0xf0, 0x40,
 };
-const uint32_t font_48_4_len = 1260;
 
 const uint8_t font_48_5[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08,
-  0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x31, 0x86, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbd, 0xf7, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x84, 0x30, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbd, 0xf7, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x71, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbd, 0xf7, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x94, 0xb2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x6d,
-  0x52, 0xaa, 0x52, 0xaa, 0x52, 0xaa, 0x52, 0xaa, 0x52, 0xaa, 0x52, 0xaa, 0x39, 0xe7, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9c, 0xf3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x10, 0xa2,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x55, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x20,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb5, 0xb6, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbe, 0x17, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x3c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xda, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xde, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xce, 0x79, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xef, 0x7d, 0xff, 0xff, 0xff, 0xff, 0xbe, 0x17, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xb6, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xb6, 0x08, 0x41,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe,
-  0xb5, 0xb6, 0x6b, 0x6d, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0x5a, 0xeb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x4a, 0x89, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0xb2, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x04, 0x42, 0x48, 0x7b, 0xcf, 0xe7, 0x3c,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7c, 0x0f, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20,
-  0x6b, 0x4d, 0xef, 0x7d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x10, 0x82, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x4a, 0x69, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x84, 0x30, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x94, 0x92, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x00, 0x20,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x21, 0x24,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xda, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x48,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x58, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x89,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x21, 0x44,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x08, 0x61, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x00, 0x20,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x20, 0xd6, 0xda, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x34, 0x00, 0x00,
-  0x00, 0x00, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x08, 0x41, 0x9c, 0xf3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x29, 0x45, 0x00, 0x00,
-  0x00, 0x00, 0xad, 0x55, 0xc6, 0x38, 0x63, 0x0c, 0x31, 0x86, 0x10, 0x82, 0x29, 0x45, 0x5a, 0xeb,
-  0xce, 0x99, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x71, 0x00, 0x00, 0x00, 0x00,
-  0x08, 0x41, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x1b, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00,
-  0x52, 0xca, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbe, 0x17, 0x21, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x31, 0x86, 0xad, 0x55, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xf7, 0xbe, 0x73, 0x8e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0x63, 0x0c, 0x84, 0x30, 0xa5, 0x34, 0x94, 0xd2, 0x6b, 0x4d,
-  0x39, 0xe7, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0x20, 0x02, 0x94, 0x03, 0x30, 0x07, 0x9f, 0x0b, 0x30, 0x08, 0x9f, 0x0b, 0x30, 0x08, 0x9f, 0x0b,
+  0x30, 0x09, 0x2f, 0x06, 0x55, 0x04, 0x30, 0x09, 0x2f, 0x01, 0xa0, 0x0a, 0x2f, 0xb0, 0x0b, 0x2f,
+  0xb0, 0x0b, 0x1f, 0x0e, 0xb0, 0x0c, 0x1f, 0x0d, 0xb0, 0x0d, 0x1f, 0x0c, 0xb0, 0x0e, 0x1f, 0x0b,
+  0xb0, 0x2f, 0x0b, 0xa0, 0x01, 0x2f, 0x0b, 0xa0, 0x03, 0x4f, 0x0b, 0x06, 0x02, 0x60, 0x04, 0x7f,
+  0x05, 0x50, 0x05, 0x8f, 0x09, 0x60, 0x02, 0x04, 0x07, 0x0e, 0x4f, 0x08, 0x90, 0x06, 0x0e, 0x2f,
+  0x0e, 0x01, 0x90, 0x05, 0x3f, 0x08, 0xa0, 0x09, 0x2f, 0x0d, 0xa0, 0x03, 0x3f, 0xb0, 0x3f, 0x02,
+  0xa0, 0x0d, 0x2f, 0x04, 0xa0, 0x0c, 0x2f, 0x05, 0xa0, 0x0e, 0x2f, 0x02, 0x90, 0x01, 0x3f, 0xa0,
+  0x05, 0x2f, 0x0d, 0xa0, 0x0d, 0x2f, 0x0a, 0x90, 0x09, 0x3f, 0x02, 0x10, 0x0a, 0x0c, 0x06, 0x03,
+  0x01, 0x02, 0x05, 0x0c, 0x3f, 0x08, 0x20, 0xaf, 0x0d, 0x01, 0x10, 0x05, 0x9f, 0x0b, 0x02, 0x20,
+  0x03, 0x0a, 0x7f, 0x07, 0x60, 0x01, 0x06, 0x08, 0x0a, 0x09, 0x06, 0x04, 0x01, 0x50,
 };
-const uint32_t font_48_5_len = 1120;
 
 const uint8_t font_48_6[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x04, 0x42, 0x48, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x39, 0xe7, 0xad, 0x95, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0x63, 0x0c, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x45, 0xc6, 0x38,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7c, 0x0f, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x28, 0xef, 0x7d, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9d, 0x13, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x8a, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xc6, 0x38, 0x84, 0x10, 0x42, 0x48, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x04, 0xef, 0x7d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xe7, 0x3c, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xc6, 0x58, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xb6,
-  0x10, 0x82, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c, 0x10, 0xa2,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xd6, 0x9a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xeb, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x4a, 0x69, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x9c, 0xf3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xeb, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x29, 0x65, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x52, 0xaa, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x34, 0x00, 0x00, 0x31, 0x86, 0x52, 0x8a,
-  0x52, 0x8a, 0x18, 0xc3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x6b, 0x8d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xdf, 0x1b, 0x73, 0xce, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x84, 0x50, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0xd2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x9d, 0x13, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0x92, 0x00, 0x00, 0x00, 0x00,
-  0xbd, 0xd7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbd, 0xf7, 0x4a, 0x69, 0x10, 0x82, 0x08, 0x41,
-  0x42, 0x08, 0xce, 0x79, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0x10, 0xa2, 0x00, 0x00,
-  0xd6, 0xba, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x10, 0x82, 0xd6, 0xba, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00,
-  0xef, 0x7d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x21, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x6b, 0x6d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x3c, 0x00, 0x00,
-  0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x21, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x08, 0x61,
-  0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x65, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xef, 0x7d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x65,
-  0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xda, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x48,
-  0xd6, 0xba, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x39, 0xe7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x63, 0x0c,
-  0xbd, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xcb,
-  0x9c, 0xf3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x4d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0x9a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x08,
-  0x7c, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x71, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x21, 0x44,
-  0x4a, 0x69, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0x96, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x10, 0x82, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x08, 0x61,
-  0x10, 0x82, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xef, 0x9d, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x4a, 0x69, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00,
-  0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x84, 0x30, 0x00, 0x00,
-  0x00, 0x00, 0x5a, 0xeb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c, 0x31, 0x86, 0x00, 0x00,
-  0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x21, 0x04, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x20, 0xde, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0xce, 0x79,
-  0xe7, 0x3c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xd6, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x31, 0xa6, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x58, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0xc7, 0xde, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbe, 0x17, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0x63, 0x0c, 0x9c, 0xf3,
-  0x94, 0xb2, 0x5a, 0xeb, 0x29, 0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0xa0, 0x02, 0x04, 0x02, 0x90, 0x04, 0x0a, 0x2f, 0x06, 0x70, 0x02, 0x0c, 0x4f, 0x08, 0x60, 0x04,
+  0x0e, 0x5f, 0x0a, 0x50, 0x05, 0x4f, 0x0c, 0x08, 0x04, 0x01, 0x40, 0x02, 0x0e, 0x2f, 0x0e, 0x05,
+  0x80, 0x0c, 0x2f, 0x0b, 0x01, 0x80, 0x05, 0x2f, 0x0e, 0x01, 0x90, 0x0c, 0x2f, 0x05, 0x90, 0x05,
+  0x2f, 0x0b, 0xa0, 0x09, 0x2f, 0x05, 0xa0, 0x0d, 0x2f, 0x01, 0x90, 0x03, 0x2f, 0x0d, 0xa0, 0x05,
+  0x2f, 0x0a, 0x00, 0x03, 0x15, 0x01, 0x50, 0x07, 0x2f, 0x1d, 0x3f, 0x0d, 0x07, 0x30, 0x08, 0xaf,
+  0x09, 0x20, 0x0a, 0xbf, 0x09, 0x10, 0x0b, 0x2f, 0x0b, 0x05, 0x01, 0x00, 0x04, 0x0c, 0x3f, 0x01,
+  0x00, 0x0d, 0x2f, 0x02, 0x30, 0x01, 0x0d, 0x2f, 0x07, 0x00, 0x0e, 0x2f, 0x02, 0x40, 0x06, 0x2f,
+  0x0e, 0x00, 0x0e, 0x2f, 0x02, 0x40, 0x01, 0x3f, 0x01, 0x0e, 0x2f, 0x03, 0x50, 0x0e, 0x2f, 0x03,
+  0x0d, 0x2f, 0x03, 0x50, 0x0d, 0x2f, 0x04, 0x0d, 0x2f, 0x04, 0x50, 0x0c, 0x2f, 0x06, 0x0b, 0x2f,
+  0x04, 0x50, 0x0c, 0x2f, 0x05, 0x09, 0x2f, 0x06, 0x50, 0x0c, 0x2f, 0x04, 0x08, 0x2f, 0x08, 0x50,
+  0x0d, 0x2f, 0x02, 0x05, 0x2f, 0x0a, 0x40, 0x01, 0x3f, 0x11, 0x2f, 0x0e, 0x01, 0x30, 0x05, 0x2f,
+  0x0d, 0x10, 0x0c, 0x2f, 0x07, 0x30, 0x0a, 0x2f, 0x08, 0x10, 0x05, 0x2f, 0x0e, 0x03, 0x10, 0x06,
+  0x3f, 0x02, 0x20, 0x0d, 0x3f, 0x0c, 0x0e, 0x3f, 0x0b, 0x30, 0x03, 0x8f, 0x0c, 0x01, 0x40, 0x03,
+  0x0d, 0x5f, 0x0b, 0x01, 0x70, 0x03, 0x06, 0x19, 0x05, 0x02, 0x40,
 };
-const uint32_t font_48_6_len = 1120;
 
 const uint8_t font_48_7[] = {
-  0x31, 0xa6, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08,
-  0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08,
-  0x08, 0x41, 0xd6, 0xba, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x21, 0x04, 0xd6, 0xba, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x21, 0x04, 0xd6, 0xba, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x21, 0x04, 0x4a, 0x89, 0x5b, 0x0b, 0x5b, 0x0b, 0x5b, 0x0b,
-  0x5b, 0x0b, 0x5b, 0x0b, 0x5b, 0x0b, 0x5b, 0x0b, 0x5b, 0x0b, 0x5b, 0x0b, 0x5b, 0x0b, 0xc6, 0x38,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xce, 0x99, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x82,
-  0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x49, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x73, 0xae, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x20, 0xe7, 0x3c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x89, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x5a, 0xcb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xb5, 0xb6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x4d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0x10, 0x82,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xae, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x14,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x42, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x45, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xe7, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xae, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x94, 0xb2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbe, 0x17, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x42, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0xa2, 0xf7, 0xde,
-  0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xad, 0x95, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xa5, 0x54, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x8d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xe7, 0x3c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x31, 0x86, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x29, 0x45, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x63, 0x2c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0x96, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x73, 0xae,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x3c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xef, 0x9d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x69, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xc6, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xef, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x55,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x84, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xde, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x63, 0x4c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x20, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x49, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x18, 0xe3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x45, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x31, 0xc6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x08, 0x41,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x8a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x4d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xce, 0x59, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0x03, 0xe4, 0x00, 0x0d, 0xef, 0x02, 0x0d, 0xef, 0x02, 0x0d, 0xef, 0x02, 0x05, 0x96, 0x0c, 0x2f,
+  0x0c, 0xa0, 0x01, 0x0e, 0x2f, 0x04, 0xa0, 0x07, 0x2f, 0x0c, 0xb0, 0x0e, 0x2f, 0x05, 0xa0, 0x05,
+  0x2f, 0x0d, 0xb0, 0x0b, 0x2f, 0x06, 0xa0, 0x01, 0x3f, 0x01, 0xa0, 0x07, 0x2f, 0x0a, 0xb0, 0x0c,
+  0x2f, 0x04, 0xa0, 0x02, 0x2f, 0x0e, 0xb0, 0x07, 0x2f, 0x09, 0xb0, 0x0b, 0x2f, 0x04, 0xa0, 0x01,
+  0x2f, 0x0e, 0xb0, 0x05, 0x2f, 0x0a, 0xb0, 0x0a, 0x2f, 0x07, 0xb0, 0x0e, 0x2f, 0x03, 0xa0, 0x02,
+  0x2f, 0x0e, 0xb0, 0x06, 0x2f, 0x0a, 0xb0, 0x0a, 0x2f, 0x07, 0xb0, 0x0e, 0x2f, 0x03, 0xa0, 0x01,
+  0x2f, 0x0e, 0xb0, 0x05, 0x2f, 0x0c, 0xb0, 0x07, 0x2f, 0x0a, 0xb0, 0x0a, 0x2f, 0x08, 0xb0, 0x0d,
+  0x2f, 0x06, 0xb0, 0x3f, 0x04, 0xa0, 0x02, 0x3f, 0x02, 0xa0, 0x03, 0x3f, 0xb0, 0x05, 0x2f, 0x0e,
+  0xb0, 0x06, 0x2f, 0x0c, 0xf0, 0x90,
 };
-const uint32_t font_48_7_len = 1190;
 
 const uint8_t font_48_8[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb, 0xad, 0x75, 0xd6, 0xba, 0xf7, 0xde,
-  0xd6, 0xda, 0xad, 0x95, 0x63, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0xbe, 0x17, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x58, 0x31, 0x86, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x10, 0xa2, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0x5a, 0xcb, 0x39, 0xc7,
-  0x6b, 0x4d, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00,
-  0x4a, 0x69, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xde, 0xfb, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x21, 0x24, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x08, 0x00, 0x00,
-  0x84, 0x50, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xeb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x9d, 0x13, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x73, 0xae, 0x00, 0x00,
-  0xb5, 0xb6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x65, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x63, 0x2c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9d, 0x13, 0x00, 0x00,
-  0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x4a, 0x69, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xce, 0x59, 0x00, 0x00,
-  0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x39, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00,
-  0xde, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x52, 0x8a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xb6, 0x00, 0x00,
-  0xbe, 0x17, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x69, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x6b, 0x6d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0x92, 0x00, 0x00,
-  0x7b, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xb5, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x39, 0xc7, 0x00, 0x00,
-  0x21, 0x04, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xef, 0x9d, 0x18, 0xc3, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x29, 0x45, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xce, 0x79, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x94, 0xd2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbd, 0xd7, 0x00, 0x00, 0x00, 0x00,
-  0x08, 0x41, 0xce, 0x99, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x42, 0x08, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x20, 0xbd, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x54, 0x08, 0x41,
-  0x94, 0xb2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x10, 0x82, 0xd6, 0xba, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xda,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9d, 0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x45, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xc6, 0x58, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xad, 0x55, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xb5, 0xb6, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xad, 0x95, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xb6, 0xf7, 0xbe,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x7b, 0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xd6, 0x00, 0x00, 0x39, 0xe7,
-  0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x31, 0xa6, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x1b, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00,
-  0x31, 0x86, 0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x14, 0x00, 0x00, 0x00, 0x00,
-  0xad, 0x75, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x4a, 0x49, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x39, 0xe7, 0x00, 0x00,
-  0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xde, 0xfb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xd6, 0x00, 0x00,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x91, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x08, 0x41,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x73, 0x8e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xef, 0x7d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x65,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xeb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbe, 0x17, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x49,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x63, 0x4c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbe, 0x17, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x65,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x84, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x00, 0x20,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xce, 0x99, 0x00, 0x00,
-  0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x8c, 0x91, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9c, 0xf3, 0x00, 0x00,
-  0x9c, 0xd3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xde, 0xfb, 0x21, 0x24, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x63, 0x0c, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x18, 0xe3, 0x00, 0x00,
-  0x10, 0xa2, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0xad, 0x75, 0x8c, 0x71,
-  0xbe, 0x17, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x4d, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x42, 0x28, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9d, 0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x10, 0xa2, 0xb5, 0x96, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xe7, 0x3c, 0x4a, 0x69, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x45, 0x5a, 0xeb, 0x8c, 0x71, 0xa5, 0x34,
-  0x73, 0xce, 0x42, 0x48, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0x30, 0x05, 0x0a, 0x0d, 0x0f, 0x0d, 0x0a, 0x06, 0x60, 0x03, 0x0b, 0x6f, 0x0c, 0x03, 0x30, 0x01,
+  0x0e, 0x8f, 0x0e, 0x01, 0x20, 0x0a, 0x2f, 0x0d, 0x05, 0x03, 0x06, 0x0e, 0x2f, 0x0a, 0x10, 0x05,
+  0x2f, 0x0d, 0x30, 0x02, 0x3f, 0x04, 0x00, 0x08, 0x2f, 0x05, 0x40, 0x0a, 0x2f, 0x07, 0x00, 0x0b,
+  0x2f, 0x03, 0x40, 0x06, 0x2f, 0x0a, 0x00, 0x0d, 0x2f, 0x50, 0x05, 0x2f, 0x0c, 0x00, 0x3f, 0x01,
+  0x40, 0x04, 0x2f, 0x0d, 0x00, 0x0d, 0x2f, 0x02, 0x40, 0x05, 0x2f, 0x0b, 0x00, 0x0b, 0x2f, 0x05,
+  0x40, 0x06, 0x2f, 0x09, 0x00, 0x07, 0x2f, 0x0a, 0x40, 0x0b, 0x2f, 0x03, 0x00, 0x02, 0x2f, 0x0e,
+  0x01, 0x20, 0x02, 0x2f, 0x0c, 0x20, 0x09, 0x2f, 0x0b, 0x20, 0x0c, 0x2f, 0x04, 0x30, 0x0b, 0x2f,
+  0x0a, 0x00, 0x09, 0x2f, 0x06, 0x40, 0x01, 0x0d, 0x2f, 0x0d, 0x2f, 0x0a, 0x60, 0x02, 0x5f, 0x0c,
+  0x70, 0x0a, 0x5f, 0x0b, 0x60, 0x0a, 0x2f, 0x0b, 0x3f, 0x0a, 0x40, 0x07, 0x2f, 0x0b, 0x00, 0x04,
+  0x0e, 0x2f, 0x0a, 0x20, 0x03, 0x2f, 0x0d, 0x01, 0x10, 0x03, 0x0e, 0x2f, 0x0a, 0x10, 0x0a, 0x2f,
+  0x04, 0x30, 0x04, 0x3f, 0x04, 0x00, 0x2f, 0x0d, 0x50, 0x0a, 0x2f, 0x0b, 0x00, 0x2f, 0x09, 0x50,
+  0x03, 0x3f, 0x00, 0x2f, 0x07, 0x60, 0x0e, 0x2f, 0x03, 0x2f, 0x05, 0x60, 0x0b, 0x2f, 0x04, 0x2f,
+  0x06, 0x60, 0x0b, 0x2f, 0x03, 0x2f, 0x08, 0x60, 0x0d, 0x2f, 0x00, 0x2f, 0x0b, 0x50, 0x01, 0x2f,
+  0x0c, 0x00, 0x3f, 0x03, 0x40, 0x09, 0x2f, 0x09, 0x00, 0x09, 0x2f, 0x0d, 0x02, 0x20, 0x06, 0x2f,
+  0x0e, 0x02, 0x00, 0x01, 0x0e, 0x2f, 0x0e, 0x0a, 0x08, 0x0b, 0x3f, 0x06, 0x20, 0x04, 0x0e, 0x8f,
+  0x0a, 0x40, 0x01, 0x0a, 0x5f, 0x0e, 0x05, 0x70, 0x02, 0x05, 0x08, 0x0a, 0x07, 0x04, 0x01, 0x40,
 };
-const uint32_t font_48_8_len = 1120;
 
 const uint8_t font_48_9[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0xa2, 0x6b, 0x6d, 0xa5, 0x34, 0xde, 0xfb,
-  0xef, 0x9d, 0xbd, 0xf7, 0x84, 0x30, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0xd6, 0xda, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x34, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x21, 0x24, 0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0xb2, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xad, 0x95, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x9d, 0xa5, 0x54,
-  0x7b, 0xcf, 0xbe, 0x17, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x39, 0xe7, 0x00, 0x00,
-  0x00, 0x00, 0x18, 0xc3, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x48, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xad, 0x55, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xad, 0x55, 0x00, 0x00,
-  0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x10, 0x82,
-  0x00, 0x00, 0xce, 0x59, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x63, 0x0c, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb5, 0xb6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x69,
-  0x00, 0x00, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x21, 0x44, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x51,
-  0x00, 0x20, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xb6,
-  0x18, 0xe3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0xc6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xce, 0x99,
-  0x31, 0xa6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x9d,
-  0x31, 0x86, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x10, 0xa2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x82, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x00, 0x00, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x21, 0x04, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x61, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x00, 0x00, 0xd6, 0xba, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x63, 0x2c, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x41, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x00, 0x00, 0x9c, 0xf3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x61, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x00, 0x00, 0x29, 0x45, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0xa2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe,
-  0x00, 0x00, 0x00, 0x00, 0xb5, 0xb6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x34,
-  0x63, 0x2c, 0x52, 0xaa, 0x84, 0x10, 0xe7, 0x3c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xde, 0xfb,
-  0x00, 0x00, 0x00, 0x00, 0x31, 0x86, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x38,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x44, 0xde, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0xa2, 0x84, 0x10, 0xb5, 0xd6, 0xef, 0x7d,
-  0xf7, 0xbe, 0xc6, 0x18, 0x8c, 0x71, 0xad, 0x75, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0xb2,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x9d, 0x13, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7b, 0xcf,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce, 0x99, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x28,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xef, 0x9d, 0x00, 0x20,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x6b, 0x6d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0x96, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x08, 0x41, 0xd6, 0xda, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x8c, 0x91, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xda, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x3a, 0x07, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x63, 0x0c, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa,
-  0xe7, 0x3c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0xb5, 0xd6, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x3c, 0x18, 0xc3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x63, 0x2c, 0xad, 0x75, 0xe7, 0x3c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c, 0x39, 0xc7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xb5, 0x96, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xce, 0x99, 0x21, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x94, 0xb2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c,
-  0x7c, 0x0f, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x73, 0xae, 0xef, 0x9d, 0xce, 0x79, 0xa5, 0x34, 0x63, 0x0c, 0x08, 0x41,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0x30, 0x01, 0x06, 0x0a, 0x0d, 0x0e, 0x0b, 0x08, 0x04, 0x60, 0x02, 0x0d, 0x6f, 0x0a, 0x40, 0x02,
+  0x0d, 0x8f, 0x09, 0x30, 0x0a, 0x2f, 0x0e, 0x0a, 0x07, 0x0b, 0x3f, 0x04, 0x10, 0x01, 0x3f, 0x04,
+  0x20, 0x0a, 0x2f, 0x0a, 0x10, 0x07, 0x2f, 0x0a, 0x30, 0x03, 0x3f, 0x01, 0x00, 0x0c, 0x2f, 0x06,
+  0x40, 0x0b, 0x2f, 0x05, 0x00, 0x0e, 0x2f, 0x02, 0x40, 0x07, 0x2f, 0x08, 0x00, 0x3f, 0x50, 0x05,
+  0x2f, 0x0b, 0x02, 0x3f, 0x50, 0x03, 0x2f, 0x0c, 0x03, 0x2f, 0x0e, 0x50, 0x02, 0x2f, 0x0e, 0x03,
+  0x3f, 0x50, 0x01, 0x3f, 0x01, 0x3f, 0x01, 0x40, 0x01, 0x3f, 0x00, 0x3f, 0x02, 0x40, 0x01, 0x3f,
+  0x00, 0x0d, 0x2f, 0x06, 0x50, 0x3f, 0x00, 0x09, 0x2f, 0x0b, 0x40, 0x01, 0x3f, 0x00, 0x02, 0x3f,
+  0x06, 0x30, 0x01, 0x3f, 0x10, 0x0b, 0x3f, 0x0a, 0x06, 0x05, 0x08, 0x0e, 0x2f, 0x0d, 0x10, 0x03,
+  0x0e, 0xaf, 0x0c, 0x20, 0x02, 0x0d, 0x9f, 0x0a, 0x30, 0x01, 0x08, 0x0b, 0x0e, 0x0f, 0x0b, 0x08,
+  0x0a, 0x2f, 0x09, 0xa0, 0x0a, 0x2f, 0x07, 0xa0, 0x0c, 0x2f, 0x04, 0x90, 0x01, 0x2f, 0x0e, 0xa0,
+  0x06, 0x2f, 0x0a, 0xa0, 0x0d, 0x2f, 0x05, 0x90, 0x09, 0x2f, 0x0d, 0x90, 0x04, 0x3f, 0x06, 0x80,
+  0x05, 0x0e, 0x2f, 0x0b, 0x70, 0x03, 0x0b, 0x3f, 0x0e, 0x01, 0x40, 0x06, 0x0a, 0x0e, 0x4f, 0x0e,
+  0x03, 0x50, 0x0a, 0x5f, 0x0c, 0x02, 0x60, 0x09, 0x3f, 0x0e, 0x08, 0x01, 0x70, 0x07, 0x0e, 0x0c,
+  0x0a, 0x06, 0xf0, 0x80,
 };
-const uint32_t font_48_9_len = 1120;
 
 const uint8_t font_48_dot[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x21, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x41,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0xa6, 0xd6, 0xba, 0xff, 0xff, 0xdf, 0x1b,
-  0x4a, 0x69, 0x00, 0x00, 0x00, 0x00, 0xbe, 0x17, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x3c,
-  0x00, 0x20, 0x21, 0x04, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x69,
-  0x08, 0x41, 0xef, 0x7d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x45, 0x00, 0x00,
-  0x8c, 0x71, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xd6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x5a, 0xeb, 0x8c, 0x91, 0x6b, 0x6d, 0x08, 0x41, 0x00, 0x00
+  0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x30, 0x01, 0x50, 0x01, 0x50, 0x02, 0x50, 0x01, 0xf0, 0xf0, 0xf0,
+  0xf0, 0xf0, 0xf0, 0x10, 0x03, 0x0d, 0x0f, 0x0d, 0x05, 0x10, 0x0b, 0x2f, 0x0e, 0x00, 0x02, 0x4f,
+  0x05, 0x00, 0x0e, 0x3f, 0x02, 0x00, 0x08, 0x2f, 0x0b, 0x20, 0x05, 0x09, 0x06, 0x10,
 };
-const uint32_t font_48_dot_len = 490;
 
 const uint8_t font_48_v[] = {
-  0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x21, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x21, 0x04, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x39, 0xc7, 0xde, 0xfb, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x9c, 0xd3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9c, 0xd3,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xb6, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xc6, 0x58, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x58, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x7c, 0x0f, 0x6b, 0x6d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x49,
-  0x31, 0xc6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x65, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x29, 0x65, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x10, 0xa2, 0x00, 0x20, 0xf7, 0xbe,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xd6, 0xda, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x58, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x51, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xa5, 0x34, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x91, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xd6,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xb5, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00,
-  0x00, 0x00, 0x5a, 0xcb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xef, 0x7d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x21, 0x24,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x45, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xf7, 0xbe, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x5c, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x63, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x0c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x38,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x55, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x94, 0xd2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x94, 0xd2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x84, 0x30, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x6b, 0x4d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xce, 0x99, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce, 0x99,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x29, 0x65, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x61, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff,
-  0xf7, 0xde, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x5c,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x38, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x55, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x7b, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x84, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x4d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbd, 0xf7,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xf7, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x29, 0x45, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0x00, 0x20, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde,
-  0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3a, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x3a, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x38, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xef,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7c, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xf7, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x39, 0xc7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x10, 0xa2, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0x08, 0x41,
-  0x00, 0x00, 0x00, 0x00, 0x08, 0x41, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xce, 0x59, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x08, 0x00, 0x00, 0x00, 0x00,
-  0x42, 0x08, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x84, 0x10,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x84, 0x30, 0x00, 0x00, 0x00, 0x00, 0x84, 0x30, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x5a, 0xeb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0xe7, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xce, 0x59, 0x00, 0x00, 0x00, 0x00, 0xce, 0x59, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x18, 0xc3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xef, 0x7d, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde,
-  0x10, 0xa2, 0x10, 0xa2, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xce, 0x79, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xa5, 0x54, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xca, 0x52, 0xca,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x84, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x5a, 0xeb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9c, 0xf3, 0x9c, 0xf3, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x39, 0xc7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x82, 0xf7, 0xde,
-  0xff, 0xff, 0xff, 0xff, 0xdf, 0x1b, 0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x3c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbe, 0x17, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9c, 0xf3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xae, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x4a, 0x89, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x21, 0x24, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe,
-  0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xd6, 0xda, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0x96, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x51, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x63, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00
+  0x34, 0x02, 0xb0, 0x02, 0x24, 0x03, 0x0d, 0x2f, 0x09, 0xb0, 0x09, 0x2f, 0x0b, 0x0a, 0x2f, 0x0c,
+  0xb0, 0x0c, 0x2f, 0x08, 0x06, 0x3f, 0xb0, 0x3f, 0x04, 0x03, 0x3f, 0x03, 0x90, 0x03, 0x3f, 0x01,
+  0x00, 0x3f, 0x05, 0x90, 0x05, 0x2f, 0x0d, 0x10, 0x0c, 0x2f, 0x08, 0x90, 0x08, 0x2f, 0x0a, 0x10,
+  0x09, 0x2f, 0x0b, 0x90, 0x0b, 0x2f, 0x06, 0x10, 0x05, 0x2f, 0x0e, 0x90, 0x0e, 0x2f, 0x03, 0x10,
+  0x02, 0x3f, 0x02, 0x70, 0x02, 0x3f, 0x30, 0x0e, 0x2f, 0x06, 0x70, 0x06, 0x2f, 0x0c, 0x30, 0x0a,
+  0x2f, 0x09, 0x70, 0x09, 0x2f, 0x08, 0x30, 0x06, 0x2f, 0x0c, 0x70, 0x0c, 0x2f, 0x04, 0x30, 0x03,
+  0x3f, 0x01, 0x50, 0x01, 0x3f, 0x50, 0x0e, 0x2f, 0x04, 0x50, 0x04, 0x2f, 0x0c, 0x50, 0x0a, 0x2f,
+  0x07, 0x50, 0x07, 0x2f, 0x08, 0x50, 0x06, 0x2f, 0x0b, 0x50, 0x0b, 0x2f, 0x04, 0x50, 0x02, 0x3f,
+  0x50, 0x3f, 0x70, 0x0e, 0x2f, 0x04, 0x30, 0x04, 0x2f, 0x0c, 0x70, 0x0a, 0x2f, 0x07, 0x30, 0x07,
+  0x2f, 0x08, 0x70, 0x05, 0x2f, 0x0b, 0x30, 0x0b, 0x2f, 0x03, 0x70, 0x01, 0x3f, 0x30, 0x2f, 0x0e,
+  0x90, 0x0c, 0x2f, 0x04, 0x10, 0x04, 0x2f, 0x0a, 0x90, 0x08, 0x2f, 0x08, 0x10, 0x08, 0x2f, 0x05,
+  0x90, 0x04, 0x2f, 0x0c, 0x10, 0x0c, 0x2f, 0x01, 0xa0, 0x0e, 0x2f, 0x11, 0x2f, 0x0c, 0xb0, 0x0a,
+  0x2f, 0x15, 0x2f, 0x08, 0xb0, 0x05, 0x2f, 0x19, 0x2f, 0x03, 0xb0, 0x01, 0x2f, 0x1d, 0x1f, 0x0e,
+  0xd0, 0x0b, 0x5f, 0x09, 0xd0, 0x07, 0x5f, 0x05, 0xd0, 0x02, 0x5f, 0xf0, 0x0d, 0x3f, 0x0a, 0xf0,
+  0x08, 0x3f, 0x06, 0xf0, 0xd0,
 };
-const uint32_t font_48_v_len = 1540;
 
 const uint8_t font_48_a[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x08, 0x61, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x42, 0x08, 0x18, 0xc3, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x8d, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0xb2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x10, 0xa2, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x0c,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x84, 0x30, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x95, 0xff, 0xff, 0xff, 0xff,
-  0xf7, 0xbe, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x08, 0x41, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xbd, 0xf7, 0xbd, 0xf7,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x21, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x52, 0x8a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x73, 0xae, 0x73, 0xae, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x73, 0xae, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9c, 0xf3, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x29, 0x45, 0x29, 0x45, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x18,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x3c, 0xff, 0xff, 0xff, 0xff, 0xde, 0xfb,
-  0x00, 0x00, 0x00, 0x00, 0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x10, 0x82, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x31, 0x86, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0xb2, 0x00, 0x00, 0x00, 0x00,
-  0x94, 0xb2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xcf,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x69, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x69, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x9d, 0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x18, 0xff, 0xff, 0xff, 0xff,
-  0xf7, 0xbe, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x08, 0x41, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff,
-  0xe7, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x10, 0x82, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xd6, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb5, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x31, 0x86,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x52, 0xaa, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x73, 0xce, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7b, 0xcf, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9d, 0x13, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0xc7,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xdf, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xef, 0x9d, 0xff, 0xff,
-  0xff, 0xff, 0xf7, 0xde, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x21, 0x24, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0x96, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb5, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x42, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x2c,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x73, 0x8e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x84, 0x50, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x54, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x31, 0x86, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x39, 0xc7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x3c, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xef, 0x9d,
-  0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x29, 0x45, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xb6, 0x10, 0xa2, 0x10, 0xa2, 0x10, 0xa2,
-  0x10, 0xa2, 0x10, 0xa2, 0x10, 0xa2, 0x10, 0xa2, 0x10, 0xa2, 0xbe, 0x17, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x4a, 0x69, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x6d, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x71,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xce, 0x59, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x21, 0x24,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xda, 0x7b, 0xef, 0x7b, 0xef, 0x7b, 0xef, 0x7b, 0xef,
-  0x7b, 0xef, 0x7b, 0xef, 0x7b, 0xef, 0x7b, 0xef, 0x7b, 0xef, 0x7b, 0xef, 0xd6, 0xda, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x8c, 0x71, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x71, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x7b, 0xef, 0x00, 0x00, 0x00, 0x00, 0x94, 0xb2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xcb,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xb6, 0x00, 0x00,
-  0x00, 0x00, 0xce, 0x79, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x21, 0x24, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x29, 0x45, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x00, 0x00, 0x08, 0x61, 0xf7, 0xde,
-  0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xef, 0x9d,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x29, 0x45, 0x42, 0x08, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xbe, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0x63, 0x2c, 0x7b, 0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0x92, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x94, 0xb2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9c, 0xf3,
-  0xb5, 0x96, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x63, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x63, 0x4c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0xba, 0xe7, 0x5c, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x31, 0xc6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0xc7,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00
+  0x70, 0x01, 0x34, 0x01, 0xf0, 0x07, 0x3f, 0x09, 0xf0, 0x0b, 0x3f, 0x0d, 0xe0, 0x01, 0x5f, 0x03,
+  0xd0, 0x06, 0x5f, 0x08, 0xd0, 0x0a, 0x5f, 0x0d, 0xd0, 0x2f, 0x1b, 0x2f, 0x02, 0xb0, 0x05, 0x2f,
+  0x17, 0x2f, 0x07, 0xb0, 0x09, 0x2f, 0x12, 0x2f, 0x0b, 0xb0, 0x0e, 0x1f, 0x0d, 0x10, 0x0d, 0x2f,
+  0x01, 0x90, 0x03, 0x2f, 0x09, 0x10, 0x09, 0x2f, 0x05, 0x90, 0x07, 0x2f, 0x05, 0x10, 0x05, 0x2f,
+  0x0a, 0x90, 0x0b, 0x2f, 0x30, 0x2f, 0x0e, 0x80, 0x01, 0x2f, 0x0b, 0x30, 0x0b, 0x2f, 0x03, 0x70,
+  0x05, 0x2f, 0x07, 0x30, 0x07, 0x2f, 0x07, 0x70, 0x0a, 0x2f, 0x03, 0x30, 0x03, 0x2f, 0x0b, 0x70,
+  0x0d, 0x1f, 0x0e, 0x50, 0x0e, 0x2f, 0x01, 0x50, 0x02, 0x2f, 0x0a, 0x50, 0x0b, 0x2f, 0x04, 0x50,
+  0x06, 0x2f, 0x07, 0x50, 0x07, 0x2f, 0x08, 0x50, 0x0a, 0x2f, 0x03, 0x50, 0x03, 0x2f, 0x0c, 0x50,
+  0x0e, 0x1f, 0x0e, 0x70, 0x0e, 0x2f, 0x01, 0x30, 0x02, 0x2f, 0x0b, 0x71, 0x0b, 0x2f, 0x05, 0x30,
+  0x06, 0xff, 0x08, 0x30, 0x0a, 0xff, 0x0c, 0x30, 0x0e, 0xff, 0x0f, 0x01, 0x10, 0x02, 0x2f, 0x0d,
+  0x97, 0x0d, 0x2f, 0x04, 0x10, 0x05, 0x2f, 0x08, 0x90, 0x08, 0x2f, 0x07, 0x10, 0x09, 0x2f, 0x05,
+  0x90, 0x05, 0x2f, 0x0b, 0x10, 0x0c, 0x2f, 0x02, 0x90, 0x02, 0x2f, 0x0e, 0x00, 0x01, 0x2f, 0x0e,
+  0xb0, 0x0e, 0x2f, 0x02, 0x04, 0x2f, 0x0b, 0xb0, 0x0c, 0x2f, 0x06, 0x07, 0x2f, 0x09, 0xb0, 0x09,
+  0x2f, 0x09, 0x0a, 0x2f, 0x06, 0xb0, 0x06, 0x2f, 0x0d, 0x0e, 0x2f, 0x03, 0xb0, 0x03, 0x3f, 0xf0,
+  0x50,
 };
-const uint32_t font_48_a_len = 1540;
 
 const uint8_t font_48_widths[13] = {
   16, 
@@ -989,34 +221,69 @@ const uint8_t font_48_widths[13] = {
  };
 
 const uint16_t font_48_sizes[13] = {
-  1120, 
-  770, 
-  1120, 
-  1120, 
-  1260, 
-  1120, 
-  1120, 
-  1190, 
-  1120, 
-  1120, 
-  490, 
-  1540, 
-  1540, 
+  235, 
+  161, 
+  158, 
+  189, 
+  202, 
+  158, 
+  219, 
+  134, 
+  256, 
+  212, 
+  46, 
+  229, 
+  225, 
  };
 
-const uint16_t *font_48_pix[13] = {
-  (uint16_t*) &font_48_0, 
-  (uint16_t*) &font_48_1, 
-  (uint16_t*) &font_48_2, 
-  (uint16_t*) &font_48_3, 
-  (uint16_t*) &font_48_4, 
-  (uint16_t*) &font_48_5, 
-  (uint16_t*) &font_48_6, 
-  (uint16_t*) &font_48_7, 
-  (uint16_t*) &font_48_8, 
-  (uint16_t*) &font_48_9, 
-  (uint16_t*) &font_48_dot, 
-  (uint16_t*) &font_48_v, 
-  (uint16_t*) &font_48_a, 
+const uint8_t *font_48_pix[13] = {
+  font_48_0, 
+  font_48_1, 
+  font_48_2, 
+  font_48_3, 
+  font_48_4, 
+  font_48_5, 
+  font_48_6, 
+  font_48_7, 
+  font_48_8, 
+  font_48_9, 
+  font_48_dot, 
+  font_48_v, 
+  font_48_a, 
  };
 
+const uint8_t font_48_index[] = {
+  0x0a, 0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0x0c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0b,
+};
+
+const uint8_t font_48_advances[13] = {
+  19, 
+  14, 
+  19, 
+  19, 
+  21, 
+  19, 
+  19, 
+  20, 
+  19, 
+  19, 
+  10, 
+  25, 
+  25, 
+ };
+
+const font_t font_48 = {
+  .size = 48,
+  .height = 35,
+  .max_width = 22,
+  .digit_width = 18,
+  .first_code = 46,
+  .num_codes = 41,
+  .index = font_48_index,
+  .widths = font_48_widths,
+  .advances = font_48_advances,
+  .pix = font_48_pix,
+  .palette = font_48_palette,
+};
@@ -1,31 +1,23 @@
+#include "font.h"
 extern const uint32_t font_48_height;
 extern const uint32_t font_48_num_glyphs;
+extern const uint8_t font_48_palette[];
 extern const uint8_t font_48_0[];
-extern const uint32_t font_48_0_len;
 extern const uint8_t font_48_1[];
-extern const uint32_t font_48_1_len;
 extern const uint8_t font_48_2[];
-extern const uint32_t font_48_2_len;
 extern const uint8_t font_48_3[];
-extern const uint32_t font_48_3_len;
 extern const uint8_t font_48_4[];
-extern const uint32_t font_48_4_len;
 extern const uint8_t font_48_5[];
-extern const uint32_t font_48_5_len;
 extern const uint8_t font_48_6[];
-extern const uint32_t font_48_6_len;
 extern const uint8_t font_48_7[];
-extern const uint32_t font_48_7_len;
 extern const uint8_t font_48_8[];
-extern const uint32_t font_48_8_len;
 extern const uint8_t font_48_9[];
-extern const uint32_t font_48_9_len;
 extern const uint8_t font_48_dot[];
-extern const uint32_t font_48_dot_len;
 extern const uint8_t font_48_v[];
-extern const uint32_t font_48_v_len;
 extern const uint8_t font_48_a[];
-extern const uint32_t font_48_a_len;
 extern const uint8_t font_48_widths[13];
 extern const uint16_t font_48_sizes[13];
-extern const uint16_t *font_48_pix[13];
+extern const uint8_t *font_48_pix[13];
+extern const uint8_t font_48_index[];
+extern const uint8_t font_48_advances[13];
+extern const font_t font_48;
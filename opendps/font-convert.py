@@ -3,7 +3,10 @@
 import subprocess
 from subprocess import call
 import sys
+import pack565
 
+# Index of the code points without a glyph, see font.h
+NO_GLYPH = 0xff
 
 # Execute cmd in a shell returning stdout
 def shell(cmd):
@@ -16,6 +19,46 @@ def image_size(fname):
 	(width, height) = info.split(",")[1].split("x")
 	return (int(width), int(height))
 
+# Return the C name of the glyph of a character
+def glyph_name(ch):
+	names = {'.': 'dot', 'V': 'v', 'A': 'a'}
+	if ch.isdigit():
+		return ch
+	return names.get(ch, "x%02x" % (ord(ch)))
+
+# Output the glyph index, the metrics and the descriptor of the font, see font.h
+def write_metrics(f, characters, glyph_widths, font_size, height):
+	first = min(ord(c) for c in characters)
+	last = max(ord(c) for c in characters)
+	index = [NO_GLYPH] * (last - first + 1)
+	for i in range(0, len(characters)):
+		index[ord(characters[i]) - first] = i
+	f.write(pack565.c_array("font_%d_index" % (font_size), index))
+	f.write("\n")
+
+	# A pixel of spacing per 16 rows of height, at least one
+	spacing = 1 + height // 16
+	f.write("const uint8_t font_%d_advances[%d] = {\n" % (font_size, len(characters)))
+	for i in range(0, len(characters)):
+		f.write("  %d, \n" % (glyph_widths[i] + spacing))
+	f.write(" };\n")
+	f.write("\n")
+
+	digit_widths = [glyph_widths[i] for i in range(0, len(characters)) if characters[i].isdigit()]
+	f.write("const font_t font_%d = {\n" % (font_size))
+	f.write("  .size = %d,\n" % (font_size))
+	f.write("  .height = %d,\n" % (height))
+	f.write("  .max_width = %d,\n" % (max(glyph_widths)))
+	f.write("  .digit_width = %d,\n" % (max(digit_widths) if digit_widths else max(glyph_widths)))
+	f.write("  .first_code = %d,\n" % (first))
+	f.write("  .num_codes = %d,\n" % (len(index)))
+	f.write("  .index = font_%d_index,\n" % (font_size))
+	f.write("  .widths = font_%d_widths,\n" % (font_size))
+	f.write("  .advances = font_%d_advances,\n" % (font_size))
+	f.write("  .pix = font_%d_pix,\n" % (font_size))
+	f.write("  .palette = font_%d_palette,\n" % (font_size))
+	f.write("};\n")
+
 def convert_font(font_fname, font_width_fname, characters, font_size, tint):
 	print "Converting %s to font-%d.c" % (font_fname, font_size)
 	glyph_widths = []
@@ -50,18 +93,28 @@ def convert_font(font_fname, font_width_fname, characters, font_size, tint):
 
 	x_position = 0;
 	shell("echo \"#include <stdint.h>\" > font-%d.c" % (font_size))
+	shell("echo \"#include \\\"font.h\\\"\" >> font-%d.c" % (font_size))
 	shell("echo >> font-%d.h" % (font_size))
 	shell("echo \"const uint32_t font_%d_height = %d;\" >> font-%d.c" % (font_size, height, font_size))
 	shell("echo \"const uint32_t font_%d_num_glyphs = %d;\" >> font-%d.c" % (font_size, len(characters), font_size))
 	shell("echo >> font-%d.c" % (font_size))
 
+	# Output the palette shared by all glyphs
+	with open("font-%d.c" % (font_size), "a") as f:
+		f.write(pack565.c_array("font_%d_palette" % (font_size), pack565.palette_bytes(tint)))
+		f.write("\n")
+
 	for i in range(0, len(characters)):
 		# Crop, convert to rgb888 and then to bgr565
 		cmd = "convert -crop %dx%d+%d+0 %s - | magick - -colorspace gray +level-colors ,#%s  -depth 8 rgb:- | ./rgbtobgr565 > temp.565" % (glyph_widths[i], height, x_position, font_fname, tint)
 		shell(cmd)
-		cmd = "xxd -c 16 -i temp.565 | sed 's/unsigned char/const uint8_t/g' | sed 's/unsigned int/const uint32_t/g' | sed 's/temp_565/font_%d_%s/' >> font-%d.c" % (font_size, characters[i], font_size)
-		shell(cmd)
-		shell("echo >> font-%d.c" % (font_size))
+		# Pack to palette indices with run length encoding, see pack565.py
+		with open("temp.565", "rb") as f:
+			runs = pack565.pack(f.read(), tint)
+		glyph_sizes.append(len(runs))
+		with open("font-%d.c" % (font_size), "a") as f:
+			f.write(pack565.c_array("font_%d_%s" % (font_size, glyph_name(characters[i])), runs))
+			f.write("\n")
 
 		x_position += glyph_widths[i]
 
@@ -75,18 +128,22 @@ def convert_font(font_fname, font_width_fname, characters, font_size, tint):
 	# Output glyph sizes
 	shell("echo \"const uint16_t font_%d_sizes[%d] = {\" >> font-%d.c" % (font_size, len(characters), font_size))
 	for i in range(0, len(characters)):
-		shell("echo \"  %d, \" >> font-%d.c" % (2 * height * glyph_widths[i], font_size))
+		shell("echo \"  %d, \" >> font-%d.c" % (glyph_sizes[i], font_size))
 	shell("echo \" };\" >> font-%d.c" % (font_size))
 	shell("echo >> font-%d.c" % (font_size))
 
 	# Output glyph pix pointers
-	shell("echo \"const uint16_t *font_%d_pix[%d] = {\" >> font-%d.c" % (font_size, len(characters), font_size))
+	shell("echo \"const uint8_t *font_%d_pix[%d] = {\" >> font-%d.c" % (font_size, len(characters), font_size))
 	for i in range(0, len(characters)):
-		shell("echo \"  (uint16_t*) &font_%d_%s, \" >> font-%d.c" % (font_size, characters[i], font_size))
+		shell("echo \"  font_%d_%s, \" >> font-%d.c" % (font_size, glyph_name(characters[i]), font_size))
 	shell("echo \" };\" >> font-%d.c" % (font_size))
 	shell("echo >> font-%d.c" % (font_size))
 
-	shell("cat font-%d.c | grep const | sed 's/const/extern const/g' | cut -d= -f1 | sed 's/ $/;/g' > font-%d.h" % (font_size, font_size))
+	with open("font-%d.c" % (font_size), "a") as f:
+		write_metrics(f, characters, glyph_widths, font_size, height)
+
+	shell("echo \"#include \\\"font.h\\\"\" > font-%d.h" % (font_size))
+	shell("cat font-%d.c | grep const | sed 's/const/extern const/g' | cut -d= -f1 | sed 's/ $/;/g' >> font-%d.h" % (font_size, font_size))
 	shell("rm temp.565")
 
 
@@ -95,7 +152,8 @@ def main():
 		tint = sys.argv[1]
 	else:
 		tint = "ffffff"
-	characters = ['0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'dot', 'v', 'a']
+	# The glyphs of the font images in order, see gfx/generate_font.py
+	characters = "0123456789.VA"
 	convert_font("gfx/fonts/ubuntu_condensed_18.png", "gfx/fonts/ubuntu_condensed_18_width.png", characters, 18, tint)
 	convert_font("gfx/fonts/ubuntu_condensed_24.png", "gfx/fonts/ubuntu_condensed_24_width.png", characters, 24, tint)
 	convert_font("gfx/fonts/ubuntu_condensed_48.png", "gfx/fonts/ubuntu_condensed_48_width.png", characters, 48, tint)
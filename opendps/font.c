@@ -0,0 +1,66 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "font.h"
+#include "font-18.h"
+#include "font-24.h"
+#include "font-48.h"
+
+const font_t *font_get(uint8_t size)
+{
+    switch (size) {
+        case 18:
+            return &font_18;
+        case 24:
+            return &font_24;
+        case 48:
+            return &font_48;
+        default:
+            return NULL;
+    }
+}
+
+int32_t font_glyph(const font_t *font, char ch)
+{
+    uint32_t code = (uint8_t) ch;
+    if (code < font->first_code || code - font->first_code >= font->num_codes) {
+        return -1;
+    }
+    uint8_t glyph = font->index[code - font->first_code];
+    return glyph == FONT_NO_GLYPH ? -1 : glyph;
+}
+
+uint32_t font_text_width(const font_t *font, const char *str)
+{
+    uint32_t width = 0;
+    for (; *str; str++) {
+        int32_t glyph = font_glyph(font, *str);
+        if (glyph >= 0) {
+            width += font->advances[glyph];
+        }
+    }
+    return width;
+}
@@ -0,0 +1,75 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __FONT_H__
+#define __FONT_H__
+
+#include <stdint.h>
+
+/** Fonts and their glyph metrics, as generated by font-convert.py. The
+  * glyphs are found through an index by code point, covering the code points
+  * from the first to the last character of the font */
+
+/** Index entry of the code points the font has no glyph for */
+#define FONT_NO_GLYPH  (0xff)
+
+typedef struct {
+    uint8_t size;              /** The size passed to tft_putch() and tft_puts() */
+    uint8_t height;            /** Height of all glyphs */
+    uint8_t max_width;         /** Width of the widest glyph */
+    uint8_t digit_width;       /** Width of the widest digit, a cell any digit fits in */
+    uint8_t first_code;        /** Code point of the first entry of the index */
+    uint8_t num_codes;         /** Number of entries of the index */
+    const uint8_t *index;      /** Glyph of each code point, or FONT_NO_GLYPH */
+    const uint8_t *widths;     /** Width of each glyph */
+    const uint8_t *advances;   /** Width of each glyph and the spacing after it */
+    const uint8_t **pix;       /** Glyphs packed with pack565.py */
+    const uint8_t *palette;    /** Palette of the glyphs */
+} font_t;
+
+/**
+  * @brief Get the font of a size
+  * @param size 18, 24 or 48
+  * @retval the font or NULL if there is no such size
+  */
+const font_t *font_get(uint8_t size);
+
+/**
+  * @brief Get the glyph of a character
+  * @param font the font
+  * @param ch the character
+  * @retval index of the glyph or -1 if the font does not have it
+  */
+int32_t font_glyph(const font_t *font, char ch);
+
+/**
+  * @brief Get the width of a string, the spacing after the last glyph
+  *        included. Characters without a glyph are skipped.
+  * @param font the font
+  * @param str the string
+  * @retval width in pixels
+  */
+uint32_t font_text_width(const font_t *font, const char *str);
+
+#endif // __FONT_H__
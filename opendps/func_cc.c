@@ -32,7 +32,7 @@
 #include "uui_number.h"
 #include "cc.h"
 #include "dbg_printf.h"
-#include "mini-printf.h"
+#include "intfmt.h"
 
 /*
  * This is the implementation of the CC screen. 
@@ -48,10 +48,18 @@ static void cc_enable(bool _enable);
 static void voltage_changed(ui_number_t *item);
 static void current_changed(ui_number_t *item);
 static void cc_tick(void);
+static void cc_activate(void);
 static void past_save(past_t *past);
 static void past_restore(past_t *past);
 static set_param_status_t set_parameter(char *name, char *value);
 static set_param_status_t get_parameter(char *name, char *value, uint32_t value_len);
+static set_param_status_t set_parameter_value(uint32_t id, int32_t value);
+static set_param_status_t get_parameter_value(uint32_t id, int32_t *value);
+static void apply_parameters(void);
+
+/** Ids of the parameters, their index in the parameters of the screen */
+#define PARAM_CURRENT  (0)
+#define PARAM_VOLTAGE  (3)
 
 #define SCREEN_ID  (2)
 #define PAST_U     (0)
@@ -135,33 +143,139 @@ ui_number_t cc_current_2 = {
 
 
 /* This is the screen definition */
-ui_screen_t cc_screen = {
+static const ui_parameter_t cc_parameters[] = {
+    {
+        .name = "current",
+        .unit = unit_ampere,
+        .prefix = si_milli
+    },
+    {
+        .name = "ovp", /** Handled by uui_set_protection() */
+        .unit = unit_volt,
+        .prefix = si_milli
+    },
+    {
+        .name = "opp",
+        .unit = unit_watt,
+        .prefix = si_milli
+    },
+    {
+        .name = "voltage", /** The limit of the constant current */
+        .unit = unit_volt,
+        .prefix = si_milli
+    },
+    {
+        .name = {'\0'} /** Terminator */
+    },
+};
+
+static const ui_screen_desc_t cc_desc = {
     .id = SCREEN_ID,
     .name = "cc",
-    .icon_data = (uint8_t *) cc,
+    .icon_data = (const uint8_t *) cc,
+    .icon_palette = (const uint8_t *) cc_palette,
     .icon_data_len = sizeof(cc),
     .icon_width = cc_width,
     .icon_height = cc_height,
+    .activate = &cc_activate,
     .enable = &cc_enable,
     .past_save = &past_save,
     .past_restore = &past_restore,
     .set_parameter = &set_parameter,
     .get_parameter = &get_parameter,
+    .set_parameter_value = &set_parameter_value,
+    .get_parameter_value = &get_parameter_value,
+    .apply_parameters = &apply_parameters,
     .tick = &cc_tick,
     .num_items = 4,
-    .parameters = {
-        {
-            .name = "current",
-            .unit = unit_ampere,
-            .prefix = si_milli
-        },
-        {
-            .name = {'\0'} /** Terminator */
-        },
-    },
+    .parameters = cc_parameters,
     .items = { (ui_item_t*) &cc_voltage, (ui_item_t*) &cc_current, (ui_item_t*) &cc_voltage_2, (ui_item_t*) &cc_current_2 }
 };
 
+ui_screen_t cc_screen = {
+    .desc = &cc_desc
+};
+
+/**
+ * @brief      Map a parameter name to its id
+ *
+ * @param[in]  name  name of parameter
+ *
+ * @retval     the id, or -1 if there is no such parameter
+ */
+static int32_t parameter_id(const char *name)
+{
+    if (strcmp("voltage", name) == 0 || strcmp("u", name) == 0) {
+        return PARAM_VOLTAGE;
+    } else if (strcmp("current", name) == 0 || strcmp("i", name) == 0) {
+        return PARAM_CURRENT;
+    }
+    return -1;
+}
+
+/**
+ * @brief      Set function parameter, the output is updated by
+ *             apply_parameters()
+ *
+ * @param[in]  id     id of parameter
+ * @param[in]  value  value of parameter - always in SI units
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t set_parameter_value(uint32_t id, int32_t value)
+{
+    switch (id) {
+        case PARAM_VOLTAGE:
+            /** value received in millivolt, module internal representation is centivolt */
+            if (value < 10 * cc_voltage.min || value > 10 * cc_voltage.max) {
+                emu_printf("[CC] Voltage %d is out of range (min:%d max:%d)\n", value, 10 * cc_voltage.min, 10 * cc_voltage.max);
+                return ps_range_error;
+            }
+            emu_printf("[CC] Setting voltage to %d\n", value);
+            number_set_value(&cc_voltage, value / 10);
+            return ps_ok;
+        case PARAM_CURRENT:
+            if (value < cc_current.min || value > cc_current.max) {
+                emu_printf("[CC] Current %d is out of range (min:%d max:%d)\n", value, cc_current.min, cc_current.max);
+                return ps_range_error;
+            }
+            emu_printf("[CC] Setting current to %d\n", value);
+            number_set_value(&cc_current, value);
+            return ps_ok;
+    }
+    return ps_unknown_name;
+}
+
+/**
+ * @brief      Program the output from the parameters set
+ */
+static void apply_parameters(void)
+{
+    (void) pwrctl_set_output(10 * cc_voltage.value, cc_current.value);
+}
+
+/**
+ * @brief      Get function parameter
+ *
+ * @param[in]  id     id of parameter
+ * @param[out] value  value of parameter - always in SI units
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t get_parameter_value(uint32_t id, int32_t *value)
+{
+    switch (id) {
+        case PARAM_VOLTAGE:
+            /** value returned in millivolt, module internal representation is centivolt */
+            *value = 10 * cc_voltage.value;
+            return ps_ok;
+        case PARAM_CURRENT:
+            *value = cc_current.value;
+            return ps_ok;
+    }
+    return ps_unknown_name;
+}
+
 /**
  * @brief      Set function parameter
  *
@@ -172,28 +286,15 @@ ui_screen_t cc_screen = {
  */
 static set_param_status_t set_parameter(char *name, char *value)
 {
-    int32_t ivalue = atoi(value);
-    if (strcmp("voltage", name) == 0 || strcmp("u", name) == 0) {
-        if (ivalue < cc_voltage.min || ivalue > cc_voltage.max) {
-            emu_printf("[CC] Voltage %d is out of range (min:%d max:%d)\n", ivalue, cv_voltage.min, cv_voltage.max);
-            return ps_range_error;
-        }
-        emu_printf("[CC] Setting voltage to %d\n", ivalue);
-        /** value received in millivolt, module internal representation is centivolt */
-        cc_voltage.value = ivalue / 10;
-        voltage_changed(&cc_voltage);
-        return ps_ok;
-    } else if (strcmp("current", name) == 0 || strcmp("i", name) == 0) {
-        if (ivalue < cc_current.min || ivalue > cc_current.max) {
-            emu_printf("[CC] Current %d is out of range (min:%d max:%d)\n", ivalue, cc_current.min, cc_current.max);
-            return ps_range_error;
-        }
-        emu_printf("[CC] Setting current to %d\n", ivalue);
-        cc_current.value = ivalue;
-        current_changed(&cc_current);
-        return ps_ok;
+    int32_t id = parameter_id(name);
+    int32_t ivalue;
+    if (id < 0) {
+        return ps_unknown_name;
     }
-    return ps_unknown_name;
+    if (!intfmt_parse_i32(value, &ivalue)) {
+        return ps_range_error;
+    }
+    return set_parameter_value(id, ivalue);
 }
 
 /**
@@ -207,15 +308,13 @@ static set_param_status_t set_parameter(char *name, char *value)
  */
 static set_param_status_t get_parameter(char *name, char *value, uint32_t value_len)
 {
-    if (strcmp("voltage", name) == 0 || strcmp("u", name) == 0) {
-        /** value returned in millivolt, module internal representation is centivolt */
-        (void) mini_snprintf(value, value_len, "%d", 10 * cc_voltage.value);
-        return ps_ok;
-    } else if (strcmp("current", name) == 0 || strcmp("i", name) == 0) {
-        (void) mini_snprintf(value, value_len, "%d", cc_current.value);
-        return ps_ok;
+    int32_t ivalue;
+    int32_t id = parameter_id(name);
+    if (id < 0 || get_parameter_value(id, &ivalue) != ps_ok) {
+        return ps_unknown_name;
     }
-    return ps_unknown_name;
+    (void) intfmt_i32(value, value_len, ivalue);
+    return ps_ok;
 }
 
 /**
@@ -246,7 +345,6 @@ static void voltage_changed(ui_number_t *item)
 {
     cc_voltage.value = item->value;
     (void) pwrctl_set_vout(10 * item->value);
-    cc_voltage.ui.draw(&cc_voltage.ui);
 }
 
 /**
@@ -258,7 +356,6 @@ static void current_changed(ui_number_t *item)
 {
     cc_current.value = item->value;
     (void) pwrctl_set_iout(item->value);
-    cc_current.ui.draw(&cc_current.ui);
 }
 
 /**
@@ -268,11 +365,18 @@ static void current_changed(ui_number_t *item)
  */
 static void past_save(past_t *past)
 {
-    /** @todo: past bug causes corruption for units smaller than 4 bytes (#27) */
-    if (!past_write_unit(past, (SCREEN_ID << 24) | PAST_U, (void*) &cc_voltage.value, 4 /* sizeof(cc_voltage.value) */ )) {
+    /** Both limits or neither */
+    if (!past_begin(past, 2 * PAST_UNIT_SIZE(4))) {
+        /** @todo: handle past write failures */
+        return;
+    }
+    if (!past_write_unit_deferred(past, (SCREEN_ID << 24) | PAST_U, (void*) &cc_voltage.value, 4 /* sizeof(cc_voltage.value) */ )) {
+        /** @todo: handle past write failures */
+    }
+    if (!past_write_unit_deferred(past, (SCREEN_ID << 24) | PAST_I, (void*) &cc_current.value, 4 /* sizeof(cc_current.value) */)) {
         /** @todo: handle past write failures */
     }
-    if (!past_write_unit(past, (SCREEN_ID << 24) | PAST_I, (void*) &cc_current.value, 4 /* sizeof(cc_current.value) */)) {
+    if (!past_commit(past)) {
         /** @todo: handle past write failures */
     }
 }
@@ -313,26 +417,18 @@ static void cc_tick(void)
     cc_voltage.max = pwrctl_calc_vin(v_in_raw) / 10;
 
     int32_t new_u = pwrctl_calc_vout(v_out_raw) / 10;
-    if (new_u != cc_voltage_2.value) {
-        cc_voltage_2.value = new_u;
-        cc_voltage_2.ui.draw(&cc_voltage_2.ui);
-    }
+    number_set_value(&cc_voltage_2, new_u);
 
     /** No focus, update display if necessary */
     int32_t new_i = pwrctl_calc_iout(i_out_raw);
-    if (new_i != cc_current_2.value) {
-        cc_current_2.value = new_i;
-        cc_current_2.ui.draw(&cc_current_2.ui);
-    }
+    number_set_value(&cc_current_2, new_i);
 }
 
 /**
- * @brief      Function init. Initialise the cc module and add its screen to
- *             the UI
- *
- * @param      ui    The user interface
+ * @brief      Set up the items when the screen is first shown, before the
+ *             settings are restored from the past
  */
-void func_cc_init(uui_t *ui)
+static void cc_activate(void)
 {
     cc_voltage.value = pwrctl_get_vout() / 10;
     cc_current.value = pwrctl_get_ilimit();
@@ -348,5 +444,15 @@ void func_cc_init(uui_t *ui)
     number_init(&cc_current);
     number_init(&cc_voltage_2);
     number_init(&cc_current_2);
+}
+
+/**
+ * @brief      Function init. Initialise the cc module and add its screen to
+ *             the UI
+ *
+ * @param      ui    The user interface
+ */
+void func_cc_init(uui_t *ui)
+{
     uui_add_screen(ui, &cc_screen);
 }
@@ -0,0 +1,687 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hw.h"
+#include "func_chg.h"
+#include "uui.h"
+#include "uui_number.h"
+#include "opendps.h"
+#include "protocol.h"
+#include "energy.h"
+#include "softtimer.h"
+#include "tick.h"
+#include "dbg_printf.h"
+#include "intfmt.h"
+
+/*
+ * This is the implementation of the battery charging screen. It has two
+ * editable values, the end of charge voltage and the charge current. When
+ * power is enabled the pack is charged with constant current until the
+ * voltage is reached and then held at constant voltage while the current
+ * tapers off. A control loop on a soft timer watches the output and stops
+ * the charge when the current has stayed below the taper current, on
+ * timeout, on a too high temperature or when the set capacity has been
+ * charged. Packs that want a float charge, like lead-acid, are held at the
+ * float voltage instead of being switched off when the current has tapered.
+ */
+
+static void chg_enable(bool _enable);
+static void voltage_changed(ui_number_t *item);
+static void current_changed(ui_number_t *item);
+static void chg_tick(void);
+static void chg_activate(void);
+static void chg_control(softtimer_t *timer);
+static void past_save(past_t *past);
+static void past_restore(past_t *past);
+static set_param_status_t set_parameter(char *name, char *value);
+static set_param_status_t get_parameter(char *name, char *value, uint32_t value_len);
+static set_param_status_t set_parameter_value(uint32_t id, int32_t value);
+static set_param_status_t get_parameter_value(uint32_t id, int32_t *value);
+static void apply_parameters(void);
+
+/** How often the termination conditions are checked */
+#ifndef CONFIG_CHG_INTERVAL_MS
+ #define CONFIG_CHG_INTERVAL_MS  (100)
+#endif
+
+/** The charge is in the CV phase when V_out is this close to the voltage */
+#ifndef CONFIG_CHG_CV_MARGIN_MV
+ #define CONFIG_CHG_CV_MARGIN_MV  (50)
+#endif
+
+/** The current must stay below the taper current this long to end the charge */
+#ifndef CONFIG_CHG_TAPER_HOLD_MS
+ #define CONFIG_CHG_TAPER_HOLD_MS  (5000)
+#endif
+
+#if MAX_PARAMETERS < 12
+ #error "The charger has 11 parameters, build with CONFIG_UI_MAX_PARAMETERS=12"
+#endif
+
+/** Ids of the parameters, their index in the parameters of the screen */
+#define PARAM_VOLTAGE      (0)
+#define PARAM_CURRENT      (1)
+#define PARAM_TAPER        (2)
+#define PARAM_FLOAT        (3)
+#define PARAM_TIMEOUT      (4)
+#define PARAM_TEMPERATURE  (5)
+#define PARAM_CAPACITY     (6)
+#define PARAM_CHARGED      (7)
+#define PARAM_STATE        (8)
+
+#define SCREEN_ID     (6)
+#define PAST_SETTINGS (0)
+#define LINE_Y(x) (10 + (x * 24))
+
+/** The state of the charge, reported by the "state" parameter */
+typedef enum {
+    chg_idle = 0,  /** Not charging */
+    chg_cc,        /** Constant current */
+    chg_cv,        /** Constant voltage, waiting for the current to taper */
+    chg_float,     /** Charged, held at the float voltage */
+    chg_done,      /** Charged, the current tapered */
+    chg_timeout,   /** Stopped, the timeout expired */
+    chg_overtemp,  /** Stopped, a temperature exceeded the limit */
+    chg_full,      /** Stopped, the capacity was charged */
+} chg_state_t;
+
+/** The settings not shown on the screen, persisted with the shown ones */
+typedef struct {
+    uint32_t voltage;     /** cV, end of charge voltage */
+    uint32_t current;     /** mA, charge current */
+    uint32_t taper;       /** mA, end of charge current */
+    uint32_t float_mv;    /** mV, float voltage, 0 to switch off when charged */
+    uint32_t timeout;     /** s, 0 for no timeout */
+    uint32_t temp_max;    /** 1/10 degrees Celsius, 0 for no limit */
+    uint32_t capacity;    /** mAh, 0 for no limit */
+} chg_settings_t;
+
+static chg_settings_t settings = {
+    .taper = 100,
+    .temp_max = 450,
+};
+
+static softtimer_t control_timer;
+static chg_state_t state;
+static uint64_t start_ticks;
+static uint64_t taper_ticks; /** When the current went below taper */
+static bool is_tapering;
+static uint32_t start_uah;   /** The energy module charge at start */
+static uint32_t charged_uah;
+
+/* This is the definition of the voltage item in the UI */
+ui_number_t chg_voltage = {
+    {
+        .type = ui_item_number,
+        .id = 10,
+        .x = 120,
+        .y = LINE_Y(0),
+        .can_focus = true,
+    },
+    .font_size = 24,
+    .value = 0,
+    .min = 0,
+    .max = 0, /** Set at init, continously updated in the tick callback */
+    .num_digits = 2,
+    .num_decimals = 2, /** 2 decimals => value is in centivolts */
+    .unit = unit_volt,
+    .changed = &voltage_changed,
+};
+
+/* This is the definition of the current item in the UI */
+ui_number_t chg_current = {
+    {
+        .type = ui_item_number,
+        .id = 11,
+        .x = 120,
+        .y = LINE_Y(1),
+        .can_focus = true,
+    },
+    .font_size = 24,
+    .value = 0,
+    .min = 0,
+    .max = CONFIG_DPS_MAX_CURRENT,
+    .num_digits = 1,
+    .num_decimals = 3, /** 3 decimals => value is in milliampere */
+    .unit = unit_ampere,
+    .changed = &current_changed,
+};
+
+/* This is the definition of the measured voltage item in the UI */
+ui_number_t chg_voltage_2 = {
+    {
+        .type = ui_item_number,
+        .id = 12,
+        .x = 120,
+        .y = LINE_Y(2),
+        .can_focus = false,
+    },
+    .font_size = 24,
+    .value = 0,
+    .min = 0,
+    .max = 0,
+    .num_digits = 2,
+    .num_decimals = 2,
+    .unit = unit_volt,
+};
+
+/* This is the definition of the measured current item in the UI */
+ui_number_t chg_current_2 = {
+    {
+        .type = ui_item_number,
+        .id = 13,
+        .x = 120,
+        .y = LINE_Y(3),
+        .can_focus = false,
+    },
+    .font_size = 24,
+    .value = 0,
+    .min = 0,
+    .max = CONFIG_DPS_MAX_CURRENT,
+    .num_digits = 1,
+    .num_decimals = 3,
+    .unit = unit_ampere,
+};
+
+/* This is the screen definition, there is no icon */
+static const ui_parameter_t chg_parameters[] = {
+    {
+        .name = "voltage", /** End of charge voltage */
+        .unit = unit_volt,
+        .prefix = si_milli
+    },
+    {
+        .name = "current", /** Charge current */
+        .unit = unit_ampere,
+        .prefix = si_milli
+    },
+    {
+        .name = "taper", /** End of charge current */
+        .unit = unit_ampere,
+        .prefix = si_milli
+    },
+    {
+        .name = "float", /** Float voltage, 0 to switch off when charged */
+        .unit = unit_volt,
+        .prefix = si_milli
+    },
+    {
+        .name = "timeout", /** 0 for no timeout */
+        .unit = unit_second,
+        .prefix = si_none
+    },
+    {
+        .name = "temp_max", /** Max reported temperature, 0 for no limit */
+        .unit = unit_celsius,
+        .prefix = si_deci
+    },
+    {
+        .name = "capacity", /** Stop after charging this much, 0 for no limit */
+        .unit = unit_ampere_hour,
+        .prefix = si_milli
+    },
+    {
+        .name = "charged", /** Read only, charged since enabled */
+        .unit = unit_ampere_hour,
+        .prefix = si_milli
+    },
+    {
+        .name = "state", /** Read only, see chg_state_t */
+        .unit = unit_last,
+        .prefix = si_none
+    },
+    {
+        .name = "ovp", /** Handled by uui_set_protection() */
+        .unit = unit_volt,
+        .prefix = si_milli
+    },
+    {
+        .name = "opp",
+        .unit = unit_watt,
+        .prefix = si_milli
+    },
+    {
+        .name = {'\0'} /** Terminator */
+    },
+};
+
+static const ui_screen_desc_t chg_desc = {
+    .id = SCREEN_ID,
+    .name = "chg",
+    .activate = &chg_activate,
+    .enable = &chg_enable,
+    .past_save = &past_save,
+    .past_restore = &past_restore,
+    .set_parameter = &set_parameter,
+    .get_parameter = &get_parameter,
+    .set_parameter_value = &set_parameter_value,
+    .get_parameter_value = &get_parameter_value,
+    .apply_parameters = &apply_parameters,
+    .tick = &chg_tick,
+    .num_items = 4,
+    .parameters = chg_parameters,
+    .items = { (ui_item_t*) &chg_voltage, (ui_item_t*) &chg_current, (ui_item_t*) &chg_voltage_2, (ui_item_t*) &chg_current_2 }
+};
+
+ui_screen_t chg_screen = {
+    .desc = &chg_desc
+};
+
+/**
+ * @brief      Map a parameter name to its id
+ *
+ * @param[in]  name  name of parameter
+ *
+ * @retval     the id, or -1 if there is no such parameter
+ */
+static int32_t parameter_id(const char *name)
+{
+    for (uint32_t i = 0; i <= PARAM_STATE; i++) {
+        if (strcmp(chg_parameters[i].name, name) == 0) {
+            return i;
+        }
+    }
+    if (strcmp("u", name) == 0) {
+        return PARAM_VOLTAGE;
+    } else if (strcmp("i", name) == 0) {
+        return PARAM_CURRENT;
+    }
+    return -1;
+}
+
+/**
+ * @brief      Set function parameter, the output is updated by
+ *             apply_parameters()
+ *
+ * @param[in]  id     id of parameter
+ * @param[in]  value  value of parameter - always in SI units
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t set_parameter_value(uint32_t id, int32_t value)
+{
+    if (value < 0) {
+        return ps_range_error;
+    }
+    switch (id) {
+        case PARAM_VOLTAGE:
+            if (value < 10 * chg_voltage.min || value > 10 * chg_voltage.max) {
+                emu_printf("[CHG] Voltage %d is out of range (min:%d max:%d)\n", value, 10 * chg_voltage.min, 10 * chg_voltage.max);
+                return ps_range_error;
+            }
+            emu_printf("[CHG] Setting voltage to %d\n", value);
+            number_set_value(&chg_voltage, value / 10);
+            return ps_ok;
+        case PARAM_CURRENT:
+            if (value < chg_current.min || value > chg_current.max) {
+                emu_printf("[CHG] Current %d is out of range (min:%d max:%d)\n", value, chg_current.min, chg_current.max);
+                return ps_range_error;
+            }
+            emu_printf("[CHG] Setting current to %d\n", value);
+            number_set_value(&chg_current, value);
+            return ps_ok;
+        case PARAM_TAPER:
+            if (value > CONFIG_DPS_MAX_CURRENT) {
+                return ps_range_error;
+            }
+            settings.taper = value;
+            return ps_ok;
+        case PARAM_FLOAT:
+            if (value > 10 * chg_voltage.max) {
+                return ps_range_error;
+            }
+            settings.float_mv = value;
+            return ps_ok;
+        case PARAM_TIMEOUT:
+            settings.timeout = value;
+            return ps_ok;
+        case PARAM_TEMPERATURE:
+            settings.temp_max = value;
+            return ps_ok;
+        case PARAM_CAPACITY:
+            settings.capacity = value;
+            return ps_ok;
+        case PARAM_CHARGED:
+        case PARAM_STATE:
+            return ps_not_supported;
+    }
+    return ps_unknown_name;
+}
+
+/**
+ * @brief      Program the output from the parameters set, the float voltage
+ *             replaces the voltage once the pack is charged
+ */
+static void apply_parameters(void)
+{
+    if (state == chg_float) {
+        (void) pwrctl_set_output(settings.float_mv, chg_current.value);
+    } else {
+        (void) pwrctl_set_output(10 * chg_voltage.value, chg_current.value);
+    }
+}
+
+/**
+ * @brief      Get function parameter
+ *
+ * @param[in]  id     id of parameter
+ * @param[out] value  value of parameter - always in SI units
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t get_parameter_value(uint32_t id, int32_t *value)
+{
+    switch (id) {
+        case PARAM_VOLTAGE:
+            *value = 10 * chg_voltage.value;
+            return ps_ok;
+        case PARAM_CURRENT:
+            *value = chg_current.value;
+            return ps_ok;
+        case PARAM_TAPER:
+            *value = settings.taper;
+            return ps_ok;
+        case PARAM_FLOAT:
+            *value = settings.float_mv;
+            return ps_ok;
+        case PARAM_TIMEOUT:
+            *value = settings.timeout;
+            return ps_ok;
+        case PARAM_TEMPERATURE:
+            *value = settings.temp_max;
+            return ps_ok;
+        case PARAM_CAPACITY:
+            *value = settings.capacity;
+            return ps_ok;
+        case PARAM_CHARGED:
+            *value = charged_uah / 1000;
+            return ps_ok;
+        case PARAM_STATE:
+            *value = state;
+            return ps_ok;
+    }
+    return ps_unknown_name;
+}
+
+/**
+ * @brief      Set function parameter
+ *
+ * @param[in]  name   name of parameter
+ * @param[in]  value  value of parameter as a string - always in SI units
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t set_parameter(char *name, char *value)
+{
+    int32_t id = parameter_id(name);
+    int32_t ivalue;
+    if (id < 0) {
+        return ps_unknown_name;
+    }
+    if (!intfmt_parse_i32(value, &ivalue)) {
+        return ps_range_error;
+    }
+    return set_parameter_value(id, ivalue);
+}
+
+/**
+ * @brief      Get function parameter
+ *
+ * @param[in]  name       name of parameter
+ * @param[in]  value      value of parameter as a string - always in SI units
+ * @param[in]  value_len  length of value buffer
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t get_parameter(char *name, char *value, uint32_t value_len)
+{
+    int32_t ivalue;
+    int32_t id = parameter_id(name);
+    if (id < 0 || get_parameter_value(id, &ivalue) != ps_ok) {
+        return ps_unknown_name;
+    }
+    (void) intfmt_i32(value, value_len, ivalue);
+    return ps_ok;
+}
+
+/**
+ * @brief      Check if any reported temperature exceeds the limit
+ *
+ * @retval     true if the charge must stop
+ */
+static bool too_hot(void)
+{
+    int16_t temp1, temp2;
+    bool shutdown;
+    opendps_get_temperature(&temp1, &temp2, &shutdown);
+    if (settings.temp_max == 0) {
+        return false;
+    }
+    return ((uint16_t) temp1 != INVALID_TEMPERATURE && temp1 > (int32_t) settings.temp_max) ||
+           ((uint16_t) temp2 != INVALID_TEMPERATURE && temp2 > (int32_t) settings.temp_max);
+}
+
+/**
+ * @brief      End the charge, or move on to the float charge
+ *
+ * @param[in]  new_state  why the charge ended
+ */
+static void finish(chg_state_t new_state)
+{
+    if (new_state == chg_done && settings.float_mv) {
+        emu_printf("[CHG] Charged, floating at %d mV\n", settings.float_mv);
+        state = chg_float;
+        (void) pwrctl_set_vout(settings.float_mv);
+        return;
+    }
+    emu_printf("[CHG] Charge ended in state %d after %d mAh\n", new_state, charged_uah / 1000);
+    state = new_state;
+    softtimer_stop(&control_timer);
+    pwrctl_enable_vout(false);
+    /** Let the UI catch up with power out */
+    (void) opendps_enable_output(false);
+}
+
+/**
+ * @brief      The control loop, follows the charge through its phases and
+ *             ends it
+ *
+ * @param      timer  The control timer
+ */
+static void chg_control(softtimer_t *timer)
+{
+    (void) timer;
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    uint32_t uah, mwh, on_time;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+    (void) v_in_raw;
+    uint32_t v_out = pwrctl_calc_vout(v_out_raw);
+    uint32_t i_out = pwrctl_calc_iout(i_out_raw);
+    uint64_t now = get_ticks();
+    energy_get(&uah, &mwh, &on_time);
+    (void) mwh;
+    (void) on_time;
+    charged_uah = uah - start_uah;
+
+    if (too_hot()) {
+        finish(chg_overtemp);
+        return;
+    }
+    if (state == chg_float) {
+        return;
+    }
+    if (settings.timeout && now - start_ticks >= 1000 * (uint64_t) settings.timeout) {
+        finish(chg_timeout);
+        return;
+    }
+    if (settings.capacity && charged_uah >= 1000 * settings.capacity) {
+        finish(chg_full);
+        return;
+    }
+    if (state == chg_cc && v_out + CONFIG_CHG_CV_MARGIN_MV >= 10 * (uint32_t) chg_voltage.value) {
+        emu_printf("[CHG] CV at %d mA\n", i_out);
+        state = chg_cv;
+        is_tapering = false;
+    }
+    if (state == chg_cv) {
+        if (i_out > settings.taper) {
+            is_tapering = false;
+        } else if (!is_tapering) {
+            is_tapering = true;
+            taper_ticks = now;
+        } else if (now - taper_ticks >= CONFIG_CHG_TAPER_HOLD_MS) {
+            finish(chg_done);
+        }
+    }
+}
+
+/**
+ * @brief      Callback for when the function is enabled
+ *
+ * @param[in]  enabled  true when function is enabled
+ */
+static void chg_enable(bool enabled)
+{
+    emu_printf("[CHG] %s output\n", enabled ? "Enable" : "Disable");
+    if (enabled) {
+        uint32_t mwh, on_time;
+        energy_get(&start_uah, &mwh, &on_time);
+        (void) mwh;
+        (void) on_time;
+        charged_uah = 0;
+        start_ticks = get_ticks();
+        state = chg_cc;
+        (void) pwrctl_set_vout(10 * chg_voltage.value);
+        (void) pwrctl_set_ilimit(CONFIG_DPS_MAX_CURRENT);
+        (void) pwrctl_set_iout(chg_current.value);
+        pwrctl_enable_vout(true);
+        softtimer_start(&control_timer, CONFIG_CHG_INTERVAL_MS, CONFIG_CHG_INTERVAL_MS, &chg_control);
+    } else {
+        softtimer_stop(&control_timer);
+        pwrctl_enable_vout(false);
+        /** Keep the reason the charge ended for the state parameter */
+        if (state == chg_cc || state == chg_cv || state == chg_float) {
+            state = chg_idle;
+        }
+    }
+}
+
+/**
+ * @brief      Callback for when value of the voltage item is changed
+ *
+ * @param      item  The voltage item
+ */
+static void voltage_changed(ui_number_t *item)
+{
+    (void) item;
+    apply_parameters();
+}
+
+/**
+ * @brief      Callback for when value of the current item is changed
+ *
+ * @param      item  The current item
+ */
+static void current_changed(ui_number_t *item)
+{
+    (void) pwrctl_set_iout(item->value);
+}
+
+/**
+ * @brief      Save persistent parameters
+ *
+ * @param      past  The past
+ */
+static void past_save(past_t *past)
+{
+    settings.voltage = chg_voltage.value;
+    settings.current = chg_current.value;
+    if (!past_write_unit(past, (SCREEN_ID << 24) | PAST_SETTINGS, (void*) &settings, sizeof(settings))) {
+        dbg_printf("Error: past write chg settings failed!\n");
+    }
+}
+
+/**
+ * @brief      Restore persistent parameters
+ *
+ * @param      past  The past
+ */
+static void past_restore(past_t *past)
+{
+    uint32_t length;
+    const chg_settings_t *p = 0;
+    if (past_read_unit(past, (SCREEN_ID << 24) | PAST_SETTINGS, (const void**) &p, &length) && length == sizeof(settings)) {
+        memcpy(&settings, p, sizeof(settings));
+        chg_voltage.value = settings.voltage;
+        chg_current.value = settings.current;
+    }
+}
+
+/**
+ * @brief      Update the limit and the measured values, the charge is run
+ *             by chg_control()
+ */
+static void chg_tick(void)
+{
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+
+    /** Continously update the max setting */
+    chg_voltage.max = pwrctl_calc_vin(v_in_raw) / 10;
+
+    number_set_value(&chg_voltage_2, pwrctl_calc_vout(v_out_raw) / 10);
+    number_set_value(&chg_current_2, pwrctl_calc_iout(i_out_raw));
+}
+
+/**
+ * @brief      Set up the items when the screen is first shown, before the
+ *             settings are restored from the past
+ */
+static void chg_activate(void)
+{
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+    (void) i_out_raw;
+    (void) v_out_raw;
+    chg_voltage.max = pwrctl_calc_vin(v_in_raw) / 10;
+    number_init(&chg_voltage);
+    number_init(&chg_current);
+    number_init(&chg_voltage_2);
+    number_init(&chg_current_2);
+}
+
+/**
+ * @brief      Function init. Initialise the charger module and add its screen
+ *             to the UI
+ *
+ * @param      ui    The user interface
+ */
+void func_chg_init(uui_t *ui)
+{
+    uui_add_screen(ui, &chg_screen);
+}
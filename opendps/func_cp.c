@@ -0,0 +1,490 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hw.h"
+#include "func_cp.h"
+#include "uui.h"
+#include "uui_number.h"
+#include "softtimer.h"
+#include "dbg_printf.h"
+#include "intfmt.h"
+
+/*
+ * This is the implementation of the CP screen. It has two editable values,
+ * the constant power and the voltage limit. While power is enabled a control
+ * loop on a soft timer sets the current to the power over the measured
+ * voltage, independently of the UI tick. The voltage limit caps the output
+ * into high resistance loads.
+ */
+
+static void cp_enable(bool _enable);
+static void power_changed(ui_number_t *item);
+static void voltage_changed(ui_number_t *item);
+static void cp_tick(void);
+static void cp_activate(void);
+static void cp_control(softtimer_t *timer);
+static void past_save(past_t *past);
+static void past_restore(past_t *past);
+static set_param_status_t set_parameter(char *name, char *value);
+static set_param_status_t get_parameter(char *name, char *value, uint32_t value_len);
+static set_param_status_t set_parameter_value(uint32_t id, int32_t value);
+static set_param_status_t get_parameter_value(uint32_t id, int32_t *value);
+static void apply_parameters(void);
+
+/** How often the current is recomputed */
+#ifndef CONFIG_CP_INTERVAL_MS
+ #define CONFIG_CP_INTERVAL_MS  (10)
+#endif
+
+/** The current is computed for at least this voltage, limiting the current
+  * into a short while the output rises */
+#define CP_MIN_VOLTAGE_MV  (500)
+
+/** Ids of the parameters, their index in the parameters of the screen */
+#define PARAM_POWER    (0)
+#define PARAM_VOLTAGE  (1)
+
+#define SCREEN_ID  (4)
+#define PAST_P     (0)
+#define PAST_U     (1)
+#define LINE_Y(x) (10 + (x * 24))
+
+static softtimer_t control_timer;
+static uint32_t i_set; /** mA, the current the loop programmed */
+
+/* This is the definition of the power item in the UI */
+ui_number_t cp_power = {
+    {
+        .type = ui_item_number,
+        .id = 10,
+        .x = 120,
+        .y = LINE_Y(0),
+        .can_focus = true,
+    },
+    .font_size = 24,
+    .value = 0,
+    .min = 0,
+    .max = 0, /** Set at init, continously updated in the tick callback */
+    .num_digits = 3,
+    .num_decimals = 1, /** 1 decimal => value is in deciwatts */
+    .unit = unit_watt, /** There is no glyph for W, the unit cell is blank */
+    .changed = &power_changed,
+};
+
+/* This is the definition of the voltage limit item in the UI */
+ui_number_t cp_voltage = {
+    {
+        .type = ui_item_number,
+        .id = 11,
+        .x = 120,
+        .y = LINE_Y(1),
+        .can_focus = true,
+    },
+    .font_size = 24,
+    .value = 0,
+    .min = 0,
+    .max = 0, /** Set at init, continously updated in the tick callback */
+    .num_digits = 2,
+    .num_decimals = 2, /** 2 decimals => value is in centivolts */
+    .unit = unit_volt,
+    .changed = &voltage_changed,
+};
+
+/* This is the definition of the measured voltage item in the UI */
+ui_number_t cp_voltage_2 = {
+    {
+        .type = ui_item_number,
+        .id = 12,
+        .x = 120,
+        .y = LINE_Y(2),
+        .can_focus = false,
+    },
+    .font_size = 24,
+    .value = 0,
+    .min = 0,
+    .max = 0,
+    .num_digits = 2,
+    .num_decimals = 2,
+    .unit = unit_volt,
+};
+
+/* This is the definition of the measured current item in the UI */
+ui_number_t cp_current_2 = {
+    {
+        .type = ui_item_number,
+        .id = 13,
+        .x = 120,
+        .y = LINE_Y(3),
+        .can_focus = false,
+    },
+    .font_size = 24,
+    .value = 0,
+    .min = 0,
+    .max = CONFIG_DPS_MAX_CURRENT,
+    .num_digits = 1,
+    .num_decimals = 3,
+    .unit = unit_ampere,
+};
+
+/* This is the screen definition, there is no icon */
+static const ui_parameter_t cp_parameters[] = {
+    {
+        .name = "power",
+        .unit = unit_watt,
+        .prefix = si_milli
+    },
+    {
+        .name = "voltage", /** The limit of the constant power */
+        .unit = unit_volt,
+        .prefix = si_milli
+    },
+    {
+        .name = "ovp", /** Handled by uui_set_protection() */
+        .unit = unit_volt,
+        .prefix = si_milli
+    },
+    {
+        .name = "opp",
+        .unit = unit_watt,
+        .prefix = si_milli
+    },
+    {
+        .name = {'\0'} /** Terminator */
+    },
+};
+
+static const ui_screen_desc_t cp_desc = {
+    .id = SCREEN_ID,
+    .name = "cp",
+    .activate = &cp_activate,
+    .enable = &cp_enable,
+    .past_save = &past_save,
+    .past_restore = &past_restore,
+    .set_parameter = &set_parameter,
+    .get_parameter = &get_parameter,
+    .set_parameter_value = &set_parameter_value,
+    .get_parameter_value = &get_parameter_value,
+    .apply_parameters = &apply_parameters,
+    .tick = &cp_tick,
+    .num_items = 4,
+    .parameters = cp_parameters,
+    .items = { (ui_item_t*) &cp_power, (ui_item_t*) &cp_voltage, (ui_item_t*) &cp_voltage_2, (ui_item_t*) &cp_current_2 }
+};
+
+ui_screen_t cp_screen = {
+    .desc = &cp_desc
+};
+
+/**
+ * @brief      The most power the output can deliver, limited to what the
+ *             power item can show
+ *
+ * @param[in]  v_in  input voltage in mV
+ *
+ * @retval     max power in deciwatts
+ */
+static int16_t power_max(uint32_t v_in)
+{
+    uint32_t max = v_in * CONFIG_DPS_MAX_CURRENT / 100000;
+    return max > 9999 ? 9999 : max;
+}
+
+/**
+ * @brief      Map a parameter name to its id
+ *
+ * @param[in]  name  name of parameter
+ *
+ * @retval     the id, or -1 if there is no such parameter
+ */
+static int32_t parameter_id(const char *name)
+{
+    if (strcmp("power", name) == 0 || strcmp("p", name) == 0) {
+        return PARAM_POWER;
+    } else if (strcmp("voltage", name) == 0 || strcmp("u", name) == 0) {
+        return PARAM_VOLTAGE;
+    }
+    return -1;
+}
+
+/**
+ * @brief      Set function parameter, the output is updated by
+ *             apply_parameters()
+ *
+ * @param[in]  id     id of parameter
+ * @param[in]  value  value of parameter - always in SI units
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t set_parameter_value(uint32_t id, int32_t value)
+{
+    switch (id) {
+        case PARAM_POWER:
+            /** value received in milliwatt, module internal representation is deciwatt */
+            if (value < 100 * cp_power.min || value > 100 * cp_power.max) {
+                emu_printf("[CP] Power %d is out of range (min:%d max:%d)\n", value, 100 * cp_power.min, 100 * cp_power.max);
+                return ps_range_error;
+            }
+            emu_printf("[CP] Setting power to %d\n", value);
+            number_set_value(&cp_power, value / 100);
+            return ps_ok;
+        case PARAM_VOLTAGE:
+            if (value < 10 * cp_voltage.min || value > 10 * cp_voltage.max) {
+                emu_printf("[CP] Voltage %d is out of range (min:%d max:%d)\n", value, 10 * cp_voltage.min, 10 * cp_voltage.max);
+                return ps_range_error;
+            }
+            emu_printf("[CP] Setting voltage to %d\n", value);
+            number_set_value(&cp_voltage, value / 10);
+            return ps_ok;
+    }
+    return ps_unknown_name;
+}
+
+/**
+ * @brief      Program the output from the parameters set, the control loop
+ *             picks up the power
+ */
+static void apply_parameters(void)
+{
+    (void) pwrctl_set_vout(10 * cp_voltage.value);
+}
+
+/**
+ * @brief      Get function parameter
+ *
+ * @param[in]  id     id of parameter
+ * @param[out] value  value of parameter - always in SI units
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t get_parameter_value(uint32_t id, int32_t *value)
+{
+    switch (id) {
+        case PARAM_POWER:
+            *value = 100 * cp_power.value;
+            return ps_ok;
+        case PARAM_VOLTAGE:
+            *value = 10 * cp_voltage.value;
+            return ps_ok;
+    }
+    return ps_unknown_name;
+}
+
+/**
+ * @brief      Set function parameter
+ *
+ * @param[in]  name   name of parameter
+ * @param[in]  value  value of parameter as a string - always in SI units
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t set_parameter(char *name, char *value)
+{
+    int32_t id = parameter_id(name);
+    int32_t ivalue;
+    if (id < 0) {
+        return ps_unknown_name;
+    }
+    if (!intfmt_parse_i32(value, &ivalue)) {
+        return ps_range_error;
+    }
+    return set_parameter_value(id, ivalue);
+}
+
+/**
+ * @brief      Get function parameter
+ *
+ * @param[in]  name       name of parameter
+ * @param[in]  value      value of parameter as a string - always in SI units
+ * @param[in]  value_len  length of value buffer
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t get_parameter(char *name, char *value, uint32_t value_len)
+{
+    int32_t ivalue;
+    int32_t id = parameter_id(name);
+    if (id < 0 || get_parameter_value(id, &ivalue) != ps_ok) {
+        return ps_unknown_name;
+    }
+    (void) intfmt_i32(value, value_len, ivalue);
+    return ps_ok;
+}
+
+/**
+ * @brief      The control loop, moves the current halfway to the power over
+ *             the measured voltage. With a resistive load the halving makes
+ *             the loop settle instead of alternating between two currents.
+ *
+ * @param      timer  The control timer
+ */
+static void cp_control(softtimer_t *timer)
+{
+    (void) timer;
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+    (void) i_out_raw;
+    (void) v_in_raw;
+    uint32_t v_out = pwrctl_calc_vout(v_out_raw);
+    if (v_out < CP_MIN_VOLTAGE_MV) {
+        v_out = CP_MIN_VOLTAGE_MV;
+    }
+    /** deciwatt * 100000 / mV = mA */
+    uint32_t target = (uint32_t) cp_power.value * 100000 / v_out;
+    if (target > CONFIG_DPS_MAX_CURRENT) {
+        target = CONFIG_DPS_MAX_CURRENT;
+    }
+    i_set = (i_set + target) / 2;
+    (void) pwrctl_set_iout(i_set);
+}
+
+/**
+ * @brief      Callback for when the function is enabled
+ *
+ * @param[in]  enabled  true when function is enabled
+ */
+static void cp_enable(bool enabled)
+{
+    emu_printf("[CP] %s output\n", enabled ? "Enable" : "Disable");
+    if (enabled) {
+        i_set = 0;
+        (void) pwrctl_set_vout(10 * cp_voltage.value);
+        (void) pwrctl_set_ilimit(CONFIG_DPS_MAX_CURRENT);
+        (void) pwrctl_set_iout(i_set);
+        pwrctl_enable_vout(true);
+        softtimer_start(&control_timer, CONFIG_CP_INTERVAL_MS, CONFIG_CP_INTERVAL_MS, &cp_control);
+    } else {
+        softtimer_stop(&control_timer);
+        pwrctl_enable_vout(false);
+    }
+}
+
+/**
+ * @brief      Callback for when value of the power item is changed, the
+ *             control loop picks it up
+ *
+ * @param      item  The power item
+ */
+static void power_changed(ui_number_t *item)
+{
+    (void) item;
+}
+
+/**
+ * @brief      Callback for when value of the voltage item is changed
+ *
+ * @param      item  The voltage item
+ */
+static void voltage_changed(ui_number_t *item)
+{
+    (void) pwrctl_set_vout(10 * item->value);
+}
+
+/**
+ * @brief      Save persistent parameters
+ *
+ * @param      past  The past
+ */
+static void past_save(past_t *past)
+{
+    uint32_t power = cp_power.value;
+    uint32_t voltage = cp_voltage.value;
+    /** Both settings or neither */
+    if (!past_begin(past, 2 * PAST_UNIT_SIZE(sizeof(uint32_t)))) {
+        return;
+    }
+    (void) past_write_unit_deferred(past, (SCREEN_ID << 24) | PAST_P, (void*) &power, sizeof(power));
+    (void) past_write_unit_deferred(past, (SCREEN_ID << 24) | PAST_U, (void*) &voltage, sizeof(voltage));
+    if (!past_commit(past)) {
+        dbg_printf("Error: past write cp settings failed!\n");
+    }
+}
+
+/**
+ * @brief      Restore persistent parameters
+ *
+ * @param      past  The past
+ */
+static void past_restore(past_t *past)
+{
+    uint32_t length;
+    uint32_t *p = 0;
+    if (past_read_unit(past, (SCREEN_ID << 24) | PAST_P, (const void**) &p, &length) && length == sizeof(uint32_t)) {
+        cp_power.value = *p;
+    }
+    if (past_read_unit(past, (SCREEN_ID << 24) | PAST_U, (const void**) &p, &length) && length == sizeof(uint32_t)) {
+        cp_voltage.value = *p;
+    }
+}
+
+/**
+ * @brief      Update the limits and the measured values, the output is run
+ *             by cp_control()
+ */
+static void cp_tick(void)
+{
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+
+    /** Continously update the max settings */
+    uint32_t v_in = pwrctl_calc_vin(v_in_raw);
+    cp_voltage.max = v_in / 10;
+    cp_power.max = power_max(v_in);
+
+    number_set_value(&cp_voltage_2, pwrctl_calc_vout(v_out_raw) / 10);
+    number_set_value(&cp_current_2, pwrctl_calc_iout(i_out_raw));
+}
+
+/**
+ * @brief      Set up the items when the screen is first shown, before the
+ *             settings are restored from the past
+ */
+static void cp_activate(void)
+{
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+    (void) i_out_raw;
+    (void) v_out_raw;
+    uint32_t v_in = pwrctl_calc_vin(v_in_raw);
+    cp_voltage.max = v_in / 10;
+    cp_power.max = power_max(v_in);
+    number_init(&cp_power);
+    number_init(&cp_voltage);
+    number_init(&cp_voltage_2);
+    number_init(&cp_current_2);
+}
+
+/**
+ * @brief      Function init. Initialise the CP module and add its screen to
+ *             the UI
+ *
+ * @param      ui    The user interface
+ */
+void func_cp_init(uui_t *ui)
+{
+    uui_add_screen(ui, &cp_screen);
+}
@@ -0,0 +1,469 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hw.h"
+#include "func_cr.h"
+#include "uui.h"
+#include "uui_number.h"
+#include "softtimer.h"
+#include "dbg_printf.h"
+#include "intfmt.h"
+
+/*
+ * This is the implementation of the CR screen, emulating a source with an
+ * internal resistance such as a battery. It has two editable values, the open
+ * circuit voltage and the series resistance. While power is enabled a control
+ * loop on a soft timer lowers the output by the drop the measured current
+ * makes over the resistance, independently of the UI tick.
+ */
+
+static void cr_enable(bool _enable);
+static void voltage_changed(ui_number_t *item);
+static void resistance_changed(ui_number_t *item);
+static void cr_tick(void);
+static void cr_activate(void);
+static void cr_control(softtimer_t *timer);
+static void past_save(past_t *past);
+static void past_restore(past_t *past);
+static set_param_status_t set_parameter(char *name, char *value);
+static set_param_status_t get_parameter(char *name, char *value, uint32_t value_len);
+static set_param_status_t set_parameter_value(uint32_t id, int32_t value);
+static set_param_status_t get_parameter_value(uint32_t id, int32_t *value);
+static void apply_parameters(void);
+
+/** How often the voltage is recomputed */
+#ifndef CONFIG_CR_INTERVAL_MS
+ #define CONFIG_CR_INTERVAL_MS  (10)
+#endif
+
+/** Ids of the parameters, their index in the parameters of the screen */
+#define PARAM_VOLTAGE     (0)
+#define PARAM_RESISTANCE  (1)
+
+#define SCREEN_ID  (5)
+#define PAST_U     (0)
+#define PAST_R     (1)
+#define LINE_Y(x) (10 + (x * 24))
+
+static softtimer_t control_timer;
+static uint32_t v_set; /** mV, the voltage the loop programmed */
+
+/* This is the definition of the open circuit voltage item in the UI */
+ui_number_t cr_voltage = {
+    {
+        .type = ui_item_number,
+        .id = 10,
+        .x = 120,
+        .y = LINE_Y(0),
+        .can_focus = true,
+    },
+    .font_size = 24,
+    .value = 0,
+    .min = 0,
+    .max = 0, /** Set at init, continously updated in the tick callback */
+    .num_digits = 2,
+    .num_decimals = 2, /** 2 decimals => value is in centivolts */
+    .unit = unit_volt,
+    .changed = &voltage_changed,
+};
+
+/* This is the definition of the resistance item in the UI */
+ui_number_t cr_resistance = {
+    {
+        .type = ui_item_number,
+        .id = 11,
+        .x = 120,
+        .y = LINE_Y(1),
+        .can_focus = true,
+    },
+    .font_size = 24,
+    .value = 0,
+    .min = 0,
+    .max = 9999,
+    .num_digits = 2,
+    .num_decimals = 2, /** 2 decimals => value is in centiohms */
+    .unit = unit_ohm, /** There is no glyph for ohm, the unit cell is blank */
+    .changed = &resistance_changed,
+};
+
+/* This is the definition of the measured voltage item in the UI */
+ui_number_t cr_voltage_2 = {
+    {
+        .type = ui_item_number,
+        .id = 12,
+        .x = 120,
+        .y = LINE_Y(2),
+        .can_focus = false,
+    },
+    .font_size = 24,
+    .value = 0,
+    .min = 0,
+    .max = 0,
+    .num_digits = 2,
+    .num_decimals = 2,
+    .unit = unit_volt,
+};
+
+/* This is the definition of the measured current item in the UI */
+ui_number_t cr_current_2 = {
+    {
+        .type = ui_item_number,
+        .id = 13,
+        .x = 120,
+        .y = LINE_Y(3),
+        .can_focus = false,
+    },
+    .font_size = 24,
+    .value = 0,
+    .min = 0,
+    .max = CONFIG_DPS_MAX_CURRENT,
+    .num_digits = 1,
+    .num_decimals = 3,
+    .unit = unit_ampere,
+};
+
+/* This is the screen definition, there is no icon */
+static const ui_parameter_t cr_parameters[] = {
+    {
+        .name = "voltage", /** Open circuit voltage */
+        .unit = unit_volt,
+        .prefix = si_milli
+    },
+    {
+        .name = "r_out", /** Longer names do not fit MAX_PARAMETER_NAME */
+        .unit = unit_ohm,
+        .prefix = si_milli
+    },
+    {
+        .name = "ovp", /** Handled by uui_set_protection() */
+        .unit = unit_volt,
+        .prefix = si_milli
+    },
+    {
+        .name = "opp",
+        .unit = unit_watt,
+        .prefix = si_milli
+    },
+    {
+        .name = {'\0'} /** Terminator */
+    },
+};
+
+static const ui_screen_desc_t cr_desc = {
+    .id = SCREEN_ID,
+    .name = "cr",
+    .activate = &cr_activate,
+    .enable = &cr_enable,
+    .past_save = &past_save,
+    .past_restore = &past_restore,
+    .set_parameter = &set_parameter,
+    .get_parameter = &get_parameter,
+    .set_parameter_value = &set_parameter_value,
+    .get_parameter_value = &get_parameter_value,
+    .apply_parameters = &apply_parameters,
+    .tick = &cr_tick,
+    .num_items = 4,
+    .parameters = cr_parameters,
+    .items = { (ui_item_t*) &cr_voltage, (ui_item_t*) &cr_resistance, (ui_item_t*) &cr_voltage_2, (ui_item_t*) &cr_current_2 }
+};
+
+ui_screen_t cr_screen = {
+    .desc = &cr_desc
+};
+
+/**
+ * @brief      Map a parameter name to its id
+ *
+ * @param[in]  name  name of parameter
+ *
+ * @retval     the id, or -1 if there is no such parameter
+ */
+static int32_t parameter_id(const char *name)
+{
+    if (strcmp("voltage", name) == 0 || strcmp("u", name) == 0) {
+        return PARAM_VOLTAGE;
+    } else if (strcmp("r_out", name) == 0 || strcmp("resistance", name) == 0 || strcmp("r", name) == 0) {
+        return PARAM_RESISTANCE;
+    }
+    return -1;
+}
+
+/**
+ * @brief      Set function parameter, the output is updated by
+ *             apply_parameters()
+ *
+ * @param[in]  id     id of parameter
+ * @param[in]  value  value of parameter - always in SI units
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t set_parameter_value(uint32_t id, int32_t value)
+{
+    switch (id) {
+        case PARAM_VOLTAGE:
+            if (value < 10 * cr_voltage.min || value > 10 * cr_voltage.max) {
+                emu_printf("[CR] Voltage %d is out of range (min:%d max:%d)\n", value, 10 * cr_voltage.min, 10 * cr_voltage.max);
+                return ps_range_error;
+            }
+            emu_printf("[CR] Setting voltage to %d\n", value);
+            number_set_value(&cr_voltage, value / 10);
+            return ps_ok;
+        case PARAM_RESISTANCE:
+            /** value received in milliohm, module internal representation is centiohm */
+            if (value < 10 * cr_resistance.min || value > 10 * cr_resistance.max) {
+                emu_printf("[CR] Resistance %d is out of range (min:%d max:%d)\n", value, 10 * cr_resistance.min, 10 * cr_resistance.max);
+                return ps_range_error;
+            }
+            emu_printf("[CR] Setting resistance to %d\n", value);
+            number_set_value(&cr_resistance, value / 10);
+            return ps_ok;
+    }
+    return ps_unknown_name;
+}
+
+/**
+ * @brief      Program the output from the parameters set, the control loop
+ *             picks up the resistance
+ */
+static void apply_parameters(void)
+{
+    if (v_set > 10 * (uint32_t) cr_voltage.value) {
+        v_set = 10 * cr_voltage.value;
+        (void) pwrctl_set_vout(v_set);
+    }
+}
+
+/**
+ * @brief      Get function parameter
+ *
+ * @param[in]  id     id of parameter
+ * @param[out] value  value of parameter - always in SI units
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t get_parameter_value(uint32_t id, int32_t *value)
+{
+    switch (id) {
+        case PARAM_VOLTAGE:
+            *value = 10 * cr_voltage.value;
+            return ps_ok;
+        case PARAM_RESISTANCE:
+            *value = 10 * cr_resistance.value;
+            return ps_ok;
+    }
+    return ps_unknown_name;
+}
+
+/**
+ * @brief      Set function parameter
+ *
+ * @param[in]  name   name of parameter
+ * @param[in]  value  value of parameter as a string - always in SI units
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t set_parameter(char *name, char *value)
+{
+    int32_t id = parameter_id(name);
+    int32_t ivalue;
+    if (id < 0) {
+        return ps_unknown_name;
+    }
+    if (!intfmt_parse_i32(value, &ivalue)) {
+        return ps_range_error;
+    }
+    return set_parameter_value(id, ivalue);
+}
+
+/**
+ * @brief      Get function parameter
+ *
+ * @param[in]  name       name of parameter
+ * @param[in]  value      value of parameter as a string - always in SI units
+ * @param[in]  value_len  length of value buffer
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t get_parameter(char *name, char *value, uint32_t value_len)
+{
+    int32_t ivalue;
+    int32_t id = parameter_id(name);
+    if (id < 0 || get_parameter_value(id, &ivalue) != ps_ok) {
+        return ps_unknown_name;
+    }
+    (void) intfmt_i32(value, value_len, ivalue);
+    return ps_ok;
+}
+
+/**
+ * @brief      The control loop, moves the voltage halfway to the open circuit
+ *             voltage less the drop over the resistance. With a resistive
+ *             load the halving keeps the loop stable for resistances up to
+ *             three times the load.
+ *
+ * @param      timer  The control timer
+ */
+static void cr_control(softtimer_t *timer)
+{
+    (void) timer;
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+    (void) v_in_raw;
+    (void) v_out_raw;
+    uint32_t v_oc = 10 * cr_voltage.value;
+    /** centiohm * mA / 100 = mV */
+    uint32_t drop = (uint32_t) cr_resistance.value * pwrctl_calc_iout(i_out_raw) / 100;
+    uint32_t target = drop < v_oc ? v_oc - drop : 0;
+    v_set = (v_set + target) / 2;
+    (void) pwrctl_set_vout(v_set);
+}
+
+/**
+ * @brief      Callback for when the function is enabled
+ *
+ * @param[in]  enabled  true when function is enabled
+ */
+static void cr_enable(bool enabled)
+{
+    emu_printf("[CR] %s output\n", enabled ? "Enable" : "Disable");
+    if (enabled) {
+        v_set = 10 * cr_voltage.value;
+        (void) pwrctl_set_vout(v_set);
+        (void) pwrctl_set_ilimit(CONFIG_DPS_MAX_CURRENT);
+        (void) pwrctl_set_iout(CONFIG_DPS_MAX_CURRENT);
+        pwrctl_enable_vout(true);
+        softtimer_start(&control_timer, CONFIG_CR_INTERVAL_MS, CONFIG_CR_INTERVAL_MS, &cr_control);
+    } else {
+        softtimer_stop(&control_timer);
+        pwrctl_enable_vout(false);
+    }
+}
+
+/**
+ * @brief      Callback for when value of the voltage item is changed, the
+ *             control loop picks it up
+ *
+ * @param      item  The voltage item
+ */
+static void voltage_changed(ui_number_t *item)
+{
+    (void) item;
+    apply_parameters();
+}
+
+/**
+ * @brief      Callback for when value of the resistance item is changed, the
+ *             control loop picks it up
+ *
+ * @param      item  The resistance item
+ */
+static void resistance_changed(ui_number_t *item)
+{
+    (void) item;
+}
+
+/**
+ * @brief      Save persistent parameters
+ *
+ * @param      past  The past
+ */
+static void past_save(past_t *past)
+{
+    uint32_t voltage = cr_voltage.value;
+    uint32_t resistance = cr_resistance.value;
+    /** Both settings or neither */
+    if (!past_begin(past, 2 * PAST_UNIT_SIZE(sizeof(uint32_t)))) {
+        return;
+    }
+    (void) past_write_unit_deferred(past, (SCREEN_ID << 24) | PAST_U, (void*) &voltage, sizeof(voltage));
+    (void) past_write_unit_deferred(past, (SCREEN_ID << 24) | PAST_R, (void*) &resistance, sizeof(resistance));
+    if (!past_commit(past)) {
+        dbg_printf("Error: past write cr settings failed!\n");
+    }
+}
+
+/**
+ * @brief      Restore persistent parameters
+ *
+ * @param      past  The past
+ */
+static void past_restore(past_t *past)
+{
+    uint32_t length;
+    uint32_t *p = 0;
+    if (past_read_unit(past, (SCREEN_ID << 24) | PAST_U, (const void**) &p, &length) && length == sizeof(uint32_t)) {
+        cr_voltage.value = *p;
+    }
+    if (past_read_unit(past, (SCREEN_ID << 24) | PAST_R, (const void**) &p, &length) && length == sizeof(uint32_t)) {
+        cr_resistance.value = *p;
+    }
+}
+
+/**
+ * @brief      Update the limit and the measured values, the output is run
+ *             by cr_control()
+ */
+static void cr_tick(void)
+{
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+
+    /** Continously update the max setting */
+    cr_voltage.max = pwrctl_calc_vin(v_in_raw) / 10;
+
+    number_set_value(&cr_voltage_2, pwrctl_calc_vout(v_out_raw) / 10);
+    number_set_value(&cr_current_2, pwrctl_calc_iout(i_out_raw));
+}
+
+/**
+ * @brief      Set up the items when the screen is first shown, before the
+ *             settings are restored from the past
+ */
+static void cr_activate(void)
+{
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+    (void) i_out_raw;
+    (void) v_out_raw;
+    cr_voltage.max = pwrctl_calc_vin(v_in_raw) / 10;
+    number_init(&cr_voltage);
+    number_init(&cr_resistance);
+    number_init(&cr_voltage_2);
+    number_init(&cr_current_2);
+}
+
+/**
+ * @brief      Function init. Initialise the CR module and add its screen to
+ *             the UI
+ *
+ * @param      ui    The user interface
+ */
+void func_cr_init(uui_t *ui)
+{
+    uui_add_screen(ui, &cr_screen);
+}
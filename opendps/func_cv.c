@@ -31,7 +31,7 @@
 #include "uui.h"
 #include "uui_number.h"
 #include "dbg_printf.h"
-#include "mini-printf.h"
+#include "intfmt.h"
 #include "cv.h"
 
 /*
@@ -46,10 +46,18 @@ static void cv_enable(bool _enable);
 static void voltage_changed(ui_number_t *item);
 static void current_changed(ui_number_t *item);
 static void cv_tick(void);
+static void cv_activate(void);
 static void past_save(past_t *past);
 static void past_restore(past_t *past);
 static set_param_status_t set_parameter(char *name, char *value);
 static set_param_status_t get_parameter(char *name, char *value, uint32_t value_len);
+static set_param_status_t set_parameter_value(uint32_t id, int32_t value);
+static set_param_status_t get_parameter_value(uint32_t id, int32_t *value);
+static void apply_parameters(void);
+
+/** Ids of the parameters, their index in the parameters of the screen */
+#define PARAM_VOLTAGE  (0)
+#define PARAM_CURRENT  (1)
 
 #define SCREEN_ID  (1)
 #define PAST_U     (0)
@@ -134,38 +142,139 @@ ui_number_t cv_current_2 = {
 
 
 /* This is the screen definition */
-ui_screen_t cv_screen = {
+static const ui_parameter_t cv_parameters[] = {
+    {
+        .name = "voltage",
+        .unit = unit_volt,
+        .prefix = si_milli
+    },
+    {
+        .name = "current",
+        .unit = unit_ampere,
+        .prefix = si_milli
+    },
+    {
+        .name = "ovp", /** Handled by uui_set_protection() */
+        .unit = unit_volt,
+        .prefix = si_milli
+    },
+    {
+        .name = "opp",
+        .unit = unit_watt,
+        .prefix = si_milli
+    },
+    {
+        .name = {'\0'} /** Terminator */
+    },
+};
+
+static const ui_screen_desc_t cv_desc = {
     .id = SCREEN_ID,
     .name = "cv",
-    .icon_data = (uint8_t *) cv,
+    .icon_data = (const uint8_t *) cv,
+    .icon_palette = (const uint8_t *) cv_palette,
     .icon_data_len = sizeof(cv),
     .icon_width = cv_width,
     .icon_height = cv_height,
+    .activate = &cv_activate,
     .enable = &cv_enable,
     .past_save = &past_save,
     .past_restore = &past_restore,
     .tick = &cv_tick,
     .set_parameter = &set_parameter,
     .get_parameter = &get_parameter,
+    .set_parameter_value = &set_parameter_value,
+    .get_parameter_value = &get_parameter_value,
+    .apply_parameters = &apply_parameters,
     .num_items = 4,
-    .parameters = {
-        {
-            .name = "voltage",
-            .unit = unit_volt,
-            .prefix = si_milli
-        },
-        {
-            .name = "current",
-            .unit = unit_ampere,
-            .prefix = si_milli
-        },
-        {
-            .name = {'\0'} /** Terminator */
-        },
-    },
+    .parameters = cv_parameters,
     .items = { (ui_item_t*) &cv_voltage, (ui_item_t*) &cv_current, (ui_item_t*) &cv_voltage_2, (ui_item_t*) &cv_current_2 }
 };
 
+ui_screen_t cv_screen = {
+    .desc = &cv_desc
+};
+
+/**
+ * @brief      Map a parameter name to its id
+ *
+ * @param[in]  name  name of parameter
+ *
+ * @retval     the id, or -1 if there is no such parameter
+ */
+static int32_t parameter_id(const char *name)
+{
+    if (strcmp("voltage", name) == 0 || strcmp("u", name) == 0) {
+        return PARAM_VOLTAGE;
+    } else if (strcmp("current", name) == 0 || strcmp("i", name) == 0) {
+        return PARAM_CURRENT;
+    }
+    return -1;
+}
+
+/**
+ * @brief      Set function parameter, the output is updated by
+ *             apply_parameters()
+ *
+ * @param[in]  id     id of parameter
+ * @param[in]  value  value of parameter - always in SI units
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t set_parameter_value(uint32_t id, int32_t value)
+{
+    switch (id) {
+        case PARAM_VOLTAGE:
+            /** value received in millivolt, module internal representation is centivolt */
+            if (value < 10 * cv_voltage.min || value > 10 * cv_voltage.max) {
+                emu_printf("[CV] Voltage %d is out of range (min:%d max:%d)\n", value, 10 * cv_voltage.min, 10 * cv_voltage.max);
+                return ps_range_error;
+            }
+            emu_printf("[CV] Setting voltage to %d\n", value);
+            number_set_value(&cv_voltage, value / 10);
+            return ps_ok;
+        case PARAM_CURRENT:
+            if (value < cv_current.min || value > cv_current.max) {
+                emu_printf("[CV] Current %d is out of range (min:%d max:%d)\n", value, cv_current.min, cv_current.max);
+                return ps_range_error;
+            }
+            emu_printf("[CV] Setting current to %d\n", value);
+            number_set_value(&cv_current, value);
+            return ps_ok;
+    }
+    return ps_unknown_name;
+}
+
+/**
+ * @brief      Program the output from the parameters set
+ */
+static void apply_parameters(void)
+{
+    (void) pwrctl_set_output(10 * cv_voltage.value, cv_current.value);
+}
+
+/**
+ * @brief      Get function parameter
+ *
+ * @param[in]  id     id of parameter
+ * @param[out] value  value of parameter - always in SI units
+ *
+ * @retval     set_param_status_t status code
+ */
+static set_param_status_t get_parameter_value(uint32_t id, int32_t *value)
+{
+    switch (id) {
+        case PARAM_VOLTAGE:
+            /** value returned in millivolt, module internal representation is centivolt */
+            *value = 10 * cv_voltage.value;
+            return ps_ok;
+        case PARAM_CURRENT:
+            *value = cv_current.value;
+            return ps_ok;
+    }
+    return ps_unknown_name;
+}
+
 /**
  * @brief      Set function parameter
  *
@@ -176,28 +285,15 @@ ui_screen_t cv_screen = {
  */
 static set_param_status_t set_parameter(char *name, char *value)
 {
-    int32_t ivalue = atoi(value);
-    if (strcmp("voltage", name) == 0 || strcmp("u", name) == 0) {
-        if (ivalue < cv_voltage.min || ivalue > cv_voltage.max) {
-            emu_printf("[CV] Voltage %d is out of range (min:%d max:%d)\n", ivalue, cv_voltage.min, cv_voltage.max);
-            return ps_range_error;
-        }
-        emu_printf("[CV] Setting voltage to %d\n", ivalue);
-        /** value received in millivolt, module internal representation is centivolt */
-        cv_voltage.value = ivalue / 10;
-        voltage_changed(&cv_voltage);
-        return ps_ok;
-    } else if (strcmp("current", name) == 0 || strcmp("i", name) == 0) {
-        if (ivalue < cv_current.min || ivalue > cv_current.max) {
-            emu_printf("[CV] Current %d is out of range (min:%d max:%d)\n", ivalue, cv_current.min, cv_current.max);
-            return ps_range_error;
-        }
-        emu_printf("[CV] Setting current to %d\n", ivalue);
-        cv_current.value = ivalue;
-        current_changed(&cv_current);
-        return ps_ok;
+    int32_t id = parameter_id(name);
+    int32_t ivalue;
+    if (id < 0) {
+        return ps_unknown_name;
     }
-    return ps_unknown_name;
+    if (!intfmt_parse_i32(value, &ivalue)) {
+        return ps_range_error;
+    }
+    return set_parameter_value(id, ivalue);
 }
 
 /**
@@ -211,15 +307,13 @@ static set_param_status_t set_parameter(char *name, char *value)
  */
 static set_param_status_t get_parameter(char *name, char *value, uint32_t value_len)
 {
-    if (strcmp("voltage", name) == 0 || strcmp("u", name) == 0) {
-        /** value returned in millivolt, module internal representation is centivolt */
-        (void) mini_snprintf(value, value_len, "%d", 10 * cv_voltage.value);
-        return ps_ok;
-    } else if (strcmp("current", name) == 0 || strcmp("i", name) == 0) {
-        (void) mini_snprintf(value, value_len, "%d", cv_current.value);
-        return ps_ok;
+    int32_t ivalue;
+    int32_t id = parameter_id(name);
+    if (id < 0 || get_parameter_value(id, &ivalue) != ps_ok) {
+        return ps_unknown_name;
     }
-    return ps_unknown_name;
+    (void) intfmt_i32(value, value_len, ivalue);
+    return ps_ok;
 }
 
 /**
@@ -234,9 +328,15 @@ static void cv_enable(bool enabled)
         (void) pwrctl_set_vout(10 * cv_voltage.value);
         (void) pwrctl_set_iout(CONFIG_DPS_MAX_CURRENT);
         (void) pwrctl_set_ilimit(cv_current.value);
+#ifdef CONFIG_VOUT_REGULATION
+        pwrctl_set_vout_regulation(true);
+#endif // CONFIG_VOUT_REGULATION
         pwrctl_enable_vout(true);
     } else {
         pwrctl_enable_vout(false);
+#ifdef CONFIG_VOUT_REGULATION
+        pwrctl_set_vout_regulation(false);
+#endif // CONFIG_VOUT_REGULATION
     }
 }
 
@@ -249,7 +349,6 @@ static void voltage_changed(ui_number_t *item)
 {
     cv_voltage.value = item->value;
     (void) pwrctl_set_vout(10 * item->value);
-    cv_voltage.ui.draw(&cv_voltage.ui);
 }
 
 /**
@@ -261,7 +360,6 @@ static void current_changed(ui_number_t *item)
 {
     cv_current.value = item->value;
     (void) pwrctl_set_iout(item->value);
-    cv_current.ui.draw(&cv_current.ui);
 }
 
 /**
@@ -271,11 +369,18 @@ static void current_changed(ui_number_t *item)
  */
 static void past_save(past_t *past)
 {
-    /** @todo: past bug causes corruption for units smaller than 4 bytes (#27) */
-    if (!past_write_unit(past, (SCREEN_ID << 24) | PAST_U, (void*) &cv_voltage.value, 4 /* sizeof(cv_voltage.value) */ )) {
+    /** Both limits or neither */
+    if (!past_begin(past, 2 * PAST_UNIT_SIZE(4))) {
         /** @todo: handle past write failures */
+        return;
     }
-    if (!past_write_unit(past, (SCREEN_ID << 24) | PAST_I, (void*) &cv_current.value, 4 /* sizeof(cv_current.value) */ )) {
+    if (!past_write_unit_deferred(past, (SCREEN_ID << 24) | PAST_U, (void*) &cv_voltage.value, 4 /* sizeof(cv_voltage.value) */ )) {
+        /** @todo: handle past write failures */
+    }
+    if (!past_write_unit_deferred(past, (SCREEN_ID << 24) | PAST_I, (void*) &cv_current.value, 4 /* sizeof(cv_current.value) */ )) {
+        /** @todo: handle past write failures */
+    }
+    if (!past_commit(past)) {
         /** @todo: handle past write failures */
     }
 }
@@ -317,25 +422,18 @@ static void cv_tick(void)
 
     /** No focus, update display if necessary */
     int32_t new_u = pwrctl_calc_vout(v_out_raw) / 10;
-    if (new_u != cv_voltage_2.value) {
-        cv_voltage_2.value = new_u;
-        cv_voltage_2.ui.draw(&cv_voltage_2.ui);
-    }
+    number_set_value(&cv_voltage_2, new_u);
 
     /** No focus, update display if necessary */
     int32_t new_i = pwrctl_calc_iout(i_out_raw);
-    if (new_i != cv_current_2.value) {
-        cv_current_2.value = new_i;
-        cv_current_2.ui.draw(&cv_current_2.ui);
-    }
+    number_set_value(&cv_current_2, new_i);
 }
 
 /**
- * @brief      Initialise the CV module and add its screen to the UI
- *
- * @param      ui    The user interface
+ * @brief      Set up the items when the screen is first shown, before the
+ *             settings are restored from the past
  */
-void func_cv_init(uui_t *ui)
+static void cv_activate(void)
 {
     cv_voltage.value = 0; /** read from past */
     cv_current.value = 0; /** read from past */
@@ -351,5 +449,14 @@ void func_cv_init(uui_t *ui)
     number_init(&cv_current);
     number_init(&cv_voltage_2);
     number_init(&cv_current_2);
+}
+
+/**
+ * @brief      Initialise the CV module and add its screen to the UI
+ *
+ * @param      ui    The user interface
+ */
+void func_cv_init(uui_t *ui)
+{
     uui_add_screen(ui, &cv_screen);
 }
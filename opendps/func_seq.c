@@ -0,0 +1,351 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "hw.h"
+#include "func_seq.h"
+#include "uui.h"
+#include "uui_number.h"
+#include "seq.h"
+#include "tick.h"
+#include "dbg_printf.h"
+
+/*
+ * This is the implementation of the sequencer screen.
+ *
+ * It runs an uploaded list of (V_out, I_out, duration) steps in constant
+ * current mode. The steps are switched from the systick ISR making the step
+ * timing accurate to the millisecond. When the sequence has been run
+ * 'repeat' times the output is held at the last step, end the sequence
+ * with a 0V step to turn the output off.
+ * The screen shows the settings of the current step and the output voltage
+ * and current, there is nothing to edit.
+ */
+
+static void seq_enable(bool _enable);
+static void seq_tick(void);
+static void seq_activate(void);
+static void past_restore(past_t *past);
+
+#define SCREEN_ID    (3)
+#define PAST_STEPS   (0)
+#define PAST_REPEAT  (1)
+#define LINE_Y(x) (10 + (x * 24))
+
+/** The sequence */
+static seq_step_t seq_steps[CONFIG_SEQ_MAX_STEPS];
+static uint32_t seq_count;
+static uint32_t seq_repeat;
+/** Number of steps received of an ongoing upload */
+static uint32_t seq_upload_count;
+static past_t *seq_past;
+
+/** Run state, owned by the systick ISR while seq_running is set */
+static volatile bool seq_running;
+static volatile uint32_t seq_step;
+static volatile uint32_t seq_loop;
+static volatile uint32_t seq_remaining_ms;
+
+/* The voltage setting of the current step */
+ui_number_t seq_voltage = {
+    {
+        .type = ui_item_number,
+        .id = 10,
+        .x = 120,
+        .y = LINE_Y(0),
+        .can_focus = false,
+    },
+    .font_size = 24,
+    .value = 0,
+    .num_digits = 2,
+    .num_decimals = 2, /** 2 decimals => value is in centivolts */
+    .unit = unit_volt,
+};
+
+/* The current setting of the current step */
+ui_number_t seq_current = {
+    {
+        .type = ui_item_number,
+        .id = 11,
+        .x = 120,
+        .y = LINE_Y(1),
+        .can_focus = false,
+    },
+    .font_size = 24,
+    .value = 0,
+    .num_digits = 1,
+    .num_decimals = 3, /** 3 decimals => value is in milliapmere */
+    .unit = unit_ampere,
+};
+
+/* The output voltage */
+ui_number_t seq_voltage_2 = {
+    {
+        .type = ui_item_number,
+        .id = 12,
+        .x = 120,
+        .y = LINE_Y(2),
+        .can_focus = false,
+    },
+    .font_size = 24,
+    .value = 0,
+    .num_digits = 2,
+    .num_decimals = 2,
+    .unit = unit_volt,
+};
+
+/* The output current */
+ui_number_t seq_current_2 = {
+    {
+        .type = ui_item_number,
+        .id = 13,
+        .x = 120,
+        .y = LINE_Y(3),
+        .can_focus = false,
+    },
+    .font_size = 24,
+    .value = 0,
+    .num_digits = 1,
+    .num_decimals = 3,
+    .unit = unit_ampere,
+};
+
+/* This is the screen definition */
+static const ui_parameter_t seq_parameters[] = {
+    {
+        .name = "ovp", /** Handled by uui_set_protection() */
+        .unit = unit_volt,
+        .prefix = si_milli
+    },
+    {
+        .name = "opp",
+        .unit = unit_watt,
+        .prefix = si_milli
+    },
+    {
+        .name = {'\0'} /** Terminator */
+    },
+};
+
+static const ui_screen_desc_t seq_desc = {
+    .id = SCREEN_ID,
+    .name = "seq",
+    .icon_data = (const uint8_t *) seq,
+    .icon_palette = (const uint8_t *) seq_palette,
+    .icon_data_len = sizeof(seq),
+    .icon_width = seq_width,
+    .icon_height = seq_height,
+    .enable = &seq_enable,
+    .activate = &seq_activate,
+    .past_restore = &past_restore,
+    .tick = &seq_tick,
+    .num_items = 4,
+    .parameters = seq_parameters,
+    .items = { (ui_item_t*) &seq_voltage, (ui_item_t*) &seq_current, (ui_item_t*) &seq_voltage_2, (ui_item_t*) &seq_current_2 }
+};
+
+ui_screen_t seq_screen = {
+    .desc = &seq_desc
+};
+
+/**
+ * @brief      Set the output to a step
+ *
+ * @param[in]  step  The step
+ */
+static void apply_step(uint32_t step)
+{
+    (void) pwrctl_set_vout(seq_steps[step].v_out_mv);
+    (void) pwrctl_set_iout(seq_steps[step].i_out_ma);
+}
+
+/**
+ * @brief      Advance the sequence, called from the systick ISR every
+ *             millisecond
+ */
+static void seq_tick_ms(void)
+{
+    if (!seq_running || --seq_remaining_ms) {
+        return;
+    }
+    uint32_t next = seq_step + 1;
+    if (next == seq_count) {
+        if (seq_repeat && ++seq_loop == seq_repeat) {
+            seq_running = false; /** Hold the last step */
+            return;
+        }
+        next = 0;
+    }
+    seq_step = next;
+    seq_remaining_ms = seq_steps[next].duration_ms;
+    apply_step(next);
+}
+
+/**
+ * @brief      Callback for when the function is enabled
+ *
+ * @param[in]  enabled  true when function is enabled
+ */
+static void seq_enable(bool enabled)
+{
+    emu_printf("[SEQ] %s output\n", enabled ? "Enable" : "Disable");
+    seq_running = false;
+    if (enabled && seq_count) {
+        (void) pwrctl_set_ilimit(CONFIG_DPS_MAX_CURRENT);
+        seq_step = 0;
+        seq_loop = 0;
+        seq_remaining_ms = seq_steps[0].duration_ms;
+        apply_step(0);
+        pwrctl_enable_vout(true);
+        seq_running = true;
+    } else {
+        pwrctl_enable_vout(false);
+    }
+}
+
+/**
+ * @brief      Upload (part of) a sequence, the sequence is stored in past
+ *             when the last step has been received
+ *
+ * @param[in]  total   Number of steps in the sequence, 0 erases it
+ * @param[in]  first   Index of the first step in steps, uploads are made
+ *                     in order
+ * @param[in]  repeat  Number of times to run the sequence, 0 for forever
+ * @param[in]  steps   The steps
+ * @param[in]  count   Number of steps
+ *
+ * @return     false if the sequencer is running or the upload is out of
+ *             order or invalid
+ */
+bool func_seq_upload(uint32_t total, uint32_t first, uint32_t repeat, const seq_step_t *steps, uint32_t count)
+{
+    if (seq_screen.is_enabled || total > CONFIG_SEQ_MAX_STEPS || first + count > total) {
+        return false;
+    }
+    if (first == 0) {
+        seq_upload_count = 0;
+    } else if (first != seq_upload_count) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (!steps[i].duration_ms) {
+            return false;
+        }
+    }
+    /** The sequence is unusable until the upload is complete */
+    seq_count = 0;
+    memcpy(&seq_steps[first], steps, count * sizeof(seq_step_t));
+    seq_upload_count += count;
+    if (seq_upload_count < total) {
+        return true;
+    }
+    seq_upload_count = 0;
+    seq_repeat = repeat;
+    seq_count = total;
+    if (!total) {
+        (void) past_erase_unit(seq_past, (SCREEN_ID << 24) | PAST_STEPS);
+        return true;
+    }
+    /** The steps and the repeat count are kept together */
+    if (!past_begin(seq_past, PAST_UNIT_SIZE(total * sizeof(seq_step_t)) + PAST_UNIT_SIZE(sizeof(seq_repeat)))) {
+        dbg_printf("Error: past write sequence failed!\n");
+        return false;
+    }
+    (void) past_write_unit(seq_past, (SCREEN_ID << 24) | PAST_STEPS, (void*) seq_steps, total * sizeof(seq_step_t));
+    (void) past_write_unit(seq_past, (SCREEN_ID << 24) | PAST_REPEAT, (void*) &seq_repeat, sizeof(seq_repeat));
+    if (!past_commit(seq_past)) {
+        dbg_printf("Error: past write sequence failed!\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief      Restore persistent parameters
+ *
+ * @param      past  The past
+ */
+static void past_restore(past_t *past)
+{
+    uint32_t length;
+    const void *p = 0;
+    if (seq_upload_count) {
+        return; /** An upload in progress owns the steps */
+    }
+    if (past_read_unit(past, (SCREEN_ID << 24) | PAST_STEPS, &p, &length) && length <= sizeof(seq_steps)) {
+        memcpy(seq_steps, p, length);
+        seq_count = length / sizeof(seq_step_t);
+    }
+    if (past_read_unit(past, (SCREEN_ID << 24) | PAST_REPEAT, &p, &length) && length == sizeof(seq_repeat)) {
+        memcpy(&seq_repeat, p, length);
+    }
+}
+
+/**
+ * @brief      Update the UI with the settings of the current step and the
+ *             output voltage and current
+ */
+static void seq_tick(void)
+{
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+    (void) v_in_raw;
+
+    int32_t new_u = pwrctl_get_vout() / 10;
+    number_set_value(&seq_voltage, new_u);
+    int32_t new_i = pwrctl_get_iout();
+    number_set_value(&seq_current, new_i);
+    new_u = pwrctl_calc_vout(v_out_raw) / 10;
+    number_set_value(&seq_voltage_2, new_u);
+    new_i = pwrctl_calc_iout(i_out_raw);
+    number_set_value(&seq_current_2, new_i);
+}
+
+/**
+ * @brief      Set up the items when the screen is first shown
+ */
+static void seq_activate(void)
+{
+    number_init(&seq_voltage);
+    number_init(&seq_current);
+    number_init(&seq_voltage_2);
+    number_init(&seq_current_2);
+}
+
+/**
+ * @brief      Function init. Initialise the sequencer module and add its
+ *             screen to the UI. Sequences can be uploaded before the screen
+ *             is first shown, so the past is kept here.
+ *
+ * @param      ui    The user interface
+ */
+void func_seq_init(uui_t *ui)
+{
+    seq_past = ui->past;
+    uui_add_screen(ui, &seq_screen);
+    (void) tick_add_callback(&seq_tick_ms);
+}
@@ -0,0 +1,65 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef __FUNC_SEQ_H__
+#define __FUNC_SEQ_H__
+
+#include "uui.h"
+
+#ifndef CONFIG_SEQ_MAX_STEPS
+ #define CONFIG_SEQ_MAX_STEPS  (32)
+#endif
+
+/** One step of a sequence */
+typedef struct {
+    uint16_t v_out_mv;
+    uint16_t i_out_ma;    /** Constant current setting */
+    uint32_t duration_ms; /** At least 1 */
+} seq_step_t;
+
+/**
+ * @brief      Add the sequencer function to the UI
+ *
+ * @param      ui    The user interface
+ */
+void func_seq_init(uui_t *ui);
+
+/**
+ * @brief      Upload (part of) a sequence, the sequence is stored in past
+ *             when the last step has been received
+ *
+ * @param[in]  total   Number of steps in the sequence, 0 erases it
+ * @param[in]  first   Index of the first step in steps, uploads are made
+ *                     in order
+ * @param[in]  repeat  Number of times to run the sequence, 0 for forever
+ * @param[in]  steps   The steps
+ * @param[in]  count   Number of steps
+ *
+ * @return     false if the sequencer is running or the upload is out of
+ *             order or invalid
+ */
+bool func_seq_upload(uint32_t total, uint32_t first, uint32_t repeat, const seq_step_t *steps, uint32_t count);
+
+#endif // __FUNC_SEQ_H__
@@ -1,6 +1,6 @@
 #!/bin/bash
 #
-# Convert gfx/png/*.png to bgr565 formatted header files
+# Convert gfx/png/*.png to palette packed bgr565 header files (see pack565.py)
 #
 
 
@@ -23,7 +23,7 @@ if which magick >/dev/null; then
 		magick $src -colorspace gray +level-colors ,#$TINT -depth 8 rgb:- | ../../rgbtobgr565 > $base
 		width="_width  "`file $src | sed 's/\ //g' | cut -d, -f 2 | cut -dx -f1`
 		height="_height  "`file $src | sed 's/\ //g' | cut -d, -f 2 | cut -dx -f2`
-		xxd -c 16 -i $base | sed 's/unsigned char/const uint8_t/g' | grep -v "unsigned int" > $dst
+		../../pack565.py $base $TINT < $base > $dst
 		echo "#define $base$width" >> $dst
 		echo "#define $base$height" >> $dst
 		rm $base
@@ -1,5 +1,10 @@
 # -*- coding: utf-8 -*-
+#
+# Render the glyphs of a font side by side, and the image marking their
+# widths, for font-convert.py. Usage: generate_font.py [size [characters]]
+# The characters must be the ones font-convert.py is given, in order.
 
+import sys
 from PIL import Image
 from PIL import ImageDraw
 from PIL import ImageFont
@@ -9,9 +14,10 @@ canvas = Image.new("RGB", (1000, 100), (0,0,0))
 canvas_width = Image.new("RGB", (1000, 100), (0,0,0))
 draw = ImageDraw.Draw(canvas)
 
-font = ImageFont.truetype("Ubuntu-C.ttf", 24)
+size = int(sys.argv[1]) if len(sys.argv) > 1 else 24
+content = sys.argv[2] if len(sys.argv) > 2 else "0123456789.VA"
 
-content = "0123456789.VA"
+font = ImageFont.truetype("Ubuntu-C.ttf", size)
 
 def meassure(im, border):
   bg = Image.new(im.mode, im.size, border)
@@ -50,5 +56,5 @@ for i in range(0, len(content)):
 
 canvas = canvas.crop(meassure(canvas, (0,0,0,0)))
 canvas_width = canvas_width.crop(meassure(canvas, (0,0,0,0)))
-canvas.save("fonts/ubuntu_condensed_24.png")
-canvas_width.save("fonts/ubuntu_condensed_24_width.png")
+canvas.save("fonts/ubuntu_condensed_%d.png" % (size))
+canvas_width.save("fonts/ubuntu_condensed_%d_width.png" % (size))
@@ -0,0 +1,214 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "histogram.h"
+#include "hw.h"
+#include "pwrctl.h"
+#include "softtimer.h"
+#include "past.h"
+#include "pastunits.h"
+#include "dbg_printf.h"
+
+static histogram_t counters;
+static past_t *histogram_past;
+static softtimer_t histogram_timer;
+/** Samples taken since the counters were written to past */
+static uint32_t unsaved;
+/** Samples skipped since the last one counted, see histogram_t */
+static uint32_t skipped;
+static bool was_enabled;
+
+static void histogram_tick(softtimer_t *timer);
+
+/**
+  * @brief Write the counters to past
+  * @retval None
+  */
+static void store_counters(void)
+{
+    unsaved = 0;
+    if (histogram_past && !past_write_unit(histogram_past, past_histogram, (void*) &counters, sizeof(counters))) {
+        dbg_printf("Error: past write histogram failed!\n");
+    }
+}
+
+/**
+  * @brief Initialize the histogram, restoring the counters from past and
+  *        starting the sampling
+  * @param past the past the counters are stored in
+  * @retval None
+  */
+void histogram_init(past_t *past)
+{
+    const void *stored;
+    uint32_t length;
+    histogram_past = past;
+    if (past_read_unit(past, past_histogram, &stored, &length) && length == sizeof(counters)) {
+        memcpy(&counters, stored, sizeof(counters));
+        if (counters.scale > HISTOGRAM_MAX_SCALE) {
+            memset(&counters, 0, sizeof(counters));
+        }
+    }
+    was_enabled = pwrctl_vout_enabled();
+    softtimer_start(&histogram_timer, CONFIG_HISTOGRAM_INTERVAL_MS, CONFIG_HISTOGRAM_INTERVAL_MS, &histogram_tick);
+}
+
+/**
+  * @brief Get the bin a reading is counted in, bin b < 4 holds the value b
+  *        and a higher bin the values from (2 + (b & 1)) << (b / 2 - 1) up
+  *        to the lower edge of the next bin
+  * @param value the reading in mV or mA
+  * @retval the bin
+  */
+uint32_t histogram_bin(uint32_t value)
+{
+    if (value > 0xffff) {
+        value = 0xffff;
+    }
+    if (value < 4) {
+        return value;
+    }
+    uint32_t msb = 31 - __builtin_clz(value);
+    return 2 * msb + ((value >> (msb - 1)) & 1);
+}
+
+/**
+  * @brief Halve the counters, a count then stands for twice the samples
+  * @retval None
+  */
+static void halve_counters(void)
+{
+    /** Rounding up keeps the bins that were ever hit */
+    for (uint32_t c = 0; c < histogram_max_channel; c++) {
+        for (uint32_t b = 0; b < HISTOGRAM_BINS; b++) {
+            counters.bins[c][b] = (counters.bins[c][b] + 1) >> 1;
+        }
+    }
+    for (uint32_t i = 0; i < HISTOGRAM_LIMITS; i++) {
+        counters.above[i] = (counters.above[i] + 1) >> 1;
+    }
+    counters.scale++;
+}
+
+/**
+  * @brief Count a sample, the counters saturate at HISTOGRAM_MAX_SCALE
+  * @param counter the counter
+  * @retval None
+  */
+static void count(uint16_t *counter)
+{
+    if (*counter == UINT16_MAX) {
+        if (counters.scale == HISTOGRAM_MAX_SCALE) {
+            return;
+        }
+        halve_counters();
+    }
+    (*counter)++;
+}
+
+/**
+  * @brief Count the readings while power out is enabled, run every
+  *        CONFIG_HISTOGRAM_INTERVAL_MS. The counters are written to past
+  *        every CONFIG_HISTOGRAM_SAVE_MS, and when power out is disabled
+  *        after CONFIG_HISTOGRAM_MIN_SAVE_MS.
+  * @param timer the histogram timer
+  * @retval None
+  */
+static void histogram_tick(softtimer_t *timer)
+{
+    (void) timer;
+    bool enabled = pwrctl_vout_enabled();
+    if (was_enabled && !enabled && unsaved >= CONFIG_HISTOGRAM_MIN_SAVE_MS / CONFIG_HISTOGRAM_INTERVAL_MS) {
+        store_counters();
+    }
+    was_enabled = enabled;
+    if (!enabled) {
+        return;
+    }
+    if (++unsaved >= CONFIG_HISTOGRAM_SAVE_MS / CONFIG_HISTOGRAM_INTERVAL_MS) {
+        store_counters();
+    }
+    if (++skipped < (1UL << counters.scale)) {
+        return;
+    }
+    skipped = 0;
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+    uint32_t v_out = pwrctl_calc_vout(v_out_raw);
+    uint32_t i_out = pwrctl_calc_iout(i_out_raw);
+    count(&counters.bins[histogram_v_out][histogram_bin(v_out)]);
+    count(&counters.bins[histogram_i_out][histogram_bin(i_out)]);
+    for (uint32_t i = 0; i < HISTOGRAM_LIMITS; i++) {
+        if (counters.limit[i] && i_out > counters.limit[i]) {
+            count(&counters.above[i]);
+        }
+    }
+}
+
+/**
+  * @brief Get the counters
+  * @retval the counters
+  */
+const histogram_t *histogram_get(void)
+{
+    return &counters;
+}
+
+/**
+  * @brief Get the number of samples a counter stands for
+  * @param count one of the counters
+  * @retval the samples
+  */
+uint32_t histogram_samples(uint16_t count)
+{
+    return (uint32_t) count << counters.scale;
+}
+
+/**
+  * @brief Set the I_out limits, their counters start over
+  * @param limit HISTOGRAM_LIMITS limits in mA, 0 for the unused ones
+  * @retval None
+  */
+void histogram_set_limits(const uint16_t *limit)
+{
+    memcpy(counters.limit, limit, sizeof(counters.limit));
+    memset(counters.above, 0, sizeof(counters.above));
+    store_counters();
+}
+
+/**
+  * @brief Clear the counters, in ram and in past, the limits are kept
+  * @retval None
+  */
+void histogram_reset(void)
+{
+    memset(counters.bins, 0, sizeof(counters.bins));
+    memset(counters.above, 0, sizeof(counters.above));
+    counters.scale = 0;
+    skipped = 0;
+    store_counters();
+}
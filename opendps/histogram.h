@@ -0,0 +1,119 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __HISTOGRAM_H__
+#define __HISTOGRAM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "past.h"
+#include "protocol.h"
+
+/** A load profile over hours or days: V_out and I_out are sampled while
+  * power out is enabled and each sample is counted in one of HISTOGRAM_BINS
+  * logarithmic bins per channel, two per octave. The samples of I_out above
+  * each of HISTOGRAM_LIMITS limits are counted too. The memory used does
+  * not depend on the time recorded: the counters are 16 bits, and when one
+  * would overflow all are halved and from then on one sample in two is
+  * counted, keeping the shape of the profile. */
+
+/** How often V_out and I_out are sampled, on a soft timer */
+#ifndef CONFIG_HISTOGRAM_INTERVAL_MS
+ #define CONFIG_HISTOGRAM_INTERVAL_MS  (10)
+#endif
+
+/** How often the counters are written to past while recording */
+#ifndef CONFIG_HISTOGRAM_SAVE_MS
+ #define CONFIG_HISTOGRAM_SAVE_MS  (30 * 60 * 1000)
+#endif
+
+/** The counters are also written when power out is disabled, if this much
+  * has been recorded since they were written, so toggling power out does
+  * not wear the flash */
+#ifndef CONFIG_HISTOGRAM_MIN_SAVE_MS
+ #define CONFIG_HISTOGRAM_MIN_SAVE_MS  (5 * 60 * 1000)
+#endif
+
+/** The largest scale of the counters, the samples they stand for fit 32 bits */
+#define HISTOGRAM_MAX_SCALE  (16)
+
+typedef enum {
+    histogram_v_out = 0, /** mV */
+    histogram_i_out,     /** mA */
+    histogram_max_channel
+} histogram_channel_t;
+
+/** The counters, stored in past as is. A count stands for 1 << scale
+  * samples, see histogram_samples(). */
+typedef struct {
+    uint16_t bins[histogram_max_channel][HISTOGRAM_BINS]; /** Samples per bin */
+    uint16_t above[HISTOGRAM_LIMITS]; /** Samples of I_out above each limit */
+    uint16_t limit[HISTOGRAM_LIMITS]; /** In mA, 0 is not used */
+    uint8_t scale;
+} histogram_t;
+
+/**
+  * @brief Initialize the histogram, restoring the counters from past and
+  *        starting the sampling
+  * @param past the past the counters are stored in
+  * @retval None
+  */
+void histogram_init(past_t *past);
+
+/**
+  * @brief Get the bin a reading is counted in, bin b < 4 holds the value b
+  *        and a higher bin the values from (2 + (b & 1)) << (b / 2 - 1) up
+  *        to the lower edge of the next bin
+  * @param value the reading in mV or mA
+  * @retval the bin
+  */
+uint32_t histogram_bin(uint32_t value);
+
+/**
+  * @brief Get the counters
+  * @retval the counters
+  */
+const histogram_t *histogram_get(void);
+
+/**
+  * @brief Get the number of samples a counter stands for
+  * @param count one of the counters
+  * @retval the samples
+  */
+uint32_t histogram_samples(uint16_t count);
+
+/**
+  * @brief Set the I_out limits, their counters start over
+  * @param limit HISTOGRAM_LIMITS limits in mA, 0 for the unused ones
+  * @retval None
+  */
+void histogram_set_limits(const uint16_t *limit);
+
+/**
+  * @brief Clear the counters, in ram and in past, the limits are kept
+  * @retval None
+  */
+void histogram_reset(void);
+
+#endif // __HISTOGRAM_H__
@@ -31,89 +31,106 @@
 #include <adc.h>
 #include <gpio.h>
 #include <nvic.h>
-#include <exti.h>
 #include <usart.h>
 #include <scb.h>
+#include <cortex.h>
+#include <dbgmcu.h>
+#if defined(CONFIG_ADC_DMA) || defined(CONFIG_WAVE)
+#include <dma.h>
+#endif // CONFIG_ADC_DMA || CONFIG_WAVE
 #include "tick.h"
+#include "buttons.h"
 #include "spi_driver.h"
 #include "pwrctl.h"
 #include "hw.h"
+#include "adc_scan.h"
 #include "event.h"
+#include "ringbuf.h"
 #include "dps-model.h"
+#include "profile.h"
+#ifdef CONFIG_CAPTURE
+#include "capture.h"
+#endif // CONFIG_CAPTURE
 
 /** Linker file symbols */
 extern uint32_t *_ram_vect_start;
 extern uint32_t *_ram_vect_end;
 extern uint32_t *vector_table;
 
-static void tim2_init(void);
+static void adc_timer_init(void);
 static void clock_init(void);
 static void adc1_init(void);
+#if defined(CONFIG_ADC_PLAN) && !defined(CONFIG_ADC_DMA)
+static void adc_plan_init(void);
+#endif // CONFIG_ADC_PLAN && !CONFIG_ADC_DMA
 static void usart_init(void);
 static void gpio_init(void);
-static void exti_init(void);
 static void dac_init(void);
-static void button_irq_init(void);
 static void copy_vectors(void);
 
-static volatile uint16_t i_out_adc;
-static volatile uint16_t i_out_trig_adc;
-static volatile uint16_t v_in_adc;
-static volatile uint16_t v_out_adc;
+/** When adc1_init() powered on the ADC */
+static uint64_t adc_power_on_tick;
 
-typedef enum {
-    adc_cha_i_out = 0,
-    adc_cha_v_in,
-    adc_cha_v_out,
-    adc_cha_max,
-
-} adc_channel_t;
 _Static_assert (adc_cha_max <= 4, "Max 4 channels for injected sampling");
 
 const uint8_t channels[adc_cha_max] = { ADC_CHA_IOUT, ADC_CHA_VIN, ADC_CHA_VOUT }; /** Must have the same order as adc_channel_t */
 
-/** Used to handle long presses */
-#define LONGPRESS_TIME_MS (1000)
-static event_t longpress_event;
-static uint64_t longpress_start;
-static bool longpress_detected;
-/** Used to filter SET press from SET + ROT */
-static bool set_pressed = false;
-static bool set_skip = false;
-
-/** We skip the first 40 samples. For a connected ESP8266 the first sample
-  * will read a current draw of ~3A which will trigger the OCP.
-  * @todo Investigate if the ESP8266 _really_ draws 3A or if it is a DPS issue
-  */
-#define STARTUP_SKIP_COUNT   (40)
-
-/** Once we are checking for OCP, we need 20 over currents in a row to trigger
-  * OCP. This is due to spikes in the ADC readings.
-  * @todo Investigate if the spikes are real or is a DPS issue
-  */
-#define OCP_FILTER_COUNT (20)
+#ifdef CONFIG_ADC_ALIGNED_VI
+/** I_out on both sides of V_out, see hw.h */
+static const uint8_t aligned_channels[4] = { ADC_CHA_IOUT, ADC_CHA_VOUT, ADC_CHA_IOUT, ADC_CHA_VIN };
+#endif // CONFIG_ADC_ALIGNED_VI
+
+#ifdef CONFIG_ADC_PLAN
+/** The sampling plan, in the order of adc_channel_t */
+static const adc_plan_t adc_plan[adc_cha_max] = {
+    [adc_cha_i_out] = { ADC_CHA_IOUT, CONFIG_ADC_IOUT_SMP, 1 },
+    [adc_cha_v_in] = { ADC_CHA_VIN, CONFIG_ADC_VIN_SMP, CONFIG_ADC_VIN_DECIMATION },
+    [adc_cha_v_out] = { ADC_CHA_VOUT, CONFIG_ADC_VOUT_SMP, CONFIG_ADC_VOUT_DECIMATION },
+};
+
+#ifndef CONFIG_ADC_DMA
+/** The plan repeats every ADC_PLAN_MAX_DECIMATION triggers. For each trigger
+  * of the period, the injected sequence and the channels it converts (bit n
+  * for adc_channel_t n) are computed by adc_plan_init() so the ISR only has to
+  * load the next sequence. */
+static uint32_t adc_plan_jsqr[ADC_PLAN_MAX_DECIMATION];
+static uint8_t adc_plan_mask[ADC_PLAN_MAX_DECIMATION];
+static uint32_t adc_plan_phase;
+/** The latest sample of each channel */
+static uint16_t adc_plan_samples[adc_cha_max];
+#endif // CONFIG_ADC_DMA
+#endif // CONFIG_ADC_PLAN
+
+/** USART1 RX bytes are kept out of the event queue. The ISR fills this ring
+  * and posts a single event_uart_rx_ready when the line goes idle (the end of
+  * a frame) or the ring is filling up. */
+#define UART_RX_BUF_SIZE  (256)
+static ringbuf_t uart_rx_ring;
+static uint8_t uart_rx_buffer[2*UART_RX_BUF_SIZE];
+static volatile bool uart_rx_event_pending;
+static volatile uint32_t uart_rx_overflows;
+
+/** USART1 TX is fed from this ring by the TXE interrupt so senders do not
+  * have to wait for the bytes to leave the wire. DMA1 channel 4 (USART1 TX)
+  * is used by the SPI driver. */
+#define UART_TX_BUF_SIZE  (256)
+static ringbuf_t uart_tx_ring;
+static uint8_t uart_tx_buffer[2*UART_TX_BUF_SIZE];
 
 #ifdef CONFIG_ADC_BENCHMARK
 static uint64_t adc_tick_start;
 #endif // CONFIG_ADC_BENCHMARK
 
-/** Number of ADC conversions performed */
-static uint32_t adc_counter;
-
-/** The ADC reading on channel ADC_CHA_IOUT when power out was disabled on the
-  * DPS5005 I used to develop OpenDPS. When testing on another unit I noticed
-  * the current measurement was quite off, the reason being the ADC reading
-  * at 0mA had an offset. For that reason, we calculate the individual offset
-  * for the unit we're running on. Might work out... */
-#define ADC_CHA_IOUT_GOLDEN_VALUE  (0x45)
-/** How many measurements do we take before calculating adc_i_offset */
-#define ADC_I_OFFSET_COUNT  (1000)
-/** Offset from golden value when measuring 0.00mA output current on this unit */
-static int32_t adc_i_offset;
-/** Are we measuring the offset not not? */
-static bool measure_i_out = true;
-/** Used to calculate mean value of ADC_CHA_IOUT when power out is disabled */
-static uint32_t i_offset_calc;
+#ifdef CONFIG_ADC_DMA
+/** In DMA mode, ADC1 converts the regular sequence on every TIM3 TRGO and
+  * DMA1 channel 1 moves the result into a circular buffer. The half transfer
+  * and transfer complete interrupts hand us one block of
+  * ADC_DMA_BLOCK_LEN scans each while the DMA fills the other half. */
+#define ADC_TRIGGER_TIMER  TIM3
+static volatile uint16_t adc_dma_buffer[2 * ADC_DMA_BLOCK_LEN * adc_cha_max];
+#else // CONFIG_ADC_DMA
+#define ADC_TRIGGER_TIMER  TIM2
+#endif // CONFIG_ADC_DMA
 
 /**
   * @brief Initialize the hardware
@@ -124,71 +141,283 @@ void hw_init(void)
     copy_vectors();
     clock_init();
     systick_init();
+#ifdef CONFIG_PROFILING
+    profile_init();
+#endif // CONFIG_PROFILING
     gpio_init();
     usart_init();
     adc1_init();
-    exti_init();
     spi_init();
     dac_init();
-    button_irq_init();
+    buttons_init();
+    DBGMCU_CR |= DBGMCU_CR_SLEEP; /** Keep the debugger attached across hw_idle() */
 
 //    AFIO_MAPR |= AFIO_MAPR_PD01_REMAP; /** @todo The original DPS FW does this, things go south if I do it... */
 }
 
 /**
-  * @brief Read latest ADC mesurements
-  * @param i_out_raw latest I_out raw value
-  * @param v_in_raw latest V_in raw value
-  * @param v_out_raw latest V_out raw value
-  * @retval none
+  * @brief Sleep until the next interrupt, unless there are events to handle
+  *        or a timer is due
+  * @param deadline the tick when the next timer expires
+  * @retval None
   */
-void hw_get_adc_values(uint16_t *i_out_raw, uint16_t *v_in_raw, uint16_t *v_out_raw)
+void hw_idle(uint64_t deadline)
 {
-    *i_out_raw = i_out_adc;
-    *v_in_raw = v_in_adc;
-    *v_out_raw = v_out_adc;
+    /** An interrupt that becomes pending while masked still ends the WFI, so
+      * an event put after the check below cannot be slept through */
+    cm_disable_interrupts();
+    if (!event_pending() && get_ticks() < deadline) {
+        __asm__ volatile ("wfi");
+    }
+    cm_enable_interrupts();
 }
 
 /**
-  * @brief Initialize TIM4 that drives the backlight of the TFT
+  * @brief Get bytes received on USART1
+  * @param buf buffer to copy received bytes to
+  * @param size size of buffer
+  * @retval number of bytes copied, 0 if there is nothing more to read
+  */
+uint32_t hw_uart_rx_get(uint8_t *buf, uint32_t size)
+{
+    uint16_t words[16];
+    uint32_t total = 0;
+    /** Clear before draining so bytes arriving during the drain post a new event */
+    uart_rx_event_pending = false;
+    while (total < size) {
+        uint32_t n = ringbuf_get_bulk(&uart_rx_ring, words, size - total < 16 ? size - total : 16);
+        if (n == 0) {
+            break;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            buf[total++] = (uint8_t) words[i];
+        }
+    }
+    return total;
+}
+
+/**
+  * @brief Queue bytes for transmission on USART1. Returns as soon as all bytes
+  *        are queued, waiting only if the TX ring is full.
+  * @param buf bytes to send
+  * @param length number of bytes
   * @retval None
   */
-void hw_enable_backlight(void)
+void hw_uart_tx(const uint8_t *buf, uint32_t length)
 {
-    rcc_periph_clock_enable(RCC_TIM4);
-    TIM4_CNT = 1;
-    TIM4_PSC = 5; // 0 => 6.41kHz 5 => 1.07kHz
-    TIM4_CCER = 0x10;
-    TIM4_CCMR1 = 0x6800;
-    TIM4_ARR = 0x8bdf;
-    TIM4_CCR2 = 0x5dc0;
-    TIM4_DMAR = 0x81;
-    // Set auto reload, start timer.
-    TIM4_CR1 |= TIM_CR1_ARPE | TIM_CR1_CEN;
+    uint16_t words[16];
+    while (length) {
+        uint32_t n = length < 16 ? length : 16;
+        for (uint32_t i = 0; i < n; i++) {
+            words[i] = buf[i];
+        }
+        uint32_t put = 0;
+        while (put < n) {
+            /** The ring has one producer, don't let an ISR print in the middle of us */
+            uint32_t primask = cm_mask_interrupts(1);
+            put += ringbuf_put_bulk(&uart_tx_ring, &words[put], n - put);
+            cm_mask_interrupts(primask);
+            USART_CR1(USART1) |= USART_CR1_TXEIE;
+            if (put < n && (primask || (SCB_ICSR & SCB_ICSR_VECTACTIVE))) {
+                /** Called with interrupts masked or from an ISR, the TXE IRQ
+                  * might not be able to drain the ring for us */
+                uint16_t data;
+                primask = cm_mask_interrupts(1);
+                if (ringbuf_get(&uart_tx_ring, &data)) {
+                    usart_send_blocking(USART1, data);
+                }
+                cm_mask_interrupts(primask);
+            }
+        }
+        buf += n;
+        length -= n;
+    }
 }
 
 /**
-  * @brief Get the ADC valut that triggered the OCP
-  * @retval Trivver value in mA
+  * @brief Wait until all queued bytes have been sent on USART1
+  * @retval None
   */
-uint16_t hw_get_itrig_ma(void)
+void hw_uart_tx_flush(void)
 {
-    return i_out_trig_adc;
+    while (uart_tx_ring.read != uart_tx_ring.write) ;
+    usart_wait_send_ready(USART1);
+    while (!(USART_SR(USART1) & USART_SR_TC)) ;
 }
 
 /**
-  * @brief Check if it current press is a long press, inject event if so
+  * @brief Change the baud rate of USART1 once all queued bytes have been sent
+  * @param baud the new rate
   * @retval None
   */
-void hw_longpress_check(void)
+void hw_uart_set_baudrate(uint32_t baud)
 {
-    if (longpress_event != event_none) {
-        if (get_ticks() - longpress_start > LONGPRESS_TIME_MS) {
-            event_put(longpress_event, press_long);
-            longpress_detected = true;
-            longpress_event = event_none;
-        }
+    hw_uart_tx_flush();
+    usart_disable(USART1);
+    usart_set_baudrate(USART1, baud);
+    usart_enable(USART1);
+}
+
+/**
+  * @brief Get the number of bytes dropped due to a full USART1 RX ring
+  * @retval number of dropped bytes since boot
+  */
+uint32_t hw_uart_rx_overflows(void)
+{
+    return uart_rx_overflows;
+}
+
+/**
+  * @brief Check if received data was announced but not read yet
+  * @retval true if an event_uart_rx_ready is waiting to be handled
+  */
+bool hw_uart_rx_waiting(void)
+{
+    return uart_rx_event_pending;
+}
+
+#ifdef CONFIG_THERMAL
+/**
+  * @brief Switch the fan, if the model has one
+  * @param on true to run the fan
+  * @retval None
+  */
+void hw_set_fan(bool on)
+{
+#ifdef MODEL_FAN_PIN
+    if (on) {
+        gpio_set(MODEL_FAN_PORT, MODEL_FAN_PIN);
+    } else {
+        gpio_clear(MODEL_FAN_PORT, MODEL_FAN_PIN);
     }
+#else // MODEL_FAN_PIN
+    (void) on;
+#endif // MODEL_FAN_PIN
+}
+
+/**
+  * @brief Get the reading of the STM32 internal temperature sensor and start
+  *        the next conversion
+  * @param temp the temperature in 1/10 degrees Celsius
+  * @retval true if a conversion had completed since the previous call
+  */
+bool hw_get_chip_temperature(int16_t *temp)
+{
+    bool done;
+    uint32_t raw = 0;
+#ifdef CONFIG_ADC_DMA
+    done = adc_eoc_injected(ADC1);
+    if (done) {
+        raw = adc_read_injected(ADC1, 1);
+        ADC_SR(ADC1) &= ~ADC_SR_JEOC;
+    }
+    adc_start_conversion_injected(ADC1);
+#else // CONFIG_ADC_DMA
+    done = adc_eoc(ADC1);
+    if (done) {
+        raw = adc_read_regular(ADC1); /** Clears EOC */
+    }
+    adc_start_conversion_regular(ADC1);
+#endif // CONFIG_ADC_DMA
+    if (done) {
+        /** T = (V25 - Vsense) / Avg_Slope + 25, Vsense in mV with a 3.3V VDDA */
+        int32_t v_sense = (int32_t) (raw * 3300 / 4095);
+        *temp = (CONFIG_CHIP_TEMP_V25_MV - v_sense) * 10000 / CONFIG_CHIP_TEMP_SLOPE_UV_C + 250;
+    }
+    return done;
+}
+#endif // CONFIG_THERMAL
+
+#ifdef CONFIG_WAVE
+/** TIM6 runs at the 24MHz core clock, the fastest rate the DMA feeds the
+  * DAC at is 256k samples per second so it does not starve the ADC DMA */
+#define WAVE_TIMER_HZ   (24000000)
+#define WAVE_MIN_TICKS  (WAVE_TIMER_HZ / 256000)
+
+/**
+  * @brief Feed the V_out DAC from a table by DMA1 channel 3 on every TIM6
+  *        update. Only the V_out DAC channel can be fed, the request of the
+  *        I_out channel is on DMA1 channel 4 which the SPI driver uses.
+  * @param table the DAC codes, read in a loop until stopped
+  * @param len number of codes
+  * @param rate_mhz samples per 1000s
+  * @retval false if the rate is out of range
+  */
+bool hw_dac_wave_start(const uint16_t *table, uint32_t len, uint64_t rate_mhz)
+{
+    uint64_t ticks = rate_mhz ? (uint64_t) WAVE_TIMER_HZ * 1000 / rate_mhz : 0;
+    if (ticks < WAVE_MIN_TICKS || ticks > 0x100000000ULL) {
+        return false;
+    }
+    hw_dac_wave_stop();
+    /** The prescaler keeps the period within 16 bits */
+    uint32_t psc = (ticks - 1) >> 16;
+    rcc_periph_clock_enable(RCC_TIM6);
+    rcc_periph_reset_pulse(RST_TIM6);
+    timer_set_prescaler(TIM6, psc);
+    timer_set_period(TIM6, ticks / (psc + 1) - 1);
+    timer_set_master_mode(TIM6, TIM_CR2_MMS_UPDATE);
+
+    rcc_periph_clock_enable(RCC_DMA1);
+    dma_channel_reset(DMA1, DMA_CHANNEL3);
+    dma_set_peripheral_address(DMA1, DMA_CHANNEL3, (uint32_t) &DAC_DHR12R1);
+    dma_set_memory_address(DMA1, DMA_CHANNEL3, (uint32_t) table);
+    dma_set_number_of_data(DMA1, DMA_CHANNEL3, len);
+    dma_set_read_from_memory(DMA1, DMA_CHANNEL3);
+    dma_enable_memory_increment_mode(DMA1, DMA_CHANNEL3);
+    dma_set_peripheral_size(DMA1, DMA_CHANNEL3, DMA_CCR_PSIZE_16BIT);
+    dma_set_memory_size(DMA1, DMA_CHANNEL3, DMA_CCR_MSIZE_16BIT);
+    dma_set_priority(DMA1, DMA_CHANNEL3, DMA_CCR_PL_HIGH);
+    dma_enable_circular_mode(DMA1, DMA_CHANNEL3);
+    dma_enable_channel(DMA1, DMA_CHANNEL3);
+
+    /** TSEL1 = 000 selects TIM6 TRGO, the DAC requests the next code from
+      * the DMA on every trigger */
+    DAC_CR = (DAC_CR & ~(7 << 3)) | DAC_CR_TEN1 | DAC_CR_DMAEN1;
+    timer_enable_counter(TIM6);
+    return true;
+}
+
+/**
+  * @brief Stop feeding the V_out DAC, it keeps the last code until written
+  * @retval None
+  */
+void hw_dac_wave_stop(void)
+{
+    if (!(DAC_CR & DAC_CR_DMAEN1)) {
+        return;
+    }
+    timer_disable_counter(TIM6);
+    DAC_CR &= ~(DAC_CR_TEN1 | DAC_CR_DMAEN1);
+    dma_disable_channel(DMA1, DMA_CHANNEL3);
+}
+
+/**
+  * @brief Check if the V_out DAC is fed by DMA
+  * @retval true if a waveform is playing
+  */
+bool hw_dac_wave_active(void)
+{
+    return (DAC_CR & DAC_CR_DMAEN1) != 0;
+}
+#endif // CONFIG_WAVE
+
+/**
+  * @brief Initialize TIM4 that drives the backlight of the TFT
+  * @retval None
+  */
+void hw_enable_backlight(void)
+{
+    rcc_periph_clock_enable(RCC_TIM4);
+    TIM4_CNT = 1;
+    TIM4_PSC = 5; // 0 => 6.41kHz 5 => 1.07kHz
+    TIM4_CCER = 0x10;
+    TIM4_CCMR1 = 0x6800;
+    TIM4_ARR = 0x8bdf;
+    TIM4_CCR2 = 0x5dc0;
+    TIM4_DMAR = 0x81;
+    // Set auto reload, start timer.
+    TIM4_CR1 |= TIM_CR1_ARPE | TIM_CR1_CEN;
 }
 
 #ifdef CONFIG_ADC_BENCHMARK
@@ -199,7 +428,8 @@ void hw_longpress_check(void)
 void hw_print_ticks(void)
 {
     uint32_t temp = (uint32_t) get_ticks() - adc_tick_start;
-    dbg_printf("%u ADC ticks in %u ms (%u Hz)\n", adc_counter, temp, adc_counter/(temp/1000));
+    uint32_t scans = adc_scan_count();
+    dbg_printf("%u ADC ticks in %u ms (%u Hz)\n", scans, temp, scans/(temp/1000));
 }
 #endif // CONFIG_ADC_BENCHMARK
 
@@ -212,28 +442,67 @@ bool hw_sel_button_pressed(void)
     return !gpio_get(BUTTON_SEL_PORT, BUTTON_SEL_PIN);
 }
 
+#ifdef CONFIG_OCP_AWD
 /**
-  * @brief Add some filtering to OCPs
+  * @brief Set the analog watchdog threshold from the current limit. The
+  *        watchdog compares raw samples so the I_out offset is undone.
   * @retval None
   */
-static void handle_ocp(uint16_t raw)
+void hw_update_ocp_limit(void)
 {
-    static uint32_t ocp_count = 0;
-    static uint32_t last_tick_counter = 0;
-    if (last_tick_counter+1 == adc_counter) {
-        ocp_count++;
-        last_tick_counter++;
-        if (ocp_count == OCP_FILTER_COUNT) {
-            i_out_trig_adc = raw;
-            pwrctl_enable_vout(false);
-            event_put(event_ocp, 0);
-        }
-    } else {
-        ocp_count = 0;
-        last_tick_counter = adc_counter;
+    int32_t offset;
+    if (!adc_scan_i_offset(&offset) || !pwrctl_i_limit_raw) {
+        /** Not armed until the offset is known and there is a limit */
+        adc_disable_analog_watchdog_injected(ADC1);
+        adc_disable_analog_watchdog_regular(ADC1);
+        return;
+    }
+    int32_t threshold = (int32_t) pwrctl_i_limit_raw - offset;
+    threshold = threshold < 0 ? 0 : threshold > 0xfff ? 0xfff : threshold;
+    adc_set_watchdog_high_threshold(ADC1, threshold);
+#ifdef CONFIG_ADC_DMA
+    adc_enable_analog_watchdog_regular(ADC1);
+#else // CONFIG_ADC_DMA
+    adc_enable_analog_watchdog_injected(ADC1);
+#endif // CONFIG_ADC_DMA
+}
+
+/**
+  * @brief Handle an analog watchdog interrupt, I_out exceeded the limit
+  * @retval None
+  */
+static inline void handle_awd(void)
+{
+    ADC_SR(ADC1) &= ~ADC_SR_AWD;
+#ifdef CONFIG_ADC_DMA
+    /** The DMA has just read the I_out sample, its position in the circular
+      * buffer tells consecutive scans apart */
+    uint32_t raw = ADC_DR(ADC1);
+    uint32_t scan = (sizeof(adc_dma_buffer) / sizeof(adc_dma_buffer[0]) - DMA_CNDTR(DMA1, DMA_CHANNEL1)) / adc_cha_max;
+#else // CONFIG_ADC_DMA
+    uint32_t raw = adc_read_injected(ADC1, adc_cha_i_out + 1);
+    uint32_t scan = adc_scan_count();
+#endif // CONFIG_ADC_DMA
+    adc_scan_awd(raw, scan);
+}
+#endif // CONFIG_OCP_AWD
+
+#if defined(CONFIG_ADC_DMA) && defined(CONFIG_OCP_AWD)
+/**
+  * @brief ADC1 ISR, only used by the analog watchdog in DMA mode
+  * @retval None
+  */
+void adc1_2_isr(void)
+{
+    PROFILE_START();
+    if (ADC_SR(ADC1) & ADC_SR_AWD) {
+        handle_awd();
     }
+    PROFILE_END(prof_adc_isr);
 }
+#endif // CONFIG_ADC_DMA && CONFIG_OCP_AWD
 
+#ifndef CONFIG_ADC_DMA
 /**
   * @brief ADC1 ISR
   * @retval None
@@ -241,39 +510,75 @@ static void handle_ocp(uint16_t raw)
   */
 void adc1_2_isr(void)
 {
+    PROFILE_START();
+#ifdef CONFIG_OCP_AWD
+    if (ADC_SR(ADC1) & ADC_SR_AWD) {
+        handle_awd();
+    }
+    if (!(ADC_SR(ADC1) & ADC_SR_JEOC)) {
+        PROFILE_END(prof_adc_isr);
+        return;
+    }
+#endif // CONFIG_OCP_AWD
 #ifdef CONFIG_ADC_BENCHMARK
-    if (adc_counter == 0) {
+    if (adc_scan_count() == 0) {
         adc_tick_start = get_ticks();
     }
 #endif // CONFIG_ADC_BENCHMARK
 
     // Clear Injected End Of Conversion (JEOC)
     ADC_SR(ADC1) &= ~ADC_SR_JEOC;
-    // If pwrctl_i_limit_raw == 0, the setting hasn't been read from past yet
-    adc_counter++;
+#ifdef CONFIG_ADC_PLAN
+    /** Load the sequence of the next trigger, ~48us away, then pick up the
+      * samples of this one in the order of adc_channel_t */
+    uint32_t mask = adc_plan_mask[adc_plan_phase];
+    adc_plan_phase = (adc_plan_phase + 1) & (ADC_PLAN_MAX_DECIMATION - 1);
+    ADC_JSQR(ADC1) = adc_plan_jsqr[adc_plan_phase];
+    uint32_t rank = 1;
+    for (uint32_t cha = 0; cha < adc_cha_max; cha++) {
+        if (mask & (1 << cha)) {
+            adc_plan_samples[cha] = adc_read_injected(ADC1, rank++);
+        }
+    }
+    adc_scan(adc_plan_samples[adc_cha_i_out], adc_plan_samples[adc_cha_v_in], adc_plan_samples[adc_cha_v_out]);
+#elif defined(CONFIG_ADC_ALIGNED_VI)
+    uint32_t i = (adc_read_injected(ADC1, 1) + adc_read_injected(ADC1, 3) + 1) / 2;
+    uint32_t v_out = adc_read_injected(ADC1, 2);
+    uint32_t v_in = adc_read_injected(ADC1, 4);
+    adc_scan(i, v_in, v_out);
+#else // CONFIG_ADC_PLAN
     uint32_t i = adc_read_injected(ADC1, adc_cha_i_out + 1); // Yes, this is correct
+    uint32_t v_in = adc_read_injected(ADC1, adc_cha_v_in + 1); // Yes, this is correct
+    uint32_t v_out = adc_read_injected(ADC1, adc_cha_v_out + 1); // Yes, this is correct
+    adc_scan(i, v_in, v_out);
+#endif // CONFIG_ADC_PLAN
+    PROFILE_END(prof_adc_isr);
+}
+#else // CONFIG_ADC_DMA
+/**
+  * @brief ADC1 DMA ISR, called when either half of the buffer is filled
+  * @retval None
+  */
+void dma1_channel1_isr(void)
+{
+    PROFILE_START();
+#ifdef CONFIG_ADC_BENCHMARK
+    if (adc_scan_count() == 0) {
+        adc_tick_start = get_ticks();
+    }
+#endif // CONFIG_ADC_BENCHMARK
 
-    /** @todo Make sure power out is not enabled during this measurement */
-    if (measure_i_out) {
-        if (adc_counter < ADC_I_OFFSET_COUNT) {
-            i_offset_calc += i;
-        } else {
-            adc_i_offset = ADC_CHA_IOUT_GOLDEN_VALUE - (i_offset_calc / ADC_I_OFFSET_COUNT);
-            measure_i_out = false;
-        }
+    if (dma_get_interrupt_flag(DMA1, DMA_CHANNEL1, DMA_HTIF)) {
+        dma_clear_interrupt_flags(DMA1, DMA_CHANNEL1, DMA_HTIF);
+        adc_scan_block((uint16_t*) &adc_dma_buffer[0]);
     }
-    if (pwrctl_i_limit_raw) {
-        if (adc_counter >= STARTUP_SKIP_COUNT) {
-            i += adc_i_offset;
-            if (i > pwrctl_i_limit_raw && pwrctl_vout_enabled()) { /** OCP! */
-                handle_ocp(i);
-            }
-            i_out_adc = i;
-        }
+    if (dma_get_interrupt_flag(DMA1, DMA_CHANNEL1, DMA_TCIF)) {
+        dma_clear_interrupt_flags(DMA1, DMA_CHANNEL1, DMA_TCIF);
+        adc_scan_block((uint16_t*) &adc_dma_buffer[ADC_DMA_BLOCK_LEN * adc_cha_max]);
     }
-    v_in_adc  = adc_read_injected(ADC1, adc_cha_v_in + 1); // Yes, this is correct
-    v_out_adc = adc_read_injected(ADC1, adc_cha_v_out + 1); // Yes, this is correct
+    PROFILE_END(prof_adc_isr);
 }
+#endif // CONFIG_ADC_DMA
 
 /**
   * @brief Handle USART1 interrupts
@@ -281,24 +586,37 @@ void adc1_2_isr(void)
   */
 void usart1_isr(void)
 {
+    PROFILE_START();
+    bool notify = false;
     if (((USART_CR1(USART1) & USART_CR1_RXNEIE) != 0) &&
         ((USART_SR(USART1) & USART_SR_RXNE) != 0)) {
         uint8_t ch = usart_recv(USART1);
-        event_put(event_uart_rx, ch);
+        if (!ringbuf_put(&uart_rx_ring, ch)) {
+            uart_rx_overflows++;
+            notify = true;
+        } else if ((uart_rx_ring.write + uart_rx_ring.size - uart_rx_ring.read) % uart_rx_ring.size == uart_rx_ring.size/2) {
+            notify = true; /** Half full without an idle line, let the main loop start chewing */
+        }
+    }
+    if (((USART_CR1(USART1) & USART_CR1_IDLEIE) != 0) &&
+        ((USART_SR(USART1) & USART_SR_IDLE) != 0)) {
+        (void) USART_DR(USART1); /** SR followed by DR read clears IDLE */
+        notify = true;
+    }
+    if (notify && !uart_rx_event_pending) {
+        uart_rx_event_pending = event_put(event_uart_rx_ready, 0);
     }
 
-#ifdef TX_IRQ
     if (((USART_CR1(USART1) & USART_CR1_TXEIE) != 0) &&
         ((USART_SR(USART1) & USART_SR_TXE) != 0)) {
-        int32_t data;
-        data = ringbuf_read_ch(&output_ring, NULL);
-        if (data == -1) {
+        uint16_t data;
+        if (!ringbuf_get(&uart_tx_ring, &data)) {
             USART_CR1(USART1) &= ~USART_CR1_TXEIE;
         } else {
             usart_send(USART1, data);
         }
     }
-#endif // TX_IRQ
+    PROFILE_END(prof_usart_isr);
 }
 /**
   * @brief Enable clocks
@@ -314,40 +632,138 @@ static void clock_init(void)
     rcc_periph_clock_enable(RCC_AFIO);
 }
 
+#if defined(CONFIG_ADC_PLAN) && !defined(CONFIG_ADC_DMA)
+/**
+  * @brief Compute the injected sequence of every trigger of the plan period
+  *        and load the first one
+  * @retval None
+  */
+static void adc_plan_init(void)
+{
+    for (uint32_t phase = 0; phase < ADC_PLAN_MAX_DECIMATION; phase++) {
+        uint8_t sequence[adc_cha_max];
+        uint8_t length = 0;
+        adc_plan_mask[phase] = 0;
+        for (uint32_t cha = 0; cha < adc_cha_max; cha++) {
+            if (phase % adc_plan[cha].decimation == 0) {
+                sequence[length++] = adc_plan[cha].channel;
+                adc_plan_mask[phase] |= 1 << cha;
+            }
+        }
+        /** Let libopencm3 sort out the rank order of short sequences */
+        adc_set_injected_sequence(ADC1, length, sequence);
+        adc_plan_jsqr[phase] = ADC_JSQR(ADC1);
+    }
+    adc_plan_phase = 0;
+    ADC_JSQR(ADC1) = adc_plan_jsqr[0];
+}
+#endif // CONFIG_ADC_PLAN && !CONFIG_ADC_DMA
+
 /**
   * @brief Enable ADC1
   * @retval None
   */
 static void adc1_init(void)
 {
-    int i;
+#ifdef CONFIG_ADC_DMA
+    rcc_periph_clock_enable(RCC_DMA1);
+    dma_channel_reset(DMA1, DMA_CHANNEL1);
+    dma_set_peripheral_address(DMA1, DMA_CHANNEL1, (uint32_t) &ADC_DR(ADC1));
+    dma_set_memory_address(DMA1, DMA_CHANNEL1, (uint32_t) adc_dma_buffer);
+    dma_set_number_of_data(DMA1, DMA_CHANNEL1, sizeof(adc_dma_buffer) / sizeof(adc_dma_buffer[0]));
+    dma_set_read_from_peripheral(DMA1, DMA_CHANNEL1);
+    dma_enable_memory_increment_mode(DMA1, DMA_CHANNEL1);
+    dma_set_peripheral_size(DMA1, DMA_CHANNEL1, DMA_CCR_PSIZE_16BIT);
+    dma_set_memory_size(DMA1, DMA_CHANNEL1, DMA_CCR_MSIZE_16BIT);
+    dma_set_priority(DMA1, DMA_CHANNEL1, DMA_CCR_PL_VERY_HIGH);
+    dma_enable_circular_mode(DMA1, DMA_CHANNEL1);
+    dma_enable_half_transfer_interrupt(DMA1, DMA_CHANNEL1);
+    dma_enable_transfer_complete_interrupt(DMA1, DMA_CHANNEL1);
+    dma_enable_channel(DMA1, DMA_CHANNEL1);
+    nvic_set_priority(NVIC_DMA1_CHANNEL1_IRQ, 0);
+    nvic_enable_irq(NVIC_DMA1_CHANNEL1_IRQ);
+#else // CONFIG_ADC_DMA
     nvic_set_priority(NVIC_ADC1_2_IRQ, 0);
     nvic_enable_irq(NVIC_ADC1_2_IRQ);
+#endif // CONFIG_ADC_DMA
     rcc_periph_clock_enable(RCC_ADC1);
     adc_power_off(ADC1); // Make sure the ADC doesn't run during config.
 
-    /** @todo Use scan mode which does all channels in one sweep and generates the interrupt/EOC/JEOC flags set at the end of all channels, not each one. */
     adc_enable_scan_mode(ADC1);
     adc_set_single_conversion_mode(ADC1);
+#ifdef CONFIG_ADC_DMA
+    // TIM2 TRGO cannot trigger the regular group, use TIM3 TRGO
+    adc_enable_external_trigger_regular(ADC1, ADC_CR2_EXTSEL_TIM3_TRGO);
+    adc_set_regular_sequence(ADC1, adc_cha_max, (uint8_t*) channels);
+    adc_enable_dma(ADC1);
+#else // CONFIG_ADC_DMA
+    /** @todo Use scan mode which does all channels in one sweep and generates the interrupt/EOC/JEOC flags set at the end of all channels, not each one. */
     // Use TIM2 TRGO as injected conversion trigger
     adc_enable_external_trigger_injected(ADC1,ADC_CR2_JEXTSEL_TIM2_TRGO);
     // Generate the ADC1_2_IRQ
     adc_enable_eoc_interrupt_injected(ADC1);
+#ifdef CONFIG_ADC_PLAN
+    adc_plan_init();
+#elif defined(CONFIG_ADC_ALIGNED_VI)
+    adc_set_injected_sequence(ADC1, sizeof(aligned_channels), (uint8_t*) aligned_channels);
+#else // CONFIG_ADC_PLAN
+    adc_set_injected_sequence(ADC1, adc_cha_max, (uint8_t*) channels);
+#endif // CONFIG_ADC_PLAN
+#endif // CONFIG_ADC_DMA
+#ifdef CONFIG_OCP_AWD
+    /** Armed by hw_update_ocp_limit() */
+    adc_enable_analog_watchdog_on_selected_channel(ADC1, ADC_CHA_IOUT);
+    adc_set_watchdog_low_threshold(ADC1, 0);
+    adc_set_watchdog_high_threshold(ADC1, 0xfff);
+    adc_enable_awd_interrupt(ADC1);
+#ifdef CONFIG_ADC_DMA
+    nvic_set_priority(NVIC_ADC1_2_IRQ, 0);
+    nvic_enable_irq(NVIC_ADC1_2_IRQ);
+#endif // CONFIG_ADC_DMA
+#endif // CONFIG_OCP_AWD
     adc_set_right_aligned(ADC1);
-    //adc_enable_temperature_sensor(); /** @todo Use internal temperature sensor for monitoring */
     adc_set_sample_time_on_all_channels(ADC1, ADC_SMPR_SMP_28DOT5CYC);
-    adc_set_injected_sequence(ADC1, adc_cha_max, (uint8_t*) channels);
+#ifdef CONFIG_ADC_PLAN
+    for (uint32_t cha = 0; cha < adc_cha_max; cha++) {
+        adc_set_sample_time(ADC1, adc_plan[cha].channel, adc_plan[cha].sample_time);
+    }
+#endif // CONFIG_ADC_PLAN
+#ifdef CONFIG_THERMAL
+    /** The sensor is converted on its own on the group the scans leave free
+      * and needs a 17.1us sampling time */
+    adc_enable_temperature_sensor();
+    adc_set_sample_time(ADC1, ADC_CHANNEL_TEMP, ADC_SMPR_SMP_239DOT5CYC);
+    {
+        uint8_t temp_channel[] = { ADC_CHANNEL_TEMP };
+#ifdef CONFIG_ADC_DMA
+        adc_enable_external_trigger_injected(ADC1, ADC_CR2_JEXTSEL_JSWSTART);
+        adc_set_injected_sequence(ADC1, 1, temp_channel);
+#else // CONFIG_ADC_DMA
+        adc_enable_external_trigger_regular(ADC1, ADC_CR2_EXTSEL_SWSTART);
+        adc_set_regular_sequence(ADC1, 1, temp_channel);
+#endif // CONFIG_ADC_DMA
+    }
+#endif // CONFIG_THERMAL
     adc_power_on(ADC1);
+    /** hw_adc_start() calibrates once the ADC has had time to stabilise */
+    adc_power_on_tick = get_ticks();
+}
 
-    // Wait for ADC starting up.
-    for (i = 0; i < 800000; i++) {
+/**
+  * @brief Calibrate ADC1 and start the scans, waiting only for what remains
+  *        of the ADC startup time since hw_init() powered it on
+  * @retval None
+  */
+void hw_adc_start(void)
+{
+    while (get_ticks() - adc_power_on_tick < CONFIG_ADC_STARTUP_MS) {
         __asm__("nop");
     }
 
     adc_reset_calibration(ADC1);
     adc_calibrate(ADC1);
 
-    tim2_init(); // Start TIM2 trigger now that the ADC is online
+    adc_timer_init(); // Start the trigger timer now that the ADC is online
 }
 
 /**
@@ -368,8 +784,10 @@ static void usart_init(void)
     usart_set_parity(USART1, USART_PARITY_NONE);
     usart_set_flow_control(USART1, USART_FLOWCONTROL_NONE);
 
-    // Enable USART1 Receive interrupt.
-    USART_CR1(USART1) |= USART_CR1_RXNEIE;
+    ringbuf_init(&uart_rx_ring, uart_rx_buffer, sizeof(uart_rx_buffer));
+    ringbuf_init(&uart_tx_ring, uart_tx_buffer, sizeof(uart_tx_buffer));
+    // Enable USART1 Receive and idle line interrupts.
+    USART_CR1(USART1) |= USART_CR1_RXNEIE | USART_CR1_IDLEIE;
 
     usart_enable(USART1);
 }
@@ -532,9 +950,8 @@ static void gpio_init(void)
 
     // PC13 I 0 Flt
 //    gpio_set_mode(GPIOC, GPIO_MODE_INPUT, GPIO_CNF_INPUT_FLOAT, GPIO13);
-#ifdef DPS5015
-	gpio_set_mode(GPIOC, GPIO_MODE_OUTPUT_50_MHZ, GPIO_CNF_OUTPUT_PUSHPULL, GPIO13);
-#endif
+    /** Power out control, C13 on the DPS5015 and B11 (set up above) on others */
+    gpio_set_mode(MODEL_PWR_PORT, GPIO_MODE_OUTPUT_50_MHZ, GPIO_CNF_OUTPUT_PUSHPULL, MODEL_PWR_PIN);
 
 	// PC14 I 0 Flt
     gpio_set_mode(GPIOC, GPIO_MODE_INPUT, GPIO_CNF_INPUT_FLOAT, GPIO14);
@@ -592,16 +1009,6 @@ static void gpio_init(void)
     gpio_set_mode(GPIOD, GPIO_MODE_INPUT, GPIO_CNF_INPUT_FLOAT, GPIO15);
 }
 
-/**
-  * @brief Enable EXTI where most buttons are connected
-  * @retval None
-  */
-static void exti_init(void)
-{
-    AFIO_EXTICR2 = 0x11;
-    AFIO_EXTICR3 = 0x11;
-}
-
 /**
   * @brief Initialize the DAC that is used to control voltage output
   * @retval None
@@ -617,14 +1024,20 @@ static void dac_init(void)
 }
 
 /**
-  * @brief Set up TIM2 for injected ADC1 sampling
+  * @brief Set up the timer triggering ADC1 sampling (TIM2 for injected
+  *        sampling, TIM3 for regular DMA sampling)
   * @retval None
   */
-static void tim2_init(void)
+static void adc_timer_init(void)
 {
-    uint32_t timer = TIM2;
+    uint32_t timer = ADC_TRIGGER_TIMER;
+#ifdef CONFIG_ADC_DMA
+    rcc_periph_clock_enable(RCC_TIM3);
+    rcc_periph_reset_pulse(RST_TIM3);
+#else // CONFIG_ADC_DMA
     rcc_periph_clock_enable(RCC_TIM2);
     rcc_periph_reset_pulse(RST_TIM2);
+#endif // CONFIG_ADC_DMA
     timer_set_mode(timer, TIM_CR1_CKD_CK_INT, TIM_CR1_CMS_EDGE, TIM_CR1_DIR_UP);
     timer_set_period(timer, 0xFF);
     timer_set_prescaler(timer, 0x8);
@@ -633,200 +1046,6 @@ static void tim2_init(void)
     timer_enable_counter(timer);
 }
 
-/**
-  * @brief Start a (possible) long press
-  * @param event the event that will be triggered by a long press
-  * @retval None
-  */
-static void longpress_begin(event_t event)
-{
-    longpress_event = event;
-    longpress_detected = false;
-    longpress_start = get_ticks();
-}
-
-/**
-  * @brief End long press check
-  * @retval true if it was a long press
-  */
-static bool longpress_end(void)
-{
-    bool temp = longpress_detected;
-    longpress_event = event_none;
-    longpress_start = 0;
-    longpress_detected = false;
-    return temp;
-}
-
-/**
-  * @brief Select button ISR
-  * @note BUTTON_SEL_isr & friends defined in hw.h
-  * @retval None
-  */
-void BUTTON_SEL_isr(void)
-{
-    static bool falling = true;
-    exti_reset_request(BUTTON_SEL_EXTI);
-    if (falling) {
-        set_pressed = true;
-        set_skip = false;
-        longpress_begin(event_button_sel);
-        exti_set_trigger(BUTTON_SEL_EXTI, EXTI_TRIGGER_RISING);
-    } else {
-        set_pressed = false;
-        if (!set_skip) {
-            if (!longpress_end()) {
-                // Not a long press, send short press
-                event_put(event_button_sel, press_short);
-            }
-        }
-        exti_set_trigger(BUTTON_SEL_EXTI, EXTI_TRIGGER_FALLING);
-    }
-    falling = !falling;
-}
-
-/**
-  * @brief M1 button ISR
-  * @retval None
-  */
-void BUTTON_M1_isr(void)
-{
-    static bool falling = true;
-    exti_reset_request(BUTTON_M1_EXTI);
-    if (falling) {
-        exti_set_trigger(BUTTON_M1_EXTI, EXTI_TRIGGER_RISING);
-    } else {
-        event_put(event_button_m1, press_short);
-        exti_set_trigger(BUTTON_M1_EXTI, EXTI_TRIGGER_FALLING);
-    }
-    falling = !falling;
-}
-
-/**
-  * @brief M2 button ISR
-  * @retval None
-  */
-void BUTTON_M2_isr(void)
-{
-    static bool falling = true;
-    exti_reset_request(BUTTON_M2_EXTI);
-    if (falling) {
-        exti_set_trigger(BUTTON_M2_EXTI, EXTI_TRIGGER_RISING);
-    } else {
-        event_put(event_button_m2, press_short);
-        exti_set_trigger(BUTTON_M2_EXTI, EXTI_TRIGGER_FALLING);
-    }
-    falling = !falling;
-}
-
-/**
-  * @brief Enable button ISR
-  * @retval None
-  */
-void BUTTON_ENABLE_isr(void)
-{
-    static bool falling = true;
-    exti_reset_request(BUTTON_ENABLE_EXTI);
-    if (falling) {
-        exti_set_trigger(BUTTON_ENABLE_EXTI, EXTI_TRIGGER_RISING);
-    } else {
-        event_put(event_button_enable, press_short);
-        exti_set_trigger(BUTTON_ENABLE_EXTI, EXTI_TRIGGER_FALLING);
-    }
-    falling = !falling;
-}
-
-/**
-  * @brief Rotare encoder ISR
-  * @retval None
-  */
-void BUTTON_ROTARY_isr(void)
-{
-    if (exti_get_flag_status(BUTTON_ROT_PRESS_EXTI)) {
-        exti_reset_request(BUTTON_ROT_PRESS_EXTI);
-        static bool falling = true;
-        if (falling) {
-            longpress_begin(event_rot_press);
-            exti_set_trigger(BUTTON_ROT_PRESS_EXTI, EXTI_TRIGGER_RISING);
-        } else {
-            if (!longpress_end()) {
-                // Not a long press, send short press
-                event_put(event_rot_press, press_short);
-            }
-            exti_set_trigger(BUTTON_ROT_PRESS_EXTI, EXTI_TRIGGER_FALLING);
-        }
-        falling = !falling;
-    }
-
-    if (exti_get_flag_status(BUTTON_ROT_A_EXTI)) {
-        exti_reset_request(BUTTON_ROT_A_EXTI);
-        bool a = (((uint16_t) GPIO_IDR(BUTTON_ROT_A_PORT)) & BUTTON_ROT_A_PIN) ? 1 : 0; // Slightly faster than gpio_get(...)
-        bool b = (((uint16_t) GPIO_IDR(BUTTON_ROT_B_PORT)) & BUTTON_ROT_B_PIN) ? 1 : 0;
-        if (a == b) {
-            if (set_pressed) {
-                set_skip = true;
-                (void) longpress_end();
-                event_put(event_rot_left_set, press_short);
-            } else {
-                event_put(event_rot_left, press_short);
-            }
-        } else {
-            if (set_pressed) {
-                set_skip = true;
-                (void) longpress_end();
-                event_put(event_rot_right_set, press_short);
-            } else {
-                event_put(event_rot_right, press_short);
-            }
-        }
-    }
-
-    if (exti_get_flag_status(BUTTON_ROT_B_EXTI)) {
-        exti_reset_request(BUTTON_ROT_B_EXTI);
-    }
-}
-
-/**
-  * @brief Initialize IRQs for the buttons
-  * @retval None
-  */
-static void button_irq_init(void)
-{
-    nvic_enable_irq(BUTTON_SEL_NVIC);
-    exti_select_source(BUTTON_SEL_EXTI, BUTTON_SEL_PORT);
-    exti_set_trigger(BUTTON_SEL_EXTI, EXTI_TRIGGER_FALLING);
-    exti_enable_request(BUTTON_SEL_EXTI);
-
-    nvic_enable_irq(BUTTON_M1_NVIC);
-    exti_select_source(BUTTON_M1_EXTI, BUTTON_M1_PORT);
-    exti_set_trigger(BUTTON_M1_EXTI, EXTI_TRIGGER_FALLING);
-    exti_enable_request(BUTTON_M1_EXTI);
-
-    nvic_enable_irq(BUTTON_M2_NVIC);
-    exti_select_source(BUTTON_M2_EXTI, BUTTON_M2_PORT);
-    exti_set_trigger(BUTTON_M2_EXTI, EXTI_TRIGGER_FALLING);
-    exti_enable_request(BUTTON_M2_EXTI);
-
-    nvic_enable_irq(BUTTON_ENABLE_NVIC);
-    exti_select_source(BUTTON_ENABLE_EXTI, BUTTON_ENABLE_PORT);
-    exti_set_trigger(BUTTON_ENABLE_EXTI, EXTI_TRIGGER_FALLING);
-    exti_enable_request(BUTTON_ENABLE_EXTI);
-
-    nvic_enable_irq(BUTTON_ROTARY_NVIC);
-
-    exti_select_source(BUTTON_ROT_A_EXTI, BUTTON_ROT_A_PORT);
-    exti_set_trigger(BUTTON_ROT_A_EXTI, EXTI_TRIGGER_BOTH);
-    exti_enable_request(BUTTON_ROT_A_EXTI);
-
-    exti_select_source(BUTTON_ROT_B_EXTI, BUTTON_ROT_B_PORT);
-    exti_set_trigger(BUTTON_ROT_B_EXTI, EXTI_TRIGGER_BOTH);
-    exti_enable_request(BUTTON_ROT_B_EXTI);
-
-    exti_select_source(BUTTON_ROT_PRESS_EXTI, BUTTON_ROT_PRESS_PORT);
-    exti_set_trigger(BUTTON_ROT_PRESS_EXTI, EXTI_TRIGGER_FALLING);
-    exti_enable_request(BUTTON_ROT_PRESS_EXTI);
-}
-
 /**
   * @brief Relocate the vector table to the internal SRAM
   * @retval None
@@ -32,6 +32,86 @@
 #define ADC_CHA_VIN   (8)
 #define ADC_CHA_VOUT  (9)
 
+/** Time given the ADC to stabilise after power on before it is calibrated,
+  * hw_init() powers it on and hw_adc_start() calibrates it */
+#ifndef CONFIG_ADC_STARTUP_MS
+ #define CONFIG_ADC_STARTUP_MS  (2)
+#endif
+
+#ifdef CONFIG_ADC_OVERSAMPLING
+/** The ADC samples are fed through a CIC decimator. Every reading is made
+  * from 2^CONFIG_ADC_DECIMATION_LOG2 samples, at ~21kHz the default 16x
+  * gives a new reading every ~0.75ms. */
+#ifndef CONFIG_ADC_DECIMATION_LOG2
+ #define CONFIG_ADC_DECIMATION_LOG2  (4)
+#endif
+/** Number of integrator and comb stages, 1 is a plain moving average */
+#ifndef CONFIG_ADC_CIC_ORDER
+ #define CONFIG_ADC_CIC_ORDER  (2)
+#endif
+/** Oversampling 4^n times gives n extra bits of resolution, which the
+  * readings of hw_get_adc_values() carry as fractional bits */
+#define HW_ADC_FRAC_BITS  (CONFIG_ADC_DECIMATION_LOG2 / 2)
+#else // CONFIG_ADC_OVERSAMPLING
+#define HW_ADC_FRAC_BITS  (0)
+#endif // CONFIG_ADC_OVERSAMPLING
+
+#ifdef CONFIG_ADC_PLAN
+/** The sampling plan gives each channel its own sample time (ADC_SMPR_SMP_*)
+  * and decimation. A channel is converted on every Nth trigger only, its
+  * previous sample standing in for the scans in between. I_out is converted
+  * on every trigger for the OCP. The decimations are powers of 2, at most
+  * ADC_PLAN_MAX_DECIMATION. */
+#define ADC_PLAN_MAX_DECIMATION  (16)
+#ifndef CONFIG_ADC_IOUT_SMP
+ #define CONFIG_ADC_IOUT_SMP  ADC_SMPR_SMP_28DOT5CYC
+#endif
+#ifndef CONFIG_ADC_VIN_SMP
+ #define CONFIG_ADC_VIN_SMP  ADC_SMPR_SMP_71DOT5CYC
+#endif
+#ifndef CONFIG_ADC_VOUT_SMP
+ #define CONFIG_ADC_VOUT_SMP  ADC_SMPR_SMP_28DOT5CYC
+#endif
+/** V_in hardly changes, 8 gives a brownout check every ~0.4ms */
+#ifndef CONFIG_ADC_VIN_DECIMATION
+ #define CONFIG_ADC_VIN_DECIMATION  (8)
+#endif
+/** Keep at 1 unless the OVP and OPP may react that many scans later */
+#ifndef CONFIG_ADC_VOUT_DECIMATION
+ #define CONFIG_ADC_VOUT_DECIMATION  (1)
+#endif
+#if (CONFIG_ADC_VIN_DECIMATION & (CONFIG_ADC_VIN_DECIMATION - 1)) || CONFIG_ADC_VIN_DECIMATION > ADC_PLAN_MAX_DECIMATION || \
+    (CONFIG_ADC_VOUT_DECIMATION & (CONFIG_ADC_VOUT_DECIMATION - 1)) || CONFIG_ADC_VOUT_DECIMATION > ADC_PLAN_MAX_DECIMATION
+ #error "The ADC plan decimations must be powers of 2 up to ADC_PLAN_MAX_DECIMATION"
+#endif
+#if defined(CONFIG_ADC_DMA) && (CONFIG_ADC_VIN_DECIMATION > 1 || CONFIG_ADC_VOUT_DECIMATION > 1)
+ #error "The DMA scans convert every channel, only the sample times of the ADC plan apply"
+#endif
+
+/** One entry of the sampling plan */
+typedef struct {
+    uint8_t channel;      /** ADC channel */
+    uint8_t sample_time;  /** ADC_SMPR_SMP_* */
+    uint8_t decimation;   /** Converted on every Nth trigger */
+} adc_plan_t;
+#endif // CONFIG_ADC_PLAN
+
+#ifdef CONFIG_ADC_ALIGNED_VI
+/** Time aligned V_out and I_out. ADC1 converts one channel at a time, a
+  * conversion slot being 41 ADC clocks (28.5 sampling + 12.5) or ~3.4us at
+  * 12MHz. The plain sequence I_out, V_in, V_out samples V_out two slots
+  * (~6.8us) after I_out, a phase error of 2.5 degrees at 1kHz for the power
+  * computed from them. The aligned sequence is I_out, V_out, I_out, V_in and
+  * the mean of the two I_out samples is I_out at the moment V_out was
+  * sampled. What remains is the curvature of I_out over two slots, for a
+  * sine of frequency f an amplitude error of 1 - cos(2*pi*f*3.4us): 0.02%
+  * at 1kHz and no phase error. The OCP, OPP, sums and readings all get the
+  * mean. */
+#if defined(CONFIG_ADC_DMA) || defined(CONFIG_ADC_PLAN)
+ #error "The aligned V/I sequence is an injected sequence of its own"
+#endif
+#endif // CONFIG_ADC_ALIGNED_VI
+
 #define TFT_RST_PORT GPIOB
 #define TFT_RST_PIN  GPIO12
 #define TFT_A0_PORT  GPIOB
@@ -39,39 +119,55 @@
 
 #define BUTTON_SEL_PORT GPIOA
 #define BUTTON_SEL_PIN  GPIO2
-#define BUTTON_SEL_EXTI EXTI2
-#define BUTTON_SEL_isr  exti2_isr
-#define BUTTON_SEL_NVIC NVIC_EXTI2_IRQ
 
 #define BUTTON_M1_PORT GPIOA
 #define BUTTON_M1_PIN  GPIO3
-#define BUTTON_M1_EXTI EXTI3
-#define BUTTON_M1_isr  exti3_isr
-#define BUTTON_M1_NVIC NVIC_EXTI3_IRQ
 
 #define BUTTON_M2_PORT GPIOA
 #define BUTTON_M2_PIN  GPIO1
-#define BUTTON_M2_EXTI EXTI1
-#define BUTTON_M2_isr  exti1_isr
-#define BUTTON_M2_NVIC NVIC_EXTI1_IRQ
 
 #define BUTTON_ENABLE_PORT GPIOB
 #define BUTTON_ENABLE_PIN  GPIO4
-#define BUTTON_ENABLE_EXTI EXTI4
-#define BUTTON_ENABLE_isr  exti4_isr
-#define BUTTON_ENABLE_NVIC NVIC_EXTI4_IRQ
 
 #define BUTTON_ROT_PRESS_PORT GPIOB
 #define BUTTON_ROT_PRESS_PIN  GPIO5
-#define BUTTON_ROT_PRESS_EXTI EXTI5
 #define BUTTON_ROT_A_PORT     GPIOB
 #define BUTTON_ROT_A_PIN      GPIO8
-#define BUTTON_ROT_A_EXTI     EXTI8
 #define BUTTON_ROT_B_PORT     GPIOB
 #define BUTTON_ROT_B_PIN      GPIO9
-#define BUTTON_ROT_B_EXTI     EXTI9
-#define BUTTON_ROTARY_isr     exti9_5_isr
-#define BUTTON_ROTARY_NVIC    NVIC_EXTI9_5_IRQ
+
+/** Sums of the samples of the scans made while power out was enabled, for
+  * integrating charge and energy. The samples are compensated with
+  * pwrctl_i_out_zero_raw and pwrctl_v_out_zero_raw like the OPP. */
+typedef struct {
+    uint32_t scans;  /** Number of scans made since boot, enabled or not */
+    uint32_t count;  /** Number of scans summed */
+    uint64_t i_out;  /** Sum of I_out samples */
+    uint64_t power;  /** Sum of V_out * I_out sample products */
+} hw_adc_sums_t;
+
+#ifdef CONFIG_ADC_DMA
+/** Number of scans (one sample of each of I_out, V_in and V_out) in each half
+  * of the ADC DMA buffer. At ~21kHz, a block is completed every ~0.75ms */
+#define ADC_DMA_BLOCK_LEN  (16)
+
+/** Summary of one block of ADC samples, I_out is offset compensated */
+typedef struct {
+    uint32_t seq;        /** Incremented for every completed block */
+    uint16_t count;      /** Number of scans in the block */
+    uint16_t i_out_avg;
+    uint16_t i_out_min;
+    uint16_t i_out_max;
+    uint16_t v_in_avg;
+    uint16_t v_out_avg;
+    uint16_t v_out_min;
+    uint16_t v_out_max;
+} adc_block_t;
+
+/** Called from the DMA ISR with num_scans interleaved [I_out, V_in, V_out]
+  * raw samples. The buffer will be overwritten after the callback returns. */
+typedef void (*hw_adc_block_callback_t)(const uint16_t *scans, uint32_t num_scans);
+#endif // CONFIG_ADC_DMA
 
 
 /**
@@ -80,21 +176,159 @@
   */
 void hw_init(void);
 
+/**
+  * @brief Calibrate the ADC and start sampling. Call a while after hw_init()
+  *        so the ADC startup time is spent on other init.
+  * @retval None
+  */
+void hw_adc_start(void);
+
+/**
+  * @brief Sleep until the next interrupt, unless there are events to handle
+  *        or a timer is due
+  * @param deadline the tick when the next timer expires
+  * @retval None
+  */
+void hw_idle(uint64_t deadline);
+
 /**
   * @brief Read latest ADC mesurements
   * @param i_out_raw latest I_out raw value
   * @param v_in_raw latest V_in raw value
   * @param v_out_raw latest V_out raw value
+  * @note The values have HW_ADC_FRAC_BITS fractional bits
   * @retval none
   */
 void hw_get_adc_values(uint16_t *i_out_raw, uint16_t *v_in_raw, uint16_t *v_out_raw);
 
+#ifdef CONFIG_ADC_DMA
+/**
+  * @brief Get the summary of the latest completed ADC block
+  * @param block the summary is copied here
+  * @retval true if a block has been completed since boot
+  */
+bool hw_get_adc_block(adc_block_t *block);
+
+/**
+  * @brief Register a consumer of raw ADC blocks
+  * @param callback function called from the DMA ISR for every completed block,
+  *        or NULL to unregister
+  * @retval None
+  */
+void hw_set_adc_block_callback(hw_adc_block_callback_t callback);
+#endif // CONFIG_ADC_DMA
+
+/**
+  * @brief Get and clear the sums of the samples made while power out was
+  *        enabled
+  * @param sums the sums since the previous call are copied here
+  * @retval None
+  */
+void hw_get_adc_sums(hw_adc_sums_t *sums);
+
+/**
+  * @brief Get bytes received on USART1
+  * @param buf buffer to copy received bytes to
+  * @param size size of buffer
+  * @retval number of bytes copied, 0 if there is nothing more to read
+  */
+uint32_t hw_uart_rx_get(uint8_t *buf, uint32_t size);
+
+/**
+  * @brief Queue bytes for transmission on USART1. Returns as soon as all bytes
+  *        are queued, waiting only if the TX ring is full.
+  * @param buf bytes to send
+  * @param length number of bytes
+  * @retval None
+  */
+void hw_uart_tx(const uint8_t *buf, uint32_t length);
+
+/**
+  * @brief Wait until all queued bytes have been sent on USART1
+  * @retval None
+  */
+void hw_uart_tx_flush(void);
+
+/**
+  * @brief Change the baud rate of USART1, after sending all queued bytes at
+  *        the current rate
+  * @param baud the new rate
+  * @retval None
+  */
+void hw_uart_set_baudrate(uint32_t baud);
+
+/**
+  * @brief Get the number of bytes dropped due to a full USART1 RX ring
+  * @retval number of dropped bytes since boot
+  */
+uint32_t hw_uart_rx_overflows(void);
+
+/**
+  * @brief Check if received data was announced but not read yet
+  * @retval true if an event_uart_rx_ready is waiting to be handled
+  */
+bool hw_uart_rx_waiting(void);
+
 /**
   * @brief Initialize TIM4 that drives the backlight of the TFT
   * @retval None
   */
 void hw_enable_backlight(void);
 
+#ifdef CONFIG_THERMAL
+/** Internal temperature sensor voltage at 25C and slope, the typical values
+  * of the datasheet. V25 varies by +/-90mV between parts, trim it for
+  * absolute readings. */
+#ifndef CONFIG_CHIP_TEMP_V25_MV
+ #define CONFIG_CHIP_TEMP_V25_MV  (1410)
+#endif
+#ifndef CONFIG_CHIP_TEMP_SLOPE_UV_C
+ #define CONFIG_CHIP_TEMP_SLOPE_UV_C  (4300)
+#endif
+
+/**
+  * @brief Switch the fan, if the model has one
+  * @param on true to run the fan
+  * @retval None
+  */
+void hw_set_fan(bool on);
+
+/**
+  * @brief Get the reading of the STM32 internal temperature sensor and start
+  *        the next conversion, on the ADC group the scans do not use
+  * @param temp the temperature in 1/10 degrees Celsius
+  * @note The absolute accuracy of the sensor is poor, see
+  *       CONFIG_CHIP_TEMP_V25_MV
+  * @retval true if a conversion had completed since the previous call
+  */
+bool hw_get_chip_temperature(int16_t *temp);
+#endif // CONFIG_THERMAL
+
+#ifdef CONFIG_WAVE
+/**
+  * @brief Feed the V_out DAC from a table by timer triggered DMA, with no CPU
+  *        work per sample
+  * @param table the DAC codes, read in a loop until stopped, must stay valid
+  * @param len number of codes
+  * @param rate_mhz samples per 1000s
+  * @retval false if the rate is out of range
+  */
+bool hw_dac_wave_start(const uint16_t *table, uint32_t len, uint64_t rate_mhz);
+
+/**
+  * @brief Stop feeding the V_out DAC, it keeps the last code until written
+  * @note May be called from ISRs
+  * @retval None
+  */
+void hw_dac_wave_stop(void);
+
+/**
+  * @brief Check if the V_out DAC is fed by DMA
+  * @retval true if a waveform is playing
+  */
+bool hw_dac_wave_active(void);
+#endif // CONFIG_WAVE
+
 /**
   * @brief Get the ADC valut that triggered the OCP
   * @retval Trivver value in mA
@@ -102,10 +336,22 @@ void hw_enable_backlight(void);
 uint16_t hw_get_itrig_ma(void);
 
 /**
-  * @brief Check if it current press is a long press, inject event if so
+  * @brief Get the ADC values of the scan that triggered the latest OVP or OPP
+  * @param i_out_raw I_out sample, offset compensated
+  * @param v_out_raw V_out sample
+  * @note The samples have no fractional bits
+  * @retval None
+  */
+void hw_get_prot_trig(uint16_t *i_out_raw, uint16_t *v_out_raw);
+
+#ifdef CONFIG_OCP_AWD
+/**
+  * @brief Arm the ADC analog watchdog for OCP at pwrctl_i_limit_raw, to be
+  *        called when the limit changes
   * @retval None
   */
-void hw_longpress_check(void);
+void hw_update_ocp_limit(void);
+#endif // CONFIG_OCP_AWD
 
 /**
   * @brief Check if SEL button is pressed
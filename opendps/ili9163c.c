@@ -42,6 +42,8 @@ static void write_command(uint8_t c);
 static void write_data(uint8_t c);
 static void write_data16(uint16_t d);
 static void color_space(uint8_t cspace);
+static void a0_data(void *arg);
+static void a0_command(void *arg);
 
 void ili9163c_init(void)
 {
@@ -80,6 +82,7 @@ void ili9163c_init(void)
 
 static void write_command(uint8_t c)
 {
+    spi_wait(); // A0 must not change under a queued transfer
     gpio_clear(TFT_A0_PORT, TFT_A0_PIN);
     uint8_t tx_buf[1] = {c};
     (void) spi_dma_transceive((uint8_t*) tx_buf, sizeof(tx_buf), 0, 0);
@@ -87,6 +90,7 @@ static void write_command(uint8_t c)
 
 static void write_data(uint8_t c)
 {
+    spi_wait(); // A0 must not change under a queued transfer
     gpio_set(TFT_A0_PORT, TFT_A0_PIN);
     uint8_t tx_buf[1] = {c};
     (void) spi_dma_transceive((uint8_t*) tx_buf, sizeof(tx_buf), 0, 0);
@@ -94,11 +98,54 @@ static void write_data(uint8_t c)
 
 static void write_data16(uint16_t d)
 {
+    spi_wait(); // A0 must not change under a queued transfer
     gpio_set(TFT_A0_PORT, TFT_A0_PIN);
     uint8_t tx_buf[2] = {(uint8_t) (d >> 8), (uint8_t) (d & 0xff)};
     (void) spi_dma_transceive((uint8_t*) tx_buf, sizeof(tx_buf), 0, 0);
 }
 
+/**
+  * @brief SPI completion callbacks switching A0 before the next queued transfer
+  */
+static void a0_data(void *arg)
+{
+    (void) arg;
+    gpio_set(TFT_A0_PORT, TFT_A0_PIN);
+}
+
+static void a0_command(void *arg)
+{
+    (void) arg;
+    gpio_clear(TFT_A0_PORT, TFT_A0_PIN);
+}
+
+/**
+  * @brief Send a sequence of commands and their parameters
+  * @param seq sequence of [command] [number of parameters] [parameters...]
+  * @param len length of sequence
+  * @note All commands and parameters are queued on the SPI bus at once with
+  *       A0 being switched from the completion callbacks. A0 is left in data
+  *       mode allowing pixel data to be queued right after. The sequence
+  *       must remain valid until the SPI driver is idle.
+  * @retval none
+  */
+void ili9163c_write_sequence(const uint8_t *seq, uint32_t len)
+{
+    spi_wait(); // A0 must not change under a queued transfer
+    gpio_clear(TFT_A0_PORT, TFT_A0_PIN);
+    while (len >= 2) {
+        uint8_t num_params = seq[1];
+        bool last = len <= 2u + num_params;
+        spi_callback_t cb = (num_params || last) ? &a0_data : 0;
+        (void) spi_dma_transceive_async((uint8_t*) seq, 1, 0, 0, cb, 0);
+        if (num_params) {
+            (void) spi_dma_transceive_async((uint8_t*) &seq[2], num_params, 0, 0, last ? 0 : &a0_command, 0);
+        }
+        seq += 2 + num_params;
+        len = last ? 0 : len - 2 - num_params;
+    }
+}
+
 static void chip_init(void)
 {
     uint8_t i;
@@ -227,16 +274,12 @@ bool ili9163c_boundary_check(int16_t x,int16_t y)
 
 void ili9163c_fill_screen(uint16_t color)
 {
-    uint32_t i;
-    uint8_t hi = color >> 8;
-    uint8_t lo = color & 0xff; 
-    uint8_t fill[] = {hi, lo, hi, lo, hi, lo, hi, lo, hi, lo, hi, lo, hi, lo, hi, lo};
-    uint8_t dummy[sizeof(fill)];
-    gpio_clear(TFT_A0_PORT, TFT_A0_PIN);
     ili9163c_set_window(0, 0, _GRAMWIDTH+2, _GRAMHEIGH); // Note! For some reason filling WxH is results in two vertical lines to the far right...
-    gpio_set(TFT_A0_PORT, TFT_A0_PIN);
-    for (i = 0;i < ((_GRAMWIDTH+2) * _GRAMHEIGH)/(sizeof(fill)/2); i++) {
-        (void) spi_dma_transceive((uint8_t*) fill, sizeof(fill), (uint8_t*) dummy, sizeof(dummy));
+    uint32_t count = (_GRAMWIDTH+2) * _GRAMHEIGH;
+    while (count) {
+        uint32_t c = count < 0xffff ? count : 0xffff;
+        (void) spi_dma_fill_async(color, c, 0, 0);
+        count -= c;
     }
 }
 
@@ -247,34 +290,34 @@ void ili9163c_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t col
     if (((x + w) - 1) >= screen_width)  w = screen_width  - x;
     if (((y + h) - 1) >= screen_height) h = screen_height - y;
     ili9163c_set_window(x,y,(x+w)-1,(y+h)-1);
-    for (y = h;y > 0;y--) {
-        for (x = w;x > 1;x--) {
-            write_data16(color);
-        }
-        write_data16(color);
-    }
+    (void) spi_dma_fill_async(color, w * h, 0, 0);
 }
 
 void ili9163c_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
 {
-    write_command(CMD_CLMADRS); // Column
-    if (rotation == 0 || rotation > 1) {
-        write_data16(x0);
-        write_data16(x1);
-    } else {
-        write_data16(x0 + __OFFSET);
-        write_data16(x1 + __OFFSET);
-    }
-
-    write_command(CMD_PGEADRS); // Page
-    if (rotation == 0) {
-        write_data16(y0 + __OFFSET);
-        write_data16(y1 + __OFFSET);
-    } else {
-        write_data16(y0);
-        write_data16(y1);
+    /** Column, page and RAM write in one go, static as it is pushed by DMA */
+    static uint8_t seq[] = {
+        CMD_CLMADRS, 4, 0, 0, 0, 0,
+        CMD_PGEADRS, 4, 0, 0, 0, 0,
+        CMD_RAMWR, 0
+    };
+    if (rotation == 1) {
+        x0 += __OFFSET;
+        x1 += __OFFSET;
+    } else if (rotation == 0) {
+        y0 += __OFFSET;
+        y1 += __OFFSET;
     }
-    write_command(CMD_RAMWR); // Into RAM
+    spi_wait(); // The previous window may still be pushed from seq
+    seq[2] = x0 >> 8;
+    seq[3] = x0 & 0xff;
+    seq[4] = x1 >> 8;
+    seq[5] = x1 & 0xff;
+    seq[8] = y0 >> 8;
+    seq[9] = y0 & 0xff;
+    seq[10] = y1 >> 8;
+    seq[11] = y1 & 0xff;
+    ili9163c_write_sequence(seq, sizeof(seq));
 }
 
 
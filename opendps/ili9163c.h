@@ -52,6 +52,7 @@
 
 void ili9163c_init(void);
 void ili9163c_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+void ili9163c_write_sequence(const uint8_t *seq, uint32_t len);
 void ili9163c_push_color(uint16_t color);
 void ili9163c_fill_screen(uint16_t color);
 void ili9163c_draw_pixel(int16_t x, int16_t y, uint16_t color);
@@ -0,0 +1,92 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "intfmt.h"
+
+/** Smallest value of each number of digits, the digits are counted first so
+  * the string can be written in place from its last digit */
+static const uint32_t powers_of_ten[] = {
+    10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+/**
+  * @brief Count the decimal digits of a value
+  * @param value the value
+  * @retval number of digits, 1 to 10
+  */
+static uint32_t num_digits(uint32_t value)
+{
+    uint32_t n = 1;
+    while (n < 10 && value >= powers_of_ten[n - 1]) {
+        n++;
+    }
+    return n;
+}
+
+uint32_t intfmt_i32(char *buf, uint32_t len, int32_t value)
+{
+    bool negative = value < 0;
+    /** Negated as unsigned, INT32_MIN has no positive counterpart */
+    uint32_t v = negative ? 0u - (uint32_t) value : (uint32_t) value;
+    uint32_t n = num_digits(v) + negative;
+    if (n + 1 > len) {
+        return 0;
+    }
+    char *p = &buf[n];
+    *p = '\0';
+    do {
+        /** Division by a constant, compiled to a multiply by its reciprocal */
+        uint32_t q = v / 10;
+        *--p = '0' + (v - q * 10);
+        v = q;
+    } while (v);
+    if (negative) {
+        *--p = '-';
+    }
+    return n;
+}
+
+bool intfmt_parse_i32(const char *str, int32_t *value)
+{
+    bool negative = false;
+    if (*str == '-' || *str == '+') {
+        negative = *str++ == '-';
+    }
+    if (*str == '\0') {
+        return false;
+    }
+    uint32_t limit = negative ? 0x80000000u : 0x7fffffffu;
+    uint32_t v = 0;
+    for (; *str; str++) {
+        uint32_t digit = (uint32_t) (*str - '0');
+        if (digit > 9 || v > (limit - digit) / 10) {
+            return false;
+        }
+        v = v * 10 + digit;
+    }
+    *value = negative ? (int32_t) (0u - v) : (int32_t) v;
+    return true;
+}
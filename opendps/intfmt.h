@@ -0,0 +1,52 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __INTFMT_H__
+#define __INTFMT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Decimal formatting and parsing of the integers passed as strings in the
+  * parameter protocol, without going through mini_snprintf and atoi */
+
+/**
+  * @brief Format a signed integer in decimal
+  * @param buf buffer receiving the terminated string
+  * @param len size of buf
+  * @param value the value
+  * @retval number of characters written, excluding the terminator, or 0 if
+  *         buf is too small
+  */
+uint32_t intfmt_i32(char *buf, uint32_t len, int32_t value);
+
+/**
+  * @brief Parse a decimal integer with an optional sign
+  * @param str the string, nothing but the number is allowed
+  * @param value receives the value
+  * @retval true if str was a number within the range of int32_t
+  */
+bool intfmt_parse_i32(const char *str, int32_t *value);
+
+#endif // __INTFMT_H__
@@ -1,374 +1,71 @@
+const uint8_t logo_palette[] = {
+  0x00, 0x00, 0x10, 0x82, 0x21, 0x04, 0x31, 0x86, 0x42, 0x08, 0x52, 0xaa, 0x63, 0x2c, 0x73, 0xae,
+  0x84, 0x30, 0x94, 0xb2, 0xa5, 0x54, 0xb5, 0xd6, 0xc6, 0x58, 0xd6, 0xda, 0xe7, 0x5c, 0xff, 0xff,
+};
 const uint8_t logo[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3,
-  0x29, 0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x18, 0xe3, 0x39, 0xc7, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x31, 0xa6, 0x9d, 0x13, 0xde, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c,
-  0xad, 0x75, 0x4a, 0x69, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x91, 0xbd, 0xf7, 0xdf, 0x1b, 0xf7, 0xbe, 0xf7, 0xbe,
-  0xd6, 0xba, 0xad, 0x75, 0x84, 0x30, 0x21, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0xe7, 0x94, 0xd2, 0xb5, 0xd6, 0xd6, 0xda,
-  0xf7, 0xbe, 0xde, 0xfb, 0xbd, 0xf7, 0x8c, 0x71, 0x18, 0xc3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x41, 0x7c, 0x0f, 0xef, 0x7d, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xef, 0x9d, 0x94, 0xb2, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3a, 0x07,
-  0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde,
-  0x63, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xef, 0x9d, 0x6b, 0x8d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xef, 0x9d, 0x73, 0xce, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x08, 0x41, 0xd6, 0x9a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xf7, 0xbe, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00, 0x42, 0x08, 0xf7, 0xbe, 0xff, 0xff, 0xf7, 0xbe,
-  0x8c, 0x91, 0x42, 0x28, 0x31, 0xc6, 0x84, 0x30, 0xe7, 0x5c, 0xff, 0xff, 0xf7, 0xde, 0x63, 0x2c,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
-  0xff, 0xff, 0xd6, 0x9a, 0x63, 0x2c, 0x63, 0x2c, 0x8c, 0x51, 0xb5, 0xb6, 0xef, 0x9d, 0xff, 0xff,
-  0xff, 0xff, 0xb5, 0xd6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x71, 0x63, 0x0c, 0x73, 0xce, 0xad, 0x95, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0x4a, 0x69, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x94, 0xb2, 0xff, 0xff,
-  0xff, 0xff, 0xb5, 0xd6, 0x5a, 0xeb, 0x10, 0x82, 0x21, 0x04, 0x63, 0x4c, 0x84, 0x30, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xce, 0x59, 0xff, 0xff, 0xff, 0xff, 0x63, 0x0c, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x39, 0xc7, 0xf7, 0xbe, 0xff, 0xff, 0xef, 0x7d, 0x08, 0x41, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0xd6, 0xda, 0xff, 0xff, 0xff, 0xff,
-  0x52, 0xca, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff,
-  0xff, 0xff, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x8a, 0xff, 0xff, 0xff, 0xff,
-  0xe7, 0x3c, 0x08, 0x41, 0x00, 0x00, 0x08, 0x41, 0xf7, 0xde, 0xff, 0xff, 0xbd, 0xf7, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0x86,
-  0xff, 0xff, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x7b, 0xcf, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xeb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x41, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x20, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x82, 0xef, 0x9d, 0xff, 0xff, 0xd6, 0xda, 0x00, 0x20,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6,
-  0x00, 0x00, 0x31, 0xa6, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x94, 0xb2, 0xff, 0xff, 0xff, 0xff,
-  0x4a, 0x69, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x04,
-  0xff, 0xff, 0xff, 0xff, 0xbe, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x49,
-  0xad, 0x75, 0xef, 0x7d, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x3c, 0xb5, 0xb6, 0x52, 0x8a, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xef,
-  0xd6, 0xba, 0xff, 0xff, 0xef, 0x9d, 0xbd, 0xf7, 0x31, 0x86, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x39, 0xe7, 0x8c, 0x71, 0xc6, 0x58, 0xe7, 0x5c, 0xff, 0xff, 0xf7, 0xde,
-  0xde, 0xfb, 0x8c, 0x91, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x94, 0xd2, 0xff, 0xff, 0xff, 0xff, 0x63, 0x2c, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x73, 0x8e, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xeb, 0x00, 0x00, 0x4a, 0x69,
-  0xff, 0xff, 0xff, 0xff, 0x63, 0x4c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xdf, 0x1b, 0xff, 0xff, 0xf7, 0xbe, 0x08, 0x41, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xff, 0xff,
-  0xff, 0xff, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x73, 0xce, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xe7, 0x5c, 0x29, 0x85, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xa5, 0x34, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xde, 0xfb, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
-  0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x31, 0xa6, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x52, 0x8a, 0xff, 0xff, 0xff, 0xff, 0x84, 0x10, 0x00, 0x00, 0x21, 0x04, 0xff, 0xff, 0xff, 0xff,
-  0x9d, 0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xf7, 0xde, 0xff, 0xff, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9c, 0xf3, 0xff, 0xff, 0xff, 0xff, 0x29, 0x45,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xe7, 0x5c, 0x39, 0xc7, 0x29, 0x65,
-  0x5a, 0xeb, 0xde, 0xfb, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x89, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x52, 0xca, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x91, 0x21, 0x04, 0x4a, 0x69, 0xef, 0x9d,
-  0xff, 0xff, 0xb5, 0xb6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff,
-  0xef, 0x9d, 0x63, 0x2c, 0x42, 0x08, 0x4a, 0x89, 0xb5, 0x96, 0xff, 0xff, 0xff, 0xff, 0x7b, 0xef,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xff, 0xff,
-  0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff,
-  0xff, 0xff, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x4d, 0xff, 0xff,
-  0xff, 0xff, 0x63, 0x4c, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x3c, 0xff, 0xff, 0xf7, 0xde, 0x39, 0xe7,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0xff, 0xff,
-  0xff, 0xff, 0xb5, 0xb6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x8c, 0x71, 0xff, 0xff, 0xff, 0xff, 0x42, 0x08, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3,
-  0xef, 0x7d, 0xff, 0xff, 0xb5, 0xd6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbe, 0x17,
-  0xff, 0xff, 0xce, 0x79, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x84, 0x30, 0xff, 0xff, 0xf7, 0xde,
-  0x10, 0x82, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce, 0x79, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x5c, 0xff, 0xff, 0xff, 0xff,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x94, 0xd2, 0xff, 0xff, 0xff, 0xff, 0x39, 0xe7,
-  0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb, 0xff, 0xff, 0xff, 0xff, 0xef, 0x9d, 0x4a, 0x89, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0x86, 0xff, 0xff, 0xff, 0xff, 0x9d, 0x13,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x7b, 0xcf, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75,
-  0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9d, 0x13, 0xff, 0xff,
-  0xff, 0xff, 0x21, 0x04, 0x00, 0x00, 0x00, 0x00, 0x21, 0x04, 0xff, 0xff, 0xff, 0xff, 0x7b, 0xcf,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0xff, 0xff, 0x52, 0xaa, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x7b, 0xef, 0xff, 0xff, 0xff, 0xff, 0x08, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xff, 0xff, 0xff, 0xff, 0x10, 0x82, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x29, 0x65, 0xf7, 0xbe, 0xff, 0xff, 0xf7, 0xde, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x94, 0xd2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9c, 0xf3, 0x08, 0x61, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x4a, 0x49, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x91, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x4d, 0xff, 0xff,
-  0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xdf, 0x1b,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x69,
-  0x00, 0x00, 0x00, 0x00, 0x42, 0x08, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x49, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x21, 0x44, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xa5, 0x34, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb,
-  0xff, 0xff, 0xff, 0xff, 0x29, 0x65, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
-  0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xbe, 0x17, 0xff, 0xff, 0xff, 0xff, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0x42, 0x28, 0x18, 0xc3, 0x31, 0xc6, 0x7b, 0xef, 0xef, 0x7d,
-  0xff, 0xff, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x7b, 0xef, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xde, 0xfb, 0x31, 0x86, 0x00, 0x00, 0x00, 0x00,
-  0x39, 0xc7, 0xff, 0xff, 0xff, 0xff, 0x9c, 0xf3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xae, 0xff, 0xff, 0xff, 0xff, 0x5b, 0x0b,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x3a, 0x07, 0xff, 0xff, 0xff, 0xff, 0x63, 0x2c, 0x00, 0x00, 0x00, 0x00,
-  0x5a, 0xcb, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xcb, 0x31, 0xa6, 0x31, 0xa6, 0x31, 0xa6, 0x4a, 0x49,
-  0xff, 0xff, 0xff, 0xff, 0x84, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff,
-  0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x49, 0xff, 0xff, 0xff, 0xff,
-  0x42, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xce, 0x99,
-  0xff, 0xff, 0xff, 0xff, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbd, 0xf7,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0xc7,
-  0xde, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x39, 0xc7, 0x00, 0x00, 0x21, 0x04, 0xff, 0xff,
-  0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x84, 0x50, 0xff, 0xff, 0xff, 0xff, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x29, 0x65, 0xff, 0xff, 0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00, 0x73, 0x8e, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0x94, 0xb2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x49, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x3c, 0xff, 0xff, 0xff, 0xff,
-  0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd6, 0x9a, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x61, 0xb5, 0xb6,
-  0xff, 0xff, 0xff, 0xff, 0xd6, 0xda, 0x00, 0x20, 0x00, 0x20, 0xff, 0xff, 0xff, 0xff, 0xbe, 0x17,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x94, 0xd2, 0xff, 0xff, 0xff, 0xff, 0x29, 0x65, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75,
-  0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x24, 0xff, 0xff,
-  0xff, 0xff, 0x84, 0x30, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xef, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x3c,
-  0xdf, 0x1b, 0xdf, 0x1b, 0xdf, 0x1b, 0xdf, 0x1b, 0xdf, 0x1b, 0xdf, 0x1b, 0x84, 0x30, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x49, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf7, 0xde, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x8d, 0x42, 0x28, 0x21, 0x44,
-  0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xce, 0x59, 0xff, 0xff,
-  0xff, 0xff, 0x63, 0x2c, 0x00, 0x00, 0xe7, 0x5c, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x18, 0xff, 0xff,
-  0xff, 0xff, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xdf, 0x1b,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0xc7, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x8d,
-  0x00, 0x00, 0x00, 0x00, 0x63, 0x4c, 0xff, 0xff, 0xff, 0xff, 0x29, 0x45, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xa5, 0x34, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x28,
-  0xff, 0xff, 0xff, 0xff, 0x4a, 0x49, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
-  0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x21, 0x24, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xb6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x48, 0xff, 0xff, 0xff, 0xff, 0x9c, 0xd3,
-  0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xff, 0xff, 0x39, 0xe7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x82, 0xf7, 0xde, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x4a, 0x69, 0xff, 0xff, 0xff, 0xff, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00,
-  0x4a, 0x89, 0xff, 0xff, 0xff, 0xff, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff,
-  0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0xff, 0xff,
-  0x4a, 0x49, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x84, 0x30, 0xff, 0xff,
-  0xff, 0xff, 0x73, 0xce, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff,
-  0xff, 0xff, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x10, 0x82, 0xff, 0xff, 0xff, 0xff, 0xbe, 0x17, 0x00, 0x00, 0x42, 0x48,
-  0xff, 0xff, 0xff, 0xff, 0x8c, 0x71, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x5a, 0xeb, 0xff, 0xff, 0xff, 0xff, 0x73, 0x8e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x7c, 0x0f, 0xff, 0xff, 0xff, 0xff, 0x42, 0x08, 0x00, 0x00, 0x00, 0x00, 0x31, 0x86, 0xff, 0xff,
-  0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x49, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xe7, 0x3c, 0xff, 0xff, 0xe7, 0x5c, 0x08, 0x61,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x18, 0xe3, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x54, 0x00, 0x00, 0x00, 0x00, 0xde, 0xfb, 0xff, 0xff,
-  0xf7, 0xbe, 0x39, 0xe7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0xe7, 0x5c,
-  0xff, 0xff, 0xf7, 0xbe, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75,
-  0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xff, 0xff,
-  0xe7, 0x5c, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xff, 0xff, 0xd6, 0xda,
-  0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x49, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x10, 0xa2, 0xbd, 0xf7, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x8d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x6d, 0xff, 0xff,
-  0xff, 0xff, 0x7c, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x63, 0x2c, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x3c,
-  0x63, 0x0c, 0x18, 0xc3, 0x08, 0x61, 0x52, 0xaa, 0xce, 0x99, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x91,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xe7, 0x5c,
-  0x31, 0xa6, 0x00, 0x00, 0x10, 0x82, 0x9c, 0xf3, 0xff, 0xff, 0xff, 0xff, 0x94, 0xb2, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xae, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xd6, 0x21, 0x44,
-  0x00, 0x00, 0x00, 0x20, 0x39, 0xc7, 0x39, 0xc7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0xa5, 0x34, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x28,
-  0xff, 0xff, 0xff, 0xff, 0x4a, 0x49, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
-  0xff, 0xff, 0xc6, 0x38, 0x39, 0xc7, 0x31, 0xc6, 0x5a, 0xeb, 0x84, 0x50, 0xdf, 0x1b, 0xff, 0xff,
-  0xff, 0xff, 0xd6, 0xda, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0xa2, 0xad, 0x95, 0x39, 0xe7,
-  0x00, 0x20, 0x00, 0x00, 0x00, 0x20, 0x5a, 0xeb, 0xef, 0x9d, 0xff, 0xff, 0xef, 0x9d, 0x18, 0xe3,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x4d, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde,
-  0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0xb2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x9d,
-  0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x1b, 0x21, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x08, 0x41, 0xbd, 0xd7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0xf7, 0xde,
-  0xff, 0xff, 0x9c, 0xf3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff,
-  0xe7, 0x5c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0xff, 0xff,
-  0x4a, 0x49, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9c, 0xf3, 0x10, 0x82,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff,
-  0xff, 0xff, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0x8e, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0xdf, 0x1b,
-  0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb, 0xce, 0x99, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xde, 0xfb, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xf7, 0xde, 0xf7, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xd6, 0x9a, 0x21, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x20, 0x9d, 0x13, 0xef, 0x9d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xde, 0x8c, 0x71,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0xe7, 0x5c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x28, 0xff, 0xff, 0xff, 0xff, 0x4a, 0x49, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb5, 0xd6, 0xd6, 0xda, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff,
-  0xf7, 0xde, 0xd6, 0xda, 0xb5, 0x96, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0xce, 0xff, 0xff, 0xff, 0xff, 0x31, 0xa6,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x4a, 0x69, 0xce, 0x79, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xde, 0xfb, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x10, 0x82, 0x4a, 0x69, 0x52, 0xaa, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75,
-  0xff, 0xff, 0xdf, 0x1b, 0x18, 0xc3, 0x4a, 0x89, 0x4a, 0x69, 0x18, 0xc3, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x31, 0x86, 0x52, 0xaa, 0x39, 0xc7, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0x29, 0x45, 0x00, 0x20, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x21, 0x24, 0x4a, 0x49, 0x63, 0x2c, 0x4a, 0x69, 0x21, 0x04, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xdf, 0x1b,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75,
-  0xff, 0xff, 0xdf, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb, 0x8c, 0x51, 0x7b, 0xcf,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0x60, 0x12, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x60, 0x02, 0x03, 0x02, 0x60, 0x03, 0x0a, 0x0d, 0x1f,
+  0x0e, 0x0a, 0x05, 0xf0, 0xf0, 0xf0, 0x00, 0x09, 0x0b, 0x0d, 0x1f, 0x0d, 0x0a, 0x08, 0x02, 0x70,
+  0x04, 0x09, 0x0b, 0x0d, 0x0f, 0x0d, 0x0b, 0x08, 0x01, 0x60, 0x08, 0x0e, 0x2f, 0x0e, 0x09, 0x01,
+  0x20, 0x04, 0x0e, 0x6f, 0x06, 0xf0, 0xf0, 0xf0, 0x7f, 0x0e, 0x07, 0x60, 0x07, 0x6f, 0x0e, 0x07,
+  0x40, 0x0c, 0x6f, 0x01, 0x10, 0x04, 0x2f, 0x09, 0x04, 0x03, 0x08, 0x0e, 0x1f, 0x06, 0xf0, 0xf0,
+  0xe0, 0x1f, 0x0c, 0x16, 0x08, 0x0b, 0x0e, 0x1f, 0x0b, 0x50, 0x07, 0x1f, 0x08, 0x06, 0x07, 0x0a,
+  0x2f, 0x05, 0x20, 0x09, 0x1f, 0x0b, 0x05, 0x01, 0x02, 0x06, 0x08, 0x20, 0x0c, 0x1f, 0x06, 0x30,
+  0x03, 0x1f, 0x0e, 0xf0, 0xf0, 0xe0, 0x1f, 0x0a, 0x30, 0x03, 0x0d, 0x1f, 0x05, 0x40, 0x07, 0x1f,
+  0x03, 0x20, 0x05, 0x1f, 0x0e, 0x20, 0x1f, 0x0b, 0x70, 0x03, 0x1f, 0x0a, 0x50, 0x07, 0x1f, 0x05,
+  0x70, 0x01, 0xc0, 0x01, 0xf0, 0x60, 0x1f, 0x0a, 0x40, 0x01, 0x0e, 0x0f, 0x0d, 0x40, 0x07, 0x1f,
+  0x03, 0x30, 0x0a, 0x1f, 0x03, 0x00, 0x03, 0x1f, 0x06, 0x70, 0x09, 0x1f, 0x05, 0x50, 0x02, 0x1f,
+  0x0b, 0x30, 0x04, 0x0a, 0x0e, 0x1f, 0x0e, 0x0b, 0x05, 0x70, 0x07, 0x0d, 0x0f, 0x0e, 0x0b, 0x03,
+  0x40, 0x04, 0x08, 0x0c, 0x0e, 0x1f, 0x0d, 0x09, 0x01, 0x50, 0x1f, 0x0a, 0x50, 0x09, 0x1f, 0x06,
+  0x30, 0x07, 0x1f, 0x03, 0x30, 0x07, 0x1f, 0x05, 0x00, 0x05, 0x1f, 0x06, 0x70, 0x0d, 0x1f, 0x70,
+  0x0d, 0x1f, 0x01, 0x20, 0x0a, 0x6f, 0x07, 0x50, 0x0a, 0x4f, 0x0e, 0x03, 0x30, 0x0a, 0x6f, 0x0d,
+  0x01, 0x40, 0x1f, 0x0a, 0x50, 0x03, 0x1f, 0x0a, 0x30, 0x07, 0x1f, 0x03, 0x30, 0x05, 0x1f, 0x08,
+  0x00, 0x02, 0x1f, 0x0a, 0x70, 0x1f, 0x0c, 0x70, 0x09, 0x1f, 0x02, 0x20, 0x0a, 0x0f, 0x0e, 0x13,
+  0x05, 0x0d, 0x1f, 0x05, 0x30, 0x05, 0x1f, 0x09, 0x02, 0x05, 0x0e, 0x0f, 0x0b, 0x30, 0x0a, 0x0f,
+  0x0e, 0x06, 0x04, 0x05, 0x0a, 0x1f, 0x07, 0x40, 0x1f, 0x0a, 0x60, 0x1f, 0x0d, 0x30, 0x07, 0x1f,
+  0x03, 0x30, 0x06, 0x1f, 0x06, 0x10, 0x0e, 0x1f, 0x04, 0x50, 0x01, 0x1f, 0x0b, 0x70, 0x08, 0x1f,
+  0x04, 0x20, 0x0a, 0x0f, 0x0d, 0x20, 0x02, 0x0e, 0x0f, 0x0b, 0x30, 0x0b, 0x0f, 0x0c, 0x20, 0x08,
+  0x1f, 0x01, 0x20, 0x0a, 0x0f, 0x0e, 0x30, 0x0c, 0x0f, 0x0e, 0x40, 0x1f, 0x0a, 0x60, 0x0e, 0x1f,
+  0x30, 0x07, 0x1f, 0x03, 0x30, 0x09, 0x1f, 0x04, 0x10, 0x05, 0x1f, 0x0e, 0x05, 0x40, 0x03, 0x1f,
+  0x0a, 0x70, 0x07, 0x1f, 0x05, 0x20, 0x0a, 0x0f, 0x0d, 0x30, 0x0a, 0x1f, 0x02, 0x10, 0x02, 0x1f,
+  0x07, 0x20, 0x04, 0x1f, 0x05, 0x20, 0x0a, 0x0f, 0x0e, 0x30, 0x07, 0x1f, 0x01, 0x30, 0x1f, 0x0a,
+  0x60, 0x0d, 0x1f, 0x01, 0x20, 0x07, 0x1f, 0x03, 0x20, 0x03, 0x2f, 0x01, 0x20, 0x09, 0x2f, 0x09,
+  0x01, 0x20, 0x04, 0x1f, 0x09, 0x70, 0x06, 0x1f, 0x06, 0x20, 0x0a, 0x0f, 0x0d, 0x30, 0x05, 0x1f,
+  0x05, 0x10, 0x04, 0x1f, 0x04, 0x20, 0x02, 0x1f, 0x06, 0x20, 0x0a, 0x0f, 0x0e, 0x30, 0x05, 0x1f,
+  0x03, 0x30, 0x1f, 0x0a, 0x60, 0x0b, 0x1f, 0x02, 0x20, 0x07, 0x1f, 0x04, 0x01, 0x03, 0x07, 0x0e,
+  0x1f, 0x07, 0x40, 0x07, 0x2f, 0x0d, 0x03, 0x10, 0x03, 0x1f, 0x09, 0x70, 0x07, 0x1f, 0x06, 0x20,
+  0x0a, 0x0f, 0x0d, 0x30, 0x04, 0x1f, 0x06, 0x10, 0x05, 0x1f, 0x05, 0x23, 0x04, 0x1f, 0x08, 0x20,
+  0x0a, 0x0f, 0x0e, 0x30, 0x04, 0x1f, 0x04, 0x30, 0x1f, 0x0a, 0x60, 0x0c, 0x1f, 0x01, 0x20, 0x07,
+  0x7f, 0x0b, 0x60, 0x03, 0x0d, 0x1f, 0x0e, 0x03, 0x00, 0x02, 0x1f, 0x0a, 0x70, 0x08, 0x1f, 0x04,
+  0x20, 0x0a, 0x0f, 0x0d, 0x30, 0x03, 0x1f, 0x07, 0x10, 0x07, 0x8f, 0x09, 0x20, 0x0a, 0x0f, 0x0e,
+  0x30, 0x04, 0x1f, 0x04, 0x30, 0x1f, 0x0a, 0x60, 0x0e, 0x1f, 0x30, 0x07, 0x5f, 0x0c, 0x05, 0x80,
+  0x01, 0x0b, 0x1f, 0x0d, 0x10, 0x1f, 0x0b, 0x70, 0x09, 0x1f, 0x03, 0x20, 0x0a, 0x0f, 0x0d, 0x30,
+  0x02, 0x1f, 0x08, 0x10, 0x07, 0x1f, 0x0e, 0x5d, 0x08, 0x20, 0x0a, 0x0f, 0x0e, 0x30, 0x04, 0x1f,
+  0x04, 0x30, 0x1f, 0x0a, 0x60, 0x1f, 0x0e, 0x30, 0x07, 0x1f, 0x07, 0x04, 0x02, 0xd0, 0x0c, 0x1f,
+  0x06, 0x00, 0x0e, 0x0f, 0x0e, 0x70, 0x0b, 0x1f, 0x01, 0x20, 0x0a, 0x0f, 0x0d, 0x30, 0x03, 0x1f,
+  0x07, 0x10, 0x06, 0x1f, 0x02, 0x90, 0x0a, 0x0f, 0x0e, 0x30, 0x04, 0x1f, 0x04, 0x30, 0x1f, 0x0a,
+  0x50, 0x02, 0x1f, 0x0b, 0x30, 0x07, 0x1f, 0x03, 0xf0, 0x04, 0x1f, 0x09, 0x00, 0x0a, 0x1f, 0x04,
+  0x50, 0x01, 0x1f, 0x0d, 0x30, 0x0a, 0x0f, 0x0d, 0x30, 0x05, 0x1f, 0x05, 0x10, 0x05, 0x1f, 0x04,
+  0x90, 0x0a, 0x0f, 0x0e, 0x30, 0x04, 0x1f, 0x04, 0x30, 0x1f, 0x0a, 0x50, 0x08, 0x1f, 0x07, 0x30,
+  0x07, 0x1f, 0x03, 0xf0, 0x01, 0x1f, 0x0b, 0x00, 0x04, 0x1f, 0x08, 0x50, 0x05, 0x1f, 0x07, 0x30,
+  0x0a, 0x0f, 0x0d, 0x30, 0x08, 0x1f, 0x04, 0x10, 0x03, 0x1f, 0x07, 0x90, 0x0a, 0x0f, 0x0e, 0x30,
+  0x04, 0x1f, 0x04, 0x30, 0x1f, 0x0a, 0x50, 0x0e, 0x0f, 0x0e, 0x01, 0x30, 0x07, 0x1f, 0x03, 0xf0,
+  0x02, 0x1f, 0x0a, 0x10, 0x0d, 0x1f, 0x04, 0x30, 0x02, 0x0e, 0x1f, 0x01, 0x30, 0x0a, 0x0f, 0x0d,
+  0x30, 0x0d, 0x0f, 0x0e, 0x30, 0x0d, 0x0f, 0x0d, 0x90, 0x0a, 0x0f, 0x0e, 0x30, 0x04, 0x1f, 0x04,
+  0x30, 0x1f, 0x0a, 0x30, 0x01, 0x0b, 0x1f, 0x07, 0x40, 0x07, 0x1f, 0x03, 0xf0, 0x06, 0x1f, 0x08,
+  0x10, 0x06, 0x1f, 0x0e, 0x06, 0x11, 0x05, 0x0c, 0x1f, 0x09, 0x40, 0x0a, 0x0f, 0x0e, 0x03, 0x00,
+  0x01, 0x09, 0x1f, 0x09, 0x30, 0x07, 0x1f, 0x0b, 0x02, 0x10, 0x13, 0x30, 0x0a, 0x0f, 0x0e, 0x30,
+  0x04, 0x1f, 0x04, 0x30, 0x1f, 0x0c, 0x13, 0x05, 0x08, 0x0d, 0x1f, 0x0d, 0x50, 0x07, 0x1f, 0x03,
+  0x80, 0x01, 0x0a, 0x04, 0x20, 0x05, 0x0e, 0x0f, 0x0e, 0x02, 0x20, 0x06, 0x7f, 0x09, 0x50, 0x0a,
+  0x2f, 0x0e, 0x2f, 0x0d, 0x02, 0x40, 0x0b, 0x2f, 0x0e, 0x1f, 0x09, 0x30, 0x0a, 0x0f, 0x0e, 0x30,
+  0x04, 0x1f, 0x04, 0x30, 0x8f, 0x09, 0x01, 0x50, 0x07, 0x1f, 0x03, 0x80, 0x07, 0x2f, 0x0d, 0x3f,
+  0x06, 0x40, 0x05, 0x0c, 0x3f, 0x0d, 0x07, 0x60, 0x0a, 0x5f, 0x0c, 0x02, 0x60, 0x0a, 0x0e, 0x3f,
+  0x08, 0x30, 0x0a, 0x0f, 0x0e, 0x30, 0x04, 0x1f, 0x04, 0x30, 0x0b, 0x0d, 0x3f, 0x0d, 0x0a, 0x04,
+  0x70, 0x07, 0x1f, 0x03, 0x80, 0x05, 0x0c, 0x4f, 0x0d, 0x04, 0x70, 0x01, 0x15, 0x02, 0x80, 0x0a,
+  0x0f, 0x0d, 0x01, 0x15, 0x01, 0xa0, 0x03, 0x05, 0x03, 0x01, 0xf0, 0x60, 0x01, 0x02, 0xf0, 0xa0,
+  0x02, 0x04, 0x06, 0x05, 0x02, 0xf0, 0x60, 0x0a, 0x0f, 0x0d, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+  0x20, 0x0a, 0x0f, 0x0d, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x20, 0x0a, 0x0f, 0x0d, 0xf0, 0xf0,
+  0xf0, 0xf0, 0xf0, 0xf0, 0x20, 0x0a, 0x0f, 0x0d, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x20, 0x05,
+  0x08, 0x07, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x50,
 };
 #define logo_width  102
 #define logo_height  29
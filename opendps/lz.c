@@ -0,0 +1,78 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lz.h"
+
+/** State of the decoder, a token may span two packets */
+static uint8_t lz_literals;   /** Literals left of the current run */
+static uint8_t lz_dist_bytes; /** Distance bytes left of the current match */
+static uint8_t lz_match_len;
+static uint16_t lz_distance;
+static uint32_t lz_length;    /** Bytes decoded */
+
+void lz_reset(void)
+{
+    lz_literals = lz_dist_bytes = 0;
+    lz_length = 0;
+}
+
+/**
+  * A control byte below 0x80 is followed by that many literals plus one,
+  * other control bytes start a match of (c & 0x7f) + UPGRADE_LZ_MIN_MATCH
+  * bytes at the 16 bit distance that follows. A match reads the image
+  * decoded so far, and may overlap the bytes it writes.
+  */
+upgrade_status_t lz_decode(const uint8_t *data, uint32_t length)
+{
+    upgrade_status_t status = upgrade_continue;
+    for (uint32_t i = 0; i < length && status == upgrade_continue; i++) {
+        uint8_t b = data[i];
+        if (lz_literals) {
+            lz_literals--;
+            status = lz_output(b);
+            lz_length++;
+        } else if (lz_dist_bytes) {
+            lz_distance = lz_distance << 8 | b;
+            if (--lz_dist_bytes) {
+                continue;
+            }
+            if (lz_distance == 0 || lz_distance > lz_length) {
+                return upgrade_protocol_error;
+            }
+            while (lz_match_len-- && status == upgrade_continue) {
+                status = lz_output(lz_image_byte(lz_length - lz_distance));
+                lz_length++;
+            }
+        } else if (b & 0x80) {
+            lz_match_len = (b & 0x7f) + UPGRADE_LZ_MIN_MATCH;
+            lz_dist_bytes = 2;
+            lz_distance = 0;
+        } else {
+            lz_literals = b + 1;
+        }
+    }
+    return status;
+}
@@ -0,0 +1,68 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __LZ_H__
+#define __LZ_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "protocol.h"
+
+/** Decoder of the LZ compressed upgrade images, see "DPS upgrade sessions"
+  * in protocol.h. dpsboot feeds it the data packets as they arrive, and a
+  * token may span two packets. */
+
+/**
+  * @brief Append a decoded byte to the image, provided by the user of the
+  *        decoder
+  * @param b the byte
+  * @retval upgrade_continue if all is well
+  */
+upgrade_status_t lz_output(uint8_t b);
+
+/**
+  * @brief Read back a byte of the image decoded so far, provided by the user
+  *        of the decoder
+  * @param pos position of the byte in the image
+  * @retval the byte
+  */
+uint8_t lz_image_byte(uint32_t pos);
+
+/**
+  * @brief Start decoding a new image
+  * @retval None
+  */
+void lz_reset(void);
+
+/**
+  * @brief Decode the next part of an image, passing the decoded bytes to
+  *        lz_output()
+  * @param data compressed data
+  * @param length length of data
+  * @retval upgrade_continue if the data was decoded and written,
+  *         upgrade_protocol_error if a match reaches before the image
+  */
+upgrade_status_t lz_decode(const uint8_t *data, uint32_t length);
+
+#endif // __LZ_H__
@@ -0,0 +1,215 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "mirror.h"
+#include "protocol.h"
+#include "serialhandler.h"
+#include "softtimer.h"
+#include "uui.h"
+#include "opendps.h"
+
+/** Commands collected until the next flush, a bulk frame's worth */
+#define MIRROR_BUFFER_SIZE  (MAX_BULK_FRAME_LENGTH - 2)
+
+static bool enabled;
+/** The redraw starting mirroring waits for the first flush, so the host gets
+  * the response to cmd_mirror first */
+static bool redraw_pending;
+static uint32_t mute_depth;
+static uint8_t buffer[MIRROR_BUFFER_SIZE];
+static uint32_t length;
+static uint8_t seq;
+static softtimer_t flush_timer;
+
+/**
+  * @brief Send the collected commands
+  * @retval none
+  */
+static void flush(void)
+{
+    if (length) {
+        serial_send_mirror_data(seq++, buffer, length);
+        length = 0;
+    }
+}
+
+/**
+  * @brief Flush the collected commands, run every CONFIG_MIRROR_FLUSH_MS
+  * @param timer the flush timer
+  * @retval none
+  */
+static void flush_tick(softtimer_t *timer)
+{
+    (void) timer;
+    if (redraw_pending) {
+        redraw_pending = false;
+        opendps_redraw();
+    }
+    flush();
+}
+
+/**
+  * @brief Make room for a command, flushing if it does not fit
+  * @param size size of the command
+  * @retval pointer to where the command is to be written, or NULL if the
+  *         operation is not mirrored
+  */
+static uint8_t *reserve(uint32_t size)
+{
+    if (!enabled || mute_depth) {
+        return 0;
+    }
+    if (length + size > MIRROR_BUFFER_SIZE) {
+        flush();
+    }
+    uint8_t *p = &buffer[length];
+    length += size;
+    return p;
+}
+
+/**
+  * @brief Start or stop mirroring, starting redraws the whole display
+  * @param enable true to mirror
+  * @retval none
+  */
+void mirror_enable(bool enable)
+{
+    length = 0;
+    enabled = enable;
+    if (enable) {
+        redraw_pending = true;
+        softtimer_start(&flush_timer, CONFIG_MIRROR_FLUSH_MS, CONFIG_MIRROR_FLUSH_MS, &flush_tick);
+    } else {
+        softtimer_stop(&flush_timer);
+    }
+}
+
+/**
+  * @brief Ignore drawing operations, for the ones making up a glyph
+  * @param mute true to ignore, calls may be nested
+  * @retval none
+  */
+void mirror_mute(bool mute)
+{
+    if (mute) {
+        mute_depth++;
+    } else if (mute_depth) {
+        mute_depth--;
+    }
+}
+
+/**
+  * @brief Mirror a cleared display
+  * @retval none
+  */
+void mirror_clear(void)
+{
+    if (enabled && !mute_depth) {
+        length = 0; /** Anything collected is overdrawn */
+    }
+    uint8_t *p = reserve(1);
+    if (p) {
+        p[0] = mirror_op_clear;
+    }
+}
+
+/**
+  * @brief Mirror a filled area
+  * @param x,y top left corner
+  * @param w,h width and height
+  * @param color in bgr565 format
+  * @retval none
+  */
+void mirror_fill(uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint16_t color)
+{
+    uint8_t *p = reserve(7);
+    if (p) {
+        p[0] = mirror_op_fill;
+        p[1] = x;
+        p[2] = y;
+        p[3] = w;
+        p[4] = h;
+        p[5] = color >> 8;
+        p[6] = color;
+    }
+}
+
+/**
+  * @brief Mirror a glyph, see tft_putch()
+  * @param size font size
+  * @param ch the character
+  * @param x,y top left corner of the bounding box
+  * @param w,h width and height of the bounding box
+  * @param highlight true if the glyph is inverted
+  * @retval none
+  */
+void mirror_glyph(uint8_t size, char ch, uint32_t x, uint32_t y, uint32_t w, uint32_t h, bool highlight)
+{
+    uint8_t *p = reserve(8);
+    if (p) {
+        p[0] = mirror_op_glyph;
+        p[1] = size;
+        p[2] = ch;
+        p[3] = x;
+        p[4] = y;
+        p[5] = w;
+        p[6] = h;
+        p[7] = highlight;
+    }
+}
+
+/**
+  * @brief Mirror a blit, only its area is sent
+  * @param x,y top left corner
+  * @param w,h width and height
+  * @retval none
+  */
+void mirror_blit(uint32_t x, uint32_t y, uint32_t w, uint32_t h)
+{
+    uint8_t *p = reserve(5);
+    if (p) {
+        p[0] = mirror_op_blit;
+        p[1] = x;
+        p[2] = y;
+        p[3] = w;
+        p[4] = h;
+    }
+}
+
+/**
+  * @brief Mirror display inversion
+  * @param invert true if inverted
+  * @retval none
+  */
+void mirror_invert(bool invert)
+{
+    uint8_t *p = reserve(2);
+    if (p) {
+        p[0] = mirror_op_invert;
+        p[1] = invert;
+    }
+}
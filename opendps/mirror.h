@@ -0,0 +1,95 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __MIRROR_H__
+#define __MIRROR_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** The drawing operations are sent to the host as compact commands, glyphs
+  * by font size and character rather than by their pixels. Graphics (icons,
+  * the logo) are sent as their bounding box only */
+
+/** Interval at which collected commands are sent */
+#ifndef CONFIG_MIRROR_FLUSH_MS
+ #define CONFIG_MIRROR_FLUSH_MS  (50)
+#endif
+
+/**
+  * @brief Start or stop mirroring, starting redraws the whole display
+  * @param enable true to mirror
+  * @retval none
+  */
+void mirror_enable(bool enable);
+
+/**
+  * @brief Ignore drawing operations, for the ones making up a glyph
+  * @param mute true to ignore, calls may be nested
+  * @retval none
+  */
+void mirror_mute(bool mute);
+
+/**
+  * @brief Mirror a cleared display
+  * @retval none
+  */
+void mirror_clear(void);
+
+/**
+  * @brief Mirror a filled area
+  * @param x,y top left corner
+  * @param w,h width and height
+  * @param color in bgr565 format
+  * @retval none
+  */
+void mirror_fill(uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint16_t color);
+
+/**
+  * @brief Mirror a glyph, see tft_putch()
+  * @param size font size
+  * @param ch the character
+  * @param x,y top left corner of the bounding box
+  * @param w,h width and height of the bounding box
+  * @param highlight true if the glyph is inverted
+  * @retval none
+  */
+void mirror_glyph(uint8_t size, char ch, uint32_t x, uint32_t y, uint32_t w, uint32_t h, bool highlight);
+
+/**
+  * @brief Mirror a blit, only its area is sent
+  * @param x,y top left corner
+  * @param w,h width and height
+  * @retval none
+  */
+void mirror_blit(uint32_t x, uint32_t y, uint32_t w, uint32_t h);
+
+/**
+  * @brief Mirror display inversion
+  * @param invert true if inverted
+  * @retval none
+  */
+void mirror_invert(bool invert);
+
+#endif // __MIRROR_H__
@@ -50,6 +50,10 @@
 #include "gpio.h"
 #include "past.h"
 #include "pastunits.h"
+#include "energy.h"
+#include "bootcom.h"
+#include "adc_scan.h"
+#include "softtimer.h"
 #include "uui.h"
 #include "uui_number.h"
 #include "opendps.h"
@@ -58,6 +62,42 @@
 #ifdef CONFIG_CC_ENABLE
 #include "func_cc.h"
 #endif // CONFIG_CC_ENABLE
+#ifdef CONFIG_SEQ_ENABLE
+#include "func_seq.h"
+#endif // CONFIG_SEQ_ENABLE
+#ifdef CONFIG_CP_ENABLE
+#include "func_cp.h"
+#endif // CONFIG_CP_ENABLE
+#ifdef CONFIG_CR_ENABLE
+#include "func_cr.h"
+#endif // CONFIG_CR_ENABLE
+#ifdef CONFIG_CHG_ENABLE
+#include "func_chg.h"
+#endif // CONFIG_CHG_ENABLE
+#ifdef CONFIG_THERMAL
+#include "thermal.h"
+#endif // CONFIG_THERMAL
+#ifdef CONFIG_BROWNOUT
+#include "brownout.h"
+#endif // CONFIG_BROWNOUT
+#ifdef CONFIG_WATCHDOG
+#include "watchdog.h"
+#endif // CONFIG_WATCHDOG
+#ifdef CONFIG_STACK_WATERMARK
+#include "stack.h"
+#endif // CONFIG_STACK_WATERMARK
+#ifdef CONFIG_PAST_TRANSFER
+#include "crc16.h"
+#endif // CONFIG_PAST_TRANSFER
+#ifdef CONFIG_STATS
+#include "stats.h"
+#endif // CONFIG_STATS
+#ifdef CONFIG_ALARMS
+#include "alarm.h"
+#endif // CONFIG_ALARMS
+#ifdef CONFIG_HISTOGRAM
+#include "histogram.h"
+#endif // CONFIG_HISTOGRAM
 
 #ifdef DPS_EMULATOR
 #include "dpsemul.h"
@@ -66,8 +106,15 @@
 #define TFT_HEIGHT  (128)
 #define TFT_WIDTH   (128)
 
-/** How ofter we update the measurements in the UI (ms) */
-#define UI_UPDATE_INTERVAL_MS  (250)
+/** How often we update the measurements in the UI (ms). The fast rate is
+  * used while the dial is turned or the readings move, the slow one once
+  * they have been steady for UI_FAST_HOLD_MS. */
+#define UI_FAST_INTERVAL_MS   (50)
+#define UI_SLOW_INTERVAL_MS  (500)
+#define UI_FAST_HOLD_MS     (1000)
+
+/** Change of a decimated ADC reading, in raw counts, that counts as moving */
+#define UI_CHANGE_THRESHOLD  (2)
 
 /** Timeout for waiting for wifi connction (ms) */
 #define WIFI_CONNECT_TIMEOUT  (10000)
@@ -85,7 +132,23 @@
 #define TFT_FLASHING_PERIOD               (100)
 #define TFT_FLASHING_COUNTER                (2)
 
+#ifndef DPS_EMULATOR
+/** Linker file symbols */
+extern uint32_t *_past_start;
+extern uint32_t *_past_end;
+#endif // DPS_EMULATOR
+
 static void ui_flash(void);
+static void lock_flash_tick(softtimer_t *timer);
+static void ui_tick(softtimer_t *timer);
+static void ui_speed_up(void);
+static void i_offset_tick(softtimer_t *timer);
+#ifdef CONFIG_PAST_WRITE_BACK
+static void past_flush_tick(softtimer_t *timer);
+#endif // CONFIG_PAST_WRITE_BACK
+#ifdef CONFIG_PAST_INCREMENTAL_GC
+static void past_gc_tick(softtimer_t *timer);
+#endif // CONFIG_PAST_INCREMENTAL_GC
 static void read_past_settings(void);
 static void write_past_settings(void);
 static void check_master_reset(void);
@@ -95,19 +158,60 @@ static uint16_t bg_color;
 static uint32_t ui_width;
 static uint32_t ui_height;
 
+/** Periodic UI updates */
+static softtimer_t ui_timer;
+/** The ADC readings of the previous UI tick, and the tick until when the UI
+  * is refreshed at the fast rate */
+static uint16_t ui_last_raw[3];
+static uint64_t ui_fast_until;
+
 /** Used to make the screen flash */
-static uint32_t tft_flashing_period;
+static softtimer_t tft_flash_timer;
 static uint32_t tft_flash_counter;
 
 /** Used for flashing the wifi icon */
-static uint32_t wifi_status_flashing_period;
+static softtimer_t wifi_flash_timer;
+static softtimer_t wifi_connect_timer;
 static bool wifi_status_visible;
 
+#ifdef CONFIG_PAST_WRITE_BACK
+/** Flushes the past write-back cache after a quiet period */
+static softtimer_t past_flush_timer;
+#endif // CONFIG_PAST_WRITE_BACK
+
+#ifdef CONFIG_PAST_INCREMENTAL_GC
+/** Runs the past garbage collection in the background */
+static softtimer_t past_gc_timer;
+#endif // CONFIG_PAST_INCREMENTAL_GC
+
+/** The I_out offset as stored in past, tagged with the V_in it was measured
+  * at */
+typedef struct {
+    int32_t offset;
+    uint32_t v_in_mv;
+} i_offset_record_t;
+
+#ifndef CONFIG_I_OFFSET_TOLERANCE
+ #define CONFIG_I_OFFSET_TOLERANCE  (2)
+#endif // CONFIG_I_OFFSET_TOLERANCE
+#ifndef CONFIG_I_OFFSET_V_IN_TOLERANCE_MV
+ #define CONFIG_I_OFFSET_V_IN_TOLERANCE_MV  (1000)
+#endif // CONFIG_I_OFFSET_V_IN_TOLERANCE_MV
+
+/** Waits for the I_out offset measurement to store the result */
+static softtimer_t i_offset_timer;
+static i_offset_record_t i_offset_stored;
+static bool i_offset_stored_valid;
+
 /** Used for flashing the lock icon */
-static uint32_t lock_flashing_period;
+static softtimer_t lock_flash_timer;
 static bool lock_visible;
 static uint32_t lock_flash_counter;
 
+/** The parameter values before a set, put back if one of the set fails */
+static int32_t param_snapshot[MAX_PARAMETERS];
+static uint32_t param_snapshot_mask;
+
 /** Current icon settings */
 static wifi_status_t wifi_status;
 static bool is_locked;
@@ -161,13 +265,64 @@ ui_number_t input_voltage = {
 };
 
 /* This is the screen definition */
-ui_screen_t main_screen = {
+static const ui_screen_desc_t main_desc = {
     .name = "main",
     .tick = &main_ui_tick,
     .num_items = 1,
     .items = { (ui_item_t*) &input_voltage }
 };
 
+ui_screen_t main_screen = {
+    .desc = &main_desc
+};
+
+#ifdef CONFIG_STATS
+/** The statistics UI, shown instead of the function UI */
+static uui_t stats_ui;
+static bool stats_visible;
+
+static void stats_ui_tick(void);
+
+/** The fonts have no letters, the rows are mean, peak to peak and ripple
+  * (AC RMS) with V_out to the left and I_out to the right */
+#define STATS_ITEM(_id, _x, _y, _digits, _decimals, _unit) \
+    { \
+        { \
+            .type = ui_item_number, \
+            .id = _id, \
+            .x = _x, \
+            .y = _y, \
+            .can_focus = false, \
+        }, \
+        .font_size = 18, \
+        .num_digits = _digits, \
+        .num_decimals = _decimals, \
+        .unit = _unit, \
+    }
+
+static ui_number_t stats_items[] = {
+    STATS_ITEM(20,  60, 10, 2, 2, unit_volt),   /** V_out mean, 10mV */
+    STATS_ITEM(21,  60, 40, 1, 3, unit_volt),   /** V_out peak to peak, mV */
+    STATS_ITEM(22,  60, 70, 1, 3, unit_volt),   /** V_out ripple, mV */
+    STATS_ITEM(23, 124, 10, 1, 3, unit_ampere), /** I_out mean, mA */
+    STATS_ITEM(24, 124, 40, 1, 3, unit_ampere), /** I_out peak to peak, mA */
+    STATS_ITEM(25, 124, 70, 1, 3, unit_ampere), /** I_out ripple, mA */
+};
+
+static const ui_screen_desc_t stats_desc = {
+    .name = "stats",
+    .tick = &stats_ui_tick,
+    .num_items = 6,
+    .items = { (ui_item_t*) &stats_items[0], (ui_item_t*) &stats_items[1],
+               (ui_item_t*) &stats_items[2], (ui_item_t*) &stats_items[3],
+               (ui_item_t*) &stats_items[4], (ui_item_t*) &stats_items[5] }
+};
+
+static ui_screen_t stats_screen = {
+    .desc = &stats_desc
+};
+#endif // CONFIG_STATS
+
 /**
  * @brief      List function names of device
  *
@@ -180,7 +335,7 @@ uint32_t opendps_get_function_names(char* names[], size_t size)
 {
     uint32_t i;
     for (i = 0; i < func_ui.num_screens && i < size; i++) {
-        names[i] = func_ui.screens[i]->name;
+        names[i] = (char*) func_ui.screens[i]->desc->name;
     }
     return i;
 }
@@ -192,7 +347,18 @@ uint32_t opendps_get_function_names(char* names[], size_t size)
  */
 const char* opendps_get_curr_function_name(void)
 {
-    return (const char*) func_ui.screens[func_ui.cur_screen]->name;
+    return func_ui.screens[func_ui.cur_screen]->desc->name;
+}
+
+/**
+ * @brief      Get current function index
+ *
+ * @return     Index of the current function as listed by
+ *             opendps_get_function_names()
+ */
+uint32_t opendps_get_curr_function_idx(void)
+{
+    return func_ui.cur_screen;
 }
 
 /**
@@ -202,14 +368,11 @@ const char* opendps_get_curr_function_name(void)
  *
  * @return     Number of items returned
  */
-uint32_t opendps_get_curr_function_params(ui_parameter_t **parameters)
+uint32_t opendps_get_curr_function_params(const ui_parameter_t **parameters)
 {
-    uint32_t i = 0;
-    *parameters = (ui_parameter_t*) &func_ui.screens[func_ui.cur_screen]->parameters;
-    while ((*parameters)[i].name[0] != 0) {
-        i++;
-    }
-    return i;
+    ui_screen_t *screen = func_ui.screens[func_ui.cur_screen];
+    *parameters = screen->desc->parameters;
+    return uui_num_parameters(screen);
 }
 
 /**
@@ -223,14 +386,77 @@ uint32_t opendps_get_curr_function_params(ui_parameter_t **parameters)
  */
 bool opendps_get_curr_function_param_value(char *name, char *value, uint32_t value_len)
 {
-    if (func_ui.screens[func_ui.cur_screen]->get_parameter) {
-        return ps_ok == func_ui.screens[func_ui.cur_screen]->get_parameter(name, value, value_len);
+    ui_screen_t *screen = func_ui.screens[func_ui.cur_screen];
+    if (screen->desc->enable && uui_get_protection(screen, name, value, value_len) == ps_ok) {
+        return true;
+    }
+    if (screen->desc->get_parameter) {
+        return ps_ok == screen->desc->get_parameter(name, value, value_len);
     }
     return false;
 }
 
 /**
- * @brief      Set parameter to value
+ * @brief      Start setting parameters, remembering the current values
+ */
+void opendps_begin_parameters(void)
+{
+    param_snapshot_mask = 0;
+    for (uint32_t id = 0; id < MAX_PARAMETERS; id++) {
+        if (opendps_get_parameter_value(id, &param_snapshot[id])) {
+            param_snapshot_mask |= 1 << id;
+        }
+    }
+}
+
+/**
+ * @brief      Apply the parameters set since opendps_begin_parameters(), or
+ *             none of them if one failed
+ *
+ * @param      stats  Status of each parameter set, the ps_ok ones become
+ *                    ps_not_applied if another failed
+ * @param[in]  count  Number of parameters set
+ *
+ * @return     true if the parameters were applied
+ */
+bool opendps_commit_parameters(set_param_status_t *stats, uint32_t count)
+{
+    ui_screen_t *screen = func_ui.screens[func_ui.cur_screen];
+    for (uint32_t i = 0; i < count; i++) {
+        if (stats[i] != ps_ok) {
+            /** Nothing has reached the output, put the old values back */
+            for (uint32_t id = 0; id < MAX_PARAMETERS; id++) {
+                if (param_snapshot_mask & (1 << id)) {
+                    (void) opendps_set_parameter_value(id, param_snapshot[id]);
+                }
+            }
+            for (i = 0; i < count; i++) {
+                if (stats[i] == ps_ok) {
+                    stats[i] = ps_not_applied;
+                }
+            }
+            return false;
+        }
+    }
+    if (!count) {
+        return true;
+    }
+    /** One output update, one persist and one redraw of what changed */
+    if (screen->desc->apply_parameters) {
+        screen->desc->apply_parameters();
+    }
+    if (screen->desc->enable && screen->is_enabled) {
+        uui_apply_protection(screen);
+        if (screen->desc->past_save) {
+            screen->desc->past_save(&g_past);
+        }
+    }
+    uui_refresh(&func_ui, false);
+    return true;
+}
+
+/**
+ * @brief      Set parameter to value, applied by opendps_commit_parameters()
  *
  * @param      name   Name of parameter
  * @param      value  Value as a string
@@ -240,15 +466,77 @@ bool opendps_get_curr_function_param_value(char *name, char *value, uint32_t val
 set_param_status_t opendps_set_parameter(char *name, char *value)
 {
     set_param_status_t status = ps_not_supported;
-    if (func_ui.screens[func_ui.cur_screen]->set_parameter) {
-        status = func_ui.screens[func_ui.cur_screen]->set_parameter(name, value);
-        if (status == ps_ok) {
-            uui_refresh(&func_ui, true);
+    ui_screen_t *screen = func_ui.screens[func_ui.cur_screen];
+    if (screen->desc->enable) {
+        /** Every function controlling power out has the protection limits */
+        status = uui_set_protection(screen, name, value);
+        if (status != ps_unknown_name) {
+            return status;
         }
+        status = ps_not_supported;
+    }
+    if (screen->desc->set_parameter) {
+        status = screen->desc->set_parameter(name, value);
     }
     return status;
 }
 
+/**
+ * @brief      Set parameter to value, the binary form of
+ *             opendps_set_parameter(), applied by opendps_commit_parameters()
+ *
+ * @param[in]  id     Index of the parameter in the cmd_list_parameters order
+ * @param[in]  value  Value in the unit of the parameter
+ *
+ * @return     Status of the operation
+ */
+set_param_status_t opendps_set_parameter_value(uint32_t id, int32_t value)
+{
+    set_param_status_t status = ps_not_supported;
+    ui_screen_t *screen = func_ui.screens[func_ui.cur_screen];
+    if (id >= uui_num_parameters(screen)) {
+        return ps_unknown_name;
+    }
+    if (screen->desc->enable) {
+        pwrctl_protection_t prot = uui_find_protection(screen->desc->parameters[id].name);
+        if (prot != prot_max) {
+            return uui_set_protection_value(screen, prot, value);
+        }
+    }
+    if (screen->desc->set_parameter_value) {
+        status = screen->desc->set_parameter_value(id, value);
+    }
+    return status;
+}
+
+/**
+ * @brief      Get the value of a parameter, the binary form of
+ *             opendps_get_curr_function_param_value()
+ *
+ * @param[in]  id     Index of the parameter in the cmd_list_parameters order
+ * @param      value  The value is stored here
+ *
+ * @return     true if the parameter exists and could be read
+ */
+bool opendps_get_parameter_value(uint32_t id, int32_t *value)
+{
+    ui_screen_t *screen = func_ui.screens[func_ui.cur_screen];
+    if (id >= uui_num_parameters(screen)) {
+        return false;
+    }
+    if (screen->desc->enable) {
+        pwrctl_protection_t prot = uui_find_protection(screen->desc->parameters[id].name);
+        if (prot != prot_max) {
+            *value = screen->protection[prot];
+            return true;
+        }
+    }
+    if (screen->desc->get_parameter_value) {
+        return ps_ok == screen->desc->get_parameter_value(id, value);
+    }
+    return false;
+}
+
 /**
  * @brief      Enable output of current function
  *
@@ -258,7 +546,7 @@ set_param_status_t opendps_set_parameter(char *name, char *value)
  */
 bool opendps_enable_output(bool enable)
 {
-    if (!is_temperature_locked && func_ui.screens[func_ui.cur_screen]->enable) {
+    if (!is_temperature_locked && func_ui.screens[func_ui.cur_screen]->desc->enable) {
         if (func_ui.screens[func_ui.cur_screen]->is_enabled != enable) {
             event_put(event_button_enable, press_short); /** @todo: call directly as this will not work for temperature alarm */
         }
@@ -288,10 +576,57 @@ static void main_ui_tick(void)
     hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
     (void) i_out_raw;
     (void) v_out_raw;
-    input_voltage.value = pwrctl_calc_vin(v_in_raw) / 100;
-    input_voltage.ui.draw(&input_voltage.ui);
+    number_set_value(&input_voltage, pwrctl_calc_vin(v_in_raw) / 100);
+}
+
+#ifdef CONFIG_STATS
+/**
+  * @brief Clamp a statistics value to what a number item can show
+  * @param value the value
+  * @retval the value, at most 9999
+  */
+static int16_t stats_clamp(uint32_t value)
+{
+    return value > 9999 ? 9999 : value;
 }
 
+/**
+  * @brief Update the statistics screen
+  * @retval none
+  */
+static void stats_ui_tick(void)
+{
+    stats_t stats[stats_max];
+    if (!stats_get(stats)) {
+        return;
+    }
+    number_set_value(&stats_items[0], stats_clamp(stats[stats_v_out].mean / 10));
+    number_set_value(&stats_items[1], stats_clamp(stats[stats_v_out].max - stats[stats_v_out].min));
+    number_set_value(&stats_items[2], stats_clamp(stats[stats_v_out].ac_rms / 1000));
+    number_set_value(&stats_items[3], stats_clamp(stats[stats_i_out].mean));
+    number_set_value(&stats_items[4], stats_clamp(stats[stats_i_out].max - stats[stats_i_out].min));
+    number_set_value(&stats_items[5], stats_clamp(stats[stats_i_out].ac_rms / 1000));
+}
+
+/**
+  * @brief Show the statistics screen in place of the function screen
+  * @param show true to show the statistics, false for the function screen
+  * @retval none
+  */
+static void show_stats(bool show)
+{
+    if (stats_visible == show) {
+        return;
+    }
+    stats_visible = show;
+    uui_show(&func_ui, !show);
+    uui_show(&stats_ui, show);
+    if (!is_temperature_locked) {
+        opendps_redraw();
+    }
+}
+#endif // CONFIG_STATS
+
 /**
   * @brief Initialize the UI
   * @retval none
@@ -308,6 +643,18 @@ static void ui_init(void)
 #else
     func_cv_init(&func_ui);
 #endif // CONFIG_CC_ENABLE
+#ifdef CONFIG_SEQ_ENABLE
+    func_seq_init(&func_ui);
+#endif // CONFIG_SEQ_ENABLE
+#ifdef CONFIG_CP_ENABLE
+    func_cp_init(&func_ui);
+#endif // CONFIG_CP_ENABLE
+#ifdef CONFIG_CR_ENABLE
+    func_cr_init(&func_ui);
+#endif // CONFIG_CR_ENABLE
+#ifdef CONFIG_CHG_ENABLE
+    func_chg_init(&func_ui);
+#endif // CONFIG_CHG_ENABLE
     uui_activate(&func_ui);
 
     uui_init(&main_ui, &g_past);
@@ -316,6 +663,16 @@ static void ui_init(void)
     input_voltage.ui.y = ui_height - font_18_height;
     uui_add_screen(&main_ui, &main_screen);
     uui_activate(&main_ui);
+
+#ifdef CONFIG_STATS
+    uui_init(&stats_ui, &g_past);
+    for (uint32_t i = 0; i < sizeof(stats_items) / sizeof(stats_items[0]); i++) {
+        number_init(&stats_items[i]);
+    }
+    uui_add_screen(&stats_ui, &stats_screen);
+    uui_show(&stats_ui, false);
+    uui_activate(&stats_ui);
+#endif // CONFIG_STATS
 }
 
 /**
@@ -330,8 +687,14 @@ static void ui_hande_event(event_t event, uint8_t data)
         opendps_lock(!is_locked);
         return;
     } else if (event == event_button_sel && data == press_long) {
+#ifdef CONFIG_STATS
+        /** Shows the statistics screen instead of inverting the display,
+          * ENABLE is left to switch the output */
+        show_stats(!stats_visible);
+#else
         tft_invert(!tft_is_inverted());
         write_past_settings();
+#endif // CONFIG_STATS
         return;
     }
 
@@ -344,8 +707,10 @@ static void ui_hande_event(event_t event, uint8_t data)
             case event_rot_left:
             case event_rot_right:
             case event_button_enable:
-                lock_flashing_period = LOCK_FLASHING_PERIOD;
                 lock_flash_counter = LOCK_FLASHING_COUNTER;
+                if (!softtimer_is_active(&lock_flash_timer)) {
+                    softtimer_start(&lock_flash_timer, LOCK_FLASHING_PERIOD, LOCK_FLASHING_PERIOD, &lock_flash_tick);
+                }
                 return;
             default:
                 break;
@@ -361,13 +726,45 @@ static void ui_hande_event(event_t event, uint8_t data)
                 (void) v_in_raw;
                 (void) v_out_raw;
                 uint16_t trig = hw_get_itrig_ma();
-                dbg_printf("%10u OCP: trig:%umA limit:%umA cur:%umA\n", (uint32_t) (get_ticks()), pwrctl_calc_iout(trig), pwrctl_calc_iout(pwrctl_i_limit_raw), pwrctl_calc_iout(i_out_raw));
+                dbg_printf("%10u OCP: trig:%umA limit:%umA cur:%umA\n", (uint32_t) (get_ticks()), pwrctl_calc_iout(trig << HW_ADC_FRAC_BITS), pwrctl_calc_iout(pwrctl_i_limit_raw << HW_ADC_FRAC_BITS), pwrctl_calc_iout(i_out_raw));
 #endif // CONFIG_OCP_DEBUGGING
+#ifdef CONFIG_SERIAL_PROTOCOL
+                serial_send_ocp_event(pwrctl_calc_iout(hw_get_itrig_ma() << HW_ADC_FRAC_BITS));
+#endif // CONFIG_SERIAL_PROTOCOL
                 ui_flash(); /** @todo When OCP kicks in, show last I_out on screen */
                 opendps_update_power_status(false);
                 uui_handle_screen_event(&func_ui, event);
             }
             break;
+        case event_ovp:
+        case event_opp:
+            {
+                pwrctl_protection_t prot = event == event_ovp ? prot_ovp : prot_opp;
+                uint16_t i_out_raw, v_out_raw;
+                hw_get_prot_trig(&i_out_raw, &v_out_raw);
+                uint32_t v_out = pwrctl_calc_vout(v_out_raw << HW_ADC_FRAC_BITS);
+                uint32_t value = prot == prot_ovp ? v_out : v_out * pwrctl_calc_iout(i_out_raw << HW_ADC_FRAC_BITS) / 1000;
+                (void) value;
+#ifdef CONFIG_OCP_DEBUGGING
+                dbg_printf("%10u %s: trig:%u limit:%u\n", (uint32_t) (get_ticks()), prot == prot_ovp ? "OVP" : "OPP", value, pwrctl_get_protection(prot));
+#endif // CONFIG_OCP_DEBUGGING
+#ifdef CONFIG_SERIAL_PROTOCOL
+                serial_send_protection_event(prot, value);
+#endif // CONFIG_SERIAL_PROTOCOL
+                ui_flash();
+                opendps_update_power_status(false);
+                uui_handle_screen_event(&func_ui, event);
+            }
+            break;
+#ifdef CONFIG_BROWNOUT
+        case event_brownout:
+            if (data) {
+                /** Power out was disabled by the brownout check */
+                opendps_update_power_status(false);
+                uui_handle_screen_event(&func_ui, event);
+            }
+            break;
+#endif // CONFIG_BROWNOUT
         case event_button_enable:
             write_past_settings();
             /** Deliberate fallthrough */
@@ -376,11 +773,31 @@ static void ui_hande_event(event_t event, uint8_t data)
         case event_button_m2:
         case event_button_sel:
         case event_rot_press:
+#ifdef CONFIG_STATS
+            if (stats_visible && event != event_button_enable) {
+                /** Any button but ENABLE goes back to the function screen */
+                show_stats(false);
+                break;
+            }
+#endif // CONFIG_STATS
+            uui_handle_screen_event(&func_ui, event);
+            uui_refresh(&func_ui, false);
+            break;
         case event_rot_left:
         case event_rot_right:
         case event_rot_left_set:
         case event_rot_right_set:
-            uui_handle_screen_event(&func_ui, event);
+#ifdef CONFIG_STATS
+            if (stats_visible) {
+                show_stats(false);
+                break;
+            }
+#endif // CONFIG_STATS
+            /** Coalesced steps, one redraw for all of them */
+            ui_speed_up();
+            for (uint32_t i = 0; i < data; i++) {
+                uui_handle_screen_event(&func_ui, event);
+            }
             uui_refresh(&func_ui, false);
             break;
         default:
@@ -397,10 +814,10 @@ void opendps_lock(bool lock)
 {
     if (is_locked != lock) {
         is_locked = lock;
-        lock_flashing_period = 0;
+        softtimer_stop(&lock_flash_timer);
         if (is_locked) {
             lock_visible = true;
-            tft_blit((uint16_t*) padlock, padlock_width, padlock_height, XPOS_LOCK, ui_height-padlock_height);
+            tft_blit_packed(padlock, padlock_palette, padlock_width, padlock_height, XPOS_LOCK, ui_height-padlock_height, false);
         } else {
             lock_visible = false;
             tft_fill(XPOS_LOCK, ui_height-padlock_height, padlock_width, padlock_height, bg_color);
@@ -408,6 +825,15 @@ void opendps_lock(bool lock)
     }
 }
 
+/**
+  * @brief Check if the UI is locked
+  * @retval true if the UI is locked
+  */
+bool opendps_is_locked(void)
+{
+    return is_locked;
+}
+
 /**
   * @brief Lock or unlock the UI due to a temperature alarm
   * @param lock true for lock, false for unlock
@@ -417,6 +843,7 @@ void opendps_temperature_lock(bool lock)
 {
     if (is_temperature_locked != lock) {
         is_temperature_locked = lock;
+        tft_frame_begin();
         if (is_temperature_locked) {
             emu_printf("DPS disabled due to temperature\n");
             /** @todo Right now we cannot use opendps_enable_output here */
@@ -424,37 +851,113 @@ void opendps_temperature_lock(bool lock)
             tft_clear();
             uui_show(&func_ui, false);
             uui_show(&main_ui, false);
-            tft_blit((uint16_t*) thermometer, thermometer_width, thermometer_height, 1+(ui_width-thermometer_width)/2, 30);
+#ifdef CONFIG_STATS
+            uui_show(&stats_ui, false);
+#endif // CONFIG_STATS
+            tft_blit_packed(thermometer, thermometer_palette, thermometer_width, thermometer_height, 1+(ui_width-thermometer_width)/2, 30, false);
         } else {
             emu_printf("DPS enabled due to temperature\n");
             tft_clear();
+#ifdef CONFIG_STATS
+            uui_show(&func_ui, !stats_visible);
+            uui_show(&stats_ui, stats_visible);
+            uui_refresh(&stats_ui, true);
+#else
             uui_show(&func_ui, true);
+#endif // CONFIG_STATS
             uui_show(&main_ui, true);
             uui_refresh(&func_ui, true);
             uui_refresh(&main_ui, true);
         }
+        tft_frame_end();
+#ifdef CONFIG_SERIAL_PROTOCOL
+        serial_send_temperature_event(is_temperature_locked, temp1, temp2);
+#endif // CONFIG_SERIAL_PROTOCOL
     }
 }
 
 /**
-  * @brief Do periodical updates in the UI
+  * @brief Redraw the whole display
   * @retval none
   */
-static void ui_tick(void)
+void opendps_redraw(void)
 {
-    static uint64_t last_wifi_update = 0;
-    static uint64_t last_tft_flash = 0;
-    static uint64_t last_lock_flash = 0;
+    tft_frame_begin();
+    tft_clear();
+    if (is_temperature_locked) {
+        tft_blit_packed(thermometer, thermometer_palette, thermometer_width, thermometer_height, 1+(ui_width-thermometer_width)/2, 30, false);
+    } else {
+        uui_refresh(&func_ui, true);
+        uui_refresh(&main_ui, true);
+#ifdef CONFIG_STATS
+        uui_refresh(&stats_ui, true);
+#endif // CONFIG_STATS
+        if (is_locked && lock_visible) {
+            tft_blit_packed(padlock, padlock_palette, padlock_width, padlock_height, XPOS_LOCK, ui_height-padlock_height, false);
+        }
+        if (wifi_status == wifi_connected) {
+            tft_blit_packed(wifi, wifi_palette, wifi_width, wifi_height, XPOS_WIFI, ui_height-wifi_height, false);
+        }
+        if (is_enabled) {
+            tft_blit_packed(power, power_palette, power_width, power_height, ui_width-power_width, ui_height-power_height, false);
+        }
+    }
+    tft_frame_end();
+}
 
-    static uint64_t last = 0;
-    /** Update on the first call and every UI_UPDATE_INTERVAL_MS ms */
-    if (last > 0 && get_ticks() - last < UI_UPDATE_INTERVAL_MS) {
-        return;
+/**
+  * @brief Keep refreshing the UI at the fast rate for UI_FAST_HOLD_MS
+  * @retval none
+  */
+static void ui_speed_up(void)
+{
+    ui_fast_until = get_ticks() + UI_FAST_HOLD_MS;
+    if (ui_timer.period_ms != UI_FAST_INTERVAL_MS) {
+        softtimer_start(&ui_timer, UI_FAST_INTERVAL_MS, UI_FAST_INTERVAL_MS, &ui_tick);
+    }
+}
+
+/**
+  * @brief Check if any of the decimated ADC readings moved since the
+  *        previous UI tick
+  * @retval true if a reading changed more than UI_CHANGE_THRESHOLD
+  */
+static bool ui_readings_moved(void)
+{
+    uint16_t raw[3];
+    bool moved = false;
+    hw_get_adc_values(&raw[0], &raw[1], &raw[2]);
+    for (uint32_t i = 0; i < 3; i++) {
+        int32_t delta = (int32_t) (raw[i] >> HW_ADC_FRAC_BITS) - (ui_last_raw[i] >> HW_ADC_FRAC_BITS);
+        if (delta > UI_CHANGE_THRESHOLD || delta < -UI_CHANGE_THRESHOLD) {
+            moved = true;
+        }
+        ui_last_raw[i] = raw[i];
     }
+    return moved;
+}
 
-    last = get_ticks();
+/**
+  * @brief Do periodical updates in the UI
+  * @param timer the UI timer
+  * @retval none
+  */
+static void ui_tick(softtimer_t *timer)
+{
+    (void) timer;
+    if (ui_readings_moved()) {
+        ui_speed_up();
+    } else if (get_ticks() >= ui_fast_until && ui_timer.period_ms != UI_SLOW_INTERVAL_MS) {
+        softtimer_start(&ui_timer, UI_SLOW_INTERVAL_MS, UI_SLOW_INTERVAL_MS, &ui_tick);
+    }
+    tft_frame_begin();
     uui_tick(&func_ui);
     uui_tick(&main_ui);
+#ifdef CONFIG_STATS
+    if (stats_visible) {
+        uui_tick(&stats_ui);
+    }
+#endif // CONFIG_STATS
 
 #ifndef CONFIG_SPLASH_SCREEN
     {
@@ -466,49 +969,89 @@ static void ui_tick(void)
         }
     }
 #endif // CONFIG_SPLASH_SCREEN
+    tft_frame_end();
+}
 
-    if (wifi_status_flashing_period > 0 && get_ticks() - last_wifi_update > wifi_status_flashing_period) {
-        last_wifi_update = get_ticks();
-        if (wifi_status_visible) {
-            tft_fill(XPOS_WIFI, ui_height-wifi_height, wifi_width, wifi_height, bg_color);
-        } else {
-            tft_blit((uint16_t*) wifi, wifi_width, wifi_height, XPOS_WIFI, ui_height-wifi_height);
-        }
-        wifi_status_visible = !wifi_status_visible;
+/**
+  * @brief Toggle the wifi icon
+  * @param timer the wifi flash timer
+  * @retval none
+  */
+static void wifi_flash_tick(softtimer_t *timer)
+{
+    (void) timer;
+    if (wifi_status_visible) {
+        tft_fill(XPOS_WIFI, ui_height-wifi_height, wifi_width, wifi_height, bg_color);
+    } else {
+        tft_blit_packed(wifi, wifi_palette, wifi_width, wifi_height, XPOS_WIFI, ui_height-wifi_height, false);
     }
+    wifi_status_visible = !wifi_status_visible;
+}
 
-    if (lock_flashing_period > 0 && get_ticks() - last_lock_flash > lock_flashing_period) {
-        last_lock_flash = get_ticks();
-        lock_visible = !lock_visible;
-        if (lock_visible) {
-            tft_blit((uint16_t*) padlock, padlock_width, padlock_height, XPOS_LOCK, ui_height-padlock_height);
-        } else {
-            tft_fill(XPOS_LOCK, ui_height-padlock_height, padlock_width, padlock_height, bg_color);
-        }
-        lock_flash_counter--;
-        if (lock_flash_counter == 0) {
-            lock_visible = true;
-            /** If the user hammers the locked buttons we might end up with an
-                invisible locking symbol at the end of the flashing */
-            tft_blit((uint16_t*) padlock, padlock_width, padlock_height, XPOS_LOCK, ui_height-padlock_height);
-            lock_flashing_period = 0;
-        }
+/**
+  * @brief Toggle the lock icon until it has flashed LOCK_FLASHING_COUNTER times
+  * @param timer the lock flash timer
+  * @retval none
+  */
+static void lock_flash_tick(softtimer_t *timer)
+{
+    lock_visible = !lock_visible;
+    if (lock_visible) {
+        tft_blit_packed(padlock, padlock_palette, padlock_width, padlock_height, XPOS_LOCK, ui_height-padlock_height, false);
+    } else {
+        tft_fill(XPOS_LOCK, ui_height-padlock_height, padlock_width, padlock_height, bg_color);
+    }
+    lock_flash_counter--;
+    if (lock_flash_counter == 0) {
+        lock_visible = true;
+        /** If the user hammers the locked buttons we might end up with an
+            invisible locking symbol at the end of the flashing */
+        tft_blit_packed(padlock, padlock_palette, padlock_width, padlock_height, XPOS_LOCK, ui_height-padlock_height, false);
+        softtimer_stop(timer);
     }
+}
 
-    if (tft_flashing_period > 0 && get_ticks() - last_tft_flash > tft_flashing_period) {
-        last_tft_flash = get_ticks();
-        tft_flash_counter--;
-        tft_invert(!tft_is_inverted());
-        if (tft_flash_counter == 0) {
-            tft_flashing_period = 0;
-        }
+/**
+  * @brief Invert the TFT until it has flashed TFT_FLASHING_COUNTER times
+  * @param timer the TFT flash timer
+  * @retval none
+  */
+static void tft_flash_tick(softtimer_t *timer)
+{
+    tft_flash_counter--;
+    tft_invert(!tft_is_inverted());
+    if (tft_flash_counter == 0) {
+        softtimer_stop(timer);
     }
+}
 
-    if (wifi_status == wifi_connecting && get_ticks() > WIFI_CONNECT_TIMEOUT) {
+/**
+  * @brief Give up waiting for the wifi connection
+  * @param timer the wifi connect timer
+  * @retval none
+  */
+static void wifi_connect_timeout(softtimer_t *timer)
+{
+    (void) timer;
+    if (wifi_status == wifi_connecting) {
         opendps_update_wifi_status(wifi_off);
     }
 }
 
+/**
+  * @brief Flash the wifi icon
+  * @param period flashing period, 0 to stop flashing
+  * @retval none
+  */
+static void wifi_flash(uint32_t period)
+{
+    if (period) {
+        softtimer_start(&wifi_flash_timer, period, period, &wifi_flash_tick);
+    } else {
+        softtimer_stop(&wifi_flash_timer);
+    }
+}
+
 /**
   * @brief Handle ping
   * @retval none
@@ -529,23 +1072,24 @@ void opendps_update_wifi_status(wifi_status_t status)
         wifi_status = status;
         switch(wifi_status) {
             case wifi_off:
-                wifi_status_flashing_period = 0;
+                wifi_flash(0);
                 wifi_status_visible = true;
                 tft_fill(XPOS_WIFI, ui_height-wifi_height, wifi_width, wifi_height, bg_color);
                 break;
             case wifi_connecting:
-                wifi_status_flashing_period = WIFI_CONNECTING_FLASHING_PERIOD;
+                wifi_flash(WIFI_CONNECTING_FLASHING_PERIOD);
+                softtimer_start(&wifi_connect_timer, WIFI_CONNECT_TIMEOUT, 0, &wifi_connect_timeout);
                 break;
             case wifi_connected:
-                wifi_status_flashing_period = 0;
+                wifi_flash(0);
                 wifi_status_visible = false;
-                tft_blit((uint16_t*) wifi, wifi_width, wifi_height, XPOS_WIFI, ui_height-wifi_height);
+                tft_blit_packed(wifi, wifi_palette, wifi_width, wifi_height, XPOS_WIFI, ui_height-wifi_height, false);
                 break;
             case wifi_error:
-                wifi_status_flashing_period = WIFI_ERROR_FLASHING_PERIOD;
+                wifi_flash(WIFI_ERROR_FLASHING_PERIOD);
                 break;
             case wifi_upgrading:
-                wifi_status_flashing_period = WIFI_UPGRADING_FLASHING_PERIOD;
+                wifi_flash(WIFI_UPGRADING_FLASHING_PERIOD);
                 break;
         }
     }
@@ -561,13 +1105,87 @@ void opendps_update_power_status(bool enabled)
     if (is_enabled != enabled) {
         is_enabled = enabled;
         if (is_enabled) {
-            tft_blit((uint16_t*) power, power_width, power_height, ui_width-power_width, ui_height-power_height);
+            tft_blit_packed(power, power_palette, power_width, power_height, ui_width-power_width, ui_height-power_height, false);
         } else {
             tft_fill(ui_width-power_width, ui_height-power_height, power_width, power_height, bg_color);
+            opendps_flush_past();
         }
     }
 }
 
+/**
+  * @brief Write the settings pending in the past write-back cache to flash
+  * @retval none
+  */
+void opendps_flush_past(void)
+{
+#ifdef CONFIG_PAST_WRITE_BACK
+    softtimer_stop(&past_flush_timer);
+    if (!past_flush(&g_past)) {
+        dbg_printf("Error: past flush failed!\n");
+    }
+#endif // CONFIG_PAST_WRITE_BACK
+}
+
+/**
+  * @brief Store the I_out offset once measured, unless past already has one
+  *        close to it measured at about the same V_in
+  * @param timer the I_out offset timer
+  * @retval none
+  */
+static void i_offset_tick(softtimer_t *timer)
+{
+    int32_t offset;
+    if (adc_scan_i_offset_measuring()) {
+        return;
+    }
+    softtimer_stop(timer);
+    if (!adc_scan_i_offset(&offset)) {
+        return;
+    }
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+    i_offset_record_t record = {
+        .offset = offset,
+        .v_in_mv = pwrctl_calc_vin(v_in_raw),
+    };
+    if (i_offset_stored_valid &&
+        abs(record.offset - i_offset_stored.offset) <= CONFIG_I_OFFSET_TOLERANCE &&
+        abs((int32_t) record.v_in_mv - (int32_t) i_offset_stored.v_in_mv) <= CONFIG_I_OFFSET_V_IN_TOLERANCE_MV) {
+        return;
+    }
+    if (!past_write_unit(&g_past, past_i_out_offset, (void*) &record, sizeof(record))) {
+        /** @todo Handle past write errors */
+        dbg_printf("Error: past write I_out offset failed!\n");
+    }
+}
+
+#ifdef CONFIG_PAST_WRITE_BACK
+/**
+  * @brief Flush the past write-back cache once the UI has been quiet
+  * @param timer the past flush timer
+  * @retval none
+  */
+static void past_flush_tick(softtimer_t *timer)
+{
+    (void) timer;
+    opendps_flush_past();
+}
+#endif // CONFIG_PAST_WRITE_BACK
+
+#ifdef CONFIG_PAST_INCREMENTAL_GC
+/**
+  * @brief Do the next step of the past garbage collection, if one is due
+  * @param timer the past GC timer
+  * @retval none
+  */
+static void past_gc_tick(softtimer_t *timer)
+{
+    (void) timer;
+    (void) past_gc_step(&g_past);
+}
+#endif // CONFIG_PAST_INCREMENTAL_GC
+
 /**
   * @brief Set temperatures
   * @param temp1 first temperature we can deal with
@@ -578,6 +1196,9 @@ void opendps_set_temperature(int16_t _temp1, int16_t _temp2)
 {
     temp1 = _temp1;
     temp2 = _temp2;
+#ifdef CONFIG_THERMAL
+    thermal_report(temp1, temp2);
+#endif // CONFIG_THERMAL
     bool alert = temp1 > shutdown_temperature || temp2 > shutdown_temperature;
     opendps_temperature_lock(alert);
     emu_printf("Got temperature %d and %d %s\n", temp1, temp2, alert ? "[ALERT]" : "");
@@ -599,6 +1220,132 @@ void opendps_get_temperature(int16_t *_temp1, int16_t *_temp2, bool *temp_shutdo
     *temp_shutdown = is_temperature_locked;
 }
 
+/**
+  * @brief Set a calibration table and store it in past
+  * @param table the table
+  * @param points the points of the table
+  * @param count number of points, 0 erases the table
+  * @retval true if the table was valid and stored
+  */
+bool opendps_set_cal_table(pwrctl_cal_table_t table, const pwrctl_cal_point_t *points, uint32_t count)
+{
+    if (!pwrctl_set_cal_table(table, points, count)) {
+        return false;
+    }
+    if (count == 0) {
+        (void) past_erase_unit(&g_past, past_cal_v_out_adc + table);
+        return true;
+    }
+    if (!past_write_unit(&g_past, past_cal_v_out_adc + table, (void*) points, count * sizeof(pwrctl_cal_point_t))) {
+        dbg_printf("Error: past write calibration table failed!\n");
+        return false;
+    }
+    return true;
+}
+
+#ifdef CONFIG_PAST_TRANSFER
+/**
+  * @brief Check if a unit goes into settings transfers, the git hashes, the
+  *        image descriptor and the upgrade marker describe the firmware of
+  *        the device rather than its settings
+  * @param id the unit id
+  * @retval true if the unit is transferred
+  */
+static bool past_transferable(past_id_t id)
+{
+    return id != past_boot_git_hash && id != past_app_git_hash && id != past_upgrade_started &&
+           id != past_app_image && id != past_app_verified;
+}
+
+/**
+  * @brief Copy the part of src found at pos of the export to buf
+  * @retval None
+  */
+static void export_copy(uint32_t pos, const uint8_t *src, uint32_t length, uint32_t offset, uint8_t *buf, uint32_t size, uint32_t *copied)
+{
+    for (uint32_t i = 0; i < length; i++, pos++) {
+        if (pos >= offset && pos < offset + size) {
+            buf[pos - offset] = src[i];
+            (*copied)++;
+        }
+    }
+}
+
+/**
+  * @brief Read a part of the settings export, the transferable units in the
+  *        past unit layout: [id:32] [length:32] [data] [padding], with the
+  *        header words big endian
+  * @param offset where in the export to start
+  * @param buf the bytes are copied here
+  * @param size size of buf
+  * @param total the size of the whole export
+  * @param crc crc16 of the whole export
+  * @retval number of bytes copied
+  */
+uint32_t opendps_past_export(uint32_t offset, uint8_t *buf, uint32_t size, uint32_t *total, uint16_t *crc)
+{
+    static const uint8_t padding[3];
+    uint32_t cursor = 0, pos = 0, copied = 0, length;
+    past_id_t id;
+    const uint8_t *data;
+    uint16_t c = 0;
+    opendps_flush_past();
+    while (past_next_unit(&g_past, &cursor, &id, (const void**) &data, &length)) {
+        if (!past_transferable(id)) {
+            continue;
+        }
+        uint8_t header[8] = {id >> 24, id >> 16, id >> 8, id, length >> 24, length >> 16, length >> 8, length};
+        uint32_t pad = PAST_UNIT_SIZE(length) - sizeof(header) - length;
+        c = crc16_update(c, header, sizeof(header));
+        c = crc16_update(c, data, length);
+        c = crc16_update(c, padding, pad);
+        export_copy(pos, header, sizeof(header), offset, buf, size, &copied);
+        export_copy(pos + sizeof(header), data, length, offset, buf, size, &copied);
+        export_copy(pos + sizeof(header) + length, padding, pad, offset, buf, size, &copied);
+        pos += PAST_UNIT_SIZE(length);
+    }
+    *total = pos;
+    *crc = c;
+    return copied;
+}
+
+/**
+  * @brief Write the units of a settings export in one past transaction,
+  *        either all of them or none. Units not in the export are kept.
+  * @param data the export, word aligned
+  * @param length size of the export
+  * @retval true if the units were written
+  */
+bool opendps_past_import(const uint8_t *data, uint32_t length)
+{
+    uint32_t pos = 0, count = 0;
+    /** Check all records before anything is written */
+    while (pos + 8 <= length) {
+        past_id_t id = (uint32_t) data[pos] << 24 | data[pos + 1] << 16 | data[pos + 2] << 8 | data[pos + 3];
+        uint32_t size = (uint32_t) data[pos + 4] << 24 | data[pos + 5] << 16 | data[pos + 6] << 8 | data[pos + 7];
+        if (id == 0 || id >= 0xfffffffd || !past_transferable(id) || size > length - pos - 8) {
+            return false;
+        }
+        pos += PAST_UNIT_SIZE(size);
+        count++;
+    }
+    if (pos != length || count > PAST_TXN_UNITS) {
+        return false;
+    }
+    opendps_flush_past();
+    if (!past_begin(&g_past, length)) {
+        return false;
+    }
+    for (pos = 0; pos < length; ) {
+        past_id_t id = data[pos] << 24 | data[pos + 1] << 16 | data[pos + 2] << 8 | data[pos + 3];
+        uint32_t size = data[pos + 4] << 24 | data[pos + 5] << 16 | data[pos + 6] << 8 | data[pos + 7];
+        (void) past_write_unit(&g_past, id, (void*) &data[pos + 8], size);
+        pos += PAST_UNIT_SIZE(size);
+    }
+    return past_commit(&g_past);
+}
+#endif // CONFIG_PAST_TRANSFER
+
 #ifdef CONFIG_SPLASH_SCREEN
 /**
   * @brief Draw splash screen
@@ -606,7 +1353,7 @@ void opendps_get_temperature(int16_t *_temp1, int16_t *_temp2, bool *temp_shutdo
   */
 static void ui_draw_splash_screen(void)
 {
-    tft_blit((uint16_t*) logo, logo_width, logo_height, (ui_width-logo_width)/2, (ui_height-logo_height)/2);
+    tft_blit_packed(logo, logo_palette, logo_width, logo_height, (ui_width-logo_width)/2, (ui_height-logo_height)/2, false);
 }
 #endif // CONFIG_SPLASH_SCREEN
 
@@ -616,8 +1363,8 @@ static void ui_draw_splash_screen(void)
   */
 static void ui_flash(void)
 {
-    tft_flashing_period = TFT_FLASHING_PERIOD;
     tft_flash_counter = TFT_FLASHING_COUNTER;
+    softtimer_start(&tft_flash_timer, TFT_FLASHING_PERIOD, TFT_FLASHING_PERIOD, &tft_flash_tick);
 }
 
 /**
@@ -636,6 +1383,34 @@ static void read_past_settings(void)
     }
     tft_invert(inverse_setting);
 
+    /** The I_out offset of the last boot is used until this boot's
+        measurement is done, and replaced in past if it changed */
+    const i_offset_record_t *i_offset = 0;
+    if (past_read_unit(&g_past, past_i_out_offset, (const void**) &i_offset, &length) && length == sizeof(i_offset_record_t)) {
+        i_offset_stored = *i_offset;
+        i_offset_stored_valid = true;
+        adc_scan_seed_i_offset(i_offset_stored.offset);
+    }
+    softtimer_start(&i_offset_timer, 100, 100, &i_offset_tick);
+
+    /** The calibration coefficients are written on first boot so they can be
+        adjusted per unit */
+    const pwrctl_calibration_t *cal = 0;
+    if (past_read_unit(&g_past, past_calibration, (const void**) &cal, &length) && length == sizeof(pwrctl_calibration_t)) {
+        pwrctl_set_calibration(cal);
+    } else if (!past_write_unit(&g_past, past_calibration, (void*) pwrctl_default_calibration(), sizeof(pwrctl_calibration_t))) {
+        /** @todo Handle past write errors */
+        dbg_printf("Error: past write calibration failed!\n");
+    }
+    for (uint32_t table = 0; table < cal_max; table++) {
+        const pwrctl_cal_point_t *points = 0;
+        if (past_read_unit(&g_past, past_cal_v_out_adc + table, (const void**) &points, &length)) {
+            if (!pwrctl_set_cal_table(table, points, length / sizeof(pwrctl_cal_point_t))) {
+                dbg_printf("Error: calibration table %u is invalid\n", table);
+            }
+        }
+    }
+
 #ifdef GIT_VERSION
     /** Update app git hash in past if needed */
     char *ver = 0;
@@ -660,7 +1435,7 @@ static void write_past_settings(void)
     if (tft_is_inverted() != last_tft_inv_setting) {
         last_tft_inv_setting = tft_is_inverted();
         uint32_t setting = last_tft_inv_setting;
-        if (!past_write_unit(&g_past, past_tft_inversion, (void*) &setting, sizeof(setting))) {
+        if (!past_write_unit_deferred(&g_past, past_tft_inversion, (void*) &setting, sizeof(setting))) {
             /** @todo Handle past write errors */
             dbg_printf("Error: past write inv failed!\n");
         }
@@ -692,13 +1467,26 @@ static void event_handler(void)
     while(1) {
         event_t event;
         uint8_t data = 0;
+#ifdef CONFIG_WATCHDOG
+        watchdog_beat(wd_main_loop);
+#endif // CONFIG_WATCHDOG
         if (!event_get(&event, &data)) {
-            hw_longpress_check();
-            ui_tick();
+#ifdef CONFIG_DBG_DEFERRED
+            /** Queued debug prints are sent one at a time, with the event
+              * queue checked in between */
+            if (dbg_flush()) {
+                (void) softtimer_run();
+                continue;
+            }
+#endif // CONFIG_DBG_DEFERRED
+            /** Everything periodic runs on soft timers */
+            hw_idle(softtimer_run());
         } else {
-            if (event) {
+#ifdef DPS_EMULATOR
+            if (event && dps_emul_verbose()) {
                 emu_printf(" Event %d 0x%02x\n", event, data);
             }
+#endif // DPS_EMULATOR
             switch(event) {
                 case event_none:
                     dbg_printf("Weird, should not receive 'none events'\n");
@@ -706,12 +1494,32 @@ static void event_handler(void)
                 case event_uart_rx:
                     serial_handle_rx_char(data);
                     break;
+                case event_uart_rx_ready:
+                    {
+                        uint8_t buf[32];
+                        uint32_t length;
+                        while ((length = hw_uart_rx_get(buf, sizeof(buf))) > 0) {
+                            serial_handle_rx_buffer(buf, length);
+                        }
+                    }
+                    break;
                 case event_ocp:
                     break;
+#ifdef CONFIG_BROWNOUT
+                case event_brownout:
+                    (void) brownout_save();
+                    break;
+#endif // CONFIG_BROWNOUT
                 default:
                     break;
             }
             ui_hande_event(event, data);
+#ifdef CONFIG_PAST_WRITE_BACK
+            if (past_is_dirty(&g_past)) {
+                /** Every event restarts the quiet period */
+                softtimer_start(&past_flush_timer, CONFIG_PAST_FLUSH_DELAY_MS, 0, &past_flush_tick);
+            }
+#endif // CONFIG_PAST_WRITE_BACK
         }
     }
 }
@@ -722,9 +1530,18 @@ static void event_handler(void)
   */
 int main(int argc, char const *argv[])
 {
+#ifdef CONFIG_STACK_WATERMARK
+    stack_paint();
+#endif // CONFIG_STACK_WATERMARK
+    uint32_t magic, offset;
+    /** A warm reboot keeps the I_out offset and skips the splash screen */
+    bool warm_boot = bootcom_get(&magic, &offset) && magic == BOOTCOM_WARM_BOOT;
     hw_init();
     pwrctl_init(); // Must be after DAC init
     event_init();
+    if (warm_boot) {
+        adc_scan_set_i_offset((int32_t) offset);
+    }
 
 #ifdef CONFIG_COMMANDLINE
     dbg_printf("Welcome to OpenDPS!\n");
@@ -734,22 +1551,54 @@ int main(int argc, char const *argv[])
     tft_init();
     delay_ms(50); // Without this delay we will observe some flickering
     tft_clear();
+    hw_adc_start(); // The ADC has stabilised while the TFT was brought up
+    bool past_fits = true;
 #ifdef DPS_EMULATOR
     dps_emul_init(&g_past, argc, argv);
 #else // DPS_EMULATOR
     (void) argc;
     (void) argv;
-    g_past.blocks[0] = 0x0800f800;
-    g_past.blocks[1] = 0x0800fc00;
+    for (uint32_t i = 0; i < PAST_NUM_BLOCKS; i++) {
+        g_past.blocks[i] = (uint32_t) &_past_start + i * PAST_BLOCK_SIZE;
+    }
+    /** A linker script of another PAST_BLOCKS would put blocks beyond the
+      * flash, the past is then left invalid and nothing is stored */
+    past_fits = (uint32_t) &_past_start + PAST_NUM_BLOCKS * PAST_BLOCK_SIZE == (uint32_t) &_past_end;
+    if (!past_fits) {
+        dbg_printf("Error: past area does not match PAST_NUM_BLOCKS!\n");
+    }
 #endif // DPS_EMULATOR
-    if (!past_init(&g_past)) {
+    if (past_fits && !past_init(&g_past)) {
         dbg_printf("Error: past init failed!\n");
         /** @todo Handle past init failure */
     }
 
     check_master_reset();
     read_past_settings();
+    energy_init(&g_past);
+#ifdef CONFIG_STATS
+    stats_init();
+#endif // CONFIG_STATS
+#ifdef CONFIG_HISTOGRAM
+    histogram_init(&g_past);
+#endif // CONFIG_HISTOGRAM
+#ifdef CONFIG_THERMAL
+    thermal_init();
+#endif // CONFIG_THERMAL
+#ifdef CONFIG_BROWNOUT
+    brownout_init(&g_past);
+#endif // CONFIG_BROWNOUT
+#ifdef CONFIG_WATCHDOG
+    watchdog_init();
+#endif // CONFIG_WATCHDOG
+#ifdef CONFIG_PAST_INCREMENTAL_GC
+    softtimer_start(&past_gc_timer, CONFIG_PAST_GC_INTERVAL_MS, CONFIG_PAST_GC_INTERVAL_MS, &past_gc_tick);
+#endif // CONFIG_PAST_INCREMENTAL_GC
     ui_init();
+#ifdef CONFIG_ALARMS
+    /** After the UI, the rules refer to its functions */
+    alarm_init(&g_past);
+#endif // CONFIG_ALARMS
 
 #ifdef CONFIG_WIFI
     /** Rationale: the ESP8266 could send this message when it starts up but
@@ -763,11 +1612,17 @@ int main(int argc, char const *argv[])
 #endif // CONFIG_WIFI
 
 #ifdef CONFIG_SPLASH_SCREEN
-    ui_draw_splash_screen();
-    hw_enable_backlight();
-    delay_ms(750);
-    tft_clear();
+    if (!warm_boot) {
+        ui_draw_splash_screen();
+        hw_enable_backlight();
+        delay_ms(750);
+        tft_clear();
+    } else {
+        hw_enable_backlight();
+    }
 #endif // CONFIG_SPLASH_SCREEN
+    ui_fast_until = get_ticks() + UI_FAST_HOLD_MS;
+    softtimer_start(&ui_timer, 0, UI_FAST_INTERVAL_MS, &ui_tick);
     event_handler();
     return 0;
 }
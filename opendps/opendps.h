@@ -28,6 +28,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "protocol.h"
+#include "pwrctl.h"
 
 /** Max number of parameters to a function */
 #define OPENDPS_MAX_PARAMETERS  (8)
@@ -58,6 +59,14 @@ uint32_t opendps_get_function_names(char* names[], size_t size);
  */
 const char* opendps_get_curr_function_name(void);
 
+/**
+ * @brief      Get current function index
+ *
+ * @return     Index of the current function as listed by
+ *             opendps_get_function_names()
+ */
+uint32_t opendps_get_curr_function_idx(void);
+
 /**
  * @brief      List parameter names of current function
  *
@@ -65,7 +74,7 @@ const char* opendps_get_curr_function_name(void);
  *
  * @return     Number of items returned
  */
-uint32_t opendps_get_curr_function_params(ui_parameter_t **parameters);
+uint32_t opendps_get_curr_function_params(const ui_parameter_t **parameters);
 
 /**
  * @brief      Return value of named parameter for current function 
@@ -79,7 +88,27 @@ uint32_t opendps_get_curr_function_params(ui_parameter_t **parameters);
 bool opendps_get_curr_function_param_value(char *name, char *value, uint32_t value_len);
 
 /**
- * @brief      Set parameter to value
+ * @brief      Start setting parameters. The parameters set with
+ *             opendps_set_parameter() and opendps_set_parameter_value() are
+ *             validated and stored, opendps_commit_parameters() then applies
+ *             all of them in one output update or none of them.
+ */
+void opendps_begin_parameters(void);
+
+/**
+ * @brief      Apply the parameters set since opendps_begin_parameters(), or
+ *             none of them if one failed
+ *
+ * @param      stats  Status of each parameter set, the ps_ok ones become
+ *                    ps_not_applied if another failed
+ * @param[in]  count  Number of parameters set
+ *
+ * @return     true if the parameters were applied
+ */
+bool opendps_commit_parameters(set_param_status_t *stats, uint32_t count);
+
+/**
+ * @brief      Set parameter to value, applied by opendps_commit_parameters()
  *
  * @param      name   Name of parameter
  * @param      value  Value as a string
@@ -88,6 +117,27 @@ bool opendps_get_curr_function_param_value(char *name, char *value, uint32_t val
  */
 set_param_status_t opendps_set_parameter(char *name, char *value);
 
+/**
+ * @brief      Set parameter to value, the binary form of
+ *             opendps_set_parameter(), applied by opendps_commit_parameters()
+ *
+ * @param[in]  id     Index of the parameter in the cmd_list_parameters order
+ * @param[in]  value  Value in the unit of the parameter
+ *
+ * @return     Status of the operation
+ */
+set_param_status_t opendps_set_parameter_value(uint32_t id, int32_t value);
+
+/**
+ * @brief      Get the value of a parameter
+ *
+ * @param[in]  id     Index of the parameter in the cmd_list_parameters order
+ * @param      value  The value is stored here
+ *
+ * @return     true if the parameter exists and could be read
+ */
+bool opendps_get_parameter_value(uint32_t id, int32_t *value);
+
 /**
  * @brief      Enable output of current function
  *
@@ -104,6 +154,13 @@ bool opendps_enable_output(bool enable);
   */
 void opendps_update_power_status(bool enabled);
 
+/**
+  * @brief Write the settings pending in the past write-back cache to flash,
+  *        done when power out is disabled and before rebooting
+  * @retval none
+  */
+void opendps_flush_past(void);
+
 /**
   * @brief Update wifi status icon
   * @param status new wifi status
@@ -124,6 +181,12 @@ void opendps_handle_ping(void);
   */
 void opendps_lock(bool lock);
 
+/**
+  * @brief Check if the UI is locked
+  * @retval true if the UI is locked
+  */
+bool opendps_is_locked(void);
+
 /**
   * @brief Lock or unlock the UI due to a temperature alarm
   * @param lock true for lock, false for unlock
@@ -131,6 +194,12 @@ void opendps_lock(bool lock);
   */
 void opendps_temperature_lock(bool lock);
 
+/**
+  * @brief Redraw the whole display
+  * @retval none
+  */
+void opendps_redraw(void);
+
 /**
   * @brief Set temperatures
   * @param temp1 first temperature we can deal with
@@ -149,4 +218,37 @@ void opendps_set_temperature(int16_t temp1, int16_t temp2);
   */
 void opendps_get_temperature(int16_t *temp1, int16_t *temp2, bool *temp_shutdown);
 
+/**
+  * @brief Set a calibration table and store it in past
+  * @param table the table
+  * @param points the points of the table
+  * @param count number of points, 0 erases the table
+  * @retval true if the table was valid and stored
+  */
+bool opendps_set_cal_table(pwrctl_cal_table_t table, const pwrctl_cal_point_t *points, uint32_t count);
+
+#ifdef CONFIG_PAST_TRANSFER
+/**
+  * @brief Read a part of the settings export, the transferable units in the
+  *        past unit layout: [id:32] [length:32] [data] [padding], with the
+  *        header words big endian
+  * @param offset where in the export to start
+  * @param buf the bytes are copied here
+  * @param size size of buf
+  * @param total the size of the whole export
+  * @param crc crc16 of the whole export
+  * @retval number of bytes copied
+  */
+uint32_t opendps_past_export(uint32_t offset, uint8_t *buf, uint32_t size, uint32_t *total, uint16_t *crc);
+
+/**
+  * @brief Write the units of a settings export in one past transaction,
+  *        either all of them or none. Units not in the export are kept.
+  * @param data the export, word aligned
+  * @param length size of the export
+  * @retval true if the units were written
+  */
+bool opendps_past_import(const uint8_t *data, uint32_t length);
+#endif // CONFIG_PAST_TRANSFER
+
 #endif // __OPENDPS_H__
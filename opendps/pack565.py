@@ -0,0 +1,103 @@
+#!/usr/bin/python
+#
+# Pack bgr565 images (as produced by rgbtobgr565) into 4 bit palette indices
+# with run length encoding, as expanded by tft_blit_packed().
+#
+# The images are grayscale images tinted with a single color so a palette of
+# 16 shades of the tint covers the antialiasing. Each byte of the packed
+# stream is a run:
+#
+#   [run length - 1 (7:4)] [palette index (3:0)]
+#
+# The palette is 16 bgr565 colors in the same byte order as the pixels, ie.
+# ready to be sent on the SPI bus. Index 0 is always black.
+#
+# Usage: pack565.py <name> <tint> < image.565
+#        Prints name_palette[] and name[] as C arrays
+#
+
+import sys
+
+PALETTE_SIZE = 16
+MAX_RUN = 16
+
+# Convert rgb888 to bgr565 exactly as rgbtobgr565 does
+def rgb_to_bgr565(red, green, blue):
+	return int(red * 31.0 / 255.0) | int(green * 63.0 / 255.0) << 5 | int(blue * 31.0 / 255.0) << 11
+
+# Return (red, green, blue) of the tint given as 'rrggbb'
+def parse_tint(tint):
+	return (int(tint[0:2], 16), int(tint[2:4], 16), int(tint[4:6], 16))
+
+# Return the palette for the tint as a list of bgr565 values
+def palette(tint):
+	(r, g, b) = parse_tint(tint)
+	pal = []
+	for i in range(0, PALETTE_SIZE):
+		level = i / float(PALETTE_SIZE - 1)
+		pal.append(rgb_to_bgr565(r * level, g * level, b * level))
+	return pal
+
+# Return the palette index closest to the bgr565 pixel
+def quantize(pixel, tint):
+	(r, g, b) = parse_tint(tint)
+	# Estimate the gray level from the channel carrying most of the tint,
+	# preferring green having the most bits
+	channels = [(g, ((pixel >> 5) & 0x3f) / 63.0), (r, (pixel & 0x1f) / 31.0), (b, ((pixel >> 11) & 0x1f) / 31.0)]
+	(strength, value) = max(channels, key=lambda c: c[0])
+	if strength == 0:
+		return 0
+	level = min(1.0, value * 255.0 / strength)
+	return int(round(level * (PALETTE_SIZE - 1)))
+
+# Pack raw bgr565 bytes (msb first) into a list of run bytes
+def pack(raw, tint):
+	runs = []
+	index = None
+	count = 0
+	for i in range(0, len(raw) - 1, 2):
+		pixel = (bytearray(raw[i:i+1])[0] << 8) | bytearray(raw[i+1:i+2])[0]
+		q = quantize(pixel, tint)
+		if q == index and count < MAX_RUN:
+			count += 1
+		else:
+			if index is not None:
+				runs.append(((count - 1) << 4) | index)
+			index = q
+			count = 1
+	if index is not None:
+		runs.append(((count - 1) << 4) | index)
+	return runs
+
+# Return list of bytes as a C array named name
+def c_array(name, data):
+	lines = ["const uint8_t %s[] = {" % (name)]
+	for i in range(0, len(data), 16):
+		lines.append("  " + ", ".join(["0x%02x" % (b) for b in data[i:i+16]]) + ",")
+	lines.append("};")
+	return "\n".join(lines) + "\n"
+
+# Return the palette as bytes in SPI byte order
+def palette_bytes(tint):
+	data = []
+	for color in palette(tint):
+		data.append((color >> 8) & 0xff)
+		data.append(color & 0xff)
+	return data
+
+def main():
+	if len(sys.argv) != 3:
+		print("Usage: %s <name> <tint> < image.565" % (sys.argv[0]))
+		sys.exit(1)
+	name = sys.argv[1]
+	tint = sys.argv[2]
+	if sys.version_info[0] >= 3:
+		raw = sys.stdin.buffer.read()
+	else:
+		raw = sys.stdin.read()
+	sys.stdout.write(c_array("%s_palette" % (name), palette_bytes(tint)))
+	sys.stdout.write(c_array(name, pack(raw, tint)))
+
+
+if __name__ == "__main__":
+    main()
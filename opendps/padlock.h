@@ -1,28 +1,12 @@
+const uint8_t padlock_palette[] = {
+  0x00, 0x00, 0x10, 0x82, 0x21, 0x04, 0x31, 0x86, 0x42, 0x08, 0x52, 0xaa, 0x63, 0x2c, 0x73, 0xae,
+  0x84, 0x30, 0x94, 0xb2, 0xa5, 0x54, 0xb5, 0xd6, 0xc6, 0x58, 0xd6, 0xda, 0xe7, 0x5c, 0xff, 0xff,
+};
 const uint8_t padlock[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x42, 0x28, 0x9c, 0xf3, 0x9c, 0xf3, 0x42, 0x28,
-  0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x24, 0xbe, 0x17,
-  0xff, 0xff, 0xf7, 0xbe, 0xf7, 0xbe, 0xff, 0xff, 0xbe, 0x17, 0x21, 0x24, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x10, 0x82, 0xce, 0x99, 0xef, 0x7d, 0x63, 0x0c, 0x18, 0xe3, 0x18, 0xe3, 0x63, 0x0c,
-  0xef, 0x7d, 0xce, 0x99, 0x10, 0x82, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x6d, 0xff, 0xff, 0x52, 0x8a,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x8a, 0xff, 0xff, 0x6b, 0x6d, 0x00, 0x00,
-  0x00, 0x00, 0xad, 0x75, 0xdf, 0x1b, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x20, 0xdf, 0x1b, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0xb5, 0xd6, 0xd6, 0xba, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xb5, 0xd6, 0x00, 0x00,
-  0x00, 0x00, 0xb5, 0xb6, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xd6, 0xba, 0xb5, 0xb6, 0x00, 0x00, 0xb5, 0xd6, 0xe7, 0x5c, 0xef, 0x9d, 0xb5, 0xd6,
-  0xb5, 0xd6, 0xb5, 0xd6, 0xb5, 0xd6, 0xb5, 0xd6, 0xb5, 0xd6, 0xef, 0x9d, 0xe7, 0x5c, 0xb5, 0xd6,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+  0x30, 0x04, 0x19, 0x04, 0x50, 0x02, 0x0b, 0x3f, 0x0b, 0x02, 0x20, 0x01, 0x0c, 0x0e, 0x06, 0x12,
+  0x06, 0x0e, 0x0c, 0x01, 0x10, 0x06, 0x0f, 0x05, 0x30, 0x05, 0x0f, 0x06, 0x10, 0x0a, 0x0d, 0x50,
+  0x0d, 0x0a, 0x10, 0x0b, 0x0d, 0x50, 0x0d, 0x0b, 0x10, 0x0b, 0x0d, 0x50, 0x0d, 0x0b, 0x00, 0x0b,
+  0x1e, 0x5b, 0x1e, 0x0b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
 };
 #define padlock_width  12
 #define padlock_height  16
@@ -29,6 +29,7 @@
 #include "past.h"
 #include <flash.h>
 #include "flashlock.h"
+#include "profile.h"
 
 /*
  * Friday the 13th of April: just discovered past gets corrupted when writing
@@ -66,26 +67,47 @@
  * (MWU) on the STM32F100, for which this module is targeted. It adapting this
  * module for eg. STM32F4s, that need to change because of the MWU of 8 bytes.
  *
- * Past uses two blocks. When one block is full (it gets filled as parameters
- * are added (obviously) and rewritten) the block is compacted and rewritten
- * into the other Past block.
+ * Past uses PAST_NUM_BLOCKS blocks (two by default). When one block is full
+ * (it gets filled as parameters are added (obviously) and rewritten) the block
+ * is compacted and rewritten into the least erased of the other blocks. The
+ * old block is left as it is, the block with the highest counter being the
+ * current one, so each garbage collection costs a single page erase and the
+ * erases are spread over all blocks.
+ *
+ * The first unit of each block is the reserved unit PAST_UNIT_ID_ERASES
+ * holding the number of times the block has been erased. It is written right
+ * after the erase, before the block gets its magic, and is never copied.
  *
  * * Writing a unit *
- * When writing a unit, the unit data is written first. Secondly, the size and
- * id are written and the parameter write is complete. There exists a theoretial
- * change that power is lost during this last write. If so, an attempt will be
- * made to clean up the write during the next power cycle.
+ * When writing a unit, the size is written first, then the data and last the
+ * id, which completes the write. If power is lost before the id is written,
+ * the block has data following its end marker and is garbage collected on the
+ * next power cycle (see Past startup). Once the id is written the unit is
+ * entered in the index and the old version of the unit, if any, is removed.
  *
  * * Removing a unit *
- * When removing a unit, the id field is written as 0x00000000, the length is
- * kept and the data is overwritten with zeros. This is why 0 is not a valid
- * unit id.
+ * When removing a unit, the data is overwritten with zeros and then the id
+ * field is written as 0x00000000, the length is kept. This is why 0 is not a
+ * valid unit id.
  *
  * * Rewriting a unit *
  * Rewriting is not an operation in itself in terms that the user does not have
  * care about it, it is handled inside Past. It is a combination of writing
  * and removing the old unit.
  *
+ * * Transactions *
+ * past_begin(...) reserves room in the current block for a marker unit
+ * (PAST_UNIT_ID_TXN) and the units to come, garbage collecting first if need
+ * be, so a transaction is never split by a garbage collection. The marker is
+ * written before the first unit, with its data word left erased, and the
+ * units follow it, written as above. The old versions of up to PAST_TXN_UNITS
+ * rewritten units are kept until past_commit(...) programs the data word of
+ * the marker, after which they and the marker are erased. If a write of the
+ * transaction failed, the commit erases the marker and the units written
+ * instead and the old versions stand. At startup, the units following a
+ * marker that was never committed are erased and the old versions of the
+ * units of a committed one are erased if that was not completed.
+ *
  * * Reading a unit *
  * When reading a unit, a pointer to the data in flash is returned along with
  * the size. The data is read only.
@@ -103,11 +125,33 @@
  * * Garbage collection *
  * As units get rewritten, Past will be filled with old unit data an at some
  * point it will be full. At this point it will perform a garbage collection,
- * copying all units to the other flash block. It will first erase that block
+ * copying all units to another flash block. It will first erase that block
  * and then copy the valid data from the old block. When colpleted it will
  * update the block counter att offset 4 and at the very last write the past
  * magic at offset 0.
  *
+ * With CONFIG_PAST_INCREMENTAL_GC, past_gc_step(...) does the garbage
+ * collection ahead of time, a few units per call, while the current block still
+ * has room. Units written meanwhile go to the current block and are copied
+ * when the walk gets to them, an already copied version of them is erased in
+ * the new block. The new block gets its magic when the walk is done, a power
+ * loss before that leaves the current block as it was.
+ *
+ * * Index *
+ * Walking the units of a block to find one gets slower as the block fills up
+ * with erased units. The offsets of the valid units of the current block are
+ * therefore kept in a RAM index sorted on id, built by past_init() and after
+ * each garbage collection and updated on write and erase. If there are more
+ * units than PAST_INDEX_SIZE, the ones not in the index are found by walking
+ * the block as before.
+ *
+ * * Write-back cache *
+ * With CONFIG_PAST_WRITE_BACK, settings that change often can be written with
+ * past_write_unit_deferred(...), which only copies the unit to a small RAM
+ * cache. Rewrites of a pending unit replace it in the cache and a unit equal to
+ * its copy in flash is dropped, past_flush(...) writes what is left. Reads and
+ * erases see the pending units.
+ *
  *
  *
  *
@@ -117,8 +161,11 @@
 
 #define PAST_UNIT_ID_INVALID           (0)
 #define PAST_UNIT_ID_END      (0xffffffff)
+#define PAST_UNIT_ID_ERASES   (0xfffffffe)
+#define PAST_UNIT_ID_TXN      (0xfffffffd)
 
-#define PAST_BLOCK_SIZE     (1024)  //STM32F100
+/** Data of a transaction marker once the transaction is committed */
+#define TXN_COMMITTED  (0)
 
 #define HEADER_COUNTER_OFFSET     (4)
 #define HEADER_FIRST_UNIT_OFFSET  (8)
@@ -126,13 +173,42 @@
 #define UNIT_SIZE_OFFSET  (4)
 #define UNIT_DATA_OFFSET  (8)
 
+/** Transaction states */
+#define TXN_NONE     (0)
+#define TXN_OPEN     (1) /** Nothing written yet */
+#define TXN_WRITTEN  (2) /** The marker at _txn_addr has been written */
+
+/** Garbage collection states */
+#define GC_IDLE   (0)
+#define GC_ERASE  (1) /** Erase the new block */
+#define GC_COPY   (2) /** Copy the unit at _gc_src */
+
 static int32_t past_find_unit(past_t *past, past_id_t id);
+static int32_t past_scan_unit(past_t *past, past_id_t id);
+static int32_t index_build(past_t *past);
+static void index_set(past_t *past, past_id_t id, uint32_t address);
+static void index_remove(past_t *past, past_id_t id);
 static bool past_erase_unit_at(uint32_t address);
 static bool past_garbage_collect(past_t *past);
+static void gc_start(past_t *past);
+static bool gc_step(past_t *past);
+static bool gc_finish(past_t *past);
+static void gc_forget(past_t *past, past_id_t id, uint32_t address);
+static uint32_t unit_footprint(uint32_t address);
+static bool write_unit_at(uint32_t address, past_id_t id, void *data, uint32_t length);
+static bool txn_recover(past_t *past);
 static inline bool flash_write32(uint32_t address, uint32_t data);
 static inline uint32_t flash_read32(uint32_t address); /** @todo Make a macro out of read32*/
-static bool copy_parameters(past_t *past, uint32_t src_base, uint32_t dst_base);
 static uint32_t past_remaining_size(past_t *past);
+static uint32_t past_free_size(past_t *past);
+static void txn_open(past_t *past, uint32_t size);
+static uint32_t read_erase_count(uint32_t base);
+static bool erase_block(uint32_t base);
+#ifdef CONFIG_PAST_WRITE_BACK
+static int32_t cache_find(past_t *past, past_id_t id);
+static void cache_drop(past_t *past, past_id_t id);
+static bool unit_equals(uint32_t address, const void *data, uint32_t length);
+#endif // CONFIG_PAST_WRITE_BACK
 
 /**
   * @brief Initialize the past, format or garbage collect if needed
@@ -144,49 +220,57 @@ bool past_init(past_t *past)
 {
     bool success = false;
     if (past) {
-        /** Check which block is the current one */
-        uint32_t magic_1 = flash_read32(past->blocks[0]);
-        uint32_t magic_2 = flash_read32(past->blocks[1]);
-        uint32_t counter_1 = flash_read32(past->blocks[0] + HEADER_COUNTER_OFFSET);
-        uint32_t counter_2 = flash_read32(past->blocks[1] + HEADER_COUNTER_OFFSET);
+        past->_gc_state = GC_IDLE;
+        past->_txn_state = TXN_NONE;
+#ifdef CONFIG_PAST_WRITE_BACK
+        past->_cache_dirty = 0;
+#endif // CONFIG_PAST_WRITE_BACK
+        /** The current block is the valid one with the highest counter */
+        bool found = false;
+        for (uint32_t i = 0; i < PAST_NUM_BLOCKS; i++) {
+            uint32_t magic = flash_read32(past->blocks[i]);
+            uint32_t counter = flash_read32(past->blocks[i] + HEADER_COUNTER_OFFSET);
+            if (PAST_MAGIC == magic && (!found || counter > past->_counter)) {
+                past->_cur_block = i;
+                past->_counter = counter;
+                found = true;
+            }
+        }
         success = true;
-        if (PAST_MAGIC == magic_1 && PAST_MAGIC == magic_2) {
-            past->_cur_block = counter_2 > counter_1 ? 1 : 0;
-            past->_counter = counter_2 > counter_1 ? counter_2 : counter_1;
-        } else if (PAST_MAGIC == magic_2) {
-            past->_cur_block = 1;
-            past->_counter = counter_2;
-        } else if (PAST_MAGIC == magic_1) {
-            past->_cur_block = 0;
-            past->_counter = counter_1;
-        } else {
-            /** No valid Past in either block */
+        if (!found) {
+            /** No valid Past in any block */
             past->_cur_block = 0;
             past->_counter = 0;
             success &= past_format(past);
         }
         if (success) {
-            int32_t addr = past_find_unit(past, PAST_UNIT_ID_END);
+            /** A single walk finds the end and builds the index */
+            int32_t addr = index_build(past);
             if (addr < 0) {
                 past->_valid = success = past_garbage_collect(past);
             } else {
                 past->_end_addr = (uint32_t) addr;
                 past->_valid = true;
+                if (txn_recover(past)) {
+                    (void) index_build(past);
+                }
             }
         }
 
-        /** Now check all space following the end address is erased space.
-          * If not we have a half completed write operation we need to clear
-          * by a garbage collect */
-        uint32_t check_addr = past->_end_addr;
-        while (check_addr < past->blocks[past->_cur_block] + PAST_BLOCK_SIZE) {
+        /** Now check the space following the end address is erased. Units
+          * are written size first and id last, so a write that was cut short
+          * has left at least one of those two words behind and there is no
+          * need to sweep the rest of the block. If there is one, we have a
+          * half completed write operation we need to clear by a garbage
+          * collect. Older firmware wrote the data first, a write it cut short
+          * is found when the next write there fails, see past_write_unit() */
+        uint32_t block_end = past->blocks[past->_cur_block] + PAST_BLOCK_SIZE;
+        for (uint32_t check_addr = past->_end_addr; check_addr < past->_end_addr + UNIT_DATA_OFFSET && check_addr < block_end; check_addr += 4) {
             if (flash_read32(check_addr) != PAST_UNIT_ID_END) {
                 success &= past_garbage_collect(past);
                 break;
             }
-            check_addr += 4;
         }
-
     }
     return success;
 }
@@ -206,12 +290,19 @@ bool past_read_unit(past_t *past, past_id_t id, const void **data, uint32_t *len
         return false;
     }
     *length = 0;
+#ifdef CONFIG_PAST_WRITE_BACK
+    int32_t slot = cache_find(past, id);
+    if (slot >= 0) {
+        *data = (const void*) past->_cache_data[slot];
+        *length = past->_cache_length[slot];
+        return true;
+    }
+#endif // CONFIG_PAST_WRITE_BACK
     int32_t address = past_find_unit(past, id);
     if (address > 0) {
         *length = flash_read32(address + UNIT_SIZE_OFFSET);
 #ifdef DPS_EMULATOR
-        uint32_t temp = flash_read32(address + UNIT_DATA_OFFSET);
-        *data = (const void*) &temp;
+        *data = flash_read_ptr(address + UNIT_DATA_OFFSET);
 #else // DPS_EMULATOR
         *data = (const void*) address + UNIT_DATA_OFFSET;
 #endif // DPS_EMULATOR
@@ -230,7 +321,8 @@ bool past_read_unit(past_t *past, past_id_t id, const void **data, uint32_t *len
   */
 bool past_write_unit(past_t *past, past_id_t id, void *data, uint32_t length)
 {
-    if (!past || !past->_valid || !data || !length || id == PAST_UNIT_ID_INVALID || id == PAST_UNIT_ID_END) {
+    PROFILE_START();
+    if (!past || !past->_valid || !data || !length || id == PAST_UNIT_ID_INVALID || id == PAST_UNIT_ID_END || id == PAST_UNIT_ID_ERASES || id == PAST_UNIT_ID_TXN) {
 #ifdef DPS_EMULATOR
         if (!past) {
             emu_printf("Past is NULL\n");
@@ -250,75 +342,88 @@ bool past_write_unit(past_t *past, past_id_t id, void *data, uint32_t length)
         if (id == PAST_UNIT_ID_END) {
             emu_printf("Id is equal to end\n");
         }
+        if (id == PAST_UNIT_ID_ERASES || id == PAST_UNIT_ID_TXN) {
+            emu_printf("Id is reserved\n");
+        }
 #endif // DPS_EMULATOR
+        PROFILE_END(prof_past_write);
         return false;
     }
-    uint32_t end_address;
-    uint32_t wi = 0; /** word index */
-    uint32_t temp;
+#ifdef CONFIG_PAST_WRITE_BACK
+    cache_drop(past, id); /** This write supersedes a pending one */
+#endif // CONFIG_PAST_WRITE_BACK
+    uint32_t size = PAST_UNIT_SIZE(length);
     bool success = false;
     unlock_flash();
-
-    if (past_remaining_size(past) < UNIT_DATA_OFFSET + length) {
-        if (!past_garbage_collect(past)) {
-            return false;
-        }
-    }
-    if (past_remaining_size(past) < UNIT_DATA_OFFSET + length) {
-        return false;
-    }
-    end_address = past->_end_addr;
     do {
+        if (past->_txn_state == TXN_NONE) {
+            if (past_free_size(past) < size && !past_garbage_collect(past)) {
+                break;
+            }
+            if (past_free_size(past) < size) {
+                break;
+            }
+        } else {
+            /** The space was reserved by past_begin */
+            uint32_t marker_size = past->_txn_state == TXN_OPEN ? PAST_UNIT_SIZE(4) : 0;
+            if (past->_end_addr + marker_size + size > past->_txn_end) {
+                past->_txn_failed = true;
+                break;
+            }
+            if (past->_txn_state == TXN_OPEN) {
+                /** The marker is left uncommitted, its data erased */
+                if (!flash_write32(past->_end_addr + UNIT_SIZE_OFFSET, 4) || !flash_write32(past->_end_addr, PAST_UNIT_ID_TXN)) {
+                    past->_txn_failed = true;
+                    break;
+                }
+                past->_txn_addr = past->_end_addr;
+                past->_end_addr += marker_size;
+                past->_txn_state = TXN_WRITTEN;
+            }
+        }
         /** Check if there is an old version of the unit */
         int32_t old_addr = past_find_unit(past, id);
         if (old_addr < 0) {
             /** @todo: format past */
         }
-        /** Write the new unit */
-        if (!flash_write32(end_address+UNIT_SIZE_OFFSET, length)) {
+        if (old_addr > 0 && past->_txn_state != TXN_NONE && past->_txn_count == PAST_TXN_UNITS) {
+            past->_txn_failed = true;
             break;
         }
-        while(4*wi < length) {
-            temp = ((uint32_t*)(data))[wi];
-            if (!flash_write32(end_address+UNIT_DATA_OFFSET+4*wi, temp)) {
-                break;
-            }
-            wi++;
-            if (length % 4 && 4*(wi+1) >= length) {
-                /** Data not even multiple of 4, reading one more word would
-                  * cause an out of bound buffer read */
-                break;
-            }
+        bool written = write_unit_at(past->_end_addr, id, data, length);
+        if (!written && past->_txn_state == TXN_NONE && past_garbage_collect(past)) {
+            /** Firmware writing the data of a unit before its size and id
+              * may have left data of a cut short write beyond the end, which
+              * past_init() does not sweep for. Collecting moves the units to
+              * a clean block, try once more there. */
+            old_addr = past_find_unit(past, id);
+            written = past_free_size(past) >= size && write_unit_at(past->_end_addr, id, data, length);
         }
-        if (length % 4) { /** Write remaining 1..3 bytes */
-            temp = 0;
-            for (uint32_t i = 0; i < length % 4; i++) {
-                uint8_t b = ((uint8_t*)(data))[4*wi + i];
-                temp |= b << (8*i);
-            }
-            if (!flash_write32(end_address+UNIT_DATA_OFFSET+4*wi, temp)) {
-                break;
+        if (!written) {
+            if (past->_txn_state != TXN_NONE) {
+                past->_txn_failed = true;
             }
-        }
-        if (!flash_write32(end_address, id)) {
             break;
         }
-        /** Update end addres of the past struct */
-        end_address += UNIT_DATA_OFFSET + length;
-        if (end_address % 4) {
-            end_address += 4 - (end_address % 4); // Word align
-        }
-        past->_end_addr = end_address;
+        index_set(past, id, past->_end_addr);
+        past->_end_addr += size;
 
-        /** If existing, erase the old version */
-        if (old_addr) {
-            if (!past_erase_unit_at(old_addr)) {
-                break;
+        /** If existing, erase the old version, at commit in a transaction */
+        if (old_addr > 0) {
+            if (past->_txn_state != TXN_NONE) {
+                past->_txn_old[past->_txn_count++] = old_addr - past->blocks[past->_cur_block];
+            } else {
+                gc_forget(past, id, old_addr);
+                past->_garbage += unit_footprint(old_addr);
+                if (!past_erase_unit_at(old_addr)) {
+                    break;
+                }
             }
         }
         success = true;
     } while(0);
     lock_flash();
+    PROFILE_END(prof_past_write);
     return success;
 }
 
@@ -331,17 +436,27 @@ bool past_write_unit(past_t *past, past_id_t id, void *data, uint32_t length)
   */
 bool past_erase_unit(past_t *past, past_id_t id)
 {
-    if (!past || !past->_valid || id == PAST_UNIT_ID_INVALID || id == PAST_UNIT_ID_END) {
+    if (!past || !past->_valid || id == PAST_UNIT_ID_INVALID || id == PAST_UNIT_ID_END || id == PAST_UNIT_ID_ERASES || id == PAST_UNIT_ID_TXN) {
         return false;
     }
     bool success = false;
+#ifdef CONFIG_PAST_WRITE_BACK
+    bool cached = cache_find(past, id) >= 0;
+    cache_drop(past, id);
+#endif // CONFIG_PAST_WRITE_BACK
     do {
         int32_t address = past_find_unit(past, id);
         if (address == 0) {
+#ifdef CONFIG_PAST_WRITE_BACK
+            success = cached;
+#endif // CONFIG_PAST_WRITE_BACK
             break;
         } else if (address < 0) {
             /** @todo: format past */
         }
+        index_remove(past, id);
+        gc_forget(past, id, (uint32_t) address);
+        past->_garbage += unit_footprint((uint32_t) address);
         if (!past_erase_unit_at((uint32_t) address)) {
             break;
         }
@@ -365,17 +480,26 @@ bool past_format(past_t *past)
     unlock_flash();
     do {
         uint32_t cur_base;
-        flash_erase_page(past->blocks[0]);
-        if (!(FLASH_SR_EOP & flash_get_status_flags())) {
-            break;
+        uint32_t i;
+        for (i = 0; i < PAST_NUM_BLOCKS; i++) {
+            if (!erase_block(past->blocks[i])) {
+                break;
+            }
         }
-        flash_erase_page(past->blocks[1]);
-        if (!(FLASH_SR_EOP & flash_get_status_flags())) {
+        if (i < PAST_NUM_BLOCKS) {
             break;
         }
         past->_cur_block = 0;
         past->_counter = 0;
-        past->_end_addr = past->blocks[0] + HEADER_FIRST_UNIT_OFFSET;
+        past->_end_addr = past->blocks[0] + HEADER_FIRST_UNIT_OFFSET + UNIT_DATA_OFFSET + 4;
+        past->_index_count = 0;
+        past->_index_complete = true;
+        past->_garbage = 0;
+        past->_gc_state = GC_IDLE;
+        past->_txn_state = TXN_NONE;
+#ifdef CONFIG_PAST_WRITE_BACK
+        past->_cache_dirty = 0;
+#endif // CONFIG_PAST_WRITE_BACK
         cur_base = past->blocks[past->_cur_block];
         if (!flash_write32(cur_base + HEADER_COUNTER_OFFSET, past->_counter)) {
             break;
@@ -389,6 +513,422 @@ bool past_format(past_t *past)
     return success;
 }
 
+/**
+  * @brief Get the number of times a past block has been erased
+  * @param past An initialized past structure
+  * @param block index of the block in the blocks array
+  * @retval erase count of the block, 0 if unknown
+  */
+uint32_t past_erase_count(past_t *past, uint32_t block)
+{
+    if (!past || block >= PAST_NUM_BLOCKS) {
+        return 0;
+    }
+    return read_erase_count(past->blocks[block]);
+}
+
+/**
+  * @brief Begin a transaction. The units written until past_commit(...) are
+  *        kept, or lost, all together should power be lost.
+  * @param past An initialized past structure
+  * @param length Total size of the units to write, see PAST_UNIT_SIZE
+  * @retval true if the space was reserved and the transaction begun
+  *         false if there is no room or a transaction is already open
+  */
+bool past_begin(past_t *past, uint32_t length)
+{
+    if (!past || !past->_valid || past->_txn_state != TXN_NONE) {
+        return false;
+    }
+    uint32_t size = PAST_UNIT_SIZE(4) + length; /** The marker and the units */
+    if (past_free_size(past) < size && !past_garbage_collect(past)) {
+        return false;
+    }
+    if (past_free_size(past) < size) {
+        return false;
+    }
+    txn_open(past, size);
+    return true;
+}
+
+/**
+  * @brief Begin a transaction that may use the PAST_RESERVE_SIZE bytes kept
+  *        free in the current block, for an emergency commit
+  * @param past An initialized past structure
+  * @param length Total size of the units to write, see PAST_UNIT_SIZE
+  * @retval true if the space was reserved and the transaction begun
+  *         false if there is no room or a transaction is already open
+  */
+bool past_begin_reserved(past_t *past, uint32_t length)
+{
+    if (!past || !past->_valid || past->_txn_state != TXN_NONE) {
+        return false;
+    }
+    uint32_t size = PAST_UNIT_SIZE(4) + length;
+    if (past_remaining_size(past) < size) {
+        return false;
+    }
+    txn_open(past, size);
+    return true;
+}
+
+/**
+  * @brief Commit the transaction, erasing the old versions of the units
+  *        written. If any of the writes failed, they are all undone.
+  * @param past An initialized past structure
+  * @retval true if the transaction was committed
+  *         false if it was rolled back or there is no transaction
+  */
+bool past_commit(past_t *past)
+{
+    if (!past || past->_txn_state == TXN_NONE) {
+        return false;
+    }
+    bool success = !past->_txn_failed;
+    if (past->_txn_state == TXN_WRITTEN) {
+        uint32_t base = past->blocks[past->_cur_block];
+        uint32_t marker = past->_txn_addr;
+        if (success) {
+            success = flash_write32(marker + UNIT_DATA_OFFSET, TXN_COMMITTED);
+        }
+        if (success) {
+            for (uint32_t i = 0; i < past->_txn_count; i++) {
+                uint32_t address = base + past->_txn_old[i];
+                gc_forget(past, flash_read32(address), address);
+                past->_garbage += unit_footprint(address);
+                (void) past_erase_unit_at(address);
+            }
+            past->_garbage += unit_footprint(marker);
+            (void) past_erase_unit_at(marker);
+        } else {
+            /** Undo the writes, the old versions are still in place */
+            for (uint32_t address = marker; address < past->_end_addr; address += unit_footprint(address)) {
+                if (flash_read32(address) != PAST_UNIT_ID_INVALID) {
+                    (void) past_erase_unit_at(address);
+                }
+            }
+            (void) index_build(past);
+        }
+    }
+    past->_txn_state = TXN_NONE;
+    lock_flash();
+    return success;
+}
+
+#ifdef CONFIG_PAST_WRITE_BACK
+/**
+  * @brief Write unit to the RAM write-back cache of the past. The unit is
+  *        written to flash by the next past_flush(...), unless it is written
+  *        again before that. Units larger than PAST_CACHE_UNIT_SIZE are
+  *        written through, and a full cache is flushed first, or the unit
+  *        written through in an open transaction.
+  * @param past An initialized past structure
+  * @param id Unit id to write
+  * @param data Data to write
+  * @param length Size of data
+  * @retval true if the unit was cached or written
+  *         false if writing failed or the past was full
+  */
+bool past_write_unit_deferred(past_t *past, past_id_t id, void *data, uint32_t length)
+{
+    if (!past || !past->_valid || !data || !length || length > PAST_CACHE_UNIT_SIZE || id == PAST_UNIT_ID_INVALID || id == PAST_UNIT_ID_END || id == PAST_UNIT_ID_ERASES || id == PAST_UNIT_ID_TXN) {
+        /** Let past_write_unit sort out the errors and the large units */
+        return past_write_unit(past, id, data, length);
+    }
+    int32_t address = past_find_unit(past, id);
+    if (address > 0 && unit_equals((uint32_t) address, data, length)) {
+        /** Back to what is in flash, nothing to write */
+        cache_drop(past, id);
+        return true;
+    }
+    int32_t slot = cache_find(past, id);
+    if (slot < 0) {
+        for (slot = 0; slot < PAST_CACHE_SLOTS && (past->_cache_dirty & (1 << slot)); slot++) ;
+        if (slot == PAST_CACHE_SLOTS) {
+            if (past->_txn_state != TXN_NONE) {
+                /** Cannot flush now, it fits in the transaction instead */
+                return past_write_unit(past, id, data, length);
+            }
+            if (!past_flush(past)) {
+                return false;
+            }
+            slot = 0;
+        }
+    }
+    memcpy(past->_cache_data[slot], data, length);
+    past->_cache_id[slot] = id;
+    past->_cache_length[slot] = length;
+    past->_cache_dirty |= 1 << slot;
+    return true;
+}
+
+/**
+  * @brief Write the units pending in the write-back cache to flash, in one
+  *        transaction, or in the open one whose length included
+  *        past_cache_size(...)
+  * @param past An initialized past structure
+  * @retval true if all pending units were written
+  *         false if writing any of them failed
+  */
+bool past_flush(past_t *past)
+{
+    if (!past || !past->_valid) {
+        return false;
+    }
+    uint8_t dirty = past->_cache_dirty;
+    if (!dirty) {
+        return true;
+    }
+    /** Dropped even if the writes fail, as a write through would be */
+    past->_cache_dirty = 0;
+    bool own_txn = past->_txn_state == TXN_NONE;
+    if (own_txn) {
+        uint32_t length = 0;
+        for (uint32_t slot = 0; slot < PAST_CACHE_SLOTS; slot++) {
+            if (dirty & (1 << slot)) {
+                length += PAST_UNIT_SIZE(past->_cache_length[slot]);
+            }
+        }
+        if (!past_begin(past, length)) {
+            return false;
+        }
+    }
+    for (uint32_t slot = 0; slot < PAST_CACHE_SLOTS; slot++) {
+        if (dirty & (1 << slot)) {
+            (void) past_write_unit(past, past->_cache_id[slot], past->_cache_data[slot], past->_cache_length[slot]);
+        }
+    }
+    return own_txn ? past_commit(past) : !past->_txn_failed;
+}
+
+/**
+  * @brief Get the flash the units pending in the write-back cache take
+  * @param past An initialized past structure
+  * @retval the sum of PAST_UNIT_SIZE of the pending units
+  */
+uint32_t past_cache_size(past_t *past)
+{
+    uint32_t length = 0;
+    for (uint32_t slot = 0; past && slot < PAST_CACHE_SLOTS; slot++) {
+        if (past->_cache_dirty & (1 << slot)) {
+            length += PAST_UNIT_SIZE(past->_cache_length[slot]);
+        }
+    }
+    return length;
+}
+
+/**
+  * @brief Check if there are units pending flush
+  * @param past An initialized past structure
+  * @retval true if past_flush(...) has something to write
+  */
+bool past_is_dirty(past_t *past)
+{
+    return past && past->_cache_dirty != 0;
+}
+
+#endif // CONFIG_PAST_WRITE_BACK
+
+#ifdef CONFIG_PAST_TRANSFER
+/**
+  * @brief Walk the units in flash, in the order they were written. Units
+  *        pending in the write-back cache are not seen, flush first.
+  * @param past An initialized past structure
+  * @param cursor 0 to get the first unit, updated for the next call
+  * @param id the id of the unit
+  * @param data the data of the unit, in flash
+  * @param length the size of the unit
+  * @retval true if a unit was found
+  *         false after the last one, or while a transaction is open
+  */
+bool past_next_unit(past_t *past, uint32_t *cursor, past_id_t *id, const void **data, uint32_t *length)
+{
+    if (!past || !past->_valid || past->_txn_state != TXN_NONE || !cursor || !id || !data || !length) {
+        return false;
+    }
+    uint32_t base = past->blocks[past->_cur_block];
+    uint32_t address = *cursor ? *cursor : base + HEADER_FIRST_UNIT_OFFSET;
+    while (address >= base + HEADER_FIRST_UNIT_OFFSET && address < past->_end_addr) {
+        past_id_t cur_id = flash_read32(address);
+        uint32_t next = address + unit_footprint(address);
+        if (cur_id != PAST_UNIT_ID_INVALID && cur_id != PAST_UNIT_ID_ERASES && cur_id != PAST_UNIT_ID_TXN) {
+            *id = cur_id;
+            *length = flash_read32(address + UNIT_SIZE_OFFSET);
+#ifdef DPS_EMULATOR
+            *data = flash_read_ptr(address + UNIT_DATA_OFFSET);
+#else // DPS_EMULATOR
+            *data = (const void*) address + UNIT_DATA_OFFSET;
+#endif // DPS_EMULATOR
+            *cursor = next;
+            return true;
+        }
+        address = next;
+    }
+    return false;
+}
+#endif // CONFIG_PAST_TRANSFER
+
+#ifdef CONFIG_PAST_WRITE_BACK
+/**
+  * @brief Find a unit pending flush
+  * @param past An initialized past structure
+  * @param id Unit id to find
+  * @retval cache slot of the unit, -1 if it is not pending
+  */
+static int32_t cache_find(past_t *past, past_id_t id)
+{
+    for (uint32_t slot = 0; slot < PAST_CACHE_SLOTS; slot++) {
+        if ((past->_cache_dirty & (1 << slot)) && past->_cache_id[slot] == id) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+/**
+  * @brief Drop a unit pending flush, if there is one
+  * @param past An initialized past structure
+  * @param id Unit id to drop
+  * @retval None
+  */
+static void cache_drop(past_t *past, past_id_t id)
+{
+    int32_t slot = cache_find(past, id);
+    if (slot >= 0) {
+        past->_cache_dirty &= ~(1 << slot);
+    }
+}
+
+/**
+  * @brief Compare a unit in flash with data
+  * @param address address of the unit (points to id)
+  * @param data data to compare with
+  * @param length size of data
+  * @retval true if the unit holds exactly the data
+  */
+static bool unit_equals(uint32_t address, const void *data, uint32_t length)
+{
+    if (flash_read32(address + UNIT_SIZE_OFFSET) != length) {
+        return false;
+    }
+    for (uint32_t i = 0; i < length; i += 4) {
+        uint32_t word = 0;
+        uint32_t n = length - i < 4 ? length - i : 4;
+        memcpy(&word, (const uint8_t*) data + i, n); /** Tail bytes are written as zeros */
+        if (flash_read32(address + UNIT_DATA_OFFSET + i) != word) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif // CONFIG_PAST_WRITE_BACK
+
+/**
+  * @brief Finish a transaction interrupted by a power loss. The units of a
+  *        committed one replace their old versions, the units of one that was
+  *        never committed are erased.
+  * @param past pointer to a past structure with the end address found
+  * @retval true if there was a transaction to finish
+  */
+static bool txn_recover(past_t *past)
+{
+    bool found = false;
+    uint32_t first = past->blocks[past->_cur_block] + HEADER_FIRST_UNIT_OFFSET;
+    for (uint32_t marker = first; marker < past->_end_addr; marker += unit_footprint(marker)) {
+        if (flash_read32(marker) != PAST_UNIT_ID_TXN) {
+            continue;
+        }
+        bool committed = flash_read32(marker + UNIT_DATA_OFFSET) == TXN_COMMITTED;
+        for (uint32_t unit = marker + unit_footprint(marker); unit < past->_end_addr; unit += unit_footprint(unit)) {
+            past_id_t id = flash_read32(unit);
+            if (id == PAST_UNIT_ID_INVALID) {
+                continue;
+            } else if (!committed) {
+                (void) past_erase_unit_at(unit);
+            } else {
+                for (uint32_t old = first; old < unit; old += unit_footprint(old)) {
+                    if (flash_read32(old) == id) {
+                        (void) past_erase_unit_at(old);
+                    }
+                }
+            }
+        }
+        (void) past_erase_unit_at(marker);
+        found = true;
+    }
+    return found;
+}
+
+/**
+  * @brief Write a unit, the id last to mark it complete. Must be called with
+  *        the flash unlocked.
+  * @param address address to write the unit to
+  * @param id Unit id
+  * @param data Data to write
+  * @param length Size of data
+  * @retval true if successful
+  */
+static bool write_unit_at(uint32_t address, past_id_t id, void *data, uint32_t length)
+{
+    uint32_t wi; /** word index */
+    uint32_t temp;
+    if (!flash_write32(address + UNIT_SIZE_OFFSET, length)) {
+        return false;
+    }
+    /** Whole words only, reading past the end of data could fault */
+    for (wi = 0; 4*(wi+1) <= length; wi++) {
+        temp = ((uint32_t*)(data))[wi];
+        if (!flash_write32(address + UNIT_DATA_OFFSET + 4*wi, temp)) {
+            return false;
+        }
+    }
+    if (length % 4) { /** Write remaining 1..3 bytes */
+        temp = 0;
+        for (uint32_t i = 0; i < length % 4; i++) {
+            uint8_t b = ((uint8_t*)(data))[4*wi + i];
+            temp |= b << (8*i);
+        }
+        if (!flash_write32(address + UNIT_DATA_OFFSET + 4*wi, temp)) {
+            return false;
+        }
+    }
+    return flash_write32(address, id);
+}
+
+/**
+  * @brief Read the erase count unit of a block
+  * @param base base address of the block
+  * @retval erase count, 0 if the block has no erase count unit
+  */
+static uint32_t read_erase_count(uint32_t base)
+{
+    uint32_t unit = base + HEADER_FIRST_UNIT_OFFSET;
+    if (flash_read32(unit) == PAST_UNIT_ID_ERASES && flash_read32(unit + UNIT_SIZE_OFFSET) == 4) {
+        return flash_read32(unit + UNIT_DATA_OFFSET);
+    }
+    return 0;
+}
+
+/**
+  * @brief Erase a block and write its increased erase count as its first
+  *        unit. The block is left without magic. Must be called with the
+  *        flash unlocked.
+  * @param base base address of the block
+  * @retval true if successful
+  */
+static bool erase_block(uint32_t base)
+{
+    uint32_t unit = base + HEADER_FIRST_UNIT_OFFSET;
+    uint32_t erases = read_erase_count(base) + 1;
+    flash_erase_page(base);
+    if (!(FLASH_SR_EOP & flash_get_status_flags())) {
+        return false;
+    }
+    return flash_write32(unit + UNIT_DATA_OFFSET, erases) &&
+           flash_write32(unit + UNIT_SIZE_OFFSET, 4) &&
+           flash_write32(unit, PAST_UNIT_ID_ERASES);
+}
+
 /**
   * @brief Return size of past data in bytes
   * @param past pointer to an initialized past structure
@@ -404,6 +944,33 @@ static uint32_t past_remaining_size(past_t *past)
     }
 }
 
+/**
+  * @brief Return the bytes left in the current block for all but
+  *        past_begin_reserved(...)
+  * @param past pointer to an initialized past structure
+  * @retval free size in bytes, PAST_RESERVE_SIZE less than remaining
+  */
+static uint32_t past_free_size(past_t *past)
+{
+    uint32_t remaining = past_remaining_size(past);
+    return remaining > PAST_RESERVE_SIZE ? remaining - PAST_RESERVE_SIZE : 0;
+}
+
+/**
+  * @brief Open a transaction of size bytes, the caller has checked the room
+  * @param past pointer to an initialized past structure
+  * @param size Size of the marker and the units
+  * @retval None
+  */
+static void txn_open(past_t *past, uint32_t size)
+{
+    unlock_flash(); /** Until past_commit */
+    past->_txn_state = TXN_OPEN;
+    past->_txn_end = past->_end_addr + size;
+    past->_txn_count = 0;
+    past->_txn_failed = false;
+}
+
 /**
   * @brief Erase past unit at given address (points to id)
   * @param address address of unit to be erased
@@ -431,6 +998,111 @@ static bool past_erase_unit_at(uint32_t address)
     return success;
 }
 
+/**
+  * @brief Find the position of an id in the index
+  * @param past pointer to an initialized past structure
+  * @param id id of unit to search for
+  * @retval index of the id, or of where it would be inserted
+  */
+static uint32_t index_search(past_t *past, past_id_t id)
+{
+    uint32_t lo = 0, hi = past->_index_count;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (past->_index_id[mid] < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+  * @brief Add or update the address of a unit in the index
+  * @param past pointer to an initialized past structure
+  * @param id id of unit
+  * @param address address of unit in the current block
+  * @retval None
+  */
+static void index_set(past_t *past, past_id_t id, uint32_t address)
+{
+    uint32_t i = index_search(past, id);
+    if (i >= past->_index_count || past->_index_id[i] != id) {
+        if (past->_index_count == PAST_INDEX_SIZE) {
+            past->_index_complete = false;
+            return;
+        }
+        for (uint32_t j = past->_index_count; j > i; j--) {
+            past->_index_id[j] = past->_index_id[j-1];
+            past->_index_offset[j] = past->_index_offset[j-1];
+        }
+        past->_index_id[i] = id;
+        past->_index_count++;
+    }
+    past->_index_offset[i] = address - past->blocks[past->_cur_block];
+}
+
+/**
+  * @brief Remove a unit from the index
+  * @param past pointer to an initialized past structure
+  * @param id id of unit
+  * @retval None
+  */
+static void index_remove(past_t *past, past_id_t id)
+{
+    uint32_t i = index_search(past, id);
+    if (i < past->_index_count && past->_index_id[i] == id) {
+        past->_index_count--;
+        for (uint32_t j = i; j < past->_index_count; j++) {
+            past->_index_id[j] = past->_index_id[j+1];
+            past->_index_offset[j] = past->_index_offset[j+1];
+        }
+    }
+}
+
+/**
+  * @brief Build the index from the units of the current block, walking them
+  *        up to the end marker. The first copy of a unit is indexed if an
+  *        interrupted write left two.
+  * @param past pointer to an initialized past structure
+  * @retval address of the end marker, or -1 if a unit is broken
+  */
+static int32_t index_build(past_t *past)
+{
+    uint32_t base = past->blocks[past->_cur_block];
+    uint32_t cur_address = base + HEADER_FIRST_UNIT_OFFSET;
+    past->_index_count = 0;
+    past->_index_complete = true;
+    past->_garbage = 0;
+    while (cur_address < base + PAST_BLOCK_SIZE) {
+        uint32_t cur_id = flash_read32(cur_address);
+        if (cur_id == PAST_UNIT_ID_END) {
+            break;
+        }
+        uint32_t cur_size = flash_read32(cur_address + UNIT_SIZE_OFFSET);
+        if (cur_size == 0 || cur_size == 0xffffffff) {
+            return -1; /** Fatal error */
+        }
+        if (cur_id != PAST_UNIT_ID_INVALID && cur_id != PAST_UNIT_ID_ERASES && cur_id != PAST_UNIT_ID_TXN) {
+            uint32_t i = index_search(past, cur_id);
+            if (i >= past->_index_count || past->_index_id[i] != cur_id) {
+                index_set(past, cur_id, cur_address);
+            }
+        } else if (cur_id == PAST_UNIT_ID_INVALID) {
+            past->_garbage += unit_footprint(cur_address);
+        }
+        if (cur_size % 4) {
+            cur_size += 4 - (cur_size % 4); // Word align
+        }
+        cur_address += UNIT_DATA_OFFSET + cur_size;
+    }
+    if (cur_address > base + PAST_BLOCK_SIZE) {
+        return -1; /** The last unit does not fit the block */
+    }
+    return cur_address;
+}
+
 /**
   * @brief Find unit and return address
   * @param past pointer to an initialized past structure
@@ -438,6 +1110,24 @@ static bool past_erase_unit_at(uint32_t address)
   * @retval address of unit or 0 if not found or -1 if an error occured
   */
 static int32_t past_find_unit(past_t *past, past_id_t id)
+{
+    uint32_t i = index_search(past, id);
+    if (i < past->_index_count && past->_index_id[i] == id) {
+        return past->blocks[past->_cur_block] + past->_index_offset[i];
+    }
+    if (past->_index_complete) {
+        return 0;
+    }
+    return past_scan_unit(past, id);
+}
+
+/**
+  * @brief Find unit by walking the current block and return address
+  * @param past pointer to an initialized past structure
+  * @param id id of unit to search for
+  * @retval address of unit or 0 if not found or -1 if an error occured
+  */
+static int32_t past_scan_unit(past_t *past, past_id_t id)
 {
     uint32_t base = past->blocks[past->_cur_block];
     uint32_t cur_address = base + HEADER_FIRST_UNIT_OFFSET;
@@ -467,49 +1157,193 @@ static int32_t past_find_unit(past_t *past, past_id_t id)
         }
 
     } while (cur_address < base + PAST_BLOCK_SIZE);
+    if (cur_address >= base + PAST_BLOCK_SIZE && id != PAST_UNIT_ID_END) {
+        cur_address = 0; /** Not found in a block full to the brim */
+    }
     return cur_address;
 }
 
 /**
-  * @brief Perform garbage collection
+  * @brief Perform garbage collection, completing the one in progress if any
   * @param past pointer to an initialized past structure
   * @retval true if GC was successful
   */
 static bool past_garbage_collect(past_t *past)
 {
-    bool success = false;
-    unlock_flash();
-    do {
-        /** Format the new block */
-        uint32_t new_block = past->blocks[past->_cur_block ? 0 : 1];
-        uint32_t old_block = past->blocks[past->_cur_block];
-        flash_erase_page(new_block);
-        if (!(FLASH_SR_EOP & flash_get_status_flags())) {
-            break;
+    if (past->_gc_state == GC_IDLE) {
+        gc_start(past);
+    }
+    while (past->_gc_state != GC_IDLE) {
+        if (!gc_step(past)) {
+            return false;
         }
-        if (!copy_parameters(past, old_block, new_block)) {
-            break;
+    }
+    return true;
+}
+
+#ifdef CONFIG_PAST_INCREMENTAL_GC
+/**
+  * @brief Do a bounded amount of garbage collection, to be called
+  *        periodically
+  * @param past An initialized past structure
+  * @retval true if a garbage collection is in progress
+  *         false if there is nothing to do, or it failed
+  */
+bool past_gc_step(past_t *past)
+{
+    if (!past || !past->_valid || past->_txn_state != TXN_NONE) {
+        return false;
+    }
+    if (past->_gc_state == GC_IDLE) {
+        if (past_free_size(past) >= PAST_GC_THRESHOLD || past->_garbage < PAST_GC_THRESHOLD) {
+            return false;
         }
+        gc_start(past);
+    }
+    return gc_step(past) && past->_gc_state != GC_IDLE;
+}
+#endif // CONFIG_PAST_INCREMENTAL_GC
 
-        if (!flash_write32(new_block + HEADER_COUNTER_OFFSET, past->_counter+1)) {
-            break;
+/**
+  * @brief Start a garbage collection into the least erased of the other
+  *        blocks, the next one in line on ties
+  * @param past pointer to an initialized past structure
+  * @retval None
+  */
+static void gc_start(past_t *past)
+{
+    uint32_t new_idx = (past->_cur_block + 1) % PAST_NUM_BLOCKS;
+    uint32_t new_erases = read_erase_count(past->blocks[new_idx]);
+    for (uint32_t i = 2; i < PAST_NUM_BLOCKS; i++) {
+        uint32_t idx = (past->_cur_block + i) % PAST_NUM_BLOCKS;
+        uint32_t erases = read_erase_count(past->blocks[idx]);
+        if (erases < new_erases) {
+            new_idx = idx;
+            new_erases = erases;
         }
-        if (!flash_write32(new_block, PAST_MAGIC)) {
-            break;
+    }
+    past->_gc_block = new_idx;
+    past->_gc_src = past->blocks[past->_cur_block] + HEADER_FIRST_UNIT_OFFSET;
+    past->_gc_state = GC_ERASE;
+}
+
+/**
+  * @brief Do the next step of the garbage collection in progress: erase the
+  *        new block, copy one unit to it or finish it
+  * @param past pointer to an initialized past structure
+  * @retval false if the garbage collection failed and was abandoned
+  */
+static bool gc_step(past_t *past)
+{
+    bool success = true;
+    uint32_t src_base = past->blocks[past->_cur_block];
+    uint32_t dst_base = past->blocks[past->_gc_block];
+    unlock_flash();
+    if (past->_gc_state == GC_ERASE) {
+        success = erase_block(dst_base);
+        past->_gc_dst = dst_base + HEADER_FIRST_UNIT_OFFSET + UNIT_DATA_OFFSET + 4; /** After the erase count */
+        past->_gc_state = GC_COPY;
+    } else if (past->_gc_state == GC_COPY) {
+        /** Copy valid units until the step has written PAST_GC_STEP_SIZE
+          * bytes, skipping erased ones is cheap */
+        uint32_t copied = 0;
+        while (success && copied < PAST_GC_STEP_SIZE && past->_gc_state == GC_COPY) {
+            uint32_t src = past->_gc_src;
+            uint32_t dst = past->_gc_dst;
+            uint32_t id = flash_read32(src);
+            int32_t size = flash_read32(src + UNIT_SIZE_OFFSET);
+            uint32_t aligned_size = size;
+            if (aligned_size % 4) {
+                aligned_size += 4 - aligned_size % 4;
+            }
+            bool uncommitted = id == PAST_UNIT_ID_TXN && flash_read32(src + UNIT_DATA_OFFSET) != TXN_COMMITTED;
+            if (id == PAST_UNIT_ID_END || uncommitted || size <= 0 || src + UNIT_DATA_OFFSET + aligned_size > src_base + PAST_BLOCK_SIZE) {
+                /** Copied all there is, or all but a transaction that was
+                  * never committed */
+                success = gc_finish(past);
+                break;
+            }
+            if (id != PAST_UNIT_ID_INVALID && id != PAST_UNIT_ID_ERASES && id != PAST_UNIT_ID_TXN) {
+                for (uint32_t i = 0; i < aligned_size / 4 && success; i++) {
+                    success &= flash_write32(dst + UNIT_DATA_OFFSET + 4*i, flash_read32(src + UNIT_DATA_OFFSET + 4*i));
+                }
+                success &= flash_write32(dst + UNIT_SIZE_OFFSET, size);
+                success &= flash_write32(dst, id);
+                past->_gc_dst = dst + UNIT_DATA_OFFSET + aligned_size;
+                copied += UNIT_DATA_OFFSET + aligned_size;
+            }
+            past->_gc_src = src + UNIT_DATA_OFFSET + aligned_size;
+            if (success && past->_gc_src >= src_base + PAST_BLOCK_SIZE) {
+                success = gc_finish(past);
+            }
         }
+    }
+    lock_flash();
+    if (!success) {
+        past->_gc_state = GC_IDLE;
+    }
+    return success;
+}
+
+/**
+  * @brief Make the new block the current one by giving it the next counter
+  *        and finally the magic. Must be called with the flash unlocked.
+  * @param past pointer to an initialized past structure
+  * @retval true if successful
+  */
+static bool gc_finish(past_t *past)
+{
+    uint32_t new_block = past->blocks[past->_gc_block];
+    past->_gc_state = GC_IDLE;
+    if (!flash_write32(new_block + HEADER_COUNTER_OFFSET, past->_counter+1)) {
+        return false;
+    }
+    if (!flash_write32(new_block, PAST_MAGIC)) {
+        return false;
+    }
+    past->_counter++;
+    past->_cur_block = past->_gc_block;
+    past->_end_addr = past->_gc_dst;
+    (void) index_build(past);
+    /** Past is now ready for writing */
+    return true;
+}
 
-        flash_erase_page(old_block);
-        if (!(FLASH_SR_EOP & flash_get_status_flags())) {
+/**
+  * @brief Erase the copy a garbage collection in progress made of a unit
+  *        that is being rewritten or erased
+  * @param past pointer to an initialized past structure
+  * @param id id of the unit
+  * @param address address of the unit in the current block
+  * @retval None
+  */
+static void gc_forget(past_t *past, past_id_t id, uint32_t address)
+{
+    if (past->_gc_state != GC_COPY || address >= past->_gc_src) {
+        return; /** Not copied (yet) */
+    }
+    uint32_t cur_address = past->blocks[past->_gc_block] + HEADER_FIRST_UNIT_OFFSET;
+    while (cur_address < past->_gc_dst) {
+        if (flash_read32(cur_address) == id) {
+            (void) past_erase_unit_at(cur_address);
             break;
         }
+        cur_address += unit_footprint(cur_address);
+    }
+}
 
-        past->_counter++;
-        past->_cur_block = past->_cur_block ? 0 : 1;
-        success = true;
-        /** Past is now ready for writing */
-    } while(0);
-    lock_flash();
-    return success;
+/**
+  * @brief Get the number of bytes a unit takes in flash
+  * @param address address of the unit (points to id)
+  * @retval size of the header and the word aligned data
+  */
+static uint32_t unit_footprint(uint32_t address)
+{
+    uint32_t size = flash_read32(address + UNIT_SIZE_OFFSET);
+    if (size % 4) {
+        size += 4 - (size % 4);
+    }
+    return UNIT_DATA_OFFSET + size;
 }
 
 /**
@@ -546,47 +1380,3 @@ static inline uint32_t flash_read32(uint32_t address)
     return *p;
 #endif // DPS_EMULATOR
 }
-
-/**
-  * @brief Copy all valid parameters from src to dst
-  * @param past pointer to an initialized past structure
-  * @param src_base source base address
-  * @param dst_base destination base address
-  * @retval true if copying was successful
-  */
-static bool copy_parameters(past_t *past, uint32_t src_base, uint32_t dst_base)
-{
-    bool success = true;
-    uint32_t src = src_base + HEADER_FIRST_UNIT_OFFSET;
-    uint32_t dst = dst_base + HEADER_FIRST_UNIT_OFFSET;
-    do {
-        uint32_t id = flash_read32(src);
-        if (id == PAST_UNIT_ID_END) {
-            break;
-        }
-        int32_t size = flash_read32(src + UNIT_SIZE_OFFSET);
-        if (size <= 0) {
-            break;
-        }
-        uint32_t aligned_size = size;
-        if (aligned_size % 4) {
-            aligned_size += 4 - aligned_size % 4;
-        }
-        if (id != 0) {
-            for (uint32_t i = 0; i < aligned_size / 4 && success; i++) {
-                success &= flash_write32(dst + UNIT_DATA_OFFSET + 4*i, flash_read32(src + UNIT_DATA_OFFSET + 4*i));
-            }
-            success &= flash_write32(dst + UNIT_SIZE_OFFSET, size);
-            success &= flash_write32(dst, id);
-            if (!success) {
-                break;
-            }
-            dst += UNIT_DATA_OFFSET + aligned_size;
-        }
-        src += UNIT_DATA_OFFSET + aligned_size;
-    } while (src < src_base + PAST_BLOCK_SIZE);
-    if (success) {
-        past->_end_addr = dst;
-    }
-    return success;
-}
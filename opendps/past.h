@@ -30,16 +30,94 @@
 
 typedef uint32_t past_id_t;
 
+/** Number of flash pages of PAST_BLOCK_SIZE bytes the past rotates over */
+#ifndef PAST_NUM_BLOCKS
+ #define PAST_NUM_BLOCKS  (2)
+#endif
+
+#define PAST_BLOCK_SIZE  (1024)  //STM32F100
+
+/** Number of units the RAM index of a past can hold, units beyond that are
+  * found by scanning the flash block. Each entry uses 6 bytes of RAM. */
+#ifndef PAST_INDEX_SIZE
+ #define PAST_INDEX_SIZE  (24)
+#endif
+
+/** Flash taken by a unit of length bytes, for sizing transactions */
+#define PAST_UNIT_SIZE(length)  (8 + (((length) + 3) & ~3))
+
+/** Number of units with an old version a transaction can rewrite */
+#ifndef PAST_TXN_UNITS
+ #define PAST_TXN_UNITS  (8)
+#endif
+
+/** Bytes kept free in the current block for transactions begun with
+  * past_begin_reserved(...), which never garbage collect and so can commit
+  * within the hold-up time of a power loss */
+#ifndef PAST_RESERVE_SIZE
+ #define PAST_RESERVE_SIZE  (0)
+#endif
+
+#ifdef CONFIG_PAST_INCREMENTAL_GC
+/** past_gc_step() starts compacting the current block into the next one when
+  * less than this many bytes remain, if that frees at least as many */
+#ifndef PAST_GC_THRESHOLD
+ #define PAST_GC_THRESHOLD  (PAST_BLOCK_SIZE / 4)
+#endif
+#endif // CONFIG_PAST_INCREMENTAL_GC
+
+/** Bytes of units each garbage collection step copies at most, the step stops
+  * after the unit that reaches it. With CONFIG_PAST_INCREMENTAL_GC, units
+  * rewritten meanwhile are copied again, so this must outpace the writes. */
+#ifndef PAST_GC_STEP_SIZE
+ #define PAST_GC_STEP_SIZE  (64)
+#endif
+
+#ifdef CONFIG_PAST_WRITE_BACK
+/** Number of units that can be pending flush in the write-back cache, and
+  * the largest unit the cache takes. Larger units are written through. */
+#ifndef PAST_CACHE_SLOTS
+ #define PAST_CACHE_SLOTS  (6)
+#endif
+#if PAST_CACHE_SLOTS > 8
+ #error "PAST_CACHE_SLOTS is limited by the 8 bit dirty mask"
+#endif
+#ifndef PAST_CACHE_UNIT_SIZE
+ #define PAST_CACHE_UNIT_SIZE  (8)
+#endif
+#endif // CONFIG_PAST_WRITE_BACK
+
 /** A structure describing a past instace. The user is expected to fill out the
-  * blocks array before calling past_init(...). The other fields must not be
-  * touched.
+  * blocks array (PAST_NUM_BLOCKS flash pages) before calling past_init(...).
+  * The other fields must not be touched.
   */
 typedef struct {
-    uint32_t blocks[2];
+    uint32_t blocks[PAST_NUM_BLOCKS];
     uint32_t _cur_block;
     uint32_t _counter;
     uint32_t _end_addr;
     bool _valid;
+    bool _index_complete; /** All units of the current block are indexed */
+    uint8_t _index_count;
+    past_id_t _index_id[PAST_INDEX_SIZE];    /** Sorted unit ids */
+    uint16_t _index_offset[PAST_INDEX_SIZE]; /** Unit offsets in the current block */
+    uint16_t _garbage;  /** Bytes taken by erased units in the current block */
+    uint8_t _gc_state;  /** Garbage collection in progress */
+    uint8_t _gc_block;  /** Block the units are copied to */
+    uint32_t _gc_src;   /** Next unit to copy */
+    uint32_t _gc_dst;   /** Where the next unit is copied */
+    uint8_t _txn_state; /** Transaction in progress */
+    uint8_t _txn_count;
+    bool _txn_failed;
+    uint32_t _txn_addr; /** Address of the transaction marker */
+    uint32_t _txn_end;  /** End of the space reserved for the transaction */
+    uint16_t _txn_old[PAST_TXN_UNITS]; /** Offsets of the versions to erase at commit */
+#ifdef CONFIG_PAST_WRITE_BACK
+    uint8_t _cache_dirty;                    /** Bit mask of slots pending flush */
+    uint8_t _cache_length[PAST_CACHE_SLOTS];
+    past_id_t _cache_id[PAST_CACHE_SLOTS];
+    uint32_t _cache_data[PAST_CACHE_SLOTS][PAST_CACHE_UNIT_SIZE / 4];
+#endif // CONFIG_PAST_WRITE_BACK
 } past_t;
 
 /**
@@ -89,4 +167,123 @@ bool past_erase_unit(past_t *past, past_id_t id);
   */
 bool past_format(past_t *past);
 
+/**
+  * @brief Get the number of times a past block has been erased
+  * @param past An initialized past structure
+  * @param block index of the block in the blocks array
+  * @retval erase count of the block, 0 if unknown
+  */
+uint32_t past_erase_count(past_t *past, uint32_t block);
+
+/**
+  * @brief Begin a transaction. The units written until past_commit(...) are
+  *        kept, or lost, all together should power be lost. Only writes are
+  *        part of the transaction and the flash stays unlocked until the
+  *        commit.
+  * @param past An initialized past structure
+  * @param length Total size of the units to write, the sum of PAST_UNIT_SIZE
+  *        of each of them
+  * @retval true if the space was reserved and the transaction begun
+  *         false if there is no room or a transaction is already open
+  */
+bool past_begin(past_t *past, uint32_t length);
+
+/**
+  * @brief Commit the transaction, erasing the old versions of the units
+  *        written. If any of the writes failed, they are all undone.
+  * @param past An initialized past structure
+  * @retval true if the transaction was committed
+  *         false if it was rolled back or there is no transaction
+  */
+bool past_commit(past_t *past);
+
+/**
+  * @brief Begin a transaction like past_begin(...) does, but without garbage
+  *        collecting and with the PAST_RESERVE_SIZE bytes kept free in the
+  *        current block available. For saving state when power is lost,
+  *        only page programming is then needed.
+  * @param past An initialized past structure
+  * @param length Total size of the units to write, see PAST_UNIT_SIZE
+  * @retval true if the space was reserved and the transaction begun
+  *         false if there is no room or a transaction is already open
+  */
+bool past_begin_reserved(past_t *past, uint32_t length);
+
+#ifdef CONFIG_PAST_INCREMENTAL_GC
+/**
+  * @brief Do a bounded amount of garbage collection, to be called
+  *        periodically. Each call erases the next block or copies up to
+  *        PAST_GC_STEP_SIZE bytes of units to it, the current block being used as before until the last unit has
+  *        been copied. A write that does not fit completes the garbage
+  *        collection at once.
+  * @param past An initialized past structure
+  * @retval true if a garbage collection is in progress
+  *         false if there is nothing to do, or it failed
+  */
+bool past_gc_step(past_t *past);
+#endif // CONFIG_PAST_INCREMENTAL_GC
+
+#ifdef CONFIG_PAST_WRITE_BACK
+/**
+  * @brief Write unit to the RAM write-back cache of the past. The unit is
+  *        written to flash by the next past_flush(...), unless it is written
+  *        again before that. Units larger than PAST_CACHE_UNIT_SIZE are
+  *        written through, and a full cache is flushed first, or the unit
+  *        written through in an open transaction.
+  * @param past An initialized past structure
+  * @param id Unit id to write
+  * @param data Data to write
+  * @param length Size of data
+  * @retval true if the unit was cached or written
+  *         false if writing failed or the past was full
+  */
+bool past_write_unit_deferred(past_t *past, past_id_t id, void *data, uint32_t length);
+
+/**
+  * @brief Write the units pending in the write-back cache to flash, in one
+  *        transaction, or in the open one whose length included
+  *        past_cache_size(...)
+  * @param past An initialized past structure
+  * @retval true if all pending units were written
+  *         false if writing any of them failed
+  */
+bool past_flush(past_t *past);
+
+/**
+  * @brief Get the flash the units pending in the write-back cache take
+  * @param past An initialized past structure
+  * @retval the sum of PAST_UNIT_SIZE of the pending units
+  */
+uint32_t past_cache_size(past_t *past);
+
+/**
+  * @brief Check if there are units pending flush
+  * @param past An initialized past structure
+  * @retval true if past_flush(...) has something to write
+  */
+bool past_is_dirty(past_t *past);
+#endif // CONFIG_PAST_WRITE_BACK
+
+#ifdef CONFIG_PAST_TRANSFER
+/**
+  * @brief Walk the units in flash, in the order they were written. Units
+  *        pending in the write-back cache are not seen, flush first.
+  * @param past An initialized past structure
+  * @param cursor 0 to get the first unit, updated for the next call
+  * @param id the id of the unit
+  * @param data the data of the unit, in flash
+  * @param length the size of the unit
+  * @retval true if a unit was found
+  *         false after the last one, or while a transaction is open
+  */
+bool past_next_unit(past_t *past, uint32_t *cursor, past_id_t *id, const void **data, uint32_t *length);
+#endif // CONFIG_PAST_TRANSFER
+
+#ifndef CONFIG_PAST_WRITE_BACK
+ #define past_write_unit_deferred  past_write_unit
+ #define past_flush(past)  (true)
+ #define past_is_dirty(past)  (false)
+ #define past_cache_size(past)  (0)
+#endif // CONFIG_PAST_WRITE_BACK
+
 #endif // __PAST_H__
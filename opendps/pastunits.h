@@ -34,6 +34,26 @@ typedef enum {
     /** stored as strings */
     past_boot_git_hash,
     past_app_git_hash,
+    /** stored as pwrctl_calibration_t */
+    past_calibration,
+    /** stored as arrays of pwrctl_cal_point_t, in pwrctl_cal_table_t order */
+    past_cal_v_out_adc,
+    past_cal_v_out_dac,
+    past_cal_i_out_adc,
+    past_cal_i_out_dac,
+    /** stored as energy_counters_t */
+    past_energy,
+    /** stored as i_offset_record_t, see opendps.c */
+    past_i_out_offset,
+    /** stored as an array of alarm_rule_t */
+    past_alarms,
+    /** stored as [length:32] | [crc:16] | [version:16] by the boot when an
+    upgrade succeeds, see dpsboot.c */
+    past_app_image,
+    /** stored as the [version:16] of past_app_image the boot found intact */
+    past_app_verified,
+    /** stored as histogram_t */
+    past_histogram,
     /** A past unit who's precense indicates we have a non finished upgrade and
     must not boot */
     past_upgrade_started = 0xff
@@ -1,36 +1,18 @@
+const uint8_t power_palette[] = {
+  0x00, 0x00, 0x10, 0x82, 0x21, 0x04, 0x31, 0x86, 0x42, 0x08, 0x52, 0xaa, 0x63, 0x2c, 0x73, 0xae,
+  0x84, 0x30, 0x94, 0xb2, 0xa5, 0x54, 0xb5, 0xd6, 0xc6, 0x58, 0xd6, 0xda, 0xe7, 0x5c, 0xff, 0xff,
+};
 const uint8_t power[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x4c,
-  0x63, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0xf7, 0xbe,
-  0xef, 0x9d, 0x18, 0xc3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x21, 0x04, 0xf7, 0xbe,
-  0xef, 0x9d, 0x18, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x08, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x4a, 0x89, 0xd6, 0xda, 0x8c, 0x71, 0x00, 0x00, 0x21, 0x04, 0xf7, 0xbe,
-  0xef, 0x9d, 0x18, 0xe3, 0x00, 0x00, 0x8c, 0x91, 0xd6, 0xda, 0x4a, 0x69, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x31, 0xa6, 0xef, 0x9d, 0xff, 0xff, 0x94, 0xb2, 0x00, 0x00, 0x21, 0x04, 0xf7, 0xbe,
-  0xef, 0x9d, 0x18, 0xe3, 0x00, 0x00, 0x9c, 0xd3, 0xff, 0xff, 0xef, 0x7d, 0x31, 0x86, 0x00, 0x00,
-  0x00, 0x20, 0xbd, 0xf7, 0xff, 0xff, 0xad, 0x75, 0x08, 0x41, 0x00, 0x00, 0x21, 0x04, 0xf7, 0xbe,
-  0xef, 0x9d, 0x18, 0xe3, 0x00, 0x00, 0x08, 0x41, 0xb5, 0x96, 0xff, 0xff, 0xb5, 0xd6, 0x00, 0x00,
-  0x31, 0xa6, 0xf7, 0xde, 0xef, 0x7d, 0x21, 0x24, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0xf7, 0xde,
-  0xf7, 0xbe, 0x18, 0xc3, 0x00, 0x00, 0x00, 0x00, 0x29, 0x45, 0xef, 0x9d, 0xf7, 0xde, 0x31, 0x86,
-  0x7b, 0xcf, 0xff, 0xff, 0xb5, 0xd6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb,
-  0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xf7, 0xff, 0xff, 0x63, 0x4c,
-  0xdf, 0x1b, 0xff, 0xff, 0x9c, 0xf3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xff, 0x84, 0x30,
-  0x7b, 0xcf, 0xff, 0xff, 0xb5, 0xd6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xf7, 0xff, 0xff, 0x63, 0x4c,
-  0x31, 0xa6, 0xf7, 0xde, 0xef, 0x7d, 0x21, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x45, 0xef, 0x9d, 0xf7, 0xde, 0x31, 0x86,
-  0x00, 0x20, 0xbd, 0xf7, 0xff, 0xff, 0xad, 0x75, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xb5, 0xb6, 0xff, 0xff, 0xb5, 0xd6, 0x00, 0x00,
-  0x00, 0x00, 0x31, 0xa6, 0xef, 0x7d, 0xff, 0xff, 0xad, 0x75, 0x21, 0x44, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x29, 0x45, 0xb5, 0x96, 0xff, 0xff, 0xef, 0x7d, 0x31, 0x86, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x4a, 0x69, 0xe7, 0x5c, 0xff, 0xff, 0xef, 0x9d, 0xad, 0x75, 0x84, 0x30,
-  0x84, 0x30, 0xad, 0x95, 0xef, 0x9d, 0xff, 0xff, 0xe7, 0x5c, 0x4a, 0x49, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0xa5, 0x54, 0xef, 0x9d, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xef, 0x9d, 0xa5, 0x34, 0x29, 0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x24, 0x5a, 0xcb, 0x94, 0xb2,
-  0x94, 0xb2, 0x5a, 0xcb, 0x21, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+  0x60, 0x16, 0xc0, 0x02, 0x0f, 0x0e, 0x01, 0xb0, 0x02, 0x0f, 0x0e, 0x02, 0x70, 0x05, 0x0d, 0x08,
+  0x00, 0x02, 0x0f, 0x0e, 0x02, 0x00, 0x09, 0x0d, 0x05, 0x20, 0x03, 0x0e, 0x0f, 0x09, 0x00, 0x02,
+  0x0f, 0x0e, 0x02, 0x00, 0x09, 0x0f, 0x0e, 0x03, 0x10, 0x0b, 0x0f, 0x0a, 0x10, 0x02, 0x0f, 0x0e,
+  0x02, 0x10, 0x0a, 0x0f, 0x0b, 0x00, 0x03, 0x0f, 0x0e, 0x02, 0x10, 0x02, 0x1f, 0x01, 0x10, 0x02,
+  0x0e, 0x0f, 0x03, 0x07, 0x0f, 0x0b, 0x30, 0x15, 0x30, 0x0b, 0x0f, 0x06, 0x0d, 0x0f, 0x09, 0x90,
+  0x0a, 0x0f, 0x08, 0x07, 0x0f, 0x0b, 0x90, 0x0b, 0x0f, 0x06, 0x03, 0x0f, 0x0e, 0x02, 0x70, 0x02,
+  0x0e, 0x0f, 0x03, 0x00, 0x0b, 0x0f, 0x0a, 0x70, 0x0b, 0x0f, 0x0b, 0x10, 0x03, 0x0e, 0x0f, 0x0a,
+  0x02, 0x30, 0x02, 0x0a, 0x0f, 0x0e, 0x03, 0x20, 0x05, 0x0e, 0x0f, 0x0e, 0x0a, 0x18, 0x0a, 0x0e,
+  0x0f, 0x0e, 0x04, 0x40, 0x03, 0x0a, 0x0e, 0x3f, 0x0e, 0x0a, 0x02, 0x70, 0x02, 0x05, 0x19, 0x05,
+  0x02, 0x40,
 };
 #define power_width  16
 #define power_height  16
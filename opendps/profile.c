@@ -0,0 +1,93 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <cortex.h>
+#include <dwt.h>
+#include "profile.h"
+#include "dbg_printf.h"
+
+/** Counters are updated from ISRs, their preemption included */
+static profile_counter_t counters[prof_max];
+
+/**
+  * @brief Enable the DWT cycle counter and clear the counters
+  * @retval none
+  */
+void profile_init(void)
+{
+    if (!dwt_enable_cycle_counter()) {
+        dbg_printf("Error: no DWT cycle counter\n");
+    }
+    profile_reset();
+}
+
+/**
+  * @brief Add a measurement, may be called from ISRs
+  * @param point the code path measured
+  * @param cycles the number of cycles it took
+  * @retval none
+  */
+void profile_add(profile_point_t point, uint32_t cycles)
+{
+    if (point >= prof_max) {
+        return;
+    }
+    uint32_t primask = cm_mask_interrupts(1);
+    profile_counter_t *c = &counters[point];
+    if (!c->count || cycles < c->min) {
+        c->min = cycles;
+    }
+    if (cycles > c->max) {
+        c->max = cycles;
+    }
+    c->count++;
+    c->total += cycles;
+    cm_mask_interrupts(primask);
+}
+
+/**
+  * @brief Get a consistent copy of the counters
+  * @param copy prof_max counters are copied here
+  * @retval none
+  */
+void profile_get(profile_counter_t *copy)
+{
+    uint32_t primask = cm_mask_interrupts(1);
+    memcpy(copy, counters, sizeof(counters));
+    cm_mask_interrupts(primask);
+}
+
+/**
+  * @brief Clear all counters
+  * @retval none
+  */
+void profile_reset(void)
+{
+    uint32_t primask = cm_mask_interrupts(1);
+    memset(counters, 0, sizeof(counters));
+    cm_mask_interrupts(primask);
+}
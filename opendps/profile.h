@@ -0,0 +1,100 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __PROFILE_H__
+#define __PROFILE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** The code paths measured with the DWT cycle counter. Keep in sync with
+  * profile_points in dpsctl/protocol.py */
+typedef enum {
+    prof_adc_isr = 0,
+    prof_usart_isr,
+    prof_button_isr,
+    prof_spi_transceive,
+    prof_uui_refresh,
+    prof_handle_frame,
+    prof_past_write,
+    prof_max
+} profile_point_t;
+
+/** Cycles spent in one code path, including the time of any interrupts
+  * preempting it */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+} profile_counter_t;
+
+#ifdef CONFIG_PROFILING
+
+#include <dwt.h>
+
+/** Start measuring in the current block */
+#define PROFILE_START() \
+    uint32_t _prof_start = dwt_read_cycle_counter()
+
+/** Record the cycles since PROFILE_START() in the same block, to be used
+  * before every return of the measured code */
+#define PROFILE_END(point) \
+    profile_add(point, dwt_read_cycle_counter() - _prof_start)
+
+/**
+  * @brief Enable the DWT cycle counter and clear the counters
+  * @retval none
+  */
+void profile_init(void);
+
+/**
+  * @brief Add a measurement, may be called from ISRs
+  * @param point the code path measured
+  * @param cycles the number of cycles it took
+  * @retval none
+  */
+void profile_add(profile_point_t point, uint32_t cycles);
+
+/**
+  * @brief Get a consistent copy of the counters
+  * @param copy prof_max counters are copied here
+  * @retval none
+  */
+void profile_get(profile_counter_t *copy);
+
+/**
+  * @brief Clear all counters
+  * @retval none
+  */
+void profile_reset(void);
+
+#else // CONFIG_PROFILING
+
+#define PROFILE_START()
+#define PROFILE_END(point)
+
+#endif // CONFIG_PROFILING
+
+#endif // __PROFILE_H__
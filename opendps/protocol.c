@@ -24,70 +24,266 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include <string.h>
 #include "protocol.h"
 #include "uframe.h"
 
 
 // Boiler plate code
-#define COPY_FRAME_RETURN() \
-	if (_length <= length) { \
-		memcpy((void*) frame, (void*) _buffer, _length); \
-		return _length; \
-	} else { \
+/** The frames are packed straight into the caller's buffer, which must hold
+  * a frame of 'payload' bytes fully escaped */
+#define DECLARE_FRAME_IN_BUFFER(payload) \
+	if (length < FRAME_OVERHEAD(payload)) { \
 		return 0; \
-	}
+	} \
+	DECLARE_FRAME_AT(frame, length);
 
 uint32_t protocol_create_response(uint8_t *frame, uint32_t length, command_t cmd, uint8_t success)
 {
-	DECLARE_FRAME(MAX_FRAME_LENGTH);
+	DECLARE_FRAME_IN_BUFFER(2);
 	PACK8(cmd_response | cmd);
 	PACK8(success);
 	FINISH_FRAME();
-	COPY_FRAME_RETURN();
+	return _length;
 }
 
 uint32_t protocol_create_ping(uint8_t *frame, uint32_t length)
 {
-	DECLARE_FRAME(MAX_FRAME_LENGTH);
+	DECLARE_FRAME_IN_BUFFER(1);
 	PACK8(cmd_ping);
 	FINISH_FRAME();
-	COPY_FRAME_RETURN();
+	return _length;
 }
 
 uint32_t protocol_create_status(uint8_t *frame, uint32_t length)
 {
-	DECLARE_FRAME(MAX_FRAME_LENGTH);
+	DECLARE_FRAME_IN_BUFFER(1);
 	PACK8(cmd_query);
 	FINISH_FRAME();
-	COPY_FRAME_RETURN();
+	return _length;
+}
+
+uint32_t protocol_create_query_response(uint8_t *frame, uint32_t length, uint16_t v_in, uint16_t v_out_setting, uint16_t v_out, uint16_t i_out, uint16_t i_limit, uint8_t power_enabled)
+{
+	DECLARE_FRAME_IN_BUFFER(13);
+	PACK8(cmd_response | cmd_query);
+	PACK8(1); // Always success
+	PACK16(v_in);
+	PACK16(v_out_setting);
+	PACK16(v_out);
+	PACK16(i_out);
+	PACK16(i_limit);
+	PACK8(!!power_enabled);
+	FINISH_FRAME();
+	return _length;
 }
 
 uint32_t protocol_create_wifi_status(uint8_t *frame, uint32_t length, wifi_status_t status)
 {
-	DECLARE_FRAME(MAX_FRAME_LENGTH);
+	DECLARE_FRAME_IN_BUFFER(2);
 	PACK8(cmd_wifi_status);
 	PACK8(status);
 	FINISH_FRAME();
-	COPY_FRAME_RETURN();
+	return _length;
 }
 
 uint32_t protocol_create_lock(uint8_t *frame, uint32_t length, uint8_t locked)
 {
-	DECLARE_FRAME(MAX_FRAME_LENGTH);
+	DECLARE_FRAME_IN_BUFFER(2);
 	PACK8(cmd_lock);
 	PACK8(!!locked);
 	FINISH_FRAME();
-	COPY_FRAME_RETURN();
+	return _length;
 }
 
 uint32_t protocol_create_ocp(uint8_t *frame, uint32_t length, uint16_t i_cut)
 {
-	DECLARE_FRAME(MAX_FRAME_LENGTH);
+	DECLARE_FRAME_IN_BUFFER(3);
 	PACK8(cmd_ocp_event);
 	PACK16(i_cut);
 	FINISH_FRAME();
-	COPY_FRAME_RETURN();
+	return _length;
+}
+
+uint32_t protocol_create_protection_event(uint8_t *frame, uint32_t length, protection_event_t protection, uint32_t value)
+{
+	DECLARE_FRAME_IN_BUFFER(6);
+	PACK8(cmd_protection_event);
+	PACK8(protection);
+	PACK32(value);
+	FINISH_FRAME();
+	return _length;
+}
+
+uint32_t protocol_create_temperature_event(uint8_t *frame, uint32_t length, uint8_t alarm, int16_t temp1, int16_t temp2)
+{
+	DECLARE_FRAME_IN_BUFFER(6);
+	PACK8(cmd_temperature_event);
+	PACK8(!!alarm);
+	PACK16((uint16_t) temp1);
+	PACK16((uint16_t) temp2);
+	FINISH_FRAME();
+	return _length;
+}
+
+uint32_t protocol_create_alarm_event(uint8_t *frame, uint32_t length, uint8_t rule, uint32_t value)
+{
+	DECLARE_FRAME_IN_BUFFER(6);
+	PACK8(cmd_alarm_event);
+	PACK8(rule);
+	PACK32(value);
+	FINISH_FRAME();
+	return _length;
+}
+
+uint32_t protocol_create_change_event(uint8_t *frame, uint32_t length, uint8_t changed, const uint16_t *values)
+{
+	DECLARE_FRAME_IN_BUFFER(NOTIFY_EVENT_PAYLOAD);
+	PACK8(cmd_change_event);
+	PACK8(changed);
+	for (uint32_t field = 0; field < notify_max_field; field++) {
+		if (!(changed & (1 << field))) {
+			continue;
+		}
+		if (field < notify_setpoint) {
+			PACK8(values[NOTIFY_VALUE(field)]);
+		} else {
+			PACK16(values[NOTIFY_VALUE(field)]);
+		}
+		if (field == notify_setpoint) {
+			PACK16(values[NOTIFY_VALUE(field) + 1]);
+		}
+	}
+	FINISH_FRAME();
+	return _length;
+}
+
+/** Pack one channel of a sample as a delta from its previous value */
+#define PACK_DELTA(prev, cur) \
+	{ \
+		int32_t _delta = (int32_t) (cur) - (int32_t) (prev); \
+		if (_delta >= -127 && _delta <= 127) { \
+			PACK8((uint8_t) _delta); \
+		} else { \
+			PACK8(SAMPLE_DELTA_ESCAPE); \
+			PACK16(cur); \
+		} \
+	}
+
+/** Unpack one channel of a sample packed with PACK_DELTA */
+#define UNPACK_DELTA(prev, cur) \
+	{ \
+		uint8_t _b; \
+		UNPACK8(_b); \
+		if (_b == SAMPLE_DELTA_ESCAPE) { \
+			UNPACK16(cur); \
+		} else { \
+			(cur) = (prev) + (int8_t) _b; \
+		} \
+	}
+
+uint32_t protocol_create_sample_batch(uint8_t *frame, uint32_t length, uint32_t timestamp, uint16_t interval, const protocol_sample_t *samples, uint32_t count)
+{
+	if (count == 0 || count > 0xff) {
+		return 0;
+	}
+	/** The caller sizes the batch to its buffer with protocol_sample_delta_size() */
+	DECLARE_FRAME_IN_BUFFER(SAMPLE_BATCH_HEADER_SIZE);
+	PACK8(cmd_stream_data);
+	PACK32(timestamp);
+	PACK16(interval);
+	PACK8(count);
+	PACK16(samples[0].v_out);
+	PACK16(samples[0].i_out);
+	PACK16(samples[0].v_in);
+	for (uint32_t i = 1; i < count; i++) {
+		PACK_DELTA(samples[i-1].v_out, samples[i].v_out);
+		PACK_DELTA(samples[i-1].i_out, samples[i].i_out);
+		PACK_DELTA(samples[i-1].v_in, samples[i].v_in);
+	}
+	FINISH_FRAME();
+	return _length;
+}
+
+uint32_t protocol_create_mirror_data(uint8_t *frame, uint32_t length, uint8_t seq, const uint8_t *ops, uint32_t ops_len)
+{
+	DECLARE_FRAME_IN_BUFFER(2 + ops_len);
+	PACK8(cmd_mirror_data);
+	PACK8(seq);
+	for (uint32_t i = 0; i < ops_len; i++) {
+		PACK8(ops[i]);
+	}
+	FINISH_FRAME();
+	return _length;
+}
+
+bool protocol_baud_supported(uint32_t baud)
+{
+	switch (baud) {
+		case UART_DEFAULT_BAUD:
+		case 230400:
+		case 460800:
+		case 921600:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/*
+ * Bytes arriving at 'baud' while the pages a chunk of 'chunk_size' bytes
+ * completes are erased and programmed
+ */
+static uint32_t upgrade_arrival(uint32_t baud, uint32_t chunk_size)
+{
+	uint32_t pages = (chunk_size + UPGRADE_PAGE_SIZE - 1) / UPGRADE_PAGE_SIZE;
+	return baud / 10 * pages * (UPGRADE_PAGE_PROGRAM_US / 100) / 10000;
+}
+
+void protocol_upgrade_grant(upgrade_grant_t *grant, uint32_t baud, uint32_t rx_room)
+{
+	uint32_t fit;
+	if (grant->chunk_size > UPGRADE_MAX_CHUNK_SIZE) {
+		grant->chunk_size = UPGRADE_MAX_CHUNK_SIZE;
+	}
+	if (grant->window > UPGRADE_MAX_WINDOW) {
+		grant->window = UPGRADE_MAX_WINDOW;
+	}
+	grant->flags &= UPGRADE_FLAG_LZ | UPGRADE_FLAG_MANIFEST;
+	/** Skipping chunks needs offsets, whole pages and a raw image */
+	if (!grant->window || grant->chunk_size % UPGRADE_PAGE_SIZE || (grant->flags & UPGRADE_FLAG_LZ)) {
+		grant->flags &= ~UPGRADE_FLAG_MANIFEST;
+	}
+	grant->ack_early = true;
+	if (!(grant->flags & UPGRADE_FLAG_LZ)) {
+		/** A raw chunk is programmed in bounded time, any window will do if
+		  * what arrives meanwhile fits */
+		while (grant->window && grant->chunk_size > UPGRADE_PAGE_SIZE && upgrade_arrival(baud, grant->chunk_size) > rx_room) {
+			grant->chunk_size -= UPGRADE_PAGE_SIZE;
+		}
+		if (upgrade_arrival(baud, grant->chunk_size) <= rx_room) {
+			return;
+		}
+	}
+	/** Otherwise the window bounds what arrives */
+	if (grant->window && !(grant->flags & UPGRADE_FLAG_MANIFEST) && grant->chunk_size > UPGRADE_PIPELINE_CHUNK_SIZE) {
+		grant->chunk_size = UPGRADE_PIPELINE_CHUNK_SIZE;
+	}
+	fit = rx_room / UPGRADE_DATA_FRAME_SIZE(grant->chunk_size);
+	grant->ack_early = fit > 0;
+	if (grant->window > fit) {
+		grant->window = fit > 0 ? fit : 1;
+	}
+}
+
+static inline uint32_t delta_size(uint16_t prev, uint16_t cur)
+{
+	int32_t delta = (int32_t) cur - (int32_t) prev;
+	return (delta >= -127 && delta <= 127) ? 1 : 3;
+}
+
+uint32_t protocol_sample_delta_size(const protocol_sample_t *prev, const protocol_sample_t *cur)
+{
+	return delta_size(prev->v_out, cur->v_out) + delta_size(prev->i_out, cur->i_out) + delta_size(prev->v_in, cur->v_in);
 }
 
 bool protocol_unpack_response(uint8_t *payload, uint32_t length, command_t *cmd, uint8_t *success)
@@ -176,3 +372,82 @@ bool protocol_unpack_ocp(uint8_t *payload, uint32_t length, uint16_t *i_cut)
 	return _remain == 0 && cmd == cmd_ocp_event;
 }
 
+bool protocol_unpack_protection_event(uint8_t *payload, uint32_t length, protection_event_t *protection, uint32_t *value)
+{
+	command_t cmd;
+	DECLARE_UNPACK(payload, length);
+	UNPACK8(cmd);
+	UNPACK8(*protection);
+	UNPACK32(*value);
+	return _remain == 0 && cmd == cmd_protection_event;
+}
+
+bool protocol_unpack_temperature_event(uint8_t *payload, uint32_t length, uint8_t *alarm, int16_t *temp1, int16_t *temp2)
+{
+	command_t cmd;
+	uint16_t t1, t2;
+	DECLARE_UNPACK(payload, length);
+	UNPACK8(cmd);
+	UNPACK8(*alarm);
+	UNPACK16(t1);
+	UNPACK16(t2);
+	*temp1 = (int16_t) t1;
+	*temp2 = (int16_t) t2;
+	return _remain == 0 && cmd == cmd_temperature_event;
+}
+
+bool protocol_unpack_alarm_event(uint8_t *payload, uint32_t length, uint8_t *rule, uint32_t *value)
+{
+	command_t cmd;
+	DECLARE_UNPACK(payload, length);
+	UNPACK8(cmd);
+	UNPACK8(*rule);
+	UNPACK32(*value);
+	return _remain == 0 && cmd == cmd_alarm_event;
+}
+
+bool protocol_unpack_change_event(uint8_t *payload, uint32_t length, uint8_t *changed, uint16_t *values)
+{
+	command_t cmd;
+	DECLARE_UNPACK(payload, length);
+	UNPACK8(cmd);
+	UNPACK8(*changed);
+	for (uint32_t field = 0; field < notify_max_field; field++) {
+		if (!(*changed & (1 << field))) {
+			continue;
+		}
+		if (field < notify_setpoint) {
+			UNPACK8(values[NOTIFY_VALUE(field)]);
+		} else {
+			UNPACK16(values[NOTIFY_VALUE(field)]);
+		}
+		if (field == notify_setpoint) {
+			UNPACK16(values[NOTIFY_VALUE(field) + 1]);
+		}
+	}
+	return _remain == 0 && cmd == cmd_change_event;
+}
+
+bool protocol_unpack_sample_batch(uint8_t *payload, uint32_t length, uint32_t *timestamp, uint16_t *interval, protocol_sample_t *samples, uint32_t *count)
+{
+	command_t cmd;
+	uint8_t num;
+	DECLARE_UNPACK(payload, length);
+	UNPACK8(cmd);
+	UNPACK32(*timestamp);
+	UNPACK16(*interval);
+	UNPACK8(num);
+	if (cmd != cmd_stream_data || num == 0 || num > *count) {
+		return false;
+	}
+	UNPACK16(samples[0].v_out);
+	UNPACK16(samples[0].i_out);
+	UNPACK16(samples[0].v_in);
+	for (uint32_t i = 1; i < num; i++) {
+		UNPACK_DELTA(samples[i-1].v_out, samples[i].v_out);
+		UNPACK_DELTA(samples[i-1].i_out, samples[i].i_out);
+		UNPACK_DELTA(samples[i-1].v_in, samples[i].v_in);
+	}
+	*count = num;
+	return _remain == 0;
+}
@@ -53,6 +53,42 @@ typedef enum {
     cmd_set_parameters,
     cmd_list_parameters,
     cmd_temperature_report,
+    cmd_stream_start,
+    cmd_stream_stop,
+    cmd_stream_data,
+    cmd_set_calibration,
+    cmd_protection_event,
+    cmd_set_sequence,
+    cmd_energy_query,
+    cmd_capture_arm,
+    cmd_capture_read,
+    cmd_profile_dump,
+    cmd_set_parameter_values,
+    cmd_get_parameter_values,
+    cmd_temperature_event,
+    cmd_set_baud,
+    cmd_wave,
+    cmd_stack_usage,
+    cmd_mirror,
+    cmd_mirror_data,
+    cmd_warm_reboot,
+    cmd_arm,
+    cmd_fire,
+    cmd_past_export,
+    cmd_past_import,
+    cmd_stats,
+    cmd_set_alarms,
+    cmd_alarm_event,
+    cmd_stage_start, /** Handled by the wifi proxy, see "Staged upgrades" below */
+    cmd_stage_data,
+    cmd_stage_upgrade,
+    cmd_stage_status,
+    cmd_subscribe,
+    cmd_change_event,
+    cmd_set_and_measure,
+    cmd_histogram,
+    cmd_histogram_limits,
+    cmd_tagged = 0x40, /** Flags a request carrying a tag, see "Tagged requests" below */
     cmd_response = 0x80
 } command_t;
 
@@ -82,7 +118,8 @@ typedef enum {
     reason_past_failure, /** Past init failed */
     reason_bootcom, /** App told us via bootcom */
     reason_unfinished_upgrade, /** A previous unfinished sympathy, eh upgrade */
-    reason_app_start_failed /** App returned */
+    reason_app_start_failed, /** App returned */
+    reason_image_corrupt /** App does not have the crc of the latest upgrade */
 } upgrade_reason_t;
 
 /** Used in cmd_set_parameters responses */
@@ -92,11 +129,168 @@ typedef enum {
     sp_illegal_value
 } set_parameter_status_t;
 
+/** Used in cmd_protection_event frames */
+typedef enum {
+    protection_ovp = 0, /** Over voltage, value in millivolt */
+    protection_opp /** Over power, value in milliwatt */
+} protection_event_t;
+
 
 #define MAX_FRAME_LENGTH (2*16) // Based on the cmd_status reponse frame (fully escaped)
 
+/** The UART always starts at this rate, see cmd_set_baud */
+#define UART_DEFAULT_BAUD  (115200)
+/** A rate set with cmd_set_baud is dropped for UART_DEFAULT_BAUD unless a
+  * valid frame arrives at the new rate within BAUD_CONFIRM_MS, and whenever
+  * no valid frame has arrived for BAUD_IDLE_MS */
+#define BAUD_CONFIRM_MS  (1000)
+#define BAUD_IDLE_MS  (10000)
+
 #define INVALID_TEMPERATURE (0xffff)
 
+/** cmd_fire datagrams are multicast to this group and port, each wifi proxy
+  * forwards them to its DPS, see "Armed setpoints" below */
+#define FIRE_MCAST_GROUP  "239.255.77.1"
+#define FIRE_MCAST_PORT   (5007)
+
+/** Most settings bytes in a cmd_past_export response or cmd_past_import
+  * request, fitting a bulk frame */
+#define PAST_TRANSFER_CHUNK  (96)
+
+/** Output field of cmd_arm and cmd_set_and_measure leaving the output as it is */
+#define ARM_OUTPUT_UNCHANGED  (0xff)
+
+/** Most readings a cmd_set_and_measure averages */
+#define MEASURE_MAX_SAMPLES  (64)
+/** V_out must stay within the tolerance this long to have settled */
+#define MEASURE_SETTLE_MS  (3)
+
+/** Largest upgrade chunk the bootloader accepts, its frame buffer has to fit
+  * the 8K of RAM */
+#define UPGRADE_MAX_CHUNK_SIZE (2048)
+/** Largest number of upgrade data packets the host may have in flight */
+#define UPGRADE_MAX_WINDOW (4)
+
+/** Largest chunk of a cmd_stage_data frame, fitting the TCP frame buffer of
+  * the wifi proxy. Chunks but the last are a multiple of 4 bytes. */
+#define STAGE_MAX_CHUNK_SIZE (1024)
+
+/** State of the firmware staged on the wifi proxy, see cmd_stage_status */
+typedef enum {
+    stage_idle = 0, /** Nothing staged */
+    stage_receiving, /** The host is sending the image */
+    stage_staged, /** The image is stored and its crc checked */
+    stage_upgrading, /** The proxy is sending the image to the DPS */
+    stage_done, /** The DPS accepted the image */
+    stage_failed /** The image was bad or the upgrade failed, see the upgrade status */
+} stage_state_t;
+
+/** Flags of cmd_upgrade_start */
+#define UPGRADE_FLAG_LZ (1 << 0) /** The image is sent LZ compressed */
+#define UPGRADE_FLAG_MANIFEST (1 << 1) /** Page crcs follow, unchanged chunks are not sent */
+/** Size of the pages of the upgrade manifest */
+#define UPGRADE_PAGE_SIZE (1024)
+/** Shortest match of the LZ compressed image, see lz_decode() in lz.c */
+#define UPGRADE_LZ_MIN_MATCH (3)
+/** Longest erase and program of an UPGRADE_PAGE_SIZE page of the STM32F100,
+  * 40ms for the page and 70us per halfword */
+#define UPGRADE_PAGE_PROGRAM_US (40000 + UPGRADE_PAGE_SIZE / 2 * 70)
+/** Chunk size granted when the window bounds what the host sends while a
+  * chunk is programmed, two packets of it fit the bootloader's receive ring */
+#define UPGRADE_PIPELINE_CHUNK_SIZE (448)
+/** Bytes of an upgrade data packet of a chunk on the wire, allowing for the
+  * escapes of the odd SOF, EOF or DLE in the data */
+#define UPGRADE_DATA_FRAME_SIZE(chunk) ((chunk) + (chunk) / 16 + 9)
+
+/** What the host asks for in cmd_upgrade_start and what the bootloader grants */
+typedef struct {
+    uint16_t chunk_size;
+    uint8_t window;
+    uint8_t flags; /** UPGRADE_FLAG_* */
+    bool ack_early; /** A chunk is acked before it is programmed */
+} upgrade_grant_t;
+
+/** Bulk frames (streamed sample batches) may carry up to this many payload
+  * bytes. The host asks for a payload size in cmd_stream_start and the device
+  * selects the smaller of the two */
+#define MAX_BULK_FRAME_LENGTH (128)
+
+/** Number of calibration points fitting a cmd_set_calibration frame */
+#define CAL_POINTS_PER_FRAME  (6)
+
+/** Number of sequence steps fitting a cmd_set_sequence frame */
+#define SEQ_STEPS_PER_FRAME  (3)
+
+/** Number of alarm rules fitting a cmd_set_alarms frame */
+#define ALARM_RULES_PER_FRAME  (2)
+
+/** Number of samples in a cmd_capture_read response, fitting a bulk frame */
+#define CAPTURE_SAMPLES_PER_FRAME  (16)
+
+/** Bins of each channel of the load profile, the number of them in a
+  * cmd_histogram response and the number of I_out limits */
+#define HISTOGRAM_BINS            (32)
+#define HISTOGRAM_BINS_PER_FRAME  (16)
+#define HISTOGRAM_LIMITS          (4)
+
+/** Limits for telemetry streaming */
+#define STREAM_MIN_INTERVAL_MS  (5)
+#define STREAM_MAX_SAMPLES      (32)
+
+/** Size of a sample batch holding one sample, and the largest size each
+  * following sample may add (all three deltas escaped) */
+#define SAMPLE_BATCH_HEADER_SIZE  (1 + 4 + 2 + 1 + 3*2)
+#define SAMPLE_MAX_DELTA_SIZE     (3*3)
+
+/** Marks a sample delta that did not fit in 8 bits, the absolute 16 bit value follows */
+#define SAMPLE_DELTA_ESCAPE  (0x80)
+
+/** Fields of cmd_subscribe and cmd_change_event, a bit each in the field
+  * masks. They are packed in this order. */
+typedef enum {
+    notify_output = 0, /** Power out enabled <enabled:8> */
+    notify_function,   /** Function index <function:8> */
+    notify_lock,       /** Lock flags <flags:8>, see NOTIFY_LOCK_* */
+    notify_setpoint,   /** Output settings <V_out:16> <I_out:16>, mV and mA */
+    notify_v_out,      /** Measured <V_out:16>, mV */
+    notify_i_out,      /** Measured <I_out:16>, mA */
+    notify_v_in,       /** Measured <V_in:16>, mV */
+    notify_max_field
+} notify_field_t;
+
+#define NOTIFY_LOCK_UI           (1 << 0) /** The controls are locked */
+#define NOTIFY_LOCK_TEMPERATURE  (1 << 1) /** Power out is locked by the temperature alarm */
+
+/** Number of values of the fields, the setpoint has two, and the index of
+  * the (first) value of a field */
+#define NOTIFY_MAX_VALUES  (notify_max_field + 1)
+#define NOTIFY_VALUE(field)  ((field) + ((field) > notify_setpoint))
+/** Largest payload of a cmd_change_event */
+#define NOTIFY_EVENT_PAYLOAD  (2 + 3*1 + 5*2)
+
+/** How often the DPS looks for changes of the subscribed fields */
+#define NOTIFY_INTERVAL_MS  (10)
+
+/** Drawing commands of cmd_mirror_data frames, positions and sizes in
+  * pixels */
+typedef enum {
+    mirror_op_clear = 1, /** [op] */
+    mirror_op_fill,      /** [op] [x] [y] [w] [h] [color:16] */
+    mirror_op_glyph,     /** [op] [font size] [char] [x] [y] [w] [h] [highlight] */
+    mirror_op_blit,      /** [op] [x] [y] [w] [h], the pixels are not sent */
+    mirror_op_invert,    /** [op] [invert] */
+} mirror_op_t;
+
+/** Size of the largest mirror command */
+#define MIRROR_MAX_OP_SIZE  (8)
+
+/** One telemetry sample in mV and mA */
+typedef struct {
+    uint16_t v_out;
+    uint16_t i_out;
+    uint16_t v_in;
+} protocol_sample_t;
+
 /*
  * Helpers for creating frames.
  *
@@ -115,6 +309,31 @@ uint32_t protocol_create_query_response(uint8_t *frame, uint32_t length, uint16_
 uint32_t protocol_create_wifi_status(uint8_t *frame, uint32_t length, wifi_status_t status);
 uint32_t protocol_create_lock(uint8_t *frame, uint32_t length, uint8_t locked);
 uint32_t protocol_create_ocp(uint8_t *frame, uint32_t length, uint16_t i_cut);
+uint32_t protocol_create_protection_event(uint8_t *frame, uint32_t length, protection_event_t protection, uint32_t value);
+uint32_t protocol_create_temperature_event(uint8_t *frame, uint32_t length, uint8_t alarm, int16_t temp1, int16_t temp2);
+uint32_t protocol_create_alarm_event(uint8_t *frame, uint32_t length, uint8_t rule, uint32_t value);
+/* 'values' holds NOTIFY_MAX_VALUES values of the fields in notify_field_t order */
+uint32_t protocol_create_change_event(uint8_t *frame, uint32_t length, uint8_t changed, const uint16_t *values);
+uint32_t protocol_create_sample_batch(uint8_t *frame, uint32_t length, uint32_t timestamp, uint16_t interval, const protocol_sample_t *samples, uint32_t count);
+uint32_t protocol_create_mirror_data(uint8_t *frame, uint32_t length, uint8_t seq, const uint8_t *ops, uint32_t ops_len);
+
+/*
+ * Return true if 'baud' is a rate cmd_set_baud may switch to
+ */
+bool protocol_baud_supported(uint32_t baud);
+
+/*
+ * Turn the chunk size, window and flags in 'grant' that a host asked for into
+ * what a bootloader with 'rx_room' bytes of receive buffer grants at 'baud',
+ * see "DPS upgrade sessions" below
+ */
+void protocol_upgrade_grant(upgrade_grant_t *grant, uint32_t baud, uint32_t rx_room);
+
+/*
+ * Return the number of payload bytes 'cur' will add to a sample batch where
+ * 'prev' is the preceeding sample.
+ */
+uint32_t protocol_sample_delta_size(const protocol_sample_t *prev, const protocol_sample_t *cur);
 
 /*
  * Helpers for unpacking frames.
@@ -131,7 +350,13 @@ bool protocol_unpack_query_response(uint8_t *payload, uint32_t length, uint16_t
 bool protocol_unpack_wifi_status(uint8_t *payload, uint32_t length, wifi_status_t *status);
 bool protocol_unpack_lock(uint8_t *payload, uint32_t length, uint8_t *locked);
 bool protocol_unpack_ocp(uint8_t *payload, uint32_t length, uint16_t *i_cut);
+bool protocol_unpack_protection_event(uint8_t *payload, uint32_t length, protection_event_t *protection, uint32_t *value);
+bool protocol_unpack_temperature_event(uint8_t *payload, uint32_t length, uint8_t *alarm, int16_t *temp1, int16_t *temp2);
+bool protocol_unpack_alarm_event(uint8_t *payload, uint32_t length, uint8_t *rule, uint32_t *value);
+bool protocol_unpack_change_event(uint8_t *payload, uint32_t length, uint8_t *changed, uint16_t *values);
 bool protocol_unpack_upgrade_start(uint8_t *payload, uint32_t length, uint16_t *chunk_size, uint16_t *crc);
+/* On entry 'count' is the capacity of 'samples', on return the number of samples unpacked */
+bool protocol_unpack_sample_batch(uint8_t *payload, uint32_t length, uint32_t *timestamp, uint16_t *interval, protocol_sample_t *samples, uint32_t *count);
 
 
 /*
@@ -188,6 +413,11 @@ bool protocol_unpack_upgrade_start(uint8_t *payload, uint32_t length, uint16_t *
  *  HOST:   [cmd_set_parameters <param 1> \0 <value 1> \0 <param 2> \0 <value 2> ... ]
  *  DPS:    [cmd_response | cmd_set_parameters] <param 1 > <set_parameter_status_t 1> <param 2> <set_parameter_status_t 2> ...
  *
+ * The parameters of one command are applied together: the output is updated
+ * once, with the voltage and current DACs written in the same cycle. If any
+ * parameter fails, none are applied, and the valid ones report
+ * ps_not_applied. This is true of cmd_set_parameter_values too.
+ *
  *
  * === Listing function parameters ===
  * This command replaces the old cmd_status command and returns a list of
@@ -203,6 +433,22 @@ bool protocol_unpack_upgrade_start(uint8_t *payload, uint32_t length, uint16_t *
  *  DPS:    [cmd_response | cmd_list_parameters] <param 1> \0 <value 1> \0 <param 2> \0 <value 2> ... ]
  *
  *
+ * === Setting and getting parameters by id ===
+ * The binary forms of cmd_set_parameters for scripts, without any string
+ * parsing on the device. The id of a parameter is its position in the
+ * cmd_list_parameters response, counting from 0, and values are signed 32 bit
+ * integers in the unit of the parameter.
+ *
+ *  HOST:   [cmd_set_parameter_values] ([<id:8>] [<value:32>])*
+ *  DPS:    [cmd_response | cmd_set_parameter_values] [1] [<set_parameter_status_t 1>] [<set_parameter_status_t 2>] ...
+ *
+ *  HOST:   [cmd_get_parameter_values]
+ *  DPS:    [cmd_response | cmd_get_parameter_values] [1] ([<id:8>] [<value:32>])*
+ *
+ * The get response holds the parameters of the current function that can be
+ * read.
+ *
+ *
  * === Receiving a temperature report ===
  * This command is used by a wifi companion with the ability to measure
  * temperature. Two temperatures are included as signed 16 bit integers x10
@@ -230,12 +476,66 @@ bool protocol_unpack_upgrade_start(uint8_t *payload, uint32_t length, uint16_t *
  *  DPS:    [cmd_response | cmd_lock] [1]
  *
  *
+ * === Tagged requests ===
+ * Responses are otherwise matched to requests by their command, which only
+ * works if the host keeps the order of its requests in mind. A host that
+ * wants to keep several requests in flight may set the cmd_tagged bit of the
+ * command and follow it with a tag of its choice. The response then carries
+ * the cmd_tagged bit and the same tag, the rest of the frames are unchanged.
+ *
+ *  HOST:   [cmd_tagged | cmd_ping] [<tag:8>]
+ *  DPS:    [cmd_response | cmd_tagged | cmd_ping] [<tag:8>] [1]
+ *
+ * Tagged and untagged requests may be mixed. Frames the DPS sends on its own
+ * (the events below and streamed samples) never have the cmd_response bit
+ * set. The bootloader does not know of tags.
+ *
+ *
+ * === Changing the UART baud rate ===
+ * The DPS and the host start at UART_DEFAULT_BAUD and the host may then move
+ * the link to any of 230400, 460800 or 921600 baud. The DPS responds at the
+ * current rate and switches once the response has been sent. <status> is 0
+ * if the rate is not supported, and the rate is then left unchanged.
+ *
+ *  HOST:   [cmd_set_baud] [<baud:32>]
+ *  DPS:    [cmd_response | cmd_set_baud] [<status>]
+ *
+ * The host confirms the new rate by sending any frame, usually cmd_ping, at
+ * that rate within BAUD_CONFIRM_MS. If no valid frame is received in time,
+ * or none for BAUD_IDLE_MS later on, the DPS goes back to UART_DEFAULT_BAUD
+ * so a host that went away does not leave it unreachable. Hosts that are
+ * done with the link set UART_DEFAULT_BAUD again. The bootloader supports the
+ * command as well, starting at UART_DEFAULT_BAUD after the app restarts into
+ * it, so the rate is negotiated again after cmd_upgrade_start.
+ *
+ *
  * === Overcurrent protection event controls ===
  * If the DPS detects overcurrent, it will send this frame with the current
  * that caused the protection to kick in (in milliamperes).
  * The DPS does not expect a response
  *
- *  DPS:    [cmd_ocp_event] [I_cut(7:0)] [I_cut(15:8)]
+ *  DPS:    [cmd_ocp_event] [I_cut(15:8)] [I_cut(7:0)]
+ *  HOST:   none
+ *
+ *
+ * === Over voltage and over power protection events ===
+ * If the DPS cuts power out because V_out or the output power exceeded the
+ * limit of the active function (its 'ovp' and 'opp' parameters), it will send
+ * this frame with the protection (protection_event_t) and the voltage (in
+ * millivolts) or power (in milliwatts) that caused it to kick in.
+ * The DPS does not expect a response
+ *
+ *  DPS:    [cmd_protection_event] [<protection_event_t:8>] [<value:32>]
+ *  HOST:   none
+ *
+ *
+ * === Temperature alarm events ===
+ * When a cmd_temperature_report raises or clears the temperature alarm, the
+ * DPS sends this frame with the alarm state (1 while power out is locked)
+ * and the reported temperatures.
+ * The DPS does not expect a response
+ *
+ *  DPS:    [cmd_temperature_event] [<alarm:8>] [<temp1:16>] [<temp2:16>]
  *  HOST:   none
  *
  *
@@ -256,11 +556,13 @@ bool protocol_unpack_upgrade_start(uint8_t *payload, uint32_t length, uint16_t *
  *     flag in the PAST and boots the app.
  *  8. The host pings the app to check the new firmware started.
  *
- *  HOST:     [cmd_upgrade_start] [chunk_size:16] [crc:16]
- *  DPS (BL): [cmd_response | cmd_upgrade_start] [<upgrade_status_t>] [<chunk_size:16>]  [<upgrade_reason_t:8>]
+ *  HOST:     [cmd_upgrade_start] [chunk_size:16] [crc:16] [<window:8> [<flags:8> [<page crc:16>]*]?]?
+ *  DPS (BL): [cmd_response | cmd_upgrade_start] [<upgrade_status_t>] [<chunk_size:16>]  [<upgrade_reason_t:8>] [<window:8>] [<flags:8>] [<page same:8>]{8}?
  *
  * The host will send packets of the agreed chunk size with the device 
- * acknowledging each packet once crc checked and written to flash. A packet
+ * acknowledging each packet once crc checked, and then writing it to flash
+ * while the host sends the next one. A flash error is reported in the
+ * response to the packet that follows the failing one. A packet
  * smaller than the chunk size or with zero payload indicates the end of the
  * upgrade session. The device will now return the outcome of the 32 bit crc
  * check of the new firmware and continue on step 7 above.
@@ -269,7 +571,372 @@ bool protocol_unpack_upgrade_start(uint8_t *payload, uint32_t length, uint16_t *
  * expected to be equal to what was aggreed upon in the cmd_upgrade_start packet.
  *
  *  HOST:   [cmd_upgrade_data] [<payload>]+
- *  DPS BL: [cmd_response | cmd_upgrade_data] [<upgrade_status_t>]
+ *  DPS BL: [cmd_response | cmd_upgrade_data] [<upgrade_status_t>] [<offset:32>]
+ *
+ * The offset is the number of image bytes the bootloader has accepted. A
+ * bootloader that sends the window field supports windowed upgrades. The
+ * app reboots into the bootloader with window 0, and the host may then send
+ * cmd_upgrade_start again, including the window it wants. The bootloader
+ * grants at most UPGRADE_MAX_WINDOW packets and UPGRADE_MAX_CHUNK_SIZE bytes
+ * per chunk, and acks a chunk before programming it when its receive buffer
+ * holds what the host sends meanwhile. A raw chunk of one page takes up to
+ * UPGRADE_PAGE_PROGRAM_US, and what arrives in that time fits at 115200
+ * baud. At higher rates and for LZ chunks, whose decoding takes any time,
+ * the window does the bounding: the chunk is cut to UPGRADE_PIPELINE_CHUNK_SIZE
+ * and the window to the packets the buffer holds. A manifest needs whole
+ * pages, so if not even one packet fits the chunk is acked after it is
+ * programmed and the window is 1. The host uses the chunk size granted.
+ * In a windowed upgrade the host may send up to <window> data
+ * packets before it waits for an ack, and each packet carries its image
+ * offset:
+ *
+ *  HOST:   [cmd_upgrade_data] [<offset:32>] [<payload>]+
+ *
+ * The acks are cumulative. Packets beyond the accepted offset are dropped
+ * silently, and packets before it are acked again. A host that times out
+ * waiting for an ack resends from the acked offset.
+ *
+ * If the bootloader grants UPGRADE_FLAG_LZ, the data packets carry an LZ
+ * compressed image and the offsets count compressed bytes. The stream is a
+ * sequence of tokens:
+ *
+ *  [<n:8>] [<literal:8>]{n+1}                         for n < 0x80
+ *  [<0x80 | (len - UPGRADE_LZ_MIN_MATCH):8>] [<distance:16>]
+ *
+ * A match copies len bytes from distance bytes back in the decoded image.
+ * The crc is computed over the decoded image.
+ *
+ * With UPGRADE_FLAG_MANIFEST the host sends the crc16 of every whole
+ * UPGRADE_PAGE_SIZE page of the new image. The bootloader grants the flag
+ * for windowed, uncompressed upgrades with a chunk size that is a multiple
+ * of the page size. The response then carries a bitmap, where bit n of
+ * byte n / 8 is set if page n of the app in flash has that crc. A chunk is
+ * skipped if all of its pages are set. The host does not send it, and the
+ * acked offset moves past it. The last chunk is never skipped, because it
+ * does not end with a whole page of the manifest.
+ *
+ *
+ * === Staged upgrades ===
+ * The wifi proxy can store a firmware image in its own flash and run the
+ * upgrade session above on its UART, so the chunks are not acked across
+ * the network. These commands are answered by the proxy and never reach
+ * the DPS, which answers them with status 0 if an older proxy forwards
+ * them. The host starts with the <length> and crc16 of the image:
+ *
+ *  HOST:   [cmd_stage_start] [<length:32>] [<crc:16>]
+ *  PROXY:  [cmd_response | cmd_stage_start] [<status>]
+ *
+ * The image is then sent in order in chunks of up to STAGE_MAX_CHUNK_SIZE
+ * bytes, with several in flight. As with windowed upgrades the acks are
+ * cumulative, <offset> being the number of bytes stored. Chunks beyond it
+ * are dropped and chunks before it are acked again. When the last chunk
+ * has been stored the proxy checks the crc of the image before acking it.
+ * Status is 0 if no image is being received or the image was bad.
+ *
+ *  HOST:   [cmd_stage_data] [<offset:32>] [<payload>]+
+ *  PROXY:  [cmd_response | cmd_stage_data] [<status>] [<offset:32>]
+ *
+ * cmd_stage_upgrade is answered right away, with status 0 if no image is
+ * staged. The proxy then upgrades the DPS, moving the link to
+ * CONFIG_DPS_BAUD in the bootloader, and does not forward other requests
+ * until it is done. The host follows the upgrade with cmd_stage_status, the
+ * <offset> of an upgrade being the number of bytes the bootloader accepted
+ * and <upgrade status> the latest upgrade_status_t it sent. A staged image
+ * is sent uncompressed and without a manifest.
+ *
+ *  HOST:   [cmd_stage_upgrade]
+ *  PROXY:  [cmd_response | cmd_stage_upgrade] [<status>]
+ *
+ *  HOST:   [cmd_stage_status]
+ *  PROXY:  [cmd_response | cmd_stage_status] [1] [<stage_state_t:8>] [<upgrade status:8>] [<offset:32>] [<length:32>]
+ *
+ *
+ * === Streaming telemetry ===
+ * The host may ask the DPS to sample V_out, I_out and V_in every <interval>
+ * milliseconds (min STREAM_MIN_INTERVAL_MS) and push them in batches of
+ * up to <count> samples (1..STREAM_MAX_SAMPLES) without further requests. The
+ * optional <frame size> is the largest payload the host accepts, the DPS
+ * replies with the size it will use (at most MAX_BULK_FRAME_LENGTH) and
+ * shortens batches that would not fit. Status is 0 if the arguments were out
+ * of range. Streaming continues until cmd_stream_stop is received. Voltages
+ * are in mV, currents in mA.
+ *
+ *  HOST:   [cmd_stream_start] [<interval:16>] [<count:8>] [<frame size:16>]?
+ *  DPS:    [cmd_response | cmd_stream_start] [<status>] [<frame size:16>]
+ *
+ *  HOST:   [cmd_stream_stop]
+ *  DPS:    [cmd_response | cmd_stream_stop] [1]
+ *
+ * The batches carry the timestamp (ms since power up) of the first sample,
+ * the following samples are spaced <interval> ms apart. The first sample is
+ * sent as is, the following are sent as signed 8 bit deltas from the previous
+ * sample. A delta outside [-127, 127] is sent as SAMPLE_DELTA_ESCAPE followed
+ * by the 16 bit value. The DPS does not expect a response.
+ *
+ *  DPS:    [cmd_stream_data] [<timestamp:32>] [<interval:16>] [<count:8>] [<V_out:16>] [<I_out:16>] [<V_in:16>] ([<dV_out>] [<dI_out>] [<dV_in>])*
+ *  HOST:   none
+ *
+ *
+ * === Change notifications ===
+ * Instead of polling cmd_query, the host may subscribe to the fields of
+ * notify_field_t it is interested in, one bit each in <fields>. Every
+ * NOTIFY_INTERVAL_MS the DPS compares the subscribed fields with what it
+ * last sent and pushes those that changed. The measured voltages and
+ * currents only count as changed once they differ from what was sent by
+ * more than <voltage deadband> mV and <current deadband> mA. A subscription
+ * is followed by a change event with all subscribed fields, and lasts
+ * until <fields> = 0 is received. Status is 0 for unknown fields.
+ *
+ *  HOST:   [cmd_subscribe] [<fields:8>] [<voltage deadband:16>] [<current deadband:16>]
+ *  DPS:    [cmd_response | cmd_subscribe] [<status>]
+ *
+ * The change event carries the mask of the fields that changed followed by
+ * their values, see notify_field_t. The DPS does not expect a response.
+ *
+ *  DPS:    [cmd_change_event] [<changed:8>] [<field>]*
+ *  HOST:   none
+ *
+ *
+ * === Uploading calibration tables ===
+ * Each unit may replace the linear conversions of its model by piecewise
+ * linear tables, see pwrctl_cal_table_t for the table numbers. A table of
+ * <total> points is sent in order in frames of up to CAL_POINTS_PER_FRAME
+ * points, <first> being the index of the first point in the frame. When the
+ * last point has been received the table is checked and stored in past.
+ * <total> = 0 erases the table and the linear conversion is used again.
+ * Status is 0 if a frame was out of order or the table was invalid.
+ *
+ *  HOST:   [cmd_set_calibration] [<table:8>] [<total:8>] [<first:8>] ([<x:16>] [<y:16>])*
+ *  DPS:    [cmd_response | cmd_set_calibration] [<status>]
+ *
+ *
+ * === Uploading sequences ===
+ * The sequencer function runs a list of <total> steps in constant current
+ * mode, each setting V_out (in millivolts) and I_out (in milliamperes) for
+ * <duration> milliseconds (at least 1). The sequence is run <repeat> times,
+ * 0 being forever. The steps are sent in order in frames of up to
+ * SEQ_STEPS_PER_FRAME steps, <first> being the index of the first step in
+ * the frame. When the last step has been received the sequence is stored in
+ * past. <total> = 0 erases the sequence. Status is 0 if the sequencer is
+ * running, the device has no sequencer or a frame was out of order or
+ * invalid.
+ *
+ *  HOST:   [cmd_set_sequence] [<total:8>] [<first:8>] [<repeat:8>] ([<V_out:16>] [<I_out:16>] [<duration:32>])*
+ *  DPS:    [cmd_response | cmd_set_sequence] [<status>]
+ *
+ *
+ * === Energy counters ===
+ * The DPS integrates the charge and energy delivered and the time power out
+ * has been enabled. The counters survive power cycles as they are stored in
+ * past whenever power out is disabled. If <reset> is 1 the counters are
+ * cleared after being reported.
+ *
+ *  HOST:   [cmd_energy_query] [<reset:8>]?
+ *  DPS:    [cmd_response | cmd_energy_query] [1] [<charge uAh:32>] [<energy mWh:32>] [<on time s:32>]
+ *
+ *
+ * === Waveform capture ===
+ * The DPS records the ADC scans into a ring of <capacity> samples, each
+ * sample being the average of <decimation> scans (at ~21kHz). When the
+ * trigger (capture_trigger_t) fires, the ring keeps <pre> samples from before
+ * the trigger, records the rest and freezes. <level> is the threshold of the
+ * level triggers in mA or mV. Trigger capture_trig_none disarms. Status is 0
+ * if the arguments were out of range or the device has no capture support.
+ *
+ *  HOST:   [cmd_capture_arm] [<trigger:8>] [<level:16>] [<decimation:16>] [<pre:16>]
+ *  DPS:    [cmd_response | cmd_capture_arm] [<status>] [<capacity:16>]
+ *
+ * The host polls the state (capture_state_t) and, once done, downloads the
+ * <count> samples oldest first, up to CAPTURE_SAMPLES_PER_FRAME samples from
+ * <offset> per frame. <trigger index> is the index of the first sample
+ * recorded after the trigger. Voltages are in mV, currents in mA.
+ *
+ *  HOST:   [cmd_capture_read] [<offset:16>]
+ *  DPS:    [cmd_response | cmd_capture_read] [<status>] [<state:8>] [<count:16>] [<trigger index:16>] [<decimation:16>] [<offset:16>] ([<V_out:16>] [<I_out:16>] [<V_in:16>])*
+ *
+ *
+ * === Rolling statistics ===
+ * Firmware built with STATS=1 keeps the min, max, mean, RMS and the RMS
+ * around the mean (the ripple) of V_out, I_out and V_in over a window of
+ * the latest <blocks> blocks of <block scans> scans (at ~21kHz). With the
+ * arguments, the window is changed and the statistics start over. <scans>
+ * is the number of scans the statistics were computed from, less than the
+ * window until it has filled. All are in mV and mA, but the ripple which is
+ * in uV and uA. The peak-to-peak is max - min. Status is 0 if the window
+ * is out of range or the device has no statistics.
+ *
+ *  HOST:   [cmd_stats] ([<block scans:16>] [<blocks:8>])?
+ *  DPS:    [cmd_response | cmd_stats] [<status>] [<block scans:16>] [<blocks:8>] [<scans:32>] ([<min:16>] [<max:16>] [<mean:16>] [<rms:16>] [<ripple:32>]){3}
+ *
+ * The channels are in the order V_out, I_out, V_in.
+ *
+ *
+ * === Alarm rules ===
+ * Firmware built with ALARMS=1 evaluates up to CONFIG_ALARM_RULES rules
+ * every CONFIG_ALARM_INTERVAL_MS. A rule fires when the reading of its
+ * <channel> (alarm_channel_t: V_out mV, I_out mA, V_in mV, power mW) has
+ * been below or above <threshold> (alarm_compare_t, ALARM_WHILE_ENABLED
+ * or:ed in for rules only evaluated while power out is enabled) for
+ * <hold> milliseconds. It then takes its <action> (alarm_action_t), the
+ * function ones switching to function index <function> as listed by
+ * cmd_list_functions, and fires again only after the condition has
+ * cleared. The rules are sent in order in frames of up to
+ * ALARM_RULES_PER_FRAME rules, <first> being the index of the first rule
+ * in the frame, and are stored in past when the last one has been
+ * received. <total> = 0 removes them all. Status is 0 if a frame was out of
+ * order, a rule is invalid or the device has no alarms.
+ *
+ *  HOST:   [cmd_set_alarms] [<total:8>] [<first:8>] ([<channel:8>] [<compare:8>] [<action:8>] [<function:8>] [<threshold:32>] [<hold:32>])*
+ *  DPS:    [cmd_response | cmd_set_alarms] [<status>]
+ *
+ * When a rule fires, the DPS sends its index and the reading that fired it.
+ * The DPS does not expect a response
+ *
+ *  DPS:    [cmd_alarm_event] [<rule:8>] [<value:32>]
+ *  HOST:   none
+ *
+ *
+ * === Load profile ===
+ * Firmware built with HISTOGRAM=1 samples V_out and I_out every <interval>
+ * milliseconds while power out is enabled, and counts each sample in one of
+ * HISTOGRAM_BINS logarithmic bins of its channel (histogram_channel_t: V_out
+ * mV, I_out mA), two per octave. Bin b < 4 holds the value b, a higher bin
+ * the values from (2 + (b & 1)) << (b / 2 - 1) up to the next bin. The host
+ * reads HISTOGRAM_BINS_PER_FRAME bins from bin <first> per frame. The
+ * counters keep 16 bits of precision, once one reaches 65535 the samples
+ * are counted in steps of a power of two. They are stored in past every
+ * CONFIG_HISTOGRAM_SAVE_MS, and when power out is disabled after
+ * CONFIG_HISTOGRAM_MIN_SAVE_MS of recording. Status is 0 if the channel or bin is out of range or the
+ * device has no histogram.
+ *
+ *  HOST:   [cmd_histogram] [<channel:8>] [<first:8>]
+ *  DPS:    [cmd_response | cmd_histogram] [<status>] [<interval:16>] [<channel:8>] [<first:8>] ([<samples:32>]){HISTOGRAM_BINS_PER_FRAME}
+ *
+ * The samples of I_out above each of HISTOGRAM_LIMITS limits (in mA, 0 for
+ * an unused one) are counted too, giving the time spent above them. The
+ * limits and the samples above them are reported first. Then, if <reset>
+ * is 1, all counters are cleared, and if limits are given they replace the
+ * old ones and their counters start over.
+ *
+ *  HOST:   [cmd_histogram_limits] [<reset:8>] ([<limit:16>]{HISTOGRAM_LIMITS})?
+ *  DPS:    [cmd_response | cmd_histogram_limits] [<status>] [<interval:16>] ([<limit:16>] [<samples above:32>]){HISTOGRAM_LIMITS}
+ *
+ *
+ * === Profiling ===
+ * Firmware built with PROFILING=1 counts the CPU cycles (at 24MHz) spent in
+ * the ISRs and the heavier main loop stages, in profile_point_t order. The
+ * cycles of interrupts preempting a stage are included in its figures. If
+ * <reset> is 1 the counters are cleared after being reported. Status is 0 if
+ * the device has no profiling support.
+ *
+ *  HOST:   [cmd_profile_dump] [<reset:8>]?
+ *  DPS:    [cmd_response | cmd_profile_dump] [<status>] [<num:8>] ([<count:32>] [<min:32>] [<avg:32>] [<max:32>])*
+ *
+ *
+ * === Waveform generation ===
+ * Firmware built with WAVE=1 can play a waveform (wave_shape_t) on V_out for
+ * ripple and transient tests. The V_out DAC is fed from a table of
+ * WAVE_SAMPLES codes per period by a timer triggered DMA, at <frequency> in
+ * mHz around <offset> mV with a peak deviation of <amplitude> mV. Shape
+ * wave_off stops and V_out returns to its setting, as does disabling power
+ * out. The current limit and the protections stay in force. Status is 0 if
+ * the arguments are out of range, power out is disabled or the device has
+ * no waveform support.
+ *
+ *  HOST:   [cmd_wave] [<shape:8>] [<frequency:32>] [<offset:16>] [<amplitude:16>]
+ *  DPS:    [cmd_response | cmd_wave] [<status>]
+ *
+ *
+ * === Stack usage ===
+ * Firmware built with STACK_WATERMARK=1 paints the stack at reset and
+ * reports its <size> in bytes and the most bytes <used> since then, ISRs
+ * included. Status is 0 if the device has no watermark support.
+ *
+ *  HOST:   [cmd_stack_usage]
+ *  DPS:    [cmd_response | cmd_stack_usage] [<status>] [<size:16>] [<used:16>]
+ *
+ *
+ * === Display mirroring ===
+ * Firmware built with MIRROR=1 can send what is drawn on the TFT as
+ * mirror_op_t drawing commands, glyphs going by font size and character
+ * rather than by pixels. Enabling mirroring redraws the whole display. The
+ * commands collected over CONFIG_MIRROR_FLUSH_MS, or a frame's worth, are
+ * sent in bulk frames with a sequence number. A host seeing a sequence
+ * number skipped should enable mirroring again to get a full redraw. Status
+ * is 0 if the device has no mirroring support.
+ *
+ *  HOST:   [cmd_mirror] [<enable:8>]
+ *  DPS:    [cmd_response | cmd_mirror] [<status>]
+ *
+ *  DPS:    [cmd_mirror_data] [<seq:8>] ([<op:8>] [<op arguments>])*
+ *
+ *
+ * === Warm reboot ===
+ * Resets the device for a fresh start without the start up delays. The
+ * bootloader starts the app at once and the app keeps the I_out offset it
+ * measured rather than measuring it again. The response is sent before the
+ * reset, the device accepts commands again a few milliseconds later.
+ *
+ *  HOST:   [cmd_warm_reboot]
+ *  DPS:    [cmd_response | cmd_warm_reboot] [<status>]
+ *
+ *
+ * === Armed setpoints ===
+ * Lets several devices change their parameters and output at the same moment.
+ * Each device is armed ahead with the parameter values, by id as in
+ * cmd_set_parameter_values, and the output state to apply, or
+ * ARM_OUTPUT_UNCHANGED. The host then sends one cmd_fire, multicast to
+ * FIRE_MCAST_GROUP:FIRE_MCAST_PORT over wifi, and every device armed with the
+ * same id applies its setpoint. The parameters are applied as one commit,
+ * none of them if one is refused, and the output is switched after them. A
+ * device fires once per arming, an arm id of 0 disarms.
+ *
+ *  HOST:   [cmd_arm] [<arm id:8>] [<output:8>] ([<id:8>] [<value:32>])*
+ *  DPS:    [cmd_response | cmd_arm] [<status>]
+ *
+ *  HOST:   [cmd_fire] [<arm id:8>]
+ *  DPS:    [cmd_response | cmd_fire] [<status>]
+ *
+ * The fire status is 0 if the device was not armed with that id. The proxies
+ * do not pass the responses to the multicast sender, a host wanting to know
+ * the outcome queries the devices afterwards.
+ *
+ *
+ * === Set, settle and measure ===
+ * One step of a sweep in one round trip. The DPS applies the parameter
+ * values, by id as in cmd_set_parameter_values, and the output state or
+ * ARM_OUTPUT_UNCHANGED like cmd_fire does. It then waits until the readings
+ * of V_out have been within <tolerance> mV of the V_out setting (0 V with
+ * power out disabled) for MEASURE_SETTLE_MS, or <timeout> ms have passed.
+ * With a tolerance of 0 it waits <timeout> ms, for functions not setting
+ * V_out. The response follows once <samples> (1..MEASURE_MAX_SAMPLES)
+ * readings, one per millisecond, have been averaged. <settled> is 0 if the
+ * timeout was hit, and <settle time> is the milliseconds until V_out
+ * settled. Status is 0 with no more data if a parameter was refused, the
+ * arguments were out of range or a measurement was already running.
+ *
+ *  HOST:   [cmd_set_and_measure] [<tolerance:16>] [<timeout:16>] [<samples:8>] [<output:8>] ([<id:8>] [<value:32>])*
+ *  DPS:    [cmd_response | cmd_set_and_measure] [<status>] [<settled:8>] [<settle time:16>] [<V_out:16>] [<I_out:16>] [<V_in:16>]
+ *
+ *
+ * === Settings backup and restore ===
+ * Firmware built with PAST_TRANSFER=1 exports its settings, the past units
+ * other than the git hashes and the upgrade marker, as a byte stream in the
+ * past unit layout: ([<id:32>] [<length:32>] [<data>] [<padding to 4>])*.
+ * The host reads it in chunks of up to PAST_TRANSFER_CHUNK bytes. Every
+ * response carries the size and crc16 of the whole stream, a change of
+ * which means the settings changed during the read.
+ *
+ *  HOST:   [cmd_past_export] [<offset:16>]
+ *  DPS:    [cmd_response | cmd_past_export] [<status>] [<total:16>] [<crc:16>] [<offset:16>] [<data>]
+ *
+ * A stream is imported in order, the chunk at offset 0 starting over. Once
+ * the last chunk arrives, all units are written in one past transaction and
+ * the device warm reboots (see above) to take them into use, after sending
+ * the response to the last chunk. Units not in the stream are kept.
+ *
+ *  HOST:   [cmd_past_import] [<total:16>] [<offset:16>] [<data>]
+ *  DPS:    [cmd_response | cmd_past_import] [<status>]
  *
  */
 
@@ -36,8 +36,37 @@
 #include "protocol.h"
 #include "serialhandler.h"
 #include "bootcom.h"
+#include "adc_scan.h"
 #include "uframe.h"
 #include "opendps.h"
+#include "tick.h"
+#include "softtimer.h"
+#include "energy.h"
+#include "profile.h"
+#ifdef CONFIG_SEQ_ENABLE
+#include "func_seq.h"
+#endif // CONFIG_SEQ_ENABLE
+#ifdef CONFIG_CAPTURE
+#include "capture.h"
+#endif // CONFIG_CAPTURE
+#ifdef CONFIG_STATS
+#include "stats.h"
+#endif // CONFIG_STATS
+#ifdef CONFIG_ALARMS
+#include "alarm.h"
+#endif // CONFIG_ALARMS
+#ifdef CONFIG_HISTOGRAM
+#include "histogram.h"
+#endif // CONFIG_HISTOGRAM
+#ifdef CONFIG_WAVE
+#include "wave.h"
+#endif // CONFIG_WAVE
+#ifdef CONFIG_STACK_WATERMARK
+#include "stack.h"
+#endif // CONFIG_STACK_WATERMARK
+#ifdef CONFIG_MIRROR
+#include "mirror.h"
+#endif // CONFIG_MIRROR
 
 #ifdef DPS_EMULATOR
  extern void dps_emul_send_frame(uint8_t *frame, uint32_t length);
@@ -49,9 +78,149 @@ typedef enum {
     cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much,
 } command_status_t;
 
-static uint8_t frame_buffer[FRAME_OVERHEAD(MAX_FRAME_LENGTH)];
-static uint32_t rx_idx = 0;
-static bool receiving_frame = false;
+/** Largest payload of each response, derived from the UI limits. Function
+  * (screen) names are held to MAX_PARAMETER_NAME like the parameter names. */
+#define PARAM_VALUE_LEN  (16) /** Formatted parameter value, terminator included */
+#define QUERY_PAYLOAD  (2 + 3*2 + 1 + 2*2 + 1 + MAX_PARAMETER_NAME + MAX_PARAMETERS * (MAX_PARAMETER_NAME + PARAM_VALUE_LEN))
+#define LIST_FUNCTIONS_PAYLOAD  (2 + MAX_SCREENS * MAX_PARAMETER_NAME)
+#define LIST_PARAMETERS_PAYLOAD  (2 + MAX_PARAMETER_NAME + MAX_PARAMETERS * (MAX_PARAMETER_NAME + 2))
+#define SET_PARAMETERS_PAYLOAD  (2 + OPENDPS_MAX_PARAMETERS)
+#define GET_PARAMETER_VALUES_PAYLOAD  (2 + 5 * OPENDPS_MAX_PARAMETERS)
+#define RESPONSE_PAYLOAD  (4) /** Status responses, stream start and capture arm */
+#define ENERGY_QUERY_PAYLOAD  (2 + 3*4)
+#define CAPTURE_READ_PAYLOAD  (3 + 4*2 + CAPTURE_SAMPLES_PER_FRAME * 3*2)
+#define STATS_PAYLOAD  (2 + 2 + 1 + 4 + 3 * (4*2 + 4))
+#define PROFILE_DUMP_PAYLOAD  (3 + prof_max * 4*4)
+#define STACK_USAGE_PAYLOAD  (2 + 2*2)
+#define PAST_EXPORT_PAYLOAD  (2 + 3*2 + PAST_TRANSFER_CHUNK)
+#define PROTECTION_EVENT_PAYLOAD  (6)
+#define OCP_EVENT_PAYLOAD  (3)
+#define TEMPERATURE_EVENT_PAYLOAD  (6)
+#define ALARM_EVENT_PAYLOAD  (6)
+#define CHANGE_EVENT_PAYLOAD  NOTIFY_EVENT_PAYLOAD
+#define SET_AND_MEASURE_PAYLOAD  (2 + 1 + 2 + 3*2)
+#define HISTOGRAM_PAYLOAD  (2 + 2 + 2 + HISTOGRAM_BINS_PER_FRAME * 4)
+#define HISTOGRAM_LIMITS_PAYLOAD  (2 + 2 + HISTOGRAM_LIMITS * (2 + 4))
+
+#define _MAX(a, b)  ((a) > (b) ? (a) : (b))
+
+/** All responses are packed into one static frame instead of on the stack,
+  * it is sent (copied to the TX ring) before the next one is built. Responses
+  * to tagged requests are one byte longer. */
+#define MAX_TX_PAYLOAD  (1 + \
+    _MAX(_MAX(_MAX(QUERY_PAYLOAD, LIST_FUNCTIONS_PAYLOAD), _MAX(LIST_PARAMETERS_PAYLOAD, GET_PARAMETER_VALUES_PAYLOAD)), \
+         _MAX(_MAX(CAPTURE_READ_PAYLOAD, PROFILE_DUMP_PAYLOAD), _MAX(MAX_BULK_FRAME_LENGTH, SET_PARAMETERS_PAYLOAD))))
+static uint8_t tx_frame[FRAME_OVERHEAD(MAX_TX_PAYLOAD)];
+
+/** Declare the frame of a response of at most 'payload' bytes, tag
+  * excluded, in tx_frame */
+#define DECLARE_TX_FRAME(payload) \
+    _Static_assert((payload) + 1 <= MAX_TX_PAYLOAD, "Response does not fit tx_frame"); \
+    DECLARE_FRAME_AT(tx_frame, FRAME_OVERHEAD((payload) + 1));
+
+/** Tag of the request being handled, if it was tagged */
+static bool rx_tagged;
+static uint8_t rx_tag;
+
+/** Pack the command of a response, and the tag of a tagged request */
+#define PACK_RESPONSE(cmd) \
+    PACK8(cmd_response | (rx_tagged ? cmd_tagged : 0) | (cmd)); \
+    if (rx_tagged) { \
+        PACK8(rx_tag); \
+    }
+
+/** The largest command is a cmd_set_parameters of MAX_PARAMETERS name=value
+  * pairs, the buffer holds its unescaped payload and crc */
+#define SET_PARAMETERS_CMD_PAYLOAD  (1 + MAX_PARAMETERS * (MAX_PARAMETER_NAME + PARAM_VALUE_LEN))
+/** cmd_past_import requests are the other large one, tag included */
+#define PAST_IMPORT_CMD_PAYLOAD  (2 + 2*2 + PAST_TRANSFER_CHUNK)
+static uint8_t frame_buffer[_MAX(FRAME_OVERHEAD(MAX_FRAME_LENGTH), _MAX(SET_PARAMETERS_CMD_PAYLOAD, PAST_IMPORT_CMD_PAYLOAD) + 2)];
+/** Received frames are decoded into frame_buffer as the bytes arrive */
+static uframe_decoder_t rx_decoder = {
+    .buf = frame_buffer,
+    .size = sizeof(frame_buffer),
+};
+
+/** Telemetry streaming, stream_interval_ms == 0 means not streaming */
+static uint16_t stream_interval_ms;
+static uint8_t stream_batch_size;
+static uint16_t stream_frame_size;
+static uint64_t stream_next_sample;
+static softtimer_t stream_timer;
+static void stream_tick(softtimer_t *timer);
+static uint32_t stream_batch_start;
+static uint8_t stream_count;
+static uint32_t stream_payload_size;
+static protocol_sample_t stream_samples[STREAM_MAX_SAMPLES];
+
+/** Change notifications, notify_fields == 0 means no subscription */
+static uint8_t notify_fields;
+static uint16_t notify_deadband_mv;
+static uint16_t notify_deadband_ma;
+static bool notify_all; /** Send all subscribed fields on the next tick */
+static uint16_t notify_sent[NOTIFY_MAX_VALUES]; /** The values last sent */
+static softtimer_t notify_timer;
+static void notify_tick(softtimer_t *timer);
+
+#ifdef CONFIG_MIRROR
+/** Mirror frames are sent while drawing, which a command being handled in
+  * tx_frame may cause */
+static uint8_t mirror_frame[FRAME_OVERHEAD(MAX_BULK_FRAME_LENGTH)];
+#endif // CONFIG_MIRROR
+
+/** A rate set with cmd_set_baud is checked for confirmation and idling this
+  * often, and dropped as described in protocol.h */
+#define BAUD_CHECK_MS  (100)
+static uint32_t uart_baud = UART_DEFAULT_BAUD;
+static bool baud_confirmed;
+static uint64_t baud_last_frame;
+static softtimer_t baud_timer;
+static void baud_tick(softtimer_t *timer);
+
+/** Setpoint applied by the next cmd_fire of arm_id, 0 when not armed */
+static uint8_t arm_id;
+static uint8_t arm_output;
+static uint8_t arm_count;
+static uint8_t arm_param_id[OPENDPS_MAX_PARAMETERS];
+static int32_t arm_value[OPENDPS_MAX_PARAMETERS];
+
+/** A cmd_set_and_measure waiting for V_out to settle or averaging the
+  * readings, measure_samples == 0 when there is none. Its response is sent
+  * from measure_tick with the tag of the request. */
+static uint8_t measure_samples;
+static uint8_t measure_count;
+static bool measure_sampling; /** Done waiting, averaging the readings */
+static bool measure_timed_out;
+static uint16_t measure_tolerance_mv;
+static uint16_t measure_timeout_ms;
+static uint16_t measure_settle_ms;
+static uint64_t measure_start;
+static uint64_t measure_within; /** When V_out came within the tolerance, 0 while it is not */
+static uint32_t measure_v_out_sum;
+static uint32_t measure_i_out_sum;
+static uint32_t measure_v_in_sum;
+static bool measure_tagged;
+static uint8_t measure_tag;
+static softtimer_t measure_timer;
+static void measure_tick(softtimer_t *timer);
+
+#ifdef CONFIG_PAST_TRANSFER
+/** Largest settings stream cmd_past_import takes, it is collected in RAM
+  * and written in one go */
+#ifndef CONFIG_PAST_IMPORT_SIZE
+ #define CONFIG_PAST_IMPORT_SIZE  (512)
+#endif
+static uint32_t past_import_buf[CONFIG_PAST_IMPORT_SIZE / 4];
+static uint32_t past_import_length;
+/** The chunk of a cmd_past_export response */
+static uint8_t past_transfer_chunk[PAST_TRANSFER_CHUNK];
+#endif // CONFIG_PAST_TRANSFER
+
+/** Calibration table being uploaded */
+static pwrctl_cal_point_t cal_upload[CONFIG_CAL_MAX_POINTS];
+static uint8_t cal_upload_count;
+
+_Static_assert ((int) prot_ovp == (int) protection_ovp && (int) prot_opp == (int) protection_opp, "Protection ids must match the protocol");
 
 /**
   * @brief Send a frame on the uart
@@ -64,12 +233,9 @@ static void send_frame(uint8_t *frame, uint32_t length)
 #ifdef DPS_EMULATOR
     dps_emul_send_frame(frame, length);
 #else // DPS_EMULATOR
-    do {
-        usart_send_blocking(USART1, *frame);
-        frame++;
-    } while(--length);
+    hw_uart_tx(frame, length);
 #endif // DPS_EMULATOR
-  }
+}
 
 /**
   * @brief Handle a query command
@@ -78,8 +244,8 @@ static void send_frame(uint8_t *frame, uint32_t length)
 static command_status_t handle_query(void)
 {
     emu_printf("%s\n", __FUNCTION__);
-    ui_parameter_t *params;
-    char value[16];
+    const ui_parameter_t *params;
+    char value[PARAM_VALUE_LEN];
     uint32_t num_param = opendps_get_curr_function_params(&params);
     
     const char* curr_func = opendps_get_curr_function_name();
@@ -94,8 +260,8 @@ static command_status_t handle_query(void)
     bool temp_shutdown;
     opendps_get_temperature(&temp1, &temp2, &temp_shutdown);
 //    uint32_t len = protocol_create_query_response(frame_buffer, sizeof(frame_buffer), v_in, v_out_setting, v_out, i_out, i_limit, power_enabled);
-    DECLARE_FRAME(64);
-    PACK8(cmd_response | cmd_query);
+    DECLARE_TX_FRAME(QUERY_PAYLOAD);
+    PACK_RESPONSE(cmd_query);
     PACK8(1); // Always success
     PACK16(v_in);
     emu_printf("v_in = %d\n", v_in);
@@ -111,7 +277,7 @@ static command_status_t handle_query(void)
     PACK_CSTR(curr_func);
     emu_printf("%s:\n", curr_func);
     for (uint32_t i=0; i < num_param; i++) {
-        opendps_get_curr_function_param_value(params[i].name, value, sizeof(value));
+        opendps_get_curr_function_param_value((char*) params[i].name, value, sizeof(value));
         emu_printf(" %s = %s\n" , params[i].name, value);
         PACK_CSTR(params[i].name);
         PACK_CSTR(value);
@@ -157,8 +323,8 @@ static command_status_t handle_set_function(uint8_t *payload, uint32_t payload_l
     }
     
     {
-        DECLARE_FRAME(MAX_FRAME_LENGTH);
-        PACK8(cmd_response | cmd_set_function);
+        DECLARE_TX_FRAME(RESPONSE_PAYLOAD);
+        PACK_RESPONSE(cmd_set_function);
         PACK8(success); // Always success
         FINISH_FRAME();
         send_frame(_buffer, _length);
@@ -172,8 +338,8 @@ static command_status_t handle_list_functions(void)
     char *names[OPENDPS_MAX_PARAMETERS];
     uint32_t num_funcs = opendps_get_function_names(names, OPENDPS_MAX_PARAMETERS);
     emu_printf("Got %d functions\n" , num_funcs);
-    DECLARE_FRAME(MAX_FRAME_LENGTH);
-    PACK8(cmd_response | cmd_list_functions);
+    DECLARE_TX_FRAME(LIST_FUNCTIONS_PAYLOAD);
+    PACK_RESPONSE(cmd_list_functions);
     PACK8(1); // Always success
     for (uint32_t i=0; i < num_funcs; i++) {
         emu_printf(" %s\n" , names[i]);
@@ -191,29 +357,69 @@ static command_status_t handle_set_parameters(uint8_t *payload, uint32_t payload
     command_t cmd;
     set_param_status_t stats[OPENDPS_MAX_PARAMETERS];
     uint32_t status_index = 0;
+    opendps_begin_parameters();
     {
         DECLARE_UNPACK(payload, payload_len);
         UNPACK8(cmd);
         (void) cmd;
-        do {
-            /** Extract all occurences of <name>=<value>\0 ... */
-            name = value = 0;
-            /** This is quite ugly, please don't look */
+        /** Extract all occurences of <name>\0<value>\0 ..., both strings
+          * must be terminated within the payload */
+        while (_remain && status_index < OPENDPS_MAX_PARAMETERS) {
+            uint32_t name_len, value_len;
             name = (char*) &_buffer[_pos];
-            _pos += strlen(name) + 1;
-            _remain -= strlen(name) + 1;
-            value = (char*) &_buffer[_pos];
-            _pos += strlen(value) + 1;
-            _remain -= strlen(value) + 1;
-            if (name && value) {
-                stats[status_index++] = opendps_set_parameter(name, value);
+            name_len = strnlen(name, _remain);
+            if (name_len == _remain) {
+                break;
+            }
+            value = (char*) &_buffer[_pos + name_len + 1];
+            value_len = strnlen(value, _remain - name_len - 1);
+            if (value_len == _remain - name_len - 1) {
+                break;
             }
-        } while(_remain && status_index < OPENDPS_MAX_PARAMETERS);
+            _pos += name_len + 1 + value_len + 1;
+            _remain -= name_len + 1 + value_len + 1;
+            stats[status_index++] = opendps_set_parameter(name, value);
+        }
+    }
+    (void) opendps_commit_parameters(stats, status_index);
+
+    {
+        DECLARE_TX_FRAME(SET_PARAMETERS_PAYLOAD);
+        PACK_RESPONSE(cmd_set_parameters);
+        PACK8(1); // Always success
+        for (uint32_t i = 0; i < status_index; i++) {
+            PACK8(stats[i]);
+        }
+        FINISH_FRAME();
+        send_frame(_buffer, _length);
+    }
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+
+static command_status_t handle_set_parameter_values(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    command_t cmd;
+    set_param_status_t stats[OPENDPS_MAX_PARAMETERS];
+    uint32_t status_index = 0;
+    opendps_begin_parameters();
+    {
+        DECLARE_UNPACK(payload, payload_len);
+        UNPACK8(cmd);
+        (void) cmd;
+        while (_remain >= 5 && status_index < OPENDPS_MAX_PARAMETERS) {
+            uint8_t id;
+            uint32_t value;
+            UNPACK8(id);
+            UNPACK32(value);
+            stats[status_index++] = opendps_set_parameter_value(id, (int32_t) value);
+        }
     }
+    (void) opendps_commit_parameters(stats, status_index);
 
     {
-        DECLARE_FRAME(MAX_FRAME_LENGTH);
-        PACK8(cmd_response | cmd_set_parameters);
+        DECLARE_TX_FRAME(SET_PARAMETERS_PAYLOAD);
+        PACK_RESPONSE(cmd_set_parameter_values);
         PACK8(1); // Always success
         for (uint32_t i = 0; i < status_index; i++) {
             PACK8(stats[i]);
@@ -224,16 +430,218 @@ static command_status_t handle_set_parameters(uint8_t *payload, uint32_t payload
     return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
 }
 
+static command_status_t handle_get_parameter_values(void)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    DECLARE_TX_FRAME(GET_PARAMETER_VALUES_PAYLOAD);
+    PACK_RESPONSE(cmd_get_parameter_values);
+    PACK8(1); // Always success
+    for (uint32_t id = 0; id < OPENDPS_MAX_PARAMETERS; id++) {
+        int32_t value;
+        if (opendps_get_parameter_value(id, &value)) {
+            PACK8(id);
+            PACK32((uint32_t) value);
+        }
+    }
+    FINISH_FRAME();
+    send_frame(_buffer, _length);
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+
+/**
+  * @brief Handle an arm command, storing the setpoint of the next cmd_fire
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed or success
+  */
+static command_status_t handle_arm(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    uint8_t cmd, id, output;
+    DECLARE_UNPACK(payload, payload_len);
+    UNPACK8(cmd);
+    (void) cmd;
+    UNPACK8(id);
+    UNPACK8(output);
+    arm_id = 0;
+    if (_remain % 5 || _remain / 5 > OPENDPS_MAX_PARAMETERS ||
+        (output > 1 && output != ARM_OUTPUT_UNCHANGED)) {
+        return cmd_failed;
+    }
+    arm_count = 0;
+    while (_remain >= 5) {
+        uint32_t value;
+        UNPACK8(arm_param_id[arm_count]);
+        UNPACK32(value);
+        arm_value[arm_count++] = (int32_t) value;
+    }
+    arm_output = output;
+    arm_id = id;
+    return cmd_success;
+}
+
+/**
+  * @brief Handle a fire command, applying the armed setpoint
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed or success
+  */
+static command_status_t handle_fire(uint8_t *payload, uint32_t payload_len)
+{
+    uint8_t cmd, id;
+    set_param_status_t stats[OPENDPS_MAX_PARAMETERS];
+    DECLARE_UNPACK(payload, payload_len);
+    UNPACK8(cmd);
+    (void) cmd;
+    UNPACK8(id);
+    if (!arm_id || id != arm_id) {
+        return cmd_failed;
+    }
+    arm_id = 0;
+    opendps_begin_parameters();
+    for (uint32_t i = 0; i < arm_count; i++) {
+        stats[i] = opendps_set_parameter_value(arm_param_id[i], arm_value[i]);
+    }
+    if (!opendps_commit_parameters(stats, arm_count)) {
+        return cmd_failed;
+    }
+    if (arm_output != ARM_OUTPUT_UNCHANGED && !opendps_enable_output(arm_output)) {
+        return cmd_failed;
+    }
+    emu_printf("Fired %d\n", id);
+    return cmd_success;
+}
+
+/**
+  * @brief Handle a set and measure command, applying the setpoint and
+  *        starting measure_tick
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed or "I sent my own frame", the response
+  *         follows when the measurement is done
+  */
+static command_status_t handle_set_and_measure(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    uint8_t cmd, samples, output, count = 0;
+    uint16_t tolerance, timeout;
+    uint8_t param_id[OPENDPS_MAX_PARAMETERS];
+    int32_t param_value[OPENDPS_MAX_PARAMETERS];
+    set_param_status_t stats[OPENDPS_MAX_PARAMETERS];
+    DECLARE_UNPACK(payload, payload_len);
+    UNPACK8(cmd);
+    (void) cmd;
+    UNPACK16(tolerance);
+    UNPACK16(timeout);
+    UNPACK8(samples);
+    UNPACK8(output);
+    if (measure_samples || payload_len < 7 || _remain % 5 || _remain / 5 > OPENDPS_MAX_PARAMETERS ||
+        samples == 0 || samples > MEASURE_MAX_SAMPLES || (output > 1 && output != ARM_OUTPUT_UNCHANGED)) {
+        return cmd_failed;
+    }
+    while (_remain >= 5) {
+        uint32_t value;
+        UNPACK8(param_id[count]);
+        UNPACK32(value);
+        param_value[count++] = (int32_t) value;
+    }
+    if (count) {
+        opendps_begin_parameters();
+        for (uint32_t i = 0; i < count; i++) {
+            stats[i] = opendps_set_parameter_value(param_id[i], param_value[i]);
+        }
+        if (!opendps_commit_parameters(stats, count)) {
+            return cmd_failed;
+        }
+    }
+    if (output != ARM_OUTPUT_UNCHANGED && !opendps_enable_output(output)) {
+        return cmd_failed;
+    }
+    measure_samples = samples;
+    measure_count = 0;
+    measure_sampling = false;
+    measure_timed_out = false;
+    measure_tolerance_mv = tolerance;
+    measure_timeout_ms = timeout;
+    measure_settle_ms = 0;
+    measure_start = get_ticks();
+    measure_within = 0;
+    measure_v_out_sum = measure_i_out_sum = measure_v_in_sum = 0;
+    measure_tagged = rx_tagged;
+    measure_tag = rx_tag;
+    softtimer_start(&measure_timer, 1, 1, &measure_tick);
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+
+/**
+  * @brief Wait for V_out to settle and average the readings of a
+  *        cmd_set_and_measure, run every millisecond while measuring
+  * @param timer the measurement timer
+  * @retval None
+  */
+static void measure_tick(softtimer_t *timer)
+{
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+    uint32_t v_out = pwrctl_calc_vout(v_out_raw);
+    uint64_t now = get_ticks();
+    if (!measure_sampling) {
+        if (measure_tolerance_mv) {
+            uint32_t target = pwrctl_vout_enabled() ? pwrctl_get_vout() : 0;
+            uint32_t diff = v_out > target ? v_out - target : target - v_out;
+            if (diff > measure_tolerance_mv) {
+                measure_within = 0;
+            } else if (!measure_within) {
+                measure_within = now;
+            }
+            if (measure_within && now - measure_within >= MEASURE_SETTLE_MS) {
+                measure_sampling = true;
+                measure_settle_ms = measure_within - measure_start;
+            }
+        }
+        if (!measure_sampling) {
+            if (now - measure_start < measure_timeout_ms) {
+                return;
+            }
+            /** Timed out, or the plain delay without a tolerance is over */
+            measure_sampling = true;
+            measure_timed_out = measure_tolerance_mv != 0;
+            measure_settle_ms = now - measure_start;
+        }
+    }
+    measure_v_out_sum += v_out;
+    measure_i_out_sum += pwrctl_calc_iout(i_out_raw);
+    measure_v_in_sum += pwrctl_calc_vin(v_in_raw);
+    if (++measure_count < measure_samples) {
+        return;
+    }
+    softtimer_stop(timer);
+    DECLARE_TX_FRAME(SET_AND_MEASURE_PAYLOAD);
+    PACK8(cmd_response | (measure_tagged ? cmd_tagged : 0) | cmd_set_and_measure);
+    if (measure_tagged) {
+        PACK8(measure_tag);
+    }
+    PACK8(1);
+    PACK8(!measure_timed_out);
+    PACK16(measure_settle_ms);
+    PACK16(measure_v_out_sum / measure_samples);
+    PACK16(measure_i_out_sum / measure_samples);
+    PACK16(measure_v_in_sum / measure_samples);
+    FINISH_FRAME();
+    measure_samples = 0;
+    send_frame(_buffer, _length);
+}
+
 static command_status_t handle_list_parameters(void)
 {
     emu_printf("%s\n", __FUNCTION__);
-    ui_parameter_t *params;
+    const ui_parameter_t *params;
     uint32_t num_param = opendps_get_curr_function_params(&params);
 
     const char* name = opendps_get_curr_function_name();
     emu_printf("Got %d parameters for %s\n" , num_param, name);
-    DECLARE_FRAME(MAX_FRAME_LENGTH);
-    PACK8(cmd_response | cmd_list_parameters);
+    DECLARE_TX_FRAME(LIST_PARAMETERS_PAYLOAD);
+    PACK_RESPONSE(cmd_list_parameters);
     PACK8(1); // Always success
     /** Pack name of current function */
     PACK_CSTR(name);
@@ -328,99 +736,1117 @@ static command_status_t handle_upgrade_start(uint8_t *payload, uint32_t payload_
     command_status_t success = cmd_failed;
     uint16_t chunk_size, crc;
     if (protocol_unpack_upgrade_start(payload, payload_len, &chunk_size, &crc)) {
-        bootcom_put(0xfedebeda, (chunk_size << 16) | crc);
+        opendps_flush_past();
+        bootcom_put(BOOTCOM_UPGRADE, (chunk_size << 16) | crc);
+        hw_uart_tx_flush(); /** Don't lose pending output in the reset */
         scb_reset_system();
     }
     return success;
 }
 
 /**
-  * @brief Handle a receved frame
-  * @param frame the received frame
-  * @param length length of frame
+  * @brief Reset the device for a warm boot, see cmd_warm_reboot, once the
+  *        pending output has been sent
   * @retval None
   */
-static void handle_frame(uint8_t *frame, uint32_t length)
+static void warm_reboot(void)
 {
-    command_status_t success = cmd_failed;
-    command_t cmd = cmd_response;
-    uint8_t *payload;
-    int32_t payload_len = uframe_extract_payload(frame, length);
-    payload = frame; // Why? Well, frame now points to the payload
-    if (payload_len <= 0) {
-        dbg_printf("Frame error %ld\n", payload_len);
-    } else {
-        cmd = frame[0];
-        switch(cmd) {
-            case cmd_ping:
-                success = 1; // Response will be sent below
-                emu_printf("Got pinged\n");
-                opendps_handle_ping();
-                break;
-            case cmd_set_function:
-                success = handle_set_function(payload, payload_len);
-                break;
-            case cmd_list_functions:
-                success = handle_list_functions();
-                break;
-            case cmd_set_parameters:
-                success = handle_set_parameters(payload, payload_len);
-                break;
-            case cmd_list_parameters:
-                success = handle_list_parameters();
-                break;
-            case cmd_query:
-                success = handle_query();
-                break;
-            case cmd_wifi_status:
-                success = handle_wifi_status(payload, payload_len);
-                break;
-            case cmd_lock:
-                success = handle_lock(payload, payload_len);
-                break;
-            case cmd_upgrade_start:
-                success = handle_upgrade_start(payload, payload_len);
-                break;
-            case cmd_enable_output:
-                success = handle_enable_output(payload, payload_len);
-                break;
-            case cmd_temperature_report:
-                success = handle_temperature(payload, payload_len);
-                break;
-            default:
-                emu_printf("Got unknown command %d (0x%02x)\n", cmd, cmd);
-                break;
-        }
+    int32_t offset;
+    opendps_flush_past();
+    /** Without a measured offset the app must measure it, do a full boot */
+    if (adc_scan_i_offset(&offset)) {
+        bootcom_put(BOOTCOM_WARM_BOOT, (uint32_t) offset);
     }
-    if (success != cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much) {
-        length = protocol_create_response(frame_buffer, sizeof(frame_buffer), cmd, success);
-        if (length > 0 && cmd != cmd_response) {
-            send_frame(frame_buffer, length);
-        }
+    hw_uart_tx_flush();
+    scb_reset_system();
+}
+
+/**
+  * @brief Handle a warm reboot command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame", if
+  *         successful the device reboots
+  */
+static command_status_t handle_warm_reboot(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    (void) payload;
+    (void) payload_len;
+    DECLARE_TX_FRAME(1);
+    PACK_RESPONSE(cmd_warm_reboot);
+    PACK8(1); // Always success
+    FINISH_FRAME();
+    send_frame(_buffer, _length);
+    warm_reboot();
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+
+#ifdef CONFIG_PAST_TRANSFER
+/**
+  * @brief Handle a settings export command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_past_export(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    uint8_t cmd;
+    uint16_t offset;
+    uint32_t total;
+    uint16_t crc;
+    {
+        DECLARE_UNPACK(payload, payload_len);
+        UNPACK8(cmd);
+        (void) cmd;
+        UNPACK16(offset);
+    }
+    uint32_t length = opendps_past_export(offset, past_transfer_chunk, PAST_TRANSFER_CHUNK, &total, &crc);
+    DECLARE_TX_FRAME(PAST_EXPORT_PAYLOAD);
+    PACK_RESPONSE(cmd_past_export);
+    PACK8(total <= 0xffff);
+    PACK16(total);
+    PACK16(crc);
+    PACK16(offset);
+    for (uint32_t i = 0; i < length; i++) {
+        PACK8(past_transfer_chunk[i]);
     }
+    FINISH_FRAME();
+    send_frame(_buffer, _length);
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
 }
 
 /**
-  * @brief Handle received character
-  * @param c well, the received character
-  * @retval None
+  * @brief Handle a settings import command, the device reboots after the
+  *        last chunk has been imported
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
   */
-void serial_handle_rx_char(char c)
+static command_status_t handle_past_import(uint8_t *payload, uint32_t payload_len)
 {
-    uint8_t b = (uint8_t) c;
-    if (b == _SOF) {
-        receiving_frame = true;
-        rx_idx = 0;
-    }
-    if (receiving_frame) {
-        if (rx_idx < sizeof(frame_buffer)) {
-            frame_buffer[rx_idx++] = b;
-            if (b == _EOF) {
-                handle_frame(frame_buffer, rx_idx);
-                receiving_frame = false;
-            }
-        } else {
-            dbg_printf("Error: RX buffer overflow!\n");
+    emu_printf("%s\n", __FUNCTION__);
+    uint8_t cmd;
+    uint16_t total, offset;
+    DECLARE_UNPACK(payload, payload_len);
+    UNPACK8(cmd);
+    (void) cmd;
+    UNPACK16(total);
+    UNPACK16(offset);
+    if (offset == 0) {
+        past_import_length = 0;
+    }
+    if (total > sizeof(past_import_buf) || offset != past_import_length || _remain > (uint32_t) (total - offset)) {
+        past_import_length = 0;
+        return cmd_failed;
+    }
+    memcpy((uint8_t*) past_import_buf + offset, &_buffer[_pos], _remain);
+    past_import_length += _remain;
+    if (past_import_length < total) {
+        return cmd_success;
+    }
+    past_import_length = 0;
+    if (!opendps_past_import((const uint8_t*) past_import_buf, total)) {
+        return cmd_failed;
+    }
+    {
+        DECLARE_TX_FRAME(1);
+        PACK_RESPONSE(cmd_past_import);
+        PACK8(1);
+        FINISH_FRAME();
+        send_frame(_buffer, _length);
+    }
+    warm_reboot();
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+#endif // CONFIG_PAST_TRANSFER
+
+/**
+  * @brief Handle a stream start command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_stream_start(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    command_t cmd;
+    uint16_t interval;
+    uint8_t batch_size;
+    uint16_t frame_size = MAX_BULK_FRAME_LENGTH;
+    bool success;
+    {
+        DECLARE_UNPACK(payload, payload_len);
+        UNPACK8(cmd);
+        (void) cmd;
+        UNPACK16(interval);
+        UNPACK8(batch_size);
+        if (_remain >= 2) {
+            UNPACK16(frame_size);
         }
+        success = _remain == 0 && interval >= STREAM_MIN_INTERVAL_MS && batch_size > 0 && batch_size <= STREAM_MAX_SAMPLES && frame_size >= SAMPLE_BATCH_HEADER_SIZE;
+    }
+    if (success) {
+        stream_interval_ms = interval;
+        stream_batch_size = batch_size;
+        stream_frame_size = frame_size < MAX_BULK_FRAME_LENGTH ? frame_size : MAX_BULK_FRAME_LENGTH;
+        stream_count = 0;
+        stream_next_sample = get_ticks();
+        softtimer_start(&stream_timer, 0, stream_interval_ms, &stream_tick);
+    }
+    {
+        DECLARE_TX_FRAME(RESPONSE_PAYLOAD);
+        PACK_RESPONSE(cmd_stream_start);
+        PACK8(success);
+        PACK16(success ? stream_frame_size : 0);
+        FINISH_FRAME();
+        send_frame(_buffer, _length);
     }
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+
+/**
+  * @brief Handle a stream stop command
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_stream_stop(void)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    stream_interval_ms = 0;
+    stream_count = 0;
+    softtimer_stop(&stream_timer);
+    return cmd_success;
+}
+
+/**
+  * @brief Handle a subscribe command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_subscribe(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    command_t cmd;
+    uint8_t fields;
+    uint16_t deadband_mv, deadband_ma;
+    DECLARE_UNPACK(payload, payload_len);
+    UNPACK8(cmd);
+    (void) cmd;
+    UNPACK8(fields);
+    UNPACK16(deadband_mv);
+    UNPACK16(deadband_ma);
+    if (payload_len != 6 || fields >= (1 << notify_max_field)) {
+        return cmd_failed;
+    }
+    notify_fields = fields;
+    notify_deadband_mv = deadband_mv;
+    notify_deadband_ma = deadband_ma;
+    if (fields) {
+        /** The first event follows the response */
+        notify_all = true;
+        softtimer_start(&notify_timer, 0, NOTIFY_INTERVAL_MS, &notify_tick);
+    } else {
+        softtimer_stop(&notify_timer);
+    }
+    return cmd_success;
+}
+
+/**
+  * @brief Handle a set calibration command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_set_calibration(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    command_t cmd;
+    uint8_t table, total, first;
+    DECLARE_UNPACK(payload, payload_len);
+    UNPACK8(cmd);
+    (void) cmd;
+    UNPACK8(table);
+    UNPACK8(total);
+    UNPACK8(first);
+    if (payload_len < 4 || _remain % 4 || total > CONFIG_CAL_MAX_POINTS || first + _remain / 4 > total) {
+        return cmd_failed;
+    }
+    if (first == 0) {
+        cal_upload_count = 0;
+    } else if (first != cal_upload_count) {
+        return cmd_failed;
+    }
+    while (_remain) {
+        UNPACK16(cal_upload[cal_upload_count].x);
+        UNPACK16(cal_upload[cal_upload_count].y);
+        cal_upload_count++;
+    }
+    if (cal_upload_count < total) {
+        return cmd_success;
+    }
+    cal_upload_count = 0;
+    return opendps_set_cal_table(table, cal_upload, total) ? cmd_success : cmd_failed;
+}
+
+/**
+  * @brief Switch the UART to a new baud rate, after the queued frames have
+  *        been sent
+  * @param baud the new rate
+  * @retval None
+  */
+static void set_baud(uint32_t baud)
+{
+    hw_uart_set_baudrate(baud);
+    uart_baud = baud;
+    baud_confirmed = false;
+    baud_last_frame = get_ticks();
+    if (baud == UART_DEFAULT_BAUD) {
+        softtimer_stop(&baud_timer);
+    } else if (!softtimer_is_active(&baud_timer)) {
+        softtimer_start(&baud_timer, BAUD_CHECK_MS, BAUD_CHECK_MS, &baud_tick);
+    }
+}
+
+/**
+  * @brief Go back to UART_DEFAULT_BAUD if the host did not confirm the new
+  *        rate in time or has gone quiet
+  * @param timer the baud timer
+  * @retval None
+  */
+static void baud_tick(softtimer_t *timer)
+{
+    (void) timer;
+    uint64_t idle = get_ticks() - baud_last_frame;
+    if (idle >= (baud_confirmed ? BAUD_IDLE_MS : BAUD_CONFIRM_MS)) {
+        dbg_printf("Baud rate %lu %s, back to %u\n", uart_baud, baud_confirmed ? "idle" : "not confirmed", UART_DEFAULT_BAUD);
+        set_baud(UART_DEFAULT_BAUD);
+    }
+}
+
+/**
+  * @brief Handle a set baud command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_set_baud(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    command_t cmd;
+    uint32_t baud;
+    bool success;
+    {
+        DECLARE_UNPACK(payload, payload_len);
+        UNPACK8(cmd);
+        (void) cmd;
+        UNPACK32(baud);
+        success = payload_len == 5 && protocol_baud_supported(baud);
+    }
+    {
+        /** The response goes out at the current rate */
+        DECLARE_TX_FRAME(RESPONSE_PAYLOAD);
+        PACK_RESPONSE(cmd_set_baud);
+        PACK8(success);
+        FINISH_FRAME();
+        send_frame(_buffer, _length);
+    }
+    if (success) {
+        set_baud(baud);
+    }
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+
+/**
+  * @brief Handle an energy query command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_energy_query(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    uint8_t reset = payload_len > 1 ? payload[1] : 0;
+    uint32_t charge_uah, energy_mwh, on_time_s;
+    energy_get(&charge_uah, &energy_mwh, &on_time_s);
+    DECLARE_TX_FRAME(ENERGY_QUERY_PAYLOAD);
+    PACK_RESPONSE(cmd_energy_query);
+    PACK8(1); // Always success
+    PACK32(charge_uah);
+    PACK32(energy_mwh);
+    PACK32(on_time_s);
+    FINISH_FRAME();
+    send_frame(_buffer, _length);
+    if (reset) {
+        energy_reset();
+    }
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+
+#ifdef CONFIG_WAVE
+/**
+  * @brief Handle a waveform command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed or success
+  */
+static command_status_t handle_wave(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    command_t cmd;
+    uint8_t shape;
+    uint32_t frequency;
+    uint16_t offset, amplitude;
+    DECLARE_UNPACK(payload, payload_len);
+    UNPACK8(cmd);
+    (void) cmd;
+    UNPACK8(shape);
+    UNPACK32(frequency);
+    UNPACK16(offset);
+    UNPACK16(amplitude);
+    if (payload_len != 10) {
+        return cmd_failed;
+    }
+    return wave_start((wave_shape_t) shape, frequency, offset, amplitude) ? cmd_success : cmd_failed;
+}
+#endif // CONFIG_WAVE
+
+#ifdef CONFIG_CAPTURE
+/**
+  * @brief Handle a capture arm command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_capture_arm(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    command_t cmd;
+    uint8_t trigger;
+    uint16_t level, decimation, pre;
+    bool success;
+    {
+        DECLARE_UNPACK(payload, payload_len);
+        UNPACK8(cmd);
+        (void) cmd;
+        UNPACK8(trigger);
+        UNPACK16(level);
+        UNPACK16(decimation);
+        UNPACK16(pre);
+        success = payload_len == 8 && capture_arm((capture_trigger_t) trigger, level, decimation, pre);
+    }
+    {
+        DECLARE_TX_FRAME(RESPONSE_PAYLOAD);
+        PACK_RESPONSE(cmd_capture_arm);
+        PACK8(success);
+        PACK16(CONFIG_CAPTURE_SAMPLES);
+        FINISH_FRAME();
+        send_frame(_buffer, _length);
+    }
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+
+/**
+  * @brief Handle a capture read command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_capture_read(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    command_t cmd;
+    uint16_t offset;
+    uint32_t count, trigger_index, decimation;
+    capture_sample_t samples[CAPTURE_SAMPLES_PER_FRAME];
+    {
+        DECLARE_UNPACK(payload, payload_len);
+        UNPACK8(cmd);
+        (void) cmd;
+        UNPACK16(offset);
+        if (payload_len != 3) {
+            return cmd_failed;
+        }
+    }
+    capture_state_t state = capture_get_state(&count, &trigger_index, &decimation);
+    uint32_t num = capture_read(offset, samples, CAPTURE_SAMPLES_PER_FRAME);
+    DECLARE_TX_FRAME(CAPTURE_READ_PAYLOAD);
+    PACK_RESPONSE(cmd_capture_read);
+    PACK8(1);
+    PACK8(state);
+    PACK16(count);
+    PACK16(trigger_index);
+    PACK16(decimation);
+    PACK16(offset);
+    for (uint32_t i = 0; i < num; i++) {
+        PACK16(samples[i].v_out);
+        PACK16(samples[i].i_out);
+        PACK16(samples[i].v_in);
+    }
+    FINISH_FRAME();
+    send_frame(_buffer, _length);
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+#endif // CONFIG_CAPTURE
+
+#ifdef CONFIG_STATS
+/**
+  * @brief Handle a statistics command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_stats(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    command_t cmd;
+    uint16_t block_scans;
+    uint8_t blocks;
+    bool success = payload_len == 1;
+    if (payload_len == 4) {
+        DECLARE_UNPACK(payload, payload_len);
+        UNPACK8(cmd);
+        (void) cmd;
+        UNPACK16(block_scans);
+        UNPACK8(blocks);
+        success = stats_configure(block_scans, blocks);
+    }
+    stats_t stats[stats_max];
+    uint32_t scans = stats_get(stats);
+    uint32_t cur_block_scans, cur_blocks;
+    stats_get_config(&cur_block_scans, &cur_blocks);
+    DECLARE_TX_FRAME(STATS_PAYLOAD);
+    PACK_RESPONSE(cmd_stats);
+    PACK8(success);
+    PACK16(cur_block_scans);
+    PACK8(cur_blocks);
+    PACK32(scans);
+    for (uint32_t c = 0; c < stats_max; c++) {
+        PACK16(stats[c].min);
+        PACK16(stats[c].max);
+        PACK16(stats[c].mean);
+        PACK16(stats[c].rms);
+        PACK32(stats[c].ac_rms);
+    }
+    FINISH_FRAME();
+    send_frame(_buffer, _length);
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+#endif // CONFIG_STATS
+
+#ifdef CONFIG_PROFILING
+/**
+  * @brief Handle a profile dump command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_profile_dump(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    uint8_t reset = payload_len > 1 ? payload[1] : 0;
+    profile_counter_t counters[prof_max];
+    profile_get(counters);
+    if (reset) {
+        profile_reset();
+    }
+    DECLARE_TX_FRAME(PROFILE_DUMP_PAYLOAD);
+    PACK_RESPONSE(cmd_profile_dump);
+    PACK8(1);
+    PACK8(prof_max);
+    for (uint32_t i = 0; i < prof_max; i++) {
+        PACK32(counters[i].count);
+        PACK32(counters[i].min);
+        PACK32(counters[i].count ? (uint32_t) (counters[i].total / counters[i].count) : 0);
+        PACK32(counters[i].max);
+    }
+    FINISH_FRAME();
+    send_frame(_buffer, _length);
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+#endif // CONFIG_PROFILING
+
+#ifdef CONFIG_STACK_WATERMARK
+/**
+  * @brief Handle a stack usage command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_stack_usage(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    (void) payload;
+    (void) payload_len;
+    uint32_t size, used;
+    stack_get(&size, &used);
+    DECLARE_TX_FRAME(STACK_USAGE_PAYLOAD);
+    PACK_RESPONSE(cmd_stack_usage);
+    PACK8(1);
+    PACK16(size);
+    PACK16(used);
+    FINISH_FRAME();
+    send_frame(_buffer, _length);
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+#endif // CONFIG_STACK_WATERMARK
+
+#ifdef CONFIG_MIRROR
+/**
+  * @brief Handle a mirror command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_mirror(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    if (payload_len < 2) {
+        return cmd_failed;
+    }
+    mirror_enable(!!payload[1]);
+    return cmd_success;
+}
+#endif // CONFIG_MIRROR
+
+#ifdef CONFIG_ALARMS
+static command_status_t handle_set_alarms(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    command_t cmd;
+    uint8_t total, first;
+    alarm_rule_t rules[ALARM_RULES_PER_FRAME];
+    uint32_t count = 0;
+    DECLARE_UNPACK(payload, payload_len);
+    UNPACK8(cmd);
+    (void) cmd;
+    UNPACK8(total);
+    UNPACK8(first);
+    if (payload_len < 3 || _remain % 12 || _remain / 12 > ALARM_RULES_PER_FRAME) {
+        return cmd_failed;
+    }
+    while (_remain) {
+        UNPACK8(rules[count].channel);
+        UNPACK8(rules[count].compare);
+        UNPACK8(rules[count].action);
+        UNPACK8(rules[count].function);
+        UNPACK32(rules[count].threshold);
+        UNPACK32(rules[count].hold_ms);
+        count++;
+    }
+    return alarm_upload(total, first, rules, count) ? cmd_success : cmd_failed;
+}
+#endif // CONFIG_ALARMS
+
+#ifdef CONFIG_HISTOGRAM
+/**
+  * @brief Handle a histogram command
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_histogram(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    if (payload_len != 3) {
+        return cmd_failed;
+    }
+    uint8_t channel = payload[1];
+    uint8_t first = payload[2];
+    if (channel >= histogram_max_channel || first > HISTOGRAM_BINS - HISTOGRAM_BINS_PER_FRAME) {
+        return cmd_failed;
+    }
+    const histogram_t *h = histogram_get();
+    DECLARE_TX_FRAME(HISTOGRAM_PAYLOAD);
+    PACK_RESPONSE(cmd_histogram);
+    PACK8(1);
+    PACK16(CONFIG_HISTOGRAM_INTERVAL_MS);
+    PACK8(channel);
+    PACK8(first);
+    for (uint32_t i = 0; i < HISTOGRAM_BINS_PER_FRAME; i++) {
+        PACK32(histogram_samples(h->bins[channel][first + i]));
+    }
+    FINISH_FRAME();
+    send_frame(_buffer, _length);
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+
+/**
+  * @brief Handle a histogram limits command, the counters are reported
+  *        before they are reset or the limits are changed
+  * @param payload payload of command frame
+  * @param payload_len length of payload
+  * @retval command_status_t failed, success or "I sent my own frame"
+  */
+static command_status_t handle_histogram_limits(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    uint16_t limit[HISTOGRAM_LIMITS];
+    if (payload_len != 2 && payload_len != 2 + 2 * HISTOGRAM_LIMITS) {
+        return cmd_failed;
+    }
+    uint8_t reset = payload[1];
+    bool set_limits = payload_len > 2;
+    if (set_limits) {
+        DECLARE_UNPACK(payload + 2, payload_len - 2);
+        for (uint32_t i = 0; i < HISTOGRAM_LIMITS; i++) {
+            UNPACK16(limit[i]);
+        }
+    }
+    const histogram_t *h = histogram_get();
+    DECLARE_TX_FRAME(HISTOGRAM_LIMITS_PAYLOAD);
+    PACK_RESPONSE(cmd_histogram_limits);
+    PACK8(1);
+    PACK16(CONFIG_HISTOGRAM_INTERVAL_MS);
+    for (uint32_t i = 0; i < HISTOGRAM_LIMITS; i++) {
+        PACK16(h->limit[i]);
+        PACK32(histogram_samples(h->above[i]));
+    }
+    FINISH_FRAME();
+    send_frame(_buffer, _length);
+    if (reset) {
+        histogram_reset();
+    }
+    if (set_limits) {
+        histogram_set_limits(limit);
+    }
+    return cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much;
+}
+#endif // CONFIG_HISTOGRAM
+
+#ifdef CONFIG_SEQ_ENABLE
+static command_status_t handle_set_sequence(uint8_t *payload, uint32_t payload_len)
+{
+    emu_printf("%s\n", __FUNCTION__);
+    command_t cmd;
+    uint8_t total, first, repeat;
+    seq_step_t steps[SEQ_STEPS_PER_FRAME];
+    uint32_t count = 0;
+    DECLARE_UNPACK(payload, payload_len);
+    UNPACK8(cmd);
+    (void) cmd;
+    UNPACK8(total);
+    UNPACK8(first);
+    UNPACK8(repeat);
+    if (payload_len < 4 || _remain % 8 || _remain / 8 > SEQ_STEPS_PER_FRAME) {
+        return cmd_failed;
+    }
+    while (_remain) {
+        UNPACK16(steps[count].v_out_mv);
+        UNPACK16(steps[count].i_out_ma);
+        UNPACK32(steps[count].duration_ms);
+        count++;
+    }
+    return func_seq_upload(total, first, repeat, steps, count) ? cmd_success : cmd_failed;
+}
+#endif // CONFIG_SEQ_ENABLE
+
+/**
+  * @brief Send the collected stream samples
+  * @retval None
+  */
+static void send_stream_batch(void)
+{
+    uint32_t length = protocol_create_sample_batch(tx_frame, FRAME_OVERHEAD(MAX_BULK_FRAME_LENGTH), stream_batch_start, stream_interval_ms, stream_samples, stream_count);
+    if (length > 0) {
+        send_frame(tx_frame, length);
+    }
+    stream_count = 0;
+}
+
+/**
+  * @brief Sample and send telemetry, run every stream_interval_ms while
+  *        streaming
+  * @param timer the stream timer
+  * @retval None
+  */
+static void stream_tick(softtimer_t *timer)
+{
+    (void) timer;
+    uint64_t now = get_ticks();
+    if (now < stream_next_sample) {
+        return;
+    }
+    if (now - stream_next_sample >= stream_interval_ms) {
+        /** We fell behind (eg. during a past write), restart the batch so the
+          * implied sample spacing stays correct */
+        if (stream_count) {
+            send_stream_batch();
+        }
+        stream_next_sample = now;
+    }
+    if (stream_count == 0) {
+        stream_batch_start = (uint32_t) stream_next_sample;
+    }
+    stream_next_sample += stream_interval_ms;
+
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    protocol_sample_t *sample = &stream_samples[stream_count];
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+    sample->v_out = pwrctl_calc_vout(v_out_raw);
+    sample->i_out = pwrctl_calc_iout(i_out_raw);
+    sample->v_in = pwrctl_calc_vin(v_in_raw);
+    if (stream_count == 0) {
+        stream_payload_size = SAMPLE_BATCH_HEADER_SIZE;
+    } else {
+        stream_payload_size += protocol_sample_delta_size(sample - 1, sample);
+    }
+    stream_count++;
+    /** Send when full or if the next sample might not fit the frame */
+    if (stream_count == stream_batch_size || stream_payload_size + SAMPLE_MAX_DELTA_SIZE > stream_frame_size) {
+        send_stream_batch();
+    }
+}
+
+/**
+  * @brief Check if a subscribed field changed since it was last sent
+  * @param field the field
+  * @param values the current values of the fields
+  * @retval true if the field is to be sent
+  */
+static bool notify_changed(uint32_t field, const uint16_t *values)
+{
+    uint32_t i = NOTIFY_VALUE(field);
+    switch (field) {
+        case notify_setpoint:
+            return values[i] != notify_sent[i] || values[i + 1] != notify_sent[i + 1];
+        case notify_v_out:
+        case notify_v_in:
+            return abs(values[i] - notify_sent[i]) > notify_deadband_mv;
+        case notify_i_out:
+            return abs(values[i] - notify_sent[i]) > notify_deadband_ma;
+        default:
+            return values[i] != notify_sent[i];
+    }
+}
+
+/**
+  * @brief Send the subscribed fields that changed, run every
+  *        NOTIFY_INTERVAL_MS while subscribed
+  * @param timer the notification timer
+  * @retval None
+  */
+static void notify_tick(softtimer_t *timer)
+{
+    (void) timer;
+    uint16_t values[NOTIFY_MAX_VALUES];
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    int16_t temp1, temp2;
+    bool temp_shutdown;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+    opendps_get_temperature(&temp1, &temp2, &temp_shutdown);
+    values[NOTIFY_VALUE(notify_output)] = pwrctl_vout_enabled();
+    values[NOTIFY_VALUE(notify_function)] = opendps_get_curr_function_idx();
+    values[NOTIFY_VALUE(notify_lock)] = (opendps_is_locked() ? NOTIFY_LOCK_UI : 0) | (temp_shutdown ? NOTIFY_LOCK_TEMPERATURE : 0);
+    values[NOTIFY_VALUE(notify_setpoint)] = pwrctl_get_vout();
+    values[NOTIFY_VALUE(notify_setpoint) + 1] = pwrctl_get_iout();
+    values[NOTIFY_VALUE(notify_v_out)] = pwrctl_calc_vout(v_out_raw);
+    values[NOTIFY_VALUE(notify_i_out)] = pwrctl_calc_iout(i_out_raw);
+    values[NOTIFY_VALUE(notify_v_in)] = pwrctl_calc_vin(v_in_raw);
+
+    uint8_t changed = 0;
+    for (uint32_t field = 0; field < notify_max_field; field++) {
+        if ((notify_fields & (1 << field)) && (notify_all || notify_changed(field, values))) {
+            changed |= 1 << field;
+        }
+    }
+    notify_all = false;
+    if (!changed) {
+        return;
+    }
+    /** Measurements are held to what was sent so a slow drift is reported
+      * once it adds up to the deadband */
+    for (uint32_t field = 0; field < notify_max_field; field++) {
+        if (changed & (1 << field)) {
+            notify_sent[NOTIFY_VALUE(field)] = values[NOTIFY_VALUE(field)];
+            if (field == notify_setpoint) {
+                notify_sent[NOTIFY_VALUE(field) + 1] = values[NOTIFY_VALUE(field) + 1];
+            }
+        }
+    }
+    uint32_t length = protocol_create_change_event(tx_frame, FRAME_OVERHEAD(CHANGE_EVENT_PAYLOAD), changed, values);
+    if (length > 0) {
+        send_frame(tx_frame, length);
+    }
+}
+
+/**
+  * @brief Notify the host that a protection cut power out
+  * @param prot the protection
+  * @param value the voltage in millivolt or power in milliwatt that triggered it
+  * @retval None
+  */
+void serial_send_protection_event(pwrctl_protection_t prot, uint32_t value)
+{
+    uint32_t length = protocol_create_protection_event(tx_frame, FRAME_OVERHEAD(PROTECTION_EVENT_PAYLOAD), (protection_event_t) prot, value);
+    if (length > 0) {
+        send_frame(tx_frame, length);
+    }
+}
+
+/**
+  * @brief Notify the host that OCP cut power out
+  * @param i_cut_ma the current that triggered it
+  * @retval None
+  */
+void serial_send_ocp_event(uint16_t i_cut_ma)
+{
+    uint32_t length = protocol_create_ocp(tx_frame, FRAME_OVERHEAD(OCP_EVENT_PAYLOAD), i_cut_ma);
+    if (length > 0) {
+        send_frame(tx_frame, length);
+    }
+}
+
+/**
+  * @brief Notify the host that the temperature alarm was raised or cleared
+  * @param alarm true if power out is locked due to the temperature
+  * @param temp1 first reported temperature
+  * @param temp2 second reported temperature
+  * @retval None
+  */
+void serial_send_temperature_event(bool alarm, int16_t temp1, int16_t temp2)
+{
+    uint32_t length = protocol_create_temperature_event(tx_frame, FRAME_OVERHEAD(TEMPERATURE_EVENT_PAYLOAD), alarm, temp1, temp2);
+    if (length > 0) {
+        send_frame(tx_frame, length);
+    }
+}
+
+#ifdef CONFIG_ALARMS
+/**
+  * @brief Notify the host that an alarm rule fired
+  * @param rule index of the rule
+  * @param value the reading that fired it
+  * @retval None
+  */
+void serial_send_alarm_event(uint8_t rule, uint32_t value)
+{
+    uint32_t length = protocol_create_alarm_event(tx_frame, FRAME_OVERHEAD(ALARM_EVENT_PAYLOAD), rule, value);
+    if (length > 0) {
+        send_frame(tx_frame, length);
+    }
+}
+#endif // CONFIG_ALARMS
+
+#ifdef CONFIG_MIRROR
+/**
+  * @brief Send mirrored drawing commands
+  * @param seq sequence number of the frame
+  * @param ops the commands
+  * @param length length of the commands, at most MAX_BULK_FRAME_LENGTH - 2
+  * @retval None
+  */
+void serial_send_mirror_data(uint8_t seq, const uint8_t *ops, uint32_t length)
+{
+    uint32_t frame_length = protocol_create_mirror_data(mirror_frame, sizeof(mirror_frame), seq, ops, length);
+    if (frame_length > 0) {
+        send_frame(mirror_frame, frame_length);
+    }
+}
+#endif // CONFIG_MIRROR
+
+/**
+  * @brief Handle a receved frame
+  * @param payload the unescaped payload of the frame
+  * @param payload_len length of payload or -E_* if the frame was invalid
+  * @retval None
+  */
+static void handle_frame(uint8_t *payload, int32_t payload_len)
+{
+    PROFILE_START();
+    command_status_t success = cmd_failed;
+    command_t cmd = cmd_response;
+    if (payload_len > 0 && (payload[0] & cmd_tagged)) {
+        /** Strip the tag so the handlers see an untagged frame */
+        if (payload_len >= 2) {
+            rx_tagged = true;
+            rx_tag = payload[1];
+            payload[1] = payload[0] & ~cmd_tagged;
+        }
+        payload++;
+        payload_len--;
+    }
+    if (payload_len <= 0) {
+        dbg_printf("Frame error %ld\n", payload_len);
+    } else {
+        /** Any valid frame confirms the baud rate, see cmd_set_baud */
+        baud_confirmed = true;
+        baud_last_frame = get_ticks();
+        cmd = payload[0];
+        switch(cmd) {
+            case cmd_ping:
+                success = 1; // Response will be sent below
+                emu_printf("Got pinged\n");
+                opendps_handle_ping();
+                break;
+            case cmd_set_function:
+                success = handle_set_function(payload, payload_len);
+                break;
+            case cmd_list_functions:
+                success = handle_list_functions();
+                break;
+            case cmd_set_parameters:
+                success = handle_set_parameters(payload, payload_len);
+                break;
+            case cmd_list_parameters:
+                success = handle_list_parameters();
+                break;
+            case cmd_set_parameter_values:
+                success = handle_set_parameter_values(payload, payload_len);
+                break;
+            case cmd_get_parameter_values:
+                success = handle_get_parameter_values();
+                break;
+            case cmd_query:
+                success = handle_query();
+                break;
+            case cmd_wifi_status:
+                success = handle_wifi_status(payload, payload_len);
+                break;
+            case cmd_lock:
+                success = handle_lock(payload, payload_len);
+                break;
+            case cmd_upgrade_start:
+                success = handle_upgrade_start(payload, payload_len);
+                break;
+            case cmd_warm_reboot:
+                success = handle_warm_reboot(payload, payload_len);
+                break;
+            case cmd_enable_output:
+                success = handle_enable_output(payload, payload_len);
+                break;
+            case cmd_arm:
+                success = handle_arm(payload, payload_len);
+                break;
+#ifdef CONFIG_PAST_TRANSFER
+            case cmd_past_export:
+                success = handle_past_export(payload, payload_len);
+                break;
+            case cmd_past_import:
+                success = handle_past_import(payload, payload_len);
+                break;
+#endif // CONFIG_PAST_TRANSFER
+            case cmd_fire:
+                success = handle_fire(payload, payload_len);
+                break;
+            case cmd_temperature_report:
+                success = handle_temperature(payload, payload_len);
+                break;
+            case cmd_stream_start:
+                success = handle_stream_start(payload, payload_len);
+                break;
+            case cmd_stream_stop:
+                success = handle_stream_stop();
+                break;
+            case cmd_subscribe:
+                success = handle_subscribe(payload, payload_len);
+                break;
+            case cmd_set_and_measure:
+                success = handle_set_and_measure(payload, payload_len);
+                break;
+            case cmd_set_calibration:
+                success = handle_set_calibration(payload, payload_len);
+                break;
+            case cmd_energy_query:
+                success = handle_energy_query(payload, payload_len);
+                break;
+            case cmd_set_baud:
+                success = handle_set_baud(payload, payload_len);
+                break;
+#ifdef CONFIG_WAVE
+            case cmd_wave:
+                success = handle_wave(payload, payload_len);
+                break;
+#endif // CONFIG_WAVE
+#ifdef CONFIG_CAPTURE
+            case cmd_capture_arm:
+                success = handle_capture_arm(payload, payload_len);
+                break;
+            case cmd_capture_read:
+                success = handle_capture_read(payload, payload_len);
+                break;
+#endif // CONFIG_CAPTURE
+#ifdef CONFIG_STATS
+            case cmd_stats:
+                success = handle_stats(payload, payload_len);
+                break;
+#endif // CONFIG_STATS
+#ifdef CONFIG_PROFILING
+            case cmd_profile_dump:
+                success = handle_profile_dump(payload, payload_len);
+                break;
+#endif // CONFIG_PROFILING
+#ifdef CONFIG_MIRROR
+            case cmd_mirror:
+                success = handle_mirror(payload, payload_len);
+                break;
+#endif // CONFIG_MIRROR
+#ifdef CONFIG_STACK_WATERMARK
+            case cmd_stack_usage:
+                success = handle_stack_usage(payload, payload_len);
+                break;
+#endif // CONFIG_STACK_WATERMARK
+#ifdef CONFIG_ALARMS
+            case cmd_set_alarms:
+                success = handle_set_alarms(payload, payload_len);
+                break;
+#endif // CONFIG_ALARMS
+#ifdef CONFIG_HISTOGRAM
+            case cmd_histogram:
+                success = handle_histogram(payload, payload_len);
+                break;
+            case cmd_histogram_limits:
+                success = handle_histogram_limits(payload, payload_len);
+                break;
+#endif // CONFIG_HISTOGRAM
+#ifdef CONFIG_SEQ_ENABLE
+            case cmd_set_sequence:
+                success = handle_set_sequence(payload, payload_len);
+                break;
+#endif // CONFIG_SEQ_ENABLE
+            default:
+                emu_printf("Got unknown command %d (0x%02x)\n", cmd, cmd);
+                break;
+        }
+    }
+    if (success != cmd_success_but_i_actually_sent_my_own_status_thank_you_very_much && cmd != cmd_response) {
+        DECLARE_TX_FRAME(RESPONSE_PAYLOAD);
+        PACK_RESPONSE(cmd);
+        PACK8(success);
+        FINISH_FRAME();
+        send_frame(_buffer, _length);
+    }
+    rx_tagged = false;
+    PROFILE_END(prof_handle_frame);
+}
+
+/**
+  * @brief Handle received characters, frames are handled as soon as their
+  *        EOF is found
+  * @param buf the received characters
+  * @param length number of characters
+  * @retval None
+  */
+void serial_handle_rx_buffer(const uint8_t *buf, uint32_t length)
+{
+    for (uint32_t i = 0; i < length; i++) {
+        int32_t payload_len = uframe_decode(&rx_decoder, buf[i]);
+        if (payload_len == -E_OVF) {
+            dbg_printf("Error: RX buffer overflow!\n");
+        } else if (payload_len != 0) {
+            handle_frame(frame_buffer, payload_len);
+        }
+    }
+}
+
+/**
+  * @brief Handle received character
+  * @param c well, the received character
+  * @retval None
+  */
+void serial_handle_rx_char(char c)
+{
+    uint8_t b = (uint8_t) c;
+    serial_handle_rx_buffer(&b, 1);
 }
@@ -24,6 +24,10 @@
 
 #include "pwrctl.h"
 #include "dps-model.h"
+#include "hw.h"
+#include "tick.h"
+#include "softtimer.h"
+#include <string.h>
 #include <gpio.h>
 #include <dac.h>
 
@@ -32,11 +36,112 @@
   * https://docs.google.com/spreadsheets/d/1AhGsU_gvZjqZyr2ZYrnkz6BeUqMquzh9UNYoTqy_Zp4/edit?usp=sharing
   */
 
+/** The model constants in fixed point, see dps-model.h */
+static const pwrctl_calibration_t default_calibration = {
+    .v_in_adc = { Q16(16.746), Q16(64.112 - 16.746) }, /** @todo: -1 in raw becuse the value needed trimming */
+    .v_out_adc = { MODEL_V_ADC_K, MODEL_V_ADC_C },
+    .v_out_dac = { MODEL_V_DAC_K, MODEL_V_DAC_C },
+    .i_out_adc = { MODEL_A_ADC_K, MODEL_A_ADC_C },
+    .i_out_dac = { MODEL_A_DAC_K, MODEL_A_DAC_C },
+    .i_limit_adc = { MODEL_I_LIMIT_K, MODEL_I_LIMIT_C },
+};
+
+static pwrctl_calibration_t calibration;
+
+/** Calibration tables in use, if any */
+static pwrctl_cal_point_t cal_points[cal_max][CONFIG_CAL_MAX_POINTS];
+static uint8_t cal_count[cal_max];
+
 static uint32_t i_out, v_out, i_limit;
+#ifdef CONFIG_THERMAL
+/** The current setting programmed is capped by the thermal derating */
+static uint32_t i_out_max = UINT32_MAX;
+#endif // CONFIG_THERMAL
+static uint32_t prot_limit[prot_max];
 static bool v_out_enabled;
+#ifdef CONFIG_WAVE
+/** The waveform generator owns the V_out DAC while this is set */
+static volatile bool vout_dac_held;
+#endif // CONFIG_WAVE
+
+static void apply_calibration(void);
+static uint16_t vout_dac(void);
+static void write_vout_dac(void);
+static uint16_t iout_dac(void);
+#ifdef CONFIG_VOUT_REGULATION
+static void reset_vout_regulation(void);
+#endif // CONFIG_VOUT_REGULATION
+static void update_protection_limits(void);
+
+#ifdef CONFIG_VOUT_REGULATION
+#ifndef CONFIG_VOUT_REG_INTERVAL_MS
+ #define CONFIG_VOUT_REG_INTERVAL_MS  (20)
+#endif
+/** Gains in Q8, the proportional and integral terms are in mV per mV of error */
+#ifndef CONFIG_VOUT_REG_KP
+ #define CONFIG_VOUT_REG_KP  (64)
+#endif
+#ifndef CONFIG_VOUT_REG_KI
+ #define CONFIG_VOUT_REG_KI  (32)
+#endif
+/** Limit of the integral and of the total trim in mV */
+#ifndef CONFIG_VOUT_REG_MAX_TRIM
+ #define CONFIG_VOUT_REG_MAX_TRIM  (300)
+#endif
+/** The integral is held while I_out is within this many percent of the
+  * constant current setting as V_out then sags by design */
+#define VOUT_REG_CC_MARGIN  (5)
+/** Let the output settle this long after a change before trimming */
+#define VOUT_REG_SETTLE_MS  (100)
+
+static softtimer_t v_reg_timer; /** Active while regulation is enabled */
+static int32_t v_reg_integral; /** Q8 mV */
+static int32_t v_trim;         /** mV */
+static uint64_t v_reg_next;
+#endif // CONFIG_VOUT_REGULATION
+
+#ifdef CONFIG_SOFT_START
+/** Time the V_out DAC is ramped over when power out is enabled */
+#ifndef CONFIG_SOFT_START_MS
+ #define CONFIG_SOFT_START_MS  (50)
+#endif
+/** The DAC is stepped every tick of the ramp */
+#define SOFT_START_STEP_MS  (1)
 
-/** not static as it is referred to from hw.c for performance reasons */
+static softtimer_t ramp_timer; /** Active while ramping */
+static uint32_t ramp_ms = CONFIG_SOFT_START_MS;
+static uint64_t ramp_start;
+static bool is_ramping;
+#endif // CONFIG_SOFT_START
+
+#ifdef CONFIG_DAC_LUT
+#ifndef CONFIG_DAC_LUT_SEGMENTS
+ #define CONFIG_DAC_LUT_SEGMENTS  (64)
+#endif
+
+/** Setpoints per segment as a power of 2, the tables covering 65.5V and,
+  * depending on the model, 8.2A to 32.8A */
+#define DAC_LUT_V_SHIFT  (10)
+#if CONFIG_DPS_MAX_CURRENT > 16384
+ #define DAC_LUT_I_SHIFT  (9)
+#elif CONFIG_DPS_MAX_CURRENT > 8192
+ #define DAC_LUT_I_SHIFT  (8)
+#else
+ #define DAC_LUT_I_SHIFT  (7)
+#endif
+
+/** DAC codes at every segment boundary, built from the calibration */
+static uint16_t v_out_dac_lut[CONFIG_DAC_LUT_SEGMENTS + 1];
+static uint16_t i_out_dac_lut[CONFIG_DAC_LUT_SEGMENTS + 1];
+
+static void build_dac_luts(void);
+#endif // CONFIG_DAC_LUT
+
+/** not static as they are referred to from hw.c for performance reasons */
 uint32_t pwrctl_i_limit_raw;
+uint32_t pwrctl_prot_limit_raw[prot_max];
+int32_t pwrctl_v_out_zero_raw;
+int32_t pwrctl_i_out_zero_raw;
 
 /**
   * @brief Initialize the power control module
@@ -44,9 +149,382 @@ uint32_t pwrctl_i_limit_raw;
   */
 void pwrctl_init(void)
 {
+    calibration = default_calibration;
+#ifdef CONFIG_DAC_LUT
+    build_dac_luts();
+#endif // CONFIG_DAC_LUT
+    update_protection_limits();
     pwrctl_enable_vout(false);
 }
 
+/**
+  * @brief Get the calibration of the model we're built for
+  * @retval the default calibration
+  */
+const pwrctl_calibration_t *pwrctl_default_calibration(void)
+{
+    return &default_calibration;
+}
+
+/**
+  * @brief Set the calibration used by the pwrctl_calc_* functions, the DAC
+  *        outputs and the current limit are updated accordingly
+  * @param cal the new calibration, copied
+  * @retval none
+  */
+void pwrctl_set_calibration(const pwrctl_calibration_t *cal)
+{
+    calibration = *cal;
+    apply_calibration();
+}
+
+/**
+  * @brief Get the calibration in use
+  * @retval the calibration
+  */
+const pwrctl_calibration_t *pwrctl_get_calibration(void)
+{
+    return &calibration;
+}
+
+/**
+  * @brief Set a piecewise linear calibration table, values outside the
+  *        table are extrapolated from the end segments
+  * @param table the table to set
+  * @param points the points, both x and y strictly increasing. ADC tables
+  *        must have x within 12 bits
+  * @param count number of points, 2..CONFIG_CAL_MAX_POINTS or 0 to revert
+  *        to the linear conversion
+  * @retval true if the table was valid and is now used
+  */
+bool pwrctl_set_cal_table(pwrctl_cal_table_t table, const pwrctl_cal_point_t *points, uint32_t count)
+{
+    if (table >= cal_max || count == 1 || count > CONFIG_CAL_MAX_POINTS) {
+        return false;
+    }
+    for (uint32_t i = 1; i < count; i++) {
+        if (points[i].x <= points[i-1].x || points[i].y <= points[i-1].y) {
+            return false;
+        }
+    }
+    /** Keeps the products in interpolate() within 32 bits */
+    if (count && (table == cal_v_out_adc || table == cal_i_out_adc) && points[count-1].x > 0xfff) {
+        return false;
+    }
+    memcpy(cal_points[table], points, count * sizeof(pwrctl_cal_point_t));
+    cal_count[table] = count;
+    apply_calibration();
+    return true;
+}
+
+/**
+  * @brief Get a calibration table
+  * @param table the table
+  * @param points set to the points of the table
+  * @retval number of points, 0 if the linear conversion is used
+  */
+uint32_t pwrctl_get_cal_table(pwrctl_cal_table_t table, const pwrctl_cal_point_t **points)
+{
+    if (table >= cal_max) {
+        return 0;
+    }
+    *points = cal_points[table];
+    return cal_count[table];
+}
+
+/**
+  * @brief Update the outputs and the current limit after the calibration
+  *        changed
+  * @retval none
+  */
+static void apply_calibration(void)
+{
+#ifdef CONFIG_DAC_LUT
+    build_dac_luts();
+#endif // CONFIG_DAC_LUT
+    pwrctl_i_limit_raw = pwrctl_calc_ilimit_adc(i_limit);
+#ifdef CONFIG_OCP_AWD
+    hw_update_ocp_limit();
+#endif // CONFIG_OCP_AWD
+    update_protection_limits();
+    (void) pwrctl_set_vout(v_out);
+    (void) pwrctl_set_iout(i_out);
+}
+
+/**
+  * @brief Look up a value in a calibration table
+  * @param table the table, must have at least 2 points
+  * @param v value to look up, with frac_bits fractional bits
+  * @param frac_bits number of fractional bits of v
+  * @param inverse if true, look up x from y
+  * @retval the interpolated value, negative results are clamped to 0
+  * @note All 16 bit operands, the products fit 32 bits and the division is
+  *       a hardware divide
+  */
+static uint32_t interpolate(pwrctl_cal_table_t table, uint32_t v, uint32_t frac_bits, bool inverse)
+{
+    const pwrctl_cal_point_t *p = cal_points[table];
+    uint32_t lo = 0, hi = cal_count[table] - 1;
+    while (hi - lo > 1) {
+        uint32_t mid = (lo + hi) / 2;
+        if ((uint32_t) (inverse ? p[mid].y : p[mid].x) << frac_bits <= v) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    uint32_t in_lo = (uint32_t) (inverse ? p[lo].y : p[lo].x) << frac_bits;
+    uint32_t in_hi = (uint32_t) (inverse ? p[hi].y : p[hi].x) << frac_bits;
+    uint32_t out_lo = inverse ? p[lo].x : p[lo].y;
+    uint32_t out_hi = inverse ? p[hi].x : p[hi].y;
+    if (v >= in_lo) {
+        return out_lo + (out_hi - out_lo) * (v - in_lo) / (in_hi - in_lo);
+    } else {
+        uint32_t d = (out_hi - out_lo) * (in_lo - v) / (in_hi - in_lo);
+        return d < out_lo ? out_lo - d : 0;
+    }
+}
+
+/**
+  * @brief Apply a conversion
+  * @param coeff the coefficients
+  * @param x the value to convert
+  * @param frac_bits number of fractional bits of x
+  * @retval k*x + c, negative results are clamped to 0
+  */
+static inline uint32_t convert(const pwrctl_coeff_t *coeff, uint32_t x, uint32_t frac_bits)
+{
+    int64_t y = ((int64_t) coeff->k * x + (int64_t) coeff->c * (1 << frac_bits)) >> (16 + frac_bits);
+    return y < 0 ? 0 : y;
+}
+
+/**
+  * @brief Invert a linear ADC conversion
+  * @param coeff the raw -> mV/mA coefficients
+  * @param y the value in mV/mA
+  * @retval the raw value x where k*x + c is y, rounded down and limited to
+  *         12 bits
+  * @note Only used when limits change, the 64 bit division is not on any
+  *       sample path
+  */
+static int32_t invert(const pwrctl_coeff_t *coeff, uint32_t y)
+{
+    if (coeff->k <= 0) {
+        return 0xfff;
+    }
+    int64_t x = (((int64_t) y << 16) - coeff->c) / coeff->k;
+    return x > 0xfff ? 0xfff : x;
+}
+
+/**
+  * @brief Calculate the V_out DAC setting from the calibration
+  * @param v_out_mv the voltage
+  * @retval the DAC value, not limited to 12 bits
+  */
+static uint32_t vout_dac_exact(uint32_t v_out_mv)
+{
+    if (cal_count[cal_v_out_dac]) {
+        return interpolate(cal_v_out_dac, v_out_mv, 0, false);
+    }
+    return convert(&calibration.v_out_dac, v_out_mv, 0);
+}
+
+/**
+  * @brief Calculate the I_limit DAC setting from the calibration
+  * @param i_out_ma the current
+  * @retval the DAC value, not limited to 12 bits
+  */
+static uint32_t iout_dac_exact(uint32_t i_out_ma)
+{
+    if (cal_count[cal_i_out_dac]) {
+        return interpolate(cal_i_out_dac, i_out_ma, 0, false);
+    }
+    return convert(&calibration.i_out_dac, i_out_ma, 0);
+}
+
+#ifdef CONFIG_DAC_LUT
+/**
+  * @brief Build the DAC lookup tables, called whenever the calibration
+  *        changes
+  * @retval none
+  * @note The linear conversion is reproduced within 1 LSB. With calibration
+  *       tables, the points falling inside a segment are approximated by
+  *       the segment
+  */
+static void build_dac_luts(void)
+{
+    for (uint32_t i = 0; i <= CONFIG_DAC_LUT_SEGMENTS; i++) {
+        uint32_t v = vout_dac_exact(i << DAC_LUT_V_SHIFT);
+        uint32_t a = iout_dac_exact(i << DAC_LUT_I_SHIFT);
+        v_out_dac_lut[i] = v > 0xffff ? 0xffff : v;
+        i_out_dac_lut[i] = a > 0xffff ? 0xffff : a;
+    }
+}
+
+/**
+  * @brief Look up a DAC setting
+  * @param lut the table
+  * @param shift log2 of the setpoints per segment
+  * @param x the setpoint, within the table
+  * @retval the DAC value interpolated between the segment ends
+  */
+static inline uint32_t lut_lookup(const uint16_t *lut, uint32_t shift, uint32_t x)
+{
+    uint32_t i = x >> shift;
+    uint32_t frac = x & ((1 << shift) - 1);
+    return lut[i] + (((int32_t) (lut[i + 1] - lut[i]) * (int32_t) frac) >> shift);
+}
+#endif // CONFIG_DAC_LUT
+
+/**
+  * @brief Calculate the raw protection limits from the limits and the
+  *        calibration
+  * @retval none
+  */
+static void update_protection_limits(void)
+{
+    if (cal_count[cal_v_out_adc]) {
+        pwrctl_v_out_zero_raw = interpolate(cal_v_out_adc, 0, 0, true);
+    } else {
+        pwrctl_v_out_zero_raw = invert(&calibration.v_out_adc, 0);
+    }
+    pwrctl_prot_limit_raw[prot_ovp] = pwrctl_calc_vout_adc(prot_limit[prot_ovp]);
+    if (cal_count[cal_i_out_adc]) {
+        pwrctl_i_out_zero_raw = interpolate(cal_i_out_adc, 0, 0, true);
+    } else {
+        pwrctl_i_out_zero_raw = invert(&calibration.i_out_adc, 0);
+    }
+    /** P[mW] = k_v * k_i * raw product / 1000, the slopes being Q16.16 */
+    uint64_t k = (uint64_t) calibration.v_out_adc.k * calibration.i_out_adc.k;
+    uint64_t opp = k ? ((uint64_t) prot_limit[prot_opp] * 1000 << 32) / k : 0;
+    pwrctl_prot_limit_raw[prot_opp] = opp > 0xffffffff ? 0xffffffff : opp;
+    for (uint32_t p = 0; p < prot_max; p++) {
+        if (!prot_limit[p]) {
+            pwrctl_prot_limit_raw[p] = 0; /** Disabled */
+        } else if (!pwrctl_prot_limit_raw[p]) {
+            pwrctl_prot_limit_raw[p] = 1; /** Limits below the first step trip on any reading */
+        }
+    }
+}
+
+/**
+  * @brief Set a protection limit
+  * @param prot the protection
+  * @param limit limit in millivolt or milliwatt, 0 disables the protection
+  * @retval true if the protection exists
+  */
+bool pwrctl_set_protection(pwrctl_protection_t prot, uint32_t limit)
+{
+    if (prot >= prot_max) {
+        return false;
+    }
+    prot_limit[prot] = limit;
+    update_protection_limits();
+    return true;
+}
+
+/**
+  * @brief Get a protection limit
+  * @param prot the protection
+  * @retval limit in millivolt or milliwatt, 0 if disabled
+  */
+uint32_t pwrctl_get_protection(pwrctl_protection_t prot)
+{
+    return prot < prot_max ? prot_limit[prot] : 0;
+}
+
+/**
+  * @brief Calculate the V_out DAC setting including the regulation trim
+  * @retval the DAC value
+  */
+static uint16_t vout_dac(void)
+{
+#ifdef CONFIG_VOUT_REGULATION
+    int32_t target = (int32_t) v_out + v_trim;
+    uint32_t dac = pwrctl_calc_vout_dac(target < 0 ? 0 : target);
+#else // CONFIG_VOUT_REGULATION
+    uint32_t dac = pwrctl_calc_vout_dac(v_out);
+#endif // CONFIG_VOUT_REGULATION
+#ifdef CONFIG_SOFT_START
+    if (is_ramping) {
+        uint32_t elapsed = get_ticks() - ramp_start;
+        if (elapsed < ramp_ms) {
+            /** The DAC code is ramped linearly from 0 */
+            return dac * elapsed / ramp_ms;
+        }
+        is_ramping = false;
+        softtimer_stop(&ramp_timer);
+    }
+#endif // CONFIG_SOFT_START
+    return dac;
+}
+
+/**
+  * @brief Write the V_out DAC, 0 while power out is disabled
+  * @retval none
+  */
+static void write_vout_dac(void)
+{
+#ifdef CONFIG_WAVE
+    if (vout_dac_held) {
+        return;
+    }
+#endif // CONFIG_WAVE
+    if (v_out_enabled) {
+        /** Needed for the DPS5005 "communications version" (the one with BT/USB) */
+        DAC_DHR12R1 = vout_dac();
+    } else {
+        DAC_DHR12R1 = 0;
+    }
+}
+
+#ifdef CONFIG_WAVE
+/**
+  * @brief Hand the V_out DAC to the waveform generator, or take it back
+  * @param hold true while the DAC is fed by DMA
+  * @retval none
+  */
+void pwrctl_hold_vout_dac(bool hold)
+{
+    vout_dac_held = hold;
+    write_vout_dac();
+}
+#endif // CONFIG_WAVE
+
+#ifdef CONFIG_SOFT_START
+/**
+  * @brief Step the ramp of the V_out DAC, the OCP stays armed throughout
+  * @param timer the ramp timer
+  * @retval none
+  */
+static void ramp_step(softtimer_t *timer)
+{
+    (void) timer;
+    if (v_out_enabled) {
+        write_vout_dac();
+    }
+}
+
+/**
+  * @brief Set the soft start time
+  * @param ms time V_out is ramped over when enabled, 0 to enable at once
+  * @retval none
+  */
+void pwrctl_set_soft_start(uint32_t ms)
+{
+    ramp_ms = ms;
+}
+
+/**
+  * @brief Get the soft start time
+  * @retval time V_out is ramped over when enabled
+  */
+uint32_t pwrctl_get_soft_start(void)
+{
+    return ramp_ms;
+}
+#endif // CONFIG_SOFT_START
+
 /**
   * @brief Set voltage output
   * @param value_mv voltage in milli volt
@@ -55,13 +533,14 @@ void pwrctl_init(void)
 bool pwrctl_set_vout(uint32_t value_mv)
 {
     /** @todo Check with max Vout, currently filtered by ui.c */
-    v_out = value_mv;
-    if (v_out_enabled) {
-        /** Needed for the DPS5005 "communications version" (the one with BT/USB) */
-        DAC_DHR12R1 = pwrctl_calc_vout_dac(v_out);
-    } else {
-        DAC_DHR12R1 = 0;
+#ifdef CONFIG_VOUT_REGULATION
+    if (value_mv != v_out) {
+        /** Keep the integral, the load likely is the same */
+        v_reg_next = get_ticks() + VOUT_REG_SETTLE_MS;
     }
+#endif // CONFIG_VOUT_REGULATION
+    v_out = value_mv;
+    write_vout_dac();
     return true;
 }
 
@@ -74,13 +553,75 @@ bool pwrctl_set_iout(uint32_t value_ma)
 {
     i_out = value_ma;
     if (v_out_enabled) {
-        DAC_DHR12R2 = pwrctl_calc_iout_dac(value_ma);
+        DAC_DHR12R2 = iout_dac();
     } else {
         DAC_DHR12R2 = 0;
     }
     return true;
 }
 
+/**
+  * @brief Set voltage and current output together
+  * @param v_out_mv voltage in milli volt
+  * @param i_out_ma current in milli ampere
+  * @retval true requested output was within specs
+  */
+bool pwrctl_set_output(uint32_t v_out_mv, uint32_t i_out_ma)
+{
+#ifdef CONFIG_VOUT_REGULATION
+    if (v_out_mv != v_out) {
+        v_reg_next = get_ticks() + VOUT_REG_SETTLE_MS;
+    }
+#endif // CONFIG_VOUT_REGULATION
+    v_out = v_out_mv;
+    i_out = i_out_ma;
+#ifdef CONFIG_WAVE
+    if (vout_dac_held) {
+        /** The waveform generator feeds channel 1, leave it be */
+        return pwrctl_set_iout(i_out_ma);
+    }
+#endif // CONFIG_WAVE
+    if (v_out_enabled) {
+        /** The dual channel register writes channel 1 (V) and 2 (I) at once */
+        DAC_DHR12RD = ((uint32_t) iout_dac() << 16) | vout_dac();
+    } else {
+        DAC_DHR12RD = 0;
+    }
+    return true;
+}
+
+/**
+  * @brief Get the DAC value of the current setting, capped by the thermal
+  *        derating
+  * @retval the DAC value
+  */
+static uint16_t iout_dac(void)
+{
+#ifdef CONFIG_THERMAL
+    return pwrctl_calc_iout_dac(i_out < i_out_max ? i_out : i_out_max);
+#else // CONFIG_THERMAL
+    return pwrctl_calc_iout_dac(i_out);
+#endif // CONFIG_THERMAL
+}
+
+#ifdef CONFIG_THERMAL
+/**
+  * @brief Cap the current programmed while the output is enabled, the
+  *        setting is kept and restored when the cap is lifted
+  * @param max_ma the cap in milliampere, UINT32_MAX for none
+  * @retval none
+  */
+void pwrctl_set_iout_max(uint32_t max_ma)
+{
+    if (max_ma != i_out_max) {
+        i_out_max = max_ma;
+        if (v_out_enabled) {
+            DAC_DHR12R2 = iout_dac();
+        }
+    }
+}
+#endif // CONFIG_THERMAL
+
 /**
   * @brief Get current output setting
   * @retval current setting in milli amps
@@ -109,6 +650,9 @@ bool pwrctl_set_ilimit(uint32_t value_ma)
     /** @todo Check with I_limit, currently filtered by ui.c */
     i_limit = value_ma;
     pwrctl_i_limit_raw = pwrctl_calc_ilimit_adc(i_limit);
+#ifdef CONFIG_OCP_AWD
+    hw_update_ocp_limit();
+#endif // CONFIG_OCP_AWD
     return true;
 }
 
@@ -128,25 +672,42 @@ uint32_t pwrctl_get_ilimit(void)
   */
 void pwrctl_enable_vout(bool enable)
 {
+#ifdef CONFIG_WAVE
+    if (!enable && vout_dac_held) {
+        /** Called by the protections too, the DMA must stop first */
+        hw_dac_wave_stop();
+        vout_dac_held = false;
+    }
+#endif // CONFIG_WAVE
     v_out_enabled = enable;
+#ifdef CONFIG_SOFT_START
+    is_ramping = enable && ramp_ms > 0;
+    if (is_ramping) {
+        ramp_start = get_ticks();
+        softtimer_start(&ramp_timer, SOFT_START_STEP_MS, SOFT_START_STEP_MS, &ramp_step);
+    } else {
+        softtimer_stop(&ramp_timer);
+    }
+#endif // CONFIG_SOFT_START
     if (v_out_enabled) {
+#ifdef CONFIG_VOUT_REGULATION
+        reset_vout_regulation();
+#ifdef CONFIG_SOFT_START
+        /** Do not trim on the ramp */
+        v_reg_next += ramp_ms;
+#endif // CONFIG_SOFT_START
+#endif // CONFIG_VOUT_REGULATION
       (void) pwrctl_set_vout(v_out);
       (void) pwrctl_set_iout(i_out);
-#ifdef DPS5015
-        //gpio_clear(GPIOA, GPIO9); // this is power control on '5015
-        gpio_set(GPIOB, GPIO11);    // B11 is fan control on '5015
-        gpio_clear(GPIOC, GPIO13);  // C13 is power control on '5015
-#else
-        gpio_clear(GPIOB, GPIO11);  // B11 is power control on '5005
-#endif
+#if defined(MODEL_FAN_PIN) && !defined(CONFIG_THERMAL) /** The thermal loop runs the fan */
+        gpio_set(MODEL_FAN_PORT, MODEL_FAN_PIN);
+#endif // MODEL_FAN_PIN && !CONFIG_THERMAL
+        gpio_clear(MODEL_PWR_PORT, MODEL_PWR_PIN);
     } else {
-#ifdef DPS5015
-        //gpio_set(GPIOA, GPIO9);    // gpio_set(GPIOB, GPIO11);
-        gpio_clear(GPIOB, GPIO11); // B11 is fan control on '5015
-        gpio_set(GPIOC, GPIO13);   // C13 is power control on '5015
-#else
-        gpio_set(GPIOB, GPIO11);  // B11 is power control on '5005
-#endif
+#if defined(MODEL_FAN_PIN) && !defined(CONFIG_THERMAL)
+        gpio_clear(MODEL_FAN_PORT, MODEL_FAN_PIN);
+#endif // MODEL_FAN_PIN && !CONFIG_THERMAL
+        gpio_set(MODEL_PWR_PORT, MODEL_PWR_PIN);
       (void) pwrctl_set_vout(v_out);
       (void) pwrctl_set_iout(i_out);
     }
@@ -163,22 +724,36 @@ bool pwrctl_vout_enabled(void)
 
 /**
   * @brief Calculate V_in based on raw ADC measurement
-  * @param raw value from ADC
+  * @param raw value from ADC, with HW_ADC_FRAC_BITS fractional bits
   * @retval corresponding voltage in milli volt
   */
 uint32_t pwrctl_calc_vin(uint16_t raw)
 {
-    return 16.746*(raw-1) + 64.112; /** @todo: -1 becuse the value needed trimming */
+    return convert(&calibration.v_in_adc, raw, HW_ADC_FRAC_BITS);
+}
+
+/**
+  * @brief Calculate the raw 12 bit ADC sample of a V_in
+  * @param v_in_mv the voltage in millivolt
+  * @retval the largest raw sample at or below v_in_mv
+  */
+uint16_t pwrctl_calc_vin_adc(uint32_t v_in_mv)
+{
+    int32_t raw = invert(&calibration.v_in_adc, v_in_mv);
+    return raw < 0 ? 0 : raw;
 }
 
 /**
   * @brief Calculate V_out based on raw ADC measurement
-  * @param raw value from ADC
+  * @param raw value from ADC, with HW_ADC_FRAC_BITS fractional bits
   * @retval corresponding voltage in milli volt
   */
 uint32_t pwrctl_calc_vout(uint16_t raw)
 {
-    return V_ADC_K*raw + V_ADC_C;
+    if (cal_count[cal_v_out_adc]) {
+        return interpolate(cal_v_out_adc, raw, HW_ADC_FRAC_BITS, false);
+    }
+    return convert(&calibration.v_out_adc, raw, HW_ADC_FRAC_BITS);
 }
 
 /**
@@ -188,28 +763,55 @@ uint32_t pwrctl_calc_vout(uint16_t raw)
   */
 uint16_t pwrctl_calc_vout_dac(uint32_t v_out_mv)
 {
-    uint32_t dac = V_DAC_K*v_out_mv + V_DAC_C;
-    return dac & 0xfff; /** 12 bits */
+#ifdef CONFIG_DAC_LUT
+    if (v_out_mv < (CONFIG_DAC_LUT_SEGMENTS << DAC_LUT_V_SHIFT)) {
+        return lut_lookup(v_out_dac_lut, DAC_LUT_V_SHIFT, v_out_mv) & 0xfff; /** 12 bits */
+    }
+#endif // CONFIG_DAC_LUT
+    return vout_dac_exact(v_out_mv) & 0xfff; /** 12 bits */
 }
 
 /**
   * @brief Calculate I_out based on raw ADC measurement
-  * @param raw value from ADC
+  * @param raw value from ADC, with HW_ADC_FRAC_BITS fractional bits
   * @retval corresponding current in milliampere
   */
 uint32_t pwrctl_calc_iout(uint16_t raw)
 {
-    return A_ADC_K*raw + A_ADC_C;
+    if (cal_count[cal_i_out_adc]) {
+        return interpolate(cal_i_out_adc, raw, HW_ADC_FRAC_BITS, false);
+    }
+    return convert(&calibration.i_out_adc, raw, HW_ADC_FRAC_BITS);
 }
 
 /**
   * @brief Calculate expected raw ADC value based on selected I_limit
   * @param i_limit_ma selected I_limit
-  * @retval expected raw ADC value
+  * @retval expected raw ADC value, compared to single samples so there are
+  *         no fractional bits
   */
 uint16_t pwrctl_calc_ilimit_adc(uint16_t i_limit_ma)
 {
-    return (i_limit_ma - A_ADC_C) / A_ADC_K + 1;
+    if (cal_count[cal_i_out_adc]) {
+        /** Rounded up like the linear conversion */
+        return interpolate(cal_i_out_adc, i_limit_ma, 0, true) + 1;
+    }
+    return convert(&calibration.i_limit_adc, i_limit_ma, 0);
+}
+
+/**
+  * @brief Calculate expected raw ADC value for a V_out
+  * @param v_out_mv the voltage
+  * @retval expected raw ADC value, compared to single samples so there are
+  *         no fractional bits
+  */
+uint16_t pwrctl_calc_vout_adc(uint32_t v_out_mv)
+{
+    if (cal_count[cal_v_out_adc]) {
+        return interpolate(cal_v_out_adc, v_out_mv, 0, true);
+    }
+    int32_t raw = invert(&calibration.v_out_adc, v_out_mv);
+    return raw < 0 ? 0 : raw;
 }
 
 /**
@@ -221,6 +823,81 @@ uint16_t pwrctl_calc_ilimit_adc(uint16_t i_limit_ma)
   */
 uint16_t pwrctl_calc_iout_dac(uint32_t i_out_ma)
 {
-    uint32_t dac = A_DAC_K * i_out_ma + A_DAC_C;
-    return dac & 0xfff; /** 12 bits */
+#ifdef CONFIG_DAC_LUT
+    if (i_out_ma < (CONFIG_DAC_LUT_SEGMENTS << DAC_LUT_I_SHIFT)) {
+        return lut_lookup(i_out_dac_lut, DAC_LUT_I_SHIFT, i_out_ma) & 0xfff; /** 12 bits */
+    }
+#endif // CONFIG_DAC_LUT
+    return iout_dac_exact(i_out_ma) & 0xfff; /** 12 bits */
+}
+
+#ifdef CONFIG_VOUT_REGULATION
+/**
+  * @brief Forget the trim, the load may have changed
+  * @retval none
+  */
+static void reset_vout_regulation(void)
+{
+    v_reg_integral = 0;
+    v_trim = 0;
+    v_reg_next = get_ticks() + VOUT_REG_SETTLE_MS;
+}
+
+/**
+  * @brief Enable or disable the V_out trim loop, the trim is reset
+  * @param enable true to regulate V_out on the measured value
+  * @retval none
+  */
+void pwrctl_set_vout_regulation(bool enable)
+{
+    reset_vout_regulation();
+    if (enable) {
+        softtimer_start(&v_reg_timer, CONFIG_VOUT_REG_INTERVAL_MS, CONFIG_VOUT_REG_INTERVAL_MS, &regulate_vout);
+    } else {
+        softtimer_stop(&v_reg_timer);
+    }
+    (void) pwrctl_set_vout(v_out);
+}
+
+/**
+  * @brief Run the V_out trim loop, every CONFIG_VOUT_REG_INTERVAL_MS while
+  *        regulation is enabled. Does nothing while settling.
+  * @param timer the regulation timer
+  * @retval none
+  */
+static void regulate_vout(softtimer_t *timer)
+{
+    (void) timer;
+    if (!v_out_enabled || !v_out) {
+        v_reg_next = get_ticks() + VOUT_REG_SETTLE_MS;
+        return;
+    }
+    if (get_ticks() < v_reg_next) {
+        return;
+    }
+
+    uint16_t i_out_raw, v_in_raw, v_out_raw;
+    hw_get_adc_values(&i_out_raw, &v_in_raw, &v_out_raw);
+    (void) v_in_raw;
+    int32_t error = (int32_t) v_out - (int32_t) pwrctl_calc_vout(v_out_raw);
+    bool limited = pwrctl_calc_iout(i_out_raw) * 100 >= i_out * (100 - VOUT_REG_CC_MARGIN);
+    if (!limited) {
+        v_reg_integral += CONFIG_VOUT_REG_KI * error;
+        if (v_reg_integral > CONFIG_VOUT_REG_MAX_TRIM << 8) {
+            v_reg_integral = CONFIG_VOUT_REG_MAX_TRIM << 8;
+        } else if (v_reg_integral < -(CONFIG_VOUT_REG_MAX_TRIM << 8)) {
+            v_reg_integral = -(CONFIG_VOUT_REG_MAX_TRIM << 8);
+        }
+    }
+    int32_t trim = (limited ? v_reg_integral : CONFIG_VOUT_REG_KP * error + v_reg_integral) / 256;
+    if (trim > CONFIG_VOUT_REG_MAX_TRIM) {
+        trim = CONFIG_VOUT_REG_MAX_TRIM;
+    } else if (trim < -CONFIG_VOUT_REG_MAX_TRIM) {
+        trim = -CONFIG_VOUT_REG_MAX_TRIM;
+    }
+    if (trim != v_trim) {
+        v_trim = trim;
+        write_vout_dac();
+    }
 }
+#endif // CONFIG_VOUT_REGULATION
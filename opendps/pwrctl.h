@@ -30,6 +30,58 @@
 
 extern uint32_t pwrctl_i_limit_raw;
 
+/** Protections checked on every ADC scan alongside the OCP, see hw.c */
+typedef enum {
+    prot_ovp = 0, /** Over voltage, limit in millivolt */
+    prot_opp,     /** Over power, limit in milliwatt */
+    prot_max
+} pwrctl_protection_t;
+
+/** Raw protection limits, 0 when disabled. The OVP limit is compared to
+  * V_out samples and the OPP limit to the product of the V_out and I_out
+  * samples less their zero points. */
+extern uint32_t pwrctl_prot_limit_raw[prot_max];
+extern int32_t pwrctl_v_out_zero_raw;
+extern int32_t pwrctl_i_out_zero_raw;
+
+/** A linear conversion y = k*x + c, k and c being Q16.16 fixed point */
+typedef struct {
+    int32_t k;
+    int32_t c;
+} pwrctl_coeff_t;
+
+/** The conversions between raw ADC/DAC values and milli volt/ampere. The ADC
+  * coefficients are for 12 bit samples, fractional bits from oversampling
+  * are handled by the conversions. */
+typedef struct {
+    pwrctl_coeff_t v_in_adc;    /** raw -> mV */
+    pwrctl_coeff_t v_out_adc;   /** raw -> mV */
+    pwrctl_coeff_t v_out_dac;   /** mV -> raw */
+    pwrctl_coeff_t i_out_adc;   /** raw -> mA */
+    pwrctl_coeff_t i_out_dac;   /** mA -> raw */
+    pwrctl_coeff_t i_limit_adc; /** mA -> raw */
+} pwrctl_calibration_t;
+
+/** Calibration tables replacing the linear conversions. DAC tables map
+  * mV/mA to DAC values and ADC tables map 12 bit samples to mV/mA, the
+  * I_out ADC table is also used backwards for the current limit. */
+typedef enum {
+    cal_v_out_adc = 0,
+    cal_v_out_dac,
+    cal_i_out_adc,
+    cal_i_out_dac,
+    cal_max
+} pwrctl_cal_table_t;
+
+#ifndef CONFIG_CAL_MAX_POINTS
+ #define CONFIG_CAL_MAX_POINTS  (16)
+#endif
+
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+} pwrctl_cal_point_t;
+
 /**
   * @brief Initialize the power control module
   * @retval none
@@ -50,6 +102,25 @@ bool pwrctl_set_vout(uint32_t value_mv);
   */
 bool pwrctl_set_iout(uint32_t value_ma);
 
+/**
+  * @brief Set voltage and current output together, both DACs are updated in
+  *        the same cycle so the output never sees a mix of old and new
+  * @param v_out_mv voltage in milli volt
+  * @param i_out_ma current in milli ampere
+  * @retval true requested output was within specs
+  */
+bool pwrctl_set_output(uint32_t v_out_mv, uint32_t i_out_ma);
+
+#ifdef CONFIG_THERMAL
+/**
+  * @brief Cap the current programmed while the output is enabled, the
+  *        setting is kept and restored when the cap is lifted
+  * @param max_ma the cap in milliampere, UINT32_MAX for none
+  * @retval none
+  */
+void pwrctl_set_iout_max(uint32_t max_ma);
+#endif // CONFIG_THERMAL
+
 /**
   * @brief Get current output setting
   * @retval current setting in milli amps
@@ -88,16 +159,118 @@ void pwrctl_enable_vout(bool enable);
   */
 bool pwrctl_vout_enabled(void);
 
+#ifdef CONFIG_WAVE
+/**
+  * @brief Hand the V_out DAC to the waveform generator, or take it back. While
+  *        held the V_out setting is kept but not written to the DAC.
+  *        Disabling power out stops the waveform and releases the DAC.
+  * @param hold true while the DAC is fed by DMA
+  * @retval none
+  */
+void pwrctl_hold_vout_dac(bool hold);
+#endif // CONFIG_WAVE
+
+#ifdef CONFIG_SOFT_START
+/**
+  * @brief Set the soft start time. When power out is enabled the V_out DAC is
+  *        ramped from 0 over this time so capacitive loads do not trip the
+  *        OCP, which stays armed during the ramp.
+  * @param ms ramp time, 0 to enable at once
+  * @retval none
+  */
+void pwrctl_set_soft_start(uint32_t ms);
+
+/**
+  * @brief Get the soft start time
+  * @retval ramp time in ms
+  */
+uint32_t pwrctl_get_soft_start(void);
+#endif // CONFIG_SOFT_START
+
+#ifdef CONFIG_VOUT_REGULATION
+/**
+  * @brief Enable or disable the V_out trim loop, the trim is reset. The loop
+  *        runs on a soft timer every CONFIG_VOUT_REG_INTERVAL_MS.
+  * @param enable true to regulate V_out on the measured value
+  * @retval none
+  */
+void pwrctl_set_vout_regulation(bool enable);
+#endif // CONFIG_VOUT_REGULATION
+
+/**
+  * @brief Get the calibration of the model we're built for
+  * @retval the default calibration
+  */
+const pwrctl_calibration_t *pwrctl_default_calibration(void);
+
+/**
+  * @brief Set the calibration used by the pwrctl_calc_* functions, the DAC
+  *        outputs and the current limit are updated accordingly
+  * @param calibration the new calibration, copied
+  * @retval none
+  */
+void pwrctl_set_calibration(const pwrctl_calibration_t *calibration);
+
+/**
+  * @brief Get the calibration in use
+  * @retval the calibration
+  */
+const pwrctl_calibration_t *pwrctl_get_calibration(void);
+
+/**
+  * @brief Set a piecewise linear calibration table, values outside the
+  *        table are extrapolated from the end segments
+  * @param table the table to set
+  * @param points the points, both x and y strictly increasing. ADC tables
+  *        must have x within 12 bits
+  * @param count number of points, 2..CONFIG_CAL_MAX_POINTS or 0 to revert
+  *        to the linear conversion
+  * @retval true if the table was valid and is now used
+  */
+bool pwrctl_set_cal_table(pwrctl_cal_table_t table, const pwrctl_cal_point_t *points, uint32_t count);
+
+/**
+  * @brief Get a calibration table
+  * @param table the table
+  * @param points set to the points of the table
+  * @retval number of points, 0 if the linear conversion is used
+  */
+uint32_t pwrctl_get_cal_table(pwrctl_cal_table_t table, const pwrctl_cal_point_t **points);
+
+/**
+  * @brief Set a protection limit
+  * @param prot the protection
+  * @param limit limit in millivolt or milliwatt, 0 disables the protection
+  * @retval true if the protection exists
+  * @note The OPP limit uses the linear V_out and I_out calibration also
+  *       when there are calibration tables
+  */
+bool pwrctl_set_protection(pwrctl_protection_t prot, uint32_t limit);
+
+/**
+  * @brief Get a protection limit
+  * @param prot the protection
+  * @retval limit in millivolt or milliwatt, 0 if disabled
+  */
+uint32_t pwrctl_get_protection(pwrctl_protection_t prot);
+
 /**
   * @brief Calculate V_in based on raw ADC measurement
-  * @param raw value from ADC
+  * @param raw value from ADC, with HW_ADC_FRAC_BITS fractional bits
   * @retval corresponding voltage in millivolt
   */
 uint32_t pwrctl_calc_vin(uint16_t raw);
 
+/**
+  * @brief Calculate the raw 12 bit ADC sample of a V_in
+  * @param v_in_mv the voltage in millivolt
+  * @retval the largest raw sample at or below v_in_mv
+  */
+uint16_t pwrctl_calc_vin_adc(uint32_t v_in_mv);
+
 /**
   * @brief Calculate V_out based on raw ADC measurement
-  * @param raw value from ADC
+  * @param raw value from ADC, with HW_ADC_FRAC_BITS fractional bits
   * @retval corresponding voltage in millivolt
   */
 uint32_t pwrctl_calc_vout(uint16_t raw);
@@ -111,7 +284,7 @@ uint16_t pwrctl_calc_vout_dac(uint32_t v_out_mv);
 
 /**
   * @brief Calculate I_out based on raw ADC measurement
-  * @param raw value from ADC
+  * @param raw value from ADC, with HW_ADC_FRAC_BITS fractional bits
   * @retval corresponding current in milliampere
   */
 uint32_t pwrctl_calc_iout(uint16_t raw);
@@ -123,6 +296,13 @@ uint32_t pwrctl_calc_iout(uint16_t raw);
   */
 uint16_t pwrctl_calc_ilimit_adc(uint16_t i_limit_ma);
 
+/**
+  * @brief Calculate expected raw ADC value for a V_out
+  * @param v_out_mv the voltage
+  * @retval expected raw ADC value
+  */
+uint16_t pwrctl_calc_vout_adc(uint32_t v_out_mv);
+
 /**
   * @brief Calculate DAC setting for constant current mode
   * @param i_out_ma requested constant current
@@ -22,8 +22,13 @@
  * THE SOFTWARE.
  */
 
+#include <string.h>
 #include "ringbuf.h"
 
+/** Index loads and stores, see the memory ordering contract in ringbuf.h */
+#define LOAD_ACQUIRE(p)      __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(p, v)  __atomic_store_n(p, v, __ATOMIC_RELEASE)
+
 /**
   * @brief Initialize the ring buffer
   * @param ring pointer to ring buffer
@@ -37,9 +42,6 @@ void ringbuf_init(ringbuf_t *ring, uint8_t *buf, uint32_t size)
 	ring->size = size/2;
 	ring->read = 0;
 	ring->write = 0;
-#ifdef DPS_EMULATOR
-	pthread_mutex_init(&ring->mutex, NULL);
-#endif // DPS_EMULATOR
 }
 
 /**
@@ -50,19 +52,7 @@ void ringbuf_init(ringbuf_t *ring, uint8_t *buf, uint32_t size)
   */
 bool ringbuf_put(ringbuf_t *ring, uint16_t word)
 {
-    bool success = false;
-#ifdef DPS_EMULATOR
-	pthread_mutex_lock(&ring->mutex);
-#endif // DPS_EMULATOR
-	if (((ring->write + 1) % ring->size) != ring->read) {
-		ring->buf[ring->write++] = word;
-		ring->write %= ring->size;
-		success = true;
-	}
-#ifdef DPS_EMULATOR
-	pthread_mutex_unlock(&ring->mutex);
-#endif // DPS_EMULATOR
-	return success;
+	return ringbuf_put_bulk(ring, &word, 1) == 1;
 }
 
 /**
@@ -73,17 +63,67 @@ bool ringbuf_put(ringbuf_t *ring, uint16_t word)
   */
 bool ringbuf_get(ringbuf_t *ring, uint16_t *word)
 {
-    bool success = false;
-#ifdef DPS_EMULATOR
-	pthread_mutex_lock(&ring->mutex);
-#endif // DPS_EMULATOR
-	if (ring->read != ring->write) {
-		*word = ring->buf[ring->read++];
-		ring->read %= ring->size;
-		success = true;
+	return ringbuf_get_bulk(ring, word, 1) == 1;
+}
+
+/**
+  * @brief Put as many words as there is room for into the ring buffer
+  * @param ring pointer to ring buffer
+  * @param words the data to put into the buffer
+  * @param count number of words
+  * @retval number of words put into the buffer
+  */
+uint32_t ringbuf_put_bulk(ringbuf_t *ring, const uint16_t *words, uint32_t count)
+{
+	uint32_t write = ring->write; /** Only we write this one */
+	uint32_t read = LOAD_ACQUIRE(&ring->read);
+	/** One slot is always left empty to tell a full ring from an empty one */
+	uint32_t space = (read + ring->size - write - 1) % ring->size;
+	if (count > space) {
+		count = space;
+	}
+	/** Copy in at most two runs, up to the end of the buffer and from the start */
+	uint32_t first = ring->size - write;
+	if (first > count) {
+		first = count;
 	}
-#ifdef DPS_EMULATOR
-	pthread_mutex_unlock(&ring->mutex);
-#endif // DPS_EMULATOR
-	return success;
+	memcpy(&ring->buf[write], words, first * sizeof(uint16_t));
+	memcpy(&ring->buf[0], &words[first], (count - first) * sizeof(uint16_t));
+	STORE_RELEASE(&ring->write, (write + count) % ring->size);
+	return count;
+}
+
+/**
+  * @brief Get up to count words from the ring buffer
+  * @param ring pointer to ring buffer
+  * @param words buffer for the data pulled from the ring buffer
+  * @param count max number of words to get
+  * @retval number of words read from the buffer
+  */
+uint32_t ringbuf_get_bulk(ringbuf_t *ring, uint16_t *words, uint32_t count)
+{
+	uint32_t read = ring->read; /** Only we write this one */
+	uint32_t write = LOAD_ACQUIRE(&ring->write);
+	uint32_t used = (write + ring->size - read) % ring->size;
+	if (count > used) {
+		count = used;
+	}
+	uint32_t first = ring->size - read;
+	if (first > count) {
+		first = count;
+	}
+	memcpy(words, &ring->buf[read], first * sizeof(uint16_t));
+	memcpy(&words[first], &ring->buf[0], (count - first) * sizeof(uint16_t));
+	STORE_RELEASE(&ring->read, (read + count) % ring->size);
+	return count;
+}
+
+/**
+  * @brief Check if the ring buffer is empty
+  * @param ring pointer to ring buffer
+  * @retval true if there is nothing to get
+  */
+bool ringbuf_is_empty(ringbuf_t *ring)
+{
+	return LOAD_ACQUIRE(&ring->read) == LOAD_ACQUIRE(&ring->write);
 }
@@ -28,18 +28,20 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-#ifdef DPS_EMULATOR
- #include <pthread.h>
-#endif // DPS_EMULATOR
-
+/** A single producer, single consumer ring buffer of 16 bit words.
+  *
+  * The producer only ever writes 'write' and the consumer only ever writes
+  * 'read'. Each side loads the other side's index with acquire semantics and
+  * publishes its own with release semantics, so data stored in the buffer is
+  * visible before the index update that hands it over. This makes the ring
+  * safe between an ISR and the main loop, or between two threads, without
+  * locks. More than one producer (or consumer) must serialize themselves.
+  */
 typedef struct {
 	uint16_t *buf;
 	uint32_t size;
-	uint32_t read;
-	uint32_t write;
-#ifdef DPS_EMULATOR
- pthread_mutex_t mutex;
-#endif // DPS_EMULATOR
+	volatile uint32_t read;
+	volatile uint32_t write;
 } ringbuf_t;
 
 /**
@@ -67,4 +69,29 @@ bool ringbuf_put(ringbuf_t *ring, uint16_t word);
   */
 bool ringbuf_get(ringbuf_t *ring, uint16_t *word);
 
+/**
+  * @brief Put as many words as there is room for into the ring buffer
+  * @param ring pointer to ring buffer
+  * @param words the data to put into the buffer
+  * @param count number of words
+  * @retval number of words put into the buffer
+  */
+uint32_t ringbuf_put_bulk(ringbuf_t *ring, const uint16_t *words, uint32_t count);
+
+/**
+  * @brief Get up to count words from the ring buffer
+  * @param ring pointer to ring buffer
+  * @param words buffer for the data pulled from the ring buffer
+  * @param count max number of words to get
+  * @retval number of words read from the buffer
+  */
+uint32_t ringbuf_get_bulk(ringbuf_t *ring, uint16_t *words, uint32_t count);
+
+/**
+  * @brief Check if the ring buffer is empty
+  * @param ring pointer to ring buffer
+  * @retval true if there is nothing to get
+  */
+bool ringbuf_is_empty(ringbuf_t *ring);
+
 #endif // __RINGBUF_H__
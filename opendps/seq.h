@@ -0,0 +1,10 @@
+const uint8_t seq_palette[] = {
+  0x00, 0x00, 0x10, 0x82, 0x21, 0x04, 0x31, 0x86, 0x42, 0x08, 0x52, 0xaa, 0x63, 0x2c, 0x73, 0xae,
+  0x84, 0x30, 0x94, 0xb2, 0xa5, 0x54, 0xb5, 0xd6, 0xc6, 0x58, 0xd6, 0xda, 0xe7, 0x5c, 0xff, 0xff,
+};
+const uint8_t seq[] = {
+  0xf0, 0x80, 0x6f, 0x80, 0x6f, 0x80, 0x1f, 0xd0, 0x1f, 0xd0, 0x1f, 0x80, 0x6f, 0x80, 0x6f, 0x80,
+  0x1f, 0xd0, 0x1f, 0xd0, 0x1f, 0xd0, 0x1f, 0x90, 0x5f, 0x90, 0x5f, 0xf0, 0x90,
+};
+#define seq_width  16
+#define seq_height  15
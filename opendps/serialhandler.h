@@ -25,6 +25,24 @@
 #ifndef __SERIALHANDER_H__
 #define __SERIALHANDER_H__
 
+#include <stdint.h>
+#include <stdbool.h>
+#include "pwrctl.h"
+
 void serial_handle_rx_char(char c);
+void serial_handle_rx_buffer(const uint8_t *buf, uint32_t length);
+
+#ifdef CONFIG_SERIAL_PROTOCOL
+void serial_send_protection_event(pwrctl_protection_t prot, uint32_t value);
+void serial_send_ocp_event(uint16_t i_cut_ma);
+void serial_send_temperature_event(bool alarm, int16_t temp1, int16_t temp2);
+#ifdef CONFIG_ALARMS
+void serial_send_alarm_event(uint8_t rule, uint32_t value);
+#endif // CONFIG_ALARMS
+#endif // CONFIG_SERIAL_PROTOCOL
+
+#ifdef CONFIG_MIRROR
+void serial_send_mirror_data(uint8_t seq, const uint8_t *ops, uint32_t length);
+#endif // CONFIG_MIRROR
 
 #endif // __SERIALHANDER_H__
\ No newline at end of file
@@ -0,0 +1,163 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "softtimer.h"
+#include "tick.h"
+
+#ifdef DPS_EMULATOR
+ #include <pthread.h>
+#else // DPS_EMULATOR
+ #include <cortex.h>
+#endif // DPS_EMULATOR
+
+/** Active timers, the one expiring first at the head. There are only a
+  * handful of timers so a sorted list beats anything fancier. */
+static softtimer_t *timers;
+
+/** Timers are started and stopped from ISRs and the main loop */
+#ifdef DPS_EMULATOR
+static pthread_mutex_t timer_mutex = PTHREAD_MUTEX_INITIALIZER;
+ #define TIMER_LOCK()    pthread_mutex_lock(&timer_mutex)
+ #define TIMER_UNLOCK()  pthread_mutex_unlock(&timer_mutex)
+#else // DPS_EMULATOR
+ #define TIMER_LOCK()    uint32_t _primask = cm_mask_interrupts(1)
+ #define TIMER_UNLOCK()  cm_mask_interrupts(_primask)
+#endif // DPS_EMULATOR
+
+/**
+  * @brief Unlink a timer, must be called with the lock held
+  * @param timer the timer
+  * @retval none
+  */
+static void unlink_timer(softtimer_t *timer)
+{
+    softtimer_t **p = &timers;
+    while (*p && *p != timer) {
+        p = &(*p)->next;
+    }
+    if (*p) {
+        *p = timer->next;
+    }
+    timer->active = false;
+}
+
+/**
+  * @brief Insert a timer in deadline order, after timers with the same
+  *        deadline. Must be called with the lock held.
+  * @param timer the timer
+  * @retval none
+  */
+static void insert_timer(softtimer_t *timer)
+{
+    softtimer_t **p = &timers;
+    while (*p && (*p)->deadline <= timer->deadline) {
+        p = &(*p)->next;
+    }
+    timer->next = *p;
+    *p = timer;
+    timer->active = true;
+}
+
+/**
+  * @brief Start (or restart) a timer, may be called from ISRs
+  * @param timer the timer
+  * @param delay_ms time until the first expiry
+  * @param period_ms time between the following expiries, 0 for a one-shot
+  * @param callback function called from the main loop on expiry
+  * @retval none
+  */
+void softtimer_start(softtimer_t *timer, uint32_t delay_ms, uint32_t period_ms, softtimer_callback_t callback)
+{
+    TIMER_LOCK();
+    if (timer->active) {
+        unlink_timer(timer);
+    }
+    timer->deadline = get_ticks() + delay_ms;
+    timer->period_ms = period_ms;
+    timer->callback = callback;
+    insert_timer(timer);
+    TIMER_UNLOCK();
+}
+
+/**
+  * @brief Stop a timer, may be called from ISRs
+  * @param timer the timer
+  * @retval none
+  */
+void softtimer_stop(softtimer_t *timer)
+{
+    TIMER_LOCK();
+    if (timer->active) {
+        unlink_timer(timer);
+    }
+    TIMER_UNLOCK();
+}
+
+/**
+  * @brief Check if a timer is active
+  * @param timer the timer
+  * @retval true if the timer will expire
+  */
+bool softtimer_is_active(const softtimer_t *timer)
+{
+    return timer->active;
+}
+
+/**
+  * @brief Run the callbacks of the expired timers, called from the main loop
+  * @retval the deadline of the next timer to expire, or SOFTTIMER_NEVER
+  */
+uint64_t softtimer_run(void)
+{
+    while (1) {
+        uint64_t now = get_ticks();
+        softtimer_t *expired = NULL;
+        uint64_t next = SOFTTIMER_NEVER;
+        {
+            TIMER_LOCK();
+            if (timers && timers->deadline <= now) {
+                expired = timers;
+                unlink_timer(expired);
+                if (expired->period_ms) {
+                    /** Keep the phase unless we fell more than a period behind */
+                    expired->deadline += expired->period_ms;
+                    if (expired->deadline <= now) {
+                        expired->deadline = now + expired->period_ms;
+                    }
+                    insert_timer(expired);
+                }
+            } else if (timers) {
+                next = timers->deadline;
+            }
+            TIMER_UNLOCK();
+        }
+        if (!expired) {
+            return next;
+        }
+        /** The callback may restart or stop any timer, including this one */
+        expired->callback(expired);
+    }
+}
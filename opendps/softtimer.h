@@ -0,0 +1,79 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __SOFTTIMER_H__
+#define __SOFTTIMER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Returned by softtimer_run() when no timer is active */
+#define SOFTTIMER_NEVER  (UINT64_MAX)
+
+typedef struct softtimer softtimer_t;
+
+/** Called from the main loop when the timer expires */
+typedef void (*softtimer_callback_t)(softtimer_t *timer);
+
+/** A timer, owned by the caller and kept in a list sorted on deadline while
+  * active. The members are private to the softtimer module. */
+struct softtimer {
+    softtimer_t *next;
+    uint64_t deadline;
+    uint32_t period_ms;  /** 0 for one-shot timers */
+    softtimer_callback_t callback;
+    bool active;
+};
+
+/**
+  * @brief Start (or restart) a timer, may be called from ISRs
+  * @param timer the timer
+  * @param delay_ms time until the first expiry
+  * @param period_ms time between the following expiries, 0 for a one-shot
+  * @param callback function called from the main loop on expiry
+  * @retval none
+  */
+void softtimer_start(softtimer_t *timer, uint32_t delay_ms, uint32_t period_ms, softtimer_callback_t callback);
+
+/**
+  * @brief Stop a timer, may be called from ISRs
+  * @param timer the timer
+  * @retval none
+  */
+void softtimer_stop(softtimer_t *timer);
+
+/**
+  * @brief Check if a timer is active
+  * @param timer the timer
+  * @retval true if the timer will expire
+  */
+bool softtimer_is_active(const softtimer_t *timer);
+
+/**
+  * @brief Run the callbacks of the expired timers, called from the main loop
+  * @retval the deadline of the next timer to expire, or SOFTTIMER_NEVER
+  */
+uint64_t softtimer_run(void);
+
+#endif // __SOFTTIMER_H__
@@ -27,8 +27,12 @@
 #include <dma.h>
 #include <nvic.h>
 #include <spi.h>
+#include <scb.h>
+#include <cortex.h>
 #include <errno.h>
 #include "spi_driver.h"
+#include "profile.h"
+#include "tick.h"
 
 /** Used to keep track of the SPI DMA status */
 typedef enum {
@@ -39,6 +43,44 @@ typedef enum {
 
 static volatile spi_status_t dma_status;
 
+/** Number of transfers that can be queued, including the one in flight */
+#define SPI_QUEUE_LEN  (8)
+
+/** A queued SPI transfer */
+typedef struct {
+    uint8_t *tx_buf;
+    uint32_t tx_len;
+    uint8_t *rx_buf;
+    uint32_t rx_len;
+    bool frame16; /** Use 16 bit frames, lengths count half words */
+    bool repeat; /** Send fill_value tx_len times */
+    uint16_t fill_value;
+    spi_callback_t callback;
+    void *arg;
+} spi_transfer_t;
+
+/** Transfer queue. The entry at queue_head is in flight while the queue is
+    not empty. queue_tail is only written by the producer and queue_head only
+    by the DMA ISRs */
+static spi_transfer_t queue[SPI_QUEUE_LEN];
+static volatile uint32_t queue_head;
+static volatile uint32_t queue_tail;
+
+/** True if SPI2 is currently configured for 16 bit frames */
+static bool frame_16bit;
+
+/** Longest a transfer may take before the queue is given up, the largest
+  * one (a full screen) takes about 10ms */
+#ifndef CONFIG_SPI_TIMEOUT_MS
+ #define CONFIG_SPI_TIMEOUT_MS  (100)
+#endif
+
+static void start_transfer(spi_transfer_t *t);
+static void transfer_done(void);
+static spi_transfer_t *enqueue(spi_callback_t callback, void *arg, uint32_t *primask);
+static void commit(uint32_t primask);
+static void abort_transfers(void);
+
 /** The DPS5005 has NSS grounded meaning we do not have to toggle it */
 #define SPI_NSS_GROUNDED
 
@@ -49,6 +91,8 @@ static volatile spi_status_t dma_status;
 void spi_init(void)
 {
     dma_status = spi_idle;
+    queue_head = queue_tail = 0;
+    frame_16bit = false;
 
     rcc_periph_clock_enable(RCC_SPI2);
     rcc_periph_clock_enable(RCC_DMA1);
@@ -66,7 +110,146 @@ void spi_init(void)
 }
 
 /**
-  * @brief TX, and optionally RX data on the SPI bus
+  * @brief Queue a TX, and optionally RX, transfer on the SPI bus
+  * @param tx_buf transmit buffer
+  * @param tx_len transmit buffer size
+  * @param rx_buf receive buffer (may be NULL)
+  * @param rx_len receive buffer size (may be 0)
+  * @param callback called from the DMA ISR when the transfer completed (may be NULL)
+  * @param arg argument passed to the callback
+  * @note The buffers must remain valid until the transfer completed. Blocks
+  *       while the queue is full unless called with interrupts masked or from
+  *       an ISR, in which case the function fails.
+  * @retval true if the transfer was queued
+  *         false if parameter error or the queue is full
+  */
+bool spi_dma_transceive_async(uint8_t *tx_buf, uint32_t tx_len, uint8_t *rx_buf, uint32_t rx_len, spi_callback_t callback, void *arg)
+{
+    if (!rx_len && !tx_len) {
+        return false;
+    }
+    uint32_t primask;
+    spi_transfer_t *t = enqueue(callback, arg, &primask);
+    if (!t) {
+        return false;
+    }
+    t->tx_buf = tx_buf;
+    t->tx_len = tx_len;
+    t->rx_buf = rx_buf;
+    t->rx_len = rx_len;
+    commit(primask);
+    return true;
+}
+
+/**
+  * @brief Queue a transfer sending the same 16 bit value repeatedly, MSB first
+  * @param value the value, eg. a bgr565 color
+  * @param count number of times to send value (max 65535)
+  * @param callback called from the DMA ISR when the transfer completed (may be NULL)
+  * @param arg argument passed to the callback
+  * @note The DMA reads value from the queue with a fixed memory address so
+  *       there is no source buffer to keep valid
+  * @retval true if the transfer was queued
+  *         false if parameter error or the queue is full
+  */
+bool spi_dma_fill_async(uint16_t value, uint32_t count, spi_callback_t callback, void *arg)
+{
+    if (!count || count > 0xffff) {
+        return false;
+    }
+    uint32_t primask;
+    spi_transfer_t *t = enqueue(callback, arg, &primask);
+    if (!t) {
+        return false;
+    }
+    t->tx_buf = (uint8_t*) &t->fill_value;
+    t->tx_len = count;
+    t->frame16 = true;
+    t->repeat = true;
+    t->fill_value = value;
+    commit(primask);
+    return true;
+}
+
+/**
+  * @brief Queue a transfer of 16 bit words, each sent MSB first
+  * @param tx_buf transmit buffer
+  * @param count number of words (max 65535)
+  * @param callback called from the DMA ISR when the transfer completed (may be NULL)
+  * @param arg argument passed to the callback
+  * @note The buffer must remain valid until the transfer completed
+  * @retval true if the transfer was queued
+  *         false if parameter error or the queue is full
+  */
+bool spi_dma_transmit16_async(const uint16_t *tx_buf, uint32_t count, spi_callback_t callback, void *arg)
+{
+    if (!count || count > 0xffff) {
+        return false;
+    }
+    uint32_t primask;
+    spi_transfer_t *t = enqueue(callback, arg, &primask);
+    if (!t) {
+        return false;
+    }
+    t->tx_buf = (uint8_t*) tx_buf;
+    t->tx_len = count;
+    t->frame16 = true;
+    commit(primask);
+    return true;
+}
+
+/**
+  * @brief Reserve the tail entry of the queue, masking interrupts
+  * @param callback completion callback of the transfer
+  * @param arg argument passed to the callback
+  * @param primask receives the interrupt mask to hand to commit()
+  * @note Blocks while the queue is full unless called with interrupts masked
+  *       or from an ISR. On success interrupts are masked until commit().
+  * @retval the entry or NULL if the queue is full
+  */
+static spi_transfer_t *enqueue(spi_callback_t callback, void *arg, uint32_t *primask)
+{
+    uint64_t deadline = get_ticks() + CONFIG_SPI_TIMEOUT_MS;
+    while (1) {
+        *primask = cm_mask_interrupts(1);
+        if ((queue_tail + 1) % SPI_QUEUE_LEN != queue_head) {
+            break;
+        }
+        cm_mask_interrupts(*primask);
+        if (*primask || (SCB_ICSR & SCB_ICSR_VECTACTIVE)) {
+            return 0;
+        }
+        if (get_ticks() >= deadline) {
+            abort_transfers();
+        }
+    }
+    spi_transfer_t *t = &queue[queue_tail];
+    t->rx_buf = 0;
+    t->rx_len = 0;
+    t->frame16 = false;
+    t->repeat = false;
+    t->callback = callback;
+    t->arg = arg;
+    return t;
+}
+
+/**
+  * @brief Publish the entry reserved by enqueue(), start it if the bus is idle
+  *        and restore the interrupt mask
+  * @param primask interrupt mask returned by enqueue()
+  * @retval None
+  */
+static void commit(uint32_t primask)
+{
+    queue_tail = (queue_tail + 1) % SPI_QUEUE_LEN;
+    if (dma_status == spi_idle) {
+        start_transfer(&queue[queue_head]);
+    }
+    cm_mask_interrupts(primask);
+}
+
+/**
+  * @brief TX, and optionally RX data on the SPI bus, waiting for completion
   * @param tx_buf transmit buffer
   * @param tx_len transmit buffer size
   * @param rx_buf receive buffer (may be NULL)
@@ -76,10 +259,67 @@ void spi_init(void)
   */
 bool spi_dma_transceive(uint8_t *tx_buf, uint32_t tx_len, uint8_t *rx_buf, uint32_t rx_len)
 {
-    if (!rx_len && !tx_len) {
+    PROFILE_START();
+    if (!spi_dma_transceive_async(tx_buf, tx_len, rx_buf, rx_len, 0, 0)) {
+        PROFILE_END(prof_spi_transceive);
         return false;
     }
+    bool success = spi_wait();
+    PROFILE_END(prof_spi_transceive);
+    return success;
+}
+
+/**
+  * @brief Check if there are transfers queued or in flight
+  * @retval true if the SPI driver is busy
+  */
+bool spi_busy(void)
+{
+    return queue_head != queue_tail;
+}
+
+/**
+  * @brief Wait for all queued transfers to complete
+  * @retval true if they completed, false if they stalled for
+  *         CONFIG_SPI_TIMEOUT_MS and were dropped
+  */
+bool spi_wait(void)
+{
+    uint64_t deadline = get_ticks() + CONFIG_SPI_TIMEOUT_MS;
+    while (spi_busy()) {
+        if (get_ticks() >= deadline) {
+            abort_transfers();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+  * @brief Give up a stalled transfer and everything queued after it,
+  *        leaving the bus idle. Their callbacks are not run.
+  * @retval None
+  */
+static void abort_transfers(void)
+{
+    uint32_t primask = cm_mask_interrupts(1);
+    dma_channel_reset(DMA1, DMA_CHANNEL4);
+    dma_channel_reset(DMA1, DMA_CHANNEL5);
+    spi_disable_tx_dma(SPI2);
+    spi_disable_rx_dma(SPI2);
+    dma_status = spi_idle;
+    queue_head = queue_tail;
+    cm_mask_interrupts(primask);
+}
 
+/**
+  * @brief Program the DMA channels and start a transfer
+  * @param t the transfer
+  * @note Called with interrupts masked or from the DMA ISRs
+  * @retval None
+  */
+static void start_transfer(spi_transfer_t *t)
+{
     dma_channel_reset(DMA1, DMA_CHANNEL4);
     dma_channel_reset(DMA1, DMA_CHANNEL5);
 
@@ -90,11 +330,23 @@ bool spi_dma_transceive(uint8_t *tx_buf, uint32_t tx_len, uint8_t *rx_buf, uint3
 
     dma_status = spi_idle;
 
-    if (rx_len) {
+    if (t->frame16 != frame_16bit) {
+        // The frame format may only be changed with the SPI disabled
+        spi_disable(SPI2);
+        if (t->frame16) {
+            spi_set_dff_16bit(SPI2);
+        } else {
+            spi_set_dff_8bit(SPI2);
+        }
+        spi_enable(SPI2);
+        frame_16bit = t->frame16;
+    }
+
+    if (t->rx_len) {
         dma_status |= spi_rx_running;
         dma_set_peripheral_address(DMA1, DMA_CHANNEL4, (uint32_t)&SPI2_DR);
-        dma_set_memory_address(DMA1, DMA_CHANNEL4, (uint32_t)rx_buf);
-        dma_set_number_of_data(DMA1, DMA_CHANNEL4, rx_len);
+        dma_set_memory_address(DMA1, DMA_CHANNEL4, (uint32_t)t->rx_buf);
+        dma_set_number_of_data(DMA1, DMA_CHANNEL4, t->rx_len);
         dma_set_read_from_peripheral(DMA1, DMA_CHANNEL4);
         dma_enable_memory_increment_mode(DMA1, DMA_CHANNEL4);
         dma_set_peripheral_size(DMA1, DMA_CHANNEL4, DMA_CCR_PSIZE_8BIT);
@@ -104,15 +356,24 @@ bool spi_dma_transceive(uint8_t *tx_buf, uint32_t tx_len, uint8_t *rx_buf, uint3
         dma_enable_channel(DMA1, DMA_CHANNEL4);
     }
 
-    if (tx_len) {
+    if (t->tx_len) {
         dma_status |= spi_tx_running;
         dma_set_peripheral_address(DMA1, DMA_CHANNEL5, (uint32_t)&SPI2_DR);
-        dma_set_memory_address(DMA1, DMA_CHANNEL5, (uint32_t)tx_buf);
-        dma_set_number_of_data(DMA1, DMA_CHANNEL5, tx_len);
+        dma_set_memory_address(DMA1, DMA_CHANNEL5, (uint32_t)t->tx_buf);
+        dma_set_number_of_data(DMA1, DMA_CHANNEL5, t->tx_len);
         dma_set_read_from_memory(DMA1, DMA_CHANNEL5);
-        dma_enable_memory_increment_mode(DMA1, DMA_CHANNEL5);
-        dma_set_peripheral_size(DMA1, DMA_CHANNEL5, DMA_CCR_PSIZE_8BIT);
-        dma_set_memory_size(DMA1, DMA_CHANNEL5, DMA_CCR_MSIZE_8BIT);
+        if (t->repeat) {
+            dma_disable_memory_increment_mode(DMA1, DMA_CHANNEL5);
+        } else {
+            dma_enable_memory_increment_mode(DMA1, DMA_CHANNEL5);
+        }
+        if (t->frame16) {
+            dma_set_peripheral_size(DMA1, DMA_CHANNEL5, DMA_CCR_PSIZE_16BIT);
+            dma_set_memory_size(DMA1, DMA_CHANNEL5, DMA_CCR_MSIZE_16BIT);
+        } else {
+            dma_set_peripheral_size(DMA1, DMA_CHANNEL5, DMA_CCR_PSIZE_8BIT);
+            dma_set_memory_size(DMA1, DMA_CHANNEL5, DMA_CCR_MSIZE_8BIT);
+        }
         dma_set_priority(DMA1, DMA_CHANNEL5, DMA_CCR_PL_HIGH);
         dma_enable_transfer_complete_interrupt(DMA1, DMA_CHANNEL5);
         dma_enable_channel(DMA1, DMA_CHANNEL5);
@@ -123,16 +384,25 @@ bool spi_dma_transceive(uint8_t *tx_buf, uint32_t tx_len, uint8_t *rx_buf, uint3
 #endif // SPI_NSS_GROUNDED
 
     // Enable DMA, effectivly starting the transfer
-    if (rx_len) {
+    if (t->rx_len) {
         spi_enable_rx_dma(SPI2);
     }
-    if (tx_len) {
+    if (t->tx_len) {
         spi_enable_tx_dma(SPI2);
     }
+}
 
-    // Wait until DMA completed in accordance with RM0008 (r16) p.713
-    /** @todo Add timeout for SPI transmission */
-    while (dma_status != spi_idle) ;
+/**
+  * @brief Finish the transfer in flight, run the completion callback and
+  *        start the next queued transfer
+  * @note Called from the DMA ISRs when both channels are done. The callback
+  *       runs before the next transfer starts, allowing it to eg. switch a
+  *       data/command line.
+  * @retval None
+  */
+static void transfer_done(void)
+{
+    // Wait until the last byte left the shift register in accordance with RM0008 (r16) p.713
     while (!(SPI_SR(SPI2) & SPI_SR_TXE)) ;
     while (SPI_SR(SPI2) & SPI_SR_BSY) ;
 
@@ -140,7 +410,16 @@ bool spi_dma_transceive(uint8_t *tx_buf, uint32_t tx_len, uint8_t *rx_buf, uint3
     gpio_set(GPIOB, GPIO12);
 #endif // SPI_NSS_GROUNDED
 
-    return true;
+    spi_callback_t callback = queue[queue_head].callback;
+    void *arg = queue[queue_head].arg;
+    queue_head = (queue_head + 1) % SPI_QUEUE_LEN;
+    if (callback) {
+        callback(arg);
+    }
+    // The callback may have queued and thereby started a transfer
+    if (queue_head != queue_tail && dma_status == spi_idle) {
+        start_transfer(&queue[queue_head]);
+    }
 }
 
 /**
@@ -156,6 +435,9 @@ void dma1_channel4_isr(void)
     spi_disable_rx_dma(SPI2);
     dma_disable_channel(DMA1, DMA_CHANNEL4);
     dma_status &= ~spi_rx_running;
+    if (dma_status == spi_idle) {
+        transfer_done();
+    }
 }
 
 /**
@@ -171,4 +453,7 @@ void dma1_channel5_isr(void)
     spi_disable_tx_dma(SPI2);
     dma_disable_channel(DMA1, DMA_CHANNEL5);
     dma_status &= ~spi_tx_running;
+    if (dma_status == spi_idle) {
+        transfer_done();
+    }
 }
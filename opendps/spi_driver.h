@@ -25,6 +25,10 @@
 #ifndef __SPI_DRIVER_H__
 #define __SPI_DRIVER_H__
 
+/** Transfer completion callback, called from the DMA ISR before the next
+    queued transfer is started */
+typedef void (*spi_callback_t)(void *arg);
+
 /**
   * @brief Initialize the SPI driver
   * @retval None
@@ -32,7 +36,7 @@
 void spi_init(void);
 
 /**
-  * @brief TX, and optionally RX data on the SPI bus
+  * @brief TX, and optionally RX data on the SPI bus, waiting for completion
   * @param tx_buf transmit buffer
   * @param tx_len transmit buffer size
   * @param rx_buf receive buffer (may be NULL)
@@ -42,4 +46,56 @@ void spi_init(void);
   */
 bool spi_dma_transceive(uint8_t *tx_buf, uint32_t tx_len, uint8_t *rx_buf, uint32_t rx_len);
 
+/**
+  * @brief Queue a TX, and optionally RX, transfer on the SPI bus
+  * @param tx_buf transmit buffer
+  * @param tx_len transmit buffer size
+  * @param rx_buf receive buffer (may be NULL)
+  * @param rx_len receive buffer size (may be 0)
+  * @param callback called from the DMA ISR when the transfer completed (may be NULL)
+  * @param arg argument passed to the callback
+  * @note The buffers must remain valid until the transfer completed. Blocks
+  *       while the queue is full unless called with interrupts masked or from
+  *       an ISR, in which case the function fails.
+  * @retval true if the transfer was queued
+  *         false if parameter error or the queue is full
+  */
+bool spi_dma_transceive_async(uint8_t *tx_buf, uint32_t tx_len, uint8_t *rx_buf, uint32_t rx_len, spi_callback_t callback, void *arg);
+
+/**
+  * @brief Queue a transfer sending the same 16 bit value repeatedly, MSB first
+  * @param value the value, eg. a bgr565 color
+  * @param count number of times to send value (max 65535)
+  * @param callback called from the DMA ISR when the transfer completed (may be NULL)
+  * @param arg argument passed to the callback
+  * @retval true if the transfer was queued
+  *         false if parameter error or the queue is full
+  */
+bool spi_dma_fill_async(uint16_t value, uint32_t count, spi_callback_t callback, void *arg);
+
+/**
+  * @brief Queue a transfer of 16 bit words, each sent MSB first
+  * @param tx_buf transmit buffer
+  * @param count number of words (max 65535)
+  * @param callback called from the DMA ISR when the transfer completed (may be NULL)
+  * @param arg argument passed to the callback
+  * @note The buffer must remain valid until the transfer completed
+  * @retval true if the transfer was queued
+  *         false if parameter error or the queue is full
+  */
+bool spi_dma_transmit16_async(const uint16_t *tx_buf, uint32_t count, spi_callback_t callback, void *arg);
+
+/**
+  * @brief Check if there are transfers queued or in flight
+  * @retval true if the SPI driver is busy
+  */
+bool spi_busy(void);
+
+/**
+  * @brief Wait for all queued transfers to complete
+  * @retval true if they completed, false if they stalled for
+  *         CONFIG_SPI_TIMEOUT_MS and were dropped
+  */
+bool spi_wait(void);
+
 #endif // __SPI_DRIVER_H__
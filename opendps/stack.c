@@ -0,0 +1,62 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stack.h"
+
+/** Symbols of the linker script, the end of .bss and the top of RAM */
+extern uint32_t _ebss, _stack;
+
+#define STACK_PAINT  (0xc5c5c5c5)
+
+/**
+  * @brief Paint the unused stack, must be the first thing main() does
+  * @retval none
+  */
+void stack_paint(void)
+{
+    uint32_t *sp;
+    __asm__ volatile ("mov %0, sp" : "=r" (sp));
+    for (uint32_t *p = &_ebss; p < sp; p++) {
+        *p = STACK_PAINT;
+    }
+}
+
+/**
+  * @brief Get the stack usage since reset
+  * @param size set to the size of the stack in bytes, from the end of .bss
+  *        to the top of RAM
+  * @param used set to the most bytes used, ISRs included
+  * @retval none
+  */
+void stack_get(uint32_t *size, uint32_t *used)
+{
+    uint32_t *p = &_ebss;
+    while (p < &_stack && *p == STACK_PAINT) {
+        p++;
+    }
+    *size = (uint32_t) &_stack - (uint32_t) &_ebss;
+    *used = (uint32_t) &_stack - (uint32_t) p;
+}
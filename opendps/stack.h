@@ -0,0 +1,50 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __STACK_H__
+#define __STACK_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** The stack grows down from the top of RAM towards .bss. At reset the free
+  * part is painted so the deepest use since then can be found by looking
+  * for the first overwritten word */
+
+/**
+  * @brief Paint the unused stack, must be the first thing main() does
+  * @retval none
+  */
+void stack_paint(void);
+
+/**
+  * @brief Get the stack usage since reset
+  * @param size set to the size of the stack in bytes, from the end of .bss
+  *        to the top of RAM
+  * @param used set to the most bytes used, ISRs included
+  * @retval none
+  */
+void stack_get(uint32_t *size, uint32_t *used);
+
+#endif // __STACK_H__
@@ -0,0 +1,311 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "stats.h"
+#include "hw.h"
+#include "pwrctl.h"
+
+/** The sums of one channel over a block or the window, raw samples */
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+    uint64_t sum;
+    uint64_t sum_sq;
+} sums_t;
+
+/** A monotonic deque of block numbers, the front being the block holding
+  * the minimum (or maximum) of the window */
+typedef struct {
+    uint32_t block[CONFIG_STATS_BLOCKS];
+    uint32_t head; /** Front, index into block[] */
+    uint32_t count;
+} deque_t;
+
+/** The window as published by the ISR, double buffered */
+typedef struct {
+    uint32_t scans;
+    sums_t sums[stats_max];
+} window_t;
+
+static volatile bool active; /** Set by stats_init() */
+static uint32_t block_scans = STATS_DEFAULT_BLOCK_SCANS;
+static uint32_t window_blocks = STATS_DEFAULT_BLOCKS;
+
+/** Owned by the ISR while active */
+static uint32_t scan_count;                         /** Scans in the current block */
+static sums_t block_sums[stats_max];                /** The current block */
+static sums_t blocks[CONFIG_STATS_BLOCKS][stats_max]; /** Completed blocks, by block number modulo CONFIG_STATS_BLOCKS */
+static uint32_t blocks_done;                        /** Number of blocks completed */
+static uint64_t window_sum[stats_max];
+static uint64_t window_sum_sq[stats_max];
+static deque_t min_deque[stats_max];
+static deque_t max_deque[stats_max];
+
+static window_t windows[2];
+static volatile uint32_t window_idx;
+static volatile uint32_t window_seq;
+
+/**
+  * @brief Start over the block and the window
+  * @retval None
+  */
+static void reset(void)
+{
+    scan_count = 0;
+    blocks_done = 0;
+    for (uint32_t c = 0; c < stats_max; c++) {
+        block_sums[c].min = 0xffff;
+        block_sums[c].max = 0;
+        block_sums[c].sum = 0;
+        block_sums[c].sum_sq = 0;
+        window_sum[c] = 0;
+        window_sum_sq[c] = 0;
+        min_deque[c].count = max_deque[c].count = 0;
+    }
+    window_seq = 0;
+}
+
+/**
+  * @brief Start the statistics with the default window
+  * @retval None
+  */
+void stats_init(void)
+{
+    (void) stats_configure(STATS_DEFAULT_BLOCK_SCANS, STATS_DEFAULT_BLOCKS);
+}
+
+/**
+  * @brief Set the window and start over
+  * @param block_scans number of scans (at ~21kHz) in each block
+  * @param blocks number of blocks in the window
+  * @retval false if the arguments are out of range
+  */
+bool stats_configure(uint32_t _block_scans, uint32_t _blocks)
+{
+    if (_block_scans == 0 || _block_scans > 0xffff || _blocks == 0 || _blocks > CONFIG_STATS_BLOCKS) {
+        return false;
+    }
+    active = false; /** The ISR keeps out until we are done */
+    block_scans = _block_scans;
+    window_blocks = _blocks;
+    reset();
+    active = true;
+    return true;
+}
+
+/**
+  * @brief Get the window
+  * @param block_scans number of scans in each block
+  * @param blocks number of blocks in the window
+  * @retval None
+  */
+void stats_get_config(uint32_t *_block_scans, uint32_t *_blocks)
+{
+    *_block_scans = block_scans;
+    *_blocks = window_blocks;
+}
+
+/**
+  * @brief Drop the block leaving the window from the front of a monotonic
+  *        deque and add a block to its back
+  * @param d the deque
+  * @param c the channel
+  * @param block the number of the block
+  * @param is_max true for the deque of maxima
+  * @retval None
+  */
+static inline void deque_push(deque_t *d, uint32_t c, uint32_t block, bool is_max)
+{
+    uint16_t value = is_max ? blocks[block % CONFIG_STATS_BLOCKS][c].max : blocks[block % CONFIG_STATS_BLOCKS][c].min;
+    if (d->count && block - d->block[d->head] >= window_blocks) {
+        d->head = (d->head + 1) % CONFIG_STATS_BLOCKS;
+        d->count--;
+    }
+    /** Blocks at the back that can no longer be the extreme of the window */
+    while (d->count) {
+        const sums_t *back = &blocks[d->block[(d->head + d->count - 1) % CONFIG_STATS_BLOCKS] % CONFIG_STATS_BLOCKS][c];
+        if (is_max ? back->max > value : back->min < value) {
+            break;
+        }
+        d->count--;
+    }
+    d->block[(d->head + d->count) % CONFIG_STATS_BLOCKS] = block;
+    d->count++;
+}
+
+/**
+  * @brief Add the completed block to the window and publish the window
+  * @retval None
+  */
+static void block_done(void)
+{
+    uint32_t block = blocks_done++;
+    sums_t *slot = blocks[block % CONFIG_STATS_BLOCKS];
+    window_t *w = &windows[window_idx ^ 1];
+    for (uint32_t c = 0; c < stats_max; c++) {
+        if (block >= window_blocks) {
+            /** The oldest block leaves the window */
+            const sums_t *old = &blocks[(block - window_blocks) % CONFIG_STATS_BLOCKS][c];
+            window_sum[c] -= old->sum;
+            window_sum_sq[c] -= old->sum_sq;
+        }
+        slot[c] = block_sums[c];
+        window_sum[c] += block_sums[c].sum;
+        window_sum_sq[c] += block_sums[c].sum_sq;
+        deque_push(&min_deque[c], c, block, false);
+        deque_push(&max_deque[c], c, block, true);
+        w->sums[c].sum = window_sum[c];
+        w->sums[c].sum_sq = window_sum_sq[c];
+        w->sums[c].min = blocks[min_deque[c].block[min_deque[c].head] % CONFIG_STATS_BLOCKS][c].min;
+        w->sums[c].max = blocks[max_deque[c].block[max_deque[c].head] % CONFIG_STATS_BLOCKS][c].max;
+        block_sums[c].min = 0xffff;
+        block_sums[c].max = 0;
+        block_sums[c].sum = 0;
+        block_sums[c].sum_sq = 0;
+    }
+    w->scans = (blocks_done < window_blocks ? blocks_done : window_blocks) * block_scans;
+    window_idx ^= 1;
+    window_seq++;
+}
+
+/**
+  * @brief Add one scan, called from the ADC ISRs
+  * @param i_out the offset compensated I_out sample
+  * @param v_in the V_in sample
+  * @param v_out the V_out sample
+  * @note The samples have no fractional bits
+  * @retval None
+  */
+void stats_scan(uint32_t i_out, uint32_t v_in, uint32_t v_out)
+{
+    if (!active) {
+        return;
+    }
+    uint32_t sample[stats_max];
+    sample[stats_v_out] = v_out;
+    sample[stats_i_out] = i_out;
+    sample[stats_v_in] = v_in;
+    for (uint32_t c = 0; c < stats_max; c++) {
+        sums_t *s = &block_sums[c];
+        uint32_t x = sample[c];
+        if (x < s->min) {
+            s->min = x;
+        }
+        if (x > s->max) {
+            s->max = x;
+        }
+        s->sum += x;
+        s->sum_sq += x * x;
+    }
+    if (++scan_count == block_scans) {
+        scan_count = 0;
+        block_done();
+    }
+}
+
+/**
+  * @brief Integer square root
+  * @param x the value
+  * @retval the square root of x, rounded down
+  */
+static uint32_t isqrt64(uint64_t x)
+{
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+/**
+  * @brief Convert a raw sample of a channel
+  * @param c the channel
+  * @param raw the sample, no fractional bits
+  * @retval the sample in mV or mA
+  */
+static uint32_t convert(uint32_t c, uint32_t raw)
+{
+    switch (c) {
+        case stats_v_out:
+            return pwrctl_calc_vout(raw << HW_ADC_FRAC_BITS);
+        case stats_i_out:
+            return pwrctl_calc_iout(raw << HW_ADC_FRAC_BITS);
+        default:
+            return pwrctl_calc_vin(raw << HW_ADC_FRAC_BITS);
+    }
+}
+
+/**
+  * @brief Get the statistics of the window, before it has been filled those
+  *        of the blocks completed so far
+  * @param stats the statistics, indexed by stats_channel_t
+  * @retval number of scans the statistics were computed from, 0 if no block
+  *         has been completed
+  */
+uint32_t stats_get(stats_t stats[stats_max])
+{
+    window_t w;
+    uint32_t seq;
+    do {
+        seq = window_seq;
+        memcpy((void*) &w, (void*) &windows[window_idx], sizeof(w));
+    } while (seq != window_seq); /** The ISR completed a block while we were copying */
+    memset(stats, 0, stats_max * sizeof(stats_t));
+    if (!seq || !w.scans) {
+        return 0;
+    }
+    for (uint32_t c = 0; c < stats_max; c++) {
+        const sums_t *s = &w.sums[c];
+        /** Mean and variance of the raw samples with 8 fractional bits,
+          * 2^21 scans of 12 bit samples fit the 64 bit products */
+        uint32_t mean_q8 = ((uint64_t) s->sum << 8) / w.scans;
+        uint64_t mean_sq_q16 = (s->sum_sq << 16) / w.scans;
+        uint64_t square_q16 = (uint64_t) mean_q8 * mean_q8;
+        uint32_t sd_q8 = mean_sq_q16 > square_q16 ? isqrt64(mean_sq_q16 - square_q16) : 0;
+        /** The conversions are linear (or piecewise so), the gain around the
+          * mean scales the deviation */
+        uint32_t mean_raw = mean_q8 >> 8;
+        uint32_t lo = mean_raw > 32 ? mean_raw - 32 : 0;
+        uint32_t gain_mv = convert(c, lo + 64) - convert(c, lo); /** Per 64 LSB */
+        stats[c].min = convert(c, s->min);
+        stats[c].max = convert(c, s->max);
+        stats[c].mean = convert(c, mean_raw) + (uint64_t) (mean_q8 & 0xff) * gain_mv / (64 * 256);
+        stats[c].ac_rms = (uint64_t) sd_q8 * gain_mv * 1000 / (64 * 256);
+        stats[c].rms = isqrt64((uint64_t) stats[c].mean * stats[c].mean * 1000000 + (uint64_t) stats[c].ac_rms * stats[c].ac_rms) / 1000;
+    }
+    return w.scans;
+}
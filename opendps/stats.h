@@ -0,0 +1,103 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __STATS_H__
+#define __STATS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Rolling statistics of the ADC scans. Every scan is added to the block
+  * being summed, at a cost per scan that does not depend on the window. The
+  * window is the latest <blocks> completed blocks of <block scans> scans
+  * each, kept by sliding sums and a monotonic deque of the block minima and
+  * maxima, updated once per block. */
+
+/** Longest window in blocks */
+#ifndef CONFIG_STATS_BLOCKS
+ #define CONFIG_STATS_BLOCKS  (32)
+#endif
+
+/** The window at boot, 20 blocks of 1024 scans or ~1s */
+#define STATS_DEFAULT_BLOCK_SCANS  (1024)
+#define STATS_DEFAULT_BLOCKS       (20)
+
+typedef enum {
+    stats_v_out = 0,
+    stats_i_out,
+    stats_v_in,
+    stats_max
+} stats_channel_t;
+
+/** The statistics of one channel over the window, in mV or mA */
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+    uint16_t mean;
+    uint16_t rms;
+    uint32_t ac_rms; /** The RMS around the mean (standard deviation) in uV or uA */
+} stats_t;
+
+/**
+  * @brief Start the statistics with the default window
+  * @retval None
+  */
+void stats_init(void);
+
+/**
+  * @brief Set the window and start over
+  * @param block_scans number of scans (at ~21kHz) in each block
+  * @param blocks number of blocks in the window
+  * @retval false if the arguments are out of range
+  */
+bool stats_configure(uint32_t block_scans, uint32_t blocks);
+
+/**
+  * @brief Get the window
+  * @param block_scans number of scans in each block
+  * @param blocks number of blocks in the window
+  * @retval None
+  */
+void stats_get_config(uint32_t *block_scans, uint32_t *blocks);
+
+/**
+  * @brief Get the statistics of the window, before it has been filled those
+  *        of the blocks completed so far
+  * @param stats the statistics, indexed by stats_channel_t
+  * @retval number of scans the statistics were computed from, 0 if no block
+  *         has been completed
+  */
+uint32_t stats_get(stats_t stats[stats_max]);
+
+/**
+  * @brief Add one scan, called from the ADC ISRs
+  * @param i_out the offset compensated I_out sample
+  * @param v_in the V_in sample
+  * @param v_out the V_out sample
+  * @note The samples have no fractional bits
+  * @retval None
+  */
+void stats_scan(uint32_t i_out, uint32_t v_in, uint32_t v_out);
+
+#endif // __STATS_H__
@@ -0,0 +1,292 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#if defined(__i386__) || defined(__x86_64__)
+ #include <x86intrin.h>
+#endif
+#include "uframe.h"
+#include "crc16.h"
+#include "ringbuf.h"
+#include "past.h"
+#include "../../emu/flash.h"
+
+/** Timings of the hot paths of the serial protocol and the past, run on the
+  * host against the emulator flash backend. Host cycles are no measure of
+  * STM32 cycles, compare the figures between builds on the same machine.
+  */
+
+#define PAYLOAD_SIZE  (128)
+
+/** Number of times each benchmark runs its operation */
+#define ITERATIONS  (200000)
+
+/** Keeps the compiler from optimizing the benchmarked calls away */
+static volatile uint32_t g_sink;
+
+typedef struct {
+    uint64_t ns;
+    uint64_t cycles;
+} bench_time_t;
+
+static void bench_start(bench_time_t *t)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    t->ns = (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#if defined(__i386__) || defined(__x86_64__)
+    t->cycles = __rdtsc();
+#else
+    t->cycles = 0;
+#endif
+}
+
+static void bench_stop(bench_time_t *t)
+{
+    bench_time_t end;
+    bench_start(&end);
+    t->ns = end.ns - t->ns;
+    t->cycles = end.cycles - t->cycles;
+}
+
+/** Print the time per operation, and per byte if bytes is non zero */
+static void bench_report(const char *name, bench_time_t *t, uint32_t ops, uint32_t bytes_per_op)
+{
+    double ns_per_op = (double) t->ns / ops;
+    printf(" %-28s %10.1f ns/op", name, ns_per_op);
+    if (bytes_per_op) {
+        double mb_per_s = (double) ops * bytes_per_op * 1000.0 / (t->ns ? t->ns : 1);
+        printf(" %8.1f MB/s %7.2f cycles/byte", mb_per_s, (double) t->cycles / ((double) ops * bytes_per_op));
+    } else {
+        printf(" %10.1f cycles/op", (double) t->cycles / ops);
+    }
+    printf("\n");
+}
+
+/** A payload with every fourth byte needing escaping, like binary data */
+static void fill_payload(uint8_t *payload, uint32_t length)
+{
+    for (uint32_t i = 0; i < length; i++) {
+        payload[i] = i % 4 == 0 ? _SOF + (i / 4) % 3 : (uint8_t) (i * 37);
+    }
+}
+
+static void bench_crc16(void)
+{
+    uint8_t payload[PAYLOAD_SIZE];
+    bench_time_t t;
+    fill_payload(payload, sizeof(payload));
+    bench_start(&t);
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        payload[0] = i;
+        g_sink += crc16(payload, sizeof(payload));
+    }
+    bench_stop(&t);
+    bench_report("crc16", &t, ITERATIONS, sizeof(payload));
+}
+
+/** Pack the payload as protocol_handler.c does */
+static uint32_t pack_payload(uint8_t *frame, uint8_t *payload, uint32_t length)
+{
+    DECLARE_FRAME(PAYLOAD_SIZE);
+    for (uint32_t i = 0; i + 8 <= length; i += 8) {
+        PACK8(payload[i]);
+        PACK8(payload[i+1]);
+        PACK16((payload[i+2] << 8) | payload[i+3]);
+        PACK32(((uint32_t) payload[i+4] << 24) | (payload[i+5] << 16) | (payload[i+6] << 8) | payload[i+7]);
+    }
+    FINISH_FRAME();
+    memcpy(frame, _buffer, _length);
+    return _length;
+}
+
+static void bench_pack(void)
+{
+    uint8_t payload[PAYLOAD_SIZE];
+    uint8_t frame[FRAME_OVERHEAD(PAYLOAD_SIZE)];
+    bench_time_t t;
+    fill_payload(payload, sizeof(payload));
+    bench_start(&t);
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        payload[1] = i;
+        g_sink += pack_payload(frame, payload, sizeof(payload));
+    }
+    bench_stop(&t);
+    bench_report("PACK8/16/32 + FINISH_FRAME", &t, ITERATIONS, sizeof(payload));
+}
+
+static void bench_extract(void)
+{
+    uint8_t payload[PAYLOAD_SIZE];
+    uint8_t frame[FRAME_OVERHEAD(PAYLOAD_SIZE)];
+    uint8_t work[FRAME_OVERHEAD(PAYLOAD_SIZE)];
+    bench_time_t t;
+    fill_payload(payload, sizeof(payload));
+    uint32_t length = pack_payload(frame, payload, sizeof(payload));
+    if (uframe_extract_payload(memcpy(work, frame, length), length) != PAYLOAD_SIZE) {
+        printf(" uframe_extract_payload failed\n");
+        return;
+    }
+
+    /** The frame is unescaped in place, so time the copy on its own too */
+    bench_start(&t);
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        memcpy(work, frame, length);
+        g_sink += work[i % length];
+    }
+    bench_stop(&t);
+    uint64_t copy_ns = t.ns, copy_cycles = t.cycles;
+
+    bench_start(&t);
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        memcpy(work, frame, length);
+        g_sink += uframe_extract_payload(work, length);
+    }
+    bench_stop(&t);
+    t.ns = t.ns > copy_ns ? t.ns - copy_ns : 0;
+    t.cycles = t.cycles > copy_cycles ? t.cycles - copy_cycles : 0;
+    bench_report("uframe_extract_payload", &t, ITERATIONS, length);
+}
+
+static void bench_ringbuf(void)
+{
+    uint8_t buf[2 * 64];
+    uint16_t words[32];
+    ringbuf_t ring;
+    bench_time_t t;
+    ringbuf_init(&ring, buf, sizeof(buf));
+
+    bench_start(&t);
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        uint16_t word;
+        for (uint32_t j = 0; j < 32; j++) {
+            (void) ringbuf_put(&ring, j);
+        }
+        for (uint32_t j = 0; j < 32; j++) {
+            (void) ringbuf_get(&ring, &word);
+            g_sink += word;
+        }
+    }
+    bench_stop(&t);
+    bench_report("ringbuf_put/get", &t, ITERATIONS * 32, 0);
+
+    for (uint32_t j = 0; j < 32; j++) {
+        words[j] = j;
+    }
+    bench_start(&t);
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        g_sink += ringbuf_put_bulk(&ring, words, 32);
+        g_sink += ringbuf_get_bulk(&ring, words, 32);
+    }
+    bench_stop(&t);
+    bench_report("ringbuf_put/get_bulk", &t, ITERATIONS * 32, 0);
+}
+
+static void bench_past(void)
+{
+    past_t past;
+    bench_time_t t, gc;
+    uint32_t value = 0, writes = 0, gcs = 0;
+    flash_emul_init(&past, NULL, false);
+    if (!past_init(&past)) {
+        printf(" past_init failed\n");
+        return;
+    }
+
+    /** The settings written when the user turns the dial */
+    memset(&gc, 0, sizeof(gc));
+    bench_start(&t);
+    for (uint32_t i = 0; i < ITERATIONS / 10; i++) {
+        bench_time_t w;
+#ifdef CONFIG_PAST_INCREMENTAL_GC
+        /** The background steps, the writes should then rarely have to GC */
+        (void) past_gc_step(&past);
+#endif // CONFIG_PAST_INCREMENTAL_GC
+        uint32_t block = past._cur_block;
+        value++;
+        bench_start(&w);
+        if (!past_write_unit(&past, 1 + i % 4, &value, sizeof(value))) {
+            printf(" past_write_unit failed after %u writes\n", writes);
+            return;
+        }
+        bench_stop(&w);
+        /** Each write is a stall of its own */
+        (void) flash_emul_take_stall_us();
+        writes++;
+        if (past._cur_block != block) {
+            gcs++;
+            gc.ns += w.ns;
+            gc.cycles += w.cycles;
+        }
+    }
+    bench_stop(&t);
+    bench_report("past_write_unit", &t, writes, 0);
+    if (gcs) {
+        bench_report("past_write_unit with GC", &gc, gcs, 0);
+    }
+    flash_emul_stats_t stats;
+    flash_emul_get_stats(&stats);
+    printf(" %u garbage collections in %u writes\n", gcs, writes);
+    printf(" on the device: %llu us flash time per write, the longest write %llu ms, %u erases of the most worn page\n",
+           (unsigned long long) stats.busy_us / writes, (unsigned long long) stats.longest_stall_us / 1000,
+           stats.max_page_erases);
+}
+
+/** The brownout save: the energy counters and a full write-back cache in
+  * one transaction in the reserve, as brownout_save() does it */
+static void bench_brownout_save(void)
+{
+    past_t past;
+    bench_time_t t;
+    uint8_t counters[24]; /** energy_counters_t */
+    uint32_t words = 0, saves = 0;
+    flash_emul_init(&past, NULL, false);
+    if (!past_init(&past)) {
+        printf(" past_init failed\n");
+        return;
+    }
+    memset(counters, 0x5a, sizeof(counters));
+    memset(&t, 0, sizeof(t));
+    for (uint32_t i = 0; i < ITERATIONS / 100; i++) {
+        bench_time_t s;
+        uint32_t value = i;
+        for (uint32_t slot = 0; slot < PAST_CACHE_SLOTS; slot++) {
+            (void) past_write_unit_deferred(&past, 20 + slot, &value, sizeof(value));
+        }
+        /** Room an ordinary write would have made by garbage collecting */
+        if (!past_write_unit(&past, 19, &value, sizeof(value))) {
+            printf(" past_write_unit failed\n");
+            return;
+        }
+        uint32_t programs = flash_emul_word_programs();
+        bench_start(&s);
+        uint32_t length = PAST_UNIT_SIZE(sizeof(counters)) + past_cache_size(&past);
+        bool ok = past_begin_reserved(&past, length) && past_write_unit(&past, 18, counters, sizeof(counters)) &&
+                  past_flush(&past) && past_commit(&past);
+        bench_stop(&s);
+        if (!ok) {
+            printf(" emergency save failed after %u saves\n", saves);
+            return;
+        }
+        t.ns += s.ns;
+        t.cycles += s.cycles;
+        words += flash_emul_word_programs() - programs;
+        saves++;
+    }
+    bench_report("brownout save", &t, saves, 0);
+    printf(" %u words programmed per save, %u us on the device (%u us max)\n", words / saves,
+           words / saves * FLASH_EMUL_WORD_PROGRAM_US, words / saves * FLASH_EMUL_WORD_PROGRAM_MAX_US);
+}
+
+int main(int argc, char const *argv[])
+{
+    printf("Running benchmarks (%u iterations)\n", ITERATIONS);
+    bench_crc16();
+    bench_pack();
+    bench_extract();
+    bench_ringbuf();
+    bench_past();
+    bench_brownout_save();
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "font.h"
+#include "font-18.h"
+#include "font-24.h"
+#include "font-48.h"
+
+static uint32_t g_num_pass = 0;
+static uint32_t g_num_fail = 0;
+
+static void check(bool ok, const char *what)
+{
+    if (ok) {
+        g_num_pass++;
+    } else {
+        printf("Failed: %s\n", what);
+        g_num_fail++;
+    }
+}
+
+/** The index agrees with the glyph order of font-convert.py */
+static bool index_matches(const font_t *font)
+{
+    const char *characters = "0123456789.VA";
+    for (uint32_t i = 0; i < strlen(characters); i++) {
+        if (font_glyph(font, characters[i]) != (int32_t) i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char const *argv[])
+{
+    const font_t *fonts[] = {font_get(18), font_get(24), font_get(48)};
+    (void) argc;
+    (void) argv;
+
+    check(fonts[0] == &font_18 && fonts[1] == &font_24 && fonts[2] == &font_48, "fonts by size");
+    check(font_get(0) == NULL && font_get(36) == NULL, "missing size");
+    for (uint32_t i = 0; i < 3; i++) {
+        const font_t *font = fonts[i];
+        uint32_t widest = 0;
+        for (uint32_t g = 0; g < 10; g++) {
+            widest = font->widths[g] > widest ? font->widths[g] : widest;
+        }
+        check(index_matches(font), "glyph index");
+        check(font_glyph(font, 'B') < 0 && font_glyph(font, ' ') < 0 && font_glyph(font, '-') < 0, "characters without glyphs");
+        check(font_glyph(font, (char) 0xff) < 0 && font_glyph(font, '\n') < 0, "outside of the index");
+        check(font->digit_width == widest && font->max_width >= widest, "width metrics");
+        check(font->advances[0] > font->widths[0], "spacing");
+        check(font_text_width(font, "1.5V") == (uint32_t) (font->advances[1] + font->advances[10] + font->advances[5] + font->advances[11]), "text width");
+        check(font_text_width(font, "1 B1") == 2u * font->advances[1], "text width skipping characters");
+        check(font_text_width(font, "") == 0, "empty text");
+    }
+    check(font_18.height == font_18_height && font_48.height == font_48_height, "height");
+
+    if (g_num_fail == 0) {
+        printf("All tests passed\n");
+    } else if (g_num_pass == 0) {
+        printf("All tests failed!\n");
+    } else {
+        printf ("%d/%d test failed\n", g_num_fail, g_num_pass);
+    }
+    printf("\n");
+
+    return g_num_fail != 0;
+}
@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "intfmt.h"
+
+static uint32_t g_num_pass = 0;
+static uint32_t g_num_fail = 0;
+
+static void check(bool ok, const char *what)
+{
+    if (ok) {
+        g_num_pass++;
+    } else {
+        printf("Failed: %s\n", what);
+        g_num_fail++;
+    }
+}
+
+/** Format and parse back, comparing with the C library */
+static bool round_trip(int32_t value)
+{
+    char buf[16], ref[16];
+    int32_t parsed;
+    uint32_t len = intfmt_i32(buf, sizeof(buf), value);
+    snprintf(ref, sizeof(ref), "%d", value);
+    return len == strlen(ref) && strcmp(buf, ref) == 0 && intfmt_parse_i32(buf, &parsed) && parsed == value;
+}
+
+int main(int argc, char const *argv[])
+{
+    int32_t values[] = {0, 1, -1, 9, 10, 99, 100, -100, 5000, 123456789, 999999999, 1000000000, 2147483647, -2147483647 - 1};
+    int32_t parsed;
+    char buf[4];
+    bool ok = true;
+    (void) argc;
+    (void) argv;
+
+    for (uint32_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        check(round_trip(values[i]), "round trip");
+    }
+    srand(1);
+    for (uint32_t i = 0; i < 100000; i++) {
+        ok &= round_trip((int32_t) ((uint32_t) rand() * 2u + (uint32_t) rand()));
+    }
+    check(ok, "random round trips");
+
+    check(intfmt_i32(buf, sizeof(buf), -100) == 0, "too small buffer");
+    check(intfmt_i32(buf, sizeof(buf), 999) == 3 && strcmp(buf, "999") == 0, "exact buffer");
+    check(intfmt_parse_i32("+42", &parsed) && parsed == 42, "plus sign");
+    check(!intfmt_parse_i32("", &parsed), "empty string");
+    check(!intfmt_parse_i32("-", &parsed), "lone sign");
+    check(!intfmt_parse_i32("12a", &parsed), "trailing garbage");
+    check(!intfmt_parse_i32("2147483648", &parsed), "overflow");
+    check(!intfmt_parse_i32("-2147483649", &parsed), "underflow");
+
+    if (g_num_fail == 0) {
+        printf("All tests passed\n");
+    } else if (g_num_pass == 0) {
+        printf("All tests failed!\n");
+    } else {
+        printf ("%d/%d test failed\n", g_num_fail, g_num_pass);
+    }
+    printf("\n");
+
+    return g_num_fail != 0;
+}
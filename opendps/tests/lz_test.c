@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lz.h"
+#include "lz_vectors.h"
+
+static uint32_t g_num_pass = 0;
+static uint32_t g_num_fail = 0;
+
+/** The image decoded by lz_decode() */
+static uint8_t g_decoded[IMAGE_LENGTH];
+static uint32_t g_decoded_length;
+
+upgrade_status_t lz_output(uint8_t b)
+{
+    if (g_decoded_length >= sizeof(g_decoded)) {
+        return upgrade_overflow_error;
+    }
+    g_decoded[g_decoded_length++] = b;
+    return upgrade_continue;
+}
+
+uint8_t lz_image_byte(uint32_t pos)
+{
+    return g_decoded[pos];
+}
+
+static void check(bool ok, const char *what)
+{
+    if (ok) {
+        g_num_pass++;
+    } else {
+        printf("Failed: %s\n", what);
+        g_num_fail++;
+    }
+}
+
+/** Random bytes, erased flash, copies from 1500 bytes back and repeated text
+  * with noise, in turns of 512 bytes. Must match lz_vectors.py. */
+static void make_image(uint8_t *image, uint32_t length)
+{
+    const char *text = "opendps ";
+    uint32_t x = 1;
+    for (uint32_t i = 0; i < length; i++) {
+        x = x * 1103515245 + 12345;
+        uint8_t r = (x >> 16) & 0xff;
+        switch ((i / 512) % 4) {
+            case 0:
+                image[i] = r;
+                break;
+            case 1:
+                image[i] = 0xff;
+                break;
+            case 2:
+                image[i] = i >= 1500 ? image[i - 1500] : r;
+                break;
+            default:
+                image[i] = text[i % 8] ^ (r < 8 ? 1 : 0);
+                break;
+        }
+    }
+}
+
+/** Decode data in packets of 1 to max_packet bytes, random if random_split */
+static upgrade_status_t decode(const uint8_t *data, uint32_t length, uint32_t max_packet, bool random_split)
+{
+    upgrade_status_t status = upgrade_continue;
+    lz_reset();
+    g_decoded_length = 0;
+    for (uint32_t pos = 0; pos < length && status == upgrade_continue; ) {
+        uint32_t packet = random_split ? 1 + rand() % max_packet : max_packet;
+        if (packet > length - pos) {
+            packet = length - pos;
+        }
+        status = lz_decode(&data[pos], packet);
+        pos += packet;
+    }
+    return status;
+}
+
+static bool decoded_is(const uint8_t *expected, uint32_t length)
+{
+    return g_decoded_length == length && memcmp(g_decoded, expected, length) == 0;
+}
+
+int main(int argc, char const *argv[])
+{
+    static uint8_t image[IMAGE_LENGTH];
+    bool ok = true;
+    (void) argc;
+    (void) argv;
+
+    make_image(image, sizeof(image));
+    check(decode(lz_image, sizeof(lz_image), sizeof(lz_image), false) == upgrade_continue && decoded_is(image, sizeof(image)), "whole stream");
+    check(decode(lz_image, sizeof(lz_image), 1, false) == upgrade_continue && decoded_is(image, sizeof(image)), "byte by byte");
+    check(sizeof(lz_image) < sizeof(image), "compression");
+    srand(1);
+    for (uint32_t i = 0; i < 1000; i++) {
+        ok &= decode(lz_image, sizeof(lz_image), i < 500 ? 8 : UPGRADE_PIPELINE_CHUNK_SIZE, true) == upgrade_continue && decoded_is(image, sizeof(image));
+    }
+    check(ok, "random packet splits");
+
+    {
+        /** A match of distance 1 repeats the literal before it */
+        const uint8_t run[] = {0x00, 'a', 0x81, 0x00, 0x01};
+        check(decode(run, sizeof(run), 2, false) == upgrade_continue && decoded_is((const uint8_t*) "aaaaa", 5), "overlapping match");
+        const uint8_t before[] = {0x00, 'a', 0x80, 0x00, 0x02};
+        check(decode(before, sizeof(before), 1, false) == upgrade_protocol_error, "match before the image");
+        const uint8_t zero[] = {0x00, 'a', 0x80, 0x00, 0x00};
+        check(decode(zero, sizeof(zero), 1, false) == upgrade_protocol_error, "zero distance");
+    }
+
+    if (g_num_fail == 0) {
+        printf("All tests passed\n");
+    } else if (g_num_pass == 0) {
+        printf("All tests failed!\n");
+    } else {
+        printf ("%d/%d test failed\n", g_num_fail, g_num_pass);
+    }
+    printf("\n");
+
+    return g_num_fail != 0;
+}
@@ -0,0 +1,144 @@
+/** Generated by lz_vectors.py, do not edit */
+#define IMAGE_LENGTH  (5000)
+static const uint8_t lz_image[] = {
+    0x7f, 0xc6, 0x7e, 0x81, 0x6b, 0x4b, 0xfb, 0xe2, 0xfb, 0x54, 0xf6, 0xbd, 0xdf, 0x7c, 0x1c, 0xe1,
+    0x87, 0x01, 0xbf, 0x31, 0xde, 0x56, 0x72, 0x0f, 0x47, 0x67, 0x66, 0x87, 0x59, 0xaa, 0x88, 0x3c,
+    0x59, 0xea, 0x56, 0x13, 0x7b, 0xd2, 0x85, 0xa1, 0xd8, 0x3c, 0x54, 0x55, 0x2f, 0x37, 0xae, 0x65,
+    0x5b, 0xda, 0x02, 0x79, 0x98, 0xcc, 0xe3, 0x1a, 0x76, 0x8e, 0x5f, 0xd9, 0x99, 0x8f, 0x1f, 0x3f,
+    0x36, 0xee, 0x43, 0x78, 0x4d, 0x0d, 0xfa, 0xbe, 0xa6, 0xda, 0xe4, 0x86, 0x8e, 0xdc, 0x29, 0x6d,
+    0x4e, 0xff, 0x56, 0xe1, 0x70, 0x20, 0xfb, 0x8f, 0xb1, 0x58, 0x05, 0x90, 0xc5, 0x09, 0xdc, 0x53,
+    0xcd, 0xaa, 0x3b, 0x48, 0x99, 0x52, 0xd3, 0x52, 0x9d, 0x06, 0x9f, 0xea, 0xb5, 0xc2, 0x06, 0x13,
+    0x98, 0x49, 0xb2, 0x01, 0x1e, 0xac, 0x32, 0x88, 0x31, 0x9c, 0x52, 0x46, 0x95, 0x71, 0x36, 0x8f,
+    0x57, 0x7f, 0xf6, 0x39, 0x1d, 0x16, 0xfa, 0x88, 0x74, 0xf5, 0x98, 0x7c, 0x17, 0x5c, 0x41, 0xbb,
+    0x6d, 0x71, 0x8e, 0x0f, 0x70, 0x59, 0xc7, 0x01, 0x1b, 0x2f, 0x33, 0x3d, 0x91, 0xc0, 0x1d, 0xa5,
+    0x0d, 0x0d, 0xab, 0x33, 0x8d, 0x7e, 0x5e, 0x8f, 0x3e, 0xe6, 0x68, 0x74, 0xa6, 0x3a, 0xb1, 0xc3,
+    0x93, 0x11, 0xa8, 0x64, 0xc7, 0xdb, 0xca, 0xe0, 0x60, 0xe1, 0xf3, 0xbf, 0x09, 0x00, 0x67, 0xa2,
+    0xe3, 0x25, 0xa0, 0x21, 0x31, 0x87, 0xd5, 0x62, 0xc5, 0xa8, 0x4f, 0x7e, 0x2e, 0x09, 0x6b, 0x94,
+    0x9f, 0xb0, 0x6d, 0xa9, 0x9e, 0x5a, 0x0b, 0x46, 0x70, 0x80, 0xb6, 0xcf, 0x47, 0x0c, 0xa6, 0xa5,
+    0x2a, 0xd8, 0xac, 0xfb, 0xa0, 0xeb, 0xb7, 0x79, 0x24, 0x72, 0x23, 0x92, 0x48, 0x80, 0xc5, 0xa6,
+    0xa7, 0x85, 0xb7, 0xd7, 0x8c, 0x90, 0xe4, 0xab, 0x63, 0x44, 0x52, 0x66, 0xe3, 0x9c, 0x33, 0x25,
+    0xf9, 0x5e, 0x7f, 0xaa, 0xba, 0x73, 0x60, 0x5d, 0x4b, 0x71, 0x7e, 0xbe, 0xa9, 0x8c, 0x57, 0x19,
+    0x71, 0xc3, 0xca, 0x5e, 0xe5, 0x2a, 0x33, 0xac, 0x88, 0x51, 0x66, 0xa1, 0x7b, 0x75, 0x67, 0x64,
+    0x9a, 0x69, 0xef, 0x6f, 0x56, 0x42, 0xa0, 0x1d, 0x51, 0xc5, 0x02, 0xf7, 0xbb, 0x92, 0x45, 0xbe,
+    0x6f, 0x0d, 0xb6, 0x38, 0xcc, 0x10, 0xfd, 0xbb, 0x54, 0x51, 0x1c, 0x7b, 0x07, 0x94, 0x27, 0x93,
+    0x7d, 0x92, 0xc3, 0xd4, 0xc6, 0xa5, 0x61, 0x51, 0x01, 0x38, 0x38, 0xa7, 0xbf, 0xf1, 0x04, 0x0d,
+    0x15, 0x9b, 0x80, 0x1f, 0x83, 0xd5, 0xa4, 0x69, 0x88, 0x7c, 0x9f, 0xb6, 0x01, 0xda, 0x93, 0x17,
+    0x45, 0x8b, 0x12, 0xb2, 0x02, 0x33, 0x5c, 0x50, 0xd6, 0xe1, 0x56, 0xa4, 0xad, 0x42, 0x4a, 0x5c,
+    0xdd, 0x86, 0x61, 0xe9, 0x03, 0x12, 0xe1, 0x0f, 0x9b, 0xea, 0x26, 0x2c, 0x61, 0xdc, 0x62, 0x48,
+    0x6b, 0x6d, 0x14, 0x7f, 0xe0, 0x03, 0x85, 0x4a, 0x72, 0x46, 0xda, 0x96, 0xc8, 0x7d, 0x1c, 0xd1,
+    0x05, 0x3e, 0xe5, 0x92, 0x70, 0x43, 0x5f, 0x6c, 0x03, 0x05, 0xb3, 0xeb, 0xb3, 0x20, 0x35, 0x4d,
+    0x7e, 0x66, 0x50, 0x01, 0x36, 0xc0, 0x33, 0xe1, 0x0f, 0xc9, 0x38, 0x2e, 0xe9, 0x29, 0x19, 0x4f,
+    0x5e, 0xb1, 0xd1, 0x49, 0x8b, 0x3b, 0x53, 0xfd, 0x9f, 0x3f, 0xee, 0x25, 0x25, 0x35, 0x7b, 0x0d,
+    0x11, 0xaf, 0x4c, 0x11, 0x8c, 0x32, 0xd4, 0xda, 0x7f, 0xd8, 0x16, 0x57, 0xe1, 0xa6, 0xce, 0x7d,
+    0xc1, 0xae, 0x62, 0xbf, 0x13, 0xe4, 0x87, 0x4c, 0x3a, 0xc1, 0xb3, 0x0c, 0x59, 0x99, 0x47, 0x58,
+    0x5a, 0xbd, 0x78, 0x7c, 0xba, 0x50, 0x01, 0xed, 0x1b, 0xea, 0x8a, 0x49, 0x88, 0xee, 0xd6, 0x14,
+    0x85, 0xab, 0xb0, 0x2c, 0xde, 0x35, 0x93, 0x11, 0x2d, 0x01, 0x1c, 0xd7, 0x28, 0x43, 0x30, 0xe7,
+    0xb0, 0x08, 0xed, 0x79, 0x00, 0xff, 0xff, 0x00, 0x01, 0xff, 0x00, 0x01, 0xff, 0x00, 0x01, 0xf6,
+    0x00, 0x01, 0x7f, 0x9c, 0x17, 0xd1, 0x28, 0x58, 0x63, 0x27, 0x6e, 0x44, 0x6b, 0x82, 0xa4, 0xba,
+    0x98, 0x73, 0xfa, 0xbb, 0xff, 0x9c, 0x1a, 0x76, 0xf2, 0x1f, 0x29, 0x99, 0x62, 0xc8, 0x7c, 0x5b,
+    0xfb, 0xf9, 0x1a, 0x46, 0xfd, 0x59, 0xf6, 0xc5, 0xdb, 0x3c, 0xe9, 0x71, 0x96, 0xd0, 0x71, 0x1c,
+    0xd8, 0x0d, 0x2c, 0x99, 0xd0, 0x5a, 0x12, 0x51, 0xd0, 0x00, 0x75, 0x87, 0xa8, 0x4f, 0xba, 0x66,
+    0xc0, 0x92, 0xd5, 0xd0, 0xf7, 0xb4, 0x86, 0xe5, 0x3f, 0xaf, 0x55, 0x55, 0xf5, 0xb8, 0x4e, 0x66,
+    0x01, 0x2c, 0x7d, 0xc4, 0xb2, 0x38, 0x28, 0x0c, 0x56, 0x4b, 0xcf, 0x17, 0x9c, 0x3d, 0xe4, 0x07,
+    0xab, 0x3c, 0x4a, 0x12, 0xfe, 0x7b, 0x90, 0x11, 0x06, 0x99, 0xea, 0xc7, 0x7d, 0xd1, 0xf3, 0xf2,
+    0x8c, 0xe7, 0x25, 0x14, 0x9c, 0xce, 0x14, 0xfe, 0xfc, 0x19, 0x6d, 0x21, 0x37, 0x28, 0xb2, 0x94,
+    0x33, 0x0f, 0xb3, 0x7f, 0xe4, 0x0a, 0x45, 0xcb, 0x9f, 0xa8, 0x11, 0xe0, 0x9f, 0x29, 0xb4, 0x18,
+    0x17, 0xef, 0x57, 0x5c, 0x5f, 0x86, 0xb3, 0x8d, 0x7f, 0x39, 0x82, 0x89, 0x7d, 0x71, 0xa9, 0xdc,
+    0x67, 0xd0, 0x22, 0x46, 0x1f, 0x11, 0xab, 0xf1, 0xe9, 0x9e, 0x30, 0x6f, 0xb6, 0xee, 0xf9, 0x75,
+    0x2e, 0xa5, 0x94, 0x59, 0x7f, 0x69, 0x80, 0x4d, 0xe8, 0x85, 0x9e, 0x59, 0x04, 0x40, 0x58, 0x1a,
+    0xd7, 0xfb, 0x8e, 0x3c, 0x9a, 0x0d, 0x45, 0xb9, 0x46, 0x5f, 0x0e, 0xce, 0xe2, 0xc6, 0x38, 0xc2,
+    0x8d, 0x24, 0xb5, 0x56, 0x4b, 0x3d, 0xcd, 0x0b, 0x8f, 0x59, 0x84, 0x16, 0x8c, 0x9f, 0xcc, 0x24,
+    0x3c, 0x2c, 0x6b, 0xce, 0x2d, 0xf6, 0xaa, 0xda, 0x0e, 0x64, 0xc3, 0x37, 0xfd, 0xa9, 0x08, 0xb7,
+    0x8e, 0xe4, 0xd3, 0x8a, 0x9b, 0xf9, 0x31, 0x7e, 0xce, 0x2d, 0x4d, 0xf8, 0xef, 0x83, 0x9e, 0xb1,
+    0xee, 0xda, 0xd0, 0x32, 0x7f, 0xb0, 0xc3, 0x73, 0x0d, 0x9a, 0x24, 0x66, 0xe1, 0xde, 0x8e, 0x02,
+    0x0b, 0x88, 0x5d, 0x06, 0x2c, 0x47, 0x95, 0x45, 0x5f, 0xfc, 0x77, 0x11, 0x37, 0x04, 0xe6, 0x66,
+    0x7b, 0x46, 0x7d, 0xd6, 0xa1, 0xfb, 0x6d, 0x38, 0x0b, 0x40, 0x17, 0x10, 0x03, 0x5d, 0x6d, 0xbd,
+    0x78, 0xd3, 0x09, 0x65, 0x76, 0x27, 0x0a, 0xa1, 0x67, 0x71, 0xb2, 0xe7, 0x0b, 0xa3, 0xc0, 0xbb,
+    0x39, 0x9a, 0x8e, 0x95, 0x53, 0xe6, 0xeb, 0x91, 0x8a, 0x5a, 0xb6, 0xd9, 0xd7, 0x52, 0x3f, 0xd2,
+    0xb4, 0xc7, 0x5d, 0x09, 0x9e, 0x14, 0x4f, 0xdc, 0x4c, 0x85, 0x53, 0xe8, 0xac, 0xa5, 0x08, 0x36,
+    0xa2, 0x44, 0x84, 0x24, 0x80, 0x4a, 0x35, 0x15, 0x43, 0x3f, 0x78, 0xd8, 0x93, 0x96, 0xfb, 0xd9,
+    0x79, 0xbc, 0xd3, 0x0a, 0xde, 0xe5, 0x5c, 0x8f, 0xc7, 0x91, 0xd4, 0x2c, 0x52, 0xe0, 0xb7, 0x6f,
+    0x70, 0x9b, 0xd8, 0x9d, 0x60, 0x5b, 0xfe, 0x44, 0x5d, 0xef, 0x47, 0xd6, 0x26, 0x71, 0xff, 0x9a,
+    0x6a, 0x7d, 0x0b, 0xe2, 0x7f, 0x6c, 0x71, 0x2a, 0x52, 0x90, 0xeb, 0xad, 0xca, 0x35, 0x2e, 0xc3,
+    0xfd, 0x59, 0xf7, 0x01, 0x15, 0x2a, 0xda, 0x0f, 0x01, 0x44, 0xca, 0x47, 0xdb, 0xa7, 0x67, 0x13,
+    0x1c, 0x7a, 0x0b, 0x03, 0x82, 0x81, 0x93, 0xb1, 0xbc, 0x60, 0xed, 0x55, 0xdb, 0x8d, 0x66, 0x27,
+    0x79, 0x16, 0xb1, 0x78, 0xa7, 0x18, 0xb6, 0x8f, 0x98, 0xfb, 0x20, 0x44, 0x0e, 0x6e, 0xa5, 0x5e,
+    0x88, 0x26, 0x14, 0xae, 0x28, 0x56, 0x20, 0xe8, 0x66, 0xed, 0xee, 0x44, 0x77, 0x92, 0x60, 0xd8,
+    0x7b, 0x60, 0xa1, 0x05, 0xdc, 0x0a, 0x6f, 0x70, 0x64, 0x6e, 0x64, 0x70, 0x73, 0x20, 0x6e, 0x70,
+    0x65, 0x82, 0x00, 0x08, 0x00, 0x6f, 0x85, 0x00, 0x08, 0x00, 0x71, 0x85, 0x00, 0x10, 0x83, 0x00,
+    0x20, 0x86, 0x00, 0x18, 0xff, 0x00, 0x08, 0x02, 0x6e, 0x64, 0x71, 0x8c, 0x00, 0x98, 0x82, 0x00,
+    0x10, 0x83, 0x00, 0x20, 0x8e, 0x00, 0xc8, 0x80, 0x00, 0x08, 0x03, 0x65, 0x71, 0x73, 0x21, 0x8f,
+    0x00, 0x48, 0x82, 0x00, 0x40, 0x8a, 0x00, 0x18, 0x00, 0x65, 0xb3, 0x00, 0x90, 0x00, 0x6f, 0xb1,
+    0x00, 0xc8, 0x91, 0x00, 0xa8, 0xa0, 0x00, 0x08, 0x88, 0x00, 0xb0, 0x00, 0x64, 0x81, 0x00, 0x78,
+    0x80, 0x00, 0x10, 0x87, 0x01, 0x08, 0x9b, 0x00, 0xc0, 0x93, 0x01, 0xc8, 0x7f, 0x32, 0x70, 0xe1,
+    0xa5, 0x25, 0x8c, 0x2c, 0xa1, 0xf4, 0x9f, 0x08, 0x29, 0xb8, 0xd4, 0xc5, 0x2c, 0x34, 0xff, 0xc7,
+    0x17, 0x56, 0x31, 0xef, 0xcb, 0x8c, 0x1d, 0xc8, 0x60, 0xcd, 0x2e, 0x76, 0x9c, 0x62, 0x64, 0x5f,
+    0x31, 0x78, 0xf2, 0x96, 0xba, 0x67, 0x99, 0x0c, 0x74, 0xc0, 0xc2, 0x75, 0xbc, 0x19, 0x5e, 0xfb,
+    0x4c, 0x97, 0x7e, 0xa6, 0x35, 0x40, 0xb1, 0x86, 0x9c, 0xfe, 0x21, 0xa5, 0x34, 0x72, 0x6c, 0xb0,
+    0x7f, 0x7e, 0x43, 0x5f, 0xc4, 0x91, 0xc5, 0xaa, 0xcf, 0xb1, 0x99, 0xaa, 0x6b, 0x4a, 0xcd, 0x4f,
+    0xa0, 0xb8, 0x72, 0xc7, 0xad, 0x96, 0xf4, 0xa9, 0xc4, 0xc4, 0x3a, 0xe5, 0x88, 0x3a, 0x81, 0x6d,
+    0x47, 0x90, 0xf8, 0x9f, 0xf7, 0x49, 0x1c, 0x79, 0xf2, 0xe3, 0xd2, 0x7b, 0x71, 0x9f, 0x46, 0x5b,
+    0xca, 0x10, 0x85, 0x6b, 0x69, 0x66, 0xdc, 0xcb, 0x90, 0x78, 0xf0, 0x4e, 0xce, 0x7f, 0x93, 0x9a,
+    0x2d, 0x40, 0x04, 0x88, 0x6e, 0x8b, 0x67, 0x95, 0x12, 0x95, 0xae, 0xe3, 0x01, 0x06, 0xf0, 0xbe,
+    0xb6, 0x82, 0xf7, 0x30, 0xaa, 0xa3, 0x88, 0x64, 0x82, 0xb8, 0x70, 0xbb, 0xf7, 0x3f, 0x53, 0xb0,
+    0x89, 0x24, 0x34, 0x6c, 0xe3, 0xb8, 0xc3, 0x28, 0x0d, 0x70, 0x6a, 0x47, 0x54, 0x62, 0x16, 0x2f,
+    0xf9, 0x7f, 0xc6, 0xeb, 0x9c, 0x91, 0xd4, 0x82, 0x66, 0xf4, 0x06, 0x14, 0xf9, 0x14, 0x54, 0xba,
+    0x19, 0xaa, 0x77, 0x1b, 0x17, 0xb5, 0x36, 0xce, 0x01, 0x3a, 0x70, 0x74, 0x8b, 0xbc, 0xe8, 0x90,
+    0xbc, 0x7b, 0xd3, 0x2d, 0x58, 0x6c, 0x23, 0x2e, 0x11, 0xfb, 0x91, 0x73, 0x6c, 0x83, 0x6d, 0xb1,
+    0x74, 0x89, 0x25, 0x0e, 0x22, 0xbc, 0x97, 0x7f, 0x87, 0xad, 0x16, 0xe2, 0xbf, 0x4e, 0x3e, 0xda,
+    0x96, 0x2c, 0x78, 0x6e, 0xf7, 0x6c, 0x4c, 0x61, 0x19, 0x87, 0x6a, 0x4f, 0x67, 0xc5, 0x7f, 0x76,
+    0x8c, 0x33, 0x7b, 0x96, 0xbc, 0x1b, 0x04, 0xbd, 0x32, 0x37, 0x80, 0xb6, 0x09, 0x08, 0x4f, 0xf0,
+    0x05, 0x20, 0x4c, 0x0c, 0x27, 0x91, 0xc9, 0x27, 0x12, 0x16, 0x4f, 0xe7, 0x20, 0x04, 0x12, 0x47,
+    0x43, 0xee, 0x36, 0x23, 0x9e, 0x1b, 0xc4, 0x83, 0xdf, 0xa9, 0x6a, 0xa7, 0x62, 0x7d, 0xf6, 0xd6,
+    0x07, 0xf2, 0x91, 0xe7, 0xcf, 0x3d, 0xbb, 0x8c, 0x39, 0xa2, 0x0a, 0x62, 0x5f, 0x58, 0xa2, 0xb9,
+    0xcf, 0x3d, 0x73, 0x23, 0x2a, 0x3a, 0x36, 0xbe, 0x7f, 0x74, 0x25, 0x41, 0x65, 0x37, 0x7d, 0xc9,
+    0xda, 0xa3, 0xb4, 0x61, 0xdf, 0x14, 0x7a, 0x53, 0xcf, 0x53, 0x72, 0x31, 0x83, 0x7e, 0xad, 0xa2,
+    0x28, 0xb7, 0xeb, 0xee, 0xdb, 0x8f, 0x90, 0x47, 0x09, 0x31, 0x67, 0xdd, 0x89, 0x4e, 0x1a, 0xa0,
+    0x76, 0xcc, 0x6d, 0xd3, 0xce, 0x2e, 0x3e, 0x55, 0xcc, 0xc1, 0x3d, 0xae, 0x05, 0x8c, 0x6b, 0x7f,
+    0xdc, 0x44, 0xf5, 0x54, 0xdc, 0x27, 0x33, 0x0b, 0xf7, 0x76, 0x77, 0xea, 0xd1, 0x46, 0xda, 0x07,
+    0x33, 0xd2, 0x05, 0x75, 0x93, 0x14, 0xa2, 0x3f, 0x69, 0x27, 0x86, 0x25, 0x31, 0x5c, 0x9b, 0x14,
+    0x3e, 0x1e, 0x8f, 0x67, 0x45, 0x86, 0x3e, 0xe0, 0xa5, 0xbd, 0xe0, 0x64, 0x77, 0x15, 0xf2, 0x7a,
+    0x5a, 0xe6, 0xe5, 0x82, 0xfb, 0x2a, 0x89, 0xb5, 0x67, 0xd8, 0x38, 0xe0, 0x10, 0x01, 0xc2, 0xe0,
+    0xa0, 0xab, 0x1c, 0xdc, 0x81, 0x71, 0xc7, 0x45, 0x29, 0xd7, 0x02, 0x8f, 0x26, 0x6e, 0xaf, 0xac,
+    0xed, 0xab, 0x05, 0x4d, 0x62, 0x88, 0xfb, 0xd7, 0x27, 0xd8, 0x70, 0x27, 0xa5, 0x6b, 0x1a, 0x06,
+    0xdb, 0xe5, 0x35, 0x6b, 0xe9, 0x5f, 0xe7, 0x73, 0x5b, 0xbb, 0x75, 0x21, 0x36, 0xc7, 0x28, 0xd5,
+    0xc5, 0x19, 0xfd, 0x8e, 0x20, 0xa4, 0x0f, 0xdf, 0x81, 0x1e, 0xc5, 0xb2, 0x46, 0x12, 0xbb, 0xc0,
+    0xbf, 0x06, 0x42, 0xff, 0x00, 0x01, 0xff, 0x00, 0x01, 0xff, 0x00, 0x01, 0xb5, 0x00, 0x01, 0xff,
+    0x05, 0xd4, 0xff, 0x05, 0xdc, 0xff, 0x05, 0xdc, 0xf7, 0x05, 0xdc, 0x97, 0x00, 0x84, 0x9c, 0x01,
+    0x0c, 0x86, 0x08, 0x20, 0x9e, 0x00, 0xcc, 0x88, 0x00, 0x18, 0x00, 0x72, 0x92, 0x01, 0x2c, 0x91,
+    0x00, 0xdc, 0xa2, 0x01, 0x44, 0x81, 0x02, 0x1c, 0x9b, 0x00, 0x88, 0xd5, 0x01, 0xac, 0xc8, 0x00,
+    0x08, 0xa4, 0x09, 0x60, 0x80, 0x00, 0xe8, 0x97, 0x02, 0x04, 0x8f, 0x01, 0x58, 0xa5, 0x01, 0xc8,
+    0x7f, 0x9f, 0x61, 0x42, 0xe0, 0xff, 0x1d, 0x75, 0x47, 0x93, 0x47, 0x53, 0x72, 0xf5, 0x8c, 0xaa,
+    0xd1, 0x66, 0x3e, 0x5d, 0x4f, 0x56, 0xf0, 0xce, 0x4f, 0xb1, 0xd3, 0x09, 0x67, 0xef, 0xd3, 0xb1,
+    0xdf, 0xda, 0x71, 0xab, 0xe7, 0x1e, 0x5f, 0x8c, 0x9c, 0x93, 0xdd, 0xc3, 0xb9, 0x49, 0xd6, 0x86,
+    0x1d, 0x57, 0xb9, 0x7d, 0x01, 0x63, 0x19, 0x31, 0xf5, 0xf1, 0x03, 0x33, 0x9f, 0x6d, 0x23, 0x0c,
+    0x33, 0xf6, 0x96, 0xe8, 0xb1, 0xf0, 0x8c, 0x01, 0xe2, 0x48, 0xa5, 0xcd, 0x10, 0x86, 0x09, 0xe6,
+    0x88, 0x94, 0x45, 0xbd, 0xd0, 0x50, 0xe9, 0xff, 0xa9, 0xd3, 0xe2, 0xc3, 0xc3, 0x7f, 0x98, 0x78,
+    0x42, 0xcb, 0xc6, 0x91, 0xf5, 0xce, 0x1d, 0xed, 0x51, 0x8c, 0x98, 0x08, 0x2f, 0x04, 0x9d, 0xe4,
+    0x4a, 0xf5, 0xd9, 0xb5, 0x76, 0x74, 0xd8, 0x4f, 0xa1, 0x2f, 0x67, 0x50, 0x8b, 0x7e, 0xaa, 0x0d,
+    0x45, 0x7f, 0x2f, 0xfc, 0x3d, 0x6b, 0x0e, 0x89, 0x67, 0x20, 0x36, 0xad, 0x0d, 0xce, 0x1b, 0x0b,
+    0x96, 0x9b, 0x53, 0x6e, 0xfc, 0xaa, 0x27, 0x5f, 0x3a, 0x16, 0xdd, 0x8a, 0x73, 0xaf, 0xc3, 0xd1,
+    0xe2, 0x72, 0xfb, 0x2d, 0x85, 0xca, 0x0a, 0x49, 0x89, 0x89, 0x1f, 0xdd, 0x74, 0xa5, 0x23, 0xcb,
+    0x14, 0xb2, 0x84, 0xfa, 0x2b, 0x23, 0xc1, 0xf6, 0xd7, 0x41, 0xb6, 0x44, 0xc3, 0xe7, 0xa5, 0x86,
+    0x10, 0x02, 0x08, 0x54, 0x01, 0xcc, 0x19, 0xd4, 0x69, 0xc3, 0x1d, 0x1f, 0xd4, 0x6c, 0x74, 0x54,
+    0x78, 0xc9, 0x62, 0x78, 0xda, 0x9b, 0x9b, 0x14, 0x40, 0x58, 0x90, 0x8c, 0xda, 0xeb, 0x7c, 0x41,
+    0xaf, 0x2e, 0x2d, 0x66, 0x48, 0x27, 0x93, 0xa3, 0x1f, 0x06, 0x0a, 0x6b, 0xc6, 0xda, 0x67, 0x1e,
+    0xd8, 0x17, 0xc4, 0xde, 0xa0, 0xc8, 0x0c, 0x31, 0x8b, 0x94, 0x45, 0x5b, 0x4e, 0x72, 0xa0, 0x79,
+    0xd6, 0x2c, 0x7f, 0x42, 0x5d, 0xf4, 0x95, 0xd0, 0x2d, 0xc5, 0x89, 0xbd, 0xba, 0xe2, 0xa9, 0x53,
+    0xa1, 0x4d, 0xd3, 0x82, 0x24, 0x16, 0x64, 0x6c, 0xc6, 0xd0, 0x2d, 0xac, 0xa8, 0xb7, 0x36, 0x6a,
+    0xa6, 0x9e, 0x35, 0x20, 0x31, 0x9a, 0xcc, 0x29, 0xea, 0x71, 0x86, 0x0e, 0x04, 0xc0, 0x90, 0x90,
+    0x56, 0xee, 0x37, 0x75, 0x43, 0xd4, 0x25, 0x13, 0x4a, 0x29, 0x5b, 0x9d, 0x6c, 0xaf, 0xed, 0x30,
+    0x41, 0x1f, 0x81, 0x9d, 0xd9, 0xd5, 0x86, 0xf4, 0x53, 0x3b, 0x33, 0xd5, 0x3f, 0xf7, 0x46, 0x76,
+    0xb5, 0xd4, 0x79, 0x73, 0x32, 0x71, 0xc4, 0x59, 0x36, 0xac, 0x56, 0xf1, 0x9e, 0xcc, 0x51, 0x4c,
+    0xc1, 0x70, 0x48, 0x93, 0x4d, 0x3b, 0x79, 0x8b, 0xe0, 0x3d, 0xca, 0xeb, 0x66, 0x20, 0x85, 0x5e,
+    0x35, 0x17, 0xd3, 0x56, 0xe9, 0x86, 0xfa, 0x96, 0x01, 0x71, 0x56, 0x7e, 0x36, 0xa6, 0x18, 0x15,
+    0x9f, 0xaa, 0xc2, 0x7f, 0xd8, 0x86, 0x65, 0x5e, 0x45, 0x08, 0x8d, 0x81, 0x26, 0x6e, 0xd2, 0x03,
+    0x9e, 0x4e, 0xce, 0x7b, 0xf5, 0x61, 0xab, 0x7d, 0x23, 0x23, 0x92, 0x93, 0x1e, 0x2d, 0xd7, 0xfc,
+    0xe3, 0x52, 0xe5, 0x27, 0x47, 0x7b, 0xeb, 0xed, 0x7b, 0x43, 0x43, 0x91, 0x60, 0x51, 0xa7, 0x79,
+    0x90, 0x79, 0x12, 0xab, 0x28, 0x92, 0x77, 0x06, 0x57, 0x15, 0x25, 0x45, 0xa8, 0x7a, 0xf5, 0xb3,
+    0x0f, 0x53, 0x39, 0xae, 0xb5, 0x25, 0x64, 0xde, 0x83, 0x09, 0x79, 0x33, 0x70, 0x07, 0x35, 0xa0,
+    0x8b, 0x2d, 0xfb, 0x99, 0xc7, 0x73, 0x84, 0x4d, 0x8a, 0x4f, 0x43, 0xa3, 0xf4, 0x16, 0x99, 0xf6,
+    0xef, 0x19, 0xbd, 0x91, 0xfb, 0x7b, 0x69, 0xe9, 0xb7, 0xd4, 0x45, 0x9d, 0x2e, 0x87, 0x14, 0x2e,
+    0xe7, 0xe3, 0xa1, 0x7e, 0xab, 0xfc, 0x67, 0x0a, 0x14, 0x47, 0x03, 0xe7, 0xda, 0xf8, 0x5a, 0x7e,
+    0xdd, 0x1c, 0x8a, 0x07, 0xbf, 0x06, 0x42, 0xff, 0x00, 0x01, 0xff, 0x00, 0x01, 0xbf, 0x00, 0x01,
+};
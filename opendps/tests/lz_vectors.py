@@ -0,0 +1,45 @@
+#!/usr/bin/env python
+"""
+Write lz_vectors.h, the test image of lz_test.c compressed by dpsctl/lz.py:
+
+    python lz_vectors.py > lz_vectors.h
+
+make_image() must match the one in lz_test.c.
+"""
+
+import os
+import sys
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "dpsctl"))
+import lz
+
+IMAGE_LENGTH = 5000
+
+"""
+Random bytes, erased flash, copies from 1500 bytes back and repeated text
+with noise, in turns of 512 bytes
+"""
+def make_image(length):
+    image = bytearray(length)
+    text = bytearray(b"opendps ")
+    x = 1
+    for i in range(length):
+        x = (x * 1103515245 + 12345) & 0xffffffff
+        r = (x >> 16) & 0xff
+        region = (i // 512) % 4
+        if region == 0:
+            image[i] = r
+        elif region == 1:
+            image[i] = 0xff
+        elif region == 2:
+            image[i] = image[i - 1500] if i >= 1500 else r
+        else:
+            image[i] = text[i % len(text)] ^ (1 if r < 8 else 0)
+    return image
+
+compressed = lz.compress(make_image(IMAGE_LENGTH))
+print("/** Generated by lz_vectors.py, do not edit */")
+print("#define IMAGE_LENGTH  (%d)" % (IMAGE_LENGTH))
+print("static const uint8_t lz_image[] = {")
+for i in range(0, len(compressed), 16):
+    print("    " + " ".join("0x%02x," % (b) for b in compressed[i:i + 16]))
+print("};")
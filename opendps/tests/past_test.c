@@ -16,20 +16,30 @@ void unlock_flash(void) {}
 
 past_t past;
 
+static uint32_t g_flash_status = FLASH_SR_EOP;
+
 void flash_erase_page(uint32_t address)
 {
     memset((char*) address, 0xff, 1024);
+    g_flash_status = FLASH_SR_EOP;
 }
 
+/** Like the STM32, a word must be erased to be programmed, but for clearing
+  * it to 0 */
 void flash_program_word(uint32_t address, uint32_t data)
 {
 //    printf("[0x%08x] = 0x%08x\n", address, data);
-    *((uint32_t*) address) = data;
+    uint32_t *word = (uint32_t*) address;
+    g_flash_status = 0;
+    if (*word == 0xffffffff || data == 0) {
+        *word = data;
+        g_flash_status = FLASH_SR_EOP;
+    }
 }
 
 uint32_t flash_get_status_flags(void)
 {
-    return FLASH_SR_EOP;
+    return g_flash_status;
 }
 
 
@@ -164,7 +174,7 @@ int main(int argc, char const *argv[])
         g_num_fail++;
     }
 
-    uint8_t buf[16*56];
+    uint8_t buf[16*56 - PAST_RESERVE_SIZE];
     memset(buf, 0xcd, sizeof(buf));
     if (past_write_unit(&past, 3, (void*) &buf, sizeof(buf))) {
         g_num_pass++;
@@ -206,6 +216,212 @@ int main(int argc, char const *argv[])
         g_num_fail++;
     }
 
+    // Units shorter than a word must not spill into the next one
+    uint16_t stest3 = 0xbeef;
+    if (past_write_unit(&past, 9, (void*) &stest3, sizeof(stest3)) && past_write_unit(&past, 10, (void*) &itest, sizeof(itest))) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    if (past_read_unit(&past, 9, (const void**) &p2, &length2) && length2 == 2 && *(uint16_t*) p2 == stest3 &&
+        past_read_unit(&past, 10, (const void**) &p1, &length1) && length1 == 4 && *p1 == itest) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    // Units written in a transaction replace the old ones at commit
+    uint32_t itest2 = 0x55aa55aa;
+    if (past_begin(&past, 2 * PAST_UNIT_SIZE(4)) && past_write_unit(&past, 1, (void*) &itest2, sizeof(itest2)) &&
+        past_write_unit(&past, 10, (void*) &itest2, sizeof(itest2)) && past_commit(&past)) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    if (past_init(&past) && past_read_unit(&past, 1, (const void**) &p1, &length1) && *p1 == itest2 &&
+        past_read_unit(&past, 10, (const void**) &p1, &length1) && *p1 == itest2) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    // and are all undone if one does not fit
+    if (past_begin(&past, PAST_UNIT_SIZE(4)) && past_write_unit(&past, 1, (void*) &itest, sizeof(itest)) &&
+        !past_write_unit(&past, 10, (void*) &itest, sizeof(itest)) && !past_commit(&past)) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    if (past_read_unit(&past, 1, (const void**) &p1, &length1) && *p1 == itest2 && past_init(&past) &&
+        past_read_unit(&past, 1, (const void**) &p1, &length1) && *p1 == itest2) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    // or if power is lost before the commit
+    if (past_begin(&past, PAST_UNIT_SIZE(4)) && past_write_unit(&past, 1, (void*) &itest, sizeof(itest)) &&
+        past_init(&past) && past_read_unit(&past, 1, (const void**) &p1, &length1) && *p1 == itest2) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+    itest = itest2;
+
+    // Firmware writing the data before the size and id may have left the
+    // data of a cut short write beyond the end
+    *(uint32_t*) (past._end_addr + 8) = 0x12345678;
+    if (past_init(&past) && past_write_unit(&past, 12, (void*) &itest, sizeof(itest)) && past_init(&past) &&
+        past_read_unit(&past, 12, (const void**) &p1, &length1) && length1 == 4 && *p1 == itest) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    if (past_read_unit(&past, 1, (const void**) &p1, &length1) && length1 == 4 && *p1 == itest &&
+        past_read_unit(&past, 2, (const void**) &p2, &length2) && length2 == strlen(stest2) && strcmp(p2, stest2) == 0) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+#ifdef CONFIG_PAST_INCREMENTAL_GC
+    // Rewrite a unit until a background garbage collection starts
+    uint32_t counter = past._counter;
+    for (uint32_t i = 0; i < 200 && !past_gc_step(&past); i++) {
+        (void) past_write_unit(&past, 6, (void*) &i, sizeof(i));
+    }
+    // and run it to completion while rewriting a unit it may have copied
+    for (uint32_t i = 0; i < 100 && past_gc_step(&past); i++) {
+        itest++;
+        (void) past_write_unit(&past, 1, (void*) &itest, sizeof(itest));
+    }
+    if (past._counter == counter + 1 && past_init(&past) && past._counter == counter + 1) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    if (past_read_unit(&past, 1, (const void**) &p1, &length1) && length1 == 4 && *p1 == itest) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    if (past_read_unit(&past, 2, (const void**) &p2, &length2) && length2 == strlen(stest2) && strcmp(p2, stest2) == 0) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+#endif // CONFIG_PAST_INCREMENTAL_GC
+
+#ifdef CONFIG_PAST_WRITE_BACK
+    // Writing what is already in flash leaves nothing to flush
+    if (past_write_unit_deferred(&past, 1, (void*) &itest, sizeof(itest)) && !past_is_dirty(&past)) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    // Rewrites of a pending unit are coalesced in RAM
+    uint32_t end_addr = past._end_addr;
+    for (uint32_t i = 0; i < 100; i++) {
+        if (!past_write_unit_deferred(&past, 4, (void*) &i, sizeof(i))) {
+            break;
+        }
+    }
+    if (past_is_dirty(&past) && past._end_addr == end_addr) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    // Pending units are read from the cache
+    if (past_read_unit(&past, 4, (const void**) &p1, &length1) && length1 == 4 && *p1 == 99) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    // and survive a reboot once flushed, written once in a transaction
+    if (past_flush(&past) && !past_is_dirty(&past) && past._end_addr == end_addr + 2 * PAST_UNIT_SIZE(4) && past_init(&past)) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    if (past_read_unit(&past, 4, (const void**) &p1, &length1) && length1 == 4 && *p1 == 99) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    // A unit only in the cache can be erased
+    if (past_write_unit_deferred(&past, 5, (void*) &itest, sizeof(itest)) && past_erase_unit(&past, 5) && !past_is_dirty(&past) && !past_read_unit(&past, 5, (const void**) &p1, &length1)) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    // Pending units are flushed into an open emergency transaction
+    uint32_t ctest = 0x0badf00d;
+    if (past_write_unit_deferred(&past, 4, (void*) &ctest, sizeof(ctest)) &&
+        past_begin_reserved(&past, PAST_UNIT_SIZE(4) + past_cache_size(&past)) &&
+        past_write_unit(&past, 7, (void*) &ctest, sizeof(ctest)) && past_flush(&past) && past_commit(&past) &&
+        past_init(&past) && past_read_unit(&past, 4, (const void**) &p1, &length1) && *p1 == ctest &&
+        past_read_unit(&past, 7, (const void**) &p1, &length1) && *p1 == ctest) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+#endif // CONFIG_PAST_WRITE_BACK
+
+#if PAST_RESERVE_SIZE > 0
+    // Ordinary writes leave the reserve alone, even after garbage
+    // collecting, emergency ones may use it
+    uint8_t fill[PAST_BLOCK_SIZE];
+    memset(fill, 0x5a, sizeof(fill));
+    bool formatted = past_format(&past);
+    uint32_t room = PAST_BLOCK_SIZE - (past._end_addr - past.blocks[past._cur_block]);
+    // leaving 4 bytes too few for a 4 byte unit above the reserve
+    uint32_t fill_length = room - PAST_RESERVE_SIZE - PAST_UNIT_SIZE(0) - (PAST_UNIT_SIZE(4) - 4);
+    if (formatted && past_write_unit(&past, 8, (void*) fill, fill_length) && !past_write_unit(&past, 11, (void*) &itest, sizeof(itest)) &&
+        past_begin_reserved(&past, PAST_UNIT_SIZE(4)) && past_write_unit(&past, 11, (void*) &itest, sizeof(itest)) && past_commit(&past)) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+#endif // PAST_RESERVE_SIZE
+
+#ifdef CONFIG_PAST_TRANSFER
+    // The walk sees the latest version of each unit, in write order
+    uint32_t cursor = 0, count = 0;
+    past_id_t ids[4];
+    past_id_t id;
+    if (past_format(&past) && past_write_unit(&past, 1, (void*) &itest, sizeof(itest)) &&
+        past_write_unit(&past, 2, (void*) stest1, strlen(stest1)) && past_write_unit(&past, 3, (void*) &itest, sizeof(itest)) &&
+        past_write_unit(&past, 1, (void*) stest2, strlen(stest2)) && past_erase_unit(&past, 3)) {
+        while (count < 4 && past_next_unit(&past, &cursor, &id, (const void**) &p1, &length1)) {
+            ids[count++] = id;
+        }
+    }
+    if (count == 2 && ids[0] == 2 && ids[1] == 1 && length1 == strlen(stest2) && memcmp(p1, stest2, length1) == 0) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+
+    // but not while a transaction is open
+    cursor = 0;
+    if (past_begin(&past, PAST_UNIT_SIZE(4)) && !past_next_unit(&past, &cursor, &id, (const void**) &p1, &length1) && past_commit(&past)) {
+        g_num_pass++;
+    } else {
+        g_num_fail++;
+    }
+#endif // CONFIG_PAST_TRANSFER
 
 //    hexdump("block 1", past_block1, sizeof(past_block1));
 //    hexdump("block 2", past_block2, sizeof(past_block2));
@@ -3,6 +3,7 @@
 #include <stdbool.h>
 #include "uframe.h"
 #include "protocol.h"
+#include "../../dpsboot/hw.h"
 
 
 #define VERBOSE_ERRORS
@@ -185,46 +186,6 @@ static bool test_response(char *test_name)
     return true;
 }
 
-static bool test_vout(char *test_name)
-{
-    uint8_t frame[FRAME_OVERHEAD(MAX_FRAME_SIZE)], *f = (uint8_t*) frame;
-    uint16_t out, in = 0x1234;
-    uint32_t len = protocol_create_vout(f, g_max_frame_size, in);
-    if (len == 0) {
-        if (!g_expecting_failure) {
-            printf(" %s: frame creation failed\n", test_name);
-        }
-        return false;
-    }
-    EXTRACT_PAYLOAD();
-    if (!protocol_unpack_vout(f, res, &out)) {
-        printf("%s: unpack response failed\n", test_name);
-        return false;
-    }
-    COMPARE(1, in, out);
-    return true;
-}
-
-static bool test_ilimit(char *test_name)
-{
-    uint8_t frame[FRAME_OVERHEAD(MAX_FRAME_SIZE)], *f = (uint8_t*) frame;
-    uint16_t out, in = 0x1234;
-    uint32_t len = protocol_create_ilimit(f, g_max_frame_size, in);
-    if (len == 0) {
-        if (!g_expecting_failure) {
-            printf(" %s: frame creation failed\n", test_name);
-        }
-        return false;
-    }
-    EXTRACT_PAYLOAD();
-    if (!protocol_unpack_ilimit(f, res, &out)) {
-        printf("%s: unpack response failed\n", test_name);
-        return false;
-    }
-    COMPARE(1, in, out);
-    return true;
-}
-
 static bool test_status(char *test_name)
 {
     uint8_t frame[FRAME_OVERHEAD(MAX_FRAME_SIZE)], *f = (uint8_t*) frame;
@@ -239,7 +200,7 @@ static bool test_status(char *test_name)
     EXTRACT_PAYLOAD();
     DECLARE_UNPACK(frame, res);
     UNPACK8(out);
-    COMPARE(1, cmd_status, out);
+    COMPARE(1, cmd_query, out);
     return true;
 }
 
@@ -253,7 +214,7 @@ static bool test_status_response(char *test_name)
     uint16_t out5, in5 = 0x1234;
     uint8_t out6, in6 = 1;
 
-    uint32_t len = protocol_create_status_response(f, g_max_frame_size, in1, in2, in3, in4, in5, in6);
+    uint32_t len = protocol_create_query_response(f, g_max_frame_size, in1, in2, in3, in4, in5, in6);
     if (len == 0) {
         if (!g_expecting_failure) {
             printf(" %s: frame creation failed\n", test_name);
@@ -261,7 +222,7 @@ static bool test_status_response(char *test_name)
         return false;
     }
     EXTRACT_PAYLOAD();
-    if (!protocol_unpack_status_response(f, res, &out1, &out2, &out3, &out4, &out5, &out6)) {
+    if (!protocol_unpack_query_response(f, res, &out1, &out2, &out3, &out4, &out5, &out6)) {
         printf("%s: unpack response failed\n", test_name);
         return false;
     }
@@ -334,12 +295,41 @@ static bool test_ocp(char *test_name)
     return true;
 }
 
-static bool test_power_enable(char *test_name)
+static bool test_protection_event(char *test_name)
 {
     uint8_t frame[FRAME_OVERHEAD(MAX_FRAME_SIZE)], *f = (uint8_t*) frame;
-    uint8_t out, in = 1;
-    uint32_t len = protocol_create_power_enable(f, g_max_frame_size, in);
+    protection_event_t prot_out, prot_in = protection_opp;
+    uint32_t out, in = 0x7e017d02; /** Escaped bytes */
+    uint32_t len = protocol_create_protection_event(f, g_max_frame_size, prot_in, in);
+    if (len == 0) {
+        if (!g_expecting_failure) {
+            printf(" %s: frame creation failed\n", test_name);
+        }
+        return false;
+    }
+    EXTRACT_PAYLOAD();
+    if (!protocol_unpack_protection_event(f, res, &prot_out, &out)) {
+        printf("%s: unpack response failed\n", test_name);
+        return false;
+    }
+    COMPARE(1, prot_in, prot_out);
+    COMPARE(2, in, out);
+    return true;
+}
 
+static bool test_sample_batch(char *test_name)
+{
+    uint8_t frame[FRAME_OVERHEAD(MAX_BULK_FRAME_LENGTH)], *f = (uint8_t*) frame;
+    protocol_sample_t in[4] = {
+        { 5000, 100, 12000 },
+        { 5001,  99, 12000 },
+        { 5300, 100, 11000 }, /** Escaped deltas */
+        { 5299, _EOF, 0xffff },
+    };
+    protocol_sample_t out[4];
+    uint32_t timestamp, count = 4;
+    uint16_t interval;
+    uint32_t len = protocol_create_sample_batch(f, g_max_frame_size, 0x12345678, 20, in, 4);
     if (len == 0) {
         if (!g_expecting_failure) {
             printf(" %s: frame creation failed\n", test_name);
@@ -347,11 +337,44 @@ static bool test_power_enable(char *test_name)
         return false;
     }
     EXTRACT_PAYLOAD();
-    if (!protocol_unpack_power_enable(f, res, &out)) {
+    if (!protocol_unpack_sample_batch(f, res, &timestamp, &interval, out, &count)) {
         printf("%s: unpack response failed\n", test_name);
         return false;
     }
-    COMPARE(1, in, out);
+    COMPARE(1, 0x12345678, timestamp);
+    COMPARE(2, 20, interval);
+    COMPARE(3, 4, count);
+    for (uint32_t i = 0; i < 4; i++) {
+        COMPARE(4, in[i].v_out, out[i].v_out);
+        COMPARE(5, in[i].i_out, out[i].i_out);
+        COMPARE(6, in[i].v_in, out[i].v_in);
+    }
+    return true;
+}
+
+static bool test_change_event(char *test_name)
+{
+    uint8_t frame[FRAME_OVERHEAD(MAX_FRAME_SIZE)], *f = (uint8_t*) frame;
+    /** All fields but V_out, with escaped bytes */
+    uint8_t changed_out, changed_in = ((1 << notify_max_field) - 1) & ~(1 << notify_v_out);
+    uint16_t out[NOTIFY_MAX_VALUES] = { 0 };
+    uint16_t in[NOTIFY_MAX_VALUES] = { 1, _SOF, NOTIFY_LOCK_TEMPERATURE, 5000, 0x7d7e, 0x1234, 0xffff, 12000 };
+    uint32_t len = protocol_create_change_event(f, g_max_frame_size, changed_in, in);
+    if (len == 0) {
+        if (!g_expecting_failure) {
+            printf(" %s: frame creation failed\n", test_name);
+        }
+        return false;
+    }
+    EXTRACT_PAYLOAD();
+    if (!protocol_unpack_change_event(f, res, &changed_out, out)) {
+        printf("%s: unpack response failed\n", test_name);
+        return false;
+    }
+    COMPARE(1, changed_in, changed_out);
+    for (uint32_t i = 0; i < NOTIFY_MAX_VALUES; i++) {
+        COMPARE(2, i == NOTIFY_VALUE(notify_v_out) ? 0 : in[i], out[i]);
+    }
     return true;
 }
 
@@ -359,7 +382,7 @@ static bool test_power_enable(char *test_name)
 static void crc_escape_test(void)
 {
     uint8_t frame_buffer[32];
-    uint32_t len = protocol_create_status_response(frame_buffer, sizeof(frame_buffer), 7750, 5000, 0, 0, 250, 0);
+    uint32_t len = protocol_create_query_response(frame_buffer, sizeof(frame_buffer), 7750, 5000, 0, 0, 250, 0);
     int32_t res = uframe_extract_payload(frame_buffer, len);
     printf(" crc_escape_test ");
     if (res > 0) {
@@ -371,6 +394,75 @@ static void crc_escape_test(void)
     }
 }
 
+/** The upgrade_grant_test cases, what the host asks for and what the
+  * bootloader grants at that rate */
+typedef struct {
+    uint32_t baud;
+    upgrade_grant_t ask;
+    upgrade_grant_t grant;
+} grant_case_t;
+
+static const grant_case_t g_grant_cases[] = {
+    /** dpsctl's first start and the legacy upgrade */
+    { 115200, { 1024, 0, 0, false }, { 1024, 0, 0, true } },
+    { 921600, { 1024, 0, 0, false }, { 1024, 0, 0, false } },
+    /** dpsctl's start with a manifest, and then with LZ */
+    { 115200, { UPGRADE_MAX_CHUNK_SIZE, UPGRADE_MAX_WINDOW, UPGRADE_FLAG_MANIFEST, false }, { 1024, UPGRADE_MAX_WINDOW, UPGRADE_FLAG_MANIFEST, true } },
+    { 921600, { UPGRADE_MAX_CHUNK_SIZE, UPGRADE_MAX_WINDOW, UPGRADE_FLAG_MANIFEST, false }, { 1024, 1, UPGRADE_FLAG_MANIFEST, false } },
+    { 115200, { 1024, UPGRADE_MAX_WINDOW, UPGRADE_FLAG_LZ, false }, { UPGRADE_PIPELINE_CHUNK_SIZE, 2, UPGRADE_FLAG_LZ, true } },
+    { 921600, { 1024, UPGRADE_MAX_WINDOW, UPGRADE_FLAG_LZ, false }, { UPGRADE_PIPELINE_CHUNK_SIZE, 2, UPGRADE_FLAG_LZ, true } },
+    /** The staged upgrade of the wifi proxy */
+    { 921600, { STAGE_MAX_CHUNK_SIZE, UPGRADE_MAX_WINDOW, 0, false }, { UPGRADE_PIPELINE_CHUNK_SIZE, 2, 0, true } },
+    /** Out of range requests */
+    { 115200, { 4096, 9, 0xff, false }, { UPGRADE_PIPELINE_CHUNK_SIZE, 2, UPGRADE_FLAG_LZ, true } },
+};
+
+/** Check the grants of the bootloader with the RX ring of dpsboot, and that
+  * an early ack never lets the host overrun the ring at any rate */
+static void upgrade_grant_test(void)
+{
+    const uint32_t rates[] = { 115200, 230400, 460800, 921600 };
+    const uint32_t room = RX_DMA_BUF_SIZE - 1;
+    bool pass = true;
+    for (uint32_t i = 0; i < sizeof(g_grant_cases) / sizeof(g_grant_cases[0]); i++) {
+        const grant_case_t *c = &g_grant_cases[i];
+        upgrade_grant_t grant = c->ask;
+        protocol_upgrade_grant(&grant, c->baud, room);
+        if (grant.chunk_size != c->grant.chunk_size || grant.window != c->grant.window ||
+            grant.flags != c->grant.flags || grant.ack_early != c->grant.ack_early) {
+            printf(" case %u granted chunk %u window %u flags %u ack early %u\n", i, grant.chunk_size, grant.window, grant.flags, grant.ack_early);
+            pass = false;
+        }
+    }
+    for (uint32_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+        for (uint32_t chunk = 256; chunk <= UPGRADE_MAX_CHUNK_SIZE; chunk += 256) {
+            for (uint32_t window = 0; window <= UPGRADE_MAX_WINDOW; window++) {
+                for (uint32_t flags = 0; flags <= (UPGRADE_FLAG_LZ | UPGRADE_FLAG_MANIFEST); flags++) {
+                    upgrade_grant_t grant = { chunk, window, flags, false };
+                    protocol_upgrade_grant(&grant, rates[r], room);
+                    uint32_t pages = (grant.chunk_size + UPGRADE_PAGE_SIZE - 1) / UPGRADE_PAGE_SIZE;
+                    uint32_t arrival = (uint64_t) rates[r] / 10 * pages * UPGRADE_PAGE_PROGRAM_US / 1000000;
+                    /** The next packet, or the window, fits unless the chunk is programmed in time */
+                    uint32_t in_flight = (window ? grant.window : 1) * UPGRADE_DATA_FRAME_SIZE(grant.chunk_size);
+                    bool timed = !(grant.flags & UPGRADE_FLAG_LZ) && arrival <= room;
+                    if ((grant.ack_early && !timed && in_flight > room) || (window && !grant.window)) {
+                        printf(" %u baud chunk %u window %u flags %u overruns the ring\n", rates[r], chunk, window, flags);
+                        pass = false;
+                    }
+                }
+            }
+        }
+    }
+    printf(" upgrade_grant_test ");
+    if (pass) {
+        printf("pass\n");
+        g_num_pass++;
+    } else {
+        printf("fail\n");
+        g_num_fail++;
+    }
+}
+
 int main(int argc, char const *argv[])
 {
     uint8_t f1[] = {0x40};
@@ -394,14 +486,14 @@ int main(int argc, char const *argv[])
     RUN_PROTOCOL_TEST(test_small_frame);
     RUN_PROTOCOL_TEST(test_ping);
     RUN_PROTOCOL_TEST(test_response);
-    RUN_PROTOCOL_TEST(test_vout);
-    RUN_PROTOCOL_TEST(test_ilimit);
     RUN_PROTOCOL_TEST(test_status);
     RUN_PROTOCOL_TEST(test_status_response);
     RUN_PROTOCOL_TEST(test_wifi);
     RUN_PROTOCOL_TEST(test_lock);
     RUN_PROTOCOL_TEST(test_ocp);
-    RUN_PROTOCOL_TEST(test_power_enable);
+    RUN_PROTOCOL_TEST(test_protection_event);
+    RUN_PROTOCOL_TEST(test_sample_batch);
+    RUN_PROTOCOL_TEST(test_change_event);
 
 
     g_max_frame_size = 2;
@@ -409,15 +501,17 @@ int main(int argc, char const *argv[])
     RUN_PROTOCOL_TEST(test_small_frame);
     RUN_PROTOCOL_TEST(test_ping);
     RUN_PROTOCOL_TEST(test_response);
-    RUN_PROTOCOL_TEST(test_vout);
-    RUN_PROTOCOL_TEST(test_ilimit);
     RUN_PROTOCOL_TEST(test_status);
     RUN_PROTOCOL_TEST(test_status_response);
     RUN_PROTOCOL_TEST(test_wifi);
     RUN_PROTOCOL_TEST(test_lock);
     RUN_PROTOCOL_TEST(test_ocp);
+    RUN_PROTOCOL_TEST(test_protection_event);
+    RUN_PROTOCOL_TEST(test_sample_batch);
+    RUN_PROTOCOL_TEST(test_change_event);
 
     crc_escape_test();
+    upgrade_grant_test();
 
     printf("\n");
     if (g_num_fail == 0) {
@@ -37,18 +37,89 @@
 #include "hw.h"
 #include "tft.h"
 #include "ili9163c.h"
-#include "font-18.h"
-#include "font-24.h"
-#include "font-48.h"
+#include "ili9163c_settings.h"
+#include "font.h"
 #include "dbg_printf.h"
+#ifdef CONFIG_MIRROR
+#include "mirror.h"
+#endif // CONFIG_MIRROR
 
 static bool is_inverted;
 
-/** Buffers for speeding up drawing */
-static uint16_t blit_buffer[20*35]; // 20x35 pixels
-static uint16_t black_buffer[20*35]; // 20x35 pixels
+#ifdef CONFIG_TFT_TILES
+/** Frames are rendered off-screen one band of display rows at a time. The
+    damaged areas of a band are packed into the tile buffer and each is
+    pushed with a single DMA transfer while the next one is being rendered */
+#ifndef CONFIG_TFT_TILE_ROWS
+ #define CONFIG_TFT_TILE_ROWS  (8)
+#endif
+#define TILE_PIXELS  (_TFTWIDTH * CONFIG_TFT_TILE_ROWS)
+static uint16_t tile_buffer[TILE_PIXELS];
+/** One bit per pixel of the band, set where some operation draws */
+static uint8_t tile_coverage[TILE_PIXELS / 8];
+
+/** Maximum number of drawing operations collected in a frame before the
+    compositor flushes early */
+#define TFT_MAX_OPS  (32)
+#else // CONFIG_TFT_TILES
+/** Packed images are expanded into two buffers alternately, one being
+    filled while the other is pushed by the SPI DMA */
+#define EXPAND_PIXELS  (256)
+static uint16_t expand_buffer[2][EXPAND_PIXELS];
+static volatile bool expand_busy[2];
+
+/** Maximum number of drawing operations collected in a frame before the
+    compositor flushes early */
+#define TFT_MAX_OPS  (16)
+#endif // CONFIG_TFT_TILES
+
+typedef enum {
+    op_blit = 0,
+    op_blit_packed,
+    op_fill,
+    op_pattern,
+    op_text
+} tft_op_type_t;
+
+/** Characters of a string drawn by one operation, longer strings are split
+    into runs of this many */
+#define TFT_TEXT_RUN  (16)
+/** The arg of op_text, the font size, the number of characters of the run
+    and whether it is inverted */
+#define TEXT_ARG(size, len, invert)  ((size) | ((len) << 8) | ((invert) ? 0x10000 : 0))
+#define TEXT_SIZE(arg)    ((arg) & 0xff)
+#define TEXT_LEN(arg)     (((arg) >> 8) & 0xff)
+#define TEXT_INVERT(arg)  ((arg) & 0x10000 ? 0xffff : 0)
+
+/** A drawing operation deferred until the end of the frame */
+typedef struct {
+    tft_op_type_t type;
+    bool dropped;
+    int16_t x, y, w, h;
+    const uint8_t *data;    // Bitmap for op_blit(_packed), pattern for op_pattern, string for op_text
+    const uint8_t *palette; // Palette for op_blit_packed
+    uint32_t arg;           // Color for op_fill, pattern size for op_pattern, inversion mask for op_blit_packed, TEXT_ARG() for op_text
+} tft_op_t;
+
+/** State for walking the runs of a packed image */
+typedef struct {
+    const uint8_t *rle;
+    const uint8_t *palette;
+    uint32_t run;
+    uint16_t color;
+    uint16_t mask;
+} unpack_t;
+
+static tft_op_t ops[TFT_MAX_OPS];
+static uint32_t num_ops;
+static uint32_t frame_depth;
 
 static void frame_glyph(uint32_t xpos, uint32_t ypos, uint32_t glyph_height, uint32_t glyph_width, uint16_t color);
+static void queue_op(tft_op_type_t type, int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *data, const uint8_t *palette, uint32_t arg);
+static void flush_ops(void);
+#ifdef CONFIG_TFT_TILES
+static void flush_tiles(void);
+#endif // CONFIG_TFT_TILES
 
 
 /**
@@ -68,7 +139,32 @@ void tft_init(void)
   */
 void tft_clear(void)
 {
+    // Anything queued would be overwritten anyway
+    num_ops = 0;
     ili9163c_fill_screen(BLACK);
+#ifdef CONFIG_MIRROR
+    mirror_clear();
+#endif // CONFIG_MIRROR
+}
+
+/**
+  * @brief Start collecting drawing operations, frames may be nested
+  * @retval none
+  */
+void tft_frame_begin(void)
+{
+    frame_depth++;
+}
+
+/**
+  * @brief End a frame, the outermost frame flushes the collected operations
+  * @retval none
+  */
+void tft_frame_end(void)
+{
+    if (frame_depth > 0 && --frame_depth == 0) {
+        flush_ops();
+    }
 }
 
 /**
@@ -78,13 +174,34 @@ void tft_clear(void)
   * @param height of data
   * @param x x position
   * @param y y position
+  * @note The transfer is queued, bits must remain valid until the SPI driver is idle
   * @retval none
   */
 void tft_blit(uint16_t *bits, uint32_t width, uint32_t height, uint32_t x, uint32_t y)
 {
-    ili9163c_set_window(x, y, x + width-1, y + height-1);
-    gpio_set(TFT_A0_PORT, TFT_A0_PIN);
-    (void) spi_dma_transceive((uint8_t*) bits, 2*width*height, 0, 0);
+#ifdef CONFIG_MIRROR
+    mirror_blit(x, y, width, height);
+#endif // CONFIG_MIRROR
+    queue_op(op_blit, x, y, width, height, (const uint8_t*) bits, 0, 0);
+}
+
+/**
+  * @brief Blit palette packed graphics on TFT, see pack565.py
+  * @param data run length encoded palette indices
+  * @param palette 16 colors in bgr565 format
+  * @param width width of data
+  * @param height of data
+  * @param x x position
+  * @param y y position
+  * @param invert if true, the colors will be inverted
+  * @retval none
+  */
+void tft_blit_packed(const uint8_t *data, const uint8_t *palette, uint32_t width, uint32_t height, uint32_t x, uint32_t y, bool invert)
+{
+#ifdef CONFIG_MIRROR
+    mirror_blit(x, y, width, height);
+#endif // CONFIG_MIRROR
+    queue_op(op_blit_packed, x, y, width, height, data, palette, invert ? 0xff : 0);
 }
 
 /**
@@ -100,64 +217,23 @@ void tft_blit(uint16_t *bits, uint32_t width, uint32_t height, uint32_t x, uint3
   */
 void tft_putch(uint8_t size, char ch, uint32_t x, uint32_t y, uint32_t w, uint32_t h, bool highlight)
 {
-    uint32_t glyph_index, glyph_width, glyph_height, glyph_size;
+    uint32_t glyph_width, glyph_height;
     uint32_t xpos, ypos;
-    uint16_t *glyph;
-    switch(ch) {
-        case '0': case '1': case '2': case '3': case '4':
-        case '5': case '6': case '7': case '8': case '9':
-            glyph_index = ch - '0';
-            break;
-        case '.':
-            glyph_index = 10;
-            break;
-        case 'V':
-            glyph_index = 11;
-            break;
-        case 'A':
-            glyph_index = 12;
-            break;
-        default:
-            dbg_printf("Cannot print character '%c'\n", ch);
-            return;
-    }
-    switch(size) {
-        case 18:
-            glyph_width = font_18_widths[glyph_index];
-            glyph = (uint16_t*) font_18_pix[glyph_index];
-            glyph_size = font_18_sizes[glyph_index];
-            glyph_height = font_18_height;
-            break;
-        case 24:
-            glyph_width = font_24_widths[glyph_index];
-            glyph = (uint16_t*) font_24_pix[glyph_index];
-            glyph_size = font_24_sizes[glyph_index];
-            glyph_height = font_24_height;
-            break;
-        case 48:
-            glyph_width = font_48_widths[glyph_index];
-            glyph = (uint16_t*) font_48_pix[glyph_index];
-            glyph_size = font_48_sizes[glyph_index];
-            glyph_height = font_48_height;
-            break;
-        default:
-            dbg_printf("Cannot print at size %d\n", (int) size);
-            return;
+    const uint8_t *glyph, *palette;
+    const font_t *font = font_get(size);
+    if (!font) {
+        dbg_printf("Cannot print at size %d\n", (int) size);
+        return;
     }
-
-    if (highlight) {
-        uint32_t *p = (uint32_t*) &blit_buffer;
-        /** @todo Perform memcpy and inversion operation */
-        memcpy(blit_buffer, glyph, glyph_size);
-        uint32_t i;
-        for (i = 0; i < glyph_size/4; i++) { // Invert 32 bits in each go
-            p[i] = ~p[i];
-        }
-        if (glyph_size % 4) { // Bits remaining?
-            blit_buffer[2*i] = ~blit_buffer[2*i];
-        }
-        glyph = blit_buffer;
+    int32_t glyph_index = font_glyph(font, ch);
+    if (glyph_index < 0) {
+        dbg_printf("Cannot print character '%c'\n", ch);
+        return;
     }
+    glyph_width = font->widths[glyph_index];
+    glyph = font->pix[glyph_index];
+    palette = font->palette;
+    glyph_height = font->height;
 
     if (w < glyph_width) {
         w = glyph_width + 2;
@@ -168,16 +244,26 @@ void tft_putch(uint8_t size, char ch, uint32_t x, uint32_t y, uint32_t w, uint32
     xpos = x+(w-glyph_width)/2;
     ypos = y+(h-glyph_height)/2;
 
-    ili9163c_set_window(xpos, ypos, xpos + glyph_width-1, ypos + glyph_height-1);
-    gpio_set(TFT_A0_PORT, TFT_A0_PIN);
-    (void) spi_dma_transceive((uint8_t*) glyph, 2 * glyph_width * glyph_height, 0, 0);
+#ifdef CONFIG_MIRROR
+    mirror_glyph(size, ch, x, y, w, h, highlight);
+    mirror_mute(true);
+#endif // CONFIG_MIRROR
+    tft_frame_begin();
+#ifdef CONFIG_TFT_TILES
+    // Clearing the whole box is free off-screen and lets the box go out as
+    // one area per band
+    tft_fill(x, y, w+1, h, BLACK);
+    tft_blit_packed(glyph, palette, glyph_width, glyph_height, xpos, ypos, highlight);
+#else // CONFIG_TFT_TILES
+    tft_blit_packed(glyph, palette, glyph_width, glyph_height, xpos, ypos, highlight);
 
     if (x < xpos) {
-        tft_fill_pattern(x, y, xpos-1, y+h-1, (uint8_t*) black_buffer, sizeof(black_buffer));
+        tft_fill(x, y, xpos-x, h, BLACK);
     }
     if (xpos+glyph_width < x+w) {
-        tft_fill_pattern(xpos+glyph_width, y, x+w, y+h-1, (uint8_t*) black_buffer, sizeof(black_buffer));
+        tft_fill(xpos+glyph_width, y, x+w-(xpos+glyph_width)+1, h, BLACK);
     }
+#endif // CONFIG_TFT_TILES
 
     if (highlight) {
         // Add some more highlighting around the glyph
@@ -186,6 +272,50 @@ void tft_putch(uint8_t size, char ch, uint32_t x, uint32_t y, uint32_t w, uint32
         // If not highlighted, make sure to erase the highlight (small font will never get highlighted)
         frame_glyph(xpos, ypos, glyph_height, glyph_width, BLACK);
     }
+    tft_frame_end();
+#ifdef CONFIG_MIRROR
+    mirror_mute(false);
+#endif // CONFIG_MIRROR
+}
+
+/**
+  * @brief Draw a string on TFT, characters the font lacks are skipped
+  * @param size size of the font, see font_get()
+  * @param str the string
+  * @param x x position
+  * @param y y position
+  * @param highlight if true, the string will be inverted
+  * @note The string is read when the frame is flushed and must remain
+  *       valid until then
+  * @retval width of the string in pixels, see font_text_width()
+  */
+uint32_t tft_puts(uint8_t size, const char *str, uint32_t x, uint32_t y, bool highlight)
+{
+    const font_t *font = font_get(size);
+    uint32_t width = 0;
+    if (!font) {
+        dbg_printf("Cannot print at size %d\n", (int) size);
+        return 0;
+    }
+    tft_frame_begin();
+    while (*str) {
+        // One operation per run, each pushed in a single window
+        uint32_t len = 0, run_width = 0;
+        for (; str[len] && len < TFT_TEXT_RUN; len++) {
+            int32_t glyph = font_glyph(font, str[len]);
+            if (glyph >= 0) {
+#ifdef CONFIG_MIRROR
+                mirror_glyph(size, str[len], x + width + run_width, y, font->advances[glyph], font->height, highlight);
+#endif // CONFIG_MIRROR
+                run_width += font->advances[glyph];
+            }
+        }
+        queue_op(op_text, x + width, y, run_width, font->height, (const uint8_t*) str, 0, TEXT_ARG(size, len, highlight));
+        width += run_width;
+        str += len;
+    }
+    tft_frame_end();
+    return width;
 }
 
 /**
@@ -194,18 +324,17 @@ void tft_putch(uint8_t size, char ch, uint32_t x, uint32_t y, uint32_t w, uint32
   * @param x2,y2 bottom right corner
   * @param fill buffer to fill from (needs not match the described area)
   * @param fill_size size of buffer
+  * @note The transfers are queued, fill must remain valid until the frame is
+  *       flushed and the SPI driver is idle
   * @retval none
   */
 void tft_fill_pattern(uint32_t x1, uint32_t y1, uint32_t x2, uint32_t y2, uint8_t *fill, uint32_t fill_size)
 {
-    uint32_t count = 2*(x2-x1+1)*(y2-y1+1);
-    ili9163c_set_window(x1, y1, x2, y2);
-    gpio_set(TFT_A0_PORT, TFT_A0_PIN);
-    while(count) {
-        uint32_t c = count < fill_size ? count : fill_size;
-        (void) spi_dma_transceive((uint8_t*) fill, c, 0, 0);
-        count -= c;
-    }
+#ifdef CONFIG_MIRROR
+    /** Patterns are solid colors in practice */
+    mirror_fill(x1, y1, x2-x1+1, y2-y1+1, fill_size >= 2 ? (fill[0] << 8) | fill[1] : 0);
+#endif // CONFIG_MIRROR
+    queue_op(op_pattern, x1, y1, x2-x1+1, y2-y1+1, fill, 0, fill_size);
 }
 
 /**
@@ -218,17 +347,10 @@ void tft_fill_pattern(uint32_t x1, uint32_t y1, uint32_t x2, uint32_t y2, uint8_
   */
 void tft_fill(uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint16_t color)
 {
-    uint8_t hi = color >> 8;
-    uint8_t lo = color && 0xff;
-    int32_t count = 2 * w * h;
-    uint8_t fill[] = {hi, lo, hi, lo, hi, lo, hi, lo, hi, lo, hi, lo, hi, lo, hi, lo, hi, lo, hi, lo, hi, lo, hi, lo, hi, lo, hi, lo, hi, lo, hi, lo};
-    ili9163c_set_window(x, y, x+w-1, y+h-1);
-    gpio_set(TFT_A0_PORT, TFT_A0_PIN);
-    while (count > 0) {
-        uint32_t len = (uint32_t) count > sizeof(fill) ? sizeof(fill) : (uint32_t) count;
-        (void) spi_dma_transceive((uint8_t*) fill, len, 0, 0);
-        count -= sizeof(fill);
-    }
+#ifdef CONFIG_MIRROR
+    mirror_fill(x, y, w, h, color);
+#endif // CONFIG_MIRROR
+    queue_op(op_fill, x, y, w, h, 0, 0, color);
 }
 
 /**
@@ -240,6 +362,9 @@ void tft_invert(bool invert)
 {
     ili9163c_invert_display(invert);
     is_inverted = invert;
+#ifdef CONFIG_MIRROR
+    mirror_invert(invert);
+#endif // CONFIG_MIRROR
 }
 
 /**
@@ -262,13 +387,568 @@ bool tft_is_inverted(void)
   */
 static void frame_glyph(uint32_t xpos, uint32_t ypos, uint32_t glyph_height, uint32_t glyph_width, uint16_t color)
 {
-    for (uint32_t i = xpos; i < xpos + glyph_width; i++) {
-        ili9163c_draw_pixel(i, ypos-1, color);
-        ili9163c_draw_pixel(i, ypos + glyph_height, color);
+    tft_fill(xpos, ypos-1, glyph_width, 1, color);
+    tft_fill(xpos, ypos + glyph_height, glyph_width, 1, color);
+    tft_fill(xpos-1, ypos, 1, glyph_height, color);
+    tft_fill(xpos + glyph_width, ypos, 1, glyph_height, color);
+}
+
+/** Walking the runs of packed images, see pack565.py */
+static void unpack_init(unpack_t *u, const uint8_t *rle, const uint8_t *palette, uint16_t mask)
+{
+    u->rle = rle;
+    u->palette = palette;
+    u->run = 0;
+    u->mask = mask;
+}
+
+static void unpack_next(unpack_t *u)
+{
+    const uint8_t *c = &u->palette[2 * (*u->rle & 0x0f)];
+    u->run = (*u->rle++ >> 4) + 1;
+    u->color = ((c[0] << 8) | c[1]) ^ u->mask;
+}
+
+static void unpack_skip(unpack_t *u, uint32_t n)
+{
+    while (n) {
+        if (!u->run) {
+            unpack_next(u);
+        }
+        uint32_t k = u->run < n ? u->run : n;
+        u->run -= k;
+        n -= k;
+    }
+}
+
+static void unpack_read(unpack_t *u, uint16_t *p, uint32_t n)
+{
+    while (n) {
+        if (!u->run) {
+            unpack_next(u);
+        }
+        uint32_t k = u->run < n ? u->run : n;
+        u->run -= k;
+        n -= k;
+        while (k--) {
+            *p++ = u->color;
+        }
+    }
+}
+
+#ifndef CONFIG_TFT_TILES
+/** The expansion buffer being filled and the pixels in it */
+static uint32_t expand_cur;
+static uint32_t expand_fill;
+
+/**
+  * @brief SPI completion callback releasing an expansion buffer
+  * @param arg the busy flag of the buffer
+  * @retval none
+  */
+static void expand_done(void *arg)
+{
+    *(volatile bool*) arg = false;
+}
+
+/**
+  * @brief Get room in the expansion buffer being filled, waiting for the
+  *        DMA to release it
+  * @param n pixels wanted, clipped to the room left on return
+  * @retval where to write them
+  */
+static uint16_t *expand_space(uint32_t *n)
+{
+    while (expand_busy[expand_cur]) ;
+    if (*n > EXPAND_PIXELS - expand_fill) {
+        *n = EXPAND_PIXELS - expand_fill;
     }
-    for (uint32_t i = ypos; i < ypos + glyph_height; i++) {
-        ili9163c_draw_pixel(xpos-1, i, color);
-        ili9163c_draw_pixel(xpos + glyph_width, i, color);
+    return &expand_buffer[expand_cur][expand_fill];
+}
+
+/**
+  * @brief Push the pixels of the expansion buffer being filled and switch
+  *        to the other one
+  * @retval none
+  */
+static void expand_push(void)
+{
+    if (!expand_fill) {
+        return;
+    }
+    expand_busy[expand_cur] = true;
+    // Sent as 16 bit frames, halving the number of DMA cycles
+    if (!spi_dma_transmit16_async(expand_buffer[expand_cur], expand_fill, &expand_done, (void*) &expand_busy[expand_cur])) {
+        expand_busy[expand_cur] = false;
+    }
+    expand_cur ^= 1;
+    expand_fill = 0;
+}
+
+/**
+  * @brief Account for pixels written to the room given by expand_space(),
+  *        pushing the buffer when it is full
+  * @param n number of pixels
+  * @retval none
+  */
+static void expand_commit(uint32_t n)
+{
+    expand_fill += n;
+    if (expand_fill == EXPAND_PIXELS) {
+        expand_push();
+    }
+}
+
+/**
+  * @brief Expand a packed image and push it to the display
+  * @param op the operation
+  * @retval none
+  */
+static void expand_packed(tft_op_t *op)
+{
+    uint32_t pixels = op->w * op->h;
+    unpack_t u;
+    unpack_init(&u, op->data, op->palette, op->arg ? 0xffff : 0);
+    while (pixels) {
+        uint32_t n = pixels;
+        uint16_t *p = expand_space(&n);
+        unpack_read(&u, p, n);
+        expand_commit(n);
+        pixels -= n;
+    }
+    expand_push();
+}
+
+/**
+  * @brief Expand a string and push it to the display, row by row through
+  *        the glyphs so the string goes out in the window of the operation
+  * @param op the operation
+  * @retval none
+  */
+static void expand_text(tft_op_t *op)
+{
+    const font_t *font = font_get(TEXT_SIZE(op->arg));
+    uint16_t mask = TEXT_INVERT(op->arg);
+    unpack_t u[TFT_TEXT_RUN];
+    uint8_t glyphs[TFT_TEXT_RUN];
+    uint32_t num_glyphs = 0;
+    for (uint32_t i = 0; i < TEXT_LEN(op->arg); i++) {
+        int32_t glyph = font_glyph(font, op->data[i]);
+        if (glyph >= 0) {
+            glyphs[num_glyphs] = glyph;
+            unpack_init(&u[num_glyphs++], font->pix[glyph], font->palette, mask);
+        }
+    }
+    for (int16_t y = 0; y < op->h; y++) {
+        for (uint32_t i = 0; i < num_glyphs; i++) {
+            uint32_t width = font->widths[glyphs[i]];
+            uint32_t gap = font->advances[glyphs[i]] - width;
+            while (width) {
+                uint32_t n = width;
+                uint16_t *p = expand_space(&n);
+                unpack_read(&u[i], p, n);
+                expand_commit(n);
+                width -= n;
+            }
+            while (gap) {
+                uint32_t n = gap;
+                uint16_t *p = expand_space(&n);
+                for (uint32_t k = 0; k < n; k++) {
+                    p[k] = BLACK ^ mask;
+                }
+                expand_commit(n);
+                gap -= n;
+            }
+        }
+    }
+    expand_push();
+}
+
+/**
+  * @brief Push an operation to the display
+  * @param op the operation
+  * @retval none
+  */
+static void execute_op(tft_op_t *op)
+{
+    uint32_t count = 2 * op->w * op->h;
+    const uint8_t *data = op->data;
+    uint32_t size = op->arg;
+    // Leaves A0 in data mode once the window commands are out
+    ili9163c_set_window(op->x, op->y, op->x + op->w-1, op->y + op->h-1);
+    if (op->type == op_blit_packed) {
+        expand_packed(op);
+        return;
+    } else if (op->type == op_text) {
+        expand_text(op);
+        return;
+    } else if (op->type == op_fill) {
+        // The color is repeated by the DMA from a fixed address, 2 bytes per count
+        data = 0;
+        size = 2 * 0xffff;
+    } else if (op->type == op_blit) {
+        size = count;
+    }
+    while (count) {
+        uint32_t c = count < size ? count : size;
+        if (op->type == op_fill) {
+            (void) spi_dma_fill_async(op->arg, c / 2, 0, 0);
+        } else {
+            (void) spi_dma_transceive_async((uint8_t*) data, c, 0, 0, 0, 0);
+        }
+        count -= c;
+    }
+}
+#endif // CONFIG_TFT_TILES
+
+/** Rectangle helpers, rectangles are given by the ops */
+static bool rect_contains(const tft_op_t *outer, const tft_op_t *inner)
+{
+    return inner->x >= outer->x && inner->y >= outer->y &&
+           inner->x + inner->w <= outer->x + outer->w &&
+           inner->y + inner->h <= outer->y + outer->h;
+}
+
+static bool rect_intersects(const tft_op_t *a, const tft_op_t *b)
+{
+    return a->x < b->x + b->w && b->x < a->x + a->w &&
+           a->y < b->y + b->h && b->y < a->y + a->h;
+}
+
+/**
+  * @brief Check if the union of two rectangles is a rectangle and if so
+  *        grow a to cover it
+  * @retval true if a was grown
+  */
+static bool rect_merge(tft_op_t *a, const tft_op_t *b)
+{
+    if (rect_contains(a, b)) {
+        return true;
+    }
+    if (a->y == b->y && a->h == b->h && a->x <= b->x + b->w && b->x <= a->x + a->w) {
+        int16_t x2 = a->x + a->w > b->x + b->w ? a->x + a->w : b->x + b->w;
+        a->x = a->x < b->x ? a->x : b->x;
+        a->w = x2 - a->x;
+        return true;
+    }
+    if (a->x == b->x && a->w == b->w && a->y <= b->y + b->h && b->y <= a->y + a->h) {
+        int16_t y2 = a->y + a->h > b->y + b->h ? a->y + a->h : b->y + b->h;
+        a->y = a->y < b->y ? a->y : b->y;
+        a->h = y2 - a->y;
+        return true;
+    }
+    return false;
+}
+
+/**
+  * @brief Record a drawing operation, or execute it right away when outside
+  *        of a frame
+  * @retval none
+  */
+static void queue_op(tft_op_type_t type, int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *data, const uint8_t *palette, uint32_t arg)
+{
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    if (num_ops == TFT_MAX_OPS) {
+        flush_ops();
+    }
+    tft_op_t *op = &ops[num_ops++];
+    op->type = type;
+    op->dropped = false;
+    op->x = x;
+    op->y = y;
+    op->w = w;
+    op->h = h;
+    op->data = data;
+    op->palette = palette;
+    op->arg = arg;
+    if (!frame_depth) {
+        flush_ops();
+    }
+}
+
+#ifdef CONFIG_TFT_TILES
+/** An area of a band */
+typedef struct {
+    int16_t x, y, w, h;
+} tile_rect_t;
+
+static tile_rect_t tile_rects[TFT_MAX_OPS];
+/** Position in the tile buffer where the next area is rendered, everything
+    from here to the end of the buffer has been sent */
+static uint32_t tile_offset;
+
+/**
+  * @brief Mark the pixels of an area as drawn in the coverage map
+  * @param r the area
+  * @param band first display row of the band
+  * @retval none
+  */
+static void coverage_set(const tile_rect_t *r, int16_t band)
+{
+    for (int16_t y = r->y; y < r->y + r->h; y++) {
+        uint32_t bit = (y - band) * _TFTWIDTH + r->x;
+        for (int16_t i = 0; i < r->w; i++, bit++) {
+            tile_coverage[bit / 8] |= 1 << (bit % 8);
+        }
+    }
+}
+
+/**
+  * @brief Check if all pixels of an area are drawn by the frame
+  * @param r the area
+  * @param band first display row of the band
+  * @retval true if completely covered
+  */
+static bool coverage_full(const tile_rect_t *r, int16_t band)
+{
+    for (int16_t y = r->y; y < r->y + r->h; y++) {
+        uint32_t bit = (y - band) * _TFTWIDTH + r->x;
+        for (int16_t i = 0; i < r->w; i++, bit++) {
+            if (!(tile_coverage[bit / 8] & (1 << (bit % 8)))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+  * @brief Render the part of a string inside an area, glyph by glyph
+  * @param op the operation
+  * @param r the area
+  * @param dst pixels of the area, r->w pixels per row
+  * @param x1,y1,x2,y2 the part of the operation inside the area
+  * @retval none
+  */
+static void render_text(const tft_op_t *op, const tile_rect_t *r, uint16_t *dst, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+    const font_t *font = font_get(TEXT_SIZE(op->arg));
+    uint16_t mask = TEXT_INVERT(op->arg);
+    int16_t gx = op->x;
+    for (uint32_t i = 0; i < TEXT_LEN(op->arg) && gx < x2; i++) {
+        int32_t glyph = font_glyph(font, op->data[i]);
+        if (glyph < 0) {
+            continue;
+        }
+        int16_t width = font->widths[glyph];
+        int16_t advance = font->advances[glyph];
+        // The columns of the glyph, then the spacing after it
+        int16_t a = gx > x1 ? gx : x1;
+        int16_t b = gx + width < x2 ? gx + width : x2;
+        if (a < b) {
+            unpack_t u;
+            unpack_init(&u, font->pix[glyph], font->palette, mask);
+            unpack_skip(&u, (y1 - op->y) * width + (a - gx));
+            for (int16_t y = y1; y < y2; y++) {
+                unpack_read(&u, &dst[(y - r->y) * r->w + (a - r->x)], b - a);
+                if (y + 1 < y2) {
+                    unpack_skip(&u, width - (b - a));
+                }
+            }
+        }
+        a = gx + width > x1 ? gx + width : x1;
+        b = gx + advance < x2 ? gx + advance : x2;
+        for (int16_t y = y1; y < y2; y++) {
+            for (int16_t x = a; x < b; x++) {
+                dst[(y - r->y) * r->w + (x - r->x)] = BLACK ^ mask;
+            }
+        }
+        gx += advance;
+    }
+}
+
+/**
+  * @brief Render the part of an operation inside an area
+  * @param op the operation
+  * @param r the area
+  * @param dst pixels of the area, r->w pixels per row
+  * @retval none
+  */
+static void render_op(const tft_op_t *op, const tile_rect_t *r, uint16_t *dst)
+{
+    int16_t x1 = op->x > r->x ? op->x : r->x;
+    int16_t y1 = op->y > r->y ? op->y : r->y;
+    int16_t x2 = op->x + op->w < r->x + r->w ? op->x + op->w : r->x + r->w;
+    int16_t y2 = op->y + op->h < r->y + r->h ? op->y + op->h : r->y + r->h;
+    unpack_t u;
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+    uint32_t w = x2 - x1;
+    if (op->type == op_text) {
+        render_text(op, r, dst, x1, y1, x2, y2);
+        return;
+    } else if (op->type == op_blit_packed) {
+        unpack_init(&u, op->data, op->palette, op->arg ? 0xffff : 0);
+        unpack_skip(&u, (y1 - op->y) * op->w + (x1 - op->x));
+    }
+    for (int16_t y = y1; y < y2; y++) {
+        uint16_t *p = &dst[(y - r->y) * r->w + (x1 - r->x)];
+        // Index of the first pixel of the row in the operation
+        uint32_t k = (y - op->y) * op->w + (x1 - op->x);
+        switch (op->type) {
+            case op_fill:
+                for (uint32_t i = 0; i < w; i++) {
+                    p[i] = op->arg;
+                }
+                break;
+            case op_blit: {
+                const uint8_t *b = &op->data[2 * k];
+                for (uint32_t i = 0; i < w; i++, b += 2) {
+                    p[i] = (b[0] << 8) | b[1];
+                }
+                break;
+            }
+            case op_pattern: {
+                // The pattern repeats over the byte stream of the area
+                uint32_t o = (2 * k) % op->arg;
+                for (uint32_t i = 0; i < w; i++) {
+                    p[i] = op->data[o] << 8;
+                    o = o + 1 < op->arg ? o + 1 : 0;
+                    p[i] |= op->data[o];
+                    o = o + 1 < op->arg ? o + 1 : 0;
+                }
+                break;
+            }
+            case op_blit_packed:
+                unpack_read(&u, p, w);
+                if (y + 1 < y2) {
+                    unpack_skip(&u, op->w - w);
+                }
+                break;
+            case op_text:
+                // Rendered by render_text()
+                break;
+        }
+    }
+}
+
+/**
+  * @brief Render the frame band by band and push the damaged areas. Areas of
+  *        a band are grown to the bounding box of their neighbours when the
+  *        frame draws every pixel of it, so each area needs one window and
+  *        one DMA transfer.
+  * @retval none
+  */
+static void flush_tiles(void)
+{
+    int16_t top = _TFTHEIGHT, bottom = 0;
+    for (uint32_t i = 0; i < num_ops; i++) {
+        if (!ops[i].dropped) {
+            top = ops[i].y < top ? ops[i].y : top;
+            bottom = ops[i].y + ops[i].h > bottom ? ops[i].y + ops[i].h : bottom;
+        }
+    }
+    top = top < 0 ? 0 : top;
+    bottom = bottom > _TFTHEIGHT ? _TFTHEIGHT : bottom;
+
+    for (int16_t band = top - top % CONFIG_TFT_TILE_ROWS; band < bottom; band += CONFIG_TFT_TILE_ROWS) {
+        uint32_t n = 0;
+        bool merged;
+        memset(tile_coverage, 0, sizeof(tile_coverage));
+        for (uint32_t i = 0; i < num_ops; i++) {
+            tft_op_t *op = &ops[i];
+            int16_t x1 = op->x > 0 ? op->x : 0;
+            int16_t y1 = op->y > band ? op->y : band;
+            int16_t x2 = op->x + op->w < _TFTWIDTH ? op->x + op->w : _TFTWIDTH;
+            int16_t y2 = op->y + op->h < band + CONFIG_TFT_TILE_ROWS ? op->y + op->h : band + CONFIG_TFT_TILE_ROWS;
+            if (op->dropped || x1 >= x2 || y1 >= y2) {
+                continue;
+            }
+            tile_rect_t *r = &tile_rects[n++];
+            r->x = x1;
+            r->y = y1;
+            r->w = x2 - x1;
+            r->h = y2 - y1;
+            coverage_set(r, band);
+        }
+
+        do {
+            merged = false;
+            for (uint32_t i = 0; i < n && !merged; i++) {
+                for (uint32_t j = i + 1; j < n && !merged; j++) {
+                    tile_rect_t *a = &tile_rects[i], *b = &tile_rects[j];
+                    tile_rect_t u;
+                    u.x = a->x < b->x ? a->x : b->x;
+                    u.y = a->y < b->y ? a->y : b->y;
+                    u.w = (a->x + a->w > b->x + b->w ? a->x + a->w : b->x + b->w) - u.x;
+                    u.h = (a->y + a->h > b->y + b->h ? a->y + a->h : b->y + b->h) - u.y;
+                    if (coverage_full(&u, band)) {
+                        *a = u;
+                        *b = tile_rects[--n];
+                        merged = true;
+                    }
+                }
+            }
+        } while (merged);
+
+        for (uint32_t i = 0; i < n; i++) {
+            tile_rect_t *r = &tile_rects[i];
+            uint32_t pixels = r->w * r->h;
+            if (tile_offset + pixels > TILE_PIXELS) {
+                // Wrap around once the start of the buffer has been sent
+                spi_wait();
+                tile_offset = 0;
+            }
+            uint16_t *dst = &tile_buffer[tile_offset];
+            for (uint32_t j = 0; j < num_ops; j++) {
+                if (!ops[j].dropped) {
+                    render_op(&ops[j], r, dst);
+                }
+            }
+            ili9163c_set_window(r->x, r->y, r->x + r->w - 1, r->y + r->h - 1);
+            (void) spi_dma_transmit16_async(dst, pixels, 0, 0);
+            tile_offset += pixels;
+        }
+    }
+}
+#endif // CONFIG_TFT_TILES
+
+/**
+  * @brief Merge the damaged areas of the frame and push them to the display.
+  *        All operations are opaque so anything completely covered by a later
+  *        operation is dropped. A fill is merged into an earlier fill of the
+  *        same color when their union is a rectangle and nothing drawn in
+  *        between overlaps it.
+  * @retval none
+  */
+static void flush_ops(void)
+{
+    for (uint32_t j = 1; j < num_ops; j++) {
+        tft_op_t *op = &ops[j];
+        for (uint32_t i = 0; i < j; i++) {
+            if (!ops[i].dropped && rect_contains(op, &ops[i])) {
+                ops[i].dropped = true;
+            }
+        }
+        if (op->type != op_fill) {
+            continue;
+        }
+        for (int32_t i = j-1; i >= 0; i--) {
+            tft_op_t *prev = &ops[i];
+            if (prev->dropped) {
+                continue;
+            }
+            if (prev->type == op_fill && prev->arg == op->arg && rect_merge(prev, op)) {
+                op->dropped = true;
+                break;
+            }
+            if (rect_intersects(prev, op)) {
+                break;
+            }
+        }
+    }
+#ifdef CONFIG_TFT_TILES
+    flush_tiles();
+#else // CONFIG_TFT_TILES
+    for (uint32_t i = 0; i < num_ops; i++) {
+        if (!ops[i].dropped) {
+            execute_op(&ops[i]);
+        }
     }
+#endif // CONFIG_TFT_TILES
+    num_ops = 0;
 }
 
@@ -37,6 +37,18 @@ void tft_init(void);
   */
 void tft_clear(void);
 
+/**
+  * @brief Start collecting drawing operations, frames may be nested
+  * @retval none
+  */
+void tft_frame_begin(void);
+
+/**
+  * @brief End a frame, the outermost frame flushes the collected operations
+  * @retval none
+  */
+void tft_frame_end(void);
+
 /**
   * @brief Blit graphics on TFT
   * @param bits graphics in bgr565 format mathing the specified size
@@ -48,6 +60,19 @@ void tft_clear(void);
   */
 void tft_blit(uint16_t *bits, uint32_t width, uint32_t height, uint32_t x, uint32_t y);
 
+/**
+  * @brief Blit palette packed graphics on TFT, see pack565.py
+  * @param data run length encoded palette indices
+  * @param palette 16 colors in bgr565 format
+  * @param width width of data
+  * @param height of data
+  * @param x x position
+  * @param y y position
+  * @param invert if true, the colors will be inverted
+  * @retval none
+  */
+void tft_blit_packed(const uint8_t *data, const uint8_t *palette, uint32_t width, uint32_t height, uint32_t x, uint32_t y, bool invert);
+
 /**
   * @brief Blit character on TFT
   * @param size size of character (0:small 1:large)
@@ -61,6 +86,19 @@ void tft_blit(uint16_t *bits, uint32_t width, uint32_t height, uint32_t x, uint3
   */
 void tft_putch(uint8_t size, char ch, uint32_t x, uint32_t y, uint32_t w, uint32_t h, bool highlight);
 
+/**
+  * @brief Draw a string on TFT, characters the font lacks are skipped
+  * @param size size of the font, see font_get()
+  * @param str the string
+  * @param x x position
+  * @param y y position
+  * @param highlight if true, the string will be inverted
+  * @note The string is read when the frame is flushed and must remain
+  *       valid until then
+  * @retval width of the string in pixels, see font_text_width()
+  */
+uint32_t tft_puts(uint8_t size, const char *str, uint32_t x, uint32_t y, bool highlight);
+
 /**
   * @brief Fill area with specified pattern
   * @param x1,y1 top left corner
@@ -95,6 +133,9 @@ bool tft_is_inverted(void);
 
 #ifdef DPS_EMULATOR
 void emul_tft_draw(void);
+void emul_tft_enable(bool enable);
+void emul_tft_stats(void);
+void emul_tft_poll(void);
 #endif // DPS_EMULATOR
 
 #endif // __TFT_H__
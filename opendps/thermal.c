@@ -0,0 +1,200 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "thermal.h"
+#include "hw.h"
+#include "pwrctl.h"
+#include "tick.h"
+#include "softtimer.h"
+#include "dbg_printf.h"
+
+/** The fan is switched on and off over this period for its duty */
+#define FAN_PWM_PERIOD_MS  (100)
+
+/** Reported temperatures older than this are ignored */
+#define REPORT_TIMEOUT_MS  (10000)
+
+/** Temperature reports use this for a sensor that could not be read */
+#define TEMP_INVALID  ((int16_t) 0xffff)
+
+/** The derating is lifted at most this many percent per interval so the
+  * current does not oscillate with the readings */
+#define DERATE_RECOVERY_PERCENT  (5)
+
+static softtimer_t thermal_timer;
+static softtimer_t fan_timer;
+static uint8_t fan_duty;
+static bool fan_on;
+static uint8_t derate_percent = 100;
+
+static int16_t chip_temp;
+static bool chip_temp_valid;
+static int16_t report_temp;
+static bool report_valid;
+static uint64_t report_tick;
+
+static int16_t hottest;
+static bool hottest_valid;
+
+/**
+  * @brief Map a temperature on a line from (t0, y0) to (t1, y1), clamped
+  * @retval the value at temp
+  */
+static int32_t ramp(int16_t temp, int16_t t0, int32_t y0, int16_t t1, int32_t y1)
+{
+    if (temp <= t0) {
+        return y0;
+    } else if (temp >= t1) {
+        return y1;
+    }
+    return y0 + (y1 - y0) * (temp - t0) / (t1 - t0);
+}
+
+/**
+  * @brief Switch the fan for the next part of the PWM period
+  * @param timer the fan timer
+  * @retval None
+  */
+static void fan_tick(softtimer_t *timer)
+{
+    uint32_t on_ms = FAN_PWM_PERIOD_MS * fan_duty / 100;
+    fan_on = !fan_on;
+    hw_set_fan(fan_on);
+    softtimer_start(timer, fan_on ? on_ms : FAN_PWM_PERIOD_MS - on_ms, 0, &fan_tick);
+}
+
+/**
+  * @brief Set the fan duty, 0 and 100 need no timer
+  * @param duty duty in percent
+  * @retval None
+  */
+static void fan_set_duty(uint8_t duty)
+{
+    fan_duty = duty;
+    if (duty == 0 || duty >= 100) {
+        softtimer_stop(&fan_timer);
+        fan_on = duty > 0;
+        hw_set_fan(fan_on);
+    } else if (!softtimer_is_active(&fan_timer)) {
+        fan_tick(&fan_timer);
+    }
+}
+
+/**
+  * @brief Run the thermal loop
+  * @param timer the thermal timer
+  * @retval None
+  */
+static void thermal_tick(softtimer_t *timer)
+{
+    (void) timer;
+    int16_t temp;
+    if (hw_get_chip_temperature(&temp)) {
+        chip_temp = temp;
+        chip_temp_valid = true;
+    }
+    if (report_valid && get_ticks() - report_tick > REPORT_TIMEOUT_MS) {
+        report_valid = false;
+    }
+
+    hottest_valid = chip_temp_valid || report_valid;
+    if (chip_temp_valid && report_valid) {
+        hottest = chip_temp > report_temp ? chip_temp : report_temp;
+    } else {
+        hottest = chip_temp_valid ? chip_temp : report_temp;
+    }
+
+    uint8_t duty;
+    uint8_t derate = 100;
+    if (!hottest_valid) {
+        /** As without the loop */
+        duty = pwrctl_vout_enabled() ? 100 : 0;
+    } else {
+        duty = ramp(hottest, CONFIG_FAN_START_TEMP, 0, CONFIG_FAN_FULL_TEMP, 100);
+        if (pwrctl_vout_enabled() && duty < CONFIG_FAN_MIN_DUTY) {
+            duty = CONFIG_FAN_MIN_DUTY;
+        }
+        derate = ramp(hottest, CONFIG_DERATE_START_TEMP, 100, CONFIG_DERATE_END_TEMP, CONFIG_DERATE_MIN_PERCENT);
+    }
+    if (derate > derate_percent + DERATE_RECOVERY_PERCENT) {
+        derate = derate_percent + DERATE_RECOVERY_PERCENT;
+    }
+    if (derate != derate_percent) {
+        if (derate < derate_percent) {
+            dbg_printf("Derating to %u%% at %d\n", derate, hottest);
+        }
+        derate_percent = derate;
+        pwrctl_set_iout_max(derate == 100 ? UINT32_MAX : (uint32_t) CONFIG_DPS_MAX_CURRENT * derate / 100);
+    }
+    if (duty != fan_duty) {
+        fan_set_duty(duty);
+    }
+}
+
+/**
+  * @brief Initialize the thermal loop and start running it on a soft timer
+  * @retval None
+  */
+void thermal_init(void)
+{
+    /** The first call starts the first conversion */
+    (void) hw_get_chip_temperature(&chip_temp);
+    softtimer_start(&thermal_timer, CONFIG_THERMAL_INTERVAL_MS, CONFIG_THERMAL_INTERVAL_MS, &thermal_tick);
+}
+
+/**
+  * @brief Feed the temperatures of a temperature report to the loop
+  * @param temp1 first temperature, 0xffff if not measured
+  * @param temp2 second temperature, 0xffff if not measured
+  * @retval None
+  */
+void thermal_report(int16_t temp1, int16_t temp2)
+{
+    report_valid = temp1 != TEMP_INVALID || temp2 != TEMP_INVALID;
+    if (temp1 == TEMP_INVALID) {
+        report_temp = temp2;
+    } else if (temp2 == TEMP_INVALID) {
+        report_temp = temp1;
+    } else {
+        report_temp = temp1 > temp2 ? temp1 : temp2;
+    }
+    report_tick = get_ticks();
+}
+
+/**
+  * @brief Get the state of the loop
+  * @param temp the hottest temperature considered
+  * @param duty fan duty in percent
+  * @param derate the current cap in percent of the model maximum
+  * @retval false if there is no temperature to go on
+  */
+bool thermal_get_state(int16_t *temp, uint8_t *duty, uint8_t *derate)
+{
+    *temp = hottest;
+    *duty = fan_duty;
+    *derate = derate_percent;
+    return hottest_valid;
+}
@@ -0,0 +1,92 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __THERMAL_H__
+#define __THERMAL_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** The thermal loop runs the fan and derates the output current from the
+  * hottest of the STM32 internal temperature sensor and the temperatures
+  * reported by a companion. Temperatures are in 1/10 degrees like the
+  * temperature reports. The hard shutdown at CONFIG_TEMPERATURE_ALERT_LEVEL
+  * is kept as the last resort. */
+
+/** How often the temperatures are checked */
+#ifndef CONFIG_THERMAL_INTERVAL_MS
+ #define CONFIG_THERMAL_INTERVAL_MS  (1000)
+#endif
+
+/** The fan duty ramps from 0 at CONFIG_FAN_START_TEMP to 100% at
+  * CONFIG_FAN_FULL_TEMP, and is at least CONFIG_FAN_MIN_DUTY percent while
+  * power out is enabled */
+#ifndef CONFIG_FAN_START_TEMP
+ #define CONFIG_FAN_START_TEMP  (350)
+#endif
+#ifndef CONFIG_FAN_FULL_TEMP
+ #define CONFIG_FAN_FULL_TEMP  (450)
+#endif
+#ifndef CONFIG_FAN_MIN_DUTY
+ #define CONFIG_FAN_MIN_DUTY  (30)
+#endif
+
+/** The current is capped from 100% of the model maximum at
+  * CONFIG_DERATE_START_TEMP down to CONFIG_DERATE_MIN_PERCENT at
+  * CONFIG_DERATE_END_TEMP */
+#ifndef CONFIG_DERATE_START_TEMP
+ #define CONFIG_DERATE_START_TEMP  (400)
+#endif
+#ifndef CONFIG_DERATE_END_TEMP
+ #define CONFIG_DERATE_END_TEMP  (480)
+#endif
+#ifndef CONFIG_DERATE_MIN_PERCENT
+ #define CONFIG_DERATE_MIN_PERCENT  (25)
+#endif
+
+/**
+  * @brief Initialize the thermal loop and start running it on a soft timer
+  * @retval None
+  */
+void thermal_init(void);
+
+/**
+  * @brief Feed the temperatures of a temperature report to the loop
+  * @param temp1 first temperature, 0xffff if not measured
+  * @param temp2 second temperature, 0xffff if not measured
+  * @retval None
+  */
+void thermal_report(int16_t temp1, int16_t temp2);
+
+/**
+  * @brief Get the state of the loop
+  * @param temp the hottest temperature considered
+  * @param fan_duty fan duty in percent
+  * @param derate_percent the current cap in percent of the model maximum
+  * @retval false if there is no temperature to go on, the fan then runs
+  *         while power out is enabled and nothing is derated
+  */
+bool thermal_get_state(int16_t *temp, uint8_t *fan_duty, uint8_t *derate_percent);
+
+#endif // __THERMAL_H__
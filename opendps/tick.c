@@ -23,11 +23,23 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <systick.h>
 #include <nvic.h>
+#include <scb.h>
+#include <cortex.h>
 #include "tick.h"
 
-static volatile uint64_t tick_ms;
+/** SysTick counts down from SYSTICK_RELOAD at 6MHz, interrupting every ms */
+#define SYSTICK_RELOAD        (5999)
+#define SYSTICK_COUNTS_PER_US (6)
+
+/** The ms counter as two words, the Cortex-M3 cannot load 64 bits at once.
+  * Only the systick ISR writes them. */
+static volatile uint32_t tick_ms_lo;
+static volatile uint32_t tick_ms_hi;
+static volatile tick_callback_t tick_callbacks[TICK_MAX_CALLBACKS];
+static volatile uint32_t tick_num_callbacks;
 
 /**
   * @brief Initialize the systick module
@@ -40,7 +52,7 @@ void systick_init(void)
 
     // 6000000/6000 = 1000 overflows per second - every 1ms one interrupt
     // SysTick interrupt every N clock pulses: set reload to N-1
-    systick_set_reload(5999);
+    systick_set_reload(SYSTICK_RELOAD);
 
     systick_interrupt_enable();
     systick_counter_enable();
@@ -54,17 +66,67 @@ void systick_init(void)
 
 void delay_ms(uint32_t delay)
 {
-    uint64_t start = tick_ms;
-    while (tick_ms < start + delay) ;    
+    uint32_t start = get_ticks32();
+    while (get_ticks32() - start < delay) ;
 }
 
 /**
   * @brief Get systick
   * @retval number of milliseconcs since powerup
+  * @note Safe to call from ISRs, the high word is re-read until it did not
+  *       change while the low word was read
   */
 uint64_t get_ticks(void)
 {
-    return tick_ms;
+    uint32_t hi, lo;
+    do {
+        hi = tick_ms_hi;
+        lo = tick_ms_lo;
+    } while (hi != tick_ms_hi);
+    return (uint64_t) hi << 32 | lo;
+}
+
+/**
+  * @brief Get the low 32 bits of systick, for comparing intervals shorter
+  *        than ~49 days using unsigned differences
+  * @retval number of milliseconcs since powerup, modulo 2^32
+  */
+uint32_t get_ticks32(void)
+{
+    return tick_ms_lo;
+}
+
+/**
+  * @brief Get a timestamp with microsecond resolution, for telemetry stamping
+  * @retval number of microseconds since powerup
+  */
+uint64_t get_ticks_us(void)
+{
+    uint32_t primask = cm_mask_interrupts(1);
+    uint64_t ms = get_ticks();
+    uint32_t count = STK_CVR;
+    if (SCB_ICSR & SCB_ICSR_PENDSTSET) {
+        /** The counter reloaded but the ISR has not counted the ms yet */
+        ms++;
+        count = STK_CVR;
+    }
+    cm_mask_interrupts(primask);
+    return ms * 1000 + (SYSTICK_RELOAD - count) / SYSTICK_COUNTS_PER_US;
+}
+
+/**
+  * @brief Add a function to be called from the systick ISR every millisecond
+  * @param callback the function
+  * @retval true if added, false if TICK_MAX_CALLBACKS are already added
+  */
+bool tick_add_callback(tick_callback_t callback)
+{
+    if (tick_num_callbacks == TICK_MAX_CALLBACKS) {
+        return false;
+    }
+    tick_callbacks[tick_num_callbacks] = callback;
+    tick_num_callbacks++; /** Published last, the ISR may run in between */
+    return true;
 }
 
 /**
@@ -73,6 +135,11 @@ uint64_t get_ticks(void)
   */
 void sys_tick_handler(void)
 {
-    tick_ms++;
+    if (++tick_ms_lo == 0) {
+        tick_ms_hi++;
+    }
+    for (uint32_t i = 0; i < tick_num_callbacks; i++) {
+        tick_callbacks[i]();
+    }
 }
 
@@ -26,6 +26,13 @@
 #define __TICK_H__
 
 #include <stdint.h>
+#include <stdbool.h>
+
+/** Called from the systick ISR every millisecond */
+typedef void (*tick_callback_t)(void);
+
+/** The button scanner and the sequencer */
+#define TICK_MAX_CALLBACKS  (2)
 
 /**
   * @brief Initialize the systick module
@@ -43,7 +50,28 @@ void delay_ms(uint32_t delay);
 /**
   * @brief Get systick
   * @retval number of milliseconcs since powerup
+  * @note Safe to call from ISRs
   */
 uint64_t get_ticks(void);
 
+/**
+  * @brief Get the low 32 bits of systick, for comparing intervals shorter
+  *        than ~49 days using unsigned differences
+  * @retval number of milliseconcs since powerup, modulo 2^32
+  */
+uint32_t get_ticks32(void);
+
+/**
+  * @brief Get a timestamp with microsecond resolution, for telemetry stamping
+  * @retval number of microseconds since powerup
+  */
+uint64_t get_ticks_us(void);
+
+/**
+  * @brief Add a function to be called from the systick ISR every millisecond
+  * @param callback the function
+  * @retval true if added, false if TICK_MAX_CALLBACKS are already added
+  */
+bool tick_add_callback(tick_callback_t callback);
+
 #endif // __TICK_H__
@@ -40,42 +40,87 @@
   */
 int32_t uframe_extract_payload(uint8_t *frame, uint32_t length)
 {
-    int32_t status = -1;
-    bool seen_dle = false;
-    uint16_t frame_crc, calc_crc = 0;
-    do {
-        if (length < 5) { // _SOF CRC16 _EOF is no usable frame
-            status = -E_LEN;
-            break;
-        }
-        if (frame[0] != _SOF || frame[length-1] != _EOF) {
-            status = -E_FRM;
-            break;
-        }
-
-        // First unescape the frame
-        uint32_t w = 0;
-        for (uint32_t r = 1; r < length-1; r++) {
-            if (seen_dle) {
-                seen_dle = false;
-                frame[w++] = frame[r] ^_XOR;
-            } else if (frame[r] == _DLE) {
-                seen_dle = true;
-            } else {
-                frame[w++] = frame[r];
-            }
-        }
+    int32_t status = 0;
+    uframe_decoder_t decoder;
+    if (length < 5) { // _SOF CRC16 _EOF is no usable frame
+        return -E_LEN;
+    }
+    if (frame[0] != _SOF || frame[length-1] != _EOF) {
+        return -E_FRM;
+    }
+    uframe_decoder_init(&decoder, frame, length);
+    uint32_t r = 0;
+    while (r < length && status == 0) {
+        status = uframe_decode(&decoder, frame[r++]);
+    }
+    return r == length ? status : -E_CRC;
+}
 
-        // Then calculate CRC
-        calc_crc = crc16((uint8_t*) frame, w - 2);
+/**
+  * @brief Initialize a streaming frame decoder
+  * @param decoder the decoder
+  * @param buf buffer for the payload and crc, may be the buffer the escaped
+  *        frame is read from as the payload never catches up with it
+  * @param size size of buffer
+  * @retval none
+  */
+void uframe_decoder_init(uframe_decoder_t *decoder, uint8_t *buf, uint32_t size)
+{
+    decoder->buf = buf;
+    decoder->size = size;
+    decoder->length = 0;
+    decoder->crc = 0;
+    decoder->receiving = false;
+    decoder->seen_dle = false;
+}
 
-        frame_crc = (uint16_t) ((frame[w-2] << 8) | frame[w-1]);
-        if (calc_crc == frame_crc) {
-            status = (int32_t) w - 2; // omit crc from returned length
-        } else {
-            status = -E_CRC;
+/**
+  * @brief Feed a received byte to the decoder. Bytes outside _SOF.._EOF are
+  *        ignored and _SOF always starts a new frame.
+  * @param decoder the decoder
+  * @param b the received byte
+  * @retval 0 if no frame was completed by the byte
+  *         length of payload, stored at the start of the buffer, if the byte
+  *         completed a valid frame
+  *         -E_* if the byte completed (or overflowed) an invalid frame
+  */
+int32_t uframe_decode(uframe_decoder_t *decoder, uint8_t b)
+{
+    if (b == _SOF) {
+        decoder->receiving = true;
+        decoder->seen_dle = false;
+        decoder->length = 0;
+        decoder->crc = 0;
+        return 0;
+    }
+    if (!decoder->receiving) {
+        return 0;
+    }
+    if (b == _EOF) {
+        decoder->receiving = false;
+        uint32_t length = decoder->length;
+        if (length < 3 || decoder->seen_dle) { // At least one byte of payload and the crc
+            return -E_LEN;
         }
-    } while(0);
-
-    return status;
+        uint16_t frame_crc = (uint16_t) ((decoder->buf[length-2] << 8) | decoder->buf[length-1]);
+        return frame_crc == decoder->crc ? (int32_t) length - 2 : -E_CRC;
+    }
+    if (b == _DLE) {
+        decoder->seen_dle = true;
+        return 0;
+    }
+    if (decoder->seen_dle) {
+        decoder->seen_dle = false;
+        b ^= _XOR;
+    }
+    if (decoder->length >= decoder->size) {
+        decoder->receiving = false;
+        return -E_OVF;
+    }
+    /** The last two bytes are the crc, so the crc lags two bytes behind */
+    if (decoder->length >= 2) {
+        decoder->crc = crc16_add(decoder->crc, decoder->buf[decoder->length-2]);
+    }
+    decoder->buf[decoder->length++] = b;
+    return 0;
 }
@@ -25,6 +25,8 @@
 #ifndef __UFRAME_H__
 #define __UFRAME_H__
 
+#include <stdint.h>
+#include <stdbool.h>
 #include "crc16.h"
 #include "dbg_printf.h"
 
@@ -37,6 +39,7 @@
 #define E_LEN 1 // Received frame is too short to be a uframe
 #define E_FRM 2 // Received data has no framing
 #define E_CRC 3 // CRC mismatch
+#define E_OVF 4 // Received frame does not fit the buffer
 
 /**  Max size given a payload of 'size' bytes
   * (SOF + every byte of payload escaped + 2x escaped crc bytes + EOF)
@@ -47,13 +50,25 @@
 /** Declare a frame of length 'length' for dumping data into */
 #define DECLARE_FRAME(length) \
     uint8_t _buffer[ FRAME_OVERHEAD(length) ]; \
+    const uint32_t _size = sizeof(_buffer); \
     _buffer[0] = _SOF; \
     uint32_t _length = 1; \
     uint16_t _crc = 0;
 
-/** Pack a byte with stuffing and crc updating */
+/** Declare a frame packed directly into 'buf' of 'size' bytes, which must be
+  * at least FRAME_OVERHEAD(1). Saves a stack buffer and a copy when the frame
+  * is built for a buffer the caller owns. */
+#define DECLARE_FRAME_AT(buf, size) \
+    uint8_t *_buffer = (buf); \
+    const uint32_t _size = (size); \
+    _buffer[0] = _SOF; \
+    uint32_t _length = 1; \
+    uint16_t _crc = 0;
+
+/** Pack a byte with stuffing and crc updating, bytes that might not fit
+  * escaped are dropped */
 #define PACK8(b) \
-    if (_length < sizeof(_buffer)) { \
+    if (_length+1 < _size) { \
         _crc = crc16_add(_crc, b); \
         uint8_t _byte = (b); \
         if (_byte == _SOF || _byte == _DLE || _byte == _EOF) { \
@@ -89,7 +104,7 @@
 
 /** Like PACK8 but does not compute crc */
 #define STUFF8(b) \
-    if (_length+2 < sizeof(_buffer)) { \
+    if (_length+2 < _size) { \
         uint8_t _byte = (b); \
         if (_byte == _SOF || _byte == _DLE || _byte == _EOF) { \
             _buffer[_length++] = _DLE; \
@@ -105,7 +120,7 @@
 #define FINISH_FRAME() \
     STUFF8((_crc >> 8) & 0xff); \
     STUFF8(_crc & 0xff); \
-    if (_length < sizeof(_buffer)) { \
+    if (_length < _size) { \
         _buffer[_length++] = _EOF; \
     }
 
@@ -134,7 +149,7 @@
 
 #define UNPACK32(h) \
     if (_remain >= 4) { \
-        (h)  = _buffer[_pos++] << 24; \
+        (h)  = (uint32_t) _buffer[_pos++] << 24; \
         (h) |= _buffer[_pos++] << 16; \
         (h) |= _buffer[_pos++] << 8; \
         (h) |= _buffer[_pos++]; \
@@ -155,4 +170,38 @@
   */
 int32_t uframe_extract_payload(uint8_t *frame, uint32_t length);
 
+/** State of a streaming frame decoder, fed one received byte at a time. The
+  * bytes are unescaped into the buffer and the crc is computed as they arrive
+  * so the payload is ready when _EOF is received. The members are private. */
+typedef struct {
+    uint8_t *buf;
+    uint32_t size;
+    uint32_t length;  /** Number of unescaped bytes, crc included */
+    uint16_t crc;     /** crc of all but the two latest bytes */
+    bool receiving;
+    bool seen_dle;
+} uframe_decoder_t;
+
+/**
+  * @brief Initialize a streaming frame decoder
+  * @param decoder the decoder
+  * @param buf buffer for the payload and crc, may be the buffer the escaped
+  *        frame is read from as the payload never catches up with it
+  * @param size size of buffer
+  * @retval none
+  */
+void uframe_decoder_init(uframe_decoder_t *decoder, uint8_t *buf, uint32_t size);
+
+/**
+  * @brief Feed a received byte to the decoder. Bytes outside _SOF.._EOF are
+  *        ignored and _SOF always starts a new frame.
+  * @param decoder the decoder
+  * @param b the received byte
+  * @retval 0 if no frame was completed by the byte
+  *         length of payload, stored at the start of the buffer, if the byte
+  *         completed a valid frame
+  *         -E_* if the byte completed (or overflowed) an invalid frame
+  */
+int32_t uframe_decode(uframe_decoder_t *decoder, uint8_t b);
+
 #endif // __UFRAME_H__
@@ -24,10 +24,17 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 #include "my_assert.h"
 #include "uui.h"
 #include "tft.h"
 #include "opendps.h"
+#include "intfmt.h"
+#include "profile.h"
+
+/** Parameter names of the protections, in pwrctl_protection_t order */
+static const char * const protection_names[prot_max] = { "ovp", "opp" };
 
 
 /**
@@ -35,7 +42,7 @@
  *
  * @param      item  The ui item
  */
-static void item_got_focus(ui_item_t *item)
+void ui_item_got_focus(ui_item_t *item)
 {
     assert(item);
     assert(item->can_focus);
@@ -48,7 +55,7 @@ static void item_got_focus(ui_item_t *item)
  *
  * @param      item  The ui item
  */
-static void item_lost_focus(ui_item_t *item)
+void ui_item_lost_focus(ui_item_t *item)
 {
     assert(item);
     assert(item->can_focus);
@@ -56,46 +63,191 @@ static void item_lost_focus(ui_item_t *item)
     item->needs_redraw = true;
 }
 
+void uui_apply_protection(ui_screen_t *screen)
+{
+    for (uint32_t p = 0; p < prot_max; p++) {
+        (void) pwrctl_set_protection(p, screen->protection[p]);
+    }
+}
+
 void uui_init(uui_t *ui, past_t *past)
 {
     assert(ui);
     ui->past = past;
     ui->num_screens = ui->cur_screen = 0;
     ui->is_visible = true;
+    ui->statics_shown = NULL;
 }
 
 void uui_add_screen(uui_t *ui, ui_screen_t *screen)
 {
     assert(ui);
     assert(screen);
-    if (screen->past_restore) {
-        screen->past_restore(ui->past);
-    }
     if (ui->num_screens < MAX_SCREENS) {
         ui->screens[ui->num_screens++] = screen;
         screen->cur_item = 0;
         screen->is_enabled = false;
-        for (uint8_t i = 0; i < screen->num_items; i++) {
-            screen->items[i]->screen = screen;
-            screen->items[i]->needs_redraw = true;
+        screen->is_activated = false;
+    }
+}
+
+/**
+ * @brief      Set up a screen the first time it is shown, so screens never
+ *             used do not cost boot time
+ *
+ * @param      ui      The user interface
+ * @param      screen  The screen
+ */
+static void screen_setup(uui_t *ui, ui_screen_t *screen)
+{
+    if (screen->is_activated) {
+        return;
+    }
+    if (screen->desc->activate) {
+        screen->desc->activate();
+    }
+    if (screen->desc->past_restore) {
+        screen->desc->past_restore(ui->past);
+    }
+    for (uint8_t i = 0; i < screen->desc->num_items; i++) {
+        screen->desc->items[i]->screen = screen;
+        screen->desc->items[i]->needs_redraw = true;
+        screen->desc->items[i]->needs_full_redraw = true;
+    }
+    screen->is_activated = true;
+}
+
+/**
+ * @brief      Get an entry of the static layer of a screen, the static
+ *             layers of its items in order
+ *
+ * @param      screen  The screen
+ * @param[in]  index   Index of the entry
+ * @param      entry   The entry
+ *
+ * @return     false past the last entry
+ */
+static bool screen_static(ui_screen_t *screen, uint32_t index, ui_static_t *entry)
+{
+    for (uint8_t i = 0; i < screen->desc->num_items; i++) {
+        ui_item_t *item = screen->desc->items[i];
+        for (uint32_t n = 0; item->ops->get_static && item->ops->get_static(item, n, entry); n++) {
+            if (index-- == 0) {
+                return true;
+            }
         }
     }
+    return false;
 }
 
-void uui_refresh(uui_t *ui, bool force)
+/**
+ * @brief      Check if a screen has an entry in its static layer
+ *
+ * @param      screen  The screen
+ * @param      entry   The entry
+ *
+ * @return     true if the screen has the same glyph in the same place
+ */
+static bool screen_has_static(ui_screen_t *screen, const ui_static_t *entry)
 {
-    assert(ui);
+    ui_static_t other;
+    for (uint32_t i = 0; screen_static(screen, i, &other); i++) {
+        if (memcmp(&other, entry, sizeof(other)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief      Draw the static layer and the icon of a screen. What the
+ *             screen shown before has in the same place is already on the
+ *             display, the rest of what it had is erased.
+ *
+ * @param      ui      The user interface
+ * @param      screen  The screen
+ */
+static void statics_draw(uui_t *ui, ui_screen_t *screen)
+{
+    ui_screen_t *old = ui->statics_shown;
+    ui_static_t entry;
+    if (old == screen) {
+        return;
+    }
+    if (old) {
+        for (uint32_t i = 0; screen_static(old, i, &entry); i++) {
+            if (entry.ch != ' ' && !screen_has_static(screen, &entry)) {
+                tft_fill(entry.x, entry.y, entry.w, entry.h, 0);
+            }
+        }
+        if (old->desc->icon_data && old->desc->icon_data != screen->desc->icon_data &&
+            (!screen->desc->icon_data || old->desc->icon_width != screen->desc->icon_width || old->desc->icon_height != screen->desc->icon_height)) {
+            tft_fill(48, 128-old->desc->icon_height, old->desc->icon_width, old->desc->icon_height, 0);
+        }
+    }
+    for (uint32_t i = 0; screen_static(screen, i, &entry); i++) {
+        if (old && screen_has_static(old, &entry)) {
+            continue;
+        }
+        if (entry.ch == ' ') {
+            tft_fill(entry.x, entry.y, entry.w, entry.h, 0);
+        } else {
+            tft_putch(entry.font_size, entry.ch, entry.x, entry.y, entry.w, entry.h, false);
+        }
+    }
+    if (screen->desc->icon_data && (!old || old->desc->icon_data != screen->desc->icon_data)) {
+        tft_blit_packed(screen->desc->icon_data, screen->desc->icon_palette, screen->desc->icon_width, screen->desc->icon_height, 48, 128-screen->desc->icon_height, false);
+    }
+    ui->statics_shown = screen;
+}
+
+/**
+ * @brief      Draw the current screen
+ *
+ * @param      ui      The user interface
+ * @param      force   If true, all items and the static layer are drawn
+ */
+static void screen_refresh(uui_t *ui, bool force)
+{
+    if (!ui->is_visible) {
+        return; /** Dirty items are drawn when the UI is shown again */
+    }
+    PROFILE_START();
     ui_screen_t *screen = ui->screens[ui->cur_screen];
     assert(screen);
-    for (uint8_t i = 0; i < screen->num_items; i++) {
-        ui_item_t *item = screen->items[i];
+    /** The screen switched from, its items are still on the display */
+    ui_screen_t *old = ui->statics_shown != screen ? ui->statics_shown : NULL;
+    tft_frame_begin();
+    if (force) {
+        statics_draw(ui, screen);
+    }
+    for (uint8_t i = 0; i < screen->desc->num_items; i++) {
+        ui_item_t *item = screen->desc->items[i];
         if (force || item->needs_redraw) {
-            assert(item->draw);
-            item->draw(item);
+            assert(item->ops->draw);
+            if (force) {
+                item->needs_full_redraw = true;
+                for (uint8_t n = 0; old && item->ops->inherit && n < old->desc->num_items; n++) {
+                    if (old->desc->items[n]->x == item->x && old->desc->items[n]->y == item->y) {
+                        item->ops->inherit(item, old->desc->items[n]);
+                    }
+                }
+            }
+            item->ops->draw(item);
             item->needs_redraw = false;
         }
     }
-    tft_blit((uint16_t*) screen->icon_data, screen->icon_width, screen->icon_height, 48, 128-screen->icon_height);
+    tft_frame_end();
+    PROFILE_END(prof_uui_refresh);
+}
+
+void uui_refresh(uui_t *ui, bool force)
+{
+    assert(ui);
+    if (force) {
+        ui->statics_shown = NULL; /** The display may hold anything */
+    }
+    screen_refresh(ui, force);
 }
 
 void uui_activate(uui_t *ui)
@@ -104,16 +256,18 @@ void uui_activate(uui_t *ui)
     assert(ui->num_screens);
     if (ui->num_screens > 0) {
         ui_screen_t *screen = ui->screens[ui->cur_screen];
+        screen_setup(ui, screen);
         /** Find the first focusable item */
-        for (uint32_t i = 0; i < screen->num_items; i++) {
-            if (screen->items[i]->can_focus) {
+        for (uint32_t i = 0; i < screen->desc->num_items; i++) {
+            if (screen->desc->items[i]->can_focus) {
                 screen->cur_item = i;
                 break;
             }
         }
         /** @todo: add activation callback for each screen allowing for updating of U/I settings */
-        uui_refresh(ui, true);
-        tft_blit((uint16_t*) screen->icon_data, screen->icon_width, screen->icon_height, 48, 128-screen->icon_height);
+        /** The items are drawn in full, the static layer the screens share
+            is left as it is */
+        screen_refresh(ui, true);
     }
 }
 
@@ -131,7 +285,7 @@ void uui_handle_screen_event(uui_t *ui, event_t event)
     assert(ui);
     ui_screen_t *screen = ui->screens[ui->cur_screen];
     assert(screen);
-    ui_item_t *item = screen->items[screen->cur_item];
+    ui_item_t *item = screen->desc->items[screen->cur_item];
     assert(item);
 
     if (!ui->is_visible) {
@@ -165,9 +319,9 @@ void uui_handle_screen_event(uui_t *ui, event_t event)
             if (item->has_focus) {
                 ui_item_t *old_item = item;
                 do {
-                    screen->cur_item = screen->cur_item ? screen->cur_item - 1 : screen->num_items - 1;
-                } while(!screen->items[screen->cur_item]->can_focus);
-                ui_item_t *new_item = screen->items[screen->cur_item];
+                    screen->cur_item = screen->cur_item ? screen->cur_item - 1 : screen->desc->num_items - 1;
+                } while(!screen->desc->items[screen->cur_item]->can_focus);
+                ui_item_t *new_item = screen->desc->items[screen->cur_item];
                 if (old_item != new_item) {
                     focus_switch(old_item);
                     focus_switch(new_item);
@@ -179,9 +333,9 @@ void uui_handle_screen_event(uui_t *ui, event_t event)
             if (item->has_focus) {
                 ui_item_t *old_item = item;
                 do {
-                    screen->cur_item = (screen->cur_item + 1) % screen->num_items;
-                } while(!screen->items[screen->cur_item]->can_focus);
-                ui_item_t *new_item = screen->items[screen->cur_item];
+                    screen->cur_item = (screen->cur_item + 1) % screen->desc->num_items;
+                } while(!screen->desc->items[screen->cur_item]->can_focus);
+                ui_item_t *new_item = screen->desc->items[screen->cur_item];
                 if (old_item != new_item) {
                     focus_switch(old_item);
                     focus_switch(new_item);
@@ -191,13 +345,19 @@ void uui_handle_screen_event(uui_t *ui, event_t event)
 
         case event_button_enable:
         case event_ocp:
+        case event_ovp:
+        case event_opp:
+        case event_brownout:
             /** If current screen can be enabled */
-            if (screen->enable) {
+            if (screen->desc->enable) {
                 screen->is_enabled = !screen->is_enabled;
-                if (screen->is_enabled && screen->past_save) {
-                    screen->past_save(ui->past);
+                if (screen->is_enabled && screen->desc->past_save) {
+                    screen->desc->past_save(ui->past);
+                }
+                if (screen->is_enabled) {
+                    uui_apply_protection(screen);
                 }
-                screen->enable(screen->is_enabled);
+                screen->desc->enable(screen->is_enabled);
                 opendps_update_power_status(screen->is_enabled); /** @todo: move */
             }
             break;
@@ -224,7 +384,7 @@ void uui_set_screen(uui_t *ui, uint32_t screen_idx)
     assert(screen_idx < ui->num_screens);
     ui_screen_t *cur_screen = ui->screens[ui->cur_screen];
     assert(cur_screen);
-    ui_item_t *item = cur_screen->items[cur_screen->cur_item];
+    ui_item_t *item = cur_screen->desc->items[cur_screen->cur_item];
     assert(item);
     ui->cur_screen = screen_idx;
     ui_screen_t *new_screen = ui->screens[ui->cur_screen];
@@ -234,7 +394,7 @@ void uui_set_screen(uui_t *ui, uint32_t screen_idx)
         opendps_update_power_status(false); /** @todo: move */
         if (cur_screen->is_enabled) {
             /** Disable the old screen as it will no longer be in control of power out */
-            cur_screen->enable(false);
+            cur_screen->desc->enable(false);
             cur_screen->is_enabled = false;
         }
         if (item->has_focus) {
@@ -244,28 +404,87 @@ void uui_set_screen(uui_t *ui, uint32_t screen_idx)
     }
 }
 
-void ui_item_init(ui_item_t *item)
+void ui_item_init(ui_item_t *item, const ui_item_ops_t *ops)
 {
     item->has_focus = false;
-    item->got_focus = &item_got_focus;
-    item->lost_focus = &item_lost_focus;
+    item->ops = ops;
+}
+
+uint32_t uui_num_parameters(const ui_screen_t *screen)
+{
+    uint32_t n = 0;
+    if (!screen->desc->parameters) {
+        return 0; /** Screens not controlled remotely have none */
+    }
+    while (n < MAX_PARAMETERS && screen->desc->parameters[n].name[0]) {
+        n++;
+    }
+    return n;
 }
 
 void uui_tick(uui_t *ui)
 {
-    ui->screens[ui->cur_screen]->tick();
+    ui->screens[ui->cur_screen]->desc->tick();
+    /** The tick only updates values, draw the changed items in one pass */
+    uui_refresh(ui, false);
 }
 
 void uui_show(uui_t *ui, bool show)
 {
     ui->is_visible = show;
+    if (!show) {
+        ui->statics_shown = NULL; /** Others may draw in our place */
+    }
 }
 
 void uui_disable_cur_screen(uui_t *ui)
 {
     ui_screen_t *screen = ui->screens[ui->cur_screen];
-    if (screen->enable && screen->is_enabled) {
+    if (screen->desc->enable && screen->is_enabled) {
         screen->is_enabled = false;
-        screen->enable(screen->is_enabled);
+        screen->desc->enable(screen->is_enabled);
+    }
+}
+
+pwrctl_protection_t uui_find_protection(const char *name)
+{
+    for (uint32_t p = 0; p < prot_max; p++) {
+        if (strcmp(protection_names[p], name) == 0) {
+            return (pwrctl_protection_t) p;
+        }
+    }
+    return prot_max;
+}
+
+set_param_status_t uui_set_protection_value(ui_screen_t *screen, pwrctl_protection_t prot, int32_t value)
+{
+    if (value < 0) {
+        return ps_range_error;
+    }
+    screen->protection[prot] = value;
+    return ps_ok;
+}
+
+set_param_status_t uui_set_protection(ui_screen_t *screen, char *name, char *value)
+{
+    pwrctl_protection_t prot = uui_find_protection(name);
+    if (prot == prot_max) {
+        return ps_unknown_name;
+    }
+    int32_t ivalue;
+    if (!intfmt_parse_i32(value, &ivalue)) {
+        return ps_range_error;
+    }
+    return uui_set_protection_value(screen, prot, ivalue);
+}
+
+set_param_status_t uui_get_protection(ui_screen_t *screen, char *name, char *value, uint32_t value_len)
+{
+    for (uint32_t p = 0; p < prot_max; p++) {
+        if (strcmp(protection_names[p], name) == 0) {
+            (void) intfmt_i32(value, value_len, screen->protection[p]);
+            return ps_ok;
+        }
     }
+    return ps_unknown_name;
 }
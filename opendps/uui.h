@@ -62,6 +62,9 @@ typedef enum {
     unit_second,
     unit_hertz,
     unit_furlong,
+    unit_ohm,
+    unit_celsius,
+    unit_ampere_hour,
     unit_last = 0xff
 } unit_t;
 
@@ -96,10 +99,12 @@ typedef enum {
     ps_unknown_name,
     ps_range_error,
     ps_not_supported,
+    ps_not_applied, /** Valid, but another parameter set with it was not */
 } set_param_status_t;
 
 /**
- * Base class for a parameter
+ * Base class for a parameter, the parameters of a screen are a const array
+ * terminated by an empty name
  */
 typedef struct ui_parameter_t {
     char name[MAX_PARAMETER_NAME];
@@ -107,54 +112,99 @@ typedef struct ui_parameter_t {
     si_prefix_t prefix;
 } ui_parameter_t;
 
+/**
+ * An entry of the static layer of a screen, a glyph that does not change
+ * while the screen is shown (like the unit of a number). The display is
+ * 128x128 pixels so the positions fit a byte.
+ */
+typedef struct {
+    uint8_t x, y, w, h; /** Bounding box */
+    uint8_t font_size;
+    char ch; /** ' ' for a blank box */
+} ui_static_t;
+
 /**
  * Base class for a UI item
  */
 typedef struct ui_screen ui_screen_t;
 
+struct ui_item_t;
+
+/**
+ * The operations of a type of UI item, shared by all items of the type and
+ * kept in flash
+ */
+typedef struct {
+    void (*got_focus)(struct ui_item_t *item);
+    void (*lost_focus)(struct ui_item_t *item);
+    void (*got_event)(struct ui_item_t *item, event_t event);
+    uint32_t (*get_value)(struct ui_item_t *item);
+    void (*draw)(struct ui_item_t *item);
+    /** Optional, gets entry 'index' of the static layer of the item and
+        returns false past the last one. The static layer is drawn by uui,
+        draw() only draws the rest. */
+    bool (*get_static)(struct ui_item_t *item, uint32_t index, ui_static_t *entry);
+    /** Optional, called when the screen is switched to and the screen before
+        had 'old' in the same place. An item laid out like it may take over
+        what old knows of the display in place of a full redraw. */
+    void (*inherit)(struct ui_item_t *item, struct ui_item_t *old);
+} ui_item_ops_t;
+
 typedef struct ui_item_t {
     uint8_t id;
     ui_item_type_t type;
     bool can_focus; /** A focusable item is one we can edit */
     bool has_focus;
     bool needs_redraw;
+    bool needs_full_redraw; /** What is on screen is unknown, items caching their rendering must redraw everything */
     uint16_t x, y;
     //uint16_t width, height;
     ui_screen_t *screen;
-
-    void (*got_focus)(struct ui_item_t *item);
-    void (*lost_focus)(struct ui_item_t *item);
-    void (*got_event)(struct ui_item_t *item, event_t event);
-    uint32_t (*get_value)(struct ui_item_t *item);
-    void (*draw)(struct ui_item_t *item);
+    const ui_item_ops_t *ops; /** Set by the init function of the item type */
 } ui_item_t;
 
 /**
  * @brief      A macro used to call operations on UI elements
  */
-#define MCALL(item, operation, ...) ((ui_item_t*) (item))->operation((ui_item_t*) item, ##__VA_ARGS__)
+#define MCALL(item, operation, ...) ((ui_item_t*) (item))->ops->operation((ui_item_t*) item, ##__VA_ARGS__)
 
 /**
- * A screen has a name and holds num_items UI items
+ * A screen has a name and holds num_items UI items. What never changes is
+ * in a const descriptor kept in flash, the ui_screen_t pointing to it holds
+ * the state.
  */
-struct ui_screen {
+typedef struct {
     uint8_t id; /** must be unique */
-    char *name;
-    uint8_t *icon_data;
+    const char *name;
+    const uint8_t *icon_data; /** Palette packed, see pack565.py */
+    const uint8_t *icon_palette;
     uint32_t icon_data_len;
     uint32_t icon_width;
     uint32_t icon_height;
-    bool is_enabled;
     uint8_t num_items;
-    uint8_t cur_item;
-    ui_parameter_t parameters[MAX_PARAMETERS];
+    const ui_parameter_t *parameters;
+    void (*activate)(void); /** Called the first time the screen is shown, sets up its items before past_restore */
     void (*enable)(bool _enable); /** Called when the enable button is pressed */
     void (*tick)(void); /** Called periodically allowing the UI to do house keeping */
     void (*past_save)(past_t *past);
     void (*past_restore)(past_t *past);
     set_param_status_t (*set_parameter)(char *name, char *value);
     set_param_status_t (*get_parameter)(char *name, char *value, uint32_t value_len);
-    ui_item_t *items[];
+    /** The binary forms, id being the index in parameters */
+    set_param_status_t (*set_parameter_value)(uint32_t id, int32_t value);
+    set_param_status_t (*get_parameter_value)(uint32_t id, int32_t *value);
+    /** The set_parameter functions only validate and store the values, this
+      * programs the output from them once they have all been set */
+    void (*apply_parameters)(void);
+    ui_item_t * const items[];
+} ui_screen_desc_t;
+
+struct ui_screen {
+    const ui_screen_desc_t *desc;
+    bool is_enabled;
+    bool is_activated; /** activate and past_restore have been run */
+    uint8_t cur_item;
+    uint32_t protection[prot_max]; /** OVP/OPP limits in mV/mW applied when the screen is enabled, 0 disables */
 };
 
 /**
@@ -166,6 +216,9 @@ typedef struct {
     bool is_visible;
     ui_screen_t *screens[MAX_SCREENS];
     past_t *past;
+    /** The screen whose static layer and icon are on the display, NULL if
+        unknown. Switching between screens only draws what differs. */
+    ui_screen_t *statics_shown;
 } uui_t;
 
 /**
@@ -176,22 +229,26 @@ typedef struct {
 void uui_init(uui_t *ui, past_t *past);
 
 /**
- * @brief      Refresh all items on current screen in need of redrawing
+ * @brief      Refresh all items on current screen in need of redrawing,
+ *             nothing is drawn while the UI is hidden
  *
  * @param      ui      The UI
- * @param      force   If true, all items will be updated
+ * @param      force   If true, the display is taken to be unknown and all
+ *                     items, the static layer and the icon are drawn
  */
 void uui_refresh(uui_t *ui, bool force);
 
 /**
- * @brief      Activate current screen
+ * @brief      Activate current screen, setting it up and restoring its
+ *             settings from the past the first time it is shown
  *
  * @param      ui    The user interface
  */
 void uui_activate(uui_t *ui);
 
 /**
- * @brief      Add screen to UI
+ * @brief      Add screen to UI. Only the descriptor is registered, the
+ *             screen is set up by uui_activate()
  *
  * @param      ui      The user interface
  * @param      screen  The screen
@@ -231,18 +288,38 @@ void uui_set_screen(uui_t *ui, uint32_t screen_idx);
  * @brief      Initialize UI item
  *
  * @param      item  The item
+ * @param      ops   The operations of its type
+ */
+void ui_item_init(ui_item_t *item, const ui_item_ops_t *ops);
+
+/**
+ * @brief      The default got_focus and lost_focus operations of an item
+ *
+ * @param      item  The item
  */
-void ui_item_init(ui_item_t *item);
+void ui_item_got_focus(ui_item_t *item);
+void ui_item_lost_focus(ui_item_t *item);
 
 /**
- * @brief      UI tick handler
+ * @brief      Get the number of parameters of a screen
+ *
+ * @param      screen  The screen
+ *
+ * @return     The number of parameters before the terminator
+ */
+uint32_t uui_num_parameters(const ui_screen_t *screen);
+
+/**
+ * @brief      UI tick handler, lets the screen update its values and then
+ *             draws the items marked for redrawing
  *
  * @param      ui    The user interface
  */
 void uui_tick(uui_t *ui);
 
 /**
- * @brief      Show or hide UUI
+ * @brief      Show or hide UUI. Once hidden, the display is redrawn with
+ *             uui_refresh(ui, true).
  *
  * @param      ui    The user interface
  * @param      show  true for show, false for hide
@@ -256,4 +333,56 @@ void uui_show(uui_t *ui, bool show);
  */
 void uui_disable_cur_screen(uui_t *ui);
 
+/**
+ * @brief      Set a protection limit ("ovp" in millivolt, "opp" in milliwatt)
+ *             of a screen, applied when the screen is enabled or by
+ *             uui_apply_protection()
+ *
+ * @param      screen  The screen
+ * @param      name    Name of parameter
+ * @param      value   Value of parameter as a string
+ *
+ * @return     ps_unknown_name if name is not a protection
+ */
+set_param_status_t uui_set_protection(ui_screen_t *screen, char *name, char *value);
+
+/**
+ * @brief      Find the protection a parameter name is the limit of
+ *
+ * @param      name  Name of parameter
+ *
+ * @return     The protection, prot_max if name is not a protection
+ */
+pwrctl_protection_t uui_find_protection(const char *name);
+
+/**
+ * @brief      Set a protection limit of a screen, as uui_set_protection()
+ *
+ * @param      screen  The screen
+ * @param      prot    The protection
+ * @param      value   The limit in millivolt or milliwatt, 0 disables
+ *
+ * @return     Status of the operation
+ */
+set_param_status_t uui_set_protection_value(ui_screen_t *screen, pwrctl_protection_t prot, int32_t value);
+
+/**
+ * @brief      Apply the protection limits of a screen to pwrctl
+ *
+ * @param      screen  The screen
+ */
+void uui_apply_protection(ui_screen_t *screen);
+
+/**
+ * @brief      Get a protection limit of a screen
+ *
+ * @param      screen     The screen
+ * @param      name       Name of parameter
+ * @param      value      Value of parameter as a string
+ * @param      value_len  Length of value buffer
+ *
+ * @return     ps_unknown_name if name is not a protection
+ */
+set_param_status_t uui_get_protection(ui_screen_t *screen, char *name, char *value, uint32_t value_len);
+
 #endif // __UUI_H__
@@ -24,12 +24,11 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include "my_assert.h"
 #include "uui_number.h"
 #include "tft.h"
-#include "font-18.h"
-#include "font-24.h"
-#include "font-48.h"
+#include "font.h"
 
 /** @todo: why is pow missing from my -lm ? */
 static uint32_t my_pow(uint32_t a, uint32_t b)
@@ -103,66 +102,178 @@ static uint32_t number_get_value(ui_item_t *_item)
     return item->value;
 }
 
+/** Marks a highlighted character in the cell cache */
+#define NUMBER_CELL_HIGHLIGHT  (0x80)
+
+/**
+ * @brief      Draw a glyph cell unless the cache says it is already on screen
+ *
+ * @param      item       The item
+ * @param      cell       Index of the cell
+ * @param[in]  ch         The character, ' ' for a blank cell
+ * @param[in]  x,y,w,h    Bounding box of the cell
+ * @param[in]  highlight  Draw the character highlighted
+ */
+static void draw_cell(ui_number_t *item, uint32_t cell, char ch, uint16_t x, uint16_t y, uint16_t w, uint16_t h, bool highlight)
+{
+    char c = ch | (highlight ? NUMBER_CELL_HIGHLIGHT : 0);
+    if (cell < NUMBER_MAX_CELLS) {
+        if (item->cells[cell] == c) {
+            return;
+        }
+        item->cells[cell] = c;
+    }
+    if (ch == ' ') {
+        tft_fill(x, y, w, h, 0);
+    } else {
+        tft_putch(item->font_size, ch, x, y, w, h, highlight);
+    }
+}
+
+/**
+ * @brief      Get the size of the glyph cells of a number
+ *
+ * @param      item  The item
+ * @param      w     The width
+ * @param      h     The height
+ */
+static void cell_size(ui_number_t *item, uint32_t *w, uint32_t *h)
+{
+    const font_t *font = font_get(item->font_size);
+    assert(font);
+    /** The bigger fonts get a pixel of margin on each side */
+    uint32_t margin = item->font_size == 18 ? 0 : 2;
+    *w = font->digit_width + margin;
+    *h = font->height + margin;
+}
+
+/** Space between the unit and the decimals, and between the decimals and
+    the decimal point */
+#define UNIT_GAP(item)  ((item)->font_size == 18 ? 2 : 4)
+#define DOT_GAP(item)   ((item)->font_size == 18 ? 4 : 10)
+/** Width of the decimal point cell, it fits in the gap */
+#define DOT_WIDTH(item) ((item)->font_size == 18 ? 4 : 10)
+
 /**
- * @brief      Draw the number from right to left (unit first)
+ * @brief      Get the static layer of the number, its unit and decimal
+ *             point
+ *
+ * @param      _item  The item
+ * @param[in]  index  Index of the entry
+ * @param      entry  The entry
+ *
+ * @return     false past the last entry
+ */
+static bool number_get_static(ui_item_t *_item, uint32_t index, ui_static_t *entry)
+{
+    ui_number_t *item = (ui_number_t*) _item;
+    uint32_t w, h;
+    cell_size(item, &w, &h);
+    entry->y = _item->y;
+    entry->h = h;
+    entry->font_size = item->font_size;
+    switch (index) {
+        case 0:
+            entry->x = _item->x - w;
+            entry->w = w;
+            switch(item->unit) {
+                case unit_volt:
+                    entry->ch = 'V';
+                    break;
+                case unit_ampere:
+                    entry->ch = 'A';
+                    break;
+                case unit_watt:
+                case unit_ohm:
+                    /** The fonts have no glyphs for these units */
+                    entry->ch = ' ';
+                    break;
+                default:
+                    assert(0);
+            }
+            return true;
+        case 1:
+            entry->x = _item->x - w - UNIT_GAP(item) - item->num_decimals * w - DOT_GAP(item);
+            entry->w = DOT_WIDTH(item);
+            entry->ch = '.';
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief      Draw the digits of the number from right to left, the unit
+ *             and the decimal point are in the static layer
  *
  * @param      _item  The item
  */
 static void number_draw(ui_item_t *_item)
 {
     uint32_t cur_digit = 0;
+    uint32_t cell = 0;
     ui_number_t *item = (ui_number_t*) _item;
     uint32_t value = item->value;
     uint32_t w, h;
-    switch (item->font_size) {
-      case 18:
-        w = font_18_widths[4]; /** @todo: Find the widest glyph */
-        h = font_18_height;
-        break;
-      case 24:
-        w = font_24_widths[4] + 2; /** @todo: Find the widest glyph */
-        h = font_24_height + 2;
-        break;
-      case 48:
-        w = font_48_widths[4] + 2; /** @todo: Find the widest glyph */
-        h = font_48_height + 2;
-        break;
+    cell_size(item, &w, &h);
+    if (_item->needs_full_redraw) {
+        memset(item->cells, 0, sizeof(item->cells));
+        _item->needs_full_redraw = false;
     }
-    uint16_t xpos = _item->x - w;
-    switch(item->unit) {
-        case unit_volt:
-            tft_putch(item->font_size, 'V', xpos, _item->y, w, h, false);
-            break;
-        case unit_ampere:
-            tft_putch(item->font_size, 'A', xpos, _item->y, w, h, false);
-            break;
-        default:
-            assert(0);
-    }
-    xpos -= item->font_size == 18 ? 2 : 4;
+    tft_frame_begin();
+    uint16_t xpos = _item->x - w - UNIT_GAP(item);
     for (uint32_t i = 0; i < item->num_decimals; i++) {
         bool highlight = _item->has_focus && item->cur_digit == cur_digit;
         xpos -= w;
-        tft_putch(item->font_size, '0'+(value%10), xpos, _item->y, w, h, highlight);
+        draw_cell(item, cell++, '0'+(value%10), xpos, _item->y, w, h, highlight);
         value /= 10;
         cur_digit++;
     }
-    xpos -= item->font_size == 18 ? 4 : 10;
-    tft_putch(item->font_size, '.', xpos, _item->y, item->font_size == 0 ? 4 : 10, h, false);
+    xpos -= DOT_GAP(item);
     for (uint32_t i = 0; i < item->num_digits; i++) {
         bool highlight = _item->has_focus && item->cur_digit == cur_digit;
         xpos -= w;
-        tft_putch(item->font_size, '0'+(value%10), xpos, _item->y, w, h, highlight);
+        draw_cell(item, cell++, '0'+(value%10), xpos, _item->y, w, h, highlight);
         value /= 10;
         cur_digit++;
         if (!value && !_item->has_focus) { /** To prevent from printing 00.123 */
             xpos -= w;
-            tft_fill(xpos, _item->y, w, h, 0);
+            draw_cell(item, cell++, ' ', xpos, _item->y, w, h, false);
             break;
         }
     }
+    tft_frame_end();
 }
 
+/**
+ * @brief      Take over the cell cache of a number in the same place on the
+ *             screen before, if it is laid out the same way
+ *
+ * @param      _item  The item
+ * @param      _old   The item of the screen before
+ */
+static void number_inherit(ui_item_t *_item, ui_item_t *_old)
+{
+    ui_number_t *item = (ui_number_t*) _item;
+    ui_number_t *old = (ui_number_t*) _old;
+    if (_old->ops == _item->ops && old->font_size == item->font_size &&
+        old->num_digits == item->num_digits && old->num_decimals == item->num_decimals) {
+        memcpy(item->cells, old->cells, sizeof(item->cells));
+        _item->needs_full_redraw = false;
+    }
+}
+
+/** Shared by all number items */
+static const ui_item_ops_t number_ops = {
+    .got_focus = &ui_item_got_focus,
+    .lost_focus = &ui_item_lost_focus,
+    .got_event = &number_got_event,
+    .get_value = &number_get_value,
+    .draw = &number_draw,
+    .get_static = &number_get_static,
+    .inherit = &number_inherit,
+};
+
 /**
  * @brief      Initialize number item
  *
@@ -171,10 +282,17 @@ static void number_draw(ui_item_t *_item)
 void number_init(ui_number_t *item)
 {
     assert(item);
-    ui_item_init(&item->ui);
-    item->ui.got_event = &number_got_event;
-    item->ui.get_value = &number_get_value;
-    item->ui.draw = &number_draw;
+    ui_item_init(&item->ui, &number_ops);
     item->cur_digit = item->num_digits + item->num_decimals - 1; /** Most signinficant digit */
     item->ui.needs_redraw = true;
+    item->ui.needs_full_redraw = true;
+}
+
+void number_set_value(ui_number_t *item, int16_t value)
+{
+    assert(item);
+    if (item->value != value) {
+        item->value = value;
+        item->ui.needs_redraw = true;
+    }
 }
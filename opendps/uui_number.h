@@ -30,6 +30,10 @@
 #include <stdbool.h>
 #include "uui.h"
 
+/** Number of glyph cells (decimals, digits and leading blank)
+    whose rendering is cached */
+#define NUMBER_MAX_CELLS  (6)
+
 /**
  * A UI item describing an editable number formatted as <num_digits>.<num_decimals>
  * The number has a min and max value and cur_digit keeps track of which digit
@@ -47,6 +51,9 @@ typedef struct ui_number_t {
     int16_t min;
     int16_t max;
     void (*changed)(struct ui_number_t *item);
+    /** Last rendered character of each cell, NUMBER_CELL_HIGHLIGHT or:ed in
+        if highlighted, 0 if unknown */
+    char cells[NUMBER_MAX_CELLS];
 } ui_number_t;
 
 /**
@@ -56,4 +63,14 @@ typedef struct ui_number_t {
  */
 void number_init(ui_number_t *item);
 
+/**
+ * @brief      Set the value of a number item. The item is only marked for
+ *             redrawing, it is drawn by the next uui_refresh() if the value
+ *             changed.
+ *
+ * @param      item   The item
+ * @param[in]  value  The new value
+ */
+void number_set_value(ui_number_t *item, int16_t value);
+
 #endif // __UUI_NUMBER_H__
@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <iwdg.h>
+#include <dbgmcu.h>
+#include "watchdog.h"
+#include "hw.h"
+#include "adc_scan.h"
+#include "tick.h"
+#include "softtimer.h"
+
+/** Deadline of each heartbeat in watchdog_heartbeat_t order */
+static const uint32_t deadline_ms[wd_max] = {
+    [wd_main_loop] = 500,
+    [wd_adc] = 100,
+    [wd_uart_rx] = 1000,
+};
+
+static uint32_t last_beat[wd_max];
+static uint32_t last_adc_count;
+static softtimer_t watchdog_timer;
+
+/**
+  * @brief Check the heartbeats and feed the IWDG if all are alive
+  * @param timer the watchdog timer
+  * @retval None
+  */
+static void watchdog_tick(softtimer_t *timer)
+{
+    (void) timer;
+    uint32_t count = adc_scan_count();
+    if (count != last_adc_count) {
+        last_adc_count = count;
+        watchdog_beat(wd_adc);
+    }
+    if (!hw_uart_rx_waiting()) {
+        watchdog_beat(wd_uart_rx);
+    }
+    uint32_t now = get_ticks32();
+    for (uint32_t hb = 0; hb < wd_max; hb++) {
+        if (now - last_beat[hb] > deadline_ms[hb]) {
+            /** No feeding, the IWDG resets the device */
+            return;
+        }
+    }
+    iwdg_reset();
+}
+
+void watchdog_init(void)
+{
+    uint32_t now = get_ticks32();
+    for (uint32_t hb = 0; hb < wd_max; hb++) {
+        last_beat[hb] = now;
+    }
+    last_adc_count = adc_scan_count();
+    /** Halting the core in the debugger must not reset it */
+    DBGMCU_CR |= DBGMCU_CR_IWDG_STOP;
+    iwdg_set_period_ms(CONFIG_WATCHDOG_TIMEOUT_MS);
+    iwdg_start();
+    softtimer_start(&watchdog_timer, CONFIG_WATCHDOG_INTERVAL_MS, CONFIG_WATCHDOG_INTERVAL_MS, &watchdog_tick);
+}
+
+void watchdog_beat(watchdog_heartbeat_t hb)
+{
+    last_beat[hb] = get_ticks32();
+}
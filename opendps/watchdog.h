@@ -0,0 +1,68 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __WATCHDOG_H__
+#define __WATCHDOG_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** The independent watchdog resets the device unless it is fed. It is only
+  * fed while every subsystem below has checked in within its deadline, so a
+  * stalled main loop, a dead ADC (and with it OCP) or received data left
+  * unhandled all end in a reset rather than an unattended output. The IWDG
+  * runs from the LSI and is not stopped by a reset, so the bootloader feeds
+  * it too. */
+
+/** IWDG period, the LSI is only accurate to about +-40% */
+#ifndef CONFIG_WATCHDOG_TIMEOUT_MS
+ #define CONFIG_WATCHDOG_TIMEOUT_MS  (2000)
+#endif
+
+/** How often the heartbeats are checked */
+#ifndef CONFIG_WATCHDOG_INTERVAL_MS
+ #define CONFIG_WATCHDOG_INTERVAL_MS  (100)
+#endif
+
+typedef enum {
+    wd_main_loop = 0, /** Beaten on every pass of the event loop */
+    wd_adc,           /** Beaten while the ADC scan count advances */
+    wd_uart_rx,       /** Beaten while no received data waits to be handled */
+    wd_max
+} watchdog_heartbeat_t;
+
+/**
+  * @brief Start the IWDG and the heartbeat checks on a soft timer
+  * @retval None
+  */
+void watchdog_init(void);
+
+/**
+  * @brief Check in a heartbeat
+  * @param hb the heartbeat
+  * @retval None
+  */
+void watchdog_beat(watchdog_heartbeat_t hb);
+
+#endif // __WATCHDOG_H__
@@ -0,0 +1,126 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "wave.h"
+#include "hw.h"
+#include "pwrctl.h"
+#include "dbg_printf.h"
+
+/** The DAC codes of one period, read by the DMA while playing */
+static uint16_t table[WAVE_SAMPLES];
+
+/** The first quarter of a sine period of WAVE_SAMPLES samples, in Q15 */
+static const int16_t quarter_sine[WAVE_SAMPLES / 4 + 1] = {
+    0, 3212, 6393, 9512, 12539, 15446, 18204, 20787, 23170,
+    25329, 27245, 28898, 30273, 31356, 32137, 32609, 32767
+};
+
+_Static_assert(WAVE_SAMPLES == 64, "quarter_sine is made for 64 samples");
+
+/**
+  * @brief Get a sample of a waveform
+  * @param shape the shape
+  * @param i the index of the sample in the period
+  * @retval the sample in Q15, -32767 to 32767
+  */
+static int32_t sample(wave_shape_t shape, uint32_t i)
+{
+    const uint32_t quarter = WAVE_SAMPLES / 4;
+    switch (shape) {
+        case wave_sine:
+            if (i < quarter) {
+                return quarter_sine[i];
+            } else if (i < 2 * quarter) {
+                return quarter_sine[2 * quarter - i];
+            } else if (i < 3 * quarter) {
+                return -quarter_sine[i - 2 * quarter];
+            }
+            return -quarter_sine[WAVE_SAMPLES - i];
+        case wave_triangle:
+            /** Rising through 0 at the start like the sine */
+            if (i < quarter) {
+                return 32767 * i / quarter;
+            } else if (i < 3 * quarter) {
+                return 32767 - 32767 * (int32_t) (i - quarter) / quarter;
+            }
+            return -32767 + 32767 * (int32_t) (i - 3 * quarter) / quarter;
+        case wave_square:
+            return i < WAVE_SAMPLES / 2 ? -32767 : 32767;
+        default:
+            return 0;
+    }
+}
+
+/**
+  * @brief Play a waveform on V_out
+  * @param shape the shape, wave_off stops
+  * @param freq_mhz frequency in mHz
+  * @param offset_mv the centre voltage
+  * @param amplitude_mv the peak deviation from the centre, clipped at 0V
+  * @retval false if the arguments are out of range or power out is disabled
+  */
+bool wave_start(wave_shape_t shape, uint32_t freq_mhz, uint32_t offset_mv, uint32_t amplitude_mv)
+{
+    if (shape == wave_off) {
+        wave_stop();
+        return true;
+    }
+    if (shape >= wave_max || freq_mhz < WAVE_MIN_FREQ_MHZ || freq_mhz > WAVE_MAX_FREQ_MHZ || !pwrctl_vout_enabled()) {
+        return false;
+    }
+    /** The DMA must not read the table while it is rebuilt */
+    wave_stop();
+    for (uint32_t i = 0; i < WAVE_SAMPLES; i++) {
+        int32_t mv = (int32_t) offset_mv + (int32_t) ((int64_t) amplitude_mv * sample(shape, i) / 32767);
+        table[i] = pwrctl_calc_vout_dac(mv < 0 ? 0 : mv);
+    }
+    pwrctl_hold_vout_dac(true);
+    if (!hw_dac_wave_start(table, WAVE_SAMPLES, (uint64_t) freq_mhz * WAVE_SAMPLES)) {
+        pwrctl_hold_vout_dac(false);
+        return false;
+    }
+    emu_printf("Wave %d at %u mHz, %u +/- %u mV\n", shape, freq_mhz, offset_mv, amplitude_mv);
+    return true;
+}
+
+/**
+  * @brief Stop the waveform, V_out returns to its setting
+  * @retval None
+  */
+void wave_stop(void)
+{
+    hw_dac_wave_stop();
+    pwrctl_hold_vout_dac(false);
+}
+
+/**
+  * @brief Check if a waveform is playing
+  * @retval true if playing
+  */
+bool wave_is_active(void)
+{
+    return hw_dac_wave_active();
+}
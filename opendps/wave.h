@@ -0,0 +1,71 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __WAVE_H__
+#define __WAVE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Samples per period of the waveform table, 2 bytes of RAM each */
+#define WAVE_SAMPLES  (64)
+
+/** Highest and lowest waveform frequencies in mHz, the DMA feeds the DAC at
+  * most 256k samples per second */
+#define WAVE_MAX_FREQ_MHZ  (4000000)
+#define WAVE_MIN_FREQ_MHZ  (100)
+
+typedef enum {
+    wave_off = 0, /** Stop, the DAC returns to the V_out setting */
+    wave_sine,
+    wave_triangle,
+    wave_square,  /** Low the first half period, high the second */
+    wave_max
+} wave_shape_t;
+
+/**
+  * @brief Play a waveform on V_out. The table is built once and fed to the
+  *        V_out DAC by a timer triggered DMA, with no CPU work per sample.
+  *        Power out must be enabled, disabling it stops the waveform.
+  * @param shape the shape, wave_off stops
+  * @param freq_mhz frequency in mHz
+  * @param offset_mv the centre voltage
+  * @param amplitude_mv the peak deviation from the centre, clipped at 0V
+  * @retval false if the arguments are out of range or power out is disabled
+  */
+bool wave_start(wave_shape_t shape, uint32_t freq_mhz, uint32_t offset_mv, uint32_t amplitude_mv);
+
+/**
+  * @brief Stop the waveform, V_out returns to its setting
+  * @retval None
+  */
+void wave_stop(void);
+
+/**
+  * @brief Check if a waveform is playing
+  * @retval true if playing
+  */
+bool wave_is_active(void);
+
+#endif // __WAVE_H__
@@ -0,0 +1,197 @@
+#!/usr/bin/python
+#
+# The MIT License (MIT)
+#
+# Copyright (c) 2017 Johan Kanflo (github.com/kanflo)
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+"""
+Flash, RAM and stack report of a firmware build, run by 'make size-report'
+in opendps/ and dpsboot/.
+
+The sections of each object are summed into .text, .rodata, .data and .bss.
+The totals come from the linked ELF and are checked against the budgets.
+The worst case stack depth is computed from the call graphs that gcc writes
+with -fcallgraph-info=su (one .ci file per object), starting from main and
+from every interrupt handler. The interrupts all run at the same priority, so
+one handler at a time is added on top of main. The exit status is 1 if a budget is exceeded,
+so a CI job can run the target as is.
+"""
+
+from __future__ import print_function
+import sys
+import os
+import re
+import argparse
+import subprocess
+
+# Bytes stacked by the Cortex-M3 on exception entry, 8 registers and alignment
+EXCEPTION_FRAME = 36
+
+def section_sizes(size_tool, path):
+    """
+    Return a dictionary of .text, .rodata, .data and .bss sizes of an object
+    or ELF file, summing the -ffunction-sections / -fdata-sections sections
+    """
+    sizes = {'text': 0, 'rodata': 0, 'data': 0, 'bss': 0}
+    out = subprocess.check_output([size_tool, "-A", "-d", path]).decode("utf-8")
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) < 2 or not fields[0].startswith(".") or not fields[1].isdigit():
+            continue
+        name = fields[0]
+        size = int(fields[1])
+        for kind in ['text', 'rodata', 'data', 'bss']:
+            if name == "." + kind or name.startswith("." + kind + "."):
+                sizes[kind] += size
+                break
+        else:
+            # Vectors, exception tables and the like live in flash
+            if name.startswith(".vectors") or name.startswith(".ARM"):
+                sizes['text'] += size
+    return sizes
+
+def parse_call_graphs(files):
+    """
+    Parse gcc's .ci files
+    Return (frames, calls) where frames maps a function to its stack frame
+    (None if unknown) and calls maps a function to the set of callees
+    """
+    node_re = re.compile(r'node: \{ title: "([^"]+)" label: "([^"]*)"')
+    edge_re = re.compile(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+    frame_re = re.compile(r'\\n(\d+) bytes \(([a-z,]+)\)')
+    frames = {}
+    calls = {}
+    for name in files:
+        with open(name) as f:
+            for line in f:
+                m = node_re.search(line)
+                if m:
+                    fr = frame_re.search(m.group(2))
+                    size = int(fr.group(1)) if fr and fr.group(2) != "dynamic" else None
+                    if size is not None or m.group(1) not in frames:
+                        frames[m.group(1)] = max(size, frames.get(m.group(1)) or 0) if size is not None else None
+                    continue
+                m = edge_re.search(line)
+                if m:
+                    calls.setdefault(m.group(1), set()).add(m.group(2))
+    return frames, calls
+
+def worst_path(func, frames, calls, memo, active):
+    """
+    Return (depth, path, complete) of the deepest call chain from func,
+    complete being False if the chain has recursion, indirect calls or
+    functions without stack information
+    """
+    if func in memo:
+        return memo[func]
+    if func in active:
+        return (0, [func + " (recursion)"], False)
+    active.add(func)
+    frame = frames.get(func)
+    complete = frame is not None and func != "__indirect_call"
+    best = (0, [], True)
+    for callee in calls.get(func, ()):
+        sub = worst_path(callee, frames, calls, memo, active)
+        if sub[0] > best[0]:
+            best = (sub[0], sub[1], best[2] and sub[2])
+        else:
+            best = (best[0], best[1], best[2] and sub[2])
+    active.discard(func)
+    result = ((frame or 0) + best[0], [func] + best[1], complete and best[2])
+    memo[func] = result
+    return result
+
+def main():
+    parser = argparse.ArgumentParser(description='Firmware size and stack report')
+    parser.add_argument('-e', '--elf', action='store', required=True, help="Linked ELF file")
+    parser.add_argument('-s', '--size-tool', action='store', default="arm-none-eabi-size", help="The size tool of the toolchain")
+    parser.add_argument('-f', '--flash-budget', type=int, action='store', default=0, help="Flash budget in bytes, 0 for no limit")
+    parser.add_argument('-r', '--ram-budget', type=int, action='store', default=0, help="RAM budget for .data, .bss and the stack in bytes, 0 for no limit")
+    parser.add_argument('-k', '--stack-budget', type=int, action='store', default=0, help="Stack budget in bytes, 0 for no limit")
+    parser.add_argument('objects', nargs='*', help="Objects to break down")
+    args = parser.parse_args()
+
+    rows = []
+    for obj in args.objects:
+        if os.path.exists(obj):
+            rows.append((obj, section_sizes(args.size_tool, obj)))
+    rows.sort(key = lambda r: -(r[1]['text'] + r[1]['rodata'] + r[1]['data'] + r[1]['bss']))
+
+    print("%-24s %7s %7s %7s %7s" % ("Object", ".text", ".rodata", ".data", ".bss"))
+    for obj, s in rows:
+        print("%-24s %7d %7d %7d %7d" % (obj, s['text'], s['rodata'], s['data'], s['bss']))
+    print("")
+
+    total = section_sizes(args.size_tool, args.elf)
+    flash = total['text'] + total['rodata'] + total['data']
+    ram = total['data'] + total['bss']
+
+    ci_files = [os.path.splitext(o)[0] + ".ci" for o in args.objects]
+    ci_files = [c for c in ci_files if os.path.exists(c)]
+    stack = 0
+    if ci_files:
+        frames, calls = parse_call_graphs(ci_files)
+        callees = set()
+        for c in calls.values():
+            callees |= c
+        roots = sorted(f for f in frames if f == "main" or f.endswith("_isr") or f.endswith("_handler"))
+        print("Largest stack frames")
+        for func in sorted((f for f in frames if frames[f]), key = lambda f: -frames[f])[:10]:
+            print("  %-40s %5d" % (func, frames[func]))
+        print("")
+        print("Worst case stack depth")
+        memo = {}
+        isr = 0
+        for root in roots:
+            if root in callees:
+                continue
+            depth, path, complete = worst_path(root, frames, calls, memo, set())
+            if root == "main":
+                stack = depth
+            else:
+                isr = max(isr, depth)
+            print("  %-22s %5d%s  %s" % (root, depth, "" if complete else "+", " > ".join(path)))
+        print("  ('+' marks chains calling functions of unknown stack usage)")
+        # All interrupts run at the same priority and never nest, the worst
+        # case is main with the deepest handler and its exception frame on
+        # top
+        if isr:
+            stack += isr + EXCEPTION_FRAME
+            print("  %-22s %5d   main, the deepest handler and a %d byte exception frame" % ("total", stack, EXCEPTION_FRAME))
+        print("")
+
+    failed = False
+    def check(what, used, budget):
+        if budget:
+            print("%-8s %6d of %6d bytes (%d%%)" % (what, used, budget, 100 * used // budget))
+            return used > budget
+        print("%-8s %6d bytes" % (what, used))
+        return False
+    failed |= check("Flash", flash, args.flash_budget)
+    failed |= check("RAM", ram + stack, args.ram_budget)
+    if ci_files:
+        failed |= check("Stack", stack, args.stack_budget)
+    if failed:
+        print("Error: budget exceeded")
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()